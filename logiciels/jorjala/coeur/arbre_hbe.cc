@@ -24,113 +24,374 @@
 
 #include "arbre_hbe.hh"
 
-static inline auto axe_depuis_direction(Axe const direction)
-{
-    if (direction == Axe::Y) {
-        return 1u;
+#include <algorithm>
+#include <cassert>
+#include <tbb/concurrent_vector.h>
+#include <tbb/parallel_invoke.h>
+
+/* Nombre maximum de cases par axe pour l'évaluation des scissions. */
+static constexpr auto NOMBRE_CASES = 16;
+
+/* Un noeud ayant au plus autant de références devient une feuille. */
+static constexpr auto REFERENCES_PAR_FEUILLE = 5l;
+
+/* Nombre de références à partir duquel les enfants d'un noeud sont construits
+ * en parallèle ; en deçà la création des tâches coûte plus qu'elle ne gagne. */
+static constexpr auto SEUIL_PARALLELE = 4096l;
+
+namespace {
+
+/* Version allégée de BoiteEnglobante pour la construction : la mise à jour des
+ * limites ne recalcule pas de centroïde, ce qui est la majeure partie du temps
+ * de regroupement. */
+struct Limites {
+    dls::math::point3d min = dls::math::point3d(constantes<double>::INFINITE);
+    dls::math::point3d max = dls::math::point3d(-constantes<double>::INFINITE);
+
+    void etend(dls::math::point3d const &autre_min, dls::math::point3d const &autre_max)
+    {
+        for (auto i = 0ul; i < 3; ++i) {
+            min[i] = std::min(min[i], autre_min[i]);
+            max[i] = std::max(max[i], autre_max[i]);
+        }
     }
 
-    if (direction == Axe::Z) {
-        return 2u;
+    void etend(Limites const &autre)
+    {
+        etend(autre.min, autre.max);
     }
 
-    return 0u;
-}
+    void etend(dls::math::point3d const &point)
+    {
+        etend(point, point);
+    }
+
+    /* La moitié de l'aire de la surface suffit pour comparer des coûts. */
+    double demi_aire_surface() const
+    {
+        auto const d = max - min;
+        return d.x * d.y + d.x * d.z + d.y * d.z;
+    }
+
+    BoiteEnglobante boite() const
+    {
+        auto resultat = BoiteEnglobante();
+        resultat.min = min;
+        resultat.max = max;
+        resultat.centroide = (min + max) * 0.5;
+        return resultat;
+    }
+};
+
+/* Les références sont partitionnées avec leurs limites pour que le
+ * regroupement parcoure la mémoire linéairement. */
+struct ReferenceHBE {
+    Limites limites{};
+    dls::math::point3d centroide{};
+    long id = 0;
+};
+
+struct CaseSAH {
+    Limites limites{};
+    Limites limites_centroides{};
+    long nombre = 0;
+
+    void fusionne(CaseSAH const &autre)
+    {
+        limites.etend(autre.limites);
+        limites_centroides.etend(autre.limites_centroides);
+        nombre += autre.nombre;
+    }
+};
+
+struct ScissionSAH {
+    unsigned int axe = 0;
+    int case_scission = -1;
+    double cout = constantes<double>::INFINITE;
+    CaseSAH gauche{};
+    CaseSAH droite{};
+};
+
+/* Transforme une coordonnée de centroïde en index de case. Le même calcul sert
+ * au regroupement et à la partition pour que les deux s'accordent. */
+struct ProjectionCases {
+    double origine = 0.0;
+    double echelle = 0.0;
+    int nombre_cases = 0;
+
+    ProjectionCases(Limites const &limites_centroides, unsigned int axe, int nombre_cases_)
+        : origine(limites_centroides.min[axe]), nombre_cases(nombre_cases_)
+    {
+        auto const ampleur = limites_centroides.max[axe] - limites_centroides.min[axe];
+
+        if (ampleur > 0.0) {
+            echelle = static_cast<double>(nombre_cases) * (1.0 - 1e-6) / ampleur;
+        }
+    }
+
+    int operator()(double valeur) const
+    {
+        auto const index = static_cast<int>((valeur - origine) * echelle);
+        return std::min(nombre_cases - 1, std::max(0, index));
+    }
+};
 
-double calcul_cout_scission(double const scission,
-                            const ArbreHBE::Noeud &noeud,
-                            dls::tableau<long> &references,
-                            Axe const direction,
-                            dls::tableau<BoiteEnglobante> const &boites_alignees,
-                            long &compte_gauche,
-                            long &compte_droite)
+/* Les petits noeuds n'ont pas besoin de toutes les cases, dont
+ * l'initialisation et le balayage coûteraient plus que le regroupement. */
+int nombre_cases_pour(long nombre_references)
 {
-    auto const axe_scission = axe_depuis_direction(direction);
+    return static_cast<int>(std::min(static_cast<long>(NOMBRE_CASES), nombre_references));
+}
+
+class ConstructriceArbreHBE {
+    dls::tableau<ReferenceHBE> &m_references;
+    unsigned int m_profondeur_max;
 
-    auto boite_gauche = BoiteEnglobante{};
-    auto gauche = 0;
-    auto boite_droite = BoiteEnglobante{};
-    auto droite = 0;
+    /* Les noeuds sont ajoutés depuis plusieurs tâches ; un concurrent_vector
+     * garantit que les noeuds déjà créés ne sont pas déplacés. */
+    tbb::concurrent_vector<ArbreHBE::Noeud> m_noeuds{};
 
-    /* Parcours les références du noeud et fusionne les dans 'gauche' ou 'droite' */
-    for (auto i = 0; i < noeud.nombre_references; ++i) {
-        auto const idx_ref = references[i];
-        auto const &reference = boites_alignees[idx_ref];
+  public:
+    ConstructriceArbreHBE(dls::tableau<ReferenceHBE> &references, unsigned int profondeur_max)
+        : m_references(references), m_profondeur_max(profondeur_max)
+    {
+    }
+
+    tbb::concurrent_vector<ArbreHBE::Noeud> const &noeuds() const
+    {
+        return m_noeuds;
+    }
+
+    void construit(Limites const &limites, Limites const &limites_centroides)
+    {
+        auto racine = ArbreHBE::Noeud();
+        racine.limites = limites.boite();
+        m_noeuds.push_back(racine);
+
+        construit_noeud(0, 0, m_references.taille(), limites_centroides, 0);
+    }
+
+  private:
+    void construit_noeud(long index_noeud,
+                         long debut,
+                         long fin,
+                         Limites const &limites_centroides,
+                         unsigned int profondeur)
+    {
+        /* Les références d'un noeud sont contiguës dans le tableau, que le
+         * noeud soit une feuille ou non. */
+        auto &noeud = m_noeuds[static_cast<size_t>(index_noeud)];
+        noeud.nombre_references = fin - debut;
+        noeud.decalage_reference = debut;
 
-        if (reference.centroide[axe_scission] <= scission) {
-            gauche++;
-            boite_gauche.etend(reference);
+        if (fin - debut <= REFERENCES_PAR_FEUILLE || profondeur + 1 >= m_profondeur_max) {
+            return;
+        }
+
+        auto const scission = trouve_meilleure_scission(debut, fin, limites_centroides);
+
+        /* Tous les centroïdes sont confondus : aucune scission possible. */
+        if (scission.case_scission == -1) {
+            return;
+        }
+
+        auto const milieu = partitionne(debut, fin, limites_centroides, scission);
+
+        auto iter = m_noeuds.grow_by(2);
+        auto const index_gauche = std::distance(m_noeuds.begin(), iter);
+        auto const index_droite = index_gauche + 1;
+
+        iter->limites = scission.gauche.limites.boite();
+        (iter + 1)->limites = scission.droite.limites.boite();
+
+        noeud.enfants[NOEUD_GAUCHE] = index_gauche;
+        noeud.enfants[NOEUD_DROITE] = index_droite;
+        noeud.axe_princ = static_cast<Axe>(scission.axe);
+
+        auto construit_gauche = [&]() {
+            construit_noeud(
+                index_gauche, debut, milieu, scission.gauche.limites_centroides, profondeur + 1);
+        };
+
+        auto construit_droite = [&]() {
+            construit_noeud(
+                index_droite, milieu, fin, scission.droite.limites_centroides, profondeur + 1);
+        };
+
+        if (fin - debut > SEUIL_PARALLELE) {
+            tbb::parallel_invoke(construit_gauche, construit_droite);
         }
         else {
-            droite++;
-            boite_droite.etend(reference);
+            construit_gauche();
+            construit_droite();
         }
     }
 
-    compte_gauche = gauche;
-    compte_droite = droite;
+    /* Regroupe les références dans les cases des trois axes en une passe, puis
+     * évalue le coût SAH de chaque frontière entre deux cases. */
+    ScissionSAH trouve_meilleure_scission(long debut,
+                                          long fin,
+                                          Limites const &limites_centroides) const
+    {
+        auto const nombre_cases = nombre_cases_pour(fin - debut);
+
+        CaseSAH cases[3][NOMBRE_CASES];
+        ProjectionCases const projections[3] = {
+            ProjectionCases(limites_centroides, 0, nombre_cases),
+            ProjectionCases(limites_centroides, 1, nombre_cases),
+            ProjectionCases(limites_centroides, 2, nombre_cases),
+        };
+
+        auto const references = m_references.donnees();
+
+        for (auto i = debut; i < fin; ++i) {
+            auto const &reference = references[i];
+
+            for (auto axe = 0u; axe < 3; ++axe) {
+                auto &case_ = cases[axe][projections[axe](reference.centroide[axe])];
+                case_.limites.etend(reference.limites);
+                case_.limites_centroides.etend(reference.centroide);
+                case_.nombre += 1;
+            }
+        }
+
+        auto resultat = ScissionSAH{};
+
+        for (auto axe = 0u; axe < 3; ++axe) {
+            if (projections[axe].echelle == 0.0) {
+                continue;
+            }
+
+            /* Accumule les cases depuis la droite pour connaître, pour chaque
+             * frontière, le coût de la partie droite. */
+            CaseSAH cumul_droite[NOMBRE_CASES];
+            cumul_droite[nombre_cases - 1] = cases[axe][nombre_cases - 1];
+
+            for (auto i = nombre_cases - 2; i >= 0; --i) {
+                cumul_droite[i] = cumul_droite[i + 1];
+                cumul_droite[i].fusionne(cases[axe][i]);
+            }
 
-    if (gauche == 0 || droite == 0) {
-        return std::pow(10.0f, 100);
+            auto cumul_gauche = CaseSAH{};
+
+            for (auto i = 0; i < nombre_cases - 1; ++i) {
+                cumul_gauche.fusionne(cases[axe][i]);
+
+                auto const &droite = cumul_droite[i + 1];
+
+                if (cumul_gauche.nombre == 0 || droite.nombre == 0) {
+                    continue;
+                }
+
+                auto const cout = static_cast<double>(cumul_gauche.nombre) *
+                                      cumul_gauche.limites.demi_aire_surface() +
+                                  static_cast<double>(droite.nombre) *
+                                      droite.limites.demi_aire_surface();
+
+                if (cout < resultat.cout) {
+                    resultat.axe = axe;
+                    resultat.case_scission = i;
+                    resultat.cout = cout;
+                    resultat.gauche = cumul_gauche;
+                    resultat.droite = droite;
+                }
+            }
+        }
+
+        return resultat;
     }
 
-    auto cout_gauche = gauche * boite_gauche.aire_surface();
-    auto cout_droite = droite * boite_droite.aire_surface();
+    long partitionne(long debut,
+                     long fin,
+                     Limites const &limites_centroides,
+                     ScissionSAH const &scission)
+    {
+        auto const projection = ProjectionCases(
+            limites_centroides, scission.axe, nombre_cases_pour(fin - debut));
 
-    return std::fabs(cout_gauche - cout_droite);
-}
+        auto references = m_references.donnees();
+        auto const milieu = std::partition(
+            references + debut, references + fin, [&](ReferenceHBE const &reference) {
+                return projection(reference.centroide[scission.axe]) <= scission.case_scission;
+            });
+
+        assert(milieu - references == debut + scission.gauche.nombre);
+        return milieu - references;
+    }
+};
 
-double trouve_meilleure_scission(ArbreHBE::Noeud &noeud,
-                                 dls::tableau<long> &references,
-                                 Axe const direction,
-                                 unsigned int const qualite,
-                                 dls::tableau<BoiteEnglobante> const &boites_alignees,
-                                 long &compte_gauche,
-                                 long &compte_droite)
+}  // namespace
+
+ArbreHBE construit_arbre_hbe_depuis_boites(dls::tableau<BoiteEnglobante> const &boites_alignees,
+                                           unsigned int profondeur_max)
 {
-    auto const axe_scission = axe_depuis_direction(direction);
+    auto limites = Limites{};
+    auto limites_centroides = Limites{};
+
+    auto references = dls::tableau<ReferenceHBE>();
+    references.reserve(boites_alignees.taille());
 
-    auto candidates = dls::tableau<double>(static_cast<long>(qualite));
-    auto longueur_axe = noeud.limites.max[axe_scission] - noeud.limites.min[axe_scission];
-    auto taille_scission = longueur_axe / static_cast<double>(qualite + 1);
-    auto taille_courante = taille_scission;
+    for (auto const &boite : boites_alignees) {
+        auto reference = ReferenceHBE();
+        reference.limites.etend(boite.min, boite.max);
+        reference.centroide = boite.centroide;
+        reference.id = boite.id;
+        references.ajoute(reference);
 
-    /* crée des scissions isométriques */
-    for (auto &candidate : candidates) {
-        candidate = noeud.limites.min[axe_scission] + taille_courante;
-        taille_courante += taille_scission;
+        limites.etend(reference.limites);
+        limites_centroides.etend(reference.centroide);
     }
 
-    /* Calculons tous les coûts de scission pour ne garder que le plus petit. */
-    auto gauche = 0l;
-    auto droite = 0l;
-    auto gauche_courante = 0l;
-    auto drotie_courante = 0l;
+    auto constructrice = ConstructriceArbreHBE(references, profondeur_max);
+    constructrice.construit(limites, limites_centroides);
+
+    /* Range les noeuds couche par couche : l'ordre de création dépend de
+     * l'ordonnancement des tâches, mais l'arbre final doit en être
+     * indépendant. Le tableau de sortie sert lui-même de file. */
+    auto const &noeuds_construits = constructrice.noeuds();
+
+    auto arbre_hbe = ArbreHBE{};
+    auto &noeuds = arbre_hbe.noeuds;
+    noeuds.reserve(static_cast<long>(noeuds_construits.size()) + 1);
+
+    auto index_source = dls::tableau<long>();
+    index_source.reserve(static_cast<long>(noeuds_construits.size()) + 1);
+
+    /* crée un noeud nul pour l'index 0; l'arbre commence à l'index 1 */
+    noeuds.ajoute(ArbreHBE::Noeud());
+    index_source.ajoute(-1);
 
-    auto meilleur_cout = constantes<double>::INFINITE;
-    auto meilleure_scission = constantes<double>::INFINITE;
+    noeuds.ajoute(noeuds_construits[0]);
+    index_source.ajoute(0);
 
-    for (auto const &candidate : candidates) {
-        auto cout = calcul_cout_scission(candidate,
-                                         noeud,
-                                         references,
-                                         direction,
-                                         boites_alignees,
-                                         gauche_courante,
-                                         drotie_courante);
+    for (auto i = 1l; i < noeuds.taille(); ++i) {
+        auto const &source = noeuds_construits[static_cast<size_t>(index_source[i])];
 
-        if (cout < meilleur_cout) {
-            meilleur_cout = cout;
-            meilleure_scission = candidate;
-            gauche = gauche_courante;
-            droite = drotie_courante;
+        noeuds[i].id_noeud = i;
+
+        if (source.est_feuille()) {
+            continue;
+        }
+
+        auto const index_gauche = noeuds.taille();
+        noeuds[i].enfants[NOEUD_GAUCHE] = index_gauche;
+        noeuds[i].enfants[NOEUD_DROITE] = index_gauche + 1;
+
+        for (auto const enfant : source.enfants) {
+            noeuds.ajoute(noeuds_construits[static_cast<size_t>(enfant)]);
+            index_source.ajoute(enfant);
         }
     }
 
-    compte_gauche = gauche;
-    compte_droite = droite;
+    arbre_hbe.nombre_noeud = noeuds.taille();
+    arbre_hbe.nombre_index_refs = references.taille();
+    arbre_hbe.index_refs.redimensionne(references.taille());
+
+    for (auto i = 0l; i < references.taille(); ++i) {
+        arbre_hbe.index_refs[i] = references[i].id;
+    }
 
-    return meilleure_scission;
+    return arbre_hbe;
 }
 
 double calcul_point_plus_proche(ArbreHBE::Noeud const &noeud,
@@ -26,6 +26,7 @@
 
 #include "biblinternes/math/boite_englobante.hh"
 #include "biblinternes/math/vecteur.hh"
+#include "biblinternes/moultfilage/boucle.hh"
 #include "biblinternes/outils/constantes.h"
 #include "biblinternes/phys/rayon.hh"
 #include "biblinternes/structures/file.hh"
@@ -45,7 +46,7 @@ struct ArbreHBE {
 
         BoiteEnglobante limites{};
 
-        long enfants[2];
+        long enfants[2] = {0, 0};
         long nombre_references = 0;
         long decalage_reference = 0;
         long id_noeud = 0;
@@ -75,21 +76,21 @@ struct ArbreHBE {
     ArbreHBE() = default;
 };
 
-double calcul_cout_scission(double const scission,
-                            const ArbreHBE::Noeud &noeud,
-                            dls::tableau<long> &references,
-                            Axe const direction,
-                            dls::tableau<BoiteEnglobante> const &boites_alignees,
-                            long &compte_gauche,
-                            long &compte_droite);
-
-double trouve_meilleure_scission(ArbreHBE::Noeud &noeud,
-                                 dls::tableau<long> &references,
-                                 Axe const direction,
-                                 unsigned int const qualite,
-                                 dls::tableau<BoiteEnglobante> const &boites_alignees,
-                                 long &compte_gauche,
-                                 long &compte_droite);
+/**
+ * Construit un arbre HBE depuis les boîtes englobantes des éléments, la boîte
+ * d'index i devant avoir i pour id.
+ *
+ * Les scissions sont choisies via un SAH groupé : les centroïdes des
+ * références d'un noeud sont répartis dans des cases le long de chaque axe, et
+ * la frontière entre deux cases de moindre coût est retenue. Les références
+ * sont partitionnées sur place dans un seul tableau, dont l'ordre donne index_refs,
+ * et les sous-arbres assez grands sont construits en parallèle.
+ *
+ * Les noeuds sont rangés couche par couche, l'index 0 étant un noeud nul et la
+ * racine se trouvant à l'index 1.
+ */
+ArbreHBE construit_arbre_hbe_depuis_boites(dls::tableau<BoiteEnglobante> const &boites_alignees,
+                                           unsigned int profondeur_max);
 
 template <typename TypeDelegue>
 auto construit_arbre_hbe(TypeDelegue const &delegue_prims, unsigned int profondeur_max)
@@ -98,251 +99,14 @@ auto construit_arbre_hbe(TypeDelegue const &delegue_prims, unsigned int profonde
     auto const nombre_de_boites = delegue_prims.nombre_elements();
     auto boites_alignees = dls::tableau<BoiteEnglobante>(nombre_de_boites);
 
-    for (auto i = 0; i < boites_alignees.taille(); ++i) {
-        boites_alignees[i] = delegue_prims.boite_englobante(i);
-    }
-
-    /* tableau pour contenir les noeuds durant la construction */
-    auto const feuilles_max = boites_alignees.taille();
-    auto const coeff_arbre = 8; /* 2^3 */
-
-    /* La taille estimée fut 2^profondeur_max, mais pouvait réserver plusieurs
-     * gigaoctets pour quelques centaines de triangles. Ceci vient de Blender.
-     */
-    auto branches_implicites = [](long coef, long feuiles) {
-        return std::max(1l, (feuiles + coef - 3) / (coef - 1));
-    };
-
-    auto const taille_estimee = feuilles_max + branches_implicites(coeff_arbre, feuilles_max) +
-                                coeff_arbre;
-
-    auto arbre = dls::tableau<ArbreHBE::Noeud>();
-    arbre.reserve(taille_estimee);
-
-    auto compte_noeud = 0u;
-    auto compte_couche = 0u;
-
-    auto refs_courantes = dls::tableau<dls::tableau<long>>();
-    refs_courantes.reserve(taille_estimee);
-
-    auto couche_courante = dls::tableau<ArbreHBE::Noeud *>();
-    auto liste_ref_finale = dls::tableau<long>();
-
-    /* crée un noeud nul pour l'index 0; l'arbre commence à l'index 1 */
-    arbre.ajoute(ArbreHBE::Noeud());
-    ++compte_noeud;
-
-    /* crée une racine avec une boîte englobant toutes les autres */
-    arbre.ajoute(ArbreHBE::Noeud());
-    ++compte_noeud;
-
-    auto racine = &arbre[1];
-
-    for (auto const &boite : boites_alignees) {
-        racine->limites.etend(boite);
-    }
-
-    /* peuple la racine avec tous les ids */
-    racine->nombre_references = nombre_de_boites;
-    racine->decalage_reference = 0;
-    racine->id_noeud = 1;
-
-    auto references_racine = dls::tableau<long>();
-    references_racine.reserve(nombre_de_boites);
-
-    for (auto const &boite : boites_alignees) {
-        references_racine.ajoute(boite.id);
-    }
-
-    couche_courante.ajoute(racine);
-    refs_courantes.ajoute(references_racine);
-
-    /* pour chaque couche, scinde les noeuds et va à la suivante */
-    for (auto couche = 0u; couche < profondeur_max; ++couche) {
-        auto couche_refs_suivante = dls::tableau<dls::tableau<long>>();
-        auto couche_suivante = dls::tableau<ArbreHBE::Noeud *>();
-
-        /* pour chaque noeud dans la couche courante, scinde et pousse résultat */
-        auto nombre_noeud_couche = couche_courante.taille();
-
-        if (nombre_noeud_couche > 0) {
-            ++compte_couche;
-        }
-
-        for (auto i = 0; i < nombre_noeud_couche; ++i) {
-            auto compte_ref = refs_courantes[i].taille();
-            auto noeud = couche_courante[i];
-
-            if (compte_ref <= 5 || (couche == profondeur_max - 1)) {
-                noeud->enfants[NOEUD_GAUCHE] = 0;
-                noeud->enfants[NOEUD_DROITE] = 0;
-                noeud->nombre_references = compte_ref;
-                noeud->decalage_reference = liste_ref_finale.taille();
-
-                for (auto j = 0; j < noeud->nombre_references; ++j) {
-                    liste_ref_finale.ajoute(refs_courantes[i][j]);
-                }
-            }
-            else {
-                /* trouve la meilleure scission via SAH et ajoute les enfants à
-                 * la couche suivante. */
-                auto axe_scission = noeud->limites.ampleur_maximale();
-                auto compte_gauche = 0l;
-                auto compte_droite = 0l;
-
-                auto meilleure_scission = trouve_meilleure_scission(*noeud,
-                                                                    refs_courantes[i],
-                                                                    axe_scission,
-                                                                    10,
-                                                                    boites_alignees,
-                                                                    compte_gauche,
-                                                                    compte_droite);
-
-                if (compte_gauche == 0 || compte_droite == 0) {
-                    compte_gauche = 0;
-                    compte_droite = 0;
-
-                    if (axe_scission == Axe::X) {
-                        axe_scission = Axe::Y;
-                    }
-                    else if (axe_scission == Axe::Y) {
-                        axe_scission = Axe::Z;
-                    }
-                    else if (axe_scission == Axe::Z) {
-                        axe_scission = Axe::X;
-                    }
-
-                    meilleure_scission = trouve_meilleure_scission(*noeud,
-                                                                   refs_courantes[i],
-                                                                   axe_scission,
-                                                                   10,
-                                                                   boites_alignees,
-                                                                   compte_gauche,
-                                                                   compte_droite);
-                }
-
-                if (compte_gauche == 0 || compte_droite == 0) {
-                    compte_gauche = 0;
-                    compte_droite = 0;
-
-                    if (axe_scission == Axe::X) {
-                        axe_scission = Axe::Y;
-                    }
-                    else if (axe_scission == Axe::Y) {
-                        axe_scission = Axe::Z;
-                    }
-                    else if (axe_scission == Axe::Z) {
-                        axe_scission = Axe::X;
-                    }
-
-                    meilleure_scission = trouve_meilleure_scission(*noeud,
-                                                                   refs_courantes[i],
-                                                                   axe_scission,
-                                                                   10,
-                                                                   boites_alignees,
-                                                                   compte_gauche,
-                                                                   compte_droite);
-                }
+    boucle_parallele(tbb::blocked_range<long>(0, nombre_de_boites, 1024),
+                     [&](tbb::blocked_range<long> const &plage) {
+                         for (auto i = plage.begin(); i < plage.end(); ++i) {
+                             boites_alignees[i] = delegue_prims.boite_englobante(i);
+                         }
+                     });
 
-                if (compte_gauche == 0 || compte_droite == 0) {
-                    noeud->enfants[NOEUD_GAUCHE] = 0;
-                    noeud->enfants[NOEUD_DROITE] = 0;
-                    noeud->nombre_references = compte_ref;
-                    noeud->decalage_reference = liste_ref_finale.taille();
-
-                    for (auto j = 0; j < noeud->nombre_references; ++j) {
-                        liste_ref_finale.ajoute(refs_courantes[i][j]);
-                    }
-                }
-                else {
-                    /* crée les noeuds gauche et droite */
-                    arbre.ajoute(ArbreHBE::Noeud());
-                    ++compte_noeud;
-
-                    auto id_gauche = arbre.taille() - 1;
-                    auto gauche = &arbre[id_gauche];
-                    gauche->id_noeud = id_gauche;
-                    gauche->nombre_references = compte_gauche;
-
-                    arbre.ajoute(ArbreHBE::Noeud());
-                    ++compte_noeud;
-
-                    auto id_droite = arbre.taille() - 1;
-                    auto droite = &arbre[id_droite];
-                    droite->id_noeud = id_droite;
-                    droite->nombre_references = compte_droite;
-
-                    noeud->enfants[NOEUD_GAUCHE] = id_gauche;
-                    noeud->enfants[NOEUD_DROITE] = id_droite;
-                    noeud->axe_princ = axe_scission;
-
-                    /* crée les listes des objets gauche et droite en se basant
-                     * sur le centroïde */
-                    auto refs_gauche = dls::tableau<long>();
-                    auto refs_droite = dls::tableau<long>();
-                    refs_gauche.reserve(compte_gauche);
-                    refs_gauche.reserve(compte_droite);
-
-                    for (auto j = 0; j < noeud->nombre_references; ++j) {
-                        auto const &index_ref = refs_courantes[i][j];
-                        auto const &ref = boites_alignees[index_ref];
-
-                        if (ref.centroide[static_cast<size_t>(axe_scission)] <=
-                            meilleure_scission) {
-                            refs_gauche.ajoute(index_ref);
-                            gauche->limites.etend(ref);
-                        }
-                        else {
-                            refs_droite.ajoute(index_ref);
-                            droite->limites.etend(ref);
-                        }
-                    }
-
-                    /* ajoute les enfants à la couche suivante */
-                    couche_suivante.ajoute(gauche);
-                    couche_suivante.ajoute(droite);
-
-                    couche_refs_suivante.ajoute(refs_gauche);
-                    couche_refs_suivante.ajoute(refs_droite);
-                }
-            }
-        }
-
-        couche_courante = couche_suivante;
-        refs_courantes = couche_refs_suivante;
-    }
-
-    auto arbre_hbe = ArbreHBE{};
-    arbre_hbe.nombre_noeud = arbre.taille();
-    arbre_hbe.noeuds = arbre;
-    arbre_hbe.nombre_index_refs = liste_ref_finale.taille();
-    arbre_hbe.index_refs = liste_ref_finale;
-
-#if 0
-	std::cerr << "-----------------------------------------------\n";
-	for (auto noeud : arbre_hbe.noeuds) {
-		if (!noeud.est_feuille()) {
-			continue;
-		}
-
-		std::cerr << "Nombre de réfs : "
-				  << noeud.nombre_references
-//				  << ", min : " << noeud.limites.min
-//				  << ", max : " << noeud.limites.max
-				  << ' ';
-
-		auto virgule = '(';
-		for (auto i = 0; i < noeud.nombre_references; ++i) {
-			auto id_prim = arbre_hbe.index_refs[noeud.decalage_reference + i];
-			std::cerr << virgule << id_prim;
-			virgule = ',';
-		}
-
-		std::cerr <<")\n";
-	}
-#endif
-
-    return arbre_hbe;
+    return construit_arbre_hbe_depuis_boites(boites_alignees, profondeur_max);
 }
 
 /* ************************************************************************** */
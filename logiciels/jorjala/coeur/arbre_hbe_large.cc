@@ -0,0 +1,153 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * The Original Code is Copyright (C) 2026 Kévin Dietrich. */
+
+#include "arbre_hbe_large.hh"
+
+#include <limits>
+
+/* Les boîtes sont converties en simple précision en arrondissant vers
+ * l'extérieur, pour ne pas manquer d'entresections aux bords. */
+static float arrondis_vers_bas(double valeur)
+{
+    auto resultat = static_cast<float>(valeur);
+
+    if (static_cast<double>(resultat) > valeur) {
+        resultat = std::nextafter(resultat, -std::numeric_limits<float>::infinity());
+    }
+
+    return resultat;
+}
+
+static float arrondis_vers_haut(double valeur)
+{
+    auto resultat = static_cast<float>(valeur);
+
+    if (static_cast<double>(resultat) < valeur) {
+        resultat = std::nextafter(resultat, std::numeric_limits<float>::infinity());
+    }
+
+    return resultat;
+}
+
+static void initialise_emplacements_vides(ArbreHBELarge::Noeud &noeud)
+{
+    for (auto i = 0; i < ArbreHBELarge::LARGEUR; ++i) {
+        noeud.min_x[i] = std::numeric_limits<float>::infinity();
+        noeud.min_y[i] = std::numeric_limits<float>::infinity();
+        noeud.min_z[i] = std::numeric_limits<float>::infinity();
+        noeud.max_x[i] = -std::numeric_limits<float>::infinity();
+        noeud.max_y[i] = -std::numeric_limits<float>::infinity();
+        noeud.max_z[i] = -std::numeric_limits<float>::infinity();
+        noeud.enfants[i] = 0;
+        noeud.nombre_references[i] = 0;
+    }
+}
+
+/* Rassemble jusqu'à LARGEUR descendants du noeud binaire en ouvrant toujours
+ * le noeud interne ayant la plus grande surface. */
+static int rassemble_descendants(ArbreHBE const &arbre,
+                                 long index_binaire,
+                                 long descendants[ArbreHBELarge::LARGEUR])
+{
+    auto const &noeud = arbre.noeuds[index_binaire];
+
+    if (noeud.est_feuille()) {
+        descendants[0] = index_binaire;
+        return 1;
+    }
+
+    descendants[0] = noeud.enfants[NOEUD_GAUCHE];
+    descendants[1] = noeud.enfants[NOEUD_DROITE];
+    auto nombre = 2;
+
+    while (nombre < ArbreHBELarge::LARGEUR) {
+        auto meilleur = -1;
+        auto meilleure_aire = -1.0;
+
+        for (auto i = 0; i < nombre; ++i) {
+            auto const &candidat = arbre.noeuds[descendants[i]];
+
+            if (candidat.est_feuille()) {
+                continue;
+            }
+
+            auto aire = candidat.limites.aire_surface();
+
+            if (aire > meilleure_aire) {
+                meilleure_aire = aire;
+                meilleur = i;
+            }
+        }
+
+        if (meilleur == -1) {
+            break;
+        }
+
+        auto const &a_ouvrir = arbre.noeuds[descendants[meilleur]];
+        descendants[meilleur] = a_ouvrir.enfants[NOEUD_GAUCHE];
+        descendants[nombre++] = a_ouvrir.enfants[NOEUD_DROITE];
+    }
+
+    return nombre;
+}
+
+static int convertis_noeud(ArbreHBE const &arbre, long index_binaire, ArbreHBELarge &resultat)
+{
+    auto const index = static_cast<int>(resultat.noeuds.taille());
+    resultat.noeuds.ajoute(ArbreHBELarge::Noeud());
+    initialise_emplacements_vides(resultat.noeuds[index]);
+
+    long descendants[ArbreHBELarge::LARGEUR];
+    auto nombre = rassemble_descendants(arbre, index_binaire, descendants);
+
+    for (auto i = 0; i < nombre; ++i) {
+        auto const &descendant = arbre.noeuds[descendants[i]];
+
+        /* La conversion des enfants ajoute des noeuds, donc le noeud courant
+         * doit être réaccédé après celle-ci. */
+        auto enfant = 0;
+        auto nombre_references = 0;
+
+        if (descendant.est_feuille()) {
+            enfant = ~static_cast<int>(descendant.decalage_reference);
+            nombre_references = static_cast<int>(descendant.nombre_references);
+        }
+        else {
+            enfant = convertis_noeud(arbre, descendants[i], resultat);
+        }
+
+        auto &noeud = resultat.noeuds[index];
+        noeud.min_x[i] = arrondis_vers_bas(descendant.limites.min.x);
+        noeud.min_y[i] = arrondis_vers_bas(descendant.limites.min.y);
+        noeud.min_z[i] = arrondis_vers_bas(descendant.limites.min.z);
+        noeud.max_x[i] = arrondis_vers_haut(descendant.limites.max.x);
+        noeud.max_y[i] = arrondis_vers_haut(descendant.limites.max.y);
+        noeud.max_z[i] = arrondis_vers_haut(descendant.limites.max.z);
+        noeud.enfants[i] = enfant;
+        noeud.nombre_references[i] = nombre_references;
+    }
+
+    return index;
+}
+
+ArbreHBELarge construit_arbre_hbe_large(ArbreHBE const &arbre)
+{
+    auto resultat = ArbreHBELarge{};
+
+    /* L'index 0 de l'arbre binaire est un noeud nul, la racine est à l'index 1. */
+    if (arbre.noeuds.taille() < 2) {
+        return resultat;
+    }
+
+    /* Un noeud large remplace au moins deux noeuds binaires internes. */
+    resultat.noeuds.reserve(arbre.noeuds.taille() / 2 + 1);
+
+    resultat.index_refs.reserve(arbre.index_refs.taille());
+    for (auto index : arbre.index_refs) {
+        resultat.index_refs.ajoute(static_cast<int>(index));
+    }
+
+    convertis_noeud(arbre, 1, resultat);
+
+    return resultat;
+}
@@ -0,0 +1,206 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * The Original Code is Copyright (C) 2026 Kévin Dietrich. */
+
+#pragma once
+
+#include <cassert>
+#include <cmath>
+#include <xmmintrin.h>
+
+#include "biblinternes/phys/rayon.hh"
+#include "biblinternes/structures/tableau.hh"
+
+#include "arbre_hbe.hh"
+
+/**
+ * Arbre HBE large : chaque noeud possède jusqu'à quatre enfants dont les
+ * boîtes englobantes, en simple précision, sont rangées composante par
+ * composante afin de pouvoir tester l'entresection d'un rayon avec les quatre
+ * boîtes en une seule fois via SSE.
+ *
+ * L'arbre est construit en aplatissant un ArbreHBE binaire : pour chaque noeud,
+ * les descendants dont la boîte a la plus grande surface sont ouverts jusqu'à
+ * avoir quatre enfants. Un noeud large fait 128 octets, comme un noeud binaire
+ * en double précision, mais l'arbre a environ quatre fois moins de noeuds.
+ */
+struct ArbreHBELarge {
+    static constexpr int LARGEUR = 4;
+
+    struct alignas(16) Noeud {
+        float min_x[LARGEUR];
+        float min_y[LARGEUR];
+        float min_z[LARGEUR];
+        float max_x[LARGEUR];
+        float max_y[LARGEUR];
+        float max_z[LARGEUR];
+
+        /* Pour un noeud interne : l'index de l'enfant dans ArbreHBELarge::noeuds,
+         * jamais nul puisque la racine est à l'index 0. Pour une feuille :
+         * ~décalage de ses références dans index_refs. Pour un emplacement
+         * vide : 0. */
+        int enfants[LARGEUR];
+
+        /* Nombre de références des feuilles ; 0 pour les noeuds internes et les
+         * emplacements vides. */
+        int nombre_references[LARGEUR];
+
+        bool enfant_est_vide(int i) const
+        {
+            return enfants[i] == 0;
+        }
+
+        bool enfant_est_feuille(int i) const
+        {
+            return enfants[i] < 0;
+        }
+    };
+
+    dls::tableau<Noeud> noeuds{};
+    dls::tableau<int> index_refs{};
+};
+
+ArbreHBELarge construit_arbre_hbe_large(ArbreHBE const &arbre);
+
+/* ************************************************************************** */
+
+namespace detail {
+
+/* Évite les multiplications 0 * infini, qui donneraient des NaNs, pour les
+ * rayons parallèles à un axe. */
+inline float inverse_direction_securise(double direction)
+{
+    if (std::abs(direction) < 1e-30) {
+        return std::copysign(1e30f, static_cast<float>(direction));
+    }
+
+    return static_cast<float>(1.0 / direction);
+}
+
+}  // namespace detail
+
+/**
+ * Retourne l'entresection la plus proche entre le rayon et les éléments du
+ * délégué. Les enfants touchés par le rayon sont empilés du plus lointain au
+ * plus proche afin de visiter les plus proches en premier, et ceux dont
+ * l'entrée est au-delà de l'entresection courante sont ignorés.
+ */
+template <typename TypeDelegue>
+auto traverse(ArbreHBELarge const &arbre,
+              TypeDelegue const &delegue,
+              dls::phys::rayond const &rayon)
+{
+    auto esect = dls::phys::esectd{};
+
+    if (arbre.noeuds.est_vide()) {
+        return esect;
+    }
+
+    auto const origine_x = _mm_set1_ps(static_cast<float>(rayon.origine.x));
+    auto const origine_y = _mm_set1_ps(static_cast<float>(rayon.origine.y));
+    auto const origine_z = _mm_set1_ps(static_cast<float>(rayon.origine.z));
+
+    auto const inverse_x = _mm_set1_ps(detail::inverse_direction_securise(rayon.direction.x));
+    auto const inverse_y = _mm_set1_ps(detail::inverse_direction_securise(rayon.direction.y));
+    auto const inverse_z = _mm_set1_ps(detail::inverse_direction_securise(rayon.direction.z));
+
+    auto const distance_min = _mm_set1_ps(static_cast<float>(rayon.distance_min));
+
+    auto t_proche = rayon.distance_max;
+
+    struct ElementPile {
+        int noeud;
+        float distance;
+    };
+
+    /* La profondeur de l'arbre est bornée par celle de l'arbre binaire
+     * (PROFONDEUR_MAX), et chaque niveau empile au plus LARGEUR - 1 noeuds en
+     * plus de celui dépilé. */
+    static constexpr auto TAILLE_PILE = 128;
+    ElementPile pile[TAILLE_PILE];
+    auto taille_pile = 0;
+
+    pile[taille_pile++] = {0, 0.0f};
+
+    while (taille_pile != 0) {
+        auto const element = pile[--taille_pile];
+
+        if (static_cast<double>(element.distance) > t_proche) {
+            continue;
+        }
+
+        auto const &noeud = arbre.noeuds[element.noeud];
+
+        auto const t0_x = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(noeud.min_x), origine_x), inverse_x);
+        auto const t1_x = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(noeud.max_x), origine_x), inverse_x);
+        auto const t0_y = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(noeud.min_y), origine_y), inverse_y);
+        auto const t1_y = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(noeud.max_y), origine_y), inverse_y);
+        auto const t0_z = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(noeud.min_z), origine_z), inverse_z);
+        auto const t1_z = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(noeud.max_z), origine_z), inverse_z);
+
+        auto const t_entree = _mm_max_ps(
+            _mm_max_ps(_mm_min_ps(t0_x, t1_x), _mm_min_ps(t0_y, t1_y)),
+            _mm_max_ps(_mm_min_ps(t0_z, t1_z), distance_min));
+        auto const t_sortie = _mm_min_ps(
+            _mm_min_ps(_mm_max_ps(t0_x, t1_x), _mm_max_ps(t0_y, t1_y)),
+            _mm_min_ps(_mm_max_ps(t0_z, t1_z), _mm_set1_ps(static_cast<float>(t_proche))));
+
+        /* Les boîtes des emplacements vides sont dégénérées, mais les tests
+         * n'excluent pas forcément celles-ci, donc elles sont ignorées plus
+         * bas. */
+        auto masque = _mm_movemask_ps(_mm_cmple_ps(t_entree, t_sortie));
+
+        if (masque == 0) {
+            continue;
+        }
+
+        alignas(16) float distances[ArbreHBELarge::LARGEUR];
+        _mm_store_ps(distances, t_entree);
+
+        /* Trie les enfants internes touchés selon leurs distances d'entrée,
+         * et teste directement les feuilles. */
+        ElementPile enfants_touches[ArbreHBELarge::LARGEUR];
+        auto nombre_touches = 0;
+
+        for (auto i = 0; i < ArbreHBELarge::LARGEUR; ++i) {
+            if ((masque & (1 << i)) == 0 || noeud.enfant_est_vide(i)) {
+                continue;
+            }
+
+            if (!noeud.enfant_est_feuille(i)) {
+                auto j = nombre_touches++;
+
+                while (j > 0 && enfants_touches[j - 1].distance < distances[i]) {
+                    enfants_touches[j] = enfants_touches[j - 1];
+                    --j;
+                }
+
+                enfants_touches[j] = {noeud.enfants[i], distances[i]};
+                continue;
+            }
+
+            auto const decalage = ~noeud.enfants[i];
+
+            for (auto r = 0; r < noeud.nombre_references[i]; ++r) {
+                auto id_prim = arbre.index_refs[decalage + r];
+                auto intersection = delegue.intersecte_element(id_prim, rayon);
+
+                if (!intersection.touche) {
+                    continue;
+                }
+
+                if (intersection.distance < t_proche) {
+                    t_proche = intersection.distance;
+                    esect = intersection;
+                }
+            }
+        }
+
+        /* Les enfants sont triés du plus lointain au plus proche. */
+        for (auto i = 0; i < nombre_touches; ++i) {
+            assert(taille_pile < TAILLE_PILE);
+            pile[taille_pile++] = enfants_touches[i];
+        }
+    }
+
+    return esect;
+}
@@ -259,7 +259,7 @@ static auto ajoute_attributs_contexte(Corps const &corps,
 
     auto &gest_attrs = ctx_gen.gest_attrs;
 
-    for (auto &attr : corps.attributs()) {
+    for (auto const &attr : corps.attributs()) {
         if (attr.portee == portee) {
             auto idx = compileuse.donnees().loge_donnees(attr.dimensions);
             gest_attrs.ajoute_attribut(
@@ -568,7 +568,9 @@ bool CompileuseGrapheLCC::compile_graphe(ContexteEvaluation const &contexte, Cor
 
     /* fais de la place pour les attributs */
     if (type_detail == DETAIL_POINTS && corps != nullptr) {
-        for (auto &attr : corps->attributs()) {
+        auto const &corps_lecture = *corps;
+
+        for (auto const &attr : corps_lecture.attributs()) {
             if (attr.portee != portee_attr::POINT) {
                 continue;
             }
@@ -169,7 +169,9 @@ void EntreeOperatrice::obtiens_liste_attributs(dls::tableau<dls::chaine> &chaine
         return;
     }
 
-    for (auto const &attributs : corps->attributs()) {
+    auto const &corps_lecture = *corps;
+
+    for (auto const &attributs : corps_lecture.attributs()) {
         chaines.ajoute(attributs.nom());
     }
 }
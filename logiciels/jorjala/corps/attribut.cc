@@ -76,12 +76,6 @@ Attribut::Attribut(
     m_tampon->redimensionne(taille * taille_octet_type_attribut(m_type) * dimensions);
 }
 
-Attribut::Attribut(Attribut const &rhs)
-    : Attribut(rhs.nom(), rhs.type(), rhs.dimensions, rhs.portee, rhs.taille())
-{
-    std::copy(rhs.m_tampon->debut(), rhs.m_tampon->fin(), m_tampon->debut());
-}
-
 type_attribut Attribut::type() const
 {
     return m_type;
@@ -131,6 +125,12 @@ void Attribut::detache()
 
 void Attribut::reinitialise()
 {
+    if (!m_tampon.unique()) {
+        /* Ne copie pas les données qui seront effacées. */
+        m_tampon = ptr_liste(memoire::loge<type_liste>("attribut"), supprime_liste);
+        return;
+    }
+
     m_tampon->efface();
 }
 
@@ -146,6 +146,15 @@ struct type_attribut_depuis_type<dls::chaine> {
         return this->valeur<__type>(idx);                                                         \
     }
 
+/**
+ * Les données d'un attribut sont partagées entre les copies de celui-ci, et ne
+ * sont copiées que lors d'un accès en écriture (copie sur écriture). Le tampon
+ * est détaché une seule fois, lorsque l'accès en écriture est obtenu via
+ * Corps::attribut, Corps::ajoute_attribut ou Corps::attributs, et non par les
+ * accès aux éléments (donnees, valeur, ...) qui peuvent donc être utilisés
+ * dans des threads. Un pointeur obtenu avant que l'attribut ne soit copié doit
+ * être détaché à nouveau avant d'être modifié.
+ */
 class Attribut {
     dls::chaine m_nom;
     type_attribut m_type;
@@ -158,7 +167,7 @@ class Attribut {
     portee_attr portee;
     int dimensions = 0;
 
-    Attribut(Attribut const &rhs);
+    Attribut(Attribut const &rhs) = default;
 
     Attribut(dls::chaine const &nom,
              type_attribut type,
@@ -190,7 +199,6 @@ class Attribut {
         assert(idx >= 0);
         assert(idx < taille());
         assert(this->type() == type_attribut_depuis_type<T>::type);
-        detache();
         return reinterpret_cast<T *>(
             &(*m_tampon)[idx * dimensions * static_cast<long>(sizeof(T))]);
     }
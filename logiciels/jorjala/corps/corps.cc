@@ -111,6 +111,9 @@ Attribut *Corps::attribut(const dls::chaine &nom_attribut)
             continue;
         }
 
+        /* L'attribut peut être modifié via le pointeur, possiblement dans des
+         * threads, donc détache ses données dès maintenant. */
+        attr.detache();
         return &attr;
     }
 
@@ -233,23 +236,30 @@ void Corps::copie_vers(Corps *corps) const
     corps->m_prims = this->m_prims;
     corps->m_nombre_sommets = this->nombre_sommets();
 
-    /* copie les attributs */
-    for (auto attr : this->m_attributs) {
+    /* copie les attributs, leurs données sont partagées jusqu'à leur
+     * prochaine modification */
+    for (auto const &attr : this->m_attributs) {
         corps->m_attributs.ajoute(attr);
     }
 
     /* copie les groupes */
-    for (auto groupe : this->m_groupes_points) {
+    for (auto const &groupe : this->m_groupes_points) {
         corps->m_groupes_points.ajoute(groupe);
     }
 
-    for (auto groupe : this->m_groupes_prims) {
+    for (auto const &groupe : this->m_groupes_prims) {
         corps->m_groupes_prims.ajoute(groupe);
     }
 }
 
 Corps::plage_attributs Corps::attributs()
 {
+    /* Voir Corps::attribut. Utiliser la version constante pour les accès en
+     * lecture, afin de ne pas copier les données partagées. */
+    for (auto &attr : m_attributs) {
+        attr.detache();
+    }
+
     return plage_attributs(m_attributs.debut(), m_attributs.fin());
 }
 
@@ -79,6 +79,10 @@ struct Corps {
 
     void supprime_attribut(dls::chaine const &nom_attribut);
 
+    /**
+     * Retourne l'attribut du nom donné, en détachant ses données si elles sont
+     * partagées avec un autre corps, afin de pouvoir le modifier.
+     */
     Attribut *attribut(dls::chaine const &nom_attribut);
 
     Attribut const *attribut(dls::chaine const &nom_attribut) const;
@@ -124,6 +128,11 @@ struct Corps {
 
     void copie_vers(Corps *corps) const;
 
+    /**
+     * Détache les données des attributs retournés afin de pouvoir les modifier,
+     * possiblement dans des threads. Utiliser la version constante pour les
+     * accès en lecture.
+     */
     plage_attributs attributs();
 
     plage_const_attributs attributs() const;
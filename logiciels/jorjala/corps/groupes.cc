@@ -114,6 +114,7 @@ void GroupePrimitive::ajoute_index(long index_poly)
 
 void GroupePrimitive::remplace_index(long i, long j)
 {
+    detache();
     (*this->m_primitives)[i] = j;
 }
 
@@ -210,6 +210,7 @@ void ListePrimitives::reinitialise()
 void ListePrimitives::redimensionne(long const nombre)
 {
     assert(nombre >= 0);
+    detache();
     m_primitives->redimensionne(nombre);
 }
 
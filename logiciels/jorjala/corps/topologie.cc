@@ -0,0 +1,85 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * The Original Code is Copyright (C) 2026 Kévin Dietrich. */
+
+#include "topologie.hh"
+
+#include <cassert>
+#include <limits>
+
+#include "corps.h"
+
+static bool polygone_est_filtre(Polygone const *polygone, filtre_polygones filtre)
+{
+    switch (filtre) {
+        case filtre_polygones::TOUS:
+            return false;
+        case filtre_polygones::FERMES:
+            return polygone->type != type_polygone::FERME;
+        case filtre_polygones::OUVERTS:
+            return polygone->type != type_polygone::OUVERT;
+    }
+
+    return false;
+}
+
+TopologiePolygones construit_topologie_polygones(Corps const &corps, filtre_polygones filtre)
+{
+    auto prims = corps.prims();
+    auto resultat = TopologiePolygones{};
+
+    /* Premier passage pour ne faire qu'une seule allocation par tableau. */
+    auto nombre_polygones = 0l;
+    auto nombre_sommets = 0l;
+
+    for (auto i = 0; i < prims->taille(); ++i) {
+        auto prim = prims->prim(i);
+
+        if (prim->type_prim() != type_primitive::POLYGONE) {
+            continue;
+        }
+
+        auto polygone = static_cast<Polygone const *>(prim);
+
+        if (polygone_est_filtre(polygone, filtre)) {
+            continue;
+        }
+
+        nombre_polygones += 1;
+        nombre_sommets += polygone->nombre_sommets();
+    }
+
+    assert(nombre_sommets <= std::numeric_limits<int>::max());
+
+    resultat.decalages.reserve(nombre_polygones + 1);
+    resultat.types.reserve(nombre_polygones);
+    resultat.index_primitives.reserve(nombre_polygones);
+    resultat.index_points.reserve(nombre_sommets);
+    resultat.index_sommets.reserve(nombre_sommets);
+
+    resultat.decalages.ajoute(0);
+
+    for (auto i = 0; i < prims->taille(); ++i) {
+        auto prim = prims->prim(i);
+
+        if (prim->type_prim() != type_primitive::POLYGONE) {
+            continue;
+        }
+
+        auto polygone = static_cast<Polygone const *>(prim);
+
+        if (polygone_est_filtre(polygone, filtre)) {
+            continue;
+        }
+
+        for (auto j = 0; j < polygone->nombre_sommets(); ++j) {
+            resultat.index_points.ajoute(static_cast<int>(polygone->index_point(j)));
+            resultat.index_sommets.ajoute(static_cast<int>(polygone->index_sommet(j)));
+        }
+
+        resultat.decalages.ajoute(static_cast<int>(resultat.index_points.taille()));
+        resultat.types.ajoute(polygone->type);
+        resultat.index_primitives.ajoute(static_cast<int>(polygone->index));
+    }
+
+    return resultat;
+}
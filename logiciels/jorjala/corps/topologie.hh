@@ -0,0 +1,74 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * The Original Code is Copyright (C) 2026 Kévin Dietrich. */
+
+#pragma once
+
+#include "biblinternes/structures/tableau.hh"
+
+#include "listes.h"
+
+struct Corps;
+
+enum class filtre_polygones : char {
+    TOUS,
+    FERMES,
+    OUVERTS,
+};
+
+/**
+ * Topologie des polygones d'un corps stockée de manière contiguë (format CSR) :
+ * les index des points et des sommets de tous les polygones se suivent dans
+ * deux tableaux, et les sommets du polygone i se trouvent dans la plage
+ * [decalages[i], decalages[i + 1]).
+ *
+ * Les polygones sont rangés dans l'ordre de la liste de primitives du corps,
+ * les autres primitives (sphères, volumes) étant ignorées. Ceci permet aux
+ * algorithmes de parcourir les polygones de manière linéaire, et en parallèle,
+ * sans déréférencer chaque primitive.
+ *
+ * La topologie est une copie : elle doit être reconstruite si les primitives
+ * du corps sont modifiées.
+ */
+struct TopologiePolygones {
+    dls::tableau<int> decalages{};
+    dls::tableau<int> index_points{};
+    dls::tableau<int> index_sommets{};
+    dls::tableau<type_polygone> types{};
+    /* Index du polygone dans la liste de primitives du corps. */
+    dls::tableau<int> index_primitives{};
+
+    long nombre_polygones() const
+    {
+        return types.taille();
+    }
+
+    long nombre_sommets_total() const
+    {
+        return index_points.taille();
+    }
+
+    long nombre_sommets(long i) const
+    {
+        return decalages[i + 1] - decalages[i];
+    }
+
+    int index_point(long i, long j) const
+    {
+        return index_points[decalages[i] + j];
+    }
+
+    int index_sommet(long i, long j) const
+    {
+        return index_sommets[decalages[i] + j];
+    }
+
+    /* Retourne un pointeur vers les index des points du polygone i, qui sont
+     * au nombre de nombre_sommets(i). */
+    int const *points_polygone(long i) const
+    {
+        return index_points.donnees() + decalages[i];
+    }
+};
+
+TopologiePolygones construit_topologie_polygones(
+    Corps const &corps, filtre_polygones filtre = filtre_polygones::TOUS);
@@ -123,7 +123,10 @@ static void evalue_objet(ContexteEvaluation const &contexte, Objet *objet)
 
     /* on garde une copie pour l'évaluation dans des threads séparés, copie
      * nécessaire pour pouvoir rendre l'objet dans la vue quand le rendu prend
-     * plus de temps que l'évaluation asynchrone. */
+     * plus de temps que l'évaluation asynchrone. Les données des points, des
+     * primitives, des attributs et des groupes sont partagées avec le corps de
+     * l'opératrice et ne seront copiées que lors de leurs prochaines
+     * modifications. */
     objet->donnees.accede_ecriture([operatrice](DonneesObjet *donnees_objet) {
         auto &_corps_ = extrait_corps(donnees_objet);
         _corps_.reinitialise();
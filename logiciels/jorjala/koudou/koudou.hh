@@ -79,6 +79,12 @@ struct ParametresRendu {
     unsigned int largeur_carreau = 32;
     double biais_ombre = 1e-4;
 
+    /* Un carreau n'est plus échantillonné une fois que l'erreur relative
+     * estimée de ses pixels passe sous ce seuil, et qu'il a reçu au moins
+     * echantillons_minimum échantillons. Un seuil nul désactive ceci. */
+    double seuil_bruit = 0.01;
+    unsigned int echantillons_minimum = 4;
+
     Scene scene{};
 
 #ifdef NOUVELLE_CAMERA
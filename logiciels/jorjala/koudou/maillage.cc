@@ -62,6 +62,41 @@ void delegue_maillage::coords_element(int idx, dls::tableau<dls::math::vec3f> &c
     }
 }
 
+BoiteEnglobante delegue_maillage::boite_englobante(long idx) const
+{
+    auto boite = BoiteEnglobante{};
+
+    auto etends = [&](int index_point) {
+        auto const &p = ptr_maillage.points[index_point];
+
+        for (auto j = 0ul; j < 3; ++j) {
+            boite.min[j] = std::min(boite.min[j], static_cast<double>(p[j]));
+            boite.max[j] = std::max(boite.max[j], static_cast<double>(p[j]));
+        }
+    };
+
+    if (idx < ptr_maillage.nombre_triangles) {
+        auto idx_tri = idx * 3;
+
+        etends(ptr_maillage.triangles[idx_tri]);
+        etends(ptr_maillage.triangles[idx_tri + 1]);
+        etends(ptr_maillage.triangles[idx_tri + 2]);
+    }
+    else {
+        auto idx_quad = (idx - ptr_maillage.nombre_triangles) * 4;
+
+        etends(ptr_maillage.quads[idx_quad]);
+        etends(ptr_maillage.quads[idx_quad + 1]);
+        etends(ptr_maillage.quads[idx_quad + 2]);
+        etends(ptr_maillage.quads[idx_quad + 3]);
+    }
+
+    boite.centroide = (boite.min + boite.max) * 0.5;
+    boite.id = idx;
+
+    return boite;
+}
+
 dls::phys::esectd delegue_maillage::intersecte_element(long idx,
                                                        const dls::phys::rayond &rayon) const
 {
@@ -206,12 +241,13 @@ maillage::maillage() : noeud(type_noeud::MAILLAGE), delegue(*this)
 
 void maillage::construit_arbre_hbe()
 {
-    arbre_hbe = bli::cree_arbre_bvh(delegue);
+    auto arbre_binaire = ::construit_arbre_hbe(delegue, PROFONDEUR_MAX);
+    arbre_hbe_large = construit_arbre_hbe_large(arbre_binaire);
 }
 
 dls::phys::esectd maillage::traverse_arbre(const dls::phys::rayond &rayon)
 {
-    return bli::traverse(arbre_hbe, delegue, rayon);
+    return traverse(arbre_hbe_large, delegue, rayon);
 }
 
 limites3d maillage::calcule_limites()
@@ -28,6 +28,8 @@
 
 #include "biblinternes/structures/tableau.hh"
 
+#include "coeur/arbre_hbe_large.hh"
+
 #include "noeud.hh"
 #include "tableau_index.hh"
 
@@ -44,6 +46,8 @@ struct delegue_maillage {
 
     void coords_element(int idx, dls::tableau<dls::math::vec3f> &cos) const;
 
+    BoiteEnglobante boite_englobante(long idx) const;
+
     dls::phys::esectd intersecte_element(long idx, dls::phys::rayond const &rayon) const;
 };
 
@@ -132,6 +136,7 @@ struct maillage : public noeud {
     tableau_index normaux_quads{};
 
     delegue_maillage delegue;
+    ArbreHBELarge arbre_hbe_large{};
 
     int nombre_triangles = 0;
     int nombre_quads = 0;
@@ -261,90 +261,149 @@ Spectre calcul_spectre(GNA &gna,
 
 /* ************************************************************************** */
 
-void MoteurRendu::echantillone_scene(ParametresRendu const &parametres,
+static void echantillone_carreau(GNA &gna,
+                                 ParametresRendu const &parametres,
+                                 PelliculeCarreau &pellicule_carreau)
+{
+    auto camera = parametres.camera;
+    auto const &carreau = pellicule_carreau.carreau();
+
+    /* utilisation de tableaux pour permettre une certaine vectorisation
+     * future des opérations
+     */
+
+    dls::tableau<vision::EchantillonCamera> echants;
+    echants.reserve(carreau.largeur * carreau.hauteur);
+
+    dls::tableau<dls::phys::rayond> rayons;
+    rayons.reserve(carreau.largeur * carreau.hauteur);
+
+    for (auto y = carreau.y; y < carreau.y + carreau.hauteur; ++y) {
+        for (auto x = carreau.x; x < carreau.x + carreau.largeur; ++x) {
+            // auto echantillon_camera = genere_echantillon_cmj(x + camera->largeur() *
+            // y, camera->hauteur(), camera->largeur(), echantillon);
+            auto echantillon_camera = genere_echantillon(gna, x, y);
+            echants.ajoute(echantillon_camera);
+
+            auto rayon = genere_rayon(camera, echantillon_camera);
+            rayons.ajoute(rayon);
+        }
+    }
+
+#ifdef STATISTIQUES
+    statistiques.nombre_rayons_primaires.fetch_add(static_cast<unsigned>(rayons.taille()));
+#endif
+
+    dls::tableau<Spectre> spectres;
+    spectres.reserve(carreau.largeur * carreau.hauteur);
+
+    for (auto &rayon : rayons) {
+        auto spectre = calcul_spectre(gna, parametres, rayon);
+        spectres.ajoute(spectre);
+    }
+
+    /* Corrige gamma. */
+    for (auto &spectre : spectres) {
+        spectre = puissance(spectre, 0.45f);
+    }
+
+    auto index = 0;
+    for (auto y = carreau.y; y < carreau.y + carreau.hauteur; ++y) {
+        for (auto x = carreau.x; x < carreau.x + carreau.largeur; ++x, ++index) {
+            float rgb[3];
+            spectres[index].vers_rvb(rgb);
+
+            auto const clr = dls::math::vec3d(rgb[0], rgb[1], rgb[2]);
+
+            auto const echant = echants[index];
+
+            auto const frac0_x = echant.x - static_cast<int>(echant.x);
+            auto const frac0_y = echant.y - static_cast<int>(echant.y);
+            auto const frac1_x = 1.0 - frac0_x;
+            auto const frac1_y = 1.0 - frac0_y;
+
+            pellicule_carreau.ajoute_echantillon(x, y, clr, frac1_x * frac1_y);
+            pellicule_carreau.ajoute_echantillon(x + 1, y, clr, frac0_x * frac1_y);
+            pellicule_carreau.ajoute_echantillon(x + 1, y + 1, clr, frac0_x * frac0_y);
+            pellicule_carreau.ajoute_echantillon(x, y + 1, clr, frac1_x * frac0_y);
+
+            pellicule_carreau.ajoute_luminance(x, y, static_cast<double>(spectres[index].y()));
+        }
+    }
+
+    pellicule_carreau.termine_passe();
+}
+
+long MoteurRendu::echantillone_scene(ParametresRendu const &parametres,
                                      dls::tableau<CarreauPellicule> const &carreaux,
                                      unsigned int echantillon)
 {
-    auto camera = parametres.camera;
+    if (echantillon == 0 || m_pellicules_carreaux.taille() != carreaux.taille()) {
+        m_pellicules_carreaux.efface();
+        m_pellicules_carreaux.reserve(carreaux.taille());
 
-    m_pellicule.redimensionne(dls::math::Hauteur(camera->hauteur()),
-                              dls::math::Largeur(camera->largeur()));
+        for (auto const &carreau : carreaux) {
+            m_pellicules_carreaux.ajoute(PelliculeCarreau(carreau));
+        }
+    }
 
     tbb::parallel_for(
         tbb::blocked_range<long>(0, carreaux.taille()),
         [&](tbb::blocked_range<long> const &plage) {
-            auto gna = GNA(static_cast<unsigned long>(17771 + plage.begin() * (echantillon + 1)));
-
             for (auto j = plage.begin(); j < plage.end(); ++j) {
-                auto const &carreau = carreaux[j];
-                /* utilisation de tableaux pour permettre une certaine vectorisation
-                 * future des opérations
-                 */
-
-                dls::tableau<vision::EchantillonCamera> echants;
-                echants.reserve(carreau.largeur * carreau.hauteur);
-
-                dls::tableau<dls::phys::rayond> rayons;
-                rayons.reserve(carreau.largeur * carreau.hauteur);
-
-                for (auto x = carreau.x; x < carreau.x + carreau.largeur; ++x) {
-                    for (auto y = carreau.y; y < carreau.y + carreau.hauteur; ++y) {
-                        // auto echantillon_camera = genere_echantillon_cmj(x + camera->largeur() *
-                        // y, camera->hauteur(), camera->largeur(), echantillon);
-                        auto echantillon_camera = genere_echantillon(gna, x, y);
-                        echants.ajoute(echantillon_camera);
-
-                        auto rayon = genere_rayon(camera, echantillon_camera);
-                        rayons.ajoute(rayon);
-                    }
+                auto &pellicule_carreau = m_pellicules_carreaux[j];
+
+                if (pellicule_carreau.a_converge()) {
+                    continue;
                 }
 
-#ifdef STATISTIQUES
-                statistiques.nombre_rayons_primaires.fetch_add(
-                    static_cast<unsigned>(rayons.taille()));
-#endif
+                /* Une graine par carreau et par échantillon, pour que le résultat
+                 * ne dépende pas du découpage des plages. */
+                auto gna = GNA(
+                    static_cast<unsigned long>(17771 + echantillon * carreaux.taille() + j));
 
-                dls::tableau<Spectre> spectres;
-                spectres.reserve(carreau.largeur * carreau.hauteur);
+                echantillone_carreau(gna, parametres, pellicule_carreau);
 
-                for (auto &rayon : rayons) {
-                    auto spectre = calcul_spectre(gna, parametres, rayon);
-                    spectres.ajoute(spectre);
+                if (parametres.seuil_bruit <= 0.0 ||
+                    pellicule_carreau.nombre_echantillons() < parametres.echantillons_minimum) {
+                    continue;
                 }
 
-                /* Corrige gamma. */
-                for (auto &spectre : spectres) {
-                    spectre = puissance(spectre, 0.45f);
+                if (pellicule_carreau.estime_erreur() < parametres.seuil_bruit) {
+                    pellicule_carreau.marque_converge();
                 }
+            }
+        });
+
+    auto carreaux_restants = 0l;
 
-                auto index = 0;
-                for (auto x = carreau.x; x < carreau.x + carreau.largeur; ++x) {
-                    for (auto y = carreau.y; y < carreau.y + carreau.hauteur; ++y, ++index) {
-                        float rgb[3];
-                        spectres[index].vers_rvb(rgb);
+    for (auto const &pellicule_carreau : m_pellicules_carreaux) {
+        if (!pellicule_carreau.a_converge()) {
+            carreaux_restants += 1;
+        }
+    }
 
-                        auto const clr = dls::math::vec3d(rgb[0], rgb[1], rgb[2]);
+    return carreaux_restants;
+}
 
-                        auto const echant = echants[index];
+void MoteurRendu::rappel_progres(type_rappel_progres rappel)
+{
+    m_rappel_progres = std::move(rappel);
+}
 
-                        auto const frac0_x = echant.x - static_cast<int>(echant.x);
-                        auto const frac0_y = echant.y - static_cast<int>(echant.y);
-                        auto const frac1_x = 1.0 - frac0_x;
-                        auto const frac1_y = 1.0 - frac0_y;
+void MoteurRendu::signale_progres(unsigned int echantillon)
+{
+    if (!m_rappel_progres) {
+        return;
+    }
 
-                        m_pellicule.ajoute_echantillon(x, y, clr, frac1_x * frac1_y);
-                        m_pellicule.ajoute_echantillon(x + 1, y, clr, frac0_x * frac1_y);
-                        m_pellicule.ajoute_echantillon(x + 1, y + 1, clr, frac0_x * frac0_y);
-                        m_pellicule.ajoute_echantillon(x, y + 1, clr, frac1_x * frac0_y);
-                    }
-                }
-            }
-        });
+    m_rappel_progres(pellicule(), echantillon);
 }
 
 void MoteurRendu::reinitialise()
 {
     m_pellicule.reinitialise();
+    m_pellicules_carreaux.efface();
     m_est_arrete = false;
 }
 
@@ -355,6 +414,7 @@ Pellicule *MoteurRendu::pointeur_pellicule()
 
 Pellicule const &MoteurRendu::pellicule()
 {
+    m_pellicule.fusionne(m_pellicules_carreaux);
     m_pellicule.creer_image();
     return m_pellicule;
 }
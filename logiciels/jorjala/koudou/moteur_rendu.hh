@@ -24,6 +24,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include "biblinternes/phys/rayon.hh"
 #include "biblinternes/phys/spectre.hh"
 
@@ -35,15 +37,30 @@ namespace kdo {
 
 class ParametresRendu;
 
+/* Appelée après chaque passe d'échantillonnage avec l'image composée jusque
+ * là, pour pouvoir l'afficher avant la fin du rendu. */
+using type_rappel_progres = std::function<void(Pellicule const &, unsigned int)>;
+
 class MoteurRendu {
     Pellicule m_pellicule{};
+    dls::tableau<PelliculeCarreau> m_pellicules_carreaux{};
+    type_rappel_progres m_rappel_progres{};
     bool m_est_arrete = false;
 
   public:
-    void echantillone_scene(ParametresRendu const &parametres,
+    /* Tire un échantillon par pixel dans chaque carreau n'ayant pas encore
+     * convergé, et retourne le nombre de carreaux restant à échantillonner.
+     * Les pellicules des carreaux sont recréées au premier échantillon. */
+    long echantillone_scene(ParametresRendu const &parametres,
                             dls::tableau<CarreauPellicule> const &carreaux,
                             unsigned int echantillon);
 
+    void rappel_progres(type_rappel_progres rappel);
+
+    /* Compose l'image et la passe au rappel de progrès, s'il y en a un. */
+    void signale_progres(unsigned int echantillon);
+
+    /* Compose l'image depuis les pellicules des carreaux. */
     Pellicule const &pellicule();
 
     void reinitialise();
@@ -24,8 +24,110 @@
 
 #include "pellicule.hh"
 
+#include <cassert>
+#include <cmath>
+#include <tbb/parallel_for.h>
+
+#include "biblinternes/outils/constantes.h"
+
 namespace kdo {
 
+PelliculeCarreau::PelliculeCarreau(CarreauPellicule const &carreau)
+    : m_carreau(carreau), m_largeur(carreau.largeur + BORDURE),
+      m_hauteur(carreau.hauteur + BORDURE)
+{
+    m_pixels.redimensionne(m_largeur * m_hauteur);
+    m_moments.redimensionne(static_cast<long>(carreau.largeur) *
+                            static_cast<long>(carreau.hauteur));
+}
+
+CarreauPellicule const &PelliculeCarreau::carreau() const
+{
+    return m_carreau;
+}
+
+void PelliculeCarreau::ajoute_echantillon(long x,
+                                          long y,
+                                          dls::math::vec3d const &couleur,
+                                          const double poids)
+{
+    auto const xx = x - m_carreau.x;
+    auto const yy = y - m_carreau.y;
+
+    assert(xx >= 0 && xx < m_largeur);
+    assert(yy >= 0 && yy < m_hauteur);
+
+    auto &pixel_pellicule = m_pixels[xx + m_largeur * yy];
+    pixel_pellicule.couleur += couleur * poids;
+    pixel_pellicule.poids += poids;
+}
+
+void PelliculeCarreau::ajoute_luminance(long x, long y, double luminance)
+{
+    auto const xx = x - m_carreau.x;
+    auto const yy = y - m_carreau.y;
+
+    assert(xx >= 0 && xx < m_carreau.largeur);
+    assert(yy >= 0 && yy < m_carreau.hauteur);
+
+    auto &moments = m_moments[xx + m_carreau.largeur * yy];
+    moments.somme += luminance;
+    moments.somme_carres += luminance * luminance;
+}
+
+PixelPellicule const &PelliculeCarreau::pixel(long x, long y) const
+{
+    return m_pixels[(x - m_carreau.x) + m_largeur * (y - m_carreau.y)];
+}
+
+void PelliculeCarreau::termine_passe()
+{
+    m_nombre_echantillons += 1;
+}
+
+unsigned int PelliculeCarreau::nombre_echantillons() const
+{
+    return m_nombre_echantillons;
+}
+
+double PelliculeCarreau::estime_erreur() const
+{
+    if (m_nombre_echantillons < 2) {
+        return constantes<double>::INFINITE;
+    }
+
+    if (m_moments.est_vide()) {
+        return 0.0;
+    }
+
+    auto const n = static_cast<double>(m_nombre_echantillons);
+    auto erreur = 0.0;
+
+    for (auto const &moments : m_moments) {
+        auto const moyenne = moments.somme / n;
+        auto const variance = std::max(0.0, moments.somme_carres / n - moyenne * moyenne) * n /
+                              (n - 1.0);
+
+        /* Borne la luminance des pixels sombres, dont l'erreur relative
+         * serait sinon démesurée. */
+        erreur += std::sqrt(variance / n) / std::max(moyenne, 1e-2);
+    }
+
+    return erreur / static_cast<double>(m_moments.taille());
+}
+
+bool PelliculeCarreau::a_converge() const
+{
+    return m_a_converge;
+}
+
+void PelliculeCarreau::marque_converge()
+{
+    m_a_converge = true;
+}
+
+/* ************************************************************************** */
+
 Pellicule::Pellicule()
 {
 }
@@ -40,20 +142,6 @@ int Pellicule::largeur() const
     return m_matrice.desc().resolution.x;
 }
 
-void Pellicule::ajoute_echantillon(long i,
-                                   long j,
-                                   dls::math::vec3d const &couleur,
-                                   const double poids)
-{
-    auto ii = std::min(i, static_cast<long>(largeur() - 1));
-    auto jj = std::min(j, static_cast<long>(hauteur() - 1));
-
-    auto index = ii + static_cast<long>(largeur()) * jj;
-    auto &pixel_pellicule = m_pixels_pellicule[index];
-    pixel_pellicule.couleur += couleur * poids;
-    pixel_pellicule.poids += poids;
-}
-
 dls::math::vec3d const &Pellicule::couleur(int i, int j)
 {
     return m_matrice.valeur(dls::math::vec2i(i, j));
@@ -88,7 +176,7 @@ void Pellicule::creer_image()
 
             if (pixel_pellicule.poids == 0.0) {
                 m_matrice.valeur(index) = dls::math::vec3d(0.0);
-                return;
+                continue;
             }
 
             m_matrice.valeur(index) = pixel_pellicule.couleur / pixel_pellicule.poids;
@@ -96,6 +184,64 @@ void Pellicule::creer_image()
     }
 }
 
+void Pellicule::fusionne(dls::tableau<PelliculeCarreau> const &pellicules_carreaux)
+{
+    reinitialise();
+
+    auto const largeur_image = static_cast<long>(largeur());
+    auto const hauteur_image = static_cast<long>(hauteur());
+
+    /* Les carreaux ne se chevauchant pas, leurs intérieurs peuvent être copiés
+     * en parallèle. */
+    tbb::parallel_for(
+        tbb::blocked_range<long>(0, pellicules_carreaux.taille()),
+        [&](tbb::blocked_range<long> const &plage) {
+            for (auto i = plage.begin(); i < plage.end(); ++i) {
+                auto const &pellicule_carreau = pellicules_carreaux[i];
+                auto const &carreau = pellicule_carreau.carreau();
+
+                assert(carreau.x + carreau.largeur <= largeur_image);
+                assert(carreau.y + carreau.hauteur <= hauteur_image);
+
+                for (long y = carreau.y; y < carreau.y + carreau.hauteur; ++y) {
+                    for (long x = carreau.x; x < carreau.x + carreau.largeur; ++x) {
+                        m_pixels_pellicule[x + largeur_image * y] = pellicule_carreau.pixel(x, y);
+                    }
+                }
+            }
+        });
+
+    /* Les bordures recouvrent les carreaux voisins, elles sont donc ajoutées
+     * en série ; elles ne représentent que peu de pixels. */
+    for (auto const &pellicule_carreau : pellicules_carreaux) {
+        auto const &carreau = pellicule_carreau.carreau();
+        auto const fin_x = static_cast<long>(carreau.x + carreau.largeur);
+        auto const fin_y = static_cast<long>(carreau.y + carreau.hauteur);
+
+        auto ajoute_pixel_bordure = [&](long x, long y) {
+            auto const &source = pellicule_carreau.pixel(x, y);
+            auto const ii = std::min(x, largeur_image - 1);
+            auto const jj = std::min(y, hauteur_image - 1);
+
+            auto &pixel_pellicule = m_pixels_pellicule[ii + largeur_image * jj];
+            pixel_pellicule.couleur += source.couleur;
+            pixel_pellicule.poids += source.poids;
+        };
+
+        for (long y = carreau.y; y < fin_y + PelliculeCarreau::BORDURE; ++y) {
+            for (long x = fin_x; x < fin_x + PelliculeCarreau::BORDURE; ++x) {
+                ajoute_pixel_bordure(x, y);
+            }
+        }
+
+        for (long y = fin_y; y < fin_y + PelliculeCarreau::BORDURE; ++y) {
+            for (long x = carreau.x; x < fin_x; ++x) {
+                ajoute_pixel_bordure(x, y);
+            }
+        }
+    }
+}
+
 void Pellicule::redimensionne(dls::math::Hauteur const &hauteur, dls::math::Largeur const &largeur)
 {
     auto moitie_x = static_cast<float>(largeur.valeur) * 0.5f;
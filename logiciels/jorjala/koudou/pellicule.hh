@@ -44,6 +44,73 @@ struct PixelPellicule {
     double poids{};
 };
 
+/* Sommes de la luminance des échantillons tirés dans un pixel et de son carré,
+ * pour en estimer la variance. */
+struct MomentsPixel {
+    double somme = 0.0;
+    double somme_carres = 0.0;
+};
+
+/**
+ * Pellicule propre à un carreau. Les tâches de rendu n'accumulent leurs
+ * échantillons que dans la pellicule du carreau qu'elles traitent, chaque
+ * pellicule ayant ses propres tampons : aucun pixel, ni aucune ligne de cache,
+ * n'est écrit par deux tâches à la fois.
+ *
+ * Un échantillon étant réparti entre son pixel et les pixels voisins à droite
+ * et en bas, la pellicule déborde du carreau d'une bordure de BORDURE pixels
+ * de ces côtés. La bordure est additionnée aux carreaux voisins lors de la
+ * fusion dans la Pellicule de l'image.
+ */
+class PelliculeCarreau {
+    CarreauPellicule m_carreau{};
+    long m_largeur = 0;
+    long m_hauteur = 0;
+
+    dls::tableau<PixelPellicule> m_pixels{};
+    dls::tableau<MomentsPixel> m_moments{};
+
+    unsigned int m_nombre_echantillons = 0;
+    bool m_a_converge = false;
+
+  public:
+    static constexpr long BORDURE = 1;
+
+    PelliculeCarreau() = default;
+
+    explicit PelliculeCarreau(CarreauPellicule const &carreau);
+
+    CarreauPellicule const &carreau() const;
+
+    /* x et y sont les coordonnées du pixel dans l'image, et doivent se
+     * trouver dans le carreau ou dans sa bordure. */
+    void ajoute_echantillon(long x,
+                            long y,
+                            dls::math::vec3d const &couleur,
+                            const double poids = 1.0);
+
+    /* Ajoute la luminance d'un échantillon tiré dans le pixel (x, y) du
+     * carreau, hors bordure. */
+    void ajoute_luminance(long x, long y, double luminance);
+
+    /* Retourne le pixel (x, y) de l'image, qui doit se trouver dans le carreau
+     * ou dans sa bordure. */
+    PixelPellicule const &pixel(long x, long y) const;
+
+    /* Signale que chaque pixel du carreau a reçu un échantillon de plus. */
+    void termine_passe();
+
+    unsigned int nombre_echantillons() const;
+
+    /* Retourne la moyenne sur les pixels de l'erreur type relative de leur
+     * luminance, ou l'infini s'il y a moins de deux échantillons. */
+    double estime_erreur() const;
+
+    bool a_converge() const;
+
+    void marque_converge();
+};
+
 class Pellicule {
   public:
     using type_grille = wlk::grille_dense_2d<dls::math::vec3d>;
@@ -60,13 +127,13 @@ class Pellicule {
 
     int largeur() const;
 
-    void ajoute_echantillon(long i,
-                            long j,
-                            dls::math::vec3d const &couleur,
-                            const double poids = 1.0);
-
     dls::math::vec3d const &couleur(int i, int j);
 
+    /* Compose les pixels de l'image depuis les pellicules des carreaux, qui
+     * doivent recouvrir l'image sans se chevaucher (hors bordures). Les pixels
+     * des bordures sortant de l'image sont ramenés sur ses derniers pixels. */
+    void fusionne(dls::tableau<PelliculeCarreau> const &pellicules_carreaux);
+
     type_grille const &donnees() const;
 
     void reinitialise();
@@ -110,7 +110,8 @@ void Scene::reinitialise()
         }
     }
 
-    memoire::deloge("ArbreBVH", arbre_hbe);
+    arbre_hbe = ArbreHBELarge{};
+    index_noeuds_arbre_hbe.efface();
 
     noeuds.efface();
     volumes.efface();
@@ -118,20 +119,38 @@ void Scene::reinitialise()
 
 void Scene::construit_arbre_hbe()
 {
-    arbre_hbe = bli::cree_arbre_bvh(delegue);
+    index_noeuds_arbre_hbe.efface();
+
+    for (auto i = 0l; i < noeuds.taille(); ++i) {
+        auto n = noeuds[i];
 
-    for (auto n : noeuds) {
         if (n->type == type_noeud::LUMIERE) {
             continue;
         }
 
         n->construit_arbre_hbe();
+
+        auto const lims = n->calcule_limites();
+
+        /* Un noeud sans géométrie n'a pas de limites valides. */
+        if (lims.min.x > lims.max.x) {
+            continue;
+        }
+
+        index_noeuds_arbre_hbe.ajoute(i);
+    }
+
+    if (index_noeuds_arbre_hbe.est_vide()) {
+        arbre_hbe = ArbreHBELarge{};
+        return;
     }
+
+    arbre_hbe = construit_arbre_hbe_large(::construit_arbre_hbe(delegue, PROFONDEUR_MAX));
 }
 
 dls::phys::esectd Scene::traverse(const dls::phys::rayond &r) const
 {
-    return bli::traverse(arbre_hbe, delegue, r);
+    return ::traverse(arbre_hbe, delegue, r);
 }
 
 /* ************************************************************************** */
@@ -273,12 +292,12 @@ delegue_scene::delegue_scene(const Scene &scene) : ptr_scene(scene)
 
 long delegue_scene::nombre_elements() const
 {
-    return ptr_scene.noeuds.taille();
+    return ptr_scene.index_noeuds_arbre_hbe.taille();
 }
 
 void delegue_scene::coords_element(int idx, dls::tableau<dls::math::vec3f> &cos) const
 {
-    auto n = ptr_scene.noeuds[idx];
+    auto n = ptr_scene.noeuds[ptr_scene.index_noeuds_arbre_hbe[idx]];
 
     auto lims = n->calcule_limites();
 
@@ -287,9 +306,23 @@ void delegue_scene::coords_element(int idx, dls::tableau<dls::math::vec3f> &cos)
     cos.ajoute(dls::math::converti_type<float>(lims.max));
 }
 
+BoiteEnglobante delegue_scene::boite_englobante(long idx) const
+{
+    auto n = ptr_scene.noeuds[ptr_scene.index_noeuds_arbre_hbe[idx]];
+    auto lims = n->calcule_limites();
+
+    auto boite = BoiteEnglobante{};
+    boite.min = dls::math::point3d(lims.min);
+    boite.max = dls::math::point3d(lims.max);
+    boite.centroide = (boite.min + boite.max) * 0.5;
+    boite.id = idx;
+
+    return boite;
+}
+
 dls::phys::esectd delegue_scene::intersecte_element(long idx, const dls::phys::rayond &r) const
 {
-    auto n = ptr_scene.noeuds[idx];
+    auto n = ptr_scene.noeuds[ptr_scene.index_noeuds_arbre_hbe[idx]];
     return n->traverse_arbre(r);
 }
 
@@ -29,7 +29,7 @@
 #include "biblinternes/phys/spectre.hh"
 #include "biblinternes/structures/tableau.hh"
 
-#include "coeur/arbre_hbe.hh"
+#include "coeur/arbre_hbe_large.hh"
 
 #include "wolika/grille_eparse.hh"
 
@@ -74,6 +74,8 @@ struct delegue_scene {
 
     void coords_element(int idx, dls::tableau<dls::math::vec3f> &cos) const;
 
+    BoiteEnglobante boite_englobante(long idx) const;
+
     dls::phys::esectd intersecte_element(long idx, const dls::phys::rayond &r) const;
 };
 
@@ -84,7 +86,10 @@ struct Scene {
 
     dls::tableau<noeud *> noeuds{};
     delegue_scene delegue;
-    bli::BVHTree *arbre_hbe = nullptr;
+    ArbreHBELarge arbre_hbe{};
+    /* Index des noeuds ayant une géométrie, les seuls à être dans l'arbre HBE :
+     * les lumières n'ont pas de limites et ne peuvent être intersectées. */
+    dls::tableau<long> index_noeuds_arbre_hbe{};
 
     Scene();
     ~Scene();
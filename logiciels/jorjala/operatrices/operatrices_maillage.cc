@@ -39,6 +39,7 @@
 #include "corps/iteration_corps.hh"
 #include "corps/limites_corps.hh"
 #include "corps/polyedre.hh"
+#include "corps/topologie.hh"
 
 #include "coeur/chef_execution.hh"
 #include "coeur/contexte_evaluation.hh"
@@ -59,23 +60,26 @@ static auto cherche_index_voisins(Corps const &corps)
 
     dls::tableau<dls::ensemble<long>> voisins(points_entree.taille());
 
-    pour_chaque_polygone_ferme(corps, [&](Corps const &corps_entree, Polygone *poly) {
-        INUTILISE(corps_entree);
+    auto topologie = construit_topologie_polygones(corps, filtre_polygones::FERMES);
 
-        for (auto j = 0; j < poly->nombre_sommets() - 1; ++j) {
-            auto i0 = poly->index_point(j);
-            auto i1 = poly->index_point(j + 1);
+    for (auto i = 0; i < topologie.nombre_polygones(); ++i) {
+        auto index_points = topologie.points_polygone(i);
+        auto nombre_sommets = topologie.nombre_sommets(i);
+
+        for (auto j = 0; j < nombre_sommets - 1; ++j) {
+            auto i0 = index_points[j];
+            auto i1 = index_points[j + 1];
 
             voisins[i0].insere(i1);
             voisins[i1].insere(i0);
         }
 
-        auto dernier = poly->index_point(poly->nombre_sommets() - 1);
-        auto premier = poly->index_point(0);
+        auto dernier = index_points[nombre_sommets - 1];
+        auto premier = index_points[0];
 
         voisins[premier].insere(dernier);
         voisins[dernier].insere(premier);
-    });
+    }
 
     return voisins;
 }
@@ -86,15 +90,13 @@ static auto cherche_index_adjacents(Corps const &corps)
 
     dls::tableau<dls::ensemble<long>> adjacents(points_entree.taille());
 
-    pour_chaque_polygone_ferme(corps, [&](Corps const &corps_entree, Polygone *polygone) {
-        INUTILISE(corps_entree);
-
-        for (auto j = 0; j < polygone->nombre_sommets(); ++j) {
-            auto i0 = polygone->index_point(j);
+    auto topologie = construit_topologie_polygones(corps, filtre_polygones::FERMES);
 
-            adjacents[i0].insere(polygone->index);
+    for (auto i = 0; i < topologie.nombre_polygones(); ++i) {
+        for (auto j = topologie.decalages[i]; j < topologie.decalages[i + 1]; ++j) {
+            adjacents[topologie.index_points[j]].insere(topologie.index_primitives[i]);
         }
-    });
+    }
 
     return adjacents;
 }
@@ -943,24 +945,25 @@ static auto calcul_donnees_aire(Corps &corps)
     auto points = corps.points_pour_lecture();
 
     auto aires = corps.ajoute_attribut("aire", type_attribut::R32, 1, portee_attr::PRIMITIVE);
+    auto topologie = construit_topologie_polygones(corps, filtre_polygones::FERMES);
 
-    pour_chaque_polygone_ferme(corps, [&](Corps const &corps_entree, Polygone *poly) {
-        INUTILISE(corps_entree);
-
-        auto aire_poly = 0.0f;
-
-        for (auto j = 2; j < poly->nombre_sommets(); ++j) {
-            auto v0 = points.point_local(poly->index_point(0));
-            auto v1 = points.point_local(poly->index_point(j - 1));
-            auto v2 = points.point_local(poly->index_point(j));
+    boucle_parallele(tbb::blocked_range<long>(0, topologie.nombre_polygones()),
+                     [&](tbb::blocked_range<long> const &plage) {
+                         for (auto i = plage.begin(); i < plage.end(); ++i) {
+                             auto index_points = topologie.points_polygone(i);
+                             auto aire_poly = 0.0f;
 
-            auto aire_tri = calcule_aire(v0, v1, v2);
+                             for (auto j = 2; j < topologie.nombre_sommets(i); ++j) {
+                                 auto v0 = points.point_local(index_points[0]);
+                                 auto v1 = points.point_local(index_points[j - 1]);
+                                 auto v2 = points.point_local(index_points[j]);
 
-            aire_poly += aire_tri;
-        }
+                                 aire_poly += calcule_aire(v0, v1, v2);
+                             }
 
-        assigne(aires->r32(poly->index), aire_poly);
-    });
+                             assigne(aires->r32(topologie.index_primitives[i]), aire_poly);
+                         }
+                     });
 
     return aires;
 }
@@ -970,24 +973,28 @@ static auto calcul_donnees_perimetres(Corps &corps)
     auto points = corps.points_pour_lecture();
 
     auto perimetres = corps.ajoute_attribut("aire", type_attribut::R32, 1, portee_attr::PRIMITIVE);
+    auto topologie = construit_topologie_polygones(corps, filtre_polygones::FERMES);
 
-    pour_chaque_polygone_ferme(corps, [&](Corps const &corps_entree, Polygone *poly) {
-        INUTILISE(corps_entree);
-
-        auto peri_poly = 0.0f;
-        auto k = poly->index_point(poly->nombre_sommets() - 1);
-
-        for (auto j = 0; j < poly->nombre_sommets(); ++j) {
-            auto idx = poly->index_point(j);
-            auto v0 = points.point_local(k);
-            auto v1 = points.point_local(idx);
-
-            peri_poly += longueur(v1 - v0);
-            k = idx;
-        }
+    boucle_parallele(tbb::blocked_range<long>(0, topologie.nombre_polygones()),
+                     [&](tbb::blocked_range<long> const &plage) {
+                         for (auto i = plage.begin(); i < plage.end(); ++i) {
+                             auto index_points = topologie.points_polygone(i);
+                             auto nombre_sommets = topologie.nombre_sommets(i);
+                             auto peri_poly = 0.0f;
+                             auto k = index_points[nombre_sommets - 1];
+
+                             for (auto j = 0; j < nombre_sommets; ++j) {
+                                 auto idx = index_points[j];
+                                 auto v0 = points.point_local(k);
+                                 auto v1 = points.point_local(idx);
+
+                                 peri_poly += longueur(v1 - v0);
+                                 k = idx;
+                             }
 
-        assigne(perimetres->r32(poly->index), peri_poly);
-    });
+                             assigne(perimetres->r32(topologie.index_primitives[i]), peri_poly);
+                         }
+                     });
 
     return perimetres;
 }
@@ -998,20 +1005,25 @@ static auto calcul_barycentre_poly(Corps &corps)
 
     auto barycentres = corps.ajoute_attribut(
         "barycentre", type_attribut::R32, 3, portee_attr::PRIMITIVE);
+    auto topologie = construit_topologie_polygones(corps, filtre_polygones::FERMES);
 
-    pour_chaque_polygone_ferme(corps, [&](Corps const &corps_entree, Polygone *poly) {
-        INUTILISE(corps_entree);
-
-        auto barycentre = dls::math::vec3f(0.0f);
+    boucle_parallele(tbb::blocked_range<long>(0, topologie.nombre_polygones()),
+                     [&](tbb::blocked_range<long> const &plage) {
+                         for (auto i = plage.begin(); i < plage.end(); ++i) {
+                             auto index_points = topologie.points_polygone(i);
+                             auto nombre_sommets = topologie.nombre_sommets(i);
+                             auto barycentre = dls::math::vec3f(0.0f);
 
-        for (auto j = 0; j < poly->nombre_sommets(); ++j) {
-            barycentre += points.point_local(poly->index_point(j));
-        }
+                             for (auto j = 0; j < nombre_sommets; ++j) {
+                                 barycentre += points.point_local(index_points[j]);
+                             }
 
-        barycentre /= static_cast<float>(poly->nombre_sommets());
+                             barycentre /= static_cast<float>(nombre_sommets);
 
-        assigne(barycentres->r32(poly->index), barycentre);
-    });
+                             assigne(barycentres->r32(topologie.index_primitives[i]),
+                                     barycentre);
+                         }
+                     });
 
     return barycentres;
 }
@@ -1039,27 +1051,30 @@ static auto calcul_centroide_poly(Corps &corps)
 
     auto centroides = corps.ajoute_attribut(
         "centroide", type_attribut::R32, 3, portee_attr::PRIMITIVE);
+    auto topologie = construit_topologie_polygones(corps, filtre_polygones::FERMES);
 
-    pour_chaque_polygone_ferme(corps, [&](Corps const &corps_entree, Polygone *poly) {
-        INUTILISE(corps_entree);
-
-        auto centroide = dls::math::vec3f(0.0f);
-        auto poids = 0.0f;
+    boucle_parallele(tbb::blocked_range<long>(0, topologie.nombre_polygones()),
+                     [&](tbb::blocked_range<long> const &plage) {
+                         for (auto i = plage.begin(); i < plage.end(); ++i) {
+                             auto index_points = topologie.points_polygone(i);
+                             auto centroide = dls::math::vec3f(0.0f);
+                             auto poids = 0.0f;
 
-        for (auto j = 0; j < poly->nombre_sommets(); ++j) {
-            auto idx = poly->index_point(j);
-            auto v1 = points.point_local(idx);
+                             for (auto j = 0; j < topologie.nombre_sommets(i); ++j) {
+                                 auto idx = index_points[j];
+                                 auto v1 = points.point_local(idx);
 
-            centroide += v1 * aires_sommets[idx];
-            poids += aires_sommets[idx];
-        }
+                                 centroide += v1 * aires_sommets[idx];
+                                 poids += aires_sommets[idx];
+                             }
 
-        if (poids != 0.0f) {
-            centroide /= poids;
-        }
+                             if (poids != 0.0f) {
+                                 centroide /= poids;
+                             }
 
-        assigne(centroides->r32(poly->index), centroide);
-    });
+                             assigne(centroides->r32(topologie.index_primitives[i]), centroide);
+                         }
+                     });
 
     return centroides;
 }
@@ -1389,21 +1389,21 @@ class OperatriceEnleveDoublons final : public OperatriceCorps {
 
         std::cerr << "Copie des attributs\n";
         /* Copie les attributs */
-        for (auto const attr : corps_entree->attributs()) {
-            if (attr->portee != portee_attr::POINT) {
-                auto copie_attr = memoire::loge<Attribut>(*attr);
+        for (auto const &attr : corps_entree->attributs()) {
+            if (attr.portee != portee_attr::POINT) {
+                auto copie_attr = memoire::loge<Attribut>(attr);
                 m_corps.ajoute_attribut(copie_attr);
                 continue;
             }
 
-            auto attr_point = m_corps.ajoute_attribut(attr->nom(), attr->type(), attr->portee);
+            auto attr_point = m_corps.ajoute_attribut(attr.nom(), attr.type(), attr.portee);
 
             for (auto i = 0, j = 0; i < points_entree->taille(); ++i) {
                 if (tamis_point[static_cast<size_t>(i)] == true) {
                     continue;
                 }
 
-                copie_attribut(attr, i, attr_point, j++);
+                copie_attribut(&attr, i, attr_point, j++);
             }
         }
 
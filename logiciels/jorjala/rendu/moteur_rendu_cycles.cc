@@ -27,7 +27,7 @@
 #include "cycles.hh"
 
 #include "coeur/objet.h"
-#include "corps/iteration_corps.hh"
+#include "corps/topologie.hh"
 
 // À FAIRE : map objet jorjala -> objet cycles
 // À FAIRE : drapeau sur les Corps pour indiquer s'ils sont sales (à resynchroniser)
@@ -66,11 +66,13 @@ static ccl::Mesh *synchronise_maillage(ccl::Scene *scene, const Corps &corps)
     used_shaders.push_back_slow(scene->default_surface);
     noeud->set_used_shaders(used_shaders);
 
+    auto topologie = construit_topologie_polygones(corps);
+
     int nombre_de_triangles = 0;
 
-    pour_chaque_polygone(corps, [&](Corps const &, Polygone *poly) {
-        nombre_de_triangles += static_cast<int>(poly->nombre_sommets() - 2);
-    });
+    for (auto i = 0; i < topologie.nombre_polygones(); ++i) {
+        nombre_de_triangles += static_cast<int>(topologie.nombre_sommets(i) - 2);
+    }
 
     auto points = corps.points_pour_lecture();
     noeud->reserve_mesh(static_cast<int>(points.taille()), nombre_de_triangles);
@@ -82,28 +84,21 @@ static ccl::Mesh *synchronise_maillage(ccl::Scene *scene, const Corps &corps)
 
     // À FAIRE : divise les triangles selon l'axe le plus court
     // À FAIRE : attributs
-    pour_chaque_polygone(corps, [&](Corps const &, Polygone *poly) {
-        auto nombre_sommets = poly->nombre_sommets();
+    for (auto i = 0; i < topologie.nombre_polygones(); ++i) {
+        auto index_points = topologie.points_polygone(i);
+        auto nombre_sommets = topologie.nombre_sommets(i);
 
         if (nombre_sommets == 4) {
-            auto i0 = static_cast<int>(poly->index_point(0));
-            auto i1 = static_cast<int>(poly->index_point(1));
-            auto i2 = static_cast<int>(poly->index_point(2));
-            auto i3 = static_cast<int>(poly->index_point(3));
-
-            noeud->add_triangle(i0, i1, i2, 0, true);
-            noeud->add_triangle(i0, i2, i3, 0, true);
+            noeud->add_triangle(index_points[0], index_points[1], index_points[2], 0, true);
+            noeud->add_triangle(index_points[0], index_points[2], index_points[3], 0, true);
         }
         else {
-            for (auto j = 2; j < poly->nombre_sommets(); ++j) {
-                auto i0 = static_cast<int>(poly->index_point(0));
-                auto i1 = static_cast<int>(poly->index_point(j - 1));
-                auto i2 = static_cast<int>(poly->index_point(j));
-
-                noeud->add_triangle(i0, i1, i2, 0, true);
+            for (auto j = 2; j < nombre_sommets; ++j) {
+                noeud->add_triangle(
+                    index_points[0], index_points[j - 1], index_points[j], 0, true);
             }
         }
-    });
+    }
 
     noeud->tag_update(scene, true);
 
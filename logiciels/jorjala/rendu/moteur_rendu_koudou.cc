@@ -31,6 +31,7 @@
 #include "coeur/objet.h"
 #include "corps/iteration_corps.hh"
 #include "corps/sphere.hh"
+#include "corps/topologie.hh"
 #include "corps/volume.hh"
 
 #include "koudou/koudou.hh"
@@ -287,14 +288,16 @@ static void ajoute_maillage(kdo::maillage *maillage, Corps const &corps)
     maillage->normaux_triangles = kdo::tableau_index(taille_indices_normaux);
     maillage->normaux_quads = kdo::tableau_index(taille_indices_normaux);
 
-    pour_chaque_polygone(corps, [&](Corps const &, Polygone *poly) {
-        auto nombre_sommets = poly->nombre_sommets();
+    auto topologie = construit_topologie_polygones(corps);
+
+    for (auto i = 0; i < topologie.nombre_polygones(); ++i) {
+        auto nombre_sommets = topologie.nombre_sommets(i);
 
         if (nombre_sommets == 4) {
-            auto i0 = static_cast<int>(poly->index_point(0));
-            auto i1 = static_cast<int>(poly->index_point(1));
-            auto i2 = static_cast<int>(poly->index_point(2));
-            auto i3 = static_cast<int>(poly->index_point(3));
+            auto i0 = topologie.index_point(i, 0);
+            auto i1 = topologie.index_point(i, 1);
+            auto i2 = topologie.index_point(i, 2);
+            auto i3 = topologie.index_point(i, 3);
 
             maillage->quads.ajoute(i0);
             maillage->quads.ajoute(i1);
@@ -310,7 +313,7 @@ static void ajoute_maillage(kdo::maillage *maillage, Corps const &corps)
 
             if (attr_N) {
                 if (attr_N->portee == portee_attr::PRIMITIVE) {
-                    n0 = static_cast<int>(poly->index);
+                    n0 = topologie.index_primitives[i];
                     n1 = n0;
                     n2 = n0;
                     n3 = n0;
@@ -351,10 +354,10 @@ static void ajoute_maillage(kdo::maillage *maillage, Corps const &corps)
             maillage->normaux_quads.ajoute(n3);
         }
         else {
-            for (auto j = 2; j < poly->nombre_sommets(); ++j) {
-                auto i0 = static_cast<int>(poly->index_point(0));
-                auto i1 = static_cast<int>(poly->index_point(j - 1));
-                auto i2 = static_cast<int>(poly->index_point(j));
+            for (auto j = 2; j < topologie.nombre_sommets(i); ++j) {
+                auto i0 = topologie.index_point(i, 0);
+                auto i1 = topologie.index_point(i, j - 1);
+                auto i2 = topologie.index_point(i, j);
 
                 maillage->triangles.ajoute(i0);
                 maillage->triangles.ajoute(i1);
@@ -368,7 +371,7 @@ static void ajoute_maillage(kdo::maillage *maillage, Corps const &corps)
 
                 if (attr_N) {
                     if (attr_N->portee == portee_attr::PRIMITIVE) {
-                        n0 = static_cast<int>(poly->index);
+                        n0 = topologie.index_primitives[i];
                         n1 = n0;
                         n2 = n0;
                     }
@@ -404,7 +407,7 @@ static void ajoute_maillage(kdo::maillage *maillage, Corps const &corps)
                 maillage->normaux_triangles.ajoute(n2);
             }
         }
-    });
+    }
 }
 
 static void ajoute_sphere(kdo::Scene &scene_koudou, Corps const &corps)
@@ -432,6 +435,30 @@ MoteurRenduKoudou::~MoteurRenduKoudou()
     delete m_koudou;
 }
 
+static void copie_pellicule(kdo::Pellicule const &pellicule,
+                            float *tampon,
+                            int hauteur,
+                            int largeur)
+{
+    auto const &donnees = pellicule.donnees();
+
+    auto index = 0;
+    for (int y = 0; y < hauteur; ++y) {
+        for (int x = 0; x < largeur; ++x, ++index) {
+            auto v = dls::math::converti_type<float>(donnees.valeur(index));
+            *tampon++ = v.x;
+            *tampon++ = v.y;
+            *tampon++ = v.z;
+            *tampon++ = 1.0f;
+
+            //			std::swap(tampon[idx0 + 0], tampon[idx1 + 0]);
+            //			std::swap(tampon[idx0 + 1], tampon[idx1 + 1]);
+            //			std::swap(tampon[idx0 + 2], tampon[idx1 + 2]);
+            //			std::swap(tampon[idx0 + 3], tampon[idx1 + 3]);
+        }
+    }
+}
+
 const char *MoteurRenduKoudou::id() const
 {
     return "koudou";
@@ -534,7 +561,9 @@ void MoteurRenduKoudou::calcule_rendu(
     std::cerr << "Mémoire normaux : " << memoire_normaux << '\n';
 
     auto moteur_rendu = m_koudou->moteur_rendu;
-    auto nombre_echantillons = 4;  // m_koudou->parametres_rendu.nombre_echantillons;
+    /* Les carreaux convergeant avant, les rendus finaux peuvent se permettre
+     * tous les échantillons demandés. */
+    auto nombre_echantillons = rendu_final ? m_koudou->parametres_rendu.nombre_echantillons : 4u;
 
 #ifdef STATISTIQUES
     init_statistiques();
@@ -547,6 +576,12 @@ void MoteurRenduKoudou::calcule_rendu(
 
     scene_koudou.construit_arbre_hbe();
 
+    /* Le tampon est ajourné après chaque passe pour que l'image partielle
+     * puisse être affichée. */
+    moteur_rendu->rappel_progres([&](kdo::Pellicule const &pellicule, unsigned int) {
+        copie_pellicule(pellicule, tampon, hauteur, largeur);
+    });
+
     /* Génère carreaux. */
     auto const largeur_carreau = m_koudou->parametres_rendu.largeur_carreau;
     auto const hauteur_carreau = m_koudou->parametres_rendu.hauteur_carreau;
@@ -586,10 +621,17 @@ void MoteurRenduKoudou::calcule_rendu(
 
         auto const debut_echantillon = dls::chrono::compte_seconde();
 
-        moteur_rendu->echantillone_scene(m_koudou->parametres_rendu, carreaux, e);
+        auto const carreaux_restants = moteur_rendu->echantillone_scene(
+            m_koudou->parametres_rendu, carreaux, e);
 
         temps_echantillon = debut_echantillon.temps();
         temps_ecoule += temps_echantillon;
+
+        moteur_rendu->signale_progres(e);
+
+        if (carreaux_restants == 0) {
+            break;
+        }
         //		temps_restant = (temps_ecoule / (e + 1.0) * nombre_echantillons) - temps_ecoule;
 
         // m_notaire->signale_rendu_fini();
@@ -611,22 +653,7 @@ void MoteurRenduKoudou::calcule_rendu(
 
     // m_notaire->signale_progres_temps(e + 1, temps_echantillon, temps_ecoule, temps_restant);
 
-    auto const &ptr_pellicule = moteur_rendu->pellicule();
-    auto const &donnees = ptr_pellicule.donnees();
+    moteur_rendu->rappel_progres(nullptr);
 
-    auto index = 0;
-    for (int y = 0; y < hauteur; ++y) {
-        for (int x = 0; x < largeur; ++x, ++index) {
-            auto v = dls::math::converti_type<float>(donnees.valeur(index));
-            *tampon++ = v.x;
-            *tampon++ = v.y;
-            *tampon++ = v.z;
-            *tampon++ = 1.0f;
-
-            //			std::swap(tampon[idx0 + 0], tampon[idx1 + 0]);
-            //			std::swap(tampon[idx0 + 1], tampon[idx1 + 1]);
-            //			std::swap(tampon[idx0 + 2], tampon[idx1 + 2]);
-            //			std::swap(tampon[idx0 + 3], tampon[idx1 + 3]);
-        }
-    }
+    copie_pellicule(moteur_rendu->pellicule(), tampon, hauteur, largeur);
 }
@@ -0,0 +1,147 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * The Original Code is Copyright (C) 2026 Kévin Dietrich. */
+
+#pragma once
+
+#include <random>
+
+#include "biblinternes/math/boite_englobante.hh"
+#include "biblinternes/phys/collision.hh"
+#include "biblinternes/phys/rayon.hh"
+#include "biblinternes/structures/tableau.hh"
+
+/* Délégué de triangles pour les tests et les mesures des arbres HBE. */
+struct DelegueTriangles {
+    dls::tableau<dls::math::vec3f> points{};
+    dls::tableau<int> triangles{};
+
+    long nombre_elements() const
+    {
+        return triangles.taille() / 3;
+    }
+
+    BoiteEnglobante boite_englobante(long idx) const
+    {
+        auto boite = BoiteEnglobante();
+
+        for (auto k = 0; k < 3; ++k) {
+            auto const &p = points[triangles[idx * 3 + k]];
+
+            for (auto j = 0ul; j < 3; ++j) {
+                boite.min[j] = std::min(boite.min[j], static_cast<double>(p[j]));
+                boite.max[j] = std::max(boite.max[j], static_cast<double>(p[j]));
+            }
+        }
+
+        boite.centroide = (boite.min + boite.max) * 0.5;
+        boite.id = idx;
+        return boite;
+    }
+
+    void coords_element(int idx, dls::tableau<dls::math::vec3f> &cos) const
+    {
+        cos.efface();
+
+        for (auto k = 0; k < 3; ++k) {
+            cos.ajoute(points[triangles[idx * 3 + k]]);
+        }
+    }
+
+    dls::phys::esectd intersecte_element(long idx, dls::phys::rayond const &rayon) const
+    {
+        auto const v0 = dls::math::converti_type_point<double>(points[triangles[idx * 3]]);
+        auto const v1 = dls::math::converti_type_point<double>(points[triangles[idx * 3 + 1]]);
+        auto const v2 = dls::math::converti_type_point<double>(points[triangles[idx * 3 + 2]]);
+
+        auto esect = dls::phys::esectd{};
+        auto distance = 1000.0;
+
+        if (entresecte_triangle(v0, v1, v2, rayon, distance) && distance > 0.0) {
+            esect.touche = true;
+            esect.distance = distance;
+            esect.idx = idx;
+        }
+
+        return esect;
+    }
+};
+
+/* Des petits triangles éparpillés dans un cube de côté 20 centré sur l'origine. */
+inline DelegueTriangles cree_soupe_triangles(long nombre, std::mt19937 &gna)
+{
+    auto dist = std::uniform_real_distribution<float>(-1.0f, 1.0f);
+    auto delegue = DelegueTriangles();
+
+    for (auto i = 0l; i < nombre; ++i) {
+        auto const centre = dls::math::vec3f(dist(gna), dist(gna), dist(gna)) * 10.0f;
+
+        for (auto k = 0; k < 3; ++k) {
+            auto const decalage = dls::math::vec3f(dist(gna), dist(gna), dist(gna)) * 0.2f;
+            delegue.points.ajoute(centre + decalage);
+            delegue.triangles.ajoute(static_cast<int>(i * 3 + k));
+        }
+    }
+
+    return delegue;
+}
+
+/* Une grille de résolution x résolution quads, ondulée comme un terrain. */
+inline DelegueTriangles cree_terrain(long resolution)
+{
+    auto delegue = DelegueTriangles();
+    auto const echelle = 20.0f / static_cast<float>(resolution);
+
+    for (auto y = 0l; y <= resolution; ++y) {
+        for (auto x = 0l; x <= resolution; ++x) {
+            auto const fx = static_cast<float>(x);
+            auto const fy = static_cast<float>(y);
+            delegue.points.ajoute(dls::math::vec3f(-10.0f + fx * echelle,
+                                                   -10.0f + fy * echelle,
+                                                   std::sin(fx * 0.05f) * std::cos(fy * 0.07f)));
+        }
+    }
+
+    for (auto y = 0l; y < resolution; ++y) {
+        for (auto x = 0l; x < resolution; ++x) {
+            auto const a = static_cast<int>(y * (resolution + 1) + x);
+            auto const b = a + 1;
+            auto const c = a + static_cast<int>(resolution) + 1;
+            auto const d = c + 1;
+
+            for (auto idx : {a, b, d, a, d, c}) {
+                delegue.triangles.ajoute(idx);
+            }
+        }
+    }
+
+    return delegue;
+}
+
+/* Des rayons tirés du dessus de la scène vers le bas ; un sur dix est
+ * parallèle à l'axe Z pour exercer les divisions par zéro de la traversée. */
+inline dls::tableau<dls::phys::rayond> cree_rayons(long nombre, std::mt19937 &gna)
+{
+    auto dist = std::uniform_real_distribution<double>(-1.0, 1.0);
+    auto rayons = dls::tableau<dls::phys::rayond>();
+    rayons.reserve(nombre);
+
+    for (auto i = 0l; i < nombre; ++i) {
+        auto rayon = dls::phys::rayond();
+        rayon.origine = dls::math::point3d(dist(gna) * 15.0, dist(gna) * 15.0, 20.0);
+
+        if (i % 10 == 0) {
+            rayon.direction = dls::math::vec3d(0.0, 0.0, -1.0);
+        }
+        else {
+            rayon.direction = dls::math::normalise(
+                dls::math::vec3d(dist(gna) * 0.5, dist(gna) * 0.5, -1.0));
+        }
+
+        calcul_direction_inverse(rayon);
+        rayon.distance_min = 0.0;
+        rayon.distance_max = constantes<double>::INFINITE;
+        rayons.ajoute(rayon);
+    }
+
+    return rayons;
+}
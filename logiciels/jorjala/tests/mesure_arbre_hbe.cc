@@ -0,0 +1,112 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * The Original Code is Copyright (C) 2026 Kévin Dietrich. */
+
+/* Mesure la construction et la traversée des arbres HBE.
+ *
+ * Utilisation : mesure_arbre_hbe [triangles] [rayons] [terrain]
+ *
+ * Sans troisième argument, la scène est une soupe de « triangles » triangles ;
+ * avec, c'est un terrain de triangles x triangles quads.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "coeur/arbre_hbe.hh"
+#include "coeur/arbre_hbe_large.hh"
+
+#include "delegue_triangles.hh"
+
+using horloge = std::chrono::steady_clock;
+
+static double millisecondes_depuis(horloge::time_point debut)
+{
+    return std::chrono::duration<double, std::milli>(horloge::now() - debut).count();
+}
+
+template <typename Fonction>
+static void mesure_traversee(char const *nom,
+                             dls::tableau<dls::phys::rayond> const &rayons,
+                             Fonction &&fonction)
+{
+    auto const debut = horloge::now();
+    auto touches = 0l;
+    auto somme_distances = 0.0;
+
+    for (auto const &rayon : rayons) {
+        auto const esect = fonction(rayon);
+
+        if (esect.touche) {
+            touches += 1;
+            somme_distances += esect.distance;
+        }
+    }
+
+    auto const secondes = millisecondes_depuis(debut) / 1000.0;
+    auto const mrayons = static_cast<double>(rayons.taille()) / secondes / 1e6;
+
+    printf("%-8s %8.3f Mrayons/s, touches %ld, somme %.6f\n",
+           nom,
+           mrayons,
+           touches,
+           somme_distances);
+}
+
+int main(int argc, char **argv)
+{
+    auto const nombre = argc > 1 ? atol(argv[1]) : 200000l;
+    auto const nombre_rayons = argc > 2 ? atol(argv[2]) : 100000l;
+    auto gna = std::mt19937(42);
+
+    auto const delegue = argc > 3 ? cree_terrain(nombre) : cree_soupe_triangles(nombre, gna);
+
+    auto debut = horloge::now();
+    auto const arbre = construit_arbre_hbe(delegue, PROFONDEUR_MAX);
+    auto const temps_binaire = millisecondes_depuis(debut);
+
+    /* Isole le temps passé dans les scissions SAH de celui du rassemblement
+     * des boîtes. */
+    auto boites = dls::tableau<BoiteEnglobante>(delegue.nombre_elements());
+    for (auto i = 0l; i < boites.taille(); ++i) {
+        boites[i] = delegue.boite_englobante(i);
+    }
+
+    debut = horloge::now();
+    construit_arbre_hbe_depuis_boites(boites, PROFONDEUR_MAX);
+    auto const temps_scissions = millisecondes_depuis(debut);
+
+    debut = horloge::now();
+    auto const large = construit_arbre_hbe_large(arbre);
+    auto const temps_large = millisecondes_depuis(debut);
+
+    debut = horloge::now();
+    auto arbre_bli = bli::cree_arbre_bvh(delegue);
+    auto const temps_bli = millisecondes_depuis(debut);
+
+    printf("%ld triangles\n", delegue.nombre_elements());
+    printf("construction : binaire %.1f ms (scissions %.1f ms), large %.1f ms, bli %.1f ms\n",
+           temps_binaire,
+           temps_scissions,
+           temps_large,
+           temps_bli);
+    printf("noeuds : binaire %ld (%zu octets), large %ld (%zu octets)\n",
+           arbre.noeuds.taille(),
+           sizeof(ArbreHBE::Noeud),
+           large.noeuds.taille(),
+           sizeof(ArbreHBELarge::Noeud));
+
+    auto const rayons = cree_rayons(nombre_rayons, gna);
+
+    mesure_traversee("binaire", rayons, [&](dls::phys::rayond const &rayon) {
+        return traverse(arbre, delegue, rayon);
+    });
+    mesure_traversee("bli", rayons, [&](dls::phys::rayond const &rayon) {
+        return bli::traverse(arbre_bli, delegue, rayon);
+    });
+    mesure_traversee("large", rayons, [&](dls::phys::rayond const &rayon) {
+        return traverse(large, delegue, rayon);
+    });
+
+    return 0;
+}
@@ -0,0 +1,247 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * The Original Code is Copyright (C) 2026 Kévin Dietrich. */
+
+#include "tests.hh"
+
+#include "coeur/arbre_hbe.hh"
+#include "coeur/arbre_hbe_large.hh"
+
+#include "delegue_triangles.hh"
+
+static bool boite_contient(BoiteEnglobante const &parent, BoiteEnglobante const &enfant)
+{
+    for (auto i = 0ul; i < 3; ++i) {
+        if (enfant.min[i] < parent.min[i] || enfant.max[i] > parent.max[i]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* Les références des enfants sont contiguës, non vides, et recouvrent
+ * exactement celles du parent. */
+static bool partition_valide(ArbreHBE::Noeud const &parent,
+                             ArbreHBE::Noeud const &gauche,
+                             ArbreHBE::Noeud const &droite)
+{
+    if (gauche.nombre_references == 0 || droite.nombre_references == 0) {
+        return false;
+    }
+
+    if (gauche.decalage_reference != parent.decalage_reference) {
+        return false;
+    }
+
+    if (droite.decalage_reference != gauche.decalage_reference + gauche.nombre_references) {
+        return false;
+    }
+
+    return gauche.nombre_references + droite.nombre_references == parent.nombre_references;
+}
+
+static void verifie_validite(dls::test_unitaire::Controleuse &controleuse,
+                             DelegueTriangles const &delegue)
+{
+    auto const arbre = construit_arbre_hbe(delegue, PROFONDEUR_MAX);
+    auto const nombre_elements = delegue.nombre_elements();
+
+    /* Chaque élément est référencé exactement une fois. */
+    CU_VERIFIE_EGALITE(controleuse, arbre.index_refs.taille(), nombre_elements);
+
+    auto nombre_references = dls::tableau<int>(nombre_elements, 0);
+
+    for (auto const index : arbre.index_refs) {
+        if (index >= 0 && index < nombre_elements) {
+            nombre_references[index] += 1;
+        }
+    }
+
+    auto elements_mal_references = 0;
+
+    for (auto const nombre : nombre_references) {
+        elements_mal_references += (nombre != 1);
+    }
+
+    CU_VERIFIE_EGALITE(controleuse, elements_mal_references, 0);
+
+    /* La racine couvre toutes les références, les enfants se partagent
+     * celles de leur parent, et leurs boîtes sont dans celle du parent. */
+    auto const &racine = arbre.noeuds[1];
+    CU_VERIFIE_EGALITE(controleuse, racine.decalage_reference, 0l);
+    CU_VERIFIE_EGALITE(controleuse, racine.nombre_references, nombre_elements);
+
+    auto noeuds_visites = 0l;
+    auto partitions_invalides = 0;
+    auto boites_hors_parent = 0;
+    auto elements_hors_feuille = 0;
+
+    auto pile = dls::pile<long>();
+    pile.empile(1);
+
+    while (!pile.est_vide()) {
+        auto const &noeud = arbre.noeuds[pile.depile()];
+        noeuds_visites += 1;
+
+        if (noeud.est_feuille()) {
+            auto const fin = noeud.decalage_reference + noeud.nombre_references;
+
+            for (auto i = noeud.decalage_reference; i < fin; ++i) {
+                auto const boite = delegue.boite_englobante(arbre.index_refs[i]);
+                elements_hors_feuille += !boite_contient(noeud.limites, boite);
+            }
+
+            continue;
+        }
+
+        auto const &gauche = arbre.noeuds[noeud.enfants[NOEUD_GAUCHE]];
+        auto const &droite = arbre.noeuds[noeud.enfants[NOEUD_DROITE]];
+
+        partitions_invalides += !partition_valide(noeud, gauche, droite);
+
+        boites_hors_parent += !boite_contient(noeud.limites, gauche.limites);
+        boites_hors_parent += !boite_contient(noeud.limites, droite.limites);
+
+        pile.empile(noeud.enfants[NOEUD_GAUCHE]);
+        pile.empile(noeud.enfants[NOEUD_DROITE]);
+    }
+
+    /* Tous les noeuds, hormis le noeud nul, sont atteints une seule fois. */
+    CU_VERIFIE_EGALITE(controleuse, noeuds_visites, arbre.noeuds.taille() - 1);
+    CU_VERIFIE_EGALITE(controleuse, partitions_invalides, 0);
+    CU_VERIFIE_EGALITE(controleuse, boites_hors_parent, 0);
+    CU_VERIFIE_EGALITE(controleuse, elements_hors_feuille, 0);
+}
+
+void test_arbre_hbe(dls::test_unitaire::Controleuse &controleuse)
+{
+    auto gna = std::mt19937(17);
+
+    CU_DEBUTE_PROPOSITION(controleuse,
+                          "Un ArbreHBE construit depuis une soupe de triangles est valide.");
+    {
+        verifie_validite(controleuse, cree_soupe_triangles(20000, gna));
+    }
+    CU_TERMINE_PROPOSITION(controleuse);
+
+    CU_DEBUTE_PROPOSITION(controleuse, "Un ArbreHBE construit depuis un terrain est valide.");
+    {
+        /* Assez de triangles pour passer par la construction parallèle. */
+        verifie_validite(controleuse, cree_terrain(100));
+    }
+    CU_TERMINE_PROPOSITION(controleuse);
+
+    CU_DEBUTE_PROPOSITION(controleuse,
+                          "Un ArbreHBE dont les centroïdes sont confondus est valide.");
+    {
+        /* Aucune scission n'est possible : la racine reste une feuille. */
+        auto delegue = DelegueTriangles();
+
+        for (auto i = 0; i < 50; ++i) {
+            delegue.points.ajoute(dls::math::vec3f(-1.0f, 0.0f, 0.0f));
+            delegue.points.ajoute(dls::math::vec3f(1.0f, 0.0f, 0.0f));
+            delegue.points.ajoute(dls::math::vec3f(0.0f, 1.0f, -0.5f));
+            delegue.points.ajoute(dls::math::vec3f(0.0f, -1.0f, 0.5f));
+
+            for (auto idx : {0, 1, 2, 0, 1, 3}) {
+                delegue.triangles.ajoute(i * 4 + idx);
+            }
+        }
+
+        verifie_validite(controleuse, delegue);
+    }
+    CU_TERMINE_PROPOSITION(controleuse);
+}
+
+/* ************************************************************************** */
+
+static dls::phys::esectd traverse_force_brute(DelegueTriangles const &delegue,
+                                              dls::phys::rayond const &rayon)
+{
+    auto resultat = dls::phys::esectd{};
+
+    for (auto i = 0l; i < delegue.nombre_elements(); ++i) {
+        auto const esect = delegue.intersecte_element(i, rayon);
+
+        if (esect.touche && (!resultat.touche || esect.distance < resultat.distance)) {
+            resultat = esect;
+        }
+    }
+
+    return resultat;
+}
+
+static bool memes_entresections(dls::phys::esectd const &a, dls::phys::esectd const &b)
+{
+    if (a.touche != b.touche) {
+        return false;
+    }
+
+    if (!a.touche) {
+        return true;
+    }
+
+    return std::abs(a.distance - b.distance) <= 1e-9;
+}
+
+static void verifie_traversees(dls::test_unitaire::Controleuse &controleuse,
+                               DelegueTriangles const &delegue,
+                               std::mt19937 &gna)
+{
+    auto const arbre = construit_arbre_hbe(delegue, PROFONDEUR_MAX);
+    auto const large = construit_arbre_hbe_large(arbre);
+    auto const rayons = cree_rayons(2000, gna);
+
+    auto differences_binaire = 0;
+    auto differences_force_brute = 0;
+    auto touches = 0;
+
+    for (auto const &rayon : rayons) {
+        auto const esect_binaire = traverse(arbre, delegue, rayon);
+        auto const esect_large = traverse(large, delegue, rayon);
+
+        if (!memes_entresections(esect_binaire, esect_large)) {
+            differences_binaire += 1;
+        }
+
+        if (!memes_entresections(traverse_force_brute(delegue, rayon), esect_large)) {
+            differences_force_brute += 1;
+        }
+
+        touches += esect_large.touche;
+    }
+
+    /* S'assure que les rayons touchent effectivement la géométrie. */
+    CU_VERIFIE_CONDITION(controleuse, touches > 0);
+    CU_VERIFIE_EGALITE(controleuse, differences_binaire, 0);
+    CU_VERIFIE_EGALITE(controleuse, differences_force_brute, 0);
+}
+
+void test_arbre_hbe_large(dls::test_unitaire::Controleuse &controleuse)
+{
+    auto gna = std::mt19937(42);
+
+    CU_DEBUTE_PROPOSITION(
+        controleuse,
+        "L'entresection la plus proche d'un ArbreHBELarge est celle de l'ArbreHBE dont il "
+        "est construit (soupe de triangles).");
+    {
+        verifie_traversees(controleuse, cree_soupe_triangles(5000, gna), gna);
+    }
+    CU_TERMINE_PROPOSITION(controleuse);
+
+    CU_DEBUTE_PROPOSITION(
+        controleuse,
+        "L'entresection la plus proche d'un ArbreHBELarge est celle de l'ArbreHBE dont il "
+        "est construit (terrain).");
+    {
+        verifie_traversees(controleuse, cree_terrain(60), gna);
+    }
+    CU_TERMINE_PROPOSITION(controleuse);
+
+    CU_DEBUTE_PROPOSITION(controleuse, "Un arbre réduit à une feuille est traversable.");
+    {
+        verifie_traversees(controleuse, cree_terrain(1), gna);
+    }
+    CU_TERMINE_PROPOSITION(controleuse);
+}
@@ -0,0 +1,15 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * The Original Code is Copyright (C) 2026 Kévin Dietrich. */
+
+#include "tests.hh"
+
+int main()
+{
+    dls::test_unitaire::Controleuse controleuse;
+    controleuse.ajoute_fonction(test_arbre_hbe);
+    controleuse.ajoute_fonction(test_arbre_hbe_large);
+
+    controleuse.performe_controles();
+
+    controleuse.imprime_resultat();
+}
@@ -0,0 +1,9 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * The Original Code is Copyright (C) 2026 Kévin Dietrich. */
+
+#pragma once
+
+#include "biblinternes/tests/test_unitaire.hh"
+
+void test_arbre_hbe(dls::test_unitaire::Controleuse &controleuse);
+void test_arbre_hbe_large(dls::test_unitaire::Controleuse &controleuse);
@@ -202,11 +202,13 @@ void ProtéineStruct::génère_code_cpp(FluxSortieCPP &os, bool pour_entête)
             os << "\tmutable int nombre_recherches = 0;\n";
             os << "\tkuri::table_hachage<IdentifiantCode const *, NoeudDéclaration *> "
                   "table_rubriques{\"rubriques_bloc\"};\n";
+            os << "\tIndexRubriquesBloc index_rubriques{};\n";
             os << "\tint nombre_de_rubriques() const;\n";
             os << "\tvoid réserve_rubriques(int nombre);\n";
             os << "\tvoid ajoute_rubrique(NoeudDéclaration *decl);\n";
             os << "\tvoid ajoute_rubrique_au_début(NoeudDéclaration *decl);\n";
             os << "\tvoid fusionne_rubriques(NoeudBloc *de);\n";
+            os << "\tvoid publie_index_rubriques();\n";
             os << "\tNoeudDéclaration *rubrique_pour_indice(int indice) const;\n";
             os << "\tNoeudDéclaration *déclaration_pour_ident(IdentifiantCode const "
                   "*ident_recherche) const;\n";
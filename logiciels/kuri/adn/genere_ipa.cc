@@ -139,8 +139,8 @@ int main(int argc, const char **argv)
     fichier.tampon_ = TamponSource(texte);
     fichier.chemin_ = chemin_adn_ipa;
 
-    auto gérante_chaine = kuri::Synchrone<GeranteChaine>();
-    auto table_identifiants = kuri::Synchrone<TableIdentifiant>();
+    auto gérante_chaine = GeranteChaine();
+    auto table_identifiants = TableIdentifiant();
     auto contexte_lexage = ContexteLexage{gérante_chaine, table_identifiants, imprime_erreur};
 
     auto lexeuse = Lexeuse(contexte_lexage, &fichier);
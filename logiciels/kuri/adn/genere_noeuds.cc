@@ -1403,6 +1403,10 @@ NoeudBloc *AssembleuseArbre::empile_bloc(Lexème const *lexème, NoeudDéclarati
 
     void dépile_bloc()
     {
+        /* Le bloc est fermé, ses rubriques peuvent être recherchées sans verrou. */
+        if (m_blocs.haut()) {
+            m_blocs.haut()->publie_index_rubriques();
+        }
         m_blocs.dépile();
     }
 
@@ -1588,6 +1592,8 @@ NoeudBloc *AssembleuseArbre::empile_bloc(Lexème const *lexème, NoeudDéclarati
                        << " += noeud.monomorphisations->mémoire_utilisée();\n";
                     os << nom_tableau << " = std::max(" << nom_tableau
                        << ", noeud.monomorphisations->nombre_items_max());\n";
+                    os << "noeud.monomorphisations->rassemble_statistiques(stats, "
+                          "noeud.ident);\n";
                     os << "}\n";
                 }
             });
@@ -1752,8 +1758,8 @@ int main(int argc, char **argv)
     fichier.tampon_ = TamponSource(texte);
     fichier.chemin_ = chemin_adn;
 
-    auto gérante_chaine = kuri::Synchrone<GeranteChaine>();
-    auto table_identifiants = kuri::Synchrone<TableIdentifiant>();
+    auto gérante_chaine = GeranteChaine();
+    auto table_identifiants = TableIdentifiant();
     auto contexte_lexage = ContexteLexage{gérante_chaine, table_identifiants, imprime_erreur};
 
     auto lexeuse = Lexeuse(contexte_lexage, &fichier);
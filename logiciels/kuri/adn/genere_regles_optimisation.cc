@@ -0,0 +1,672 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * The Original Code is Copyright (C) 2026 Kévin Dietrich. */
+
+/* Fichier de génération des tables de motifs pour les règles de réécriture de la RI
+ * (representation_intermediaire/optimisations.txt).
+ *
+ * Une règle est de la forme :
+ *     (remplace MOTIF REMPLACEMENT)
+ * où MOTIF est une expression (op opérande opérande), et REMPLACEMENT une expression ou un atome
+ * entre parenthèses. Les atomes sont des variables (x), des constantes littérales (0, -1), des
+ * constantes liées (@N), ou, dans les remplacements, des constantes calculées (%(N - 1)).
+ *
+ * Les règles utilisant des opérateurs inconnus de la RI (spécifiques à une machine) ou des
+ * conditions ne sont pas compilées, mais sont listées dans le fichier généré. */
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "compilation/liste_operateurs.hh"
+
+#include "structures/chemin_systeme.hh"
+#include "structures/tableau.hh"
+
+#include "outils_independants_des_lexemes.hh"
+
+struct DonnéesOpérateur {
+    std::string nom_genre{};
+    std::string id{};
+};
+
+static kuri::tableau<DonnéesOpérateur> donne_opérateurs_binaires()
+{
+    kuri::tableau<DonnéesOpérateur> résultat;
+#define ENUMERE_GENRE_OPBINAIRE_EX(genre, id, op_code) résultat.ajoute({#genre, #id});
+    ENUMERE_OPERATEURS_BINAIRE
+#undef ENUMERE_GENRE_OPBINAIRE_EX
+    return résultat;
+}
+
+static kuri::tableau<DonnéesOpérateur> opérateurs_binaires = donne_opérateurs_binaires();
+
+static DonnéesOpérateur const *trouve_opérateur(std::string const &id)
+{
+    /* Les opérateurs invalide et idx n'ont pas de sens dans une règle. */
+    if (id == "invalide" || id == "idx") {
+        return nullptr;
+    }
+
+    POUR (opérateurs_binaires) {
+        if (it.id == id) {
+            return &it;
+        }
+    }
+    return nullptr;
+}
+
+/* ------------------------------------------------------------------------- */
+/** \name Analyse des règles.
+ * \{ */
+
+static std::string supprime_commentaires(std::string const &texte)
+{
+    std::string résultat;
+    size_t i = 0;
+    while (i < texte.size()) {
+        if (texte.compare(i, 2, "/*") == 0) {
+            auto fin = texte.find("*/", i + 2);
+            if (fin == std::string::npos) {
+                break;
+            }
+            /* Remplace le commentaire par une espace pour séparer les mots qui l'entourent. */
+            résultat += ' ';
+            i = fin + 2;
+            continue;
+        }
+        résultat += texte[i];
+        i += 1;
+    }
+    return résultat;
+}
+
+static kuri::tableau<std::string> découpe_en_mots(std::string const &texte)
+{
+    kuri::tableau<std::string> résultat;
+    std::string mot_courant;
+
+    auto termine_mot = [&]() {
+        if (!mot_courant.empty()) {
+            résultat.ajoute(mot_courant);
+            mot_courant.clear();
+        }
+    };
+
+    for (auto c : texte) {
+        if (c == '(' || c == ')' || c == '@' || c == '%') {
+            termine_mot();
+            résultat.ajoute(std::string(1, c));
+            continue;
+        }
+
+        if (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+            termine_mot();
+            continue;
+        }
+
+        mot_courant += c;
+    }
+
+    termine_mot();
+    return résultat;
+}
+
+enum class GenreExpression {
+    OPÉRATEUR,
+    VARIABLE,
+    CONSTANTE,
+    CONSTANTE_LIÉE,
+    CONSTANTE_CALCULÉE,
+};
+
+struct Expression {
+    GenreExpression genre{};
+    std::string nom{};
+    int64_t valeur = 0;
+    DonnéesOpérateur const *opérateur = nullptr;
+    kuri::tableau<Expression> opérandes{};
+};
+
+struct Règle {
+    std::string texte{};
+    Expression motif{};
+    Expression remplacement{};
+    std::string raison_erreur{};
+    kuri::tableau<std::string> liaisons{};
+};
+
+static bool est_nombre(std::string const &mot)
+{
+    auto début = size_t(0);
+    if (mot.size() > 1 && mot[0] == '-') {
+        début = 1;
+    }
+
+    for (auto i = début; i < mot.size(); i++) {
+        if (mot[i] < '0' || mot[i] > '9') {
+            return false;
+        }
+    }
+
+    return début < mot.size();
+}
+
+struct AnalyseuseRègles {
+    kuri::tableau<std::string> mots{};
+    int64_t position = 0;
+    std::string erreur{};
+
+    bool fini() const
+    {
+        return position >= mots.taille();
+    }
+
+    std::string const &mot_courant() const
+    {
+        static const std::string vide = "";
+        if (fini()) {
+            return vide;
+        }
+        return mots[position];
+    }
+
+    bool consomme(std::string const &attendu)
+    {
+        if (mot_courant() != attendu) {
+            if (erreur.empty()) {
+                erreur = "attendu « " + attendu + " », obtenu « " + mot_courant() + " »";
+            }
+            return false;
+        }
+        position += 1;
+        return true;
+    }
+
+    /* Avance jusqu'à la parenthèse fermant l'expression courante, pour reprendre l'analyse à la
+     * règle suivante en cas d'erreur. */
+    void saute_jusqu_à_profondeur(int profondeur)
+    {
+        while (!fini() && profondeur > 0) {
+            if (mot_courant() == "(") {
+                profondeur += 1;
+            }
+            else if (mot_courant() == ")") {
+                profondeur -= 1;
+            }
+            position += 1;
+        }
+    }
+
+    bool analyse_atome(Expression &résultat)
+    {
+        auto mot = mot_courant();
+
+        if (mot == "@") {
+            position += 1;
+            résultat.genre = GenreExpression::CONSTANTE_LIÉE;
+            résultat.nom = mot_courant();
+            position += 1;
+            return true;
+        }
+
+        if (mot == "%") {
+            /* %(N - 1) */
+            position += 1;
+            if (!consomme("(")) {
+                return false;
+            }
+            résultat.genre = GenreExpression::CONSTANTE_CALCULÉE;
+            résultat.nom = mot_courant();
+            position += 1;
+
+            auto opération = mot_courant();
+            position += 1;
+            if (opération == "+") {
+                résultat.opérateur = trouve_opérateur("ajt");
+            }
+            else if (opération == "-") {
+                résultat.opérateur = trouve_opérateur("sst");
+            }
+            else if (opération == "*") {
+                résultat.opérateur = trouve_opérateur("mul");
+            }
+            else {
+                erreur = "opération « " + opération + " » non supportée pour les constantes";
+                return false;
+            }
+
+            if (!est_nombre(mot_courant())) {
+                erreur = "nombre attendu dans le calcul de constante";
+                return false;
+            }
+            résultat.valeur = std::stoll(mot_courant());
+            position += 1;
+            return consomme(")");
+        }
+
+        if (mot == "(" || mot == ")" || mot.empty()) {
+            erreur = "atome attendu";
+            return false;
+        }
+
+        position += 1;
+
+        if (est_nombre(mot)) {
+            résultat.genre = GenreExpression::CONSTANTE;
+            résultat.valeur = std::stoll(mot);
+            return true;
+        }
+
+        résultat.genre = GenreExpression::VARIABLE;
+        résultat.nom = mot;
+        return true;
+    }
+
+    /* Analyse une expression : soit un atome, soit (atome), soit (op expr expr). */
+    bool analyse_expression(Expression &résultat)
+    {
+        if (mot_courant() != "(") {
+            return analyse_atome(résultat);
+        }
+
+        position += 1;
+
+        auto premier_mot = mot_courant();
+        if (position + 1 < mots.taille() && mots[position + 1] == ")") {
+            /* (x) */
+            if (!analyse_atome(résultat)) {
+                return false;
+            }
+            return consomme(")");
+        }
+
+        if (premier_mot == "@" || premier_mot == "%") {
+            if (!analyse_atome(résultat)) {
+                return false;
+            }
+            return consomme(")");
+        }
+
+        position += 1;
+
+        résultat.genre = GenreExpression::OPÉRATEUR;
+        résultat.nom = premier_mot;
+        résultat.opérateur = trouve_opérateur(premier_mot);
+
+        while (!fini() && mot_courant() != ")") {
+            Expression opérande;
+            if (!analyse_expression(opérande)) {
+                return false;
+            }
+            résultat.opérandes.ajoute(opérande);
+        }
+
+        if (!consomme(")")) {
+            return false;
+        }
+
+        if (!résultat.opérateur) {
+            erreur = "opérateur « " + premier_mot + " » inconnu de la RI";
+            return false;
+        }
+
+        if (résultat.opérandes.taille() != 2) {
+            erreur = "l'opérateur « " + premier_mot + " » doit avoir deux opérandes";
+            return false;
+        }
+
+        return true;
+    }
+
+    kuri::tableau<Règle> analyse()
+    {
+        kuri::tableau<Règle> résultat;
+
+        while (!fini()) {
+            if (mot_courant() != "(") {
+                std::cerr << "Mot inattendu « " << mot_courant() << " » hors d'une règle\n";
+                position += 1;
+                continue;
+            }
+
+            auto début = position;
+            position += 1;
+
+            Règle règle;
+            erreur.clear();
+
+            if (mot_courant() != "remplace") {
+                saute_jusqu_à_profondeur(1);
+                continue;
+            }
+            position += 1;
+
+            auto succès = analyse_expression(règle.motif);
+            succès = succès && analyse_expression(règle.remplacement);
+
+            if (succès && mot_courant() == "si") {
+                erreur = "les conditions ne sont pas supportées";
+                succès = false;
+            }
+
+            if (succès) {
+                succès = consomme(")");
+            }
+            else {
+                auto profondeur = 0;
+                for (auto i = début; i < position; i++) {
+                    if (mots[i] == "(") {
+                        profondeur += 1;
+                    }
+                    else if (mots[i] == ")") {
+                        profondeur -= 1;
+                    }
+                }
+                saute_jusqu_à_profondeur(profondeur);
+            }
+
+            for (auto i = début; i < position; i++) {
+                auto const &mot = mots[i];
+                auto const dernier = règle.texte.empty() ? ' ' : règle.texte.back();
+                if (!règle.texte.empty() && mot != ")" && dernier != '(' && dernier != '@' &&
+                    dernier != '%') {
+                    règle.texte += ' ';
+                }
+                règle.texte += mot;
+            }
+
+            if (!succès) {
+                règle.raison_erreur = erreur;
+            }
+
+            résultat.ajoute(règle);
+        }
+
+        return résultat;
+    }
+};
+
+static int donne_liaison(Règle &règle, std::string const &nom)
+{
+    POUR_INDICE (règle.liaisons) {
+        if (it == nom) {
+            return indice_it;
+        }
+    }
+    return -1;
+}
+
+static bool valide_motif(Règle &règle, Expression const &expression)
+{
+    switch (expression.genre) {
+        case GenreExpression::OPÉRATEUR:
+        {
+            POUR (expression.opérandes) {
+                if (!valide_motif(règle, it)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        case GenreExpression::VARIABLE:
+        case GenreExpression::CONSTANTE_LIÉE:
+        {
+            if (donne_liaison(règle, expression.nom) == -1) {
+                règle.liaisons.ajoute(expression.nom);
+            }
+            return true;
+        }
+        case GenreExpression::CONSTANTE:
+        {
+            return true;
+        }
+        case GenreExpression::CONSTANTE_CALCULÉE:
+        {
+            règle.raison_erreur = "constante calculée dans un motif";
+            return false;
+        }
+    }
+    return false;
+}
+
+static bool valide_remplacement(Règle &règle, Expression const &expression)
+{
+    switch (expression.genre) {
+        case GenreExpression::OPÉRATEUR:
+        {
+            POUR (expression.opérandes) {
+                if (!valide_remplacement(règle, it)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        case GenreExpression::VARIABLE:
+        case GenreExpression::CONSTANTE_LIÉE:
+        case GenreExpression::CONSTANTE_CALCULÉE:
+        {
+            if (donne_liaison(règle, expression.nom) == -1) {
+                règle.raison_erreur = "« " + expression.nom + " » n'est pas lié par le motif";
+                return false;
+            }
+            return true;
+        }
+        case GenreExpression::CONSTANTE:
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void valide_règle(Règle &règle)
+{
+    if (!règle.raison_erreur.empty()) {
+        return;
+    }
+
+    if (règle.motif.genre != GenreExpression::OPÉRATEUR) {
+        règle.raison_erreur = "le motif doit être une opération";
+        return;
+    }
+
+    if (!valide_motif(règle, règle.motif)) {
+        return;
+    }
+
+    valide_remplacement(règle, règle.remplacement);
+}
+
+/** \} */
+
+/* ------------------------------------------------------------------------- */
+/** \name Génération du code.
+ * \{ */
+
+static void génère_noeuds(Règle &règle, Expression const &expression, std::ostream &os)
+{
+    auto genre_op = std::string("Invalide");
+    auto genre = "";
+    auto liaison = 0;
+    auto valeur = expression.valeur;
+
+    switch (expression.genre) {
+        case GenreExpression::OPÉRATEUR:
+        {
+            genre = "OPÉRATEUR";
+            genre_op = expression.opérateur->nom_genre;
+            break;
+        }
+        case GenreExpression::VARIABLE:
+        {
+            genre = "VARIABLE";
+            liaison = donne_liaison(règle, expression.nom);
+            break;
+        }
+        case GenreExpression::CONSTANTE:
+        {
+            genre = "CONSTANTE";
+            break;
+        }
+        case GenreExpression::CONSTANTE_LIÉE:
+        {
+            genre = "CONSTANTE_LIÉE";
+            liaison = donne_liaison(règle, expression.nom);
+            break;
+        }
+        case GenreExpression::CONSTANTE_CALCULÉE:
+        {
+            genre = "CONSTANTE_CALCULÉE";
+            genre_op = expression.opérateur->nom_genre;
+            liaison = donne_liaison(règle, expression.nom);
+            break;
+        }
+    }
+
+    os << "    {GenreNoeudMotif::" << genre << ", OpérateurBinaire::Genre::" << genre_op << ", "
+       << liaison << ", " << valeur << "},\n";
+
+    POUR (expression.opérandes) {
+        génère_noeuds(règle, it, os);
+    }
+}
+
+static int compte_noeuds(Expression const &expression)
+{
+    auto résultat = 1;
+    POUR (expression.opérandes) {
+        résultat += compte_noeuds(it);
+    }
+    return résultat;
+}
+
+static void génère_code(kuri::tableau<Règle> &règles, std::ostream &os)
+{
+    os << "// Fichier généré automatiquement, NE PAS ÉDITER\n\n";
+    inclus_système(os, "iterator");
+    os << "\n";
+    inclus(os, "regles_optimisation.hh");
+    os << "\n";
+
+    POUR (règles) {
+        if (it.raison_erreur.empty()) {
+            continue;
+        }
+        os << "/* Règle ignorée (" << it.raison_erreur << ") :\n";
+        os << " * " << it.texte << " */\n";
+    }
+    os << "\n";
+
+    POUR_INDICE (règles) {
+        if (!it.raison_erreur.empty()) {
+            continue;
+        }
+
+        os << "/* " << it.texte << " */\n";
+        os << "static const NoeudMotif motif_" << indice_it << "[] = {\n";
+        génère_noeuds(it, it.motif, os);
+        os << "};\n";
+        os << "static const NoeudMotif remplacement_" << indice_it << "[] = {\n";
+        génère_noeuds(it, it.remplacement, os);
+        os << "};\n\n";
+    }
+
+    /* Groupe les règles selon l'opérateur à la racine du motif. */
+    kuri::tableau<DonnéesOpérateur const *> opérateurs_racines;
+    POUR (règles) {
+        if (!it.raison_erreur.empty()) {
+            continue;
+        }
+
+        auto opérateur = it.motif.opérateur;
+        auto déjà_présent = false;
+        POUR_NOMME (op, opérateurs_racines) {
+            if (op == opérateur) {
+                déjà_présent = true;
+                break;
+            }
+        }
+
+        if (!déjà_présent) {
+            opérateurs_racines.ajoute(opérateur);
+        }
+    }
+
+    POUR_NOMME (opérateur, opérateurs_racines) {
+        os << "static const RègleRéécriture règles_" << opérateur->id << "[] = {\n";
+        POUR_INDICE (règles) {
+            if (!it.raison_erreur.empty() || it.motif.opérateur != opérateur) {
+                continue;
+            }
+
+            os << "    {\"" << it.texte << "\", motif_" << indice_it << ", "
+               << compte_noeuds(it.motif) << ", remplacement_" << indice_it << ", "
+               << compte_noeuds(it.remplacement) << ", " << it.liaisons.taille() << "},\n";
+        }
+        os << "};\n\n";
+    }
+
+    os << "kuri::tableau_statique<RègleRéécriture const> donne_règles_réécriture(\n";
+    os << "    OpérateurBinaire::Genre op)\n";
+    os << "{\n";
+    os << "    switch (op) {\n";
+    POUR_NOMME (opérateur, opérateurs_racines) {
+        os << "        case OpérateurBinaire::Genre::" << opérateur->nom_genre << ":\n";
+        os << "        {\n";
+        os << "            return {règles_" << opérateur->id << ", std::size(règles_"
+           << opérateur->id << ")};\n";
+        os << "        }\n";
+    }
+    os << "        default:\n";
+    os << "        {\n";
+    os << "            break;\n";
+    os << "        }\n";
+    os << "    }\n";
+    os << "\n";
+    os << "    return {};\n";
+    os << "}\n";
+}
+
+/** \} */
+
+int main(int argc, const char **argv)
+{
+    if (argc != 4) {
+        std::cerr << "Utilisation: " << argv[0] << " nom_fichier_sortie -i fichier_règles\n";
+        return 1;
+    }
+
+    auto nom_fichier_sortie = kuri::chemin_systeme(argv[1]);
+
+    std::ifstream fichier_règles(argv[3]);
+    if (!fichier_règles.is_open()) {
+        std::cerr << "Impossible d'ouvrir le fichier « " << argv[3] << " »\n";
+        return 1;
+    }
+
+    std::stringstream flux_texte;
+    flux_texte << fichier_règles.rdbuf();
+
+    auto analyseuse = AnalyseuseRègles();
+    analyseuse.mots = découpe_en_mots(supprime_commentaires(flux_texte.str()));
+
+    auto règles = analyseuse.analyse();
+    POUR (règles) {
+        valide_règle(it);
+    }
+
+    auto nom_fichier_tmp = kuri::chemin_systeme::chemin_temporaire(
+        nom_fichier_sortie.nom_fichier());
+
+    {
+        std::ofstream fichier_sortie(vers_std_path(nom_fichier_tmp));
+        génère_code(règles, fichier_sortie);
+    }
+
+    if (!remplace_si_différent(nom_fichier_tmp, argv[1])) {
+        return 1;
+    }
+
+    return 0;
+}
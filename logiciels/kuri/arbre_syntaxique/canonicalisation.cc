@@ -965,7 +965,7 @@ NoeudExpression *Simplificatrice::simplifie(NoeudExpression *noeud)
                 littérale_chaine->drapeaux |=
                     DrapeauxNoeud::LEXÈME_EST_RÉUTILISÉ_POUR_SUBSTITUTION;
                 auto fichier = espace->fichier(noeud->lexème->fichier);
-                littérale_chaine->valeur = compilatrice.gérante_chaine->ajoute_chaine(
+                littérale_chaine->valeur = compilatrice.gérante_chaine.ajoute_chaine(
                     fichier->chemin());
                 littérale_chaine->type = typeuse.type_chaine;
                 noeud->substitution = littérale_chaine;
@@ -976,7 +976,7 @@ NoeudExpression *Simplificatrice::simplifie(NoeudExpression *noeud)
                 littérale_chaine->drapeaux |=
                     DrapeauxNoeud::LEXÈME_EST_RÉUTILISÉ_POUR_SUBSTITUTION;
                 auto fichier = espace->fichier(noeud->lexème->fichier);
-                littérale_chaine->valeur = compilatrice.gérante_chaine->ajoute_chaine(
+                littérale_chaine->valeur = compilatrice.gérante_chaine.ajoute_chaine(
                     fichier->module->chemin());
                 littérale_chaine->type = typeuse.type_chaine;
                 noeud->substitution = littérale_chaine;
@@ -987,7 +987,7 @@ NoeudExpression *Simplificatrice::simplifie(NoeudExpression *noeud)
                 auto littérale_chaine = assem->crée_littérale_chaine(noeud->lexème);
                 littérale_chaine->drapeaux |=
                     DrapeauxNoeud::LEXÈME_EST_RÉUTILISÉ_POUR_SUBSTITUTION;
-                littérale_chaine->valeur = compilatrice.gérante_chaine->ajoute_chaine(
+                littérale_chaine->valeur = compilatrice.gérante_chaine.ajoute_chaine(
                     fonction_courante->ident->nom);
                 littérale_chaine->type = typeuse.type_chaine;
                 noeud->substitution = littérale_chaine;
@@ -1117,8 +1117,8 @@ IdentifiantCode *Simplificatrice::donne_identifiant_pour_variable()
     auto nom = enchaine("tmp_", nom_base, "_", m_nombre_variables);
     m_nombre_variables++;
 
-    auto table_identifiant = espace->compilatrice().table_identifiants.verrou_écriture();
-    return table_identifiant->identifiant_pour_nouvelle_chaine(nom);
+    auto &table_identifiants = espace->compilatrice().table_identifiants;
+    return table_identifiants.identifiant_pour_nouvelle_chaine(nom);
 }
 
 NoeudExpression *Simplificatrice::simplifie_boucle_pour(NoeudPour *inst)
@@ -2082,7 +2082,7 @@ void Simplificatrice::simplifie_position_code_source(NoeudDirectiveIntrospection
     auto const fichier = espace->fichier(lexème_site->fichier);
     auto valeur_chemin_fichier = assem->crée_littérale_chaine(lexème);
     valeur_chemin_fichier->drapeaux |= DrapeauxNoeud::LEXÈME_EST_RÉUTILISÉ_POUR_SUBSTITUTION;
-    valeur_chemin_fichier->valeur = compilatrice.gérante_chaine->ajoute_chaine(fichier->chemin());
+    valeur_chemin_fichier->valeur = compilatrice.gérante_chaine.ajoute_chaine(fichier->chemin());
     valeur_chemin_fichier->type = typeuse.type_chaine;
 
     /* PositionCodeSource.fonction */
@@ -2093,7 +2093,7 @@ void Simplificatrice::simplifie_position_code_source(NoeudDirectiveIntrospection
 
     auto valeur_nom_fonction = assem->crée_littérale_chaine(lexème);
     valeur_nom_fonction->drapeaux |= DrapeauxNoeud::LEXÈME_EST_RÉUTILISÉ_POUR_SUBSTITUTION;
-    valeur_nom_fonction->valeur = compilatrice.gérante_chaine->ajoute_chaine(nom_fonction);
+    valeur_nom_fonction->valeur = compilatrice.gérante_chaine.ajoute_chaine(nom_fonction);
     valeur_nom_fonction->type = typeuse.type_chaine;
 
     /* PositionCodeSource.ligne */
@@ -3,6 +3,8 @@
 
 #include "utilitaires.hh"
 
+#include <mutex>
+
 #include "compilation/broyage.hh"
 #include "compilation/compilatrice.hh"
 #include "compilation/contexte.hh"
@@ -1640,6 +1642,166 @@ static void init_table_hachage_rubriques(PointeurTableauVerrouillé<NoeudDéclar
     }
 }
 
+/* ------------------------------------------------------------------------- */
+/** \name IndexRubriquesBloc
+ * \{ */
+
+struct IndexRubriques {
+    /* Les rubriques dans l'ordre du bloc, pour les recherches linéaires. */
+    kuri::tableau<NoeudDéclaration *> rubriques{};
+    /* Première rubrique de chaque identifiant, seulement pour les grands blocs. */
+    TableRubriques table_rubriques{"index_rubriques_bloc"};
+};
+
+/* Index partagé par tous les blocs sans rubriques, pour ne pas en allouer un par bloc. */
+static const IndexRubriques index_rubriques_vide{};
+
+/* Les index remplacés, qui peuvent encore être lus par les tâches en cours de traitement. */
+struct IndexRubriquesRetirés {
+    std::mutex verrou{};
+    kuri::tableau<IndexRubriques const *, int> index{};
+    std::atomic<int> nombre_index = 0;
+    std::atomic<int> nombre_tâches_en_cours = 0;
+
+    ~IndexRubriquesRetirés()
+    {
+        POUR (index) {
+            delete it;
+        }
+    }
+
+    void ajoute(IndexRubriques const *index_retiré)
+    {
+        std::unique_lock l(verrou);
+        index.ajoute(index_retiré);
+        nombre_index.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void libère_si_aucune_tâche_en_cours()
+    {
+        std::unique_lock l(verrou);
+        /* Une tâche lisant un index retiré a été comptée avant sa lecture, qui précède le retrait
+         * de l'index (voir GardeLecturesIndexRubriques). */
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (nombre_tâches_en_cours.load(std::memory_order_acquire) != 0) {
+            return;
+        }
+
+        POUR (index) {
+            delete it;
+        }
+        index.efface();
+        nombre_index.store(0, std::memory_order_relaxed);
+    }
+};
+
+static IndexRubriquesRetirés index_rubriques_retirés{};
+
+GardeLecturesIndexRubriques::GardeLecturesIndexRubriques()
+{
+    index_rubriques_retirés.nombre_tâches_en_cours.fetch_add(1, std::memory_order_relaxed);
+    /* Ordonne le compte avant toute lecture d'un index par la tâche. */
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+GardeLecturesIndexRubriques::~GardeLecturesIndexRubriques()
+{
+    termine();
+}
+
+void GardeLecturesIndexRubriques::termine()
+{
+    if (!m_active) {
+        return;
+    }
+    m_active = false;
+
+    auto const tâches_en_cours = index_rubriques_retirés.nombre_tâches_en_cours.fetch_sub(
+        1, std::memory_order_acq_rel);
+    if (tâches_en_cours == 1 &&
+        index_rubriques_retirés.nombre_index.load(std::memory_order_relaxed) != 0) {
+        index_rubriques_retirés.libère_si_aucune_tâche_en_cours();
+    }
+}
+
+IndexRubriquesBloc::~IndexRubriquesBloc()
+{
+    /* Plus aucune recherche ne peut se faire dans le bloc. */
+    auto index = m_index.exchange(nullptr, std::memory_order_acq_rel);
+    if (index != nullptr && index != &index_rubriques_vide) {
+        delete index;
+    }
+}
+
+void IndexRubriquesBloc::publie(kuri::tableau_statique<NoeudDéclaration *> rubriques)
+{
+    if (m_index.load(std::memory_order_relaxed) != nullptr) {
+        /* L'index est invalidé à chaque modification, il est donc à jour. */
+        return;
+    }
+
+    if (rubriques.taille() == 0) {
+        m_index.store(&index_rubriques_vide, std::memory_order_release);
+        return;
+    }
+
+    auto index = new IndexRubriques();
+    index->rubriques = rubriques;
+    if (rubriques.taille() > TAILLE_MAX_TABLEAU_RUBRIQUES) {
+        POUR (rubriques) {
+            ajoute_rubrique(index->table_rubriques, it);
+        }
+    }
+
+    m_index.store(index, std::memory_order_release);
+}
+
+void IndexRubriquesBloc::invalide()
+{
+    auto index = m_index.exchange(nullptr, std::memory_order_seq_cst);
+    if (index == nullptr || index == &index_rubriques_vide) {
+        return;
+    }
+    /* Des lecteurs peuvent encore utiliser l'index. */
+    index_rubriques_retirés.ajoute(index);
+}
+
+NoeudDéclaration *donne_déclaration_pour_ident(IndexRubriques const *index,
+                                               IdentifiantCode const *ident)
+{
+    if (index->table_rubriques.taille() != 0) {
+        return index->table_rubriques.valeur_ou(ident, nullptr);
+    }
+
+    POUR (index->rubriques) {
+        if (it->ident == ident) {
+            return it;
+        }
+    }
+    return nullptr;
+}
+
+NoeudDéclaration *donne_déclaration_avec_même_ident_que(IndexRubriques const *index,
+                                                        NoeudExpression const *expr)
+{
+    if (index->table_rubriques.taille() != 0) {
+        auto résultat = index->table_rubriques.valeur_ou(expr->ident, nullptr);
+        if (résultat != expr) {
+            return résultat;
+        }
+        return nullptr;
+    }
+
+    POUR (index->rubriques) {
+        if (it != expr && it->ident == expr->ident) {
+            return it;
+        }
+    }
+    return nullptr;
+}
+
+/** \} */
+
 static void ajoute_à_ensemble_de_surcharge(NoeudDéclaration *decl, NoeudDéclaration *à_ajouter)
 {
     if (decl->est_entête_fonction()) {
@@ -1687,6 +1849,7 @@ void NoeudBloc::ajoute_rubrique(NoeudDéclaration *decl)
     }
 
     auto rubriques_ = rubriques.verrou_écriture();
+    index_rubriques.invalide();
     if (rubriques_->taille() >= TAILLE_MAX_TABLEAU_RUBRIQUES) {
         init_table_hachage_rubriques(rubriques_, table_rubriques);
         ::ajoute_rubrique(table_rubriques, decl);
@@ -1698,6 +1861,7 @@ void NoeudBloc::ajoute_rubrique(NoeudDéclaration *decl)
 void NoeudBloc::ajoute_rubrique_au_début(NoeudDéclaration *decl)
 {
     auto rubriques_ = rubriques.verrou_écriture();
+    index_rubriques.invalide();
     if (rubriques_->taille() >= TAILLE_MAX_TABLEAU_RUBRIQUES) {
         init_table_hachage_rubriques(rubriques_, table_rubriques);
         ::ajoute_rubrique(table_rubriques, decl);
@@ -1718,6 +1882,12 @@ void NoeudBloc::fusionne_rubriques(NoeudBloc *de)
     }
 }
 
+void NoeudBloc::publie_index_rubriques()
+{
+    auto rubriques_ = rubriques.verrou_écriture();
+    index_rubriques.publie(*rubriques_);
+}
+
 NoeudDéclaration *NoeudBloc::rubrique_pour_indice(int indice) const
 {
     return rubriques->a(indice);
@@ -1725,6 +1895,11 @@ NoeudDéclaration *NoeudBloc::rubrique_pour_indice(int indice) const
 
 NoeudDéclaration *NoeudBloc::déclaration_pour_ident(IdentifiantCode const *ident_recherche) const
 {
+    if (auto index = index_rubriques.donne_index()) {
+        nombre_recherches += 1;
+        return donne_déclaration_pour_ident(index, ident_recherche);
+    }
+
     auto rubriques_ = rubriques.verrou_lecture();
     nombre_recherches += 1;
 
@@ -1742,6 +1917,11 @@ NoeudDéclaration *NoeudBloc::déclaration_pour_ident(IdentifiantCode const *ide
 
 NoeudDéclaration *NoeudBloc::déclaration_avec_meme_ident_que(NoeudExpression const *expr) const
 {
+    if (auto index = index_rubriques.donne_index()) {
+        nombre_recherches += 1;
+        return donne_déclaration_avec_même_ident_que(index, expr);
+    }
+
     auto rubriques_ = rubriques.verrou_lecture();
     nombre_recherches += 1;
 
@@ -3280,7 +3460,7 @@ NoeudDéclarationEntêteFonction *crée_fonction_pour_métaprogramme(Contexte *c
 
         POUR (tuple->rubriques) {
             auto decl_sortie = assembleuse->crée_déclaration_variable(lexème, nullptr, nullptr);
-            decl_sortie->ident = compilatrice->table_identifiants->identifiant_pour_chaine(
+            decl_sortie->ident = compilatrice->table_identifiants.identifiant_pour_chaine(
                 "__ret0");
             decl_sortie->type = it.type;
             decl_sortie->drapeaux |= DrapeauxNoeud::DECLARATION_FUT_VALIDEE;
@@ -3290,12 +3470,12 @@ NoeudDéclarationEntêteFonction *crée_fonction_pour_métaprogramme(Contexte *c
         decl_entête->param_sortie = assembleuse->crée_déclaration_variable(
             lexème, nullptr, nullptr);
         decl_entête->param_sortie->ident =
-            compilatrice->table_identifiants->identifiant_pour_chaine("valeur_de_retour");
+            compilatrice->table_identifiants.identifiant_pour_chaine("valeur_de_retour");
         decl_entête->param_sortie->type = type_retour;
     }
     else {
         auto decl_sortie = assembleuse->crée_déclaration_variable(lexème, nullptr, nullptr);
-        decl_sortie->ident = compilatrice->table_identifiants->identifiant_pour_chaine("__ret0");
+        decl_sortie->ident = compilatrice->table_identifiants.identifiant_pour_chaine("__ret0");
         decl_sortie->type = type_retour;
         decl_sortie->drapeaux |= DrapeauxNoeud::DECLARATION_FUT_VALIDEE;
 
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <iosfwd>
 
 #include "prodeclaration.hh"
@@ -10,6 +11,7 @@
 #include "compilation/transformation_type.hh"
 
 #include "structures/chaine_statique.hh"
+#include "structures/tableau.hh"
 #include "structures/tableau_compresse.hh"
 #include "structures/tablet.hh"
 
@@ -513,6 +515,68 @@ kuri::tablet<IdentifiantCode *, 6> donne_les_noms_de_la_hiérarchie(NoeudBloc *b
 
 /** \} */
 
+/* ------------------------------------------------------------------------- */
+/** \name IndexRubriquesBloc
+ * Index des rubriques d'un bloc, publié quand le bloc est fermé, pour que les recherches de
+ * symboles puissent se faire sans verrou depuis toutes les tâcheronnes.
+ *
+ * Un index publié n'est jamais modifié. Toute modification des rubriques du bloc invalide
+ * l'index, et les recherches utilisent le verrou du bloc jusqu'à la prochaine publication. Les
+ * index remplacés pouvant encore être lus, ils sont mis de côté jusqu'à ce qu'aucune tâche ne
+ * soit en cours de traitement (voir GardeLecturesIndexRubriques).
+ * \{ */
+
+struct IndexRubriques;
+
+struct IndexRubriquesBloc {
+  private:
+    std::atomic<IndexRubriques const *> m_index{nullptr};
+
+  public:
+    IndexRubriquesBloc() = default;
+    ~IndexRubriquesBloc();
+
+    EMPECHE_COPIE(IndexRubriquesBloc);
+
+    /* Retourne l'index publié, ou nul s'il n'y en a pas. */
+    IndexRubriques const *donne_index() const
+    {
+        return m_index.load(std::memory_order_acquire);
+    }
+
+    /* Ces fonctions doivent être appelées avec le verrou d'écriture des rubriques du bloc. */
+    void publie(kuri::tableau_statique<NoeudDéclaration *> rubriques);
+    void invalide();
+};
+
+/* Les recherches de rubriques ne se font que lors du traitement des tâches par les tâcheronnes,
+ * traitement qui doit être encadré par cette garde. Les index retirés sont détruits dès que plus
+ * aucune tâche n'est en cours de traitement, aucune recherche ne pouvant alors les lire. */
+struct GardeLecturesIndexRubriques {
+  private:
+    bool m_active = true;
+
+  public:
+    GardeLecturesIndexRubriques();
+    ~GardeLecturesIndexRubriques();
+
+    EMPECHE_COPIE(GardeLecturesIndexRubriques);
+
+    /* Termine la garde avant sa destruction, par exemple avant de dormir. */
+    void termine();
+};
+
+/* Retourne la première déclaration de l'index ayant l'identifiant. */
+NoeudDéclaration *donne_déclaration_pour_ident(IndexRubriques const *index,
+                                               IdentifiantCode const *ident);
+
+/* Retourne la première déclaration de l'index ayant le même identifiant que l'expression, mais
+ * n'étant pas l'expression. */
+NoeudDéclaration *donne_déclaration_avec_même_ident_que(IndexRubriques const *index,
+                                                        NoeudExpression const *expr);
+
+/** \} */
+
 NoeudDéclarationEntêteFonction *crée_entête_pour_initialisation_type(Type *type,
                                                                      AssembleuseArbre *assembleuse,
                                                                      Typeuse &typeuse);
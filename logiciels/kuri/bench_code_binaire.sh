@@ -0,0 +1,49 @@
+#!/bin/bash
+
+# Compare l'exécution des métaprogrammes avec et sans --code_binaire_registres sur les fichiers de
+# exemples/tests (ou sur ceux donnés en paramètres).
+#
+# Utilisation : KURI=chemin/vers/kuri ./bench_code_binaire.sh [FICHIERS...]
+
+KURI=${KURI:-kuri}
+
+if [ $# -eq 0 ]; then
+    FICHIERS=`find exemples/tests -maxdepth 1 -type f -name "*.kuri"`
+else
+    FICHIERS=$@
+fi
+
+# Imprime le nombre d'instructions exécutées et le temps passé dans les métaprogrammes (en ms).
+mesure() {
+    $KURI --avec_stats $2 $1 2>/dev/null | awk -F'|' '
+        /Instructions exécutées/ { gsub(/[^0-9]/, "", $3); instructions = $3 }
+        /- Métaprogrammes/ { gsub(/ /, "", $3); temps = $3 }
+        END { print (instructions == "" ? 0 : instructions), (temps == "" ? 0 : temps) }'
+}
+
+printf "%-50s %14s %14s %10s %10s\n" "Fichier" "Inst. pile" "Inst. reg." "ms pile" "ms reg."
+
+total_pile=0
+total_registres=0
+temps_pile=0
+temps_registres=0
+
+for fichier in ${FICHIERS[@]}; do
+    read inst_pile ms_pile <<< `mesure $fichier ""`
+    read inst_registres ms_registres <<< `mesure $fichier --code_binaire_registres`
+
+    if [ "$inst_pile" = "0" ]; then
+        continue
+    fi
+
+    printf "%-50s %14d %14d %10s %10s\n" `basename $fichier` $inst_pile $inst_registres $ms_pile \
+        $ms_registres
+
+    total_pile=$((total_pile + inst_pile))
+    total_registres=$((total_registres + inst_registres))
+    temps_pile=`awk "BEGIN { print $temps_pile + $ms_pile }"`
+    temps_registres=`awk "BEGIN { print $temps_registres + $ms_registres }"`
+done
+
+printf "%-50s %14d %14d %10s %10s\n" "Total" $total_pile $total_registres $temps_pile \
+    $temps_registres
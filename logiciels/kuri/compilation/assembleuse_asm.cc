@@ -0,0 +1,1095 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * The Original Code is Copyright (C) 2021 Kévin Dietrich. */
+
+#include "assembleuse_asm.hh"
+
+#include <iostream>
+#include <limits>
+
+#define TABULATION "  "
+#define NOUVELLE_LIGNE "\n"
+
+#define VERIFIE_NON_ATTEINT assert(false)
+
+/* ------------------------------------------------------------------------- */
+/** \name Registres x64
+ * \{ */
+
+kuri::chaine_statique chaine_pour_registre(Registre registre, uint32_t taille_octet)
+{
+#define APPARIE_REGISTRE(type, nom1, nom2, nom4, nom8)                                            \
+    case Registre::type:                                                                          \
+    {                                                                                             \
+        if (taille_octet == 1)                                                                    \
+            return nom1;                                                                          \
+        if (taille_octet == 2)                                                                    \
+            return nom2;                                                                          \
+        if (taille_octet == 4)                                                                    \
+            return nom4;                                                                          \
+        return nom8;                                                                              \
+    }
+
+    switch (registre) {
+        APPARIE_REGISTRE(RAX, "al", "ax", "eax", "rax")
+        APPARIE_REGISTRE(RBX, "bl", "bx", "ebx", "rbx")
+        APPARIE_REGISTRE(RCX, "cl", "cx", "ecx", "rcx")
+        APPARIE_REGISTRE(RDX, "dl", "dx", "edx", "rdx")
+        APPARIE_REGISTRE(RSI, "sil", "si", "esi", "rsi")
+        APPARIE_REGISTRE(RDI, "dil", "di", "edi", "rdi")
+        APPARIE_REGISTRE(RBP, "bpl", "bp", "ebp", "rbp")
+        APPARIE_REGISTRE(RSP, "spl", "sp", "esp", "rsp")
+        APPARIE_REGISTRE(R8, "r8b", "r8w", "r8d", "r8")
+        APPARIE_REGISTRE(R9, "r9b", "r9w", "r9d", "r9")
+        APPARIE_REGISTRE(R10, "r10b", "r10w", "r10d", "r10")
+        APPARIE_REGISTRE(R11, "r11b", "r11w", "r11d", "r11")
+        APPARIE_REGISTRE(R12, "r12b", "r12w", "r12d", "r12")
+        APPARIE_REGISTRE(R13, "r13b", "r13w", "r13d", "r13")
+        APPARIE_REGISTRE(R14, "r14b", "r14W", "r14d", "r14")
+        APPARIE_REGISTRE(R15, "r15b", "r15w", "r15d", "r15")
+
+        APPARIE_REGISTRE(XMM0, "xmm0", "xmm0", "xmm0", "xmm0")
+        APPARIE_REGISTRE(XMM1, "xmm1", "xmm1", "xmm1", "xmm1")
+        APPARIE_REGISTRE(XMM2, "xmm2", "xmm2", "xmm2", "xmm2")
+        APPARIE_REGISTRE(XMM3, "xmm3", "xmm3", "xmm3", "xmm3")
+        APPARIE_REGISTRE(XMM4, "xmm4", "xmm4", "xmm4", "xmm4")
+        APPARIE_REGISTRE(XMM5, "xmm5", "xmm5", "xmm5", "xmm5")
+        APPARIE_REGISTRE(XMM6, "xmm6", "xmm6", "xmm6", "xmm6")
+        APPARIE_REGISTRE(XMM7, "xmm7", "xmm7", "xmm7", "xmm7")
+        case Registre::AH:
+        {
+            return "ah";
+        }
+    }
+
+#undef APPARIE_REGISTRE
+
+    return "registre_invalide";
+}
+
+std::ostream &operator<<(std::ostream &os, Registre reg)
+{
+    return os << chaine_pour_registre(reg, 8);
+}
+
+/** \} */
+
+/* ------------------------------------------------------------------------- */
+/** \name Assembleuse.
+ * \{ */
+
+static kuri::chaine_statique donne_chaine_taille_opérande(uint32_t taille)
+{
+    if (taille == 1) {
+        return "byte";
+    }
+    if (taille == 2) {
+        return "word";
+    }
+    if (taille == 4) {
+        return "dword";
+    }
+    return "qword";
+}
+
+std::ostream &operator<<(std::ostream &os, TypeOpérande type)
+{
+#define IMPRIME_CAS(x)                                                                            \
+    case TypeOpérande::x:                                                                         \
+        os << #x;                                                                                 \
+        break
+    switch (type) {
+        IMPRIME_CAS(REGISTRE);
+        IMPRIME_CAS(IMMÉDIATE8);
+        IMPRIME_CAS(IMMÉDIATE16);
+        IMPRIME_CAS(IMMÉDIATE32);
+        IMPRIME_CAS(IMMÉDIATE64);
+        IMPRIME_CAS(MÉMOIRE);
+        IMPRIME_CAS(FONCTION);
+        IMPRIME_CAS(GLOBALE);
+        IMPRIME_CAS(LABEL);
+    }
+#undef IMPRIME_CAS
+    return os;
+}
+
+static kuri::chaine_statique chaine_pour_mnémonique(Mnémonique mnémonique)
+{
+    switch (mnémonique) {
+#define ENUMERE_MNÉMONIQUE_EX(genre, nom)                                                         \
+    case Mnémonique::genre:                                                                       \
+        return nom;
+        ENUMERE_MNÉMONIQUES(ENUMERE_MNÉMONIQUE_EX)
+#undef ENUMERE_MNÉMONIQUE_EX
+    }
+    return "mnémonique_invalide";
+}
+
+std::ostream &operator<<(std::ostream &os, AssembleuseASM::Mémoire mémoire)
+{
+    auto const adresse = mémoire.adresse;
+    assert(adresse.taille() != 0);
+    auto const décalage = mémoire.décalage;
+    os << "[" << adresse;
+    if (décalage < 0) {
+        os << " - ";
+    }
+    else {
+        os << " + ";
+    }
+    os << abs(décalage) << "]";
+    return os;
+}
+
+/** \} */
+
+/* ------------------------------------------------------------------------- */
+/** \name Encodage des instructions x64.
+ * \{ */
+
+/* Le numéro du registre tel qu'encodé dans les instructions, dans l'ordre de l'énumération. */
+static const uint8_t numéros_registres[] = {
+    0, 3, 1, 2, 6, 7, 5, 4, 8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7, 4,
+};
+
+static uint8_t donne_numéro_registre(Registre registre)
+{
+    return numéros_registres[static_cast<int>(registre)];
+}
+
+/* Les registres spl, bpl, sil, et dil ne sont accessibles qu'avec un préfixe REX. */
+static bool requiers_rex_pour_octet(AssembleuseASM::Opérande const &opérande, uint32_t taille)
+{
+    if (taille != 1 || opérande.type != TypeOpérande::REGISTRE) {
+        return false;
+    }
+
+    auto const numéro = donne_numéro_registre(opérande.registre);
+    return opérande.registre != Registre::AH && numéro >= 4 && numéro <= 7;
+}
+
+/* La valeur est étendue depuis la taille de l'immédiate, puis tronquée à la taille de
+ * l'opération lors de l'encodage, comme le fait NASM. */
+static int64_t donne_valeur_immédiate(AssembleuseASM::Opérande const &opérande)
+{
+    switch (opérande.type) {
+        case TypeOpérande::IMMÉDIATE8:
+        {
+            return int8_t(opérande.immédiate8.valeur);
+        }
+        case TypeOpérande::IMMÉDIATE16:
+        {
+            return int16_t(opérande.immédiate16.valeur);
+        }
+        case TypeOpérande::IMMÉDIATE32:
+        {
+            return int32_t(opérande.immédiate32.valeur);
+        }
+        case TypeOpérande::IMMÉDIATE64:
+        {
+            return int64_t(opérande.immédiate64.valeur);
+        }
+        case TypeOpérande::REGISTRE:
+        case TypeOpérande::MÉMOIRE:
+        case TypeOpérande::FONCTION:
+        case TypeOpérande::GLOBALE:
+        case TypeOpérande::LABEL:
+        {
+            break;
+        }
+    }
+
+    VERIFIE_NON_ATTEINT;
+    return 0;
+}
+
+static bool est_accumulateur(AssembleuseASM::Opérande const &opérande)
+{
+    return AssembleuseASM::est_registre(opérande, Registre::RAX);
+}
+
+static bool est_octet_signé(int64_t valeur)
+{
+    return valeur >= -128 && valeur <= 127;
+}
+
+static bool est_entier_32_signé(int64_t valeur)
+{
+    return valeur >= std::numeric_limits<int32_t>::min() &&
+           valeur <= std::numeric_limits<int32_t>::max();
+}
+
+kuri::chaine_statique donne_symbole_et_décalage(kuri::chaine_statique expression,
+                                                int64_t &r_décalage)
+{
+    r_décalage = 0;
+
+    for (auto i = int64_t(0); i < expression.taille(); i++) {
+        if (expression[i] != '+' && expression[i] != '-') {
+            continue;
+        }
+
+        for (auto j = i + 1; j < expression.taille(); j++) {
+            if (expression[j] >= '0' && expression[j] <= '9') {
+                r_décalage = r_décalage * 10 + (expression[j] - '0');
+            }
+        }
+
+        if (expression[i] == '-') {
+            r_décalage = -r_décalage;
+        }
+
+        auto fin = i;
+        while (fin > 0 && expression[fin - 1] == ' ') {
+            fin -= 1;
+        }
+
+        return expression.sous_chaine(0, fin);
+    }
+
+    return expression;
+}
+
+void EncodeuseX64::émets_instruction(uint8_t préfixe,
+                                     bool rex_w,
+                                     bool rex_requis,
+                                     std::initializer_list<uint8_t> opcode,
+                                     uint8_t reg,
+                                     Opérande const &rm,
+                                     int64_t immédiate,
+                                     int taille_immédiate)
+{
+    auto const est_relatif_rip = rm.type == TypeOpérande::GLOBALE ||
+                                 (rm.type == TypeOpérande::MÉMOIRE && rm.mémoire.est_globale);
+
+    auto numéro_rm = uint8_t(0);
+    if (rm.type == TypeOpérande::REGISTRE) {
+        numéro_rm = donne_numéro_registre(rm.registre);
+    }
+    else if (!est_relatif_rip) {
+        assert(rm.type == TypeOpérande::MÉMOIRE);
+        numéro_rm = donne_numéro_registre(rm.mémoire.registre);
+    }
+
+    auto rex = uint8_t(0x40);
+    if (rex_w) {
+        rex |= 0x08;
+    }
+    if (reg & 8) {
+        rex |= 0x04;
+    }
+    if (numéro_rm & 8) {
+        rex |= 0x01;
+    }
+
+    if (préfixe != 0) {
+        émets_octet(préfixe);
+    }
+    if (rex != 0x40 || rex_requis) {
+        émets_octet(rex);
+    }
+    for (auto octet : opcode) {
+        émets_octet(octet);
+    }
+
+    auto const bits_reg = uint8_t((reg & 7) << 3);
+
+    if (rm.type == TypeOpérande::REGISTRE) {
+        émets_octet(uint8_t(0xC0 | bits_reg | (numéro_rm & 7)));
+    }
+    else if (est_relatif_rip) {
+        émets_octet(uint8_t(0x05 | bits_reg));
+        auto const expression = rm.type == TypeOpérande::GLOBALE ? rm.globale.valeur :
+                                                                    rm.mémoire.adresse;
+        émets_référence(expression, -4 - taille_immédiate, R_X86_64_PC32);
+    }
+    else {
+        auto const décalage = rm.mémoire.décalage;
+        auto const base = uint8_t(numéro_rm & 7);
+
+        /* rbp et r13 en base requièrent toujours un déplacement. */
+        auto mode = uint8_t(0x80);
+        if (décalage == 0 && base != 5) {
+            mode = 0x00;
+        }
+        else if (est_octet_signé(décalage)) {
+            mode = 0x40;
+        }
+
+        émets_octet(uint8_t(mode | bits_reg | base));
+
+        /* rsp et r12 en base requièrent un octet SIB. */
+        if (base == 4) {
+            émets_octet(0x24);
+        }
+
+        if (mode == 0x40) {
+            émets_immédiate(décalage, 1);
+        }
+        else if (mode == 0x80) {
+            émets_immédiate(décalage, 4);
+        }
+    }
+
+    if (taille_immédiate != 0) {
+        émets_immédiate(immédiate, taille_immédiate);
+    }
+}
+
+void EncodeuseX64::émets_instruction_avec_taille(uint32_t taille,
+                                                 std::initializer_list<uint8_t> opcode_octet,
+                                                 std::initializer_list<uint8_t> opcode,
+                                                 uint8_t reg,
+                                                 Opérande const &rm,
+                                                 bool rex_requis,
+                                                 int64_t immédiate,
+                                                 int taille_immédiate)
+{
+    auto const préfixe = uint8_t(taille == 2 ? 0x66 : 0x00);
+    émets_instruction(préfixe,
+                      taille == 8,
+                      rex_requis || requiers_rex_pour_octet(rm, taille),
+                      taille == 1 ? opcode_octet : opcode,
+                      reg,
+                      rm,
+                      immédiate,
+                      taille_immédiate);
+}
+
+void EncodeuseX64::encode_arithmétique(uint8_t extension,
+                                       Opérande dst,
+                                       Opérande src,
+                                       uint32_t taille)
+{
+    auto const base = uint8_t(extension * 8);
+
+    if (AssembleuseASM::est_immédiate(src.type)) {
+        auto const valeur = donne_valeur_immédiate(src);
+
+        /* Les formes pour l'accumulateur sont plus courtes, sauf face à une immédiate sur
+         * un octet étendue. */
+        if (est_accumulateur(dst) && (taille == 1 || !est_octet_signé(valeur))) {
+            émets_instruction_accumulateur(taille, uint8_t(base + 4), valeur);
+        }
+        else if (taille == 1) {
+            émets_instruction_avec_taille(
+                taille, {0x80}, {0x80}, extension, dst, false, valeur, 1);
+        }
+        else if (est_octet_signé(valeur)) {
+            émets_instruction_avec_taille(
+                taille, {0x83}, {0x83}, extension, dst, false, valeur, 1);
+        }
+        else {
+            auto const taille_immédiate = taille == 2 ? 2 : 4;
+            émets_instruction_avec_taille(
+                taille, {0x81}, {0x81}, extension, dst, false, valeur, taille_immédiate);
+        }
+        return;
+    }
+
+    if (src.type == TypeOpérande::REGISTRE) {
+        émets_instruction_avec_taille(taille,
+                                      {base},
+                                      {uint8_t(base + 1)},
+                                      donne_numéro_registre(src.registre),
+                                      dst,
+                                      requiers_rex_pour_octet(src, taille));
+        return;
+    }
+
+    assert(dst.type == TypeOpérande::REGISTRE);
+    émets_instruction_avec_taille(taille,
+                                  {uint8_t(base + 2)},
+                                  {uint8_t(base + 3)},
+                                  donne_numéro_registre(dst.registre),
+                                  src,
+                                  requiers_rex_pour_octet(dst, taille));
+}
+
+void EncodeuseX64::encode_mov(Opérande dst, Opérande src, uint32_t taille)
+{
+    if (AssembleuseASM::est_immédiate(src.type)) {
+        auto const valeur = donne_valeur_immédiate(src);
+
+        if (dst.type != TypeOpérande::REGISTRE) {
+            auto const taille_immédiate = taille == 1 ? 1 : (taille == 2 ? 2 : 4);
+            émets_instruction_avec_taille(
+                taille, {0xC6}, {0xC7}, 0, dst, false, valeur, taille_immédiate);
+            return;
+        }
+
+        auto const numéro = donne_numéro_registre(dst.registre);
+        auto rex = uint8_t(0x40 | ((numéro & 8) ? 0x01 : 0x00));
+
+        if (taille == 8 && !(valeur >= 0 && valeur <= 0xFFFFFFFF)) {
+            if (est_entier_32_signé(valeur)) {
+                émets_instruction(0x00, true, false, {0xC7}, 0, dst, valeur, 4);
+                return;
+            }
+
+            émets_octet(uint8_t(rex | 0x08));
+            émets_octet(uint8_t(0xB8 + (numéro & 7)));
+            émets_immédiate(valeur, 8);
+            return;
+        }
+
+        /* Les mouvements vers les registres 32-bit mettent à zéro les bits supérieurs. */
+        if (taille == 2) {
+            émets_octet(0x66);
+        }
+        if (rex != 0x40 || requiers_rex_pour_octet(dst, taille)) {
+            émets_octet(rex);
+        }
+
+        if (taille == 1) {
+            émets_octet(uint8_t(0xB0 + (numéro & 7)));
+            émets_immédiate(valeur, 1);
+        }
+        else {
+            émets_octet(uint8_t(0xB8 + (numéro & 7)));
+            émets_immédiate(valeur, taille == 2 ? 2 : 4);
+        }
+        return;
+    }
+
+    if (src.type == TypeOpérande::REGISTRE) {
+        émets_instruction_avec_taille(taille,
+                                      {0x88},
+                                      {0x89},
+                                      donne_numéro_registre(src.registre),
+                                      dst,
+                                      requiers_rex_pour_octet(src, taille));
+        return;
+    }
+
+    assert(dst.type == TypeOpérande::REGISTRE);
+    émets_instruction_avec_taille(taille,
+                                  {0x8A},
+                                  {0x8B},
+                                  donne_numéro_registre(dst.registre),
+                                  src,
+                                  requiers_rex_pour_octet(dst, taille));
+}
+
+void EncodeuseX64::émets_instruction_accumulateur(uint32_t taille,
+                                                  uint8_t opcode_octet,
+                                                  int64_t immédiate)
+{
+    if (taille == 2) {
+        émets_octet(0x66);
+    }
+    else if (taille == 8) {
+        émets_octet(0x48);
+    }
+
+    if (taille == 1) {
+        émets_octet(opcode_octet);
+        émets_immédiate(immédiate, 1);
+        return;
+    }
+
+    émets_octet(uint8_t(opcode_octet + 1));
+    émets_immédiate(immédiate, taille == 2 ? 2 : 4);
+}
+
+void EncodeuseX64::encode_décalage(uint8_t extension, Opérande dst, Opérande src, uint32_t taille)
+{
+    if (AssembleuseASM::est_immédiate(src.type)) {
+        auto const valeur = donne_valeur_immédiate(src);
+
+        if (valeur == 1) {
+            émets_instruction_avec_taille(taille, {0xD0}, {0xD1}, extension, dst, false);
+            return;
+        }
+
+        émets_instruction_avec_taille(taille, {0xC0}, {0xC1}, extension, dst, false, valeur, 1);
+        return;
+    }
+
+    assert(AssembleuseASM::est_registre(src, Registre::RCX));
+    émets_instruction_avec_taille(taille, {0xD2}, {0xD3}, extension, dst, false);
+}
+
+void EncodeuseX64::encode_sse(
+    uint8_t préfixe, uint8_t opcode, Opérande dst, Opérande src, bool rex_w)
+{
+    assert(dst.type == TypeOpérande::REGISTRE);
+    émets_instruction(
+        préfixe, rex_w, false, {0x0F, opcode}, donne_numéro_registre(dst.registre), src);
+}
+
+void EncodeuseX64::encode(Mnémonique mnémonique)
+{
+    switch (mnémonique) {
+        case Mnémonique::RET:
+        {
+            émets_octet(0xC3);
+            return;
+        }
+        case Mnémonique::SYSCALL:
+        {
+            émets_octet(0x0F);
+            émets_octet(0x05);
+            return;
+        }
+        case Mnémonique::UD2:
+        {
+            émets_octet(0x0F);
+            émets_octet(0x0B);
+            return;
+        }
+        case Mnémonique::INT3:
+        {
+            émets_octet(0xCC);
+            return;
+        }
+        case Mnémonique::CBW:
+        {
+            émets_octet(0x66);
+            émets_octet(0x98);
+            return;
+        }
+        case Mnémonique::CWD:
+        {
+            émets_octet(0x66);
+            émets_octet(0x99);
+            return;
+        }
+        case Mnémonique::CDQ:
+        {
+            émets_octet(0x99);
+            return;
+        }
+        case Mnémonique::CQO:
+        {
+            émets_octet(0x48);
+            émets_octet(0x99);
+            return;
+        }
+        default:
+        {
+            break;
+        }
+    }
+
+    VERIFIE_NON_ATTEINT;
+}
+
+void EncodeuseX64::encode_unaire(Mnémonique mnémonique, Opérande dst, uint32_t taille_dst)
+{
+    switch (mnémonique) {
+        case Mnémonique::JMP:
+        {
+            émets_octet(0xE9);
+            émets_référence_label(dst.label);
+            return;
+        }
+        case Mnémonique::JE:
+        case Mnémonique::JZ:
+        case Mnémonique::JNE:
+        case Mnémonique::JNZ:
+        case Mnémonique::JL:
+        case Mnémonique::JGE:
+        case Mnémonique::JLE:
+        case Mnémonique::JG:
+        {
+            auto code_condition = uint8_t(0x84);
+            if (mnémonique == Mnémonique::JNE || mnémonique == Mnémonique::JNZ) {
+                code_condition = 0x85;
+            }
+            else if (mnémonique == Mnémonique::JL) {
+                code_condition = 0x8C;
+            }
+            else if (mnémonique == Mnémonique::JGE) {
+                code_condition = 0x8D;
+            }
+            else if (mnémonique == Mnémonique::JLE) {
+                code_condition = 0x8E;
+            }
+            else if (mnémonique == Mnémonique::JG) {
+                code_condition = 0x8F;
+            }
+
+            émets_octet(0x0F);
+            émets_octet(code_condition);
+            émets_référence_label(dst.label);
+            return;
+        }
+        case Mnémonique::CALL:
+        {
+            if (dst.type == TypeOpérande::FONCTION) {
+                émets_octet(0xE8);
+                émets_référence(dst.fonction.valeur,
+                                -4,
+                                dst.fonction.plt ? R_X86_64_PLT32 : R_X86_64_PC32);
+                return;
+            }
+
+            émets_instruction(0x00, false, false, {0xFF}, 2, dst);
+            return;
+        }
+        case Mnémonique::PUSH:
+        {
+            if (dst.type == TypeOpérande::REGISTRE) {
+                auto const numéro = donne_numéro_registre(dst.registre);
+                if (numéro & 8) {
+                    émets_octet(0x41);
+                }
+                émets_octet(uint8_t(0x50 + (numéro & 7)));
+                return;
+            }
+
+            /* Comme pour nasm, les immédiates tenant sur un octet sont étendues. */
+            if (AssembleuseASM::est_immédiate(dst.type)) {
+                auto const valeur = donne_valeur_immédiate(dst);
+                auto const taille_immédiate = dst.type == TypeOpérande::IMMÉDIATE16 ? 2 : 4;
+
+                if (taille_immédiate == 2) {
+                    émets_octet(0x66);
+                }
+
+                if (est_octet_signé(valeur)) {
+                    émets_octet(0x6A);
+                    émets_immédiate(valeur, 1);
+                }
+                else {
+                    émets_octet(0x68);
+                    émets_immédiate(valeur, taille_immédiate);
+                }
+                return;
+            }
+
+            /* L'adresse d'une constante de la fonction ne peut être poussée comme une
+             * immédiate dans un exécutable indépendant de la position, elle est donc chargée
+             * relativement à rip : push rax; lea rax, [rip + .CN]; xchg [rsp], rax. */
+            if (dst.type == TypeOpérande::LABEL) {
+                émets_octet(0x50);
+                émets_octet(0x48);
+                émets_octet(0x8D);
+                émets_octet(0x05);
+                émets_référence_label(dst.label);
+                émets_octet(0x48);
+                émets_octet(0x87);
+                émets_octet(0x04);
+                émets_octet(0x24);
+                return;
+            }
+
+            auto const préfixe = uint8_t(taille_dst == 2 ? 0x66 : 0x00);
+            émets_instruction(préfixe, false, false, {0xFF}, 6, dst);
+            return;
+        }
+        case Mnémonique::POP:
+        {
+            if (dst.type == TypeOpérande::REGISTRE) {
+                auto const numéro = donne_numéro_registre(dst.registre);
+                if (numéro & 8) {
+                    émets_octet(0x41);
+                }
+                émets_octet(uint8_t(0x58 + (numéro & 7)));
+                return;
+            }
+
+            auto const préfixe = uint8_t(taille_dst == 2 ? 0x66 : 0x00);
+            émets_instruction(préfixe, false, false, {0x8F}, 0, dst);
+            return;
+        }
+        case Mnémonique::NOT:
+        case Mnémonique::NEG:
+        case Mnémonique::MUL:
+        case Mnémonique::IMUL:
+        case Mnémonique::DIV:
+        case Mnémonique::IDIV:
+        {
+            auto extension = uint8_t(2);
+            if (mnémonique == Mnémonique::NEG) {
+                extension = 3;
+            }
+            else if (mnémonique == Mnémonique::MUL) {
+                extension = 4;
+            }
+            else if (mnémonique == Mnémonique::IMUL) {
+                extension = 5;
+            }
+            else if (mnémonique == Mnémonique::DIV) {
+                extension = 6;
+            }
+            else if (mnémonique == Mnémonique::IDIV) {
+                extension = 7;
+            }
+
+            émets_instruction_avec_taille(taille_dst, {0xF6}, {0xF7}, extension, dst, false);
+            return;
+        }
+        default:
+        {
+            break;
+        }
+    }
+
+    VERIFIE_NON_ATTEINT;
+}
+
+void EncodeuseX64::encode_binaire(Mnémonique mnémonique,
+                                  Opérande dst,
+                                  uint32_t taille_dst,
+                                  Opérande src,
+                                  uint32_t taille_src)
+{
+    switch (mnémonique) {
+        case Mnémonique::ADD:
+        {
+            encode_arithmétique(0, dst, src, taille_dst);
+            return;
+        }
+        case Mnémonique::OR:
+        {
+            encode_arithmétique(1, dst, src, taille_dst);
+            return;
+        }
+        case Mnémonique::AND:
+        {
+            encode_arithmétique(4, dst, src, taille_dst);
+            return;
+        }
+        case Mnémonique::SUB:
+        {
+            encode_arithmétique(5, dst, src, taille_dst);
+            return;
+        }
+        case Mnémonique::XOR:
+        {
+            encode_arithmétique(6, dst, src, taille_dst);
+            return;
+        }
+        case Mnémonique::CMP:
+        {
+            encode_arithmétique(7, dst, src, taille_dst);
+            return;
+        }
+        case Mnémonique::TEST:
+        {
+            if (AssembleuseASM::est_immédiate(src.type) && est_accumulateur(dst)) {
+                émets_instruction_accumulateur(taille_dst, 0xA8, donne_valeur_immédiate(src));
+                return;
+            }
+
+            if (AssembleuseASM::est_immédiate(src.type)) {
+                auto const taille_immédiate = taille_dst == 1 ? 1 : (taille_dst == 2 ? 2 : 4);
+                émets_instruction_avec_taille(taille_dst,
+                                              {0xF6},
+                                              {0xF7},
+                                              0,
+                                              dst,
+                                              false,
+                                              donne_valeur_immédiate(src),
+                                              taille_immédiate);
+                return;
+            }
+
+            assert(src.type == TypeOpérande::REGISTRE);
+            émets_instruction_avec_taille(taille_dst,
+                                          {0x84},
+                                          {0x85},
+                                          donne_numéro_registre(src.registre),
+                                          dst,
+                                          requiers_rex_pour_octet(src, taille_dst));
+            return;
+        }
+        case Mnémonique::MOV:
+        {
+            encode_mov(dst, src, taille_dst);
+            return;
+        }
+        case Mnémonique::MOVSX:
+        case Mnémonique::MOVZX:
+        {
+            assert(dst.type == TypeOpérande::REGISTRE);
+
+            /* Les mouvements vers les registres 32-bit mettent à zéro les bits supérieurs. */
+            if (taille_src >= taille_dst ||
+                (mnémonique == Mnémonique::MOVZX && taille_src == 4)) {
+                encode_mov(dst, src, std::min(taille_src, taille_dst));
+                return;
+            }
+
+            auto const préfixe = uint8_t(taille_dst == 2 ? 0x66 : 0x00);
+            auto const reg = donne_numéro_registre(dst.registre);
+            auto const rex_requis = requiers_rex_pour_octet(src, taille_src);
+
+            if (taille_src == 4) {
+                émets_instruction(préfixe, taille_dst == 8, rex_requis, {0x63}, reg, src);
+                return;
+            }
+
+            auto opcode = uint8_t(taille_src == 1 ? 0xB6 : 0xB7);
+            if (mnémonique == Mnémonique::MOVSX) {
+                opcode += 8;
+            }
+
+            émets_instruction(préfixe, taille_dst == 8, rex_requis, {0x0F, opcode}, reg, src);
+            return;
+        }
+        case Mnémonique::LEA:
+        {
+            assert(dst.type == TypeOpérande::REGISTRE);
+            émets_instruction(
+                0x00, true, false, {0x8D}, donne_numéro_registre(dst.registre), src);
+            return;
+        }
+        case Mnémonique::IMUL:
+        {
+            assert(dst.type == TypeOpérande::REGISTRE);
+            auto const reg = donne_numéro_registre(dst.registre);
+
+            if (AssembleuseASM::est_immédiate(src.type)) {
+                auto const valeur = donne_valeur_immédiate(src);
+                if (est_octet_signé(valeur)) {
+                    émets_instruction_avec_taille(
+                        taille_dst, {0x6B}, {0x6B}, reg, dst, false, valeur, 1);
+                }
+                else {
+                    émets_instruction_avec_taille(taille_dst,
+                                                  {0x69},
+                                                  {0x69},
+                                                  reg,
+                                                  dst,
+                                                  false,
+                                                  valeur,
+                                                  taille_dst == 2 ? 2 : 4);
+                }
+                return;
+            }
+
+            émets_instruction_avec_taille(taille_dst, {0x0F, 0xAF}, {0x0F, 0xAF}, reg, src, false);
+            return;
+        }
+        case Mnémonique::SHL:
+        {
+            encode_décalage(4, dst, src, taille_dst);
+            return;
+        }
+        case Mnémonique::SHR:
+        {
+            encode_décalage(5, dst, src, taille_dst);
+            return;
+        }
+        case Mnémonique::SAR:
+        {
+            encode_décalage(7, dst, src, taille_dst);
+            return;
+        }
+        case Mnémonique::CMOVE:
+        case Mnémonique::CMOVNE:
+        case Mnémonique::CMOVL:
+        case Mnémonique::CMOVGE:
+        case Mnémonique::CMOVLE:
+        case Mnémonique::CMOVG:
+        {
+            auto code_condition = uint8_t(0x44);
+            if (mnémonique == Mnémonique::CMOVNE) {
+                code_condition = 0x45;
+            }
+            else if (mnémonique == Mnémonique::CMOVL) {
+                code_condition = 0x4C;
+            }
+            else if (mnémonique == Mnémonique::CMOVGE) {
+                code_condition = 0x4D;
+            }
+            else if (mnémonique == Mnémonique::CMOVLE) {
+                code_condition = 0x4E;
+            }
+            else if (mnémonique == Mnémonique::CMOVG) {
+                code_condition = 0x4F;
+            }
+
+            assert(dst.type == TypeOpérande::REGISTRE);
+            émets_instruction_avec_taille(taille_dst,
+                                          {0x0F, code_condition},
+                                          {0x0F, code_condition},
+                                          donne_numéro_registre(dst.registre),
+                                          src,
+                                          false);
+            return;
+        }
+        case Mnémonique::MOVSS:
+        case Mnémonique::MOVSD:
+        {
+            auto const préfixe = uint8_t(mnémonique == Mnémonique::MOVSS ? 0xF3 : 0xF2);
+            if (dst.type == TypeOpérande::REGISTRE) {
+                encode_sse(préfixe, 0x10, dst, src, false);
+                return;
+            }
+
+            assert(src.type == TypeOpérande::REGISTRE);
+            émets_instruction(
+                préfixe, false, false, {0x0F, 0x11}, donne_numéro_registre(src.registre), dst);
+            return;
+        }
+        case Mnémonique::ADDSS:
+        {
+            encode_sse(0xF3, 0x58, dst, src, false);
+            return;
+        }
+        case Mnémonique::ADDSD:
+        {
+            encode_sse(0xF2, 0x58, dst, src, false);
+            return;
+        }
+        case Mnémonique::MULSS:
+        {
+            encode_sse(0xF3, 0x59, dst, src, false);
+            return;
+        }
+        case Mnémonique::MULSD:
+        {
+            encode_sse(0xF2, 0x59, dst, src, false);
+            return;
+        }
+        case Mnémonique::SUBSS:
+        {
+            encode_sse(0xF3, 0x5C, dst, src, false);
+            return;
+        }
+        case Mnémonique::SUBSD:
+        {
+            encode_sse(0xF2, 0x5C, dst, src, false);
+            return;
+        }
+        case Mnémonique::DIVSS:
+        {
+            encode_sse(0xF3, 0x5E, dst, src, false);
+            return;
+        }
+        case Mnémonique::DIVSD:
+        {
+            encode_sse(0xF2, 0x5E, dst, src, false);
+            return;
+        }
+        case Mnémonique::XORPS:
+        {
+            encode_sse(0x00, 0x57, dst, src, false);
+            return;
+        }
+        case Mnémonique::PXOR:
+        {
+            encode_sse(0x66, 0xEF, dst, src, false);
+            return;
+        }
+        case Mnémonique::UCOMISS:
+        {
+            encode_sse(0x00, 0x2E, dst, src, false);
+            return;
+        }
+        case Mnémonique::UCOMISD:
+        {
+            encode_sse(0x66, 0x2E, dst, src, false);
+            return;
+        }
+        case Mnémonique::CVTSD2SS:
+        {
+            encode_sse(0xF2, 0x5A, dst, src, false);
+            return;
+        }
+        case Mnémonique::CVTTSS2SI:
+        {
+            encode_sse(0xF3, 0x2C, dst, src, taille_dst == 8);
+            return;
+        }
+        case Mnémonique::CVTSS2SI:
+        {
+            encode_sse(0xF3, 0x2D, dst, src, taille_dst == 8);
+            return;
+        }
+        case Mnémonique::CVTTSD2SI:
+        {
+            encode_sse(0xF2, 0x2C, dst, src, taille_dst == 8);
+            return;
+        }
+        case Mnémonique::CVTSD2SI:
+        {
+            encode_sse(0xF2, 0x2D, dst, src, taille_dst == 8);
+            return;
+        }
+        case Mnémonique::CVTSI2SS:
+        {
+            encode_sse(0xF3, 0x2A, dst, src, taille_src == 8);
+            return;
+        }
+        case Mnémonique::CVTSI2SD:
+        {
+            encode_sse(0xF2, 0x2A, dst, src, taille_src == 8);
+            return;
+        }
+        default:
+        {
+            break;
+        }
+    }
+
+    VERIFIE_NON_ATTEINT;
+}
+
+/** \} */
+
+/* ------------------------------------------------------------------------- */
+/** \name Sorties de l'assembleuse.
+ * \{ */
+
+void AssembleuseASM::ajoute_instruction(Mnémonique mnémonique)
+{
+    if (m_encodeuse) {
+        m_encodeuse->encode(mnémonique);
+        return;
+    }
+
+    *m_sortie << TABULATION << chaine_pour_mnémonique(mnémonique) << NOUVELLE_LIGNE;
+}
+
+void AssembleuseASM::ajoute_instruction_unaire(Mnémonique mnémonique,
+                                               Opérande dst,
+                                               uint32_t taille_dst)
+{
+    if (m_encodeuse) {
+        m_encodeuse->encode_unaire(mnémonique, dst, taille_dst);
+        return;
+    }
+
+    *m_sortie << TABULATION << chaine_pour_mnémonique(mnémonique) << " ";
+    imprime_opérande(dst, taille_dst);
+    *m_sortie << NOUVELLE_LIGNE;
+}
+
+void AssembleuseASM::ajoute_instruction_binaire(Mnémonique mnémonique,
+                                                Opérande dst,
+                                                uint32_t taille_dst,
+                                                Opérande src,
+                                                uint32_t taille_src)
+{
+    if (m_encodeuse) {
+        m_encodeuse->encode_binaire(mnémonique, dst, taille_dst, src, taille_src);
+        return;
+    }
+
+    *m_sortie << TABULATION << chaine_pour_mnémonique(mnémonique) << " ";
+
+    if (mnémonique == Mnémonique::MOV && dst.type == TypeOpérande::MÉMOIRE) {
+        *m_sortie << donne_chaine_taille_opérande(taille_dst) << " ";
+    }
+
+    imprime_opérande(dst, taille_dst);
+    *m_sortie << ", ";
+    imprime_opérande(src, taille_src);
+    *m_sortie << NOUVELLE_LIGNE;
+}
+
+void AssembleuseASM::ajoute_label(Label label)
+{
+    if (m_encodeuse) {
+        m_encodeuse->définis_label(label);
+        return;
+    }
+
+    *m_sortie << "." << label.nom << label.indice << ":" << NOUVELLE_LIGNE;
+}
+
+/** \} */
@@ -0,0 +1,1115 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * The Original Code is Copyright (C) 2021 Kévin Dietrich. */
+
+#pragma once
+
+#include <cstdlib>
+#include <initializer_list>
+#include <iosfwd>
+
+#include "structures/chaine_statique.hh"
+#include "structures/enchaineuse.hh"
+#include "structures/table_hachage.hh"
+#include "structures/tableau.hh"
+
+#include "utilitaires/log.hh"
+#include "utilitaires/macros.hh"
+
+#include "fichier_elf.hh"
+
+/* ------------------------------------------------------------------------- */
+/** \name Registres x64
+ * \{ */
+
+enum class Registre {
+    RAX,
+    RBX,
+    RCX,
+    RDX,
+    RSI,
+    RDI,
+    RBP,
+    RSP,
+    R8,
+    R9,
+    R10,
+    R11,
+    R12,
+    R13,
+    R14,
+    R15,
+
+    XMM0,
+    XMM1,
+    XMM2,
+    XMM3,
+    XMM4,
+    XMM5,
+    XMM6,
+    XMM7,
+
+    /* Cas spécial. */
+    AH,
+};
+
+#define NOMBRE_REGISTRES_ENTIER 16
+#define NOMBRE_REGISTRES_RÉEL 8
+#define NOMBRE_REGISTRES (NOMBRE_REGISTRES_ENTIER + NOMBRE_REGISTRES_RÉEL)
+
+kuri::chaine_statique chaine_pour_registre(Registre registre, uint32_t taille_octet);
+
+std::ostream &operator<<(std::ostream &os, Registre reg);
+
+/** \} */
+
+/* ------------------------------------------------------------------------- */
+/** \name Assembleuse.
+ * Les instructions sont soit imprimées pour être assemblées par NASM, soit directement encodées
+ * par une EncodeuseX64.
+ * \{ */
+
+enum class TypeOpérande {
+    REGISTRE,
+    IMMÉDIATE8,
+    IMMÉDIATE16,
+    IMMÉDIATE32,
+    IMMÉDIATE64,
+    MÉMOIRE,
+    FONCTION,
+    GLOBALE,
+    LABEL,
+};
+
+std::ostream &operator<<(std::ostream &os, TypeOpérande type);
+
+/* Les mnémoniques des instructions émises par l'AssembleuseASM. */
+#define ENUMERE_MNÉMONIQUES(O)                                                                    \
+    O(ADD, "add")                                                                                 \
+    O(ADDSD, "addsd")                                                                             \
+    O(ADDSS, "addss")                                                                             \
+    O(AND, "and")                                                                                 \
+    O(CALL, "call")                                                                               \
+    O(CBW, "cbw")                                                                                 \
+    O(CDQ, "cdq")                                                                                 \
+    O(CMOVE, "cmove")                                                                             \
+    O(CMOVG, "cmovg")                                                                             \
+    O(CMOVGE, "cmovge")                                                                           \
+    O(CMOVL, "cmovl")                                                                             \
+    O(CMOVLE, "cmovle")                                                                           \
+    O(CMOVNE, "cmovne")                                                                           \
+    O(CMP, "cmp")                                                                                 \
+    O(CQO, "cqo")                                                                                 \
+    O(CVTSD2SI, "cvtsd2si")                                                                       \
+    O(CVTSD2SS, "cvtsd2ss")                                                                       \
+    O(CVTSI2SD, "cvtsi2sd")                                                                       \
+    O(CVTSI2SS, "cvtsi2ss")                                                                       \
+    O(CVTSS2SI, "cvtss2si")                                                                       \
+    O(CVTTSD2SI, "cvttsd2si")                                                                     \
+    O(CVTTSS2SI, "cvttss2si")                                                                     \
+    O(CWD, "cwd")                                                                                 \
+    O(DIV, "div")                                                                                 \
+    O(DIVSD, "divsd")                                                                             \
+    O(DIVSS, "divss")                                                                             \
+    O(IDIV, "idiv")                                                                               \
+    O(IMUL, "imul")                                                                               \
+    O(INT3, "int3")                                                                               \
+    O(JE, "je")                                                                                   \
+    O(JG, "jg")                                                                                   \
+    O(JGE, "jge")                                                                                 \
+    O(JL, "jl")                                                                                   \
+    O(JLE, "jle")                                                                                 \
+    O(JMP, "jmp")                                                                                 \
+    O(JNE, "jne")                                                                                 \
+    O(JNZ, "jnz")                                                                                 \
+    O(JZ, "jz")                                                                                   \
+    O(LEA, "lea")                                                                                 \
+    O(MOV, "mov")                                                                                 \
+    O(MOVSD, "movsd")                                                                             \
+    O(MOVSS, "movss")                                                                             \
+    O(MOVSX, "movsx")                                                                             \
+    O(MOVZX, "movzx")                                                                             \
+    O(MUL, "mul")                                                                                 \
+    O(MULSD, "mulsd")                                                                             \
+    O(MULSS, "mulss")                                                                             \
+    O(NEG, "neg")                                                                                 \
+    O(NOT, "not")                                                                                 \
+    O(OR, "or")                                                                                   \
+    O(POP, "pop")                                                                                 \
+    O(PUSH, "push")                                                                               \
+    O(PXOR, "pxor")                                                                               \
+    O(RET, "ret")                                                                                 \
+    O(SAR, "sar")                                                                                 \
+    O(SHL, "shl")                                                                                 \
+    O(SHR, "shr")                                                                                 \
+    O(SUB, "sub")                                                                                 \
+    O(SUBSD, "subsd")                                                                             \
+    O(SUBSS, "subss")                                                                             \
+    O(SYSCALL, "syscall")                                                                         \
+    O(TEST, "test")                                                                               \
+    O(UCOMISD, "ucomisd")                                                                         \
+    O(UCOMISS, "ucomiss")                                                                         \
+    O(UD2, "ud2")                                                                                 \
+    O(XOR, "xor")                                                                                 \
+    O(XORPS, "xorps")
+
+enum class Mnémonique : uint8_t {
+#define ENUMERE_MNÉMONIQUE_EX(genre, nom) genre,
+    ENUMERE_MNÉMONIQUES(ENUMERE_MNÉMONIQUE_EX)
+#undef ENUMERE_MNÉMONIQUE_EX
+};
+
+class EncodeuseX64;
+
+struct AssembleuseASM {
+  private:
+    /* Seule l'une des deux sorties est active : soit le code est imprimé pour être assemblé par
+     * NASM, soit il est directement encodé dans un fichier objet. */
+    Enchaineuse *m_sortie = nullptr;
+    EncodeuseX64 *m_encodeuse = nullptr;
+
+  public:
+    struct Immédiate8 {
+        uint8_t valeur;
+    };
+
+    struct Immédiate16 {
+        uint16_t valeur;
+    };
+
+    struct Immédiate32 {
+        uint32_t valeur;
+    };
+
+    struct Immédiate64 {
+        uint64_t valeur;
+    };
+
+    struct Fonction {
+        kuri::chaine_statique valeur{};
+        bool plt = false;
+    };
+
+    struct Globale {
+        kuri::chaine_statique valeur;
+    };
+
+    struct Label {
+        kuri::chaine_statique nom;
+        int indice;
+    };
+
+    static bool est_immédiate(TypeOpérande type)
+    {
+        switch (type) {
+            case TypeOpérande::IMMÉDIATE8:
+            case TypeOpérande::IMMÉDIATE16:
+            case TypeOpérande::IMMÉDIATE32:
+            case TypeOpérande::IMMÉDIATE64:
+            {
+                return true;
+            }
+            case TypeOpérande::REGISTRE:
+            case TypeOpérande::MÉMOIRE:
+            case TypeOpérande::FONCTION:
+            case TypeOpérande::GLOBALE:
+            case TypeOpérande::LABEL:
+            {
+                return false;
+            }
+        }
+        return false;
+    }
+
+    struct Mémoire {
+        /* Un registre ou le nom d'une globale. */
+        kuri::chaine_statique adresse{};
+        int32_t décalage = 0;
+        bool est_globale = false;
+        /* Le registre de base, si l'adresse n'est pas celle d'une globale. */
+        Registre registre{};
+
+        Mémoire() = default;
+
+        Mémoire(Registre registre_, int32_t décalage_ = 0)
+            : adresse(chaine_pour_registre(registre_, 8)), décalage(décalage_),
+              registre(registre_)
+        {
+        }
+
+        Mémoire(kuri::chaine_statique globale) : adresse(globale), est_globale(true)
+        {
+        }
+    };
+
+    struct Opérande {
+        TypeOpérande type{};
+        Registre registre{};
+        Immédiate8 immédiate8{};
+        Immédiate16 immédiate16{};
+        Immédiate32 immédiate32{};
+        Immédiate64 immédiate64{};
+        Mémoire mémoire{};
+        Fonction fonction{};
+        Globale globale{};
+        Label label{};
+
+        Opérande()
+        {
+        }
+
+        Opérande(Mémoire mém) : type(TypeOpérande::MÉMOIRE), mémoire(mém)
+        {
+        }
+
+        Opérande(Immédiate8 imm) : type(TypeOpérande::IMMÉDIATE8), immédiate8(imm)
+        {
+        }
+
+        Opérande(Immédiate16 imm) : type(TypeOpérande::IMMÉDIATE16), immédiate16(imm)
+        {
+        }
+
+        Opérande(Immédiate32 imm) : type(TypeOpérande::IMMÉDIATE32), immédiate32(imm)
+        {
+        }
+
+        Opérande(Immédiate64 imm) : type(TypeOpérande::IMMÉDIATE64), immédiate64(imm)
+        {
+        }
+
+        Opérande(Registre reg) : type(TypeOpérande::REGISTRE), registre(reg)
+        {
+        }
+
+        Opérande(Fonction fonct) : type(TypeOpérande::FONCTION), fonction(fonct)
+        {
+        }
+
+        Opérande(Globale glob) : type(TypeOpérande::GLOBALE), globale(glob)
+        {
+        }
+
+        Opérande(Label lab) : type(TypeOpérande::LABEL), label(lab)
+        {
+        }
+
+        bool est_mémoire() const
+        {
+            return type == TypeOpérande::MÉMOIRE && mémoire.est_globale == false;
+        }
+    };
+
+    static bool est_registre(Opérande src, Registre reg)
+    {
+        return src.type == TypeOpérande::REGISTRE && src.registre == reg;
+    }
+
+    static Opérande donne_immédiate8(Opérande opérande)
+    {
+        assert(est_immédiate(opérande.type));
+        if (opérande.type == TypeOpérande::IMMÉDIATE16) {
+            return Immédiate8{static_cast<uint8_t>(opérande.immédiate16.valeur)};
+        }
+        if (opérande.type == TypeOpérande::IMMÉDIATE32) {
+            return Immédiate8{static_cast<uint8_t>(opérande.immédiate32.valeur)};
+        }
+        if (opérande.type == TypeOpérande::IMMÉDIATE64) {
+            return Immédiate8{static_cast<uint8_t>(opérande.immédiate64.valeur)};
+        }
+        return opérande;
+    }
+
+    AssembleuseASM(Enchaineuse &sortie) : m_sortie(&sortie)
+    {
+    }
+
+    AssembleuseASM(EncodeuseX64 &encodeuse) : m_encodeuse(&encodeuse)
+    {
+    }
+
+    EMPECHE_COPIE(AssembleuseASM);
+
+    void commente(kuri::chaine_statique message)
+    {
+        if (m_sortie) {
+            *m_sortie << "  ;" << message << "\n";
+        }
+    }
+
+    void mov(Opérande dst, Opérande src, uint32_t taille)
+    {
+        assert(!est_immédiate(dst.type));
+        assert(taille <= 8);
+        assert(!dst.est_mémoire() || !src.est_mémoire());
+        ajoute_instruction_binaire(Mnémonique::MOV, dst, taille, src, taille);
+    }
+
+    void mov_ah(Opérande dst)
+    {
+        assert(!est_immédiate(dst.type));
+        ajoute_instruction_binaire(Mnémonique::MOV, dst, 1, Registre::AH, 1);
+    }
+
+    void movsx(Opérande dst, uint32_t taille_dst, Opérande src, uint32_t taille_src)
+    {
+        assert(!est_immédiate(dst.type) && !est_immédiate(src.type));
+        assert(taille_dst <= 8 && taille_src <= 8);
+        assert(!dst.est_mémoire() || !src.est_mémoire());
+        ajoute_instruction_binaire(Mnémonique::MOVSX, dst, taille_dst, src, taille_src);
+    }
+
+    void movzx(Opérande dst, uint32_t taille_dst, Opérande src, uint32_t taille_src)
+    {
+        assert(!est_immédiate(dst.type) && !est_immédiate(src.type));
+        assert(taille_dst <= 8 && taille_src <= 8);
+        assert(!dst.est_mémoire() || !src.est_mémoire());
+        ajoute_instruction_binaire(Mnémonique::MOVZX, dst, taille_dst, src, taille_src);
+    }
+
+    void movss(Opérande dst, Opérande src)
+    {
+        assert(!est_immédiate(dst.type));
+        assert(dst.type != TypeOpérande::MÉMOIRE || src.type != TypeOpérande::MÉMOIRE);
+        ajoute_instruction_binaire(Mnémonique::MOVSS, dst, 4, src, 4);
+    }
+
+    void movsd(Opérande dst, Opérande src)
+    {
+        assert(!est_immédiate(dst.type));
+        assert(dst.type != TypeOpérande::MÉMOIRE || src.type != TypeOpérande::MÉMOIRE);
+        ajoute_instruction_binaire(Mnémonique::MOVSD, dst, 8, src, 8);
+    }
+
+    void lea(Opérande dst, Opérande src)
+    {
+        assert_rappel(src.type == TypeOpérande::MÉMOIRE,
+                      [&]() { dbg() << "La source est de type " << src.type; });
+        assert(dst.type == TypeOpérande::REGISTRE);
+        ajoute_instruction_binaire(Mnémonique::LEA, dst, 8, src, 8);
+    }
+
+    void call(Opérande src)
+    {
+        ajoute_instruction_unaire(Mnémonique::CALL, src, 8);
+    }
+
+    void jump(int id_label)
+    {
+        ajoute_instruction_unaire(Mnémonique::JMP, Label{"label", id_label}, 0);
+    }
+
+    void jump_si_zéro(int id_label)
+    {
+        ajoute_instruction_unaire(Mnémonique::JZ, Label{"label", id_label}, 0);
+    }
+
+    void jump_si_non_zéro(int id_label)
+    {
+        ajoute_instruction_unaire(Mnémonique::JNZ, Label{"label", id_label}, 0);
+    }
+
+    void jump_si_égal(int id_label)
+    {
+        ajoute_instruction_unaire(Mnémonique::JE, Label{"label", id_label}, 0);
+    }
+
+    void jump_si_inégal(int id_label)
+    {
+        ajoute_instruction_unaire(Mnémonique::JNE, Label{"label", id_label}, 0);
+    }
+
+    void jump_si_inférieur(int id_label)
+    {
+        ajoute_instruction_unaire(Mnémonique::JL, Label{"label", id_label}, 0);
+    }
+
+    void jump_si_inférieur_égal(int id_label)
+    {
+        ajoute_instruction_unaire(Mnémonique::JLE, Label{"label", id_label}, 0);
+    }
+
+    void jump_si_supérieur(int id_label)
+    {
+        ajoute_instruction_unaire(Mnémonique::JG, Label{"label", id_label}, 0);
+    }
+
+    void jump_si_supérieur_égal(int id_label)
+    {
+        ajoute_instruction_unaire(Mnémonique::JGE, Label{"label", id_label}, 0);
+    }
+
+    void label(int id)
+    {
+        ajoute_label(Label{"label", id});
+    }
+
+    void add(Opérande dst, Opérande src, uint32_t taille_octet)
+    {
+        génère_code_opération_binaire(dst, src, Mnémonique::ADD, taille_octet);
+    }
+
+    void sub(Opérande dst, Opérande src, uint32_t taille_octet)
+    {
+        génère_code_opération_binaire(dst, src, Mnémonique::SUB, taille_octet);
+    }
+
+    void mul(Opérande src, uint32_t taille_octet)
+    {
+        assert(!est_immédiate(src.type));
+        ajoute_instruction_unaire(Mnémonique::MUL, src, taille_octet);
+    }
+
+    void imul(Opérande dst, Opérande src, uint32_t taille_octet)
+    {
+        génère_code_opération_binaire(dst, src, Mnémonique::IMUL, taille_octet);
+    }
+
+    void imul(Opérande src, uint32_t taille_octet)
+    {
+        ajoute_instruction_unaire(Mnémonique::IMUL, src, taille_octet);
+    }
+
+    void div(Opérande src, uint32_t taille_octet)
+    {
+        ajoute_instruction_unaire(Mnémonique::DIV, src, taille_octet);
+    }
+
+    void idiv(Opérande src, uint32_t taille_octet)
+    {
+        ajoute_instruction_unaire(Mnémonique::IDIV, src, taille_octet);
+    }
+
+    void neg(Opérande dst, uint32_t taille_octet)
+    {
+        ajoute_instruction_unaire(Mnémonique::NEG, dst, taille_octet);
+    }
+
+    void addss(Opérande dst, Opérande src)
+    {
+        ajoute_instruction_binaire(Mnémonique::ADDSS, dst, 4, src, 4);
+    }
+
+    void addsd(Opérande dst, Opérande src)
+    {
+        ajoute_instruction_binaire(Mnémonique::ADDSD, dst, 8, src, 8);
+    }
+
+    void mulss(Opérande dst, Opérande src)
+    {
+        ajoute_instruction_binaire(Mnémonique::MULSS, dst, 4, src, 4);
+    }
+
+    void mulsd(Opérande dst, Opérande src)
+    {
+        ajoute_instruction_binaire(Mnémonique::MULSD, dst, 8, src, 8);
+    }
+
+    void subss(Opérande dst, Opérande src)
+    {
+        ajoute_instruction_binaire(Mnémonique::SUBSS, dst, 4, src, 4);
+    }
+
+    void subsd(Opérande dst, Opérande src)
+    {
+        ajoute_instruction_binaire(Mnémonique::SUBSD, dst, 8, src, 8);
+    }
+
+    void divss(Opérande dst, Opérande src)
+    {
+        ajoute_instruction_binaire(Mnémonique::DIVSS, dst, 4, src, 4);
+    }
+
+    void divsd(Opérande dst, Opérande src)
+    {
+        ajoute_instruction_binaire(Mnémonique::DIVSD, dst, 8, src, 8);
+    }
+
+    void xorps(Opérande dst, Opérande src)
+    {
+        ajoute_instruction_binaire(Mnémonique::XORPS, dst, 4, src, 4);
+    }
+
+    void and_(Opérande dst, Opérande src, uint32_t taille_octet)
+    {
+        génère_code_opération_binaire(dst, src, Mnémonique::AND, taille_octet);
+    }
+
+    void or_(Opérande dst, Opérande src, uint32_t taille_octet)
+    {
+        génère_code_opération_binaire(dst, src, Mnémonique::OR, taille_octet);
+    }
+
+    void xor_(Opérande dst, Opérande src, uint32_t taille_octet)
+    {
+        génère_code_opération_binaire(dst, src, Mnémonique::XOR, taille_octet);
+    }
+
+    void not_(Opérande dst, uint32_t taille_octet)
+    {
+        ajoute_instruction_unaire(Mnémonique::NOT, dst, taille_octet);
+    }
+
+    void shl(Opérande dst, Opérande src, uint32_t taille_octet)
+    {
+        génère_code_décalage_bits(dst, src, Mnémonique::SHL, taille_octet);
+    }
+
+    void shr(Opérande dst, Opérande src, uint32_t taille_octet)
+    {
+        génère_code_décalage_bits(dst, src, Mnémonique::SHR, taille_octet);
+    }
+
+    void sar(Opérande dst, Opérande src, uint32_t taille_octet)
+    {
+        génère_code_décalage_bits(dst, src, Mnémonique::SAR, taille_octet);
+    }
+
+    void cmp(Opérande dst, Opérande src, uint32_t taille_octet)
+    {
+        ajoute_instruction_binaire(Mnémonique::CMP, dst, taille_octet, src, taille_octet);
+    }
+
+    void ucomiss(Opérande dst, Opérande src)
+    {
+        assert(dst.type == TypeOpérande::REGISTRE);
+        assert(!est_immédiate(src.type));
+        ajoute_instruction_binaire(Mnémonique::UCOMISS, dst, 4, src, 4);
+    }
+
+    void ucomisd(Opérande dst, Opérande src)
+    {
+        assert(dst.type == TypeOpérande::REGISTRE);
+        assert(!est_immédiate(src.type));
+        ajoute_instruction_binaire(Mnémonique::UCOMISD, dst, 8, src, 8);
+    }
+
+    void cmove(Opérande dst, Opérande src)
+    {
+        génère_code_opération_binaire(dst, src, Mnémonique::CMOVE, 8);
+    }
+
+    void cmovne(Opérande dst, Opérande src)
+    {
+        génère_code_opération_binaire(dst, src, Mnémonique::CMOVNE, 8);
+    }
+
+    void cmovl(Opérande dst, Opérande src)
+    {
+        génère_code_opération_binaire(dst, src, Mnémonique::CMOVL, 8);
+    }
+
+    void cmovle(Opérande dst, Opérande src)
+    {
+        génère_code_opération_binaire(dst, src, Mnémonique::CMOVLE, 8);
+    }
+
+    void cmovg(Opérande dst, Opérande src)
+    {
+        génère_code_opération_binaire(dst, src, Mnémonique::CMOVG, 8);
+    }
+
+    void cmovge(Opérande dst, Opérande src)
+    {
+        génère_code_opération_binaire(dst, src, Mnémonique::CMOVGE, 8);
+    }
+
+    void cvttss2si(Opérande dst, Opérande src, uint32_t taille_octet)
+    {
+        ajoute_instruction_binaire(Mnémonique::CVTTSS2SI, dst, taille_octet, src, taille_octet);
+    }
+
+    void cvtss2si(Opérande dst, Opérande src, uint32_t taille_octet)
+    {
+        ajoute_instruction_binaire(Mnémonique::CVTSS2SI, dst, taille_octet, src, taille_octet);
+    }
+
+    void cvttsd2si(Opérande dst, Opérande src, uint32_t taille_octet)
+    {
+        ajoute_instruction_binaire(Mnémonique::CVTTSD2SI, dst, taille_octet, src, taille_octet);
+    }
+
+    void cvtsd2si(Opérande dst, Opérande src, uint32_t taille_octet)
+    {
+        ajoute_instruction_binaire(Mnémonique::CVTSD2SI, dst, taille_octet, src, taille_octet);
+    }
+
+    void cvtsd2ss(Opérande dst, Opérande src)
+    {
+        ajoute_instruction_binaire(Mnémonique::CVTSD2SS, dst, 4, src, 8);
+    }
+
+    void test(Opérande dst, Opérande src)
+    {
+        ajoute_instruction_binaire(Mnémonique::TEST, dst, 8, src, 8);
+    }
+
+    void push(Opérande src, uint32_t taille_octet)
+    {
+        if (src.type == TypeOpérande::REGISTRE) {
+            assert(taille_octet == 8);
+        }
+        ajoute_instruction_unaire(Mnémonique::PUSH, src, taille_octet);
+    }
+
+    void empile(Registre reg, uint32_t taille_octet)
+    {
+        if (taille_octet == 8) {
+            push(reg, 8);
+        }
+        else {
+            // mov(Mémoire{Registre::RSP}, reg, taille_octet);
+            // sub(Registre::RSP, Immédiate64{taille_octet}, 8);
+            push(reg, 8);
+        }
+    }
+
+    void push(Registre reg)
+    {
+        push(reg, 8);
+    }
+
+    void push_immédiate_8(uint8_t valeur)
+    {
+        push(Immédiate8{valeur}, 1);
+    }
+
+    void push_immédiate_16(uint16_t valeur)
+    {
+        push(Immédiate16{valeur}, 2);
+    }
+
+    void push_immédiate_32(uint32_t valeur)
+    {
+        push(Immédiate32{valeur}, 4);
+    }
+
+    void push_immédiate_64(uint64_t valeur)
+    {
+        push(Immédiate64{valeur}, 8);
+    }
+
+    void pop(Opérande dst, uint32_t taille_octet)
+    {
+        if (dst.type == TypeOpérande::REGISTRE) {
+            assert(taille_octet == 8);
+        }
+        ajoute_instruction_unaire(Mnémonique::POP, dst, taille_octet);
+    }
+
+    void pop(Registre reg)
+    {
+        pop(reg, 8);
+    }
+
+    void dépile(Registre reg, uint32_t taille_octet)
+    {
+        if (taille_octet == 8) {
+            pop(reg, 8);
+        }
+        else {
+            // mov(reg, Mémoire{Registre::RSP}, taille_octet);
+            // add(Registre::RSP, Immédiate64{taille_octet}, 8);
+            pop(reg, 8);
+        }
+    }
+
+    void ret()
+    {
+        ajoute_instruction(Mnémonique::RET);
+    }
+
+    void syscall()
+    {
+        ajoute_instruction(Mnémonique::SYSCALL);
+    }
+
+    void ud2()
+    {
+        ajoute_instruction(Mnémonique::UD2);
+    }
+
+    void int3()
+    {
+        ajoute_instruction(Mnémonique::INT3);
+    }
+
+    void cbw()
+    {
+        ajoute_instruction(Mnémonique::CBW);
+    }
+
+    void cwd()
+    {
+        ajoute_instruction(Mnémonique::CWD);
+    }
+
+    void cdq()
+    {
+        ajoute_instruction(Mnémonique::CDQ);
+    }
+
+    void cqo()
+    {
+        ajoute_instruction(Mnémonique::CQO);
+    }
+
+    void pxor(Registre reg1, Registre reg2)
+    {
+        ajoute_instruction_binaire(Mnémonique::PXOR, reg1, 8, reg2, 8);
+    }
+
+    void cvtsi2ss(Opérande dst, Opérande src, uint32_t taille_octet)
+    {
+        ajoute_instruction_binaire(Mnémonique::CVTSI2SS, dst, 8, src, taille_octet);
+    }
+
+    void cvtsi2sd(Opérande dst, Opérande src, uint32_t taille_octet)
+    {
+        ajoute_instruction_binaire(Mnémonique::CVTSI2SD, dst, 8, src, taille_octet);
+    }
+
+  private:
+    void ajoute_instruction(Mnémonique mnémonique);
+
+    void ajoute_instruction_unaire(Mnémonique mnémonique, Opérande dst, uint32_t taille_dst);
+
+    void ajoute_instruction_binaire(Mnémonique mnémonique,
+                                    Opérande dst,
+                                    uint32_t taille_dst,
+                                    Opérande src,
+                                    uint32_t taille_src);
+
+    void ajoute_label(Label label);
+
+    void imprime_opérande(Opérande opérande, uint32_t taille_octet = 8)
+    {
+        switch (opérande.type) {
+            case TypeOpérande::IMMÉDIATE8:
+            {
+                *m_sortie << "byte " << uint32_t(opérande.immédiate8.valeur);
+                return;
+            }
+            case TypeOpérande::IMMÉDIATE16:
+            {
+                *m_sortie << "word " << uint32_t(opérande.immédiate16.valeur);
+                return;
+            }
+            case TypeOpérande::IMMÉDIATE32:
+            {
+                *m_sortie << "dword " << opérande.immédiate32.valeur;
+                return;
+            }
+            case TypeOpérande::IMMÉDIATE64:
+            {
+                *m_sortie << "qword " << opérande.immédiate64.valeur;
+                return;
+            }
+            case TypeOpérande::MÉMOIRE:
+            {
+                auto const adresse = opérande.mémoire.adresse;
+                assert(adresse.taille() != 0);
+
+                if (!opérande.mémoire.est_globale) {
+                    auto const décalage = opérande.mémoire.décalage;
+                    *m_sortie << "[" << adresse;
+                    if (décalage < 0) {
+                        *m_sortie << " - " << abs(décalage);
+                    }
+                    else if (décalage > 0) {
+                        *m_sortie << " + " << décalage;
+                    }
+                    *m_sortie << "]";
+                }
+                else {
+                    if (adresse.pointeur()[0] == '.') {
+                        *m_sortie << "qword [rel " << adresse << "]";
+                    }
+                    else {
+                        *m_sortie << "[rel " << adresse << "]";
+                    }
+                }
+                return;
+            }
+            case TypeOpérande::REGISTRE:
+            {
+                *m_sortie << chaine_pour_registre(opérande.registre, taille_octet);
+                return;
+            }
+            case TypeOpérande::FONCTION:
+            {
+                *m_sortie << opérande.fonction.valeur;
+                if (opérande.fonction.plt) {
+                    *m_sortie << " wrt ..plt";
+                }
+                return;
+            }
+            case TypeOpérande::GLOBALE:
+            {
+                /* Relativement à rip, comme dans le code encodé directement, pour que le code
+                 * soit indépendant de sa position. */
+                *m_sortie << "[rel " << opérande.globale.valeur << "]";
+                return;
+            }
+            case TypeOpérande::LABEL:
+            {
+                *m_sortie << "." << opérande.label.nom << opérande.label.indice;
+                return;
+            }
+        }
+
+        *m_sortie << "opérande_invalide";
+    }
+
+    void génère_code_opération_binaire(Opérande dst,
+                                       Opérande src,
+                                       Mnémonique mnémonique,
+                                       uint32_t taille_octet)
+    {
+        assert(!est_immédiate(dst.type));
+        assert(!(dst.type == TypeOpérande::MÉMOIRE && src.type == TypeOpérande::MÉMOIRE));
+        ajoute_instruction_binaire(mnémonique, dst, taille_octet, src, taille_octet);
+    }
+
+    void génère_code_décalage_bits(Opérande dst,
+                                   Opérande src,
+                                   Mnémonique mnémonique,
+                                   uint32_t taille_octet)
+    {
+        assert(!est_immédiate(dst.type));
+        assert(est_immédiate(src.type) || est_registre(src, Registre::RCX));
+        ajoute_instruction_binaire(mnémonique, dst, taille_octet, src, 1);
+    }
+};
+
+std::ostream &operator<<(std::ostream &os, AssembleuseASM::Mémoire mémoire);
+
+/** \} */
+
+/* ------------------------------------------------------------------------- */
+/** \name Encodage des instructions x64.
+ * Les instructions sont directement encodées dans la section .text d'un fichier objet, sans
+ * passer par un assembleur externe. Les références aux labels et aux constantes des fonctions
+ * sont résolues à la fin de chaque fonction, les autres symboles le sont via des relocations.
+ * \{ */
+
+/* Sépare une expression de la forme « symbole + décalage » ou « symbole - décalage ». */
+kuri::chaine_statique donne_symbole_et_décalage(kuri::chaine_statique expression,
+                                                int64_t &r_décalage);
+
+class EncodeuseX64 {
+    using Opérande = AssembleuseASM::Opérande;
+    using Label = AssembleuseASM::Label;
+
+    struct RéférenceLocale {
+        uint64_t décalage = 0;
+        /* Soit un label, soit une constante (.CN) de la fonction. */
+        bool est_constante = false;
+        int indice = 0;
+        int64_t addend = 0;
+    };
+
+    FichierELF &m_fichier;
+    SectionELF *m_section_text = nullptr;
+    kuri::table_hachage<kuri::chaine_statique, int64_t> m_symboles{"Symboles ELF"};
+
+    /* État de la fonction courante. */
+    int64_t m_symbole_fonction_courante = -1;
+    kuri::table_hachage<int, uint64_t> m_labels{"Labels fonction ASM"};
+    kuri::table_hachage<int, uint64_t> m_constantes{"Constantes fonction ASM"};
+    kuri::tableau<RéférenceLocale> m_références_locales{};
+
+  public:
+    EncodeuseX64(FichierELF &fichier)
+        : m_fichier(fichier), m_section_text(fichier.donne_section(".text"))
+    {
+    }
+
+    EMPECHE_COPIE(EncodeuseX64);
+
+    SectionELF &donne_section_text()
+    {
+        return *m_section_text;
+    }
+
+    /* Retourne l'indice du symbole, en créant un symbole non-défini s'il n'existe pas encore. */
+    int64_t donne_indice_symbole(kuri::chaine_statique nom)
+    {
+        auto trouvé = false;
+        auto résultat = m_symboles.trouve(nom, trouvé);
+        if (trouvé) {
+            return résultat;
+        }
+
+        auto symbole = SymboleELF{};
+        symbole.nom = nom;
+        résultat = m_fichier.ajoute_symbole(symbole);
+        m_symboles.insère(nom, résultat);
+        return résultat;
+    }
+
+    int64_t définis_symbole(kuri::chaine_statique nom,
+                            SectionELF const *section,
+                            uint64_t valeur,
+                            uint64_t taille,
+                            uint8_t type,
+                            uint8_t liaison)
+    {
+        auto résultat = donne_indice_symbole(nom);
+        auto &symbole = m_fichier.donne_symbole(résultat);
+        symbole.section = section;
+        symbole.valeur = valeur;
+        symbole.taille = taille;
+        symbole.type = type;
+        symbole.liaison = liaison;
+        return résultat;
+    }
+
+    void débute_fonction(kuri::chaine_statique nom)
+    {
+        m_section_text->aligne(16);
+        m_symbole_fonction_courante = définis_symbole(
+            nom, m_section_text, m_section_text->donne_taille(), 0, STT_FUNC, STB_GLOBAL);
+        m_labels.reinitialise();
+        m_constantes.reinitialise();
+        m_références_locales.efface();
+    }
+
+    void définis_label(Label label)
+    {
+        m_labels.insère(label.indice, m_section_text->donne_taille());
+    }
+
+    void définis_constante_locale(int indice)
+    {
+        m_constantes.insère(indice, m_section_text->donne_taille());
+    }
+
+    void termine_fonction()
+    {
+        POUR (m_références_locales) {
+            auto trouvé = false;
+            auto cible = it.est_constante ? m_constantes.trouve(it.indice, trouvé) :
+                                            m_labels.trouve(it.indice, trouvé);
+            assert(trouvé);
+            auto valeur = int32_t(int64_t(cible) + it.addend - int64_t(it.décalage));
+            m_section_text->remplace_octets(it.décalage, &valeur, sizeof(valeur));
+        }
+
+        auto &symbole = m_fichier.donne_symbole(m_symbole_fonction_courante);
+        symbole.taille = m_section_text->donne_taille() - symbole.valeur;
+        m_symbole_fonction_courante = -1;
+    }
+
+    /* Ajoute l'adresse absolue du symbole dans la section (pour l'initialisation des
+     * globales). */
+    void ajoute_relocation_absolue(SectionELF &section, kuri::chaine_statique expression)
+    {
+        auto décalage = int64_t(0);
+        auto nom = donne_symbole_et_décalage(expression, décalage);
+
+        auto relocation = RelocationELF{};
+        relocation.décalage = section.donne_taille();
+        relocation.indice_symbole = donne_indice_symbole(nom);
+        relocation.type = R_X86_64_64;
+        relocation.addend = décalage;
+        section.relocations.ajoute(relocation);
+
+        section.ajoute_zéros(8);
+    }
+
+    void encode(Mnémonique mnémonique);
+
+    void encode_unaire(Mnémonique mnémonique, Opérande dst, uint32_t taille_dst);
+
+    void encode_binaire(Mnémonique mnémonique,
+                        Opérande dst,
+                        uint32_t taille_dst,
+                        Opérande src,
+                        uint32_t taille_src);
+
+  private:
+    void émets_octet(uint8_t octet)
+    {
+        m_section_text->ajoute_valeur(octet);
+    }
+
+    void émets_immédiate(int64_t valeur, int taille)
+    {
+        m_section_text->ajoute_octets(&valeur, taille);
+    }
+
+    /* Émets le déplacement relatif vers un symbole ou une constante de la fonction.
+     * L'addend prend en compte les octets restant de l'instruction. */
+    void émets_référence(kuri::chaine_statique expression, int64_t addend, uint32_t type)
+    {
+        if (expression[0] == '.') {
+            /* Les constantes des fonctions sont nommées « .CN ». */
+            auto indice = 0;
+            for (auto i = int64_t(2); i < expression.taille(); i++) {
+                indice = indice * 10 + (expression[i] - '0');
+            }
+
+            émets_référence_locale(true, indice, addend);
+            return;
+        }
+
+        auto décalage = int64_t(0);
+        auto nom = donne_symbole_et_décalage(expression, décalage);
+
+        auto relocation = RelocationELF{};
+        relocation.décalage = m_section_text->donne_taille();
+        relocation.indice_symbole = donne_indice_symbole(nom);
+        relocation.type = type;
+        relocation.addend = addend + décalage;
+        m_section_text->relocations.ajoute(relocation);
+
+        émets_immédiate(0, 4);
+    }
+
+    void émets_référence_locale(bool est_constante, int indice, int64_t addend)
+    {
+        auto référence = RéférenceLocale{};
+        référence.décalage = m_section_text->donne_taille();
+        référence.est_constante = est_constante;
+        référence.indice = indice;
+        référence.addend = addend;
+        m_références_locales.ajoute(référence);
+        émets_immédiate(0, 4);
+    }
+
+    void émets_référence_label(Label label)
+    {
+        émets_référence_locale(label.nom == "C", label.indice, -4);
+    }
+
+    /* Émets une instruction de la forme : [préfixe] [REX] opcode ModRM [SIB] [déplacement]
+     * [immédiate]. `reg` est soit un numéro de registre, soit une extension de l'opcode. */
+    void émets_instruction(uint8_t préfixe,
+                           bool rex_w,
+                           bool rex_requis,
+                           std::initializer_list<uint8_t> opcode,
+                           uint8_t reg,
+                           Opérande const &rm,
+                           int64_t immédiate = 0,
+                           int taille_immédiate = 0);
+
+    void émets_instruction_avec_taille(uint32_t taille,
+                                       std::initializer_list<uint8_t> opcode_octet,
+                                       std::initializer_list<uint8_t> opcode,
+                                       uint8_t reg,
+                                       Opérande const &rm,
+                                       bool rex_requis,
+                                       int64_t immédiate = 0,
+                                       int taille_immédiate = 0);
+
+    /* Émets une instruction opérant sur al, ax, eax, ou rax, et une immédiate. L'opcode est
+     * celui de la forme sur un octet, celui des autres formes le suit. */
+    void émets_instruction_accumulateur(uint32_t taille, uint8_t opcode_octet, int64_t immédiate);
+
+    void encode_arithmétique(uint8_t extension, Opérande dst, Opérande src, uint32_t taille);
+    void encode_mov(Opérande dst, Opérande src, uint32_t taille);
+    void encode_décalage(uint8_t extension, Opérande dst, Opérande src, uint32_t taille);
+    void encode_sse(uint8_t préfixe, uint8_t opcode, Opérande dst, Opérande src, bool rex_w);
+};
+
+/** \} */
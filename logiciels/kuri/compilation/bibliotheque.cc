@@ -756,7 +756,7 @@ GestionnaireBibliothèques::GestionnaireBibliothèques(Compilatrice &compilatric
 
 bool GestionnaireBibliothèques::initialise_bibliothèques_pour_exécution(Compilatrice &compilatrice)
 {
-    auto table_idents = compilatrice.table_identifiants.verrou_écriture();
+    auto &table_idents = compilatrice.table_identifiants;
     auto gestionnaire = compilatrice.gestionnaire_bibliothèques.verrou_écriture();
     auto espace = compilatrice.espace_défaut_compilation();
 
@@ -777,7 +777,7 @@ bool GestionnaireBibliothèques::initialise_bibliothèques_pour_exécution(Compi
 
     /* La bibliothèque r16. */
     auto bibr16 = gestionnaire->crée_bibliothèque(
-        *espace, nullptr, table_idents->identifiant_pour_chaine("libr16"), "r16");
+        *espace, nullptr, table_idents.identifiant_pour_chaine("libr16"), "r16");
 
     bibr16->crée_symbole("DLS_vers_r32", TypeSymbole::FONCTION)
         ->définis_adresse_pour_exécution(
@@ -795,7 +795,7 @@ bool GestionnaireBibliothèques::initialise_bibliothèques_pour_exécution(Compi
 #ifndef _MSC_VER
     /* La bibliothèque pthread. */
     gestionnaire->crée_bibliothèque(
-        *espace, nullptr, table_idents->identifiant_pour_chaine("libpthread"), "pthread");
+        *espace, nullptr, table_idents.identifiant_pour_chaine("libpthread"), "pthread");
 #endif
 
     return !compilatrice.possède_erreur();
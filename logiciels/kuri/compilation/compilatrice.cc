@@ -10,6 +10,7 @@
 
 #include "statistiques/statistiques.hh"
 
+#include "parsage/cache_lexemes.hh"
 #include "parsage/lexeuse.hh"
 
 #include "structures/chemin_systeme.hh"
@@ -98,11 +99,16 @@ Compilatrice::Compilatrice(kuri::chaine chemin_racine_kuri, ArgumentsCompilatric
 {
     racine_modules_kuri = racine_kuri / "modules";
 
-    initialise_identifiants_intrinsèques(*table_identifiants.verrou_écriture());
-    initialise_identifiants_ipa(*table_identifiants.verrou_écriture());
+    initialise_identifiants_intrinsèques(table_identifiants);
+    initialise_identifiants_ipa(table_identifiants);
 
     broyeuse = mémoire::loge<Broyeuse>("Broyeuse");
 
+    if (arguments.utilise_cache_lexèmes) {
+        cache_lexèmes = mémoire::loge<CacheLexèmes>("CacheLexèmes",
+                                                     CacheLexèmes::dossier_défaut());
+    }
+
     m_date_début_compilation = hui_systeme();
 }
 
@@ -125,6 +131,7 @@ Compilatrice::~Compilatrice()
     }
 
     mémoire::déloge("Broyeuse", broyeuse);
+    mémoire::déloge("CacheLexèmes", cache_lexèmes);
 }
 
 /* ************************************************************************** */
@@ -178,10 +185,11 @@ int64_t Compilatrice::mémoire_utilisée() const
 {
     auto résultat = taille_de(Compilatrice);
 
-    résultat += ordonnanceuse->mémoire_utilisée();
-    résultat += table_identifiants->mémoire_utilisée();
+    résultat += ordonnanceuse.mémoire_utilisée();
+    résultat += table_identifiants.mémoire_utilisée();
 
-    résultat += gérante_chaine->mémoire_utilisée();
+    résultat += gérante_chaine.mémoire_utilisée();
+    résultat += données_constantes_fichiers.mémoire_utilisée();
 
     POUR ((*espaces_de_travail.verrou_lecture())) {
         résultat += it->mémoire_utilisée();
@@ -231,10 +239,18 @@ void Compilatrice::rassemble_statistiques(Statistiques &stats) const
         it->rassemble_statistiques(stats);
     }
 
-    stats.nombre_identifiants = table_identifiants->taille();
+    stats.nombre_identifiants = table_identifiants.taille();
+
+    if (cache_lexèmes) {
+        cache_lexèmes->rassemble_statistiques(stats);
+    }
+
+    données_constantes_fichiers.rassemble_statistiques(stats);
 
     gestionnaire_code->rassemble_statistiques(stats);
 
+    ordonnanceuse.rassemble_statistiques(stats);
+
     gestionnaire_bibliothèques->rassemble_statistiques(stats);
 
     auto métaprogrammes_ = métaprogrammes.verrou_lecture();
@@ -363,7 +379,7 @@ ContexteLexage Compilatrice::contexte_lexage(EspaceDeTravail *espace)
         }
     };
 
-    return {gérante_chaine, table_identifiants, rappel_erreur};
+    return {gérante_chaine, table_identifiants, rappel_erreur, cache_lexèmes};
 }
 
 // -----------------------------------------------------------------------------
@@ -578,11 +594,11 @@ IdentifiantCode *Compilatrice::donne_identifiant_pour_globale(kuri::chaine_stati
 {
     auto occurences = donne_nombre_occurences_chaine(nom_de_base);
     if (occurences == 0) {
-        return table_identifiants->identifiant_pour_nouvelle_chaine(nom_de_base);
+        return table_identifiants.identifiant_pour_nouvelle_chaine(nom_de_base);
     }
 
     auto nom = enchaine(nom_de_base, '_', occurences);
-    return table_identifiants->identifiant_pour_nouvelle_chaine(nom);
+    return table_identifiants.identifiant_pour_nouvelle_chaine(nom);
 }
 
 IdentifiantCode *Compilatrice::donne_nom_défaut_valeur_retour(int indice)
@@ -590,7 +606,7 @@ IdentifiantCode *Compilatrice::donne_nom_défaut_valeur_retour(int indice)
     std::unique_lock verrouille(m_mutex_noms_valeurs_retours_défaut);
 
     if (indice >= m_noms_valeurs_retours_défaut.taille()) {
-        auto ident = table_identifiants->identifiant_pour_nouvelle_chaine(
+        auto ident = table_identifiants.identifiant_pour_nouvelle_chaine(
             enchaine("__ret", indice));
         m_noms_valeurs_retours_défaut.ajoute(ident);
     }
@@ -5,6 +5,7 @@
 
 #include "parsage/gerante_chaine.hh"
 #include "parsage/identifiant.hh"
+#include "parsage/modules.hh"
 
 #include "bibliotheque.hh"
 #include "erreur.h"
@@ -14,6 +15,7 @@
 #include "options.hh"
 #include "structures.hh"
 #include "tacheronne.hh"
+#include "trace_taches.hh"
 
 #include "structures/chemin_systeme.hh"
 #include "structures/date.hh"
@@ -21,6 +23,7 @@
 #include "utilitaires/synchrone.hh"
 
 class Broyeuse;
+struct CacheLexèmes;
 struct ContexteLexage;
 struct ConvertisseuseNoeudCode;
 struct EspaceDeTravail;
@@ -32,6 +35,8 @@ struct Statistiques;
 enum class FormatRapportProfilage : int {
     BRENDAN_GREGG,
     ECHANTILLONS_TOTAL_POUR_FONCTION,
+    TABLEAUX,
+    SPEEDSCOPE,
 };
 
 namespace kuri {
@@ -77,6 +82,11 @@ struct ArgumentsCompilatrice {
     bool valide_llvm = false;
     bool parallélise_llvm = false;
     bool débogage_ne_compile_que_nécessaire = false;
+    bool utilise_cache_lexèmes = false;
+    bool compilation_incrémentale = false;
+    bool jit_métaprogrammes = false;
+    bool code_binaire_registres = false;
+    bool assembleur_interne = false;
     FormatRapportProfilage format_rapport_profilage = FormatRapportProfilage::BRENDAN_GREGG;
 
     TypeCoulisse coulisse = TypeCoulisse::C;
@@ -84,16 +94,19 @@ struct ArgumentsCompilatrice {
     /* Fichier où inscrire les fichiers utilisés si --emets_fichiers_utilises fut renseigné. */
     kuri::chemin_systeme chemin_fichier_utilises{};
 
+    /* Fichier où écrire la trace des tâches si --trace_tâches fut renseigné. */
+    kuri::chemin_systeme chemin_trace_tâches{};
+
     /* La liste des arguments en ligne de commande passés après "--". */
     kuri::tableau<kuri::chaine_statique> arguments_pour_métaprogrammes{};
 };
 
 struct Compilatrice {
-    kuri::Synchrone<TableIdentifiant> table_identifiants{};
+    TableIdentifiant table_identifiants{};
 
-    kuri::Synchrone<OrdonnanceuseTache> ordonnanceuse;
+    OrdonnanceuseTache ordonnanceuse;
 
-    kuri::Synchrone<GeranteChaine> gérante_chaine{};
+    GeranteChaine gérante_chaine{};
 
     kuri::Synchrone<Messagère> messagère{};
 
@@ -121,6 +134,15 @@ struct Compilatrice {
 
     Broyeuse *broyeuse = nullptr;
 
+    /* Non-nul si --cache_lexèmes fut renseigné. */
+    CacheLexèmes *cache_lexèmes = nullptr;
+
+    /* Le contenu et les lexèmes des fichiers du disque, partagés entre les espaces. */
+    TableDonnéesConstantesFichiers données_constantes_fichiers{};
+
+    /* Origine des temps des événements si --trace_tâches fut renseigné. */
+    HorlogeTrace horloge_trace{};
+
     /* Tous les tableaux créés pour les appels à #compilatrice_lèxe_fichier. */
     kuri::tableau<kuri::tableau<kuri::Lexème>> m_tableaux_lexèmes{};
 
@@ -207,6 +229,11 @@ struct Compilatrice {
         return m_code_erreur;
     }
 
+    bool trace_tâches_active() const
+    {
+        return !arguments.chemin_trace_tâches.est_vide();
+    }
+
   public:
     OptionsDeCompilation *options_compilation();
     void ajourne_options_compilation(OptionsDeCompilation *options);
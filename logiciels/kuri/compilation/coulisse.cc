@@ -12,6 +12,8 @@
 #include "environnement.hh"
 #include "espace_de_travail.hh"
 #include "programme.hh"
+
+#include "representation_intermediaire/instructions.hh"
 #include "utilitaires/log.hh"
 
 #include "statistiques/statistiques.hh"
@@ -124,6 +126,20 @@ bool Coulisse::crée_fichier_objet(ArgsGénérationCode const &args)
 {
     if (!est_coulisse_métaprogramme()) {
         info() << "Génération du code...";
+
+        /* La RI des fonctions est libérée au fur et à mesure de la génération du code final : si
+         * l'espace doit regénérer son code, par exemple car du code y fut ajouté après sa
+         * compilation, le code ne peut plus être généré. */
+        POUR (args.ri_programme->donne_fonctions()) {
+            if (it->ri_libérée) {
+                args.espace
+                    ->rapporte_erreur_sans_site(
+                        "Impossible de générer le code final, la RI d'une fonction fut libérée "
+                        "lors d'une génération précédente")
+                    .ajoute_message("La fonction est « ", it->nom, " ».\n");
+                return false;
+            }
+        }
     }
     auto début_génération_code = kuri::chrono::compte_seconde();
     auto err = génère_code_impl(args);
@@ -150,6 +166,15 @@ bool Coulisse::crée_fichier_objet(ArgsGénérationCode const &args)
     }
     temps_fichier_objet = début_fichier_objet.temps();
 
+    /* Les coulisses libèrent la RI des fonctions dès que leur code est généré lorsqu'elles le
+     * peuvent ; libère celle des fonctions restantes avant la liaison. */
+    if (!est_coulisse_métaprogramme()) {
+        POUR (args.ri_programme->donne_fonctions()) {
+            args.espace->libère_ri_fonction(it);
+        }
+        mémoire::rends_mémoire_libérée();
+    }
+
     return true;
 }
 
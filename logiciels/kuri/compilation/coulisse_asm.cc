@@ -5,7 +5,9 @@
 
 #include <array>
 #include <fstream>
+#include <initializer_list>
 #include <iostream>
+#include <limits>
 
 #include "arbre_syntaxique/cas_genre_noeud.hh"
 #include "arbre_syntaxique/noeud_expression.hh"
@@ -23,11 +25,13 @@
 #include "utilitaires/log.hh"
 #include "utilitaires/macros.hh"
 
+#include "assembleuse_asm.hh"
 #include "broyage.hh"
 #include "compilatrice.hh"
 #include "environnement.hh"
 #include "erreur.h"
 #include "espace_de_travail.hh"
+#include "fichier_elf.hh"
 #include "programme.hh"
 #include "typage.hh"
 
@@ -38,103 +42,6 @@
 
 #define VERIFIE_NON_ATTEINT assert(false)
 
-/* ------------------------------------------------------------------------- */
-/** \name Registres x64
- * \{ */
-
-enum class Registre {
-    RAX,
-    RBX,
-    RCX,
-    RDX,
-    RSI,
-    RDI,
-    RBP,
-    RSP,
-    R8,
-    R9,
-    R10,
-    R11,
-    R12,
-    R13,
-    R14,
-    R15,
-
-    XMM0,
-    XMM1,
-    XMM2,
-    XMM3,
-    XMM4,
-    XMM5,
-    XMM6,
-    XMM7,
-
-    /* Cas spécial. */
-    AH,
-};
-
-#define NOMBRE_REGISTRES_ENTIER 16
-#define NOMBRE_REGISTRES_RÉEL 8
-#define NOMBRE_REGISTRES (NOMBRE_REGISTRES_ENTIER + NOMBRE_REGISTRES_RÉEL)
-
-static kuri::chaine_statique chaine_pour_registre(Registre registre, uint32_t taille_octet)
-{
-#define APPARIE_REGISTRE(type, nom1, nom2, nom4, nom8)                                            \
-    case Registre::type:                                                                          \
-    {                                                                                             \
-        if (taille_octet == 1)                                                                    \
-            return nom1;                                                                          \
-        if (taille_octet == 2)                                                                    \
-            return nom2;                                                                          \
-        if (taille_octet == 4)                                                                    \
-            return nom4;                                                                          \
-        return nom8;                                                                              \
-    }
-
-    switch (registre) {
-        APPARIE_REGISTRE(RAX, "al", "ax", "eax", "rax")
-        APPARIE_REGISTRE(RBX, "bl", "bx", "ebx", "rbx")
-        APPARIE_REGISTRE(RCX, "cl", "cx", "ecx", "rcx")
-        APPARIE_REGISTRE(RDX, "dl", "dx", "edx", "rdx")
-        APPARIE_REGISTRE(RSI, "sil", "si", "esi", "rsi")
-        APPARIE_REGISTRE(RDI, "dil", "di", "edi", "rdi")
-        APPARIE_REGISTRE(RBP, "bpl", "bp", "ebp", "rbp")
-        APPARIE_REGISTRE(RSP, "spl", "sp", "esp", "rsp")
-        APPARIE_REGISTRE(R8, "r8b", "r8w", "r8d", "r8")
-        APPARIE_REGISTRE(R9, "r9b", "r9w", "r9d", "r9")
-        APPARIE_REGISTRE(R10, "r10b", "r10w", "r10d", "r10")
-        APPARIE_REGISTRE(R11, "r11b", "r11w", "r11d", "r11")
-        APPARIE_REGISTRE(R12, "r12b", "r12w", "r12d", "r12")
-        APPARIE_REGISTRE(R13, "r13b", "r13w", "r13d", "r13")
-        APPARIE_REGISTRE(R14, "r14b", "r14W", "r14d", "r14")
-        APPARIE_REGISTRE(R15, "r15b", "r15w", "r15d", "r15")
-
-        APPARIE_REGISTRE(XMM0, "xmm0", "xmm0", "xmm0", "xmm0")
-        APPARIE_REGISTRE(XMM1, "xmm1", "xmm1", "xmm1", "xmm1")
-        APPARIE_REGISTRE(XMM2, "xmm2", "xmm2", "xmm2", "xmm2")
-        APPARIE_REGISTRE(XMM3, "xmm3", "xmm3", "xmm3", "xmm3")
-        APPARIE_REGISTRE(XMM4, "xmm4", "xmm4", "xmm4", "xmm4")
-        APPARIE_REGISTRE(XMM5, "xmm5", "xmm5", "xmm5", "xmm5")
-        APPARIE_REGISTRE(XMM6, "xmm6", "xmm6", "xmm6", "xmm6")
-        APPARIE_REGISTRE(XMM7, "xmm7", "xmm7", "xmm7", "xmm7")
-        case Registre::AH:
-        {
-            return "ah";
-        }
-    }
-
-#undef APPARIE_REGISTRE
-
-    return "registre_invalide";
-}
-
-static std::ostream &operator<<(std::ostream &os, Registre reg)
-{
-    return os << chaine_pour_registre(reg, 8);
-}
-
-/** \} */
-
 /* ------------------------------------------------------------------------- */
 /** \name ABI x64 pour passer des paramètres
  *  https://refspecs.linuxfoundation.org/elf/x86_64-abi-0.99.pdf section 3.2.3
@@ -862,857 +769,66 @@ kuri::tablet<Huitoctet, 4> ClassifieuseArgument::donne_classe_argument(Type cons
     if (indice == -1) {
         ::donne_classe_argument(typeuse, type, résultat);
 
-        auto rangée = RangéeHuitoctetsType{};
-        rangée.indice_premier_inclusif = int32_t(m_huitoctets_types.taille());
-        rangée.indice_dernier_exclusif = rangée.indice_premier_inclusif +
-                                         int32_t(résultat.taille());
-
-        POUR (résultat) {
-            m_huitoctets_types.ajoute(it);
-        }
-
-        m_rangées_huitoctets_types.ajoute(rangée);
-
-        indice = int32_t(m_rangées_huitoctets_types.taille() - 1);
-        m_table_huitoctets_types.insère(type, indice);
-        return résultat;
-    }
-
-    auto rangée = m_rangées_huitoctets_types[indice];
-
-    for (auto i = rangée.indice_premier_inclusif; i < rangée.indice_dernier_exclusif; i++) {
-        résultat.ajoute(m_huitoctets_types[i]);
-    }
-
-    return résultat;
-}
-
-void classifie_arguments(Typeuse &typeuse, AtomeFonction const *fonction)
-{
-    dbg() << "------------------------------------------";
-
-    auto classifieuse = ClassifieuseArgument{typeuse};
-    auto classement = classifieuse.donne_classement_arguments(
-        fonction->type->comme_type_fonction());
-
-    auto indice_arg = 0;
-    POUR (classement.arguments) {
-        dbg() << fonction->params_entrée[indice_arg++]->ident->nom;
-
-        for (auto i = it.premier_huitoctet_inclusif; i < it.dernier_huitoctet_exclusif; i++) {
-            auto registre = classement.registres_huitoctets[i].registre;
-            dbg() << " => " << classement.huitoctets[i].classe << " ("
-                  << chaine_pour_registre(registre, 8) << ")";
-        }
-    }
-}
-
-/** \} */
-
-/*
-
-  Pour réduire la taille du code :
-
-  préfére imm8, imm16, imm32 si le nombre le permet pour mov
-
-  mov reg, 0 => xor reg, reg
-  cmp reg, 0 => test reg, reg (pour les sauts : saute_si_zéro, saute_si_non_zéro)
-  add reg, 1 => inc reg
-  sub reg, 1 => dec reg
-
-*/
-
-static kuri::chaine_statique donne_chaine_taille_opérande(uint32_t taille)
-{
-    if (taille == 1) {
-        return "byte";
-    }
-    if (taille == 2) {
-        return "word";
-    }
-    if (taille == 4) {
-        return "dword";
-    }
-    return "qword";
-}
-
-enum class TypeOpérande {
-    REGISTRE,
-    IMMÉDIATE8,
-    IMMÉDIATE16,
-    IMMÉDIATE32,
-    IMMÉDIATE64,
-    MÉMOIRE,
-    FONCTION,
-    GLOBALE,
-    LABEL,
-};
-
-static std::ostream &operator<<(std::ostream &os, TypeOpérande type)
-{
-#define IMPRIME_CAS(x)                                                                            \
-    case TypeOpérande::x:                                                                         \
-        os << #x;                                                                                 \
-        break
-    switch (type) {
-        IMPRIME_CAS(REGISTRE);
-        IMPRIME_CAS(IMMÉDIATE8);
-        IMPRIME_CAS(IMMÉDIATE16);
-        IMPRIME_CAS(IMMÉDIATE32);
-        IMPRIME_CAS(IMMÉDIATE64);
-        IMPRIME_CAS(MÉMOIRE);
-        IMPRIME_CAS(FONCTION);
-        IMPRIME_CAS(GLOBALE);
-        IMPRIME_CAS(LABEL);
-    }
-#undef IMPRIME_CAS
-    return os;
-}
-
-struct AssembleuseASM {
-  private:
-    Enchaineuse &m_sortie;
-
-  public:
-    struct Immédiate8 {
-        uint8_t valeur;
-    };
-
-    struct Immédiate16 {
-        uint16_t valeur;
-    };
-
-    struct Immédiate32 {
-        uint32_t valeur;
-    };
-
-    struct Immédiate64 {
-        uint64_t valeur;
-    };
-
-    struct Fonction {
-        kuri::chaine_statique valeur{};
-        bool plt = false;
-    };
-
-    struct Globale {
-        kuri::chaine_statique valeur;
-    };
-
-    struct Label {
-        kuri::chaine_statique nom;
-        int indice;
-    };
-
-    static bool est_immédiate(TypeOpérande type)
-    {
-        switch (type) {
-            case TypeOpérande::IMMÉDIATE8:
-            case TypeOpérande::IMMÉDIATE16:
-            case TypeOpérande::IMMÉDIATE32:
-            case TypeOpérande::IMMÉDIATE64:
-            {
-                return true;
-            }
-            case TypeOpérande::REGISTRE:
-            case TypeOpérande::MÉMOIRE:
-            case TypeOpérande::FONCTION:
-            case TypeOpérande::GLOBALE:
-            case TypeOpérande::LABEL:
-            {
-                return false;
-            }
-        }
-        return false;
-    }
-
-    struct Mémoire {
-        /* Un registre ou le nom d'une globale. */
-        kuri::chaine_statique adresse{};
-        int32_t décalage = 0;
-        bool est_globale = false;
-
-        Mémoire() = default;
-
-        Mémoire(Registre registre, int32_t décalage_ = 0)
-            : adresse(chaine_pour_registre(registre, 8)), décalage(décalage_)
-        {
-        }
-
-        Mémoire(kuri::chaine_statique globale) : adresse(globale), est_globale(true)
-        {
-        }
-    };
-
-    struct Opérande {
-        TypeOpérande type{};
-        Registre registre{};
-        Immédiate8 immédiate8{};
-        Immédiate16 immédiate16{};
-        Immédiate32 immédiate32{};
-        Immédiate64 immédiate64{};
-        Mémoire mémoire{};
-        Fonction fonction{};
-        Globale globale{};
-        Label label{};
-
-        Opérande()
-        {
-        }
-
-        Opérande(Mémoire mém) : type(TypeOpérande::MÉMOIRE), mémoire(mém)
-        {
-        }
-
-        Opérande(Immédiate8 imm) : type(TypeOpérande::IMMÉDIATE8), immédiate8(imm)
-        {
-        }
-
-        Opérande(Immédiate16 imm) : type(TypeOpérande::IMMÉDIATE16), immédiate16(imm)
-        {
-        }
-
-        Opérande(Immédiate32 imm) : type(TypeOpérande::IMMÉDIATE32), immédiate32(imm)
-        {
-        }
-
-        Opérande(Immédiate64 imm) : type(TypeOpérande::IMMÉDIATE64), immédiate64(imm)
-        {
-        }
-
-        Opérande(Registre reg) : type(TypeOpérande::REGISTRE), registre(reg)
-        {
-        }
-
-        Opérande(Fonction fonct) : type(TypeOpérande::FONCTION), fonction(fonct)
-        {
-        }
-
-        Opérande(Globale glob) : type(TypeOpérande::GLOBALE), globale(glob)
-        {
-        }
-
-        Opérande(Label lab) : type(TypeOpérande::LABEL), label(lab)
-        {
-        }
-
-        bool est_mémoire() const
-        {
-            return type == TypeOpérande::MÉMOIRE && mémoire.est_globale == false;
-        }
-    };
-
-    static bool est_registre(Opérande src, Registre reg)
-    {
-        return src.type == TypeOpérande::REGISTRE && src.registre == reg;
-    }
-
-    static Opérande donne_immédiate8(Opérande opérande)
-    {
-        assert(est_immédiate(opérande.type));
-        if (opérande.type == TypeOpérande::IMMÉDIATE16) {
-            return Immédiate8{static_cast<uint8_t>(opérande.immédiate16.valeur)};
-        }
-        if (opérande.type == TypeOpérande::IMMÉDIATE32) {
-            return Immédiate8{static_cast<uint8_t>(opérande.immédiate32.valeur)};
-        }
-        if (opérande.type == TypeOpérande::IMMÉDIATE64) {
-            return Immédiate8{static_cast<uint8_t>(opérande.immédiate64.valeur)};
-        }
-        return opérande;
-    }
-
-    AssembleuseASM(Enchaineuse &sortie) : m_sortie(sortie)
-    {
-    }
-
-    void commente(kuri::chaine_statique message)
-    {
-        m_sortie << "  ;" << message << "\n";
-    }
-
-    void mov(Opérande dst, Opérande src, uint32_t taille)
-    {
-        assert(!est_immédiate(dst.type));
-        assert(taille <= 8);
-        assert(!dst.est_mémoire() || !src.est_mémoire());
-        ajoute_instruction_binaire(__func__, dst, taille, src, taille);
-    }
-
-    void mov_ah(Opérande dst)
-    {
-        assert(!est_immédiate(dst.type));
-        ajoute_instruction_binaire("mov", dst, 1, Registre::AH, 1);
-    }
-
-    void movsx(Opérande dst, uint32_t taille_dst, Opérande src, uint32_t taille_src)
-    {
-        assert(!est_immédiate(dst.type) && !est_immédiate(src.type));
-        assert(taille_dst <= 8 && taille_src <= 8);
-        assert(!dst.est_mémoire() || !src.est_mémoire());
-        ajoute_instruction_binaire(__func__, dst, taille_dst, src, taille_src);
-    }
-
-    void movzx(Opérande dst, uint32_t taille_dst, Opérande src, uint32_t taille_src)
-    {
-        assert(!est_immédiate(dst.type) && !est_immédiate(src.type));
-        assert(taille_dst <= 8 && taille_src <= 8);
-        assert(!dst.est_mémoire() || !src.est_mémoire());
-        ajoute_instruction_binaire(__func__, dst, taille_dst, src, taille_src);
-    }
-
-    void movss(Opérande dst, Opérande src)
-    {
-        assert(!est_immédiate(dst.type));
-        assert(dst.type != TypeOpérande::MÉMOIRE || src.type != TypeOpérande::MÉMOIRE);
-        ajoute_instruction_binaire(__func__, dst, 4, src, 4);
-    }
-
-    void movsd(Opérande dst, Opérande src)
-    {
-        assert(!est_immédiate(dst.type));
-        assert(dst.type != TypeOpérande::MÉMOIRE || src.type != TypeOpérande::MÉMOIRE);
-        ajoute_instruction_binaire(__func__, dst, 8, src, 8);
-    }
-
-    void lea(Opérande dst, Opérande src)
-    {
-        assert_rappel(src.type == TypeOpérande::MÉMOIRE,
-                      [&]() { dbg() << "La source est de type " << src.type; });
-        assert(dst.type == TypeOpérande::REGISTRE);
-        ajoute_instruction_binaire(__func__, dst, 8, src, 8);
-    }
-
-    void call(Opérande src)
-    {
-        ajoute_instruction_unaire(__func__, src, 8);
-    }
-
-    void jump(int id_label)
-    {
-        ajoute_instruction_unaire("jmp", Label{"label", id_label}, 0);
-    }
-
-    void jump_si_zéro(int id_label)
-    {
-        ajoute_instruction_unaire("jz", Label{"label", id_label}, 0);
-    }
-
-    void jump_si_non_zéro(int id_label)
-    {
-        ajoute_instruction_unaire("jnz", Label{"label", id_label}, 0);
-    }
-
-    void jump_si_égal(int id_label)
-    {
-        ajoute_instruction_unaire("je", Label{"label", id_label}, 0);
-    }
-
-    void jump_si_inégal(int id_label)
-    {
-        ajoute_instruction_unaire("jne", Label{"label", id_label}, 0);
-    }
-
-    void jump_si_inférieur(int id_label)
-    {
-        ajoute_instruction_unaire("jl", Label{"label", id_label}, 0);
-    }
-
-    void jump_si_inférieur_égal(int id_label)
-    {
-        ajoute_instruction_unaire("jle", Label{"label", id_label}, 0);
-    }
-
-    void jump_si_supérieur(int id_label)
-    {
-        ajoute_instruction_unaire("jg", Label{"label", id_label}, 0);
-    }
-
-    void jump_si_supérieur_égal(int id_label)
-    {
-        ajoute_instruction_unaire("jge", Label{"label", id_label}, 0);
-    }
-
-    void label(int id)
-    {
-        ajoute_label(Label{"label", id});
-    }
-
-    void add(Opérande dst, Opérande src, uint32_t taille_octet)
-    {
-        génère_code_opération_binaire(dst, src, "add", taille_octet);
-    }
-
-    void sub(Opérande dst, Opérande src, uint32_t taille_octet)
-    {
-        génère_code_opération_binaire(dst, src, "sub", taille_octet);
-    }
-
-    void mul(Opérande src, uint32_t taille_octet)
-    {
-        assert(!est_immédiate(src.type));
-        ajoute_instruction_unaire(__func__, src, taille_octet);
-    }
-
-    void imul(Opérande dst, Opérande src, uint32_t taille_octet)
-    {
-        génère_code_opération_binaire(dst, src, "imul", taille_octet);
-    }
-
-    void imul(Opérande src, uint32_t taille_octet)
-    {
-        ajoute_instruction_unaire(__func__, src, taille_octet);
-    }
-
-    void div(Opérande src, uint32_t taille_octet)
-    {
-        ajoute_instruction_unaire(__func__, src, taille_octet);
-    }
-
-    void idiv(Opérande src, uint32_t taille_octet)
-    {
-        ajoute_instruction_unaire(__func__, src, taille_octet);
-    }
-
-    void neg(Opérande dst, uint32_t taille_octet)
-    {
-        ajoute_instruction_unaire(__func__, dst, taille_octet);
-    }
-
-    void addss(Opérande dst, Opérande src)
-    {
-        ajoute_instruction_binaire(__func__, dst, 4, src, 4);
-    }
-
-    void addsd(Opérande dst, Opérande src)
-    {
-        ajoute_instruction_binaire(__func__, dst, 8, src, 8);
-    }
-
-    void mulss(Opérande dst, Opérande src)
-    {
-        ajoute_instruction_binaire(__func__, dst, 4, src, 4);
-    }
-
-    void mulsd(Opérande dst, Opérande src)
-    {
-        ajoute_instruction_binaire(__func__, dst, 8, src, 8);
-    }
-
-    void subss(Opérande dst, Opérande src)
-    {
-        ajoute_instruction_binaire(__func__, dst, 4, src, 4);
-    }
-
-    void subsd(Opérande dst, Opérande src)
-    {
-        ajoute_instruction_binaire(__func__, dst, 8, src, 8);
-    }
-
-    void divss(Opérande dst, Opérande src)
-    {
-        ajoute_instruction_binaire(__func__, dst, 4, src, 4);
-    }
-
-    void divsd(Opérande dst, Opérande src)
-    {
-        ajoute_instruction_binaire(__func__, dst, 8, src, 8);
-    }
-
-    void xorps(Opérande dst, Opérande src)
-    {
-        ajoute_instruction_binaire(__func__, dst, 4, src, 4);
-    }
-
-    void and_(Opérande dst, Opérande src, uint32_t taille_octet)
-    {
-        génère_code_opération_binaire(dst, src, "and", taille_octet);
-    }
-
-    void or_(Opérande dst, Opérande src, uint32_t taille_octet)
-    {
-        génère_code_opération_binaire(dst, src, "or", taille_octet);
-    }
-
-    void xor_(Opérande dst, Opérande src, uint32_t taille_octet)
-    {
-        génère_code_opération_binaire(dst, src, "xor", taille_octet);
-    }
-
-    void not_(Opérande dst, uint32_t taille_octet)
-    {
-        ajoute_instruction_unaire("not", dst, taille_octet);
-    }
-
-    void shl(Opérande dst, Opérande src, uint32_t taille_octet)
-    {
-        génère_code_décalage_bits(dst, src, "shl", taille_octet);
-    }
-
-    void shr(Opérande dst, Opérande src, uint32_t taille_octet)
-    {
-        génère_code_décalage_bits(dst, src, "shr", taille_octet);
-    }
-
-    void sar(Opérande dst, Opérande src, uint32_t taille_octet)
-    {
-        génère_code_décalage_bits(dst, src, "sar", taille_octet);
-    }
-
-    void cmp(Opérande dst, Opérande src, uint32_t taille_octet)
-    {
-        ajoute_instruction_binaire(__func__, dst, taille_octet, src, taille_octet);
-    }
-
-    void ucomiss(Opérande dst, Opérande src)
-    {
-        assert(dst.type == TypeOpérande::REGISTRE);
-        assert(!est_immédiate(src.type));
-        ajoute_instruction_binaire(__func__, dst, 4, src, 4);
-    }
-
-    void ucomisd(Opérande dst, Opérande src)
-    {
-        assert(dst.type == TypeOpérande::REGISTRE);
-        assert(!est_immédiate(src.type));
-        ajoute_instruction_binaire(__func__, dst, 8, src, 8);
-    }
-
-    void cmove(Opérande dst, Opérande src)
-    {
-        génère_code_opération_binaire(dst, src, "cmove", 8);
-    }
-
-    void cmovne(Opérande dst, Opérande src)
-    {
-        génère_code_opération_binaire(dst, src, "cmovne", 8);
-    }
-
-    void cmovl(Opérande dst, Opérande src)
-    {
-        génère_code_opération_binaire(dst, src, "cmovl", 8);
-    }
-
-    void cmovle(Opérande dst, Opérande src)
-    {
-        génère_code_opération_binaire(dst, src, "cmovle", 8);
-    }
-
-    void cmovg(Opérande dst, Opérande src)
-    {
-        génère_code_opération_binaire(dst, src, "cmovg", 8);
-    }
-
-    void cmovge(Opérande dst, Opérande src)
-    {
-        génère_code_opération_binaire(dst, src, "cmovge", 8);
-    }
-
-    void cvttss2si(Opérande dst, Opérande src, uint32_t taille_octet)
-    {
-        ajoute_instruction_binaire(__func__, dst, taille_octet, src, taille_octet);
-    }
-
-    void cvtss2si(Opérande dst, Opérande src, uint32_t taille_octet)
-    {
-        ajoute_instruction_binaire(__func__, dst, taille_octet, src, taille_octet);
-    }
-
-    void cvttsd2si(Opérande dst, Opérande src, uint32_t taille_octet)
-    {
-        ajoute_instruction_binaire(__func__, dst, taille_octet, src, taille_octet);
-    }
-
-    void cvtsd2si(Opérande dst, Opérande src, uint32_t taille_octet)
-    {
-        ajoute_instruction_binaire(__func__, dst, taille_octet, src, taille_octet);
-    }
-
-    void cvtsd2ss(Opérande dst, Opérande src)
-    {
-        ajoute_instruction_binaire(__func__, dst, 4, src, 8);
-    }
-
-    void test(Opérande dst, Opérande src)
-    {
-        ajoute_instruction_binaire(__func__, dst, 8, src, 8);
-    }
-
-    void push(Opérande src, uint32_t taille_octet)
-    {
-        if (src.type == TypeOpérande::REGISTRE) {
-            assert(taille_octet == 8);
-        }
-        ajoute_instruction_unaire(__func__, src, taille_octet);
-    }
-
-    void empile(Registre reg, uint32_t taille_octet)
-    {
-        if (taille_octet == 8) {
-            push(reg, 8);
-        }
-        else {
-            // mov(Mémoire{Registre::RSP}, reg, taille_octet);
-            // sub(Registre::RSP, Immédiate64{taille_octet}, 8);
-            push(reg, 8);
-        }
-    }
-
-    void push(Registre reg)
-    {
-        push(reg, 8);
-    }
-
-    void push_immédiate_8(uint8_t valeur)
-    {
-        push(Immédiate8{valeur}, 1);
-    }
-
-    void push_immédiate_16(uint16_t valeur)
-    {
-        push(Immédiate16{valeur}, 2);
-    }
-
-    void push_immédiate_32(uint32_t valeur)
-    {
-        push(Immédiate32{valeur}, 4);
-    }
-
-    void push_immédiate_64(uint64_t valeur)
-    {
-        push(Immédiate64{valeur}, 8);
-    }
-
-    void pop(Opérande dst, uint32_t taille_octet)
-    {
-        if (dst.type == TypeOpérande::REGISTRE) {
-            assert(taille_octet == 8);
-        }
-        ajoute_instruction_unaire(__func__, dst, taille_octet);
-    }
-
-    void pop(Registre reg)
-    {
-        pop(reg, 8);
-    }
-
-    void dépile(Registre reg, uint32_t taille_octet)
-    {
-        if (taille_octet == 8) {
-            pop(reg, 8);
-        }
-        else {
-            // mov(reg, Mémoire{Registre::RSP}, taille_octet);
-            // add(Registre::RSP, Immédiate64{taille_octet}, 8);
-            pop(reg, 8);
-        }
-    }
-
-    void ret()
-    {
-        ajoute_instruction(__func__);
-    }
-
-    void syscall()
-    {
-        ajoute_instruction(__func__);
-    }
-
-    void ud2()
-    {
-        ajoute_instruction(__func__);
-    }
-
-    void int3()
-    {
-        ajoute_instruction(__func__);
-    }
-
-    void cbw()
-    {
-        ajoute_instruction(__func__);
-    }
-
-    void cwd()
-    {
-        ajoute_instruction(__func__);
-    }
-
-    void cdq()
-    {
-        ajoute_instruction(__func__);
-    }
-
-    void cqo()
-    {
-        ajoute_instruction(__func__);
-    }
-
-    void pxor(Registre reg1, Registre reg2)
-    {
-        ajoute_instruction_binaire(__func__, reg1, 8, reg2, 8);
-    }
-
-    void cvtsi2ss(Opérande dst, Opérande src, uint32_t taille_octet)
-    {
-        ajoute_instruction_binaire(__func__, dst, 8, src, taille_octet);
-    }
-
-    void cvtsi2sd(Opérande dst, Opérande src, uint32_t taille_octet)
-    {
-        ajoute_instruction_binaire(__func__, dst, 8, src, taille_octet);
-    }
-
-  private:
-    void ajoute_instruction(kuri::chaine_statique nom)
-    {
-        m_sortie << TABULATION << nom << NOUVELLE_LIGNE;
-    }
-
-    void ajoute_instruction_unaire(kuri::chaine_statique nom, Opérande dst, uint32_t taille_dst)
-    {
-        m_sortie << TABULATION << nom << " ";
-        imprime_opérande(dst, taille_dst);
-        m_sortie << NOUVELLE_LIGNE;
-    }
-
-    void ajoute_instruction_binaire(kuri::chaine_statique nom,
-                                    Opérande dst,
-                                    uint32_t taille_dst,
-                                    Opérande src,
-                                    uint32_t taille_src)
-    {
-        m_sortie << TABULATION << nom << " ";
-
-        if (nom == "mov" && dst.type == TypeOpérande::MÉMOIRE) {
-            m_sortie << donne_chaine_taille_opérande(taille_dst) << " ";
-        }
-
-        imprime_opérande(dst, taille_dst);
-        m_sortie << ", ";
-        imprime_opérande(src, taille_src);
-        m_sortie << NOUVELLE_LIGNE;
-    }
-
-    void ajoute_label(Label label)
-    {
-        m_sortie << "." << label.nom << label.indice << ":" << NOUVELLE_LIGNE;
-    }
-
-    void imprime_opérande(Opérande opérande, uint32_t taille_octet = 8)
-    {
-        switch (opérande.type) {
-            case TypeOpérande::IMMÉDIATE8:
-            {
-                m_sortie << "byte " << uint32_t(opérande.immédiate8.valeur);
-                return;
-            }
-            case TypeOpérande::IMMÉDIATE16:
-            {
-                m_sortie << "word " << uint32_t(opérande.immédiate16.valeur);
-                return;
-            }
-            case TypeOpérande::IMMÉDIATE32:
-            {
-                m_sortie << "dword " << opérande.immédiate32.valeur;
-                return;
-            }
-            case TypeOpérande::IMMÉDIATE64:
-            {
-                m_sortie << "qword " << opérande.immédiate64.valeur;
-                return;
-            }
-            case TypeOpérande::MÉMOIRE:
-            {
-                auto const adresse = opérande.mémoire.adresse;
-                assert(adresse.taille() != 0);
-
-                if (!opérande.mémoire.est_globale) {
-                    auto const décalage = opérande.mémoire.décalage;
-                    m_sortie << "[" << adresse;
-                    if (décalage < 0) {
-                        m_sortie << " - " << abs(décalage);
-                    }
-                    else if (décalage > 0) {
-                        m_sortie << " + " << décalage;
-                    }
-                    m_sortie << "]";
-                }
-                else {
-                    if (adresse.pointeur()[0] == '.') {
-                        m_sortie << "qword [rel " << adresse << "]";
-                    }
-                    else {
-                        m_sortie << "[rel " << adresse << "]";
-                    }
-                }
-                return;
-            }
-            case TypeOpérande::REGISTRE:
-            {
-                m_sortie << chaine_pour_registre(opérande.registre, taille_octet);
-                return;
-            }
-            case TypeOpérande::FONCTION:
-            {
-                m_sortie << opérande.fonction.valeur;
-                if (opérande.fonction.plt) {
-                    m_sortie << " wrt ..plt";
-                }
-                return;
-            }
-            case TypeOpérande::GLOBALE:
-            {
-                m_sortie << "[" << opérande.globale.valeur << "]";
-                return;
-            }
-            case TypeOpérande::LABEL:
-            {
-                m_sortie << "." << opérande.label.nom << opérande.label.indice;
-                return;
-            }
+        auto rangée = RangéeHuitoctetsType{};
+        rangée.indice_premier_inclusif = int32_t(m_huitoctets_types.taille());
+        rangée.indice_dernier_exclusif = rangée.indice_premier_inclusif +
+                                         int32_t(résultat.taille());
+
+        POUR (résultat) {
+            m_huitoctets_types.ajoute(it);
         }
 
-        m_sortie << "opérande_invalide";
-    }
+        m_rangées_huitoctets_types.ajoute(rangée);
 
-    void génère_code_opération_binaire(Opérande dst,
-                                       Opérande src,
-                                       kuri::chaine_statique nom_op,
-                                       uint32_t taille_octet)
-    {
-        assert(!est_immédiate(dst.type));
-        assert(!(dst.type == TypeOpérande::MÉMOIRE && src.type == TypeOpérande::MÉMOIRE));
-        ajoute_instruction_binaire(nom_op, dst, taille_octet, src, taille_octet);
+        indice = int32_t(m_rangées_huitoctets_types.taille() - 1);
+        m_table_huitoctets_types.insère(type, indice);
+        return résultat;
     }
 
-    void génère_code_décalage_bits(Opérande dst,
-                                   Opérande src,
-                                   kuri::chaine_statique nom_op,
-                                   uint32_t taille_octet)
-    {
-        assert(!est_immédiate(dst.type));
-        assert(est_immédiate(src.type) || est_registre(src, Registre::RCX));
-        ajoute_instruction_binaire(nom_op, dst, taille_octet, src, 1);
+    auto rangée = m_rangées_huitoctets_types[indice];
+
+    for (auto i = rangée.indice_premier_inclusif; i < rangée.indice_dernier_exclusif; i++) {
+        résultat.ajoute(m_huitoctets_types[i]);
     }
-};
 
-static std::ostream &operator<<(std::ostream &os, AssembleuseASM::Mémoire mémoire)
+    return résultat;
+}
+
+void classifie_arguments(Typeuse &typeuse, AtomeFonction const *fonction)
 {
-    auto const adresse = mémoire.adresse;
-    assert(adresse.taille() != 0);
-    auto const décalage = mémoire.décalage;
-    os << "[" << adresse;
-    if (décalage < 0) {
-        os << " - ";
-    }
-    else {
-        os << " + ";
+    dbg() << "------------------------------------------";
+
+    auto classifieuse = ClassifieuseArgument{typeuse};
+    auto classement = classifieuse.donne_classement_arguments(
+        fonction->type->comme_type_fonction());
+
+    auto indice_arg = 0;
+    POUR (classement.arguments) {
+        dbg() << fonction->params_entrée[indice_arg++]->ident->nom;
+
+        for (auto i = it.premier_huitoctet_inclusif; i < it.dernier_huitoctet_exclusif; i++) {
+            auto registre = classement.registres_huitoctets[i].registre;
+            dbg() << " => " << classement.huitoctets[i].classe << " ("
+                  << chaine_pour_registre(registre, 8) << ")";
+        }
     }
-    os << abs(décalage) << "]";
-    return os;
 }
 
+/** \} */
+
+/*
+
+  Pour réduire la taille du code :
+
+  préfére imm8, imm16, imm32 si le nombre le permet pour mov
+
+  mov reg, 0 => xor reg, reg
+  cmp reg, 0 => test reg, reg (pour les sauts : saute_si_zéro, saute_si_non_zéro)
+  add reg, 1 => inc reg
+  sub reg, 1 => dec reg
+
+*/
+
 /* Tient trace des registres pour éviter de surécrire dans un registre. */
 struct GestionnaireRegistres {
   private:
@@ -1756,7 +872,8 @@ struct GestionnaireRegistres {
             return static_cast<Registre>(i);
         }
 
-        assert(false);
+        VERIFIE_NON_ATTEINT;
+        return static_cast<Registre>(indice_début);
     }
 
   public:
@@ -1854,7 +971,14 @@ struct GénératriceCodeASM {
 
     Typeuse &typeuse;
 
+    /* Non-nul si le code est directement encodé dans un fichier objet. */
+    EncodeuseX64 *m_encodeuse = nullptr;
+
   public:
+    /* Si non-nul, la RI de chaque fonction est libérée via cet espace une fois son code généré.
+     * Nul pour la compilation à la volée des métaprogrammes. */
+    EspaceDeTravail *espace_libération_ri = nullptr;
+
     GénératriceCodeASM(Typeuse &ref_typeuse)
         : m_constante_négation_r32(
               AtomeConstanteEntière(ref_typeuse.type_z32, uint64_t(-2147483648))),
@@ -1877,6 +1001,8 @@ struct GénératriceCodeASM {
                                                  Enchaineuse &enchaineuse,
                                                  int profondeur);
 
+    void écris_initialisation_globale(Atome const *initialisateur, SectionELF &section);
+
     void génère_code_pour_instruction(Instruction const *inst,
                                       AssembleuseASM &assembleuse,
                                       const UtilisationAtome utilisation);
@@ -1904,6 +1030,14 @@ struct GénératriceCodeASM {
                      Enchaineuse &os,
                      bool compile_toutes_les_fonctions);
 
+    void génère_code_objet(ProgrammeRepreInter const &repr_inter_programme,
+                           FichierELF &fichier,
+                           bool compile_toutes_les_fonctions);
+
+    void génère_code_pour_jit(kuri::tableau_statique<AtomeFonction const *> fonctions,
+                              FichierELF &fichier,
+                              kuri::tableau<uint64_t> &décalages_fonctions);
+
     /* Sauvegarde/restaure les registres devant être préservés à travers un appel.
      * @Long-terme : ne préserve que les registres que nous modifions. */
     void sauvegarde_registres_appel(AssembleuseASM &assembleuse);
@@ -1932,9 +1066,10 @@ struct GénératriceCodeASM {
     AssembleuseASM::Mémoire alloue_variable(InstructionAllocation const *alloc);
     AssembleuseASM::Mémoire donne_adresse_stack();
 
+    /* `os` est nul si le code est encodé dans un fichier objet. */
     void génère_code_pour_fonction(const AtomeFonction *it,
                                    AssembleuseASM &assembleuse,
-                                   Enchaineuse &os,
+                                   Enchaineuse *os,
                                    bool compile_toutes_les_fonctions);
 
     void génère_code_pour_retourne(const InstructionRetour *inst_retour,
@@ -2365,6 +1500,127 @@ void GénératriceCodeASM::génère_code_pour_initialisation_globale(Atome const
     }
 }
 
+void GénératriceCodeASM::écris_initialisation_globale(Atome const *initialisateur,
+                                                      SectionELF &section)
+{
+    switch (initialisateur->genre_atome) {
+        case Atome::Genre::FONCTION:
+        {
+            auto atome_fonc = initialisateur->comme_fonction();
+            m_encodeuse->ajoute_relocation_absolue(section, atome_fonc->nom);
+            return;
+        }
+        case Atome::Genre::TRANSTYPE_CONSTANT:
+        {
+            auto transtype = initialisateur->comme_transtype_constant();
+            écris_initialisation_globale(transtype->valeur, section);
+            return;
+        }
+        case Atome::Genre::ACCÈS_INDICE_CONSTANT:
+        {
+            auto indice_constant = initialisateur->comme_accès_indice_constant();
+            assert(indice_constant->indice == 0);
+            écris_initialisation_globale(indice_constant->accédé, section);
+            return;
+        }
+        case Atome::Genre::CONSTANTE_NULLE:
+        {
+            section.ajoute_valeur(uint64_t(0));
+            return;
+        }
+        case Atome::Genre::CONSTANTE_TAILLE_DE:
+        {
+            auto type = initialisateur->comme_taille_de()->type_de_données;
+            section.ajoute_valeur(uint32_t(type->taille_octet));
+            return;
+        }
+        case Atome::Genre::CONSTANTE_RÉELLE:
+        {
+            auto constante_réelle = initialisateur->comme_constante_réelle();
+            if (constante_réelle->type == typeuse.type_r32) {
+                section.ajoute_valeur(float(constante_réelle->valeur));
+            }
+            else {
+                section.ajoute_valeur(constante_réelle->valeur);
+            }
+            return;
+        }
+        case Atome::Genre::CONSTANTE_ENTIÈRE:
+        {
+            auto constante_entière = initialisateur->comme_constante_entière();
+            /* Petit-boutisme : les premiers octets de la valeur sont ceux à écrire. */
+            section.ajoute_octets(&constante_entière->valeur,
+                                  int64_t(constante_entière->type->taille_octet));
+            return;
+        }
+        case Atome::Genre::CONSTANTE_BOOLÉENNE:
+        {
+            auto constante_booléenne = initialisateur->comme_constante_booléenne();
+            section.ajoute_valeur(uint8_t(constante_booléenne->valeur));
+            return;
+        }
+        case Atome::Genre::CONSTANTE_CARACTÈRE:
+        {
+            auto caractère = initialisateur->comme_constante_caractère();
+            section.ajoute_valeur(uint8_t(caractère->valeur));
+            return;
+        }
+        case Atome::Genre::CONSTANTE_STRUCTURE:
+        {
+            auto structure = initialisateur->comme_constante_structure();
+            auto type = structure->type->comme_type_composé();
+            auto tableau_valeur = structure->donne_atomes_rubriques();
+            auto const début = section.donne_taille();
+
+            POUR_INDICE (type->donne_rubriques_pour_code_machine()) {
+                auto const décalage = section.donne_taille() - début;
+                if (it.décalage != décalage) {
+                    section.ajoute_zéros(it.décalage - décalage);
+                }
+
+                écris_initialisation_globale(tableau_valeur[indice_it], section);
+            }
+
+            auto const décalage = section.donne_taille() - début;
+            if (type->taille_octet != décalage) {
+                section.ajoute_zéros(type->taille_octet - décalage);
+            }
+            return;
+        }
+        case Atome::Genre::CONSTANTE_TABLEAU_FIXE:
+        {
+            auto tableau = initialisateur->comme_constante_tableau();
+            auto éléments = tableau->donne_atomes_éléments();
+
+            POUR (éléments) {
+                écris_initialisation_globale(it, section);
+            }
+
+            return;
+        }
+        case Atome::Genre::CONSTANTE_DONNÉES_CONSTANTES:
+        case Atome::Genre::INITIALISATION_TABLEAU:
+        case Atome::Genre::NON_INITIALISATION:
+        case Atome::Genre::INSTRUCTION:
+        {
+            VERIFIE_NON_ATTEINT;
+            return;
+        }
+        case Atome::Genre::GLOBALE:
+        {
+            // À FAIRE : prédéclare les noms des globales
+            auto nom = table_globales.valeur_ou(initialisateur, "0");
+            if (nom == "0") {
+                section.ajoute_valeur(uint64_t(0));
+                return;
+            }
+
+            m_encodeuse->ajoute_relocation_absolue(section, nom);
+            return;
+        }
+    }
+}
+
 void GénératriceCodeASM::génère_code_pour_instruction(const Instruction *inst,
                                                       AssembleuseASM &assembleuse,
                                                       UtilisationAtome const utilisation)
@@ -3010,7 +2266,15 @@ void GénératriceCodeASM::charge_atome_dans_registre(Atome const *atome,
     else if (atome->est_globale()) {
         if (est_type_compatible_registre_entier(source->type)) {
             assembleuse.pop(registre);
-            assembleuse.mov(registre, AssembleuseASM::Mémoire{registre}, 8);
+            assembleuse.mov(
+                registre, AssembleuseASM::Mémoire{registre}, source->type->taille_octet);
+
+            if (source->type->taille_octet == 1) {
+                assembleuse.and_(registre, AssembleuseASM::Immédiate64{0xff}, 8);
+            }
+            else if (source->type->taille_octet == 2) {
+                assembleuse.and_(registre, AssembleuseASM::Immédiate64{0xffff}, 8);
+            }
         }
         else {
             dbg() << "Type non supporté : " << chaine_type(atome->type);
@@ -3079,7 +2343,7 @@ void GénératriceCodeASM::génère_code_pour_opération_binaire(InstructionOpBi
     auto génère_code_comparaison_entier = [&](auto &&gen_code) {
         auto const type_gauche = inst_bin->valeur_gauche->type;
 
-        if ((utilisation & UtilisationAtome::POUR_BRANCHE_CONDITION) != UtilisationAtome::AUCUNE) {
+        if (utilisation == UtilisationAtome::POUR_BRANCHE_CONDITION) {
             assembleuse.cmp(opérande_gauche, opérande_droite, type_gauche->taille_octet);
             return;
         }
@@ -3096,6 +2360,8 @@ void GénératriceCodeASM::génère_code_pour_opération_binaire(InstructionOpBi
         assembleuse.cmp(opérande_gauche, opérande_droite, type_gauche->taille_octet);
         gen_code(registre_résultat, registre);
 
+        assembleuse.empile(registre_résultat, inst_bin->type->taille_octet);
+
         // table_valeurs[inst_bin->numéro] = registre_résultat;
         registres.réinitialise();
         registres.marque_registre_occupé(registre_résultat);
@@ -3114,7 +2380,7 @@ void GénératriceCodeASM::génère_code_pour_opération_binaire(InstructionOpBi
             assembleuse.movsd(Registre::XMM1, opérande_droite);
         }
 
-        if ((utilisation & UtilisationAtome::POUR_BRANCHE_CONDITION) != UtilisationAtome::AUCUNE) {
+        if (utilisation == UtilisationAtome::POUR_BRANCHE_CONDITION) {
             if (type_gauche == typeuse.type_r32) {
                 assembleuse.ucomiss(Registre::XMM0, Registre::XMM1);
             }
@@ -3837,7 +3103,18 @@ void GénératriceCodeASM::génère_code_pour_branche_condition(
 
     auto atome_prédicat = donne_source_charge_ou_atome(prédicat);
 
-    génère_code_pour_atome(atome_prédicat, assembleuse, UtilisationAtome::POUR_BRANCHE_CONDITION);
+    /* POUR_OPÉRANDE contient POUR_BRANCHE_CONDITION : appelons directement la génération de
+     * l'opération afin que seule la comparaison du prédicat ne pose que les drapeaux du CPU, les
+     * autres comparaisons devant empiler leur résultat. */
+    if (est_instruction_comparaison(prédicat)) {
+        génère_code_pour_opération_binaire(prédicat->comme_instruction()->comme_op_binaire(),
+                                           assembleuse,
+                                           UtilisationAtome::POUR_BRANCHE_CONDITION);
+    }
+    else {
+        génère_code_pour_atome(
+            atome_prédicat, assembleuse, UtilisationAtome::POUR_BRANCHE_CONDITION);
+    }
 
     auto génère_code_branche = [&](auto &&méthode_si_vrai, auto &&méthode_si_faux) {
         /* Ne générons qu'un seul saut si possible. */
@@ -4370,7 +3647,10 @@ void GénératriceCodeASM::génère_code(ProgrammeRepreInter const &repr_inter_p
 
         dbg() << "[" << indice_it << " / " << fonctions_à_compiler.taille() << "] "
               << "Compilation de " << it->nom;
-        génère_code_pour_fonction(it, assembleuse, os, compile_toutes_les_fonctions);
+        génère_code_pour_fonction(it, assembleuse, &os, compile_toutes_les_fonctions);
+        if (espace_libération_ri) {
+            espace_libération_ri->libère_ri_fonction(it);
+        }
     }
 
     // Fonction de test.
@@ -4384,18 +3664,145 @@ void GénératriceCodeASM::génère_code(ProgrammeRepreInter const &repr_inter_p
     }
 }
 
+void GénératriceCodeASM::génère_code_objet(ProgrammeRepreInter const &repr_inter_programme,
+                                           FichierELF &fichier,
+                                           bool compile_toutes_les_fonctions)
+{
+    auto encodeuse = EncodeuseX64(fichier);
+    m_encodeuse = &encodeuse;
+
+    auto fonctions = repr_inter_programme.donne_fonctions();
+    auto fonctions_à_compiler = donne_fonctions_à_compiler(fonctions,
+                                                           compile_toutes_les_fonctions);
+
+    auto opt_données_constantes = repr_inter_programme.donne_données_constantes();
+    if (opt_données_constantes.has_value()) {
+        auto données_constantes = opt_données_constantes.value();
+
+        auto section_rodata = fichier.donne_section(".rodata");
+        section_rodata->aligne(uint64_t(données_constantes->alignement_désiré));
+        auto const décalage = section_rodata->donne_taille();
+        fichier.écris_données_constantes(données_constantes);
+
+        encodeuse.définis_symbole("DC",
+                                  section_rodata,
+                                  décalage,
+                                  section_rodata->donne_taille() - décalage,
+                                  STT_OBJECT,
+                                  STB_LOCAL);
+
+        POUR (données_constantes->tableaux_constants) {
+            auto nom_globale = enchaine("DC + ", it.décalage_dans_données_constantes);
+            table_globales.insère(it.globale, nom_globale);
+        }
+    }
+
+    auto globales = repr_inter_programme.donne_globales();
+
+    auto section_data = fichier.donne_section(".data");
+    POUR (globales) {
+        if (it->est_externe || !it->est_constante) {
+            continue;
+        }
+
+        auto type = it->donne_type_alloué();
+        section_data->aligne(type->alignement);
+        auto const décalage = section_data->donne_taille();
+        écris_initialisation_globale(it->initialisateur, *section_data);
+
+        encodeuse.définis_symbole(broyeuse.broye_nom_simple(it->ident),
+                                  section_data,
+                                  décalage,
+                                  section_data->donne_taille() - décalage,
+                                  STT_OBJECT,
+                                  STB_LOCAL);
+    }
+
+    auto section_bss = fichier.donne_section(".bss");
+    POUR (globales) {
+        if (it->est_externe || it->est_constante) {
+            continue;
+        }
+
+        auto type = it->donne_type_alloué();
+        section_bss->aligne(type->alignement);
+        auto const décalage = section_bss->donne_taille();
+        section_bss->ajoute_zéros(type->taille_octet);
+
+        encodeuse.définis_symbole(broyeuse.broye_nom_simple(it->ident),
+                                  section_bss,
+                                  décalage,
+                                  type->taille_octet,
+                                  STT_OBJECT,
+                                  STB_LOCAL);
+    }
+
+    /* Définition des fonctions. Les fonctions externes sont référencées par des symboles
+     * non-définis lors de leurs appels. */
+    auto assembleuse = AssembleuseASM(encodeuse);
+
+    POUR_INDICE (fonctions_à_compiler) {
+        if (it->est_externe) {
+            continue;
+        }
+
+        dbg() << "[" << indice_it << " / " << fonctions_à_compiler.taille() << "] "
+              << "Compilation de " << it->nom;
+        génère_code_pour_fonction(it, assembleuse, nullptr, compile_toutes_les_fonctions);
+        if (espace_libération_ri) {
+            espace_libération_ri->libère_ri_fonction(it);
+        }
+    }
+
+    // Fonction de test.
+    if (!compile_toutes_les_fonctions) {
+        encodeuse.débute_fonction("main");
+        assembleuse.call(AssembleuseASM::Fonction{"principale", false});
+        assembleuse.mov(
+            AssembleuseASM::Opérande(Registre::RAX), AssembleuseASM::Immédiate32(0), 4);
+        assembleuse.ret();
+        encodeuse.termine_fonction();
+    }
+
+    m_encodeuse = nullptr;
+}
+
+void GénératriceCodeASM::génère_code_pour_jit(
+    kuri::tableau_statique<AtomeFonction const *> fonctions,
+    FichierELF &fichier,
+    kuri::tableau<uint64_t> &décalages_fonctions)
+{
+    auto encodeuse = EncodeuseX64(fichier);
+    m_encodeuse = &encodeuse;
+
+    auto assembleuse = AssembleuseASM(encodeuse);
+
+    POUR (fonctions) {
+        génère_code_pour_fonction(it, assembleuse, nullptr, false);
+        auto const &symbole = fichier.donne_symbole(encodeuse.donne_indice_symbole(it->nom));
+        décalages_fonctions.ajoute(symbole.valeur);
+    }
+
+    m_encodeuse = nullptr;
+}
+
 void GénératriceCodeASM::génère_code_pour_fonction(AtomeFonction const *fonction,
                                                    AssembleuseASM &assembleuse,
-                                                   Enchaineuse &os,
+                                                   Enchaineuse *os,
                                                    bool compile_toutes_les_fonctions)
 {
     fonction->numérote_instructions();
 
+    auto nom_fonction = kuri::chaine_statique(fonction->nom);
     if (compile_toutes_les_fonctions && fonction->nom == "principale") {
-        os << "__principale:\n";
+        nom_fonction = "__principale";
+    }
+
+    if (m_encodeuse) {
+        m_encodeuse->débute_fonction(nom_fonction);
     }
     else {
-        os << fonction->nom << ":\n";
+        *os << nom_fonction << ":\n";
     }
 
     définis_fonction_courante(fonction);
@@ -4498,17 +3905,31 @@ void GénératriceCodeASM::génère_code_pour_fonction(AtomeFonction const *fonc
             continue;
         }
 
-        imprime_inst_en_commentaire(os, it);
+        if (os) {
+            imprime_inst_en_commentaire(*os, it);
+        }
         génère_code_pour_instruction(it, assembleuse, UtilisationAtome::AUCUNE);
     }
 
     POUR_INDICE (m_constantes_fonction_courante) {
-        os << TABULATION << ".C" << indice_it << ":" << NOUVELLE_LIGNE;
-        génère_code_pour_initialisation_globale(it, os, 1);
+        if (m_encodeuse) {
+            m_encodeuse->définis_constante_locale(indice_it);
+            écris_initialisation_globale(it, m_encodeuse->donne_section_text());
+            continue;
+        }
+
+        *os << TABULATION << ".C" << indice_it << ":" << NOUVELLE_LIGNE;
+        génère_code_pour_initialisation_globale(it, *os, 1);
     }
 
     m_fonction_courante = nullptr;
-    os << "\n\n";
+
+    if (m_encodeuse) {
+        m_encodeuse->termine_fonction();
+    }
+    else {
+        *os << "\n\n";
+    }
 }
 
 /* http://www.uclibc.org/docs/psABI-x86_64.pdf */
@@ -4585,8 +4006,6 @@ std::optional<ErreurCoulisse> CoulisseASM::génère_code_impl(const ArgsGénéra
 std::optional<ErreurCoulisse> CoulisseASM::crée_fichier_objet_impl(
     const ArgsCréationFichiersObjets &args)
 {
-    Enchaineuse enchaineuse;
-
     auto &repr_inter_programme = *args.ri_programme;
     auto &typeuse = args.espace->typeuse;
     auto &compilatrice = args.compilatrice;
@@ -4596,6 +4015,23 @@ std::optional<ErreurCoulisse> CoulisseASM::crée_fichier_objet_impl(
     // génère_code_début_fichier(enchaineuse, compilatrice.racine_kuri);
 
     auto génératrice = GénératriceCodeASM{typeuse};
+    génératrice.espace_libération_ri = args.espace;
+
+    if (compilatrice->arguments.assembleur_interne) {
+        auto fichier = FichierELF::crée_fichier_objet();
+        génératrice.génère_code_objet(
+            repr_inter_programme, *fichier, compile_toutes_les_fonctions);
+        auto const fichier_écris = fichier->écris_vers("/tmp/compilation_kuri_asm.o");
+        mémoire::déloge("FichierELF", fichier);
+
+        if (!fichier_écris) {
+            return ErreurCoulisse{"Impossible d'écrire le fichier objet."};
+        }
+
+        return {};
+    }
+
+    Enchaineuse enchaineuse;
     génératrice.génère_code(repr_inter_programme, enchaineuse, compile_toutes_les_fonctions);
 
     std::ofstream of;
@@ -4660,3 +4096,12 @@ int64_t CoulisseASM::mémoire_utilisée() const
 {
     return 0;
 }
+
+void génère_code_machine_pour_jit(Typeuse &typeuse,
+                                  kuri::tableau_statique<AtomeFonction const *> fonctions,
+                                  FichierELF &fichier,
+                                  kuri::tableau<uint64_t> &décalages_fonctions)
+{
+    auto génératrice = GénératriceCodeASM{typeuse};
+    génératrice.génère_code_pour_jit(fonctions, fichier, décalages_fonctions);
+}
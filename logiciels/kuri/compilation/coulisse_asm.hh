@@ -3,8 +3,11 @@
 
 #pragma once
 
+#include "structures/tableau.hh"
+
 #include "coulisse.hh"
 
+class FichierELF;
 struct Typeuse;
 
 struct CoulisseASM final : public Coulisse {
@@ -21,3 +24,14 @@ struct CoulisseASM final : public Coulisse {
 
 struct AtomeFonction;
 void classifie_arguments(Typeuse &typeuse, AtomeFonction const *fonction);
+
+/* Encode, pour la compilation à la volée des métaprogrammes, le code machine des fonctions
+ * données dans la section .text du fichier, sans passer par un assembleur externe. Le décalage de
+ * chaque fonction dans la section est ajouté à décalages_fonctions. Les appels entre les
+ * fonctions restent des relocations de la section, à résoudre une fois l'adresse du code connue.
+ * Les fonctions ne peuvent appeler que des fonctions de la liste, et ne peuvent référencer ni
+ * globales, ni données constantes. */
+void génère_code_machine_pour_jit(Typeuse &typeuse,
+                                  kuri::tableau_statique<AtomeFonction const *> fonctions,
+                                  FichierELF &fichier,
+                                  kuri::tableau<uint64_t> &décalages_fonctions);
@@ -3,13 +3,17 @@
 
 #include "coulisse_c.hh"
 
+#include <algorithm>
+#include <atomic>
 #include <fstream>
+#include <thread>
 
 #include "structures/chemin_systeme.hh"
 #include "structures/table_hachage.hh"
 #include "structures/tableau_page.hh"
 
 #include "parsage/identifiant.hh"
+#include "parsage/modules.hh"
 
 #include "utilitaires/divers.hh"
 #include "utilitaires/poule_de_taches.hh"
@@ -236,6 +240,10 @@ struct GénératriceCodeC {
     EspaceDeTravail &m_espace;
     AtomeFonction const *m_fonction_courante = nullptr;
 
+    /* Pour les génératrices des fichiers sources générés en parallèle : la génératrice ayant
+     * généré l'entête, dont les tables de noms sont partagées en lecture seule. */
+    GénératriceCodeC const *m_génératrice_entête = nullptr;
+
     InformationsDeDébogage *m_info_débogage = nullptr;
 
     Broyeuse &broyeuse;
@@ -276,6 +284,10 @@ struct GénératriceCodeC {
 
     GénératriceCodeC(EspaceDeTravail &espace, Broyeuse &broyeuse_);
 
+    GénératriceCodeC(EspaceDeTravail &espace,
+                     Broyeuse &broyeuse_,
+                     GénératriceCodeC const &génératrice_entête);
+
     EMPECHE_COPIE(GénératriceCodeC);
 
     ~GénératriceCodeC();
@@ -292,7 +304,8 @@ struct GénératriceCodeC {
 
     void déclare_fonction(Enchaineuse &os, AtomeFonction const *atome_fonc, bool pour_entête);
 
-    void génère_code(CoulisseC::FichierC const &fichier);
+    /* Retourne l'empreinte du code généré. */
+    uint64_t génère_code(CoulisseC::FichierC const &fichier);
 
     void génère_code_pour_appel(Enchaineuse &os, InstructionAppel const *appel);
     void génère_code_pour_appel_impl(Enchaineuse &os, InstructionAppel const *appel);
@@ -316,6 +329,9 @@ struct GénératriceCodeC {
 
     kuri::chaine_statique donne_nom_pour_instruction(Instruction const *instruction);
 
+    kuri::chaine_statique donne_nom_globale_généré(Atome const *globale,
+                                                   kuri::chaine_statique défaut) const;
+
     kuri::chaine_statique donne_nom_pour_init_tableau();
 
     kuri::chaine_statique donne_nom_pour_globale(const AtomeGlobale *valeur_globale,
@@ -1110,6 +1126,17 @@ GénératriceCodeC::GénératriceCodeC(EspaceDeTravail &espace, Broyeuse &broyeu
 #endif
 }
 
+GénératriceCodeC::GénératriceCodeC(EspaceDeTravail &espace,
+                                   Broyeuse &broyeuse_,
+                                   GénératriceCodeC const &génératrice_entête)
+    : m_espace(espace), m_génératrice_entête(&génératrice_entête), broyeuse(broyeuse_)
+{
+    m_convertisseuse_type_c = mémoire::loge<ConvertisseuseTypeC>("Conver", broyeuse, *this);
+    nombre_de_globales = génératrice_entête.nombre_de_globales;
+    nombre_de_fonctions = génératrice_entête.nombre_de_fonctions;
+    nombre_de_types = génératrice_entête.nombre_de_types;
+}
+
 GénératriceCodeC::~GénératriceCodeC()
 {
     mémoire::déloge("Conver", m_convertisseuse_type_c);
@@ -1263,7 +1290,7 @@ kuri::chaine_statique GénératriceCodeC::génère_code_pour_atome(Atome const *
         }
         case Atome::Genre::GLOBALE:
         {
-            return table_globales.valeur_ou(atome, "");
+            return donne_nom_globale_généré(atome, "");
         }
         case Atome::Genre::TRANSTYPE_CONSTANT:
         {
@@ -2049,6 +2076,7 @@ void GénératriceCodeC::génère_code_entête(CoulisseC::FichierC const &fichie
     /* Définissons ensuite les fonctions devant être enlignées. */
     POUR (fichier.fonctions_enlignées) {
         génère_code_fonction(it, os);
+        m_espace.libère_ri_fonction(it);
     }
 }
 
@@ -2116,6 +2144,22 @@ kuri::chaine_statique GénératriceCodeC::donne_nom_pour_instruction(const Instr
     return enchaine(nom_base_variable, instruction->numéro);
 }
 
+kuri::chaine_statique GénératriceCodeC::donne_nom_globale_généré(
+    Atome const *globale, kuri::chaine_statique défaut) const
+{
+    auto trouvé = false;
+    auto nom = table_globales.trouve(globale, trouvé);
+    if (trouvé) {
+        return nom;
+    }
+
+    if (m_génératrice_entête) {
+        return m_génératrice_entête->table_globales.valeur_ou(globale, défaut);
+    }
+
+    return défaut;
+}
+
 kuri::chaine_statique GénératriceCodeC::donne_nom_pour_init_tableau()
 {
     return enchaine("init_tableau", nombre_init_tableau++);
@@ -2134,7 +2178,7 @@ kuri::chaine_statique GénératriceCodeC::donne_nom_pour_globale(const AtomeGlob
 
     if (!pour_entête) {
         /* Nous devons déjà avoir généré la globale. */
-        auto nom_globale = table_globales.valeur_ou(valeur_globale, "GLOBALE_INCONNUE");
+        auto nom_globale = donne_nom_globale_généré(valeur_globale, "GLOBALE_INCONNUE");
         return nom_globale.sous_chaine(1);
     }
 
@@ -2153,7 +2197,13 @@ kuri::chaine_statique GénératriceCodeC::donne_nom_pour_fonction(AtomeFonction
     }
 
     auto trouvé = false;
-    auto nom = table_fonctions.trouve(fonction, trouvé);
+    auto nom = kuri::chaine_statique();
+    if (m_génératrice_entête) {
+        nom = m_génératrice_entête->table_fonctions.trouve(fonction, trouvé);
+    }
+    if (!trouvé) {
+        nom = table_fonctions.trouve(fonction, trouvé);
+    }
     if (!trouvé) {
         nom = enchaine(nom_base_fonction, nombre_de_fonctions++);
         table_fonctions.insère(fonction, nom);
@@ -2194,7 +2244,13 @@ kuri::chaine_statique GénératriceCodeC::donne_nom_pour_type(Type const *type)
     }
 
     auto trouvé = false;
-    auto nom = table_types.trouve(type, trouvé);
+    auto nom = kuri::chaine_statique();
+    if (m_génératrice_entête) {
+        nom = m_génératrice_entête->table_types.trouve(type, trouvé);
+    }
+    if (!trouvé) {
+        nom = table_types.trouve(type, trouvé);
+    }
     if (!trouvé) {
         nom = enchaine(nom_base_type, nombre_de_types++);
         table_types.insère(type, nom);
@@ -2221,6 +2277,12 @@ kuri::chaine_statique GénératriceCodeC::donne_nom_pour_rubrique(
         return "static_";
     }
 
+    /* Le nom broyé est mis en cache dans l'identifiant, ce que nous ne pouvons faire depuis
+     * plusieurs fils. */
+    if (m_génératrice_entête && rubrique.nom->nom_broye == "") {
+        return broyeuse.broye_nom_simple(rubrique.nom->nom);
+    }
+
     return broyeuse.broye_nom_simple(rubrique.nom);
 }
 
@@ -2233,6 +2295,12 @@ void GénératriceCodeC::génère_code_source(CoulisseC::FichierC const &fichier
 {
     os << "#include \"compilation_kuri.h\"\n";
 
+    /* Les noms des chaines et des initialisations de tableaux sont locaux aux fonctions :
+     * réinitialise les compteurs afin que le code d'un fichier ne dépende pas des fichiers
+     * générés avant lui par la même génératrice. */
+    indice_chaine = 0;
+    nombre_init_tableau = 0;
+
     génère_code_pour_tableaux_données_constantes(os, fichier.données_constantes, false);
 
     /* Définis les globales. */
@@ -2260,10 +2328,12 @@ void GénératriceCodeC::génère_code_source(CoulisseC::FichierC const &fichier
             m_info_débogage->définis_fonction_courante(it->decl);
         }
         génère_code_fonction(it, os);
+        /* Chaque fonction n'est définie que dans un seul fichier. */
+        m_espace.libère_ri_fonction(it);
     }
 }
 
-void GénératriceCodeC::génère_code(CoulisseC::FichierC const &fichier)
+uint64_t GénératriceCodeC::génère_code(CoulisseC::FichierC const &fichier)
 {
     Enchaineuse enchaineuse;
 
@@ -2301,6 +2371,13 @@ void GénératriceCodeC::génère_code(CoulisseC::FichierC const &fichier)
     std::ofstream of(vers_std_path(fichier.chemin_fichier));
     enchaineuse.imprime_dans_flux(of);
     of.close();
+
+    /* La RI des fonctions du fichier fut libérée lors de la génération de leurs codes. */
+    if (!fichier.est_entête) {
+        mémoire::rends_mémoire_libérée();
+    }
+
+    return enchaineuse.empreinte_fnv1a();
 }
 
 void GénératriceCodeC::génère_code_pour_appel(Enchaineuse &os, InstructionAppel const *appel)
@@ -2644,22 +2721,19 @@ void GénératriceCodeC::génère_code_pour_tableaux_données_constantes(
         table_globales.insère(it.globale, nom_globale);
     }
 
+    /* La taille des données n'est pas dans l'entête, afin qu'un changement des données
+     * constantes ne modifie pas celui-ci, ce qui invaliderait tous les fichiers objets lors d'une
+     * compilation incrémentale. */
     if (pour_entête) {
-        os << "extern ";
-    }
-
-    os << "_Alignas(" << données_constantes->alignement_désiré << ") ";
-    os << "const uint8_t DC[" << données_constantes->taille_données_tableaux_constants << "]";
-
-    if (pour_entête) {
-        os << ";\n";
+        os << "extern _Alignas(" << données_constantes->alignement_désiré << ") ";
+        os << "const uint8_t DC[];\n";
+        os << "extern const uint64_t DC_taille;\n";
 
         os << "static inline bool intrinseque_est_adresse_donnees_constantes(const void *ptr)\n";
         os << "{\n";
         os << "    const uint8_t *ptr_type = (const uint8_t *)ptr;\n";
         os << "    const uint8_t *ptr_base = &DC[0];\n";
-        os << "    return ptr_base <= ptr_type && ptr_type < (ptr_base + "
-           << données_constantes->taille_données_tableaux_constants << ");\n";
+        os << "    return ptr_base <= ptr_type && ptr_type < (ptr_base + DC_taille);\n";
         os << "}\n";
 
         os << "static inline uint64_t intrinseque_lis_compteur_temporel()\n";
@@ -2671,6 +2745,12 @@ void GénératriceCodeC::génère_code_pour_tableaux_données_constantes(
         return;
     }
 
+    os << "const uint64_t DC_taille = " << données_constantes->taille_données_tableaux_constants
+       << ";\n";
+
+    os << "_Alignas(" << données_constantes->alignement_désiré << ") ";
+    os << "const uint8_t DC[" << données_constantes->taille_données_tableaux_constants << "]";
+
     auto virgule = " = {\n";
     auto compteur = 0;
     POUR (données_constantes->tableaux_constants) {
@@ -2703,6 +2783,11 @@ void GénératriceCodeC::génère_code_pour_tableaux_données_constantes(
 
 /** \} */
 
+static int64_t donne_nombre_fils_génération()
+{
+    return std::max(int64_t(1), int64_t(std::thread::hardware_concurrency()));
+}
+
 std::optional<ErreurCoulisse> CoulisseC::génère_code_impl(const ArgsGénérationCode &args)
 {
     auto &espace = *args.espace;
@@ -2724,12 +2809,58 @@ std::optional<ErreurCoulisse> CoulisseC::génère_code_impl(const ArgsGénérati
 
     auto génératrice = GénératriceCodeC(espace, *args.broyeuse);
 
+    /* Les noms des symboles broyés sont mis en cache dans les identifiants et les types, et les
+     * informations de débogage sont communes à tous les fichiers : dans ces cas, génère les
+     * fichiers en série. */
+    auto const génère_en_parallèle = !génératrice.préserve_symboles() &&
+                                     !génératrice.m_info_débogage;
+
+    /* Génère d'abord l'entête, qui nomme toutes les fonctions, tous les types, et toutes les
+     * globales. Les fichiers sources peuvent ensuite être générés indépendamment les uns des
+     * autres en consultant les noms de la génératrice de l'entête. */
+    kuri::tableau<CoulisseC::FichierC *> fichiers_sources;
     POUR (m_fichiers) {
+        if (!it.est_entête && génère_en_parallèle) {
+            fichiers_sources.ajoute(&it);
+            continue;
+        }
+
         if (génératrice.m_info_débogage) {
             génératrice.m_info_débogage->définis_fichier_c_courant(it.chemin_fichier);
         }
-        génératrice.génère_code(it);
+        it.empreinte = génératrice.génère_code(it);
+    }
+
+    auto const nombre_fils = std::min(donne_nombre_fils_génération(), fichiers_sources.taille());
+
+    kuri::tableau<int64_t> mémoire_par_fil(nombre_fils);
+    std::atomic<int64_t> indice_fichier_suivant = 0;
+
+    auto poule_de_tâches = kuri::PouleDeTâchesMoultFils{};
+    for (int64_t i = 0; i < nombre_fils; i++) {
+        poule_de_tâches.ajoute_tâche([&, i]() {
+            /* Chaque fil doit avoir sa propre broyeuse. */
+            auto broyeuse = Broyeuse();
+            auto génératrice_fil = GénératriceCodeC(espace, broyeuse, génératrice);
+
+            while (true) {
+                auto const indice = indice_fichier_suivant.fetch_add(1);
+                if (indice >= fichiers_sources.taille()) {
+                    break;
+                }
+
+                auto fichier = fichiers_sources[indice];
+                fichier->empreinte = génératrice_fil.génère_code(*fichier);
+            }
+
+            mémoire_par_fil[i] = génératrice_fil.mémoire_utilisée() +
+                                 broyeuse.mémoire_utilisée();
+        });
+    }
+
+    static_cast<void>(poule_de_tâches.attends_sur_tâches());
 
+    POUR (m_fichiers) {
         if (!kuri::chemin_systeme::existe(it.chemin_fichier)) {
             auto message = enchaine("Impossible d'écrire le fichier '", it.chemin_fichier, "'");
             return ErreurCoulisse{message};
@@ -2737,10 +2868,35 @@ std::optional<ErreurCoulisse> CoulisseC::génère_code_impl(const ArgsGénérati
     }
 
     m_mémoire_génératrice += génératrice.mémoire_utilisée();
+    POUR (mémoire_par_fil) {
+        m_mémoire_génératrice += it;
+    }
 
     return {};
 }
 
+/* Retourne l'empreinte identifiant le fichier objet d'un fichier source pour la compilation
+ * incrémentale : celle-ci dépend de la commande de compilation, et des codes du fichier source et
+ * de l'entête. */
+static kuri::chaine donne_empreinte_fichier_objet(kuri::chaine_statique commande,
+                                                  uint64_t empreinte_entête,
+                                                  uint64_t empreinte_source)
+{
+    auto empreinte = kuri::empreinte_fnv1a(commande);
+    empreinte = kuri::empreinte_fnv1a(enchaine(empreinte_entête, ":", empreinte_source), empreinte);
+    return enchaine(empreinte);
+}
+
+static bool fichier_objet_est_à_jour(CoulisseC::FichierC const &fichier,
+                                     kuri::chaine_statique empreinte)
+{
+    if (!kuri::chemin_systeme::existe(fichier.chemin_fichier_objet)) {
+        return false;
+    }
+
+    return charge_contenu_fichier(fichier.chemin_fichier_empreinte) == empreinte;
+}
+
 std::optional<ErreurCoulisse> CoulisseC::crée_fichier_objet_impl(
     const ArgsCréationFichiersObjets &args)
 {
@@ -2755,18 +2911,60 @@ std::optional<ErreurCoulisse> CoulisseC::crée_fichier_objet_impl(
     auto poule_de_tâches = kuri::PouleDeTâchesSousProcessus{};
 #    endif
 
+    /* Un fichier objet final n'est pas écris dans le dossier de l'espace, il ne peut être
+     * réutilisé. */
+    auto const compilation_incrémentale = args.compilatrice->arguments.compilation_incrémentale &&
+                                          espace.options.résultat !=
+                                              RésultatCompilation::FICHIER_OBJET;
+
+    auto empreinte_entête = uint64_t(0);
     POUR (m_fichiers) {
         if (it.est_entête) {
+            empreinte_entête = it.empreinte;
+        }
+    }
+
+    kuri::tableau<kuri::chaine> empreintes;
+    kuri::tableau<bool> fichiers_à_compiler;
+    auto nombre_fichiers_réutilisés = 0;
+
+    POUR (m_fichiers) {
+        if (it.est_entête) {
+            empreintes.ajoute("");
+            fichiers_à_compiler.ajoute(false);
             continue;
         }
 
-        if (!kuri::chemin_systeme::supprime(it.chemin_fichier_objet)) {
+        auto empreinte = kuri::chaine();
+        if (compilation_incrémentale) {
+            auto commande = commande_pour_fichier_objet(
+                espace.options, it.chemin_fichier, it.chemin_fichier_objet, false);
+            empreinte = donne_empreinte_fichier_objet(commande, empreinte_entête, it.empreinte);
+
+            if (fichier_objet_est_à_jour(it, empreinte)) {
+                empreintes.ajoute(empreinte);
+                fichiers_à_compiler.ajoute(false);
+                nombre_fichiers_réutilisés += 1;
+                continue;
+            }
+        }
+
+        empreintes.ajoute(empreinte);
+        fichiers_à_compiler.ajoute(true);
+
+        if (!kuri::chemin_systeme::supprime(it.chemin_fichier_objet) ||
+            !kuri::chemin_systeme::supprime(it.chemin_fichier_empreinte)) {
             return ErreurCoulisse{"Impossible de supprimer les vieux fichiers objets."};
         }
     }
 
-    POUR (m_fichiers) {
-        if (it.est_entête) {
+    if (compilation_incrémentale && args.compilatrice->arguments.verbeux) {
+        info() << "Compilation incrémentale : " << nombre_fichiers_réutilisés << " fichier(s) "
+               << "objet(s) réutilisé(s).";
+    }
+
+    POUR_INDICE (m_fichiers) {
+        if (!fichiers_à_compiler[indice_it]) {
             continue;
         }
         poule_de_tâches.ajoute_tâche([&]() {
@@ -2784,8 +2982,8 @@ std::optional<ErreurCoulisse> CoulisseC::crée_fichier_objet_impl(
 
     poule_de_tâches.attends_sur_tâches();
 
-    POUR (m_fichiers) {
-        if (it.est_entête) {
+    POUR_INDICE (m_fichiers) {
+        if (!fichiers_à_compiler[indice_it]) {
             continue;
         }
         if (kuri::chemin_systeme::existe(it.chemin_fichier_erreur_objet)) {
@@ -2802,6 +3000,13 @@ std::optional<ErreurCoulisse> CoulisseC::crée_fichier_objet_impl(
                 "Le fichier objet '", it.chemin_fichier_objet, "' ne fut pas écris.");
             return ErreurCoulisse{message};
         }
+
+        if (compilation_incrémentale) {
+            /* L'empreinte n'est écrite qu'après la création réussie du fichier objet, afin de
+             * ne jamais réutiliser un fichier objet incomplet. */
+            std::ofstream flux(vers_std_path(it.chemin_fichier_empreinte));
+            flux << empreintes[indice_it];
+        }
     }
 
     // auto &repr_inter = *args.ri_programme;
@@ -2878,10 +3083,12 @@ int64_t CoulisseC::mémoire_utilisée() const
     auto résultat = int64_t(0);
 
     résultat += m_fichiers.taille_mémoire();
+    résultat += m_fonctions_par_fichier_source.taille_mémoire();
 
     POUR (m_fichiers) {
         résultat += it.chemin_fichier.taille();
         résultat += it.chemin_fichier_objet.taille();
+        résultat += it.chemin_fichier_empreinte.taille();
         résultat += it.chemin_fichier_erreur_objet.taille();
     }
 
@@ -2890,6 +3097,22 @@ int64_t CoulisseC::mémoire_utilisée() const
     return résultat;
 }
 
+/* Retourne le chemin du fichier source de la fonction, ou une chaine vide si la fonction n'en a
+ * pas. Le chemin est utilisé plutôt que l'indice du fichier, car ce dernier dépend de l'ordre de
+ * chargement des fichiers, qui peut changer d'une compilation à l'autre. */
+static kuri::chaine_statique donne_fichier_source(EspaceDeTravail const &espace,
+                                                  AtomeFonction const *fonction)
+{
+    if (!fonction->decl || !fonction->decl->lexème) {
+        return "";
+    }
+    auto const fichier = espace.fichier(fonction->decl->lexème->fichier);
+    if (!fichier) {
+        return "";
+    }
+    return fichier->chemin();
+}
+
 void CoulisseC::crée_fichiers(const ProgrammeRepreInter &repr_inter, EspaceDeTravail const &espace)
 {
     auto const &options = espace.options;
@@ -2920,8 +3143,12 @@ void CoulisseC::crée_fichiers(const ProgrammeRepreInter &repr_inter, EspaceDeTr
         return;
     }
 
+    auto const compilation_incrémentale =
+        espace.compilatrice().arguments.compilation_incrémentale;
+
     /* Crée un fichier source pour les globales. */
-    auto &fichier_globales = ajoute_fichier_c(espace.nom, false);
+    auto &fichier_globales = ajoute_fichier_c(
+        espace.nom, false, compilation_incrémentale ? "globales" : "");
     fichier_globales.données_constantes = données_constantes;
     fichier_globales.globales = repr_inter.donne_globales_internes();
 
@@ -2930,14 +3157,57 @@ void CoulisseC::crée_fichiers(const ProgrammeRepreInter &repr_inter, EspaceDeTr
     /* Nombre maximum d'instructions par fichier, afin d'avoir une taille cohérente entre tous les
      * fichiers. */
     constexpr auto nombre_instructions_max_par_fichier = 50000;
-    int nombre_instructions = 0;
-    int indice_première_fonction = 0;
+    /* Nombre minimum d'instructions par fichier, afin que le coût de l'inclusion de l'entête dans
+     * chaque fichier reste négligeable. */
+    constexpr auto nombre_instructions_min_par_fichier = 5000;
+
     auto fonctions = repr_inter.donne_fonctions_horslignées();
 
+    auto cible_instructions = int64_t(nombre_instructions_max_par_fichier);
+    auto cible_fonctions = fonctions.taille();
+
+    if (compilation_incrémentale) {
+        /* Les limites des fichiers ne doivent dépendre que des fichiers sources, afin que les
+         * fichiers objets des fichiers sources non modifiés puissent être réutilisés. */
+        trie_fonctions_par_fichier_source(espace, fonctions);
+        fonctions = m_fonctions_par_fichier_source;
+    }
+    else if (fonctions.taille() != 0) {
+        /* Vise au moins un fichier par fil afin que la génération et la compilation du code
+         * utilisent tous les cœurs, et équilibre le nombre de fonctions entre les fichiers. */
+        auto nombre_instructions_total = int64_t(0);
+        POUR (fonctions) {
+            nombre_instructions_total += it->instructions.taille();
+        }
+
+        auto const nombre_fils = donne_nombre_fils_génération();
+        cible_instructions = (nombre_instructions_total + nombre_fils - 1) / nombre_fils;
+        cible_instructions = std::clamp(cible_instructions,
+                                        int64_t(nombre_instructions_min_par_fichier),
+                                        int64_t(nombre_instructions_max_par_fichier));
+
+        auto const nombre_fichiers = std::max(
+            int64_t(1), (nombre_instructions_total + cible_instructions - 1) / cible_instructions);
+        cible_fonctions = (fonctions.taille() + nombre_fichiers - 1) / nombre_fichiers;
+    }
+
+    auto nombre_instructions = int64_t(0);
+    auto indice_première_fonction = int64_t(0);
+    /* Pour la compilation incrémentale, les fichiers C sont nommés selon le chemin de leur
+     * fichier source et leur rang parmi les fichiers C de celui-ci : un même fichier source
+     * retrouve ainsi toujours les mêmes fichiers objets, quel que soit l'ordre de chargement. */
+    auto indice_fichier_c_pour_source = 0;
+
     POUR_INDICE (fonctions) {
         nombre_instructions += it->instructions.taille();
-        if (nombre_instructions <= nombre_instructions_max_par_fichier &&
-            indice_it != fonctions.taille() - 1) {
+        auto const nombre_fonctions = indice_it - indice_première_fonction + 1;
+        auto const fin_fichier_source =
+            compilation_incrémentale &&
+            (indice_it == fonctions.taille() - 1 ||
+             donne_fichier_source(espace, it) !=
+                 donne_fichier_source(espace, fonctions[indice_it + 1]));
+        if (nombre_instructions < cible_instructions && nombre_fonctions < cible_fonctions &&
+            indice_it != fonctions.taille() - 1 && !fin_fichier_source) {
             continue;
         }
 
@@ -2947,7 +3217,17 @@ void CoulisseC::crée_fichiers(const ProgrammeRepreInter &repr_inter, EspaceDeTr
         auto fonctions_du_fichier = kuri::tableau_statique<AtomeFonction *>(pointeur_fonction,
                                                                             taille);
 
-        auto &fichier = ajoute_fichier_c(espace.nom, false);
+        auto nom_fichier_c = kuri::chaine();
+        if (compilation_incrémentale) {
+            auto const empreinte_chemin = kuri::empreinte_fnv1a(donne_fichier_source(espace, it));
+            nom_fichier_c = enchaine(empreinte_chemin, "_", indice_fichier_c_pour_source);
+            indice_fichier_c_pour_source += 1;
+            if (fin_fichier_source) {
+                indice_fichier_c_pour_source = 0;
+            }
+        }
+
+        auto &fichier = ajoute_fichier_c(espace.nom, false, nom_fichier_c);
         fichier.fonctions = fonctions_du_fichier;
 
         nombre_instructions = 0;
@@ -2955,11 +3235,58 @@ void CoulisseC::crée_fichiers(const ProgrammeRepreInter &repr_inter, EspaceDeTr
     }
 }
 
-CoulisseC::FichierC &CoulisseC::ajoute_fichier_c(kuri::chaine_statique nom_espace, bool entête)
+void CoulisseC::trie_fonctions_par_fichier_source(
+    EspaceDeTravail const &espace, kuri::tableau_statique<AtomeFonction *> fonctions)
+{
+    struct FonctionÀTrier {
+        kuri::chaine_statique chemin{};
+        int ligne = 0;
+        int colonne = 0;
+        AtomeFonction *fonction = nullptr;
+    };
+
+    kuri::tableau<FonctionÀTrier> fonctions_à_trier;
+    fonctions_à_trier.réserve(fonctions.taille());
+    POUR (fonctions) {
+        auto fonction_à_trier = FonctionÀTrier{donne_fichier_source(espace, it), 0, 0, it};
+        if (it->decl && it->decl->lexème) {
+            fonction_à_trier.ligne = it->decl->lexème->ligne;
+            fonction_à_trier.colonne = it->decl->lexème->colonne;
+        }
+        fonctions_à_trier.ajoute(fonction_à_trier);
+    }
+
+    /* Trie également selon la position de la déclaration, afin que le code généré pour un
+     * fichier source ne dépende pas de l'ordre dans lequel ses fonctions furent compilées. Le tri
+     * est stable afin de préserver l'ordre des fonctions d'une même déclaration (p.e. les
+     * monomorphisations). */
+    std::stable_sort(fonctions_à_trier.begin(),
+                     fonctions_à_trier.end(),
+                     [](FonctionÀTrier const &a, FonctionÀTrier const &b) {
+                         if (a.chemin != b.chemin) {
+                             return a.chemin < b.chemin;
+                         }
+                         if (a.ligne != b.ligne) {
+                             return a.ligne < b.ligne;
+                         }
+                         return a.colonne < b.colonne;
+                     });
+
+    m_fonctions_par_fichier_source.efface();
+    m_fonctions_par_fichier_source.réserve(fonctions.taille());
+    POUR (fonctions_à_trier) {
+        m_fonctions_par_fichier_source.ajoute(it.fonction);
+    }
+}
+
+CoulisseC::FichierC &CoulisseC::ajoute_fichier_c(kuri::chaine_statique nom_espace,
+                                                 bool entête,
+                                                 kuri::chaine_statique nom)
 {
     kuri::chaine nom_fichier;
     kuri::chaine nom_fichier_objet;
     kuri::chaine nom_fichier_erreur;
+    kuri::chaine nom_fichier_empreinte;
 
     if (entête) {
         auto nom_entête = enchaine("kuri-", nom_espace, "/compilation_kuri.h");
@@ -2967,14 +3294,18 @@ CoulisseC::FichierC &CoulisseC::ajoute_fichier_c(kuri::chaine_statique nom_espac
     }
     else {
         auto nom_base_fichier = kuri::chemin_systeme::chemin_temporaire(
-            enchaine("kuri-", nom_espace, "/compilation_kuri", m_fichiers.taille()));
+            nom.taille() != 0 ?
+                enchaine("kuri-", nom_espace, "/compilation_kuri_", nom) :
+                enchaine("kuri-", nom_espace, "/compilation_kuri", m_fichiers.taille()));
 
         nom_fichier = enchaine(nom_base_fichier, ".c");
         nom_fichier_objet = nom_fichier_objet_pour(nom_base_fichier);
         nom_fichier_erreur = enchaine(nom_base_fichier, "_erreur.txt");
+        nom_fichier_empreinte = enchaine(nom_base_fichier, ".empreinte");
     }
 
-    FichierC résultat = {nom_fichier, nom_fichier_objet, nom_fichier_erreur};
+    FichierC résultat = {
+        nom_fichier, nom_fichier_objet, nom_fichier_erreur, nom_fichier_empreinte};
     résultat.est_entête = entête;
     m_fichiers.ajoute(résultat);
     return m_fichiers.dernier_élément();
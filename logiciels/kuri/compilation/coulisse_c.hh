@@ -21,6 +21,11 @@ struct CoulisseC final : public Coulisse {
         kuri::chaine chemin_fichier{};
         kuri::chaine chemin_fichier_objet{};
         kuri::chaine chemin_fichier_erreur_objet{};
+        kuri::chaine chemin_fichier_empreinte{};
+
+        /* Empreinte du code du fichier et de celui de l'entête, pour la compilation
+         * incrémentale. */
+        uint64_t empreinte = 0;
 
         const DonnéesConstantes *données_constantes = nullptr;
         kuri::tableau_statique<Type *> types{};
@@ -34,6 +39,11 @@ struct CoulisseC final : public Coulisse {
   private:
     kuri::tableau<FichierC> m_fichiers{};
 
+    /* Pour la compilation incrémentale, les fonctions horslignées sont groupées selon leurs
+     * fichiers sources, afin qu'une modification d'un fichier source ne change que les fichiers
+     * C contenant ses fonctions. */
+    kuri::tableau<AtomeFonction *> m_fonctions_par_fichier_source{};
+
     int64_t m_mémoire_génératrice = 0;
 
     std::optional<ErreurCoulisse> génère_code_impl(ArgsGénérationCode const &args) override;
@@ -47,5 +57,11 @@ struct CoulisseC final : public Coulisse {
 
     void crée_fichiers(ProgrammeRepreInter const &repr_inter, const EspaceDeTravail &espace);
 
-    FichierC &ajoute_fichier_c(kuri::chaine_statique nom_espace, bool entête);
+    /* Si nom n'est pas vide, il remplace l'indice du fichier dans le nom de celui-ci. */
+    FichierC &ajoute_fichier_c(kuri::chaine_statique nom_espace,
+                               bool entête,
+                               kuri::chaine_statique nom = "");
+
+    void trie_fonctions_par_fichier_source(EspaceDeTravail const &espace,
+                                           kuri::tableau_statique<AtomeFonction *> fonctions);
 };
@@ -3573,9 +3573,74 @@ CoulisseLLVM::~CoulisseLLVM()
     POUR (m_modules) {
         delete it->module;
         delete it->contexte_llvm;
+        delete it->machine_cible;
         mémoire::déloge("DonnéesModule", it);
     }
-    delete m_machine_cible;
+}
+
+static int64_t donne_nombre_fils_génération()
+{
+    return std::max(int64_t(1), int64_t(std::thread::hardware_concurrency()));
+}
+
+static std::optional<llvm::OptimizationLevel> donne_niveau_optimisation_llvm(
+    NiveauOptimisation niveau)
+{
+    switch (niveau) {
+        case NiveauOptimisation::AUCUN:
+        case NiveauOptimisation::O0:
+        {
+            return {};
+        }
+        case NiveauOptimisation::O1:
+        {
+            return llvm::OptimizationLevel::O1;
+        }
+        case NiveauOptimisation::O2:
+        {
+            return llvm::OptimizationLevel::O2;
+        }
+        case NiveauOptimisation::Os:
+        {
+            return llvm::OptimizationLevel::Os;
+        }
+        case NiveauOptimisation::Oz:
+        {
+            return llvm::OptimizationLevel::Oz;
+        }
+        case NiveauOptimisation::O3:
+        {
+            return llvm::OptimizationLevel::O3;
+        }
+    }
+
+    return {};
+}
+
+/* Exécute le pipeline d'optimisation par défaut de LLVM sur le module. Chaque appel crée ses
+ * propres gestionnaires d'analyses, ce qui permet d'optimiser plusieurs modules en parallèle. */
+static void optimise_module(DonnéesModule &module, OptionsDeCompilation const &options)
+{
+    auto niveau = donne_niveau_optimisation_llvm(options.niveau_optimisation);
+    if (!niveau.has_value()) {
+        return;
+    }
+
+    llvm::LoopAnalysisManager gestionnaire_boucles;
+    llvm::FunctionAnalysisManager gestionnaire_fonctions;
+    llvm::CGSCCAnalysisManager gestionnaire_cgscc;
+    llvm::ModuleAnalysisManager gestionnaire_modules;
+
+    llvm::PassBuilder builder(module.machine_cible);
+    builder.registerModuleAnalyses(gestionnaire_modules);
+    builder.registerCGSCCAnalyses(gestionnaire_cgscc);
+    builder.registerFunctionAnalyses(gestionnaire_fonctions);
+    builder.registerLoopAnalyses(gestionnaire_boucles);
+    builder.crossRegisterProxies(
+        gestionnaire_boucles, gestionnaire_fonctions, gestionnaire_cgscc, gestionnaire_modules);
+
+    auto passes = builder.buildPerModuleDefaultPipeline(niveau.value());
+    passes.run(*module.module, gestionnaire_modules);
 }
 
 std::optional<ErreurCoulisse> CoulisseLLVM::génère_code_impl(const ArgsGénérationCode &args)
@@ -3613,31 +3678,57 @@ std::optional<ErreurCoulisse> CoulisseLLVM::génère_code_impl(const ArgsGénér
         return ErreurCoulisse{message_erreur};
     }
 
-    auto CPU = "generic";
-    auto feature = "";
-    auto options_cible = llvm::TargetOptions{};
-    auto RM = std::optional<llvm::Reloc::Model>(llvm::Reloc::PIC_);
-    m_machine_cible = cible->createTargetMachine(triplet_cible, CPU, feature, options_cible, RM);
+    m_cible = cible;
 
     crée_modules(repr_inter, triplet_cible, espace.options);
 
-    POUR (m_modules) {
-        auto generatrice = GénératriceCodeLLVM(espace, *it);
-        generatrice.génère_code();
-    }
+    /* Chaque module possède son propre contexte LLVM : ils peuvent être générés, validés, et
+     * optimisés indépendamment les uns des autres. Les fonctions de la RI ne sont numérotées que
+     * par le module les définissant. */
+    auto const nombre_fils = std::min(donne_nombre_fils_génération(), m_modules.taille());
+    std::atomic<int64_t> indice_module_suivant = 0;
+
+    auto poule_de_tâches = kuri::PouleDeTâchesMoultFils{};
+    for (int64_t i = 0; i < nombre_fils; i++) {
+        poule_de_tâches.ajoute_tâche([&]() {
+            while (true) {
+                auto const indice = indice_module_suivant.fetch_add(1);
+                if (indice >= m_modules.taille()) {
+                    break;
+                }
+
+                auto module = m_modules[indice];
+
+                {
+                    auto génératrice = GénératriceCodeLLVM(espace, *module);
+                    génératrice.génère_code();
+                }
 
-    if (espace.options.valide_ir_llvm) {
-        POUR_INDICE (m_modules) {
-            auto opt_erreur_validation = valide_llvm_ir(
-                *it->module, indice_it, compilatrice->arguments.verbeux);
-            if (opt_erreur_validation.has_value()) {
-                auto erreur_validation = opt_erreur_validation.value();
-                auto message_erreur = enchaine("Erreur lors de la validation du code LLVM.\n",
-                                               "La commande a retourné :\n\n",
-                                               erreur_validation.message);
-                return ErreurCoulisse{message_erreur};
+                if (espace.options.valide_ir_llvm) {
+                    auto opt_erreur_validation = valide_llvm_ir(
+                        *module->module, indice, compilatrice->arguments.verbeux);
+                    if (opt_erreur_validation.has_value()) {
+                        module->erreur_génération = enchaine(
+                            "Erreur lors de la validation du code LLVM.\n",
+                            "La commande a retourné :\n\n",
+                            opt_erreur_validation.value().message);
+                        continue;
+                    }
+                }
+
+                optimise_module(*module, espace.options);
             }
+        });
+    }
+
+    static_cast<void>(poule_de_tâches.attends_sur_tâches());
+
+    POUR (m_modules) {
+        if (it->erreur_génération.taille() == 0) {
+            continue;
         }
+
+        return ErreurCoulisse{it->erreur_génération};
     }
 
     return {};
@@ -3649,11 +3740,9 @@ std::optional<ErreurCoulisse> CoulisseLLVM::crée_fichier_objet_impl(
 #ifndef NDEBUG
     auto poule_de_tâches = kuri::PouleDeTâchesEnSérie{};
 #else
-#    if 0
+    /* Chaque module ayant sa propre machine cible, les fichiers objets peuvent être émis dans des
+     * fils d'exécution. */
     auto poule_de_tâches = kuri::PouleDeTâchesMoultFils{};
-#    else
-    auto poule_de_tâches = kuri::PouleDeTâchesSousProcessus{};
-#    endif
 #endif
 
     POUR (m_modules) {
@@ -3809,7 +3898,8 @@ void CoulisseLLVM::crée_fichier_objet(DonnéesModule *module, OptionsDeCompilat
 
     auto type_fichier = llvm::CodeGenFileType::ObjectFile;
 
-    if (m_machine_cible->addPassesToEmitFile(passes_pour_modules, dest, nullptr, type_fichier)) {
+    auto machine_cible = module->machine_cible;
+    if (machine_cible->addPassesToEmitFile(passes_pour_modules, dest, nullptr, type_fichier)) {
         module->erreur_fichier_objet = "La machine cible ne peut pas émettre ce type de fichier";
         return;
     }
@@ -3850,9 +3940,23 @@ void CoulisseLLVM::crée_modules(const ProgrammeRepreInter &repr_inter,
         module->définis_fonctions(fonctions);
     }
     else {
-        /* Crée des modules pour les fonctions. */
-        constexpr int nombre_instructions_par_module = 20000;
-        int nombre_instructions = 0;
+        /* Crée des modules pour les fonctions : autant que de fils d'exécution, afin que chacun
+         * ait un module à générer et à optimiser, sans pour autant créer des modules trop petits
+         * pour valoir le coût d'un fichier objet. Les fonctions sont réparties selon leurs nombres
+         * d'instructions pour équilibrer la charge des fils. */
+        constexpr int64_t nombre_instructions_minimum_par_module = 20000;
+        int64_t nombre_instructions_total = 0;
+        POUR (fonctions) {
+            nombre_instructions_total += it->nombre_d_instructions_avec_entrées_sorties();
+        }
+
+        auto const nombre_modules = std::clamp(nombre_instructions_total /
+                                                   nombre_instructions_minimum_par_module,
+                                               int64_t(1),
+                                               donne_nombre_fils_génération());
+        auto const nombre_instructions_par_module = nombre_instructions_total / nombre_modules;
+
+        int64_t nombre_instructions = 0;
         int index_première_fonction = 0;
         for (int i = 0; i < fonctions.taille(); i++) {
             auto fonction = fonctions[i];
@@ -3890,12 +3994,19 @@ DonnéesModule *CoulisseLLVM::crée_un_module(kuri::chaine_statique nom,
 {
     auto résultat = mémoire::loge<DonnéesModule>("DonnéesModule");
     résultat->contexte_llvm = new llvm::LLVMContext;
+
+    auto CPU = "generic";
+    auto feature = "";
+    auto options_cible = llvm::TargetOptions{};
+    auto RM = std::optional<llvm::Reloc::Model>(llvm::Reloc::PIC_);
+    résultat->machine_cible = m_cible->createTargetMachine(
+        triplet_cible, CPU, feature, options_cible, RM);
     résultat->le_module_est_unique = !options.parallélise_llvm;
 
     auto nom_module = enchaine(nom, m_modules.taille());
 
     résultat->module = new llvm::Module(vers_string_ref(nom_module), *résultat->contexte_llvm);
-    résultat->module->setDataLayout(m_machine_cible->createDataLayout());
+    résultat->module->setDataLayout(résultat->machine_cible->createDataLayout());
     résultat->module->setTargetTriple(triplet_cible);
     résultat->module->addModuleFlag(llvm::Module::Error, "wchar_size", 4);
     résultat->module->setPICLevel(llvm::PICLevel::BigPIC);
@@ -3922,7 +4033,9 @@ int64_t CoulisseLLVM::mémoire_utilisée() const
     POUR (m_modules) {
         résultat += taille_de(llvm::LLVMContext);
         résultat += taille_de(llvm::Module);
+        résultat += taille_de(llvm::TargetMachine);
         résultat += it->chemin_fichier_objet.taille();
+        résultat += it->erreur_génération.taille();
         résultat += it->erreur_fichier_objet.taille();
     }
 
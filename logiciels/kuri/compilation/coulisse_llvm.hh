@@ -20,6 +20,7 @@ struct ProgrammeRepreInter;
 namespace llvm {
 class LLVMContext;
 class Module;
+class Target;
 class TargetMachine;
 }  // namespace llvm
 
@@ -27,9 +28,13 @@ class TargetMachine;
 /** \name DonnéesModule
  * \{ */
 
+/* Les modules sont générés, optimisés, et émis chacun dans leur propre fil d'exécution : chacun
+ * possède donc son contexte et sa machine cible, LLVM ne permettant pas de les partager entre
+ * plusieurs fils. */
 struct DonnéesModule {
     llvm::LLVMContext *contexte_llvm = nullptr;
     llvm::Module *module = nullptr;
+    llvm::TargetMachine *machine_cible = nullptr;
     AtomeFonction *intrinsèque_est_adresse_données_constantes = nullptr;
 
     kuri::chemin_systeme chemin_fichier_objet{};
@@ -45,6 +50,7 @@ struct DonnéesModule {
     kuri::ensemble<AtomeGlobale const *> m_ensemble_globales{};
 
   public:
+    kuri::chaine erreur_génération{};
     kuri::chaine erreur_fichier_objet{};
 
     void définis_données_constantes(const DonnéesConstantes *données_constantes);
@@ -66,7 +72,7 @@ struct DonnéesModule {
 
 struct CoulisseLLVM final : public Coulisse {
   private:
-    llvm::TargetMachine *m_machine_cible = nullptr;
+    llvm::Target const *m_cible = nullptr;
 
     kuri::tableau<DonnéesModule *> m_modules{};
 
@@ -249,6 +249,24 @@ bool EspaceDeTravail::peut_génèrer_code_final() const
     return false;
 }
 
+void EspaceDeTravail::libère_ri_fonctions()
+{
+    if (NOMBRE_DE_TACHES(EXECUTION) != 0) {
+        return;
+    }
+
+    registre_ri->libère_ri_fonctions();
+}
+
+void EspaceDeTravail::libère_ri_fonction(AtomeFonction *fonction)
+{
+    if (fonction->données_exécution && NOMBRE_DE_TACHES(EXECUTION) != 0) {
+        return;
+    }
+
+    registre_ri->libère_ri_fonction(fonction);
+}
+
 bool EspaceDeTravail::parsage_terminé() const
 {
     return NOMBRE_DE_TACHES(CHARGEMENT) == 0 && NOMBRE_DE_TACHES(LEXAGE) == 0 &&
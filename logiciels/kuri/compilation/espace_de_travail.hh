@@ -19,6 +19,7 @@
 
 #include "representation_intermediaire/constructrice_ri.hh"
 
+struct AtomeFonction;
 struct AtomeGlobale;
 struct Compilatrice;
 struct MétaProgramme;
@@ -35,11 +36,9 @@ struct UnitéCompilation;
  *
  * Problèmes :
  * - les modules ne sont ouvert qu'une seule fois
- * - il faudra stocker les modules pour chaque espace de travail, et partager les données
- * constantes des fichiers
- * - séparer les données constantes des données dynamiques
- * -- données constantes : tampon du fichier, lexèmes
- * -- données dynamiques : arbres syntaxiques, types, noeuds dépendances
+ * - les données constantes des fichiers (tampon du fichier, lexèmes) sont partagées via
+ * DonnéesConstantesFichier, mais les données dynamiques (arbres syntaxiques, types, noeuds
+ * dépendances) sont toujours propres à chaque espace
  */
 struct EspaceDeTravail {
   private:
@@ -171,6 +170,16 @@ struct EspaceDeTravail {
     bool peut_génèrer_code_final() const;
     bool parsage_terminé() const;
 
+    /* Libère les instructions des fonctions une fois le code final généré, sauf si un
+     * métaprogramme de l'espace est toujours en cours d'exécution : la MachineVirtuelle peut
+     * compiler à la volée ses fonctions depuis leurs RI. */
+    void libère_ri_fonctions();
+
+    /* Libère les instructions d'une fonction dont le code final vient d'être généré. La RI des
+     * fonctions ayant du code binaire est gardée tant qu'un métaprogramme de l'espace est en cours
+     * d'exécution, pour la même raison. */
+    void libère_ri_fonction(AtomeFonction *fonction);
+
     Message *change_de_phase(kuri::Synchrone<Messagère> &messagère,
                              PhaseCompilation nouvelle_phase,
                              kuri::chaine_statique fonction_appelante);
@@ -6,12 +6,14 @@
 #include <fcntl.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <unistd.h>
 
 #include "programme.hh"
 
 #include "representation_intermediaire/instructions.hh"
 
 #include "structures/chemin_systeme.hh"
+#include "structures/enchaineuse.hh"
 
 #include "utilitaires/log.hh"
 #include "utilitaires/logeuse_memoire.hh"
@@ -170,26 +172,97 @@ struct TableDeChaines {
     }
 };
 
+/* ------------------------------------------------------------------------- */
+/** \name SectionELF
+ * \{ */
+
+uint64_t SectionELF::donne_taille() const
+{
+    if (type == SHT_NOBITS) {
+        return taille_sans_données;
+    }
+    return uint64_t(données.taille());
+}
+
+void SectionELF::ajoute_octets(void const *octets, int64_t taille)
+{
+    auto const taille_courante = données.taille();
+    données.redimensionne(taille_courante + taille);
+    memcpy(données.données() + taille_courante, octets, size_t(taille));
+}
+
+void SectionELF::ajoute_zéros(uint64_t taille)
+{
+    if (type == SHT_NOBITS) {
+        taille_sans_données += taille;
+        return;
+    }
+
+    données.redimensionne(données.taille() + int64_t(taille), 0);
+}
+
+void SectionELF::aligne(uint64_t alignement_requis)
+{
+    if (alignement_requis <= 1) {
+        return;
+    }
+
+    alignement = std::max(alignement, alignement_requis);
+
+    auto const reste = donne_taille() % alignement_requis;
+    if (reste != 0) {
+        ajoute_zéros(alignement_requis - reste);
+    }
+}
+
+void SectionELF::remplace_octets(uint64_t décalage, void const *octets, int64_t taille)
+{
+    assert(int64_t(décalage) + taille <= données.taille());
+    memcpy(données.données() + décalage, octets, size_t(taille));
+}
+
+/** \} */
+
+/* ------------------------------------------------------------------------- */
+/** \name FichierELF
+ * \{ */
+
 FichierELF *FichierELF::crée_fichier_objet()
 {
     auto résultat = mémoire::loge<FichierELF>("FichierELF");
     résultat->crée_section("", SHT_NULL);
-    résultat->crée_section(".text", SHT_PROGBITS);
-    résultat->crée_section(".data", SHT_PROGBITS);
-    résultat->crée_section(".bss", SHT_NOBITS);
-    résultat->crée_section(".tbss", SHT_NOBITS);
-    résultat->crée_section(".rodata", SHT_PROGBITS);
-    résultat->crée_section(".data.rel.ro.local", SHT_PROGBITS);
-    résultat->crée_section(".rela.data.rel.ro.local", SHT_RELA);
-    résultat->crée_section(".comment", SHT_PROGBITS);
+
+    auto text = résultat->crée_section(".text", SHT_PROGBITS);
+    text->drapeaux = SHF_ALLOC | SHF_EXECINSTR;
+    text->alignement = 16;
+
+    auto data = résultat->crée_section(".data", SHT_PROGBITS);
+    data->drapeaux = SHF_ALLOC | SHF_WRITE;
+    data->alignement = 8;
+
+    auto bss = résultat->crée_section(".bss", SHT_NOBITS);
+    bss->drapeaux = SHF_ALLOC | SHF_WRITE;
+    bss->alignement = 8;
+
+    auto rodata = résultat->crée_section(".rodata", SHT_PROGBITS);
+    rodata->drapeaux = SHF_ALLOC;
+
+    /* Une section vide indique au lieur que la pile n'a pas besoin d'être exécutable. */
     résultat->crée_section(".note.GNU-stack", SHT_PROGBITS);
-    résultat->crée_section(".note.gnu.property", SHT_NOTE);
+
     résultat->crée_section(".symtab", SHT_SYMTAB);
     résultat->crée_section(".strtab", SHT_STRTAB);
     résultat->crée_section(".shstrtab", SHT_STRTAB);
     return résultat;
 }
 
+FichierELF::~FichierELF()
+{
+    POUR (m_sections) {
+        mémoire::déloge("SectionELF", it);
+    }
+}
+
 SectionELF *FichierELF::crée_section(kuri::chaine_statique nom, uint32_t type)
 {
     auto résultat = mémoire::loge<SectionELF>("SectionELF");
@@ -233,119 +306,289 @@ uint16_t FichierELF::donne_indice_section(kuri::chaine_statique nom) const
     return résultat;
 }
 
+uint16_t FichierELF::donne_indice_section(SectionELF const *section) const
+{
+    POUR_INDICE (m_sections) {
+        if (it == section) {
+            return uint16_t(indice_it);
+        }
+    }
+
+    assert(false);
+    return SHN_UNDEF;
+}
+
+int64_t FichierELF::ajoute_symbole(SymboleELF const &symbole)
+{
+    auto résultat = m_symboles.taille();
+    m_symboles.ajoute(symbole);
+    return résultat;
+}
+
+SymboleELF &FichierELF::donne_symbole(int64_t indice)
+{
+    return m_symboles[indice];
+}
+
 void FichierELF::écris_données_constantes(DonnéesConstantes const *données)
 {
-    m_données_constantes = données;
+    auto section_rodata = donne_section(".rodata");
+    section_rodata->aligne(données->alignement_désiré);
+
+    POUR (données->tableaux_constants) {
+        section_rodata->ajoute_zéros(uint64_t(it.rembourrage));
+
+        auto tableau = it.tableau->donne_données();
+        section_rodata->ajoute_octets(tableau.begin(), tableau.taille());
+    }
 }
 
-void FichierELF::écris_vers(kuri::chaine_statique chemin) const
+int64_t FichierELF::mémoire_utilisée() const
 {
-    auto fichier = FichierPagé{};
+    auto résultat = m_sections.taille_mémoire() + m_symboles.taille_mémoire();
+
+    POUR (m_sections) {
+        résultat += int64_t(sizeof(SectionELF));
+        résultat += it->nom.taille();
+        résultat += it->données.taille_mémoire();
+        résultat += it->relocations.taille_mémoire();
+    }
+
+    POUR (m_symboles) {
+        résultat += it.nom.taille();
+    }
+
+    return résultat;
+}
+
+template <typename T>
+static void ajoute_valeur(kuri::tableau<uint8_t> &tampon, T const &valeur)
+{
+    auto const taille_courante = tampon.taille();
+    tampon.redimensionne(taille_courante + int64_t(sizeof(T)));
+    memcpy(tampon.données() + taille_courante, &valeur, sizeof(T));
+}
+
+bool FichierELF::écris_vers(kuri::chaine_statique chemin) const
+{
+    /* Les symboles locaux doivent précéder les symboles globaux dans la table des symboles. Le
+     * premier symbole est le symbole nul. */
+    kuri::tableau<int64_t> indices_symboles(m_symboles.taille());
+    auto indice_symbole_courant = int64_t(1);
+    POUR_INDICE (m_symboles) {
+        if (it.liaison == STB_LOCAL) {
+            indices_symboles[indice_it] = indice_symbole_courant++;
+        }
+    }
+    auto const indice_premier_symbole_global = indice_symbole_courant;
+    POUR_INDICE (m_symboles) {
+        if (it.liaison != STB_LOCAL) {
+            indices_symboles[indice_it] = indice_symbole_courant++;
+        }
+    }
+
+    auto const indice_symtab = donne_indice_section(".symtab");
+    auto const indice_strtab = donne_indice_section(".strtab");
+    auto const indice_shstrtab = donne_indice_section(".shstrtab");
+
+    /* Table des chaines des symboles. */
+    auto table_noms_symboles = TableDeChaines{};
+    static_cast<void>(table_noms_symboles.ajoute_chaine(""));
+
+    /* Table des symboles. */
+    kuri::tableau<Elf64_Sym> symboles(indice_symbole_courant);
+    memset(symboles.données(), 0, size_t(symboles.taille()) * sizeof(Elf64_Sym));
+
+    POUR_INDICE (m_symboles) {
+        auto &symbole = symboles[indices_symboles[indice_it]];
+        symbole.st_name = Elf64_Word(table_noms_symboles.ajoute_chaine(it.nom));
+        symbole.st_info = uint8_t(ELF64_ST_INFO(it.liaison, it.type));
+        symbole.st_other = STV_DEFAULT;
+        symbole.st_shndx = it.section ? donne_indice_section(it.section) : Elf64_Half(SHN_UNDEF);
+        symbole.st_value = it.valeur;
+        symbole.st_size = it.taille;
+    }
+
+    /* Sections de relocations. */
+    struct SectionRelocations {
+        kuri::chaine nom{};
+        uint16_t indice_section_cible = 0;
+        kuri::tableau<uint8_t> données{};
+    };
+
+    kuri::tableau<SectionRelocations> sections_relocations;
+    POUR_INDICE (m_sections) {
+        if (it->relocations.est_vide()) {
+            continue;
+        }
+
+        auto section_relocations = SectionRelocations{};
+        section_relocations.nom = enchaine(".rela", it->nom);
+        section_relocations.indice_section_cible = uint16_t(indice_it);
+
+        POUR_NOMME (relocation, it->relocations) {
+            auto rela = Elf64_Rela{};
+            rela.r_offset = relocation.décalage;
+            rela.r_info = ELF64_R_INFO(
+                uint64_t(indices_symboles[relocation.indice_symbole]), relocation.type);
+            rela.r_addend = relocation.addend;
+            ajoute_valeur(section_relocations.données, rela);
+        }
+
+        sections_relocations.ajoute(section_relocations);
+    }
+
+    /* Table des noms des sections. */
     auto table_noms_entêtes_sections = TableDeChaines{};
+    auto nombre_de_sections = m_sections.taille() + sections_relocations.taille();
+    kuri::tableau<Elf64_Shdr> entêtes_sections(nombre_de_sections);
+    memset(entêtes_sections.données(), 0, size_t(nombre_de_sections) * sizeof(Elf64_Shdr));
+
+    POUR_INDICE (m_sections) {
+        auto &entête = entêtes_sections[indice_it];
+        entête.sh_name = Elf64_Word(table_noms_entêtes_sections.ajoute_chaine(it->nom));
+        entête.sh_type = it->type;
+        entête.sh_flags = it->drapeaux;
+        entête.sh_size = it->donne_taille();
+        entête.sh_addralign = it->alignement;
+    }
+
+    POUR_INDICE (sections_relocations) {
+        auto &entête = entêtes_sections[m_sections.taille() + indice_it];
+        entête.sh_name = Elf64_Word(table_noms_entêtes_sections.ajoute_chaine(it.nom));
+        entête.sh_type = SHT_RELA;
+        entête.sh_flags = SHF_INFO_LINK;
+        entête.sh_size = uint64_t(it.données.taille());
+        entête.sh_link = indice_symtab;
+        entête.sh_info = it.indice_section_cible;
+        entête.sh_addralign = 8;
+        entête.sh_entsize = sizeof(Elf64_Rela);
+    }
+
+    auto &entête_symtab = entêtes_sections[indice_symtab];
+    entête_symtab.sh_size = uint64_t(symboles.taille()) * sizeof(Elf64_Sym);
+    entête_symtab.sh_link = indice_strtab;
+    entête_symtab.sh_info = Elf64_Word(indice_premier_symbole_global);
+    entête_symtab.sh_addralign = 8;
+    entête_symtab.sh_entsize = sizeof(Elf64_Sym);
+
+    auto &entête_strtab = entêtes_sections[indice_strtab];
+    entête_strtab.sh_size = table_noms_symboles.donne_taille();
+    entête_strtab.sh_addralign = 1;
+
+    auto &entête_shstrtab = entêtes_sections[indice_shstrtab];
+    entête_shstrtab.sh_size = table_noms_entêtes_sections.donne_taille();
+    entête_shstrtab.sh_addralign = 1;
 
     /* Entête fichier. */
-    auto entête_fichier = fichier.loge_en_un_seul_morceau<Elf64_Ehdr>();
-
-    entête_fichier->e_ident[EI_MAG0] = ELFMAG0;
-    entête_fichier->e_ident[EI_MAG1] = ELFMAG1;
-    entête_fichier->e_ident[EI_MAG2] = ELFMAG2;
-    entête_fichier->e_ident[EI_MAG3] = ELFMAG3;
-    entête_fichier->e_ident[EI_CLASS] = ELFCLASS64;
-    entête_fichier->e_ident[EI_DATA] = ELFDATA2LSB;
-    entête_fichier->e_ident[EI_VERSION] = EV_CURRENT;
-    entête_fichier->e_ident[EI_OSABI] = ELFOSABI_SYSV;
-    entête_fichier->e_ident[EI_ABIVERSION] = 0;
+    auto entête_fichier = Elf64_Ehdr{};
+    entête_fichier.e_ident[EI_MAG0] = ELFMAG0;
+    entête_fichier.e_ident[EI_MAG1] = ELFMAG1;
+    entête_fichier.e_ident[EI_MAG2] = ELFMAG2;
+    entête_fichier.e_ident[EI_MAG3] = ELFMAG3;
+    entête_fichier.e_ident[EI_CLASS] = ELFCLASS64;
+    entête_fichier.e_ident[EI_DATA] = ELFDATA2LSB;
+    entête_fichier.e_ident[EI_VERSION] = EV_CURRENT;
+    entête_fichier.e_ident[EI_OSABI] = ELFOSABI_SYSV;
+    entête_fichier.e_ident[EI_ABIVERSION] = 0;
     for (int i = EI_PAD; i < EI_NIDENT; i++) {
-        entête_fichier->e_ident[i] = 0;
-    }
-
-    // À FAIRE : détermine ceci lors de la création.
-    entête_fichier->e_type = ET_REL;
-    entête_fichier->e_machine = EM_X86_64;
-    entête_fichier->e_version = EV_CURRENT;
-    entête_fichier->e_entry = 0;
-    // À FAIRE : détermine ceci.
-    entête_fichier->e_phoff = 0;
-    entête_fichier->e_flags = 0;
-    entête_fichier->e_ehsize = sizeof(Elf64_Ehdr);
-    // À FAIRE : détermine ceci.
-    entête_fichier->e_phentsize = 0;
-    // À FAIRE : détermine ceci.
-    entête_fichier->e_phnum = 0;
-    entête_fichier->e_shentsize = sizeof(Elf64_Shdr);
-    entête_fichier->e_shnum = Elf64_Half(m_sections.taille());
-    entête_fichier->e_shstrndx = donne_indice_section(".shstrtab");
+        entête_fichier.e_ident[i] = 0;
+    }
 
-    /* Entêtes sections. */
-    entête_fichier->e_shoff = fichier.donne_taille();
+    entête_fichier.e_type = ET_REL;
+    entête_fichier.e_machine = EM_X86_64;
+    entête_fichier.e_version = EV_CURRENT;
+    entête_fichier.e_entry = 0;
+    entête_fichier.e_phoff = 0;
+    entête_fichier.e_flags = 0;
+    entête_fichier.e_ehsize = sizeof(Elf64_Ehdr);
+    entête_fichier.e_phentsize = 0;
+    entête_fichier.e_phnum = 0;
+    entête_fichier.e_shentsize = sizeof(Elf64_Shdr);
+    entête_fichier.e_shnum = Elf64_Half(nombre_de_sections);
+    entête_fichier.e_shstrndx = indice_shstrtab;
 
-    POUR (m_sections) {
-        auto entête_section = fichier.loge_en_un_seul_morceau<Elf64_Shdr>();
-        entête_section->sh_name = Elf64_Word(table_noms_entêtes_sections.ajoute_chaine(it->nom));
-        entête_section->sh_type = it->type;
-        entête_section->sh_flags = 0;
-        entête_section->sh_addr = 0;
-        entête_section->sh_offset = 0;
-        entête_section->sh_size = 0;
-        entête_section->sh_link = 0;
-        entête_section->sh_info = 0;
-        entête_section->sh_addralign = 0;
-        entête_section->sh_entsize = 0;
+    auto fichier = FichierPagé{};
 
-        it->entête = entête_section;
-    }
+    auto écris_octets = [&](void const *octets, uint64_t taille) {
+        auto pointeur = const_cast<char *>(static_cast<char const *>(octets));
+        fichier.écris(kuri::tableau_statique<char>(pointeur, int64_t(taille)));
+    };
 
-    auto section_shstrtab = donne_section(".shstrtab");
-    section_shstrtab->entête->sh_size = table_noms_entêtes_sections.donne_taille();
-    section_shstrtab->entête->sh_addralign = 1;
+    auto écris_contenu_section = [&](Elf64_Shdr &entête, void const *octets, uint64_t taille) {
+        auto const alignement = std::max(entête.sh_addralign, uint64_t(1));
+        while ((fichier.donne_taille() % alignement) != 0) {
+            fichier.écris_octet(0x0);
+        }
 
-    if (m_données_constantes) {
-        auto section_rodata = donne_section(".rodata");
-        section_rodata->entête->sh_size = Elf64_Xword(
-            m_données_constantes->taille_données_tableaux_constants);
-        section_rodata->entête->sh_addralign = m_données_constantes->alignement_désiré;
-    }
+        entête.sh_offset = fichier.donne_taille();
+        écris_octets(octets, taille);
+    };
 
-    auto décalage_section = fichier.donne_taille();
+    /* L'entête du fichier est réécris une fois le décalage des entêtes des sections connu. */
+    écris_octets(&entête_fichier, sizeof(Elf64_Ehdr));
 
     /* Sections. */
-    POUR (m_sections) {
-        it->entête->sh_offset = décalage_section;
-        décalage_section += it->entête->sh_size;
-
-        dbg() << it->nom << ", taille " << it->entête->sh_size << ", décalage "
-              << it->entête->sh_offset;
+    POUR_INDICE (m_sections) {
+        auto &entête = entêtes_sections[indice_it];
 
-        if (it->nom == ".shstrtab") {
-            POUR_NOMME (chaine, table_noms_entêtes_sections.chaines()) {
+        if (indice_it == indice_symtab) {
+            écris_contenu_section(entête, symboles.données(), entête.sh_size);
+        }
+        else if (indice_it == indice_strtab) {
+            entête.sh_offset = fichier.donne_taille();
+            POUR_NOMME (chaine, table_noms_symboles.chaines()) {
                 fichier.écris(chaine, true);
             }
         }
-        else if (it->nom == ".rodata" && m_données_constantes) {
-            POUR_NOMME (tableau_constant, m_données_constantes->tableaux_constants) {
-                for (auto i = 0; i < tableau_constant.rembourrage; i++) {
-                    fichier.écris_octet(0x0);
-                }
-
-                auto tableau = tableau_constant.tableau->donne_données();
-                fichier.écris(tableau);
+        else if (indice_it == indice_shstrtab) {
+            entête.sh_offset = fichier.donne_taille();
+            POUR_NOMME (chaine, table_noms_entêtes_sections.chaines()) {
+                fichier.écris(chaine, true);
             }
         }
+        else if (it->type == SHT_NOBITS) {
+            entête.sh_offset = fichier.donne_taille();
+        }
+        else {
+            écris_contenu_section(entête, it->données.begin(), entête.sh_size);
+        }
     }
 
+    POUR_INDICE (sections_relocations) {
+        auto &entête = entêtes_sections[m_sections.taille() + indice_it];
+        écris_contenu_section(entête, it.données.begin(), entête.sh_size);
+    }
+
+    /* Entêtes sections. */
+    while ((fichier.donne_taille() % 8) != 0) {
+        fichier.écris_octet(0x0);
+    }
+
+    entête_fichier.e_shoff = fichier.donne_taille();
+    écris_octets(entêtes_sections.données(),
+                 uint64_t(entêtes_sections.taille()) * sizeof(Elf64_Shdr));
+    memcpy(fichier.pages()[0].données, &entête_fichier, sizeof(Elf64_Ehdr));
+
     /* Écriture du fichier. */
     auto std_path = vers_std_path(chemin);
     auto fd = open(std_path.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0644);
-    if (fd != -1) {
-        POUR (fichier.pages()) {
-            auto octets_écris = write(fd, it.données, it.occupé);
-            assert(octets_écris == it.occupé);
-            dbg() << "Écris " << octets_écris << " octets";
-        }
-
-        close(fd);
+    if (fd == -1) {
+        return false;
     }
-    else {
-        perror("open");
+
+    auto résultat = true;
+
+    POUR (fichier.pages()) {
+        auto octets_écris = write(fd, it.données, it.occupé);
+        if (octets_écris != int64_t(it.occupé)) {
+            résultat = false;
+            break;
+        }
     }
+
+    close(fd);
+    return résultat;
 }
+
+/** \} */
@@ -8,27 +8,87 @@
 #include "structures/chaine.hh"
 #include "structures/tableau.hh"
 
+#include "utilitaires/macros.hh"
+
 struct DonnéesConstantes;
 
+struct RelocationELF {
+    uint64_t décalage = 0;
+    int64_t indice_symbole = 0;
+    uint32_t type = R_X86_64_NONE;
+    int64_t addend = 0;
+};
+
 struct SectionELF {
     kuri::chaine nom{};
     uint32_t type{};
+    uint64_t drapeaux = 0;
+    uint64_t alignement = 1;
+
+    /* Le contenu de la section, sauf pour les sections SHT_NOBITS dont seule la taille est
+     * connue. */
+    kuri::tableau<uint8_t> données{};
+    uint64_t taille_sans_données = 0;
+
+    kuri::tableau<RelocationELF> relocations{};
+
+    uint64_t donne_taille() const;
+
+    void ajoute_octets(void const *octets, int64_t taille);
+
+    template <typename T>
+    void ajoute_valeur(T valeur)
+    {
+        ajoute_octets(&valeur, sizeof(T));
+    }
+
+    void ajoute_zéros(uint64_t taille);
+
+    /* Ajoute des zéros (ou réserve de l'espace pour les sections SHT_NOBITS) afin que la taille
+     * de la section soit un multiple de l'alignement donné. */
+    void aligne(uint64_t alignement_requis);
 
-    Elf64_Shdr *entête = nullptr;
+    /* Remplace les octets à partir du décalage donné, pour résoudre les références locales. */
+    void remplace_octets(uint64_t décalage, void const *octets, int64_t taille);
+};
+
+struct SymboleELF {
+    kuri::chaine nom{};
+    /* Nul si le symbole n'est pas défini dans le fichier. */
+    SectionELF const *section = nullptr;
+    uint64_t valeur = 0;
+    uint64_t taille = 0;
+    uint8_t type = STT_NOTYPE;
+    uint8_t liaison = STB_GLOBAL;
 };
 
 class FichierELF {
     kuri::tableau<SectionELF *> m_sections{};
-    DonnéesConstantes const *m_données_constantes = nullptr;
+    kuri::tableau<SymboleELF> m_symboles{};
 
   public:
     static FichierELF *crée_fichier_objet();
 
+    FichierELF() = default;
+
+    EMPECHE_COPIE(FichierELF);
+
+    ~FichierELF();
+
     SectionELF *crée_section(kuri::chaine_statique nom, uint32_t type);
     SectionELF *donne_section(kuri::chaine_statique nom) const;
     uint16_t donne_indice_section(kuri::chaine_statique nom) const;
 
+    /* Retourne l'indice du symbole ajouté, à utiliser pour les relocations. */
+    int64_t ajoute_symbole(SymboleELF const &symbole);
+    SymboleELF &donne_symbole(int64_t indice);
+
     void écris_données_constantes(DonnéesConstantes const *données);
 
-    void écris_vers(kuri::chaine_statique chemin) const;
+    int64_t mémoire_utilisée() const;
+
+    bool écris_vers(kuri::chaine_statique chemin) const;
+
+  private:
+    uint16_t donne_indice_section(SectionELF const *section) const;
 };
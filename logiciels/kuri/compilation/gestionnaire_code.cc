@@ -1045,7 +1045,7 @@ MétaProgramme *GestionnaireCode::crée_métaprogramme_corps_texte(EspaceDeTrava
                                     DrapeauxNoeudFonction::FUT_GÉNÉRÉE_PAR_LA_COMPILATRICE);
 
     auto decl_sortie = m_assembleuse->crée_déclaration_variable(lexème, nullptr, nullptr);
-    decl_sortie->ident = m_compilatrice->table_identifiants->identifiant_pour_chaine("__ret0");
+    decl_sortie->ident = m_compilatrice->table_identifiants.identifiant_pour_chaine("__ret0");
     decl_sortie->type = espace->typeuse.type_chaine;
     decl_sortie->drapeaux |= DrapeauxNoeud::DECLARATION_FUT_VALIDEE;
 
@@ -1528,6 +1528,7 @@ NoeudBloc *GestionnaireCode::crée_bloc_racine(Typeuse &typeuse)
 
 #undef CREE_DECLARATION_TYPE_PLATEFORME
 
+    résultat->publie_index_rubriques();
     return résultat;
 }
 
@@ -1581,6 +1582,7 @@ void GestionnaireCode::mets_en_attente(UnitéCompilation *unité_attendante, Att
     auto espace = unité_attendante->espace;
     ajoute_requêtes_pour_attente(espace, attente);
     unité_attendante->ajoute_attente(attente);
+    trace_attente(unité_attendante, attente);
     ajoute_unité_à_liste_attente(unité_attendante);
 }
 
@@ -1595,11 +1597,22 @@ void GestionnaireCode::mets_en_attente(UnitéCompilation *unité_attendante,
     POUR (attentes) {
         ajoute_requêtes_pour_attente(espace, it);
         unité_attendante->ajoute_attente(it);
+        trace_attente(unité_attendante, it);
     }
 
     ajoute_unité_à_liste_attente(unité_attendante);
 }
 
+void GestionnaireCode::trace_attente(UnitéCompilation const *unité, Attente const &attente)
+{
+    if (!m_compilatrice || !m_compilatrice->trace_tâches_active()) {
+        return;
+    }
+
+    m_attentes_tracées.ajoute(
+        crée_événement_attente(unité, attente, m_compilatrice->horloge_trace));
+}
+
 void GestionnaireCode::tâche_unité_terminée(UnitéCompilation *unité)
 {
 #ifdef TEMPORISE_UNITES_POUR_SIMULER_MOULTFILAGE
@@ -2047,6 +2060,7 @@ void GestionnaireCode::typage_terminé(UnitéCompilation *unité)
             POUR (*bloc->rubriques.verrou_écriture()) {
                 bloc_parent->ajoute_rubrique(it);
             }
+            bloc_parent->publie_index_rubriques();
             POUR (*bloc->expressions.verrou_écriture()) {
                 ajoute_noeud_de_haut_niveau(it, espace, fichier);
             }
@@ -2144,6 +2158,14 @@ void GestionnaireCode::execution_terminée(UnitéCompilation *unité)
     auto espace = unité->espace;
     TACHE_TERMINEE(EXECUTION);
     enleve_programme(unité->métaprogramme->programme);
+
+    /* Le dernier métaprogramme de l'espace peut se terminer après le code final, par exemple
+     * celui interceptant les messages de l'espace : libère la RI qui fut gardée pour lui. */
+    if (espace->phase_courante() == PhaseCompilation::COMPILATION_TERMINÉE &&
+        espace->options.résultat != RésultatCompilation::RIEN) {
+        espace->libère_ri_fonctions();
+    }
+
     unité->définis_état(UnitéCompilation::État::COMPILATION_TERMINÉE);
 }
 
@@ -2188,6 +2210,7 @@ void GestionnaireCode::generation_code_machine_terminée(UnitéCompilation *unit
         else {
             espace->change_de_phase(
                 m_compilatrice->messagère, PhaseCompilation::COMPILATION_TERMINÉE, __func__);
+            espace->libère_ri_fonctions();
         }
     }
 
@@ -2211,6 +2234,7 @@ void GestionnaireCode::liaison_programme_terminée(UnitéCompilation *unité)
         TACHE_TERMINEE(LIAISON_PROGRAMME);
         espace->change_de_phase(
             m_compilatrice->messagère, PhaseCompilation::COMPILATION_TERMINÉE, __func__);
+        espace->libère_ri_fonctions();
     }
 
     unité->définis_état(UnitéCompilation::État::COMPILATION_TERMINÉE);
@@ -11,6 +11,7 @@
 
 #include "arbre_syntaxique/allocatrice.hh"
 #include "graphe_dependance.hh"
+#include "trace_taches.hh"
 #include "unite_compilation.hh"
 
 #include <random>
@@ -165,6 +166,9 @@ class GestionnaireCode {
     /* Utilisé afin de récupérer la mémoire dans crée_tâches. */
     kuri::tableau<UnitéCompilation *> m_nouvelles_unités{};
 
+    /* Les mises en attente, si --trace_tâches fut renseigné. */
+    kuri::tableau<ÉvénementAttente, int> m_attentes_tracées{};
+
   public:
     GestionnaireCode() = default;
     GestionnaireCode(Compilatrice *compilatrice);
@@ -288,7 +292,14 @@ class GestionnaireCode {
 
     void imprime_stats() const;
 
+    kuri::tableau_statique<ÉvénementAttente> donne_attentes_tracées() const
+    {
+        return m_attentes_tracées;
+    }
+
   private:
+    void trace_attente(UnitéCompilation const *unité, Attente const &attente);
+
     UnitéCompilation *crée_unité_pour_message(EspaceDeTravail *espace, Message *message);
 
     UnitéCompilation *requiers_noeud_code(EspaceDeTravail *espace, NoeudExpression *noeud);
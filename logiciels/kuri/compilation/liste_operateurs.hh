@@ -0,0 +1,54 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * The Original Code is Copyright (C) 2026 Kévin Dietrich. */
+
+#pragma once
+
+/* Listes des opérateurs de base, séparées de operateurs.hh pour pouvoir être incluses par les
+ * générateurs de code qui ne dépendent pas de l'arbre syntaxique. */
+
+/* Non genre, chaine RI. */
+#define ENUMERE_OPERATEURS_UNAIRE                                                                 \
+    ENUMERE_GENRE_OPUNAIRE_EX(Invalide, invalide)                                                 \
+    ENUMERE_GENRE_OPUNAIRE_EX(Positif, plus)                                                      \
+    ENUMERE_GENRE_OPUNAIRE_EX(Négation, moins)                                                    \
+    ENUMERE_GENRE_OPUNAIRE_EX(Négation_Binaire, nonb)
+
+/* Nom genre, chaine RI, code opération MV. */
+#define ENUMERE_OPERATEURS_BINAIRE                                                                \
+    ENUMERE_GENRE_OPBINAIRE_EX(Invalide, invalide, octet_t(-1))                                   \
+    ENUMERE_GENRE_OPBINAIRE_EX(Addition, ajt, OP_AJOUTE)                                          \
+    ENUMERE_GENRE_OPBINAIRE_EX(Addition_Réel, ajtr, OP_AJOUTE_RÉEL)                               \
+    ENUMERE_GENRE_OPBINAIRE_EX(Soustraction, sst, OP_SOUSTRAIT)                                   \
+    ENUMERE_GENRE_OPBINAIRE_EX(Soustraction_Réel, sstr, OP_SOUSTRAIT_RÉEL)                        \
+    ENUMERE_GENRE_OPBINAIRE_EX(Multiplication, mul, OP_MULTIPLIE)                                 \
+    ENUMERE_GENRE_OPBINAIRE_EX(Multiplication_Réel, mulr, OP_MULTIPLIE_RÉEL)                      \
+    ENUMERE_GENRE_OPBINAIRE_EX(Division_Naturel, divn, OP_DIVISE)                                 \
+    ENUMERE_GENRE_OPBINAIRE_EX(Division_Relatif, divz, OP_DIVISE_RELATIF)                         \
+    ENUMERE_GENRE_OPBINAIRE_EX(Division_Réel, divr, OP_DIVISE_RÉEL)                               \
+    ENUMERE_GENRE_OPBINAIRE_EX(Reste_Naturel, modn, OP_RESTE_NATUREL)                             \
+    ENUMERE_GENRE_OPBINAIRE_EX(Reste_Relatif, modz, OP_RESTE_RELATIF)                             \
+    ENUMERE_GENRE_OPBINAIRE_EX(Comp_Égal, eg, OP_COMP_ÉGAL)                                       \
+    ENUMERE_GENRE_OPBINAIRE_EX(Comp_Inégal, neg, OP_COMP_INÉGAL)                                  \
+    ENUMERE_GENRE_OPBINAIRE_EX(Comp_Inf, inf, OP_COMP_INF)                                        \
+    ENUMERE_GENRE_OPBINAIRE_EX(Comp_Inf_Égal, infeg, OP_COMP_INF_ÉGAL)                            \
+    ENUMERE_GENRE_OPBINAIRE_EX(Comp_Sup, sup, OP_COMP_SUP)                                        \
+    ENUMERE_GENRE_OPBINAIRE_EX(Comp_Sup_Égal, supeg, OP_COMP_SUP_ÉGAL)                            \
+    ENUMERE_GENRE_OPBINAIRE_EX(Comp_Inf_Nat, infn, OP_COMP_INF_NATUREL)                           \
+    ENUMERE_GENRE_OPBINAIRE_EX(Comp_Inf_Égal_Nat, infegn, OP_COMP_INF_ÉGAL_NATUREL)               \
+    ENUMERE_GENRE_OPBINAIRE_EX(Comp_Sup_Nat, supn, OP_COMP_SUP_NATUREL)                           \
+    ENUMERE_GENRE_OPBINAIRE_EX(Comp_Sup_Égal_Nat, supegn, OP_COMP_SUP_ÉGAL_NATUREL)               \
+    ENUMERE_GENRE_OPBINAIRE_EX(Comp_Égal_Réel, egr, OP_COMP_ÉGAL_RÉEL)                            \
+    ENUMERE_GENRE_OPBINAIRE_EX(Comp_Inégal_Réel, negr, OP_COMP_INÉGAL_RÉEL)                       \
+    ENUMERE_GENRE_OPBINAIRE_EX(Comp_Inf_Réel, infr, OP_COMP_INF_RÉEL)                             \
+    ENUMERE_GENRE_OPBINAIRE_EX(Comp_Inf_Égal_Réel, infegr, OP_COMP_INF_ÉGAL_RÉEL)                 \
+    ENUMERE_GENRE_OPBINAIRE_EX(Comp_Sup_Réel, supr, OP_COMP_SUP_RÉEL)                             \
+    ENUMERE_GENRE_OPBINAIRE_EX(Comp_Sup_Égal_Réel, supegr, OP_COMP_SUP_ÉGAL_RÉEL)                 \
+    ENUMERE_GENRE_OPBINAIRE_EX(Et_Binaire, et, OP_ET_BINAIRE)                                     \
+    ENUMERE_GENRE_OPBINAIRE_EX(Ou_Binaire, ou, OP_OU_BINAIRE)                                     \
+    ENUMERE_GENRE_OPBINAIRE_EX(Ou_Exclusif, oux, OP_OU_EXCLUSIF)                                  \
+    ENUMERE_GENRE_OPBINAIRE_EX(Dec_Gauche, decg, OP_DEC_GAUCHE)                                   \
+    ENUMERE_GENRE_OPBINAIRE_EX(Dec_Droite_Arithm, decda, OP_DEC_DROITE_ARITHM)                    \
+    ENUMERE_GENRE_OPBINAIRE_EX(Dec_Droite_Logique, decdl, OP_DEC_DROITE_LOGIQUE)                  \
+    ENUMERE_GENRE_OPBINAIRE_EX(Pivote_Gauche, pvg, OP_PIVOTE_GAUCHE)                              \
+    ENUMERE_GENRE_OPBINAIRE_EX(Pivote_Droite, pvd, OP_PIVOTE_DROITE)                              \
+    ENUMERE_GENRE_OPBINAIRE_EX(Indexage, idx, octet_t(-1))
@@ -9,6 +9,8 @@
 
 #include "parsage/identifiant.hh"
 
+#include "statistiques/statistiques.hh"
+
 #include "utilitaires/log.hh"
 
 #include "compilatrice.hh"
@@ -46,38 +48,179 @@ std::ostream &operator<<(std::ostream &os, const ItemMonomorphisation &item)
     return os;
 }
 
-NoeudExpression *Monomorphisations::trouve_monomorphisation(
-    kuri::tableau_statique<ItemMonomorphisation> items) const
+static uint64_t combine_empreintes(uint64_t graine, uint64_t empreinte)
 {
-    auto monomorphisations_ = monomorphisations.verrou_lecture();
+    return graine ^ (empreinte + 0x9e3779b9 + (graine << 6) + (graine >> 2));
+}
 
-    POUR (*monomorphisations_) {
-        if (it.premier.taille() != items.taille()) {
-            continue;
+static uint64_t donne_empreinte_valeur(ValeurExpression const &valeur)
+{
+    if (valeur.est_entière()) {
+        return uint64_t(valeur.entière());
+    }
+    if (valeur.est_booléenne()) {
+        return uint64_t(valeur.booléenne());
+    }
+    if (valeur.est_réelle()) {
+        return std::hash<double>()(valeur.réelle());
+    }
+    if (valeur.est_chaine()) {
+        return std::hash<void *>()(valeur.chaine());
+    }
+    if (valeur.est_tableau_fixe()) {
+        return std::hash<void *>()(valeur.tableau_fixe());
+    }
+    if (valeur.est_fonction()) {
+        return std::hash<void *>()(valeur.fonction());
+    }
+    if (valeur.est_type()) {
+        return std::hash<void *>()(valeur.type());
+    }
+    return 0;
+}
+
+/* L'empreinte ne considère que ce que compare ItemMonomorphisation::operator==. */
+static uint64_t donne_empreinte_items(kuri::tableau_statique<ItemMonomorphisation> items)
+{
+    auto résultat = uint64_t(items.taille());
+
+    POUR (items) {
+        résultat = combine_empreintes(résultat, std::hash<void const *>()(it.ident));
+        résultat = combine_empreintes(résultat, std::hash<void const *>()(it.type));
+        résultat = combine_empreintes(résultat, uint64_t(it.genre));
+
+        if (it.genre == GenreItem::VALEUR) {
+            résultat = combine_empreintes(résultat, donne_empreinte_valeur(it.valeur));
         }
+    }
 
-        auto trouve = true;
+    return résultat;
+}
 
-        for (auto i = 0; i < items.taille(); ++i) {
-            if (it.premier[i] != items[i]) {
-                trouve = false;
-                break;
-            }
+static bool sont_items_égaux(kuri::tableau_statique<ItemMonomorphisation> items1,
+                             kuri::tableau_statique<ItemMonomorphisation> items2)
+{
+    if (items1.taille() != items2.taille()) {
+        return false;
+    }
+
+    for (auto i = 0; i < items1.taille(); ++i) {
+        if (items1[i] != items2[i]) {
+            return false;
         }
+    }
 
-        if (!trouve) {
-            continue;
+    return true;
+}
+
+Monomorphisations::~Monomorphisations()
+{
+    POUR (m_tables) {
+        mémoire::déloge_tableau("Monomorphisations::alvéoles", it->alvéoles, it->nombre_alvéoles);
+        mémoire::déloge("Monomorphisations::TableEntrées", it);
+    }
+
+    POUR (m_entrées) {
+        mémoire::déloge("Monomorphisations::Entrée", it);
+    }
+}
+
+NoeudExpression *Monomorphisations::trouve_dans_table(
+    TableEntrées const *table,
+    kuri::tableau_statique<ItemMonomorphisation> items,
+    uint64_t empreinte)
+{
+    if (!table) {
+        return nullptr;
+    }
+
+    auto const masque = uint64_t(table->nombre_alvéoles - 1);
+
+    /* La table n'étant jamais pleine, il y a toujours une alvéole vide pour arrêter la
+     * recherche. */
+    for (auto i = empreinte & masque;; i = (i + 1) & masque) {
+        auto entrée = table->alvéoles[i].load(std::memory_order_acquire);
+        if (!entrée) {
+            return nullptr;
         }
 
-        return it.second;
+        if (entrée->empreinte == empreinte && sont_items_égaux(entrée->items, items)) {
+            return entrée->noeud;
+        }
     }
+}
 
-    return nullptr;
+void Monomorphisations::insère_entrée(TableEntrées *table, Entrée *entrée)
+{
+    auto const masque = uint64_t(table->nombre_alvéoles - 1);
+
+    for (auto i = entrée->empreinte & masque;; i = (i + 1) & masque) {
+        if (!table->alvéoles[i].load(std::memory_order_relaxed)) {
+            table->alvéoles[i].store(entrée, std::memory_order_release);
+            return;
+        }
+    }
 }
 
-void Monomorphisations::ajoute(const tableau_items &items, NoeudExpression *noeud)
+Monomorphisations::TableEntrées *Monomorphisations::crée_table(int nombre_alvéoles)
 {
-    monomorphisations->ajoute({items, noeud});
+    auto table = mémoire::loge<TableEntrées>("Monomorphisations::TableEntrées");
+    table->alvéoles = mémoire::loge_tableau<std::atomic<Entrée *>>("Monomorphisations::alvéoles",
+                                                                   nombre_alvéoles);
+    table->nombre_alvéoles = nombre_alvéoles;
+
+    for (auto i = 0; i < nombre_alvéoles; ++i) {
+        new (&table->alvéoles[i]) std::atomic<Entrée *>(nullptr);
+    }
+
+    POUR (m_entrées) {
+        insère_entrée(table, it);
+    }
+
+    m_tables.ajoute(table);
+    return table;
+}
+
+NoeudExpression *Monomorphisations::trouve_monomorphisation(
+    kuri::tableau_statique<ItemMonomorphisation> items) const
+{
+    auto const empreinte = donne_empreinte_items(items);
+    return trouve_dans_table(m_table.load(std::memory_order_acquire), items, empreinte);
+}
+
+NoeudExpression *Monomorphisations::ajoute(const tableau_items &items, NoeudExpression *noeud)
+{
+    auto const empreinte = donne_empreinte_items(items);
+
+    std::unique_lock verrou(m_verrou);
+
+    auto table = m_table.load(std::memory_order_relaxed);
+
+    /* Un autre fil a pu ajouter la même monomorphisation depuis notre recherche. */
+    auto existante = trouve_dans_table(table, items, empreinte);
+    if (existante) {
+        return existante;
+    }
+
+    auto entrée = mémoire::loge<Entrée>("Monomorphisations::Entrée");
+    entrée->items = items;
+    entrée->noeud = noeud;
+    entrée->empreinte = empreinte;
+
+    m_entrées.ajoute(entrée);
+
+    if (!table || m_entrées.taille() * 2 > table->nombre_alvéoles) {
+        auto nombre_alvéoles = table ? table->nombre_alvéoles * 2 : NOMBRE_ALVÉOLES_INITIAL;
+        /* La nouvelle table contient déjà toutes les entrées lors de sa publication. */
+        m_table.store(crée_table(nombre_alvéoles), std::memory_order_release);
+    }
+    else {
+        insère_entrée(table, entrée);
+    }
+
+    m_nombre_entrées.fetch_add(1, std::memory_order_relaxed);
+
+    return noeud;
 }
 
 kuri::tableau<ItemMonomorphisation, int> Monomorphisations::donne_items_pour(
@@ -85,9 +228,11 @@ kuri::tableau<ItemMonomorphisation, int> Monomorphisations::donne_items_pour(
 {
     kuri::tableau<ItemMonomorphisation, int> résultat;
 
-    POUR (*monomorphisations.verrou_lecture()) {
-        if (it.second == noeud) {
-            résultat = it.premier;
+    std::unique_lock verrou(m_verrou);
+
+    POUR (m_entrées) {
+        if (it->noeud == noeud) {
+            résultat = it->items;
             break;
         }
     }
@@ -97,12 +242,20 @@ kuri::tableau<ItemMonomorphisation, int> Monomorphisations::donne_items_pour(
 
 int64_t Monomorphisations::mémoire_utilisée() const
 {
+    std::unique_lock verrou(m_verrou);
+
     int64_t résultat = 0;
-    résultat += monomorphisations->taille() *
-                (taille_de(NoeudExpression *) + taille_de(tableau_items));
+    résultat += m_entrées.taille_mémoire();
+    résultat += m_entrées.taille() * taille_de(Entrée);
+    résultat += m_tables.taille_mémoire();
 
-    POUR (*monomorphisations.verrou_lecture()) {
-        résultat += it.premier.taille() * (taille_de(ItemMonomorphisation));
+    POUR (m_tables) {
+        résultat += taille_de(TableEntrées);
+        résultat += it->nombre_alvéoles * taille_de(std::atomic<Entrée *>);
+    }
+
+    POUR (m_entrées) {
+        résultat += it->items.taille() * (taille_de(ItemMonomorphisation));
     }
 
     return résultat;
@@ -110,22 +263,37 @@ int64_t Monomorphisations::mémoire_utilisée() const
 
 int Monomorphisations::taille() const
 {
-    return monomorphisations->taille();
+    return m_nombre_entrées.load(std::memory_order_relaxed);
 }
 
 int Monomorphisations::nombre_items_max() const
 {
+    std::unique_lock verrou(m_verrou);
+
     int n = 0;
 
-    POUR (*monomorphisations.verrou_lecture()) {
-        if (it.premier.taille() > n) {
-            n = it.premier.taille();
+    POUR (m_entrées) {
+        if (it->items.taille() > n) {
+            n = it->items.taille();
         }
     }
 
     return n;
 }
 
+void Monomorphisations::rassemble_statistiques(Statistiques &stats,
+                                               IdentifiantCode const *ident) const
+{
+    auto const nombre_monomorphisations = taille();
+    if (nombre_monomorphisations == 0) {
+        return;
+    }
+
+    auto nom = ident ? ident->nom : kuri::chaine_statique("anonyme");
+    stats.stats_monomorphisations.fusionne_entrée(
+        {nom, nombre_monomorphisations, mémoire_utilisée()});
+}
+
 void Monomorphisations::imprime(std::ostream &os) const
 {
     Enchaineuse enchaineuse;
@@ -135,13 +303,13 @@ void Monomorphisations::imprime(std::ostream &os) const
 
 void Monomorphisations::imprime(Enchaineuse &os, int indentations) const
 {
-    auto monomorphisations_ = monomorphisations.verrou_lecture();
-    if (monomorphisations_->taille() == 0) {
+    std::unique_lock verrou(m_verrou);
+    if (m_entrées.taille() == 0) {
         os << "Il n'y a aucune monomorphisation connue !\n";
         return;
     }
 
-    auto nombre_monomorphisations = monomorphisations_->taille();
+    auto nombre_monomorphisations = m_entrées.taille();
 
     if (nombre_monomorphisations == 1) {
         os << chaine_indentations(indentations) << "Une monomorphisation connue :\n";
@@ -150,9 +318,9 @@ void Monomorphisations::imprime(Enchaineuse &os, int indentations) const
         os << chaine_indentations(indentations) << "Les monomorphisations connues sont :\n";
     }
 
-    POUR (*monomorphisations_) {
-        for (auto i = 0; i < it.premier.taille(); ++i) {
-            os << chaine_indentations(indentations + 1) << it.premier[i] << '\n';
+    POUR (m_entrées) {
+        for (auto i = 0; i < it->items.taille(); ++i) {
+            os << chaine_indentations(indentations + 1) << it->items[i] << '\n';
         }
 
         nombre_monomorphisations--;
@@ -225,7 +393,12 @@ static std::pair<NoeudExpression *, bool> monomorphise_au_besoin(
         }
     }
 
-    monomorphisations->ajoute(items_monomorphisation, copie);
+    /* Si un autre fil a monomorphisé les mêmes items entretemps, utilise sa copie. */
+    auto monomorphisation_connue = monomorphisations->ajoute(items_monomorphisation, copie);
+    if (monomorphisation_connue != copie) {
+        return {monomorphisation_connue, false};
+    }
+
     return {copie, true};
 }
 
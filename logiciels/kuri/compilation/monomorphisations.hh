@@ -3,16 +3,22 @@
 
 #pragma once
 
+#include <atomic>
+#include <mutex>
+
 #include "arbre_syntaxique/expression.hh"
 
 #include "structures/tableau.hh"
 #include "structures/tuples.hh"
 
+#include "utilitaires/macros.hh"
+
 struct Contexte;
 struct EspaceDeTravail;
 struct Enchaineuse;
 struct IdentifiantCode;
 struct NoeudDéclarationType;
+struct Statistiques;
 using Type = NoeudDéclarationType;
 
 namespace kuri {
@@ -72,10 +78,48 @@ std::ostream &operator<<(std::ostream &os, const ItemMonomorphisation &item);
 struct Monomorphisations {
   protected:
     using tableau_items = kuri::tableau<ItemMonomorphisation, int>;
-    kuri::tableau_synchrone<kuri::paire<tableau_items, NoeudExpression *>> monomorphisations{};
+
+    struct Entrée {
+        tableau_items items{};
+        NoeudExpression *noeud = nullptr;
+        uint64_t empreinte = 0;
+    };
+
+    /* Table à adressage ouvert des entrées, d'une puissance de 2 alvéoles, remplie au plus à
+     * moitié. Les alvéoles sont lues sans verrou : une entrée est entièrement construite avant
+     * d'être publiée, et n'est plus modifiée par la suite. Lorsque la table serait remplie à plus
+     * de moitié, une table deux fois plus grande est remplie puis publiée à sa place. */
+    struct TableEntrées {
+        std::atomic<Entrée *> *alvéoles = nullptr;
+        int nombre_alvéoles = 0;
+    };
+
+    static constexpr int NOMBRE_ALVÉOLES_INITIAL = 8;
+
+    std::atomic<TableEntrées *> m_table = nullptr;
+    std::atomic<int> m_nombre_entrées = 0;
+
+    /* Toutes les tables créées, la dernière étant la table courante. Les tables remplacées sont
+     * gardées jusqu'à la destruction, car d'autres fils peuvent encore les parcourir ; leurs
+     * tailles étant en progression géométrique, elles occupent moins que la table courante. */
+    kuri::tableau<TableEntrées *, int> m_tables{};
+
+    /* Les entrées dans l'ordre d'ajout, pour les impressions. Les ajouts sont sérialisés par le
+     * verrou. */
+    kuri::tableau<Entrée *, int> m_entrées{};
+    mutable std::mutex m_verrou{};
 
   public:
-    void ajoute(tableau_items const &items, NoeudExpression *noeud);
+    Monomorphisations() = default;
+
+    EMPECHE_COPIE(Monomorphisations);
+
+    ~Monomorphisations();
+
+    /* Ajoute la monomorphisation, sauf si une monomorphisation pour les mêmes items fut ajoutée
+     * entretemps par un autre fil. Retourne le noeud de la monomorphisation connue pour les
+     * items. */
+    NoeudExpression *ajoute(tableau_items const &items, NoeudExpression *noeud);
 
     // À FAIRE : supprime l'allocation, mais nous le passons à monomorphie_au_besoin.
     kuri::tableau<ItemMonomorphisation, int> donne_items_pour(NoeudExpression *noeud) const;
@@ -89,8 +133,19 @@ struct Monomorphisations {
 
     int nombre_items_max() const;
 
+    void rassemble_statistiques(Statistiques &stats, IdentifiantCode const *ident) const;
+
     void imprime(std::ostream &os) const;
     void imprime(Enchaineuse &os, int indentations = 0) const;
+
+  private:
+    static NoeudExpression *trouve_dans_table(TableEntrées const *table,
+                                              kuri::tableau_statique<ItemMonomorphisation> items,
+                                              uint64_t empreinte);
+
+    /* Doivent être appelées avec le verrou. */
+    TableEntrées *crée_table(int nombre_alvéoles);
+    static void insère_entrée(TableEntrées *table, Entrée *entrée);
 };
 
 std::pair<NoeudDéclarationEntêteFonction *, bool> monomorphise_au_besoin(
@@ -610,6 +610,8 @@ void Syntaxeuse::quand_commence()
 
 void Syntaxeuse::quand_termine()
 {
+    /* Les autres fichiers du module invalideront l'index s'ils ajoutent des rubriques. */
+    m_fichier->module->bloc->publie_index_rubriques();
     m_contexte->assembleuse->dépile_tout();
 }
 
@@ -3004,7 +3006,7 @@ NoeudExpression *Syntaxeuse::analyse_déclaration_fonction(Lexème const *lexèm
         noeud->param_sortie = m_contexte->assembleuse->crée_déclaration_variable(
             noeud->params_sorties[0]->lexème, nullptr, nullptr);
         noeud->param_sortie->ident = m_compilatrice.table_identifiants
-                                         ->identifiant_pour_nouvelle_chaine("valeur_de_retour");
+                                         .identifiant_pour_nouvelle_chaine("valeur_de_retour");
     }
     else {
         noeud->param_sortie = noeud->params_sorties[0]->comme_déclaration_variable();
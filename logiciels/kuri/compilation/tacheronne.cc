@@ -109,6 +109,25 @@ OrdonnanceuseTache::OrdonnanceuseTache(Compilatrice *compilatrice) : m_compilatr
 {
 }
 
+OrdonnanceuseTache::~OrdonnanceuseTache()
+{
+    POUR (m_files_tacheronnes) {
+        mémoire::déloge("FilesTacheronne", it);
+    }
+}
+
+/* Verrouille les files, en comptant les contentions sur leur verrou. */
+static std::unique_lock<std::mutex> verrouille_files(std::mutex &verrou,
+                                                     std::atomic<int64_t> &nombre_contentions)
+{
+    if (verrou.try_lock()) {
+        return std::unique_lock<std::mutex>(verrou, std::adopt_lock);
+    }
+
+    nombre_contentions += 1;
+    return std::unique_lock<std::mutex>(verrou);
+}
+
 void OrdonnanceuseTache::crée_tâche_pour_unité(UnitéCompilation *unité)
 {
     assert(unité);
@@ -121,41 +140,140 @@ void OrdonnanceuseTache::crée_tâche_pour_unité(UnitéCompilation *unité)
     tache.espace = unité->espace;
     tache.genre = static_cast<GenreTâche>(indice_file + 2);
 
-    tâches[indice_file].enfile(tache);
+    m_tâches_créées.ajoute(tache);
+}
 
-    pique_taille.tâches[indice_file] = std::max(pique_taille.tâches[indice_file],
-                                                tâches[indice_file].taille());
+void OrdonnanceuseTache::enfile(FilesTacheronne &files,
+                                int indice_file,
+                                Tâche const &tâche,
+                                uint64_t séquence)
+{
+    files.tâches[indice_file].enfile({tâche, séquence});
+    files.actualise_séquence_tête(indice_file);
+    m_nombre_tâches_en_attente += 1;
+
+    files.pique_taille.tâches[indice_file] = std::max(files.pique_taille.tâches[indice_file],
+                                                      files.tâches[indice_file].taille());
 }
 
-int64_t OrdonnanceuseTache::nombre_de_tâches_en_attente() const
+void OrdonnanceuseTache::crée_tâches()
 {
-    auto résultat = int64_t(0);
-    POUR (tâches) {
-        résultat += it.taille();
+    /* Si une autre tacheronne est en train de créer les tâches, n'attendons pas sur elle : les
+     * tâches seront disponibles lors du prochain appel. */
+    std::unique_lock<std::mutex> verrou(m_verrou_création, std::try_to_lock);
+    if (!verrou.owns_lock()) {
+        return;
     }
-    return résultat;
+
+    /* Une autre tacheronne a pu créer des tâches avant que nous ne prenions le verrou. */
+    if (m_nombre_tâches_en_attente.load() != 0) {
+        return;
+    }
+
+    m_compilatrice->gestionnaire_code->crée_tâches(*this);
+    distribue_tâches_créées();
 }
 
-Tâche OrdonnanceuseTache::tâche_suivante(Tâche &tache_terminee, DrapeauxTacheronne drapeaux)
+void OrdonnanceuseTache::distribue_tâches_créées()
 {
-    if (nombre_de_tâches_en_attente() == 0) {
-        m_compilatrice->gestionnaire_code->crée_tâches(*this);
+    auto const nombre_tacheronnes = m_files_tacheronnes.taille();
+    if (nombre_tacheronnes == 0 || m_tâches_créées.est_vide()) {
+        m_tâches_créées.efface();
+        return;
     }
 
-    if (compilation_terminée) {
-        return Tâche::compilation_terminée();
+    /* Ne prend le verrou de chaque tacheronne qu'une seule fois. Le décalage change à chaque
+     * distribution afin de ne pas toujours donner les premières tâches à la même tacheronne. Les
+     * séquences sont réservées d'avance afin de suivre l'ordre de création des tâches. */
+    auto const séquence_base = m_séquence_suivante.fetch_add(
+        static_cast<uint64_t>(m_tâches_créées.taille()));
+
+    for (int64_t i = 0; i < nombre_tacheronnes; i++) {
+        auto &files = *m_files_tacheronnes[(i + m_décalage_distribution) % nombre_tacheronnes];
+        auto verrou = verrouille_files(files.verrou, files.nombre_contentions);
+
+        for (auto j = i; j < m_tâches_créées.taille(); j += nombre_tacheronnes) {
+            auto const &tâche = m_tâches_créées[j];
+            auto const indice_file = static_cast<int>(tâche.genre) - 2;
+            enfile(files, indice_file, tâche, séquence_base + static_cast<uint64_t>(j));
+        }
     }
 
-    for (int i = 0; i < NOMBRE_FILES; ++i) {
-        if (!drapeau_est_actif(drapeaux, static_cast<DrapeauxTacheronne>(1 << i))) {
+    m_décalage_distribution += 1;
+    m_tâches_créées.efface();
+}
+
+bool OrdonnanceuseTache::prends_tâche(int id_tacheronne,
+                                      DrapeauxTacheronne drapeaux,
+                                      Tâche &résultat)
+{
+    auto const nombre_tacheronnes = m_files_tacheronnes.taille();
+    auto &files_tacheronne = *m_files_tacheronnes[id_tacheronne];
+
+    for (int indice_file = 0; indice_file < NOMBRE_FILES; ++indice_file) {
+        if (!drapeau_est_actif(drapeaux, static_cast<DrapeauxTacheronne>(1 << indice_file))) {
             continue;
         }
 
-        if (!tâches[i].est_vide()) {
-            return tâches[i].défile();
+        /* Cherche la file ayant la tâche la plus ancienne, sans prendre de verrou. Une autre
+         * tacheronne peut prendre la tâche entre temps, auquel cas nous recommençons. */
+        while (true) {
+            FilesTacheronne *files_choisies = nullptr;
+            auto séquence_choisie = SÉQUENCE_FILE_VIDE;
+
+            for (int64_t i = 0; i < nombre_tacheronnes; i++) {
+                auto files = m_files_tacheronnes[(id_tacheronne + i) % nombre_tacheronnes];
+                auto const séquence = files->séquences_têtes[indice_file].load();
+                if (séquence < séquence_choisie) {
+                    séquence_choisie = séquence;
+                    files_choisies = files;
+                }
+            }
+
+            if (!files_choisies) {
+                break;
+            }
+
+            auto verrou = verrouille_files(files_choisies->verrou,
+                                           files_choisies->nombre_contentions);
+
+            auto &file = files_choisies->tâches[indice_file];
+            if (file.est_vide() || file.front().séquence != séquence_choisie) {
+                continue;
+            }
+
+            résultat = file.défile().tâche;
+            files_choisies->actualise_séquence_tête(indice_file);
+            m_nombre_tâches_en_attente -= 1;
+
+            files_tacheronne.nombre_tâches_prises += 1;
+            if (files_choisies != &files_tacheronne) {
+                files_tacheronne.nombre_tâches_volées += 1;
+            }
+            return true;
         }
     }
 
+    return false;
+}
+
+Tâche OrdonnanceuseTache::tâche_suivante(Tâche &tache_terminee,
+                                         DrapeauxTacheronne drapeaux,
+                                         int id_tacheronne)
+{
+    if (m_nombre_tâches_en_attente.load() == 0) {
+        crée_tâches();
+    }
+
+    if (compilation_terminée) {
+        return Tâche::compilation_terminée();
+    }
+
+    auto tâche = Tâche{};
+    if (prends_tâche(id_tacheronne, drapeaux, tâche)) {
+        return tâche;
+    }
+
     auto unité = tache_terminee.unité;
     auto espace = EspaceDeTravail::nul();
 
@@ -180,28 +298,40 @@ Tâche OrdonnanceuseTache::tâche_suivante(Tâche &tache_terminee, DrapeauxTache
 int64_t OrdonnanceuseTache::mémoire_utilisée() const
 {
     auto memoire = int64_t(0);
-    POUR (pique_taille.tâches) {
-        memoire += it * taille_de(Tâche);
+    memoire += m_files_tacheronnes.taille_mémoire();
+    memoire += m_tâches_créées.taille_mémoire();
+    POUR (m_files_tacheronnes) {
+        memoire += taille_de(FilesTacheronne);
+        for (auto pique : it->pique_taille.tâches) {
+            memoire += pique * taille_de(TâcheNumérotée);
+        }
     }
     return memoire;
 }
 
 int OrdonnanceuseTache::enregistre_tacheronne(Badge<Tacheronne> /*badge*/)
 {
-    return nombre_de_tacheronnes++;
+    std::unique_lock<std::mutex> verrou(m_verrou_création);
+    m_files_tacheronnes.ajoute(mémoire::loge<FilesTacheronne>("FilesTacheronne"));
+    return static_cast<int>(m_files_tacheronnes.taille() - 1);
 }
 
 void OrdonnanceuseTache::supprime_toutes_les_tâches()
 {
-    POUR (tâches) {
-        it.efface();
-    }
+    m_tâches_créées.efface();
 
     /* Il faut que toutes les tacheronnes soient notifiées de la fin de la compilation, donc enfile
-     * un nombre égal de tâcheronnes de tâches de fin de compilation. */
-    for (int i = 0; i < nombre_de_tacheronnes; ++i) {
-        POUR (tâches) {
-            it.enfile(Tâche::compilation_terminée());
+     * une tâche de fin de compilation dans chaque file de chaque tâcheronne. */
+    POUR (m_files_tacheronnes) {
+        auto verrou = verrouille_files(it->verrou, it->nombre_contentions);
+
+        for (auto &file : it->tâches) {
+            m_nombre_tâches_en_attente -= file.taille();
+            file.efface();
+        }
+
+        for (int indice_file = 0; indice_file < NOMBRE_FILES; ++indice_file) {
+            enfile(*it, indice_file, Tâche::compilation_terminée(), m_séquence_suivante++);
         }
     }
 }
@@ -209,36 +339,79 @@ void OrdonnanceuseTache::supprime_toutes_les_tâches()
 void OrdonnanceuseTache::supprime_toutes_les_tâches_pour_espace(const EspaceDeTravail *espace,
                                                                 UnitéCompilation::État état)
 {
-    auto predicat = [&](Tâche const &tache) { return tache.espace == espace; };
-    POUR (tâches) {
-        for (auto &tache : it) {
-            if (tache.espace != espace) {
-                continue;
-            }
+    auto predicat = [&](TâcheNumérotée const &tache) { return tache.tâche.espace == espace; };
 
-            tache.unité->définis_état(état);
+    kuri::tableau<Tâche> tâches_restantes;
+    POUR (m_tâches_créées) {
+        if (it.espace == espace) {
+            it.unité->définis_état(état);
+            continue;
         }
+        tâches_restantes.ajoute(it);
+    }
+    m_tâches_créées.permute(tâches_restantes);
 
-        it.efface_si(predicat);
+    POUR (m_files_tacheronnes) {
+        auto verrou = verrouille_files(it->verrou, it->nombre_contentions);
+
+        for (int indice_file = 0; indice_file < NOMBRE_FILES; ++indice_file) {
+            auto &file = it->tâches[indice_file];
+            for (auto &tache : file) {
+                if (tache.tâche.espace != espace) {
+                    continue;
+                }
+
+                tache.tâche.unité->définis_état(état);
+            }
+
+            auto const taille_avant = file.taille();
+            file.efface_si(predicat);
+            m_nombre_tâches_en_attente -= taille_avant - file.taille();
+            it->actualise_séquence_tête(indice_file);
+        }
     }
 }
 
 void OrdonnanceuseTache::imprime_données_files(std::ostream &os)
 {
+    int64_t nombre_de_tâches[NOMBRE_FILES] = {};
+    POUR (m_tâches_créées) {
+        nombre_de_tâches[static_cast<int>(it.genre) - 2] += 1;
+    }
+    POUR (m_files_tacheronnes) {
+        auto verrou = verrouille_files(it->verrou, it->nombre_contentions);
+        for (int indice_file = 0; indice_file < NOMBRE_FILES; ++indice_file) {
+            nombre_de_tâches[indice_file] += it->tâches[indice_file].taille();
+        }
+    }
+
     os << "Nombre de tâches dans les files :\n";
 #define IMPRIME_NOMBRE_DE_TACHES(VERBE, ACTION, CHAINE, INDICE)                                   \
-    os << "-- " << CHAINE << " : " << tâches[INDICE].taille() << '\n';
+    os << "-- " << CHAINE << " : " << nombre_de_tâches[INDICE] << '\n';
 
     ENUMERE_TACHES_POSSIBLES(IMPRIME_NOMBRE_DE_TACHES)
 
 #undef IMPRIME_NOMBRE_DE_TACHES
 }
 
+void OrdonnanceuseTache::rassemble_statistiques(Statistiques &stats) const
+{
+    POUR_INDICE (m_files_tacheronnes) {
+        auto entrée = EntréeFileTâches{};
+        entrée.tacheronne = indice_it;
+        entrée.tâches_prises = it->nombre_tâches_prises.load();
+        entrée.tâches_volées = it->nombre_tâches_volées.load();
+        entrée.contentions = it->nombre_contentions.load();
+        stats.stats_files_tâches.fusionne_entrée(entrée);
+    }
+}
+
 Tacheronne::Tacheronne(Compilatrice &comp)
     : compilatrice(comp), analyseuse_ri(mémoire::loge<ContexteAnalyseRI>("ContexteAnalyseRI")),
       assembleuse(mémoire::loge<AssembleuseArbre>("AssembleuseArbre", this->allocatrice_noeud)),
-      id(compilatrice.ordonnanceuse->enregistre_tacheronne({}))
+      id(compilatrice.ordonnanceuse.enregistre_tacheronne({}))
 {
+    trace.id_tacheronne = id;
 }
 
 Tacheronne::~Tacheronne()
@@ -255,7 +428,8 @@ bool Tacheronne::gère_tâche()
     auto &ordonnanceuse = compilatrice.ordonnanceuse;
 
     {
-        tâche = ordonnanceuse->tâche_suivante(tâche, drapeaux);
+        auto garde_lectures_index = GardeLecturesIndexRubriques();
+        tâche = ordonnanceuse.tâche_suivante(tâche, drapeaux, id);
 
         if (tâche.genre != GenreTâche::DORS) {
             nombre_dodos = 0;
@@ -266,6 +440,12 @@ bool Tacheronne::gère_tâche()
                 UnitéCompilation::État::EN_COURS_DE_TRAITEMENT_PAR_TACHERONNE);
         }
 
+        auto événement_trace = ÉvénementTâche{};
+        auto const trace_active = compilatrice.trace_tâches_active() && tâche.unité;
+        if (trace_active) {
+            événement_trace = débute_événement_tâche(tâche, compilatrice.horloge_trace);
+        }
+
         switch (tâche.genre) {
             case GenreTâche::COMPILATION_TERMINÉE:
             {
@@ -282,6 +462,7 @@ bool Tacheronne::gère_tâche()
                     exécute_métaprogrammes();
                 }
                 else {
+                    garde_lectures_index.termine();
                     if (compilatrice.arguments.compile_en_mode_parallèle) {
                         nombre_dodos += 1;
                         kuri::chrono::dors_microsecondes(100 * nombre_dodos);
@@ -300,13 +481,24 @@ bool Tacheronne::gère_tâche()
                     fichier->mutex.lock();
 
                     if (!fichier->fut_chargé) {
-                        auto début_chargement = kuri::chrono::compte_seconde();
-                        auto texte = charge_contenu_fichier(fichier->chemin());
-                        temps_chargement += début_chargement.temps();
-
-                        auto début_tampon = kuri::chrono::compte_seconde();
-                        fichier->charge_tampon(TamponSource(texte));
-                        temps_tampons += début_tampon.temps();
+                        auto données = compilatrice.données_constantes_fichiers.trouve_ou_crée(
+                            fichier->chemin());
+                        données->mutex.lock();
+
+                        /* Le fichier peut avoir été chargé par un autre espace. */
+                        if (!données->fut_chargé) {
+                            auto début_chargement = kuri::chrono::compte_seconde();
+                            auto texte = charge_contenu_fichier(fichier->chemin());
+                            temps_chargement += début_chargement.temps();
+
+                            auto début_tampon = kuri::chrono::compte_seconde();
+                            données->tampon = TamponSource(texte);
+                            données->fut_chargé = true;
+                            temps_tampons += début_tampon.temps();
+                        }
+
+                        données->mutex.unlock();
+                        fichier->partage_données_constantes(données);
                     }
 
                     fichier->mutex.unlock();
@@ -334,9 +526,11 @@ bool Tacheronne::gère_tâche()
                     if (!fichier->en_lexage) {
                         fichier->en_lexage = true;
                         auto début_lexage = kuri::chrono::compte_seconde();
-                        auto lexeuse = Lexeuse(compilatrice.contexte_lexage(unité->espace),
-                                               fichier);
-                        lexeuse.performe_lexage();
+                        if (!compilatrice.données_constantes_fichiers.copie_lexèmes(fichier)) {
+                            auto lexeuse = Lexeuse(compilatrice.contexte_lexage(unité->espace),
+                                                   fichier);
+                            lexeuse.performe_lexage();
+                        }
                         temps_lexage += début_lexage.temps();
                         fichier->en_lexage = false;
                     }
@@ -364,6 +558,7 @@ bool Tacheronne::gère_tâche()
                 auto syntaxeuse = Syntaxeuse(&contexte, unité);
                 syntaxeuse.analyse();
                 unité->fichier->fut_parsé = true;
+                compilatrice.données_constantes_fichiers.publie_lexèmes(unité->fichier);
                 compilatrice.gestionnaire_code->tâche_unité_terminée(tâche.unité);
                 temps_parsage += début_parsage.temps();
                 break;
@@ -414,6 +609,12 @@ bool Tacheronne::gère_tâche()
                         "de la création de la représentation intermédiaire du programme.");
                     return true;
                 }
+                /* Les métaprogrammes sont exécutés depuis le code binaire de la machine
+                 * virtuelle, déjà généré depuis la RI. */
+                if (espace.options.niveau_optimisation > NiveauOptimisation::O0 &&
+                    !programme->pour_métaprogramme()) {
+                    optimise_programme(espace, *repr_inter);
+                }
                 if (compilatrice.arguments.émets_ri && !programme->pour_métaprogramme()) {
                     auto chemin_fichier_ri = programme->donne_chemin_pour_fichier_ri();
                     info() << "Écriture de '" << chemin_fichier_ri << "' ...";
@@ -505,6 +706,11 @@ bool Tacheronne::gère_tâche()
                 break;
             }
         }
+
+        if (trace_active) {
+            événement_trace.fin = compilatrice.horloge_trace.temps();
+            trace.événements.ajoute(événement_trace);
+        }
     }
 
     temps_scene += temps_début.temps() - temps_executable - temps_fichier_objet;
@@ -565,6 +771,27 @@ bool Tacheronne::gère_unité_pour_ri(UnitéCompilation *unité)
     return true;
 }
 
+static bool peut_optimiser_fonction(EspaceDeTravail const &espace, AtomeFonction const *atome)
+{
+    if (atome->est_externe || atome->instructions.est_vide()) {
+        return false;
+    }
+
+    /* N'optimise pas cette fonction car le manque de retour supprime tout le code. */
+    if (atome->decl && atome->decl == espace.interface_kuri->decl_creation_contexte) {
+        return false;
+    }
+
+    /* Les coulisses traitent spécialement les paramètres des points d'entrée (p.e. argv en C)
+     * lors de l'appel à __init_contexte_kuri, qui ne doit donc pas être enligné. */
+    if (atome->decl && (atome->decl->ident == ID::__point_d_entree_systeme ||
+                        atome->decl->ident == ID::__point_d_entree_dynamique)) {
+        return false;
+    }
+
+    return true;
+}
+
 void Tacheronne::gère_unité_pour_optimisation(UnitéCompilation *unité)
 {
     auto noeud = unité->noeud;
@@ -575,13 +802,33 @@ void Tacheronne::gère_unité_pour_optimisation(UnitéCompilation *unité)
         return;
     }
 
-    /* N'optimise pas cette fonction car le manque de retour supprime tout le code. */
-    if (entête == unité->espace->interface_kuri->decl_creation_contexte) {
+    auto atome = entête->atome->comme_fonction();
+    if (!peut_optimiser_fonction(*unité->espace, atome)) {
         return;
     }
 
+    constructrice_ri.commence_espace(unité->espace);
     optimise_code(
-        *unité->espace, constructrice_ri.donne_constructrice(), entête->atome->comme_fonction());
+        *unité->espace, constructrice_ri.donne_constructrice(), atome, &stats_enlignage);
+    constructrice_ri.termine_espace();
+}
+
+void Tacheronne::optimise_programme(EspaceDeTravail &espace,
+                                    ProgrammeRepreInter const &repr_inter)
+{
+    auto début_optimisation = kuri::chrono::compte_seconde();
+    constructrice_ri.commence_espace(&espace);
+
+    POUR (repr_inter.donne_fonctions()) {
+        if (!peut_optimiser_fonction(espace, it)) {
+            continue;
+        }
+
+        optimise_code(espace, constructrice_ri.donne_constructrice(), it, &stats_enlignage);
+    }
+
+    constructrice_ri.termine_espace();
+    temps_optimisation += début_optimisation.temps();
 }
 
 void Tacheronne::gère_unité_pour_exécution(UnitéCompilation *unité)
@@ -879,7 +1126,7 @@ NoeudExpression *Tacheronne::noeud_syntaxique_depuis_résultat(
                 const_cast<char *>(chaine.pointeur()));
 
             auto lit_chaine = assembleuse->crée_littérale_chaine(lexème);
-            lit_chaine->valeur = compilatrice.gérante_chaine->ajoute_chaine(chaine);
+            lit_chaine->valeur = compilatrice.gérante_chaine.ajoute_chaine(chaine);
             lit_chaine->type = type;
 
             if (la_mémoire_fut_allouée) {
@@ -1051,13 +1298,18 @@ void Tacheronne::rassemble_statistiques(Statistiques &stats)
     constructrice_ri.rassemble_statistiques(stats);
     allocatrice_noeud.rassemble_statistiques(stats);
 
+    stats.stats_enlignage += stats_enlignage;
+
     stats.ajoute_mémoire_utilisée("Compilatrice", lexèmes_extra.mémoire_utilisée());
 
     if (mv) {
         mv->rassemble_statistiques(stats);
     }
 
-    // std::cerr << "tâcheronne " << id << " a dormis pendant " << temps_passé_à_dormir << "ms\n";
+    auto entrée_file = EntréeFileTâches{};
+    entrée_file.tacheronne = id;
+    entrée_file.temps_passé_à_dormir = temps_passe_à_dormir;
+    stats.stats_files_tâches.fusionne_entrée(entrée_file);
 }
 
 void Tacheronne::initialise_contexte(Contexte *contexte, EspaceDeTravail *espace)
@@ -3,6 +3,10 @@
 
 #pragma once
 
+#include <atomic>
+#include <limits>
+#include <mutex>
+
 #include "arbre_syntaxique/allocatrice.hh"
 
 #include "parsage/outils_lexemes.hh"
@@ -14,6 +18,7 @@
 #include "broyage.hh"
 #include "statistiques/statistiques.hh"
 #include "tache.hh"
+#include "trace_taches.hh"
 #include "unite_compilation.hh"
 
 #include "../representation_intermediaire/constructrice_ri.hh"
@@ -24,6 +29,7 @@ struct Compilatrice;
 struct ContexteAnalyseRI;
 struct DétectriceFuiteDeMémoire;
 struct MachineVirtuelle;
+struct ProgrammeRepreInter;
 struct Tacheronne;
 
 /* Drapeaux pour les tâches étant dans des files. */
@@ -41,6 +47,20 @@ DEFINIS_OPERATEURS_DRAPEAU(DrapeauxTacheronne)
 
 std::ostream &operator<<(std::ostream &os, DrapeauxTacheronne drapeaux);
 
+/* Ordonnanceuse des tâches.
+ *
+ * Chaque tacheronne possède ses propres files de tâches, protégées par son propre verrou. Pour
+ * chaque genre de tâche, une tacheronne prend la plus ancienne tâche parmi toutes les files, en
+ * volant au besoin dans celles des autres tacheronnes. Les genres de tâches sont considérés dans
+ * l'ordre de leurs files et, pour un genre, les tâches dans l'ordre de leur création, comme pour
+ * une file globale, car le GestionnaireCode dépend de cet ordre (par exemple, les fonctions
+ * d'initialisation des types sont créées avant la génération de RI de leurs utilisatrices). Les
+ * capacités des tacheronnes (DrapeauxTacheronne) sont respectées lors des vols : une tacheronne
+ * ne prend que les tâches des files qu'elle peut gérer.
+ *
+ * Les tâches sont créées par le GestionnaireCode quand toutes les files sont vides, ce qui n'est
+ * fait que par une seule tacheronne à la fois. Les tâches créées sont ensuite distribuées à tour
+ * de rôle dans les files des tacheronnes. */
 struct OrdonnanceuseTache {
   public:
     enum {
@@ -54,13 +74,6 @@ struct OrdonnanceuseTache {
     };
 
   private:
-    Compilatrice *m_compilatrice = nullptr;
-
-    kuri::file<Tâche> tâches[NOMBRE_FILES];
-
-    int nombre_de_tacheronnes = 0;
-    bool compilation_terminée = false;
-
     // Tiens trace du nombre maximal de tâches par file, afin de générer des statistiques.
     struct PiqueTailleFile {
         int64_t tâches[OrdonnanceuseTache::NOMBRE_FILES];
@@ -86,17 +99,72 @@ struct OrdonnanceuseTache {
         }
     };
 
-    PiqueTailleFile pique_taille{};
+    /* Les tâches sont numérotées lors de leur création afin de pouvoir toujours prendre la plus
+     * ancienne tâche d'un genre parmi toutes les files. */
+    struct TâcheNumérotée {
+        Tâche tâche{};
+        uint64_t séquence = 0;
+    };
+
+    static constexpr uint64_t SÉQUENCE_FILE_VIDE = std::numeric_limits<uint64_t>::max();
+
+    /* Les files de chaque tacheronne sont logées séparément, afin que les tacheronnes ne se
+     * partagent pas les lignes de cache des compteurs. */
+    struct FilesTacheronne {
+        std::mutex verrou{};
+        kuri::file<TâcheNumérotée> tâches[NOMBRE_FILES];
+        PiqueTailleFile pique_taille{};
+
+        /* Séquence de la tâche en tête de chaque file, ou SÉQUENCE_FILE_VIDE, afin de pouvoir
+         * choisir une file sans prendre les verrous. */
+        std::atomic<uint64_t> séquences_têtes[NOMBRE_FILES];
+
+        /* Statistiques. */
+        std::atomic<int64_t> nombre_tâches_prises{0};
+        std::atomic<int64_t> nombre_tâches_volées{0};
+        std::atomic<int64_t> nombre_contentions{0};
+
+        FilesTacheronne()
+        {
+            POUR (séquences_têtes) {
+                it = SÉQUENCE_FILE_VIDE;
+            }
+        }
+
+        void actualise_séquence_tête(int indice_file)
+        {
+            auto const &file = tâches[indice_file];
+            séquences_têtes[indice_file] = file.est_vide() ? SÉQUENCE_FILE_VIDE :
+                                                             file.front().séquence;
+        }
+    };
+
+    Compilatrice *m_compilatrice = nullptr;
+
+    kuri::tableau<FilesTacheronne *> m_files_tacheronnes{};
+
+    /* Verrou pour la création de tâches par le GestionnaireCode. */
+    std::mutex m_verrou_création{};
+    /* Les tâches créées par le GestionnaireCode ne sont distribuées qu'à la fin de la création,
+     * afin que les tâches des espaces erronés puissent être supprimées avant d'être prises. */
+    kuri::tableau<Tâche> m_tâches_créées{};
+    int64_t m_décalage_distribution = 0;
+    std::atomic<uint64_t> m_séquence_suivante{0};
+
+    std::atomic<int64_t> m_nombre_tâches_en_attente{0};
+    std::atomic<bool> compilation_terminée{false};
 
   public:
     OrdonnanceuseTache() = default;
     OrdonnanceuseTache(Compilatrice *compilatrice);
 
+    ~OrdonnanceuseTache();
+
     EMPECHE_COPIE(OrdonnanceuseTache);
 
     void crée_tâche_pour_unité(UnitéCompilation *unité);
 
-    Tâche tâche_suivante(Tâche &tache_terminee, DrapeauxTacheronne drapeaux);
+    Tâche tâche_suivante(Tâche &tache_terminee, DrapeauxTacheronne drapeaux, int id_tacheronne);
 
     int64_t mémoire_utilisée() const;
 
@@ -113,8 +181,16 @@ struct OrdonnanceuseTache {
 
     void imprime_données_files(std::ostream &os);
 
+    void rassemble_statistiques(Statistiques &stats) const;
+
   private:
-    int64_t nombre_de_tâches_en_attente() const;
+    void crée_tâches();
+
+    void distribue_tâches_créées();
+
+    bool prends_tâche(int id_tacheronne, DrapeauxTacheronne drapeaux, Tâche &résultat);
+
+    void enfile(FilesTacheronne &files, int indice_file, Tâche const &tâche, uint64_t séquence);
 };
 
 struct Tacheronne {
@@ -144,12 +220,17 @@ struct Tacheronne {
     double temps_tampons = 0.0;
     double temps_optimisation = 0.0;
 
+    StatistiquesEnlignage stats_enlignage{};
+
     DrapeauxTacheronne drapeaux = DrapeauxTacheronne::PEUT_TOUT_FAIRE;
 
     int id = 0;
     int nombre_dodos = 0;
     double temps_passe_à_dormir = 0.0;
 
+    /* Remplie si --trace_tâches fut renseigné. */
+    TraceTâches trace{};
+
     Tacheronne(Compilatrice &comp);
 
     ~Tacheronne();
@@ -166,6 +247,7 @@ struct Tacheronne {
     void gère_unité_pour_typage(UnitéCompilation *unité);
     bool gère_unité_pour_ri(UnitéCompilation *unité);
     void gère_unité_pour_optimisation(UnitéCompilation *unité);
+    void optimise_programme(EspaceDeTravail &espace, ProgrammeRepreInter const &repr_inter);
     void gère_unité_pour_exécution(UnitéCompilation *unité);
 
     void exécute_métaprogrammes();
@@ -0,0 +1,250 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * The Original Code is Copyright (C) 2026 Kévin Dietrich. */
+
+#include "trace_taches.hh"
+
+#include <algorithm>
+#include <fstream>
+
+#include "arbre_syntaxique/noeud_expression.hh"
+
+#include "parsage/identifiant.hh"
+#include "parsage/modules.hh"
+
+#include "structures/enchaineuse.hh"
+
+#include "espace_de_travail.hh"
+#include "metaprogramme.hh"
+#include "operateurs.hh"
+
+static kuri::chaine_statique donne_nom_pour_trace(IdentifiantCode const *ident)
+{
+    if (!ident) {
+        return "";
+    }
+    return ident->nom;
+}
+
+static kuri::chaine_statique donne_nom_pour_trace(UnitéCompilation const *unité)
+{
+    switch (unité->donne_raison_d_être()) {
+        case RaisonDÊtre::CHARGEMENT_FICHIER:
+        case RaisonDÊtre::LEXAGE_FICHIER:
+        case RaisonDÊtre::PARSAGE_FICHIER:
+        {
+            return unité->fichier->nom();
+        }
+        case RaisonDÊtre::TYPAGE:
+        case RaisonDÊtre::GENERATION_RI:
+        case RaisonDÊtre::CONVERSION_NOEUD_CODE:
+        {
+            return donne_nom_pour_trace(unité->noeud->ident);
+        }
+        case RaisonDÊtre::CREATION_FONCTION_INIT_TYPE:
+        case RaisonDÊtre::CALCULE_TAILLE_TYPE:
+        {
+            return donne_nom_pour_trace(unité->type->ident);
+        }
+        case RaisonDÊtre::GENERATION_RI_PRINCIPALE_MP:
+        case RaisonDÊtre::EXECUTION:
+        {
+            auto fonction = unité->métaprogramme->fonction;
+            return fonction ? donne_nom_pour_trace(fonction->ident) : "";
+        }
+        case RaisonDÊtre::SYNTHÉTISATION_OPÉRATEUR:
+        {
+            return chaine_pour_genre_op(unité->opérateur_binaire->genre);
+        }
+        case RaisonDÊtre::AUCUNE:
+        case RaisonDÊtre::ENVOIE_MESSAGE:
+        case RaisonDÊtre::LIAISON_PROGRAMME:
+        case RaisonDÊtre::GENERATION_CODE_MACHINE:
+        {
+            break;
+        }
+    }
+
+    return "";
+}
+
+ÉvénementTâche débute_événement_tâche(Tâche const &tâche, HorlogeTrace const &horloge)
+{
+    auto résultat = ÉvénementTâche{};
+    résultat.genre = tâche.genre;
+    résultat.unité = tâche.unité;
+    if (tâche.unité) {
+        résultat.raison_d_être = tâche.unité->donne_raison_d_être();
+        résultat.nom = donne_nom_pour_trace(tâche.unité);
+    }
+    if (tâche.espace) {
+        résultat.nom_espace = tâche.espace->nom;
+    }
+    résultat.début = horloge.temps();
+    return résultat;
+}
+
+ÉvénementAttente crée_événement_attente(UnitéCompilation const *unité,
+                                         Attente const &attente,
+                                         HorlogeTrace const &horloge)
+{
+    auto résultat = ÉvénementAttente{};
+    résultat.unité = unité;
+    résultat.temps = horloge.temps();
+    résultat.commentaire = attente.donne_commentaire(unité);
+    return résultat;
+}
+
+/* ------------------------------------------------------------------------- */
+/** \name Écriture de la trace.
+ * \{ */
+
+static void imprime_temps(Enchaineuse &os, double temps)
+{
+    os << int64_t(temps);
+}
+
+struct ÉvénementÀÉcrire {
+    ÉvénementTâche const *événement = nullptr;
+    int id_tacheronne = 0;
+    /* Index de la première attente émise lors de l'exécution de la tâche, dans le tableau des
+     * attentes. Les suivantes sont chainées via attente_suivante. */
+    int première_attente = -1;
+};
+
+static bool est_avant(ÉvénementÀÉcrire const &a, ÉvénementÀÉcrire const &b)
+{
+    if (a.événement->unité != b.événement->unité) {
+        return a.événement->unité < b.événement->unité;
+    }
+    return a.événement->début < b.événement->début;
+}
+
+/* Trouve la tâche exécutant l'unité de l'attente au moment où elle fut émise. */
+static ÉvénementÀÉcrire *trouve_événement_pour_attente(
+    kuri::tableau<ÉvénementÀÉcrire, int> &événements, ÉvénementAttente const &attente)
+{
+    auto clé = ÉvénementTâche{};
+    clé.unité = attente.unité;
+    clé.début = attente.temps;
+
+    /* Le premier événement de l'unité débutant après l'attente. */
+    auto iter = std::upper_bound(
+        événements.begin(), événements.end(), ÉvénementÀÉcrire{&clé}, est_avant);
+    if (iter == événements.begin()) {
+        return nullptr;
+    }
+
+    --iter;
+    if (iter->événement->unité != attente.unité || iter->événement->fin < attente.temps) {
+        return nullptr;
+    }
+
+    return iter;
+}
+
+static void imprime_attente(Enchaineuse &os,
+                            ÉvénementAttente const &attente,
+                            ÉvénementÀÉcrire const *événement)
+{
+    os << "{\"name\":\"attente\",\"cat\":\"attente\",\"ph\":\"i\",\"ts\":";
+    imprime_temps(os, attente.temps);
+    if (événement) {
+        os << ",\"s\":\"t\",\"pid\":1,\"tid\":" << événement->id_tacheronne;
+    }
+    else {
+        os << ",\"s\":\"g\",\"pid\":1,\"tid\":0";
+    }
+    os << ",\"args\":{\"attente\":";
+    imprime_chaine_json(os, attente.commentaire);
+    os << "}}";
+}
+
+bool écris_trace_tâches(kuri::chemin_systeme const &chemin,
+                        kuri::tableau_statique<TraceTâches const *> traces,
+                        kuri::tableau_statique<ÉvénementAttente> attentes)
+{
+    std::ofstream fichier(vers_std_path(chemin));
+    if (!fichier.is_open()) {
+        return false;
+    }
+
+    kuri::tableau<ÉvénementÀÉcrire, int> événements;
+    POUR (traces) {
+        for (auto const &événement : it->événements) {
+            événements.ajoute({&événement, it->id_tacheronne});
+        }
+    }
+
+    std::sort(événements.begin(), événements.end(), est_avant);
+
+    /* Associe les attentes aux tâches. */
+    kuri::tableau<int, int> attente_suivante;
+    attente_suivante.redimensionne(int(attentes.taille()), -1);
+    kuri::tableau<ÉvénementÀÉcrire const *, int> événement_pour_attente;
+    événement_pour_attente.redimensionne(int(attentes.taille()), nullptr);
+
+    for (auto i = int(attentes.taille()) - 1; i >= 0; i--) {
+        auto événement = trouve_événement_pour_attente(événements, attentes[i]);
+        if (!événement) {
+            continue;
+        }
+
+        attente_suivante[i] = événement->première_attente;
+        événement->première_attente = i;
+        événement_pour_attente[i] = événement;
+    }
+
+    Enchaineuse os;
+    os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+    auto virgule = "";
+    POUR (traces) {
+        os << virgule << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+           << it->id_tacheronne << ",\"args\":{\"name\":\"Tacheronne " << it->id_tacheronne
+           << "\"}}";
+        virgule = ",\n";
+    }
+
+    POUR (événements) {
+        auto const &événement = *it.événement;
+
+        os << virgule << "{\"name\":\"" << chaine_genre_tâche(événement.genre) << "\"";
+        os << ",\"cat\":\"" << chaine_raison_d_être(événement.raison_d_être) << "\"";
+        os << ",\"ph\":\"X\",\"ts\":";
+        imprime_temps(os, événement.début);
+        os << ",\"dur\":";
+        imprime_temps(os, événement.fin - événement.début);
+        os << ",\"pid\":1,\"tid\":" << it.id_tacheronne;
+
+        os << ",\"args\":{\"unité\":";
+        imprime_chaine_json(os, événement.nom);
+        os << ",\"espace\":";
+        imprime_chaine_json(os, événement.nom_espace);
+
+        if (it.première_attente != -1) {
+            os << ",\"attentes\":[";
+            auto virgule_attente = "";
+            for (auto i = it.première_attente; i != -1; i = attente_suivante[i]) {
+                os << virgule_attente;
+                imprime_chaine_json(os, attentes[i].commentaire);
+                virgule_attente = ",";
+            }
+            os << "]";
+        }
+
+        os << "}}";
+        virgule = ",\n";
+    }
+
+    for (auto i = 0; i < attentes.taille(); i++) {
+        os << virgule;
+        imprime_attente(os, attentes[i], événement_pour_attente[i]);
+        virgule = ",\n";
+    }
+
+    os << "\n]}\n";
+    os.imprime_dans_flux(fichier);
+    return true;
+}
+
+/** \} */
@@ -0,0 +1,64 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * The Original Code is Copyright (C) 2026 Kévin Dietrich. */
+
+#pragma once
+
+#include "structures/chaine.hh"
+#include "structures/chemin_systeme.hh"
+#include "structures/tableau.hh"
+
+#include "utilitaires/chrono.hh"
+
+#include "tache.hh"
+#include "unite_compilation.hh"
+
+/* ------------------------------------------------------------------------- */
+/** \name Trace des tâches.
+ *
+ * Si --trace_tâches fut renseigné, chaque tacheronne enregistre les tâches qu'elle exécute, et le
+ * GestionnaireCode les mises en attente des unités de compilation. Le tout est écrit à la fin de
+ * la compilation au format « Trace Event » de Chrome, qui peut être lu avec chrome://tracing ou
+ * ui.perfetto.dev, afin de voir quelles unités attendent sur quoi et quand.
+ *
+ * Sans l'option, rien n'est enregistré : les tacheronnes ne font que tester un booléen.
+ * \{ */
+
+/* Horloge commune à tous les événements, en microsecondes depuis le début de la compilation. */
+using HorlogeTrace = kuri::chrono::compte_temps<1>;
+
+struct ÉvénementTâche {
+    GenreTâche genre{};
+    RaisonDÊtre raison_d_être{};
+    UnitéCompilation const *unité = nullptr;
+    /* Ce que compile l'unité. Les données vivent aussi longtemps que la compilation. */
+    kuri::chaine_statique nom{};
+    kuri::chaine_statique nom_espace{};
+    double début = 0.0;
+    double fin = 0.0;
+};
+
+struct ÉvénementAttente {
+    UnitéCompilation const *unité = nullptr;
+    double temps = 0.0;
+    kuri::chaine commentaire{};
+};
+
+/* Les événements d'une tacheronne. */
+struct TraceTâches {
+    int id_tacheronne = 0;
+    kuri::tableau<ÉvénementTâche, int> événements{};
+};
+
+ÉvénementTâche débute_événement_tâche(Tâche const &tâche, HorlogeTrace const &horloge);
+
+ÉvénementAttente crée_événement_attente(UnitéCompilation const *unité,
+                                         Attente const &attente,
+                                         HorlogeTrace const &horloge);
+
+/* Écris les événements au format JSON de Chrome. Chaque tâche est associée aux attentes émises
+ * par son unité lors de son exécution. Retourne faux si le fichier ne peut être ouvert. */
+bool écris_trace_tâches(kuri::chemin_systeme const &chemin,
+                        kuri::tableau_statique<TraceTâches const *> traces,
+                        kuri::tableau_statique<ÉvénementAttente> attentes);
+
+/** \} */
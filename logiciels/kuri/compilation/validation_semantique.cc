@@ -459,6 +459,7 @@ RésultatValidation Sémanticienne::valide_sémantique_noeud(NoeudExpression *no
                     *m_unité->espace, noeud, noeud->ident, lexème_nom_bibliothèque->chaine);
             noeud->drapeaux |= DrapeauxNoeud::DECLARATION_FUT_VALIDEE;
             noeud->bloc_parent->ajoute_rubrique(noeud->comme_déclaration_bibliothèque());
+            noeud->bloc_parent->publie_index_rubriques();
             break;
         }
         case GenreNoeud::DÉCLARATION_ENTÊTE_FONCTION:
@@ -580,7 +581,7 @@ RésultatValidation Sémanticienne::valide_sémantique_noeud(NoeudExpression *no
             if (insère->fichier == nullptr) {
                 auto fichier = m_compilatrice.crée_fichier_pour_insère(m_espace, insère);
                 auto littérale = expression_ou_résultat_exécution->comme_littérale_chaine();
-                auto source = m_compilatrice.gérante_chaine->chaine_pour_adresse(
+                auto source = m_compilatrice.gérante_chaine.chaine_pour_adresse(
                     littérale->valeur);
                 fichier->charge_tampon(TamponSource(source));
                 return Attente::sur_parsage(fichier);
@@ -5734,7 +5735,7 @@ RésultatValidation Sémanticienne::valide_opérateur_binaire_type(NoeudExpressi
             auto &table_identifiants = m_compilatrice.table_identifiants;
 
             for (auto i = 2; i < expressions_rubriques.taille(); i++) {
-                auto ident = table_identifiants->identifiant_pour_nouvelle_chaine(enchaine(i));
+                auto ident = table_identifiants.identifiant_pour_nouvelle_chaine(enchaine(i));
                 noms_rubriques.ajoute(ident);
             }
 
@@ -0,0 +1,141 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * The Original Code is Copyright (C) 2026 Kévin Dietrich. */
+
+/* Mesure le débit de la Lexeuse sur tous les fichiers Kuri d'un dossier.
+ *
+ * Utilisation : bench_lexage DOSSIER [RÉPÉTITIONS] [--commentaires]
+ *
+ * Avec --commentaires, les commentaires et guillemets sont inclus dans les lexèmes, comme le fait
+ * kuri_format. */
+
+#include <cstring>
+
+#include "compilation/compilatrice.hh"
+#include "compilation/espace_de_travail.hh"
+
+#include "parsage/lexeuse.hh"
+#include "parsage/modules.hh"
+
+#include "structures/chemin_systeme.hh"
+#include "structures/format.hh"
+
+#include "utilitaires/chrono.hh"
+#include "utilitaires/log.hh"
+
+/* Empreinte FNV-1a des lexèmes, pour vérifier qu'une optimisation de la Lexeuse ne change pas
+ * son résultat. */
+static uint64_t calcule_empreinte_lexèmes(kuri::tableau_statique<Fichier *> fichiers)
+{
+    auto empreinte = uint64_t(14695981039346656037ull);
+    auto mélange = [&](uint64_t valeur) {
+        empreinte ^= valeur;
+        empreinte *= 1099511628211ull;
+    };
+
+    POUR (fichiers) {
+        for (auto const &lexème : it->lexèmes) {
+            mélange(uint64_t(lexème.genre));
+            mélange(uint64_t(lexème.ligne));
+            mélange(uint64_t(lexème.colonne));
+            for (auto c : lexème.chaine) {
+                mélange(uint64_t(static_cast<unsigned char>(c)));
+            }
+        }
+    }
+
+    return empreinte;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2) {
+        dbg() << "Utilisation : " << argv[0] << " DOSSIER [RÉPÉTITIONS] [--commentaires]";
+        return 1;
+    }
+
+    auto chemin_dossier = kuri::chemin_systeme::absolu(kuri::chemin_systeme(argv[1]));
+    if (!kuri::chemin_systeme::est_dossier(chemin_dossier)) {
+        dbg() << "Le chemin " << chemin_dossier << " ne pointe pas vers un dossier.";
+        return 1;
+    }
+
+    auto répétitions = 10;
+    auto drapeaux = 0;
+    for (auto i = 2; i < argc; i++) {
+        if (strcmp(argv[i], "--commentaires") == 0) {
+            drapeaux = INCLUS_COMMENTAIRES | INCLUS_GUILLEMETS;
+        }
+        else {
+            répétitions = std::max(1, atoi(argv[i]));
+        }
+    }
+
+    auto arguments = ArgumentsCompilatrice{};
+    arguments.importe_kuri = false;
+    /* Nous mesurons le lexage, pas le chargement depuis le cache. */
+    arguments.utilise_cache_lexèmes = false;
+    auto compilatrice = Compilatrice("", arguments);
+    auto espace = EspaceDeTravail(compilatrice, {}, "");
+    auto &sys_module = espace.sys_module;
+
+    /* Chargement des fichiers, hors de la mesure. */
+    kuri::tableau<Fichier *, int> fichiers;
+    auto octets_par_passe = int64_t(0);
+
+    auto chemins = kuri::chemin_systeme::fichiers_du_dossier_récursif(chemin_dossier);
+    POUR (chemins) {
+        auto module = sys_module->trouve_ou_crée_module(nullptr, it.chemin_parent());
+        auto résultat_fichier = sys_module->trouve_ou_crée_fichier(
+            module, it.nom_fichier(), it);
+        if (!std::holds_alternative<FichierNeuf>(résultat_fichier)) {
+            continue;
+        }
+
+        auto fichier = static_cast<Fichier *>(std::get<FichierNeuf>(résultat_fichier));
+        auto tampon = charge_contenu_fichier({it.pointeur(), it.taille()});
+        fichier->charge_tampon(TamponSource(std::move(tampon)));
+
+        octets_par_passe += fichier->tampon().chaine().taille();
+        fichiers.ajoute(fichier);
+    }
+
+    auto meilleur_temps = std::numeric_limits<double>::max();
+    auto temps_total = 0.0;
+    auto nombre_de_lexèmes = int64_t(0);
+
+    for (auto i = 0; i < répétitions; i++) {
+        nombre_de_lexèmes = 0;
+
+        auto début = kuri::chrono::compte_seconde();
+        POUR (fichiers) {
+            it->lexèmes.efface();
+            auto lexeuse = Lexeuse(compilatrice.contexte_lexage(nullptr), it, drapeaux);
+            lexeuse.performe_lexage();
+            nombre_de_lexèmes += it->lexèmes.taille();
+        }
+        auto temps = début.temps();
+
+        meilleur_temps = std::min(meilleur_temps, temps);
+        temps_total += temps;
+    }
+
+    if (compilatrice.possède_erreur()) {
+        return 1;
+    }
+
+    auto const mégaoctets = double(octets_par_passe) / (1024.0 * 1024.0);
+
+    dbg() << "Fichiers            : " << fichiers.taille();
+    dbg() << "Taille              : " << taille_octet(size_t(octets_par_passe));
+    dbg() << "Lexèmes             : " << formatte_nombre(nombre_de_lexèmes);
+    dbg() << "Empreinte           : " << calcule_empreinte_lexèmes(fichiers);
+    dbg() << "Répétitions         : " << répétitions;
+    dbg() << "Temps moyen         : " << formatte_nombre(temps_total / répétitions * 1000.0)
+          << "ms";
+    dbg() << "Meilleur temps      : " << formatte_nombre(meilleur_temps * 1000.0) << "ms";
+    dbg() << "Débit (meilleur)    : " << formatte_nombre(mégaoctets / meilleur_temps) << " Mo/s";
+    dbg() << "Débit (moyen)       : "
+          << formatte_nombre(mégaoctets * répétitions / temps_total) << " Mo/s";
+
+    return 0;
+}
@@ -38,8 +38,11 @@ static void lance_application(DonneesCommandeKuri *donnees)
 {
     compilation_terminee = false;
 
+    /* Les compilations successives réutilisent les lexèmes des fichiers non-modifiés, ainsi que
+     * les fichiers objets des fichiers C dont le code n'a pas changé. */
     auto commande_kuri = enchaine("kuri ",
                                   donnees->fichier,
+                                  " --cache_lexèmes --compilation_incrémentale",
                                   " --emets_fichiers_utilises ",
                                   donnees->nom_fichier_fichier_utilises,
                                   '\0');
@@ -98,6 +98,28 @@ static void imprime_fichiers_utilises(Compilatrice &compilatrice)
     }
 }
 
+/**
+ * Écris la trace des tâches dans le fichier spécifié via la ligne de commande.
+ */
+static void émets_trace_tâches(Compilatrice &compilatrice,
+                               kuri::tableau<Tacheronne *> const &tacheronnes)
+{
+    if (!compilatrice.trace_tâches_active()) {
+        return;
+    }
+
+    kuri::tableau<TraceTâches const *> traces;
+    POUR (tacheronnes) {
+        traces.ajoute(&it->trace);
+    }
+
+    auto gestionnaire = compilatrice.gestionnaire_code.verrou_lecture();
+    auto const &chemin = compilatrice.arguments.chemin_trace_tâches;
+    if (!écris_trace_tâches(chemin, traces, gestionnaire->donne_attentes_tracées())) {
+        dbg() << "Impossible d'écrire la trace des tâches dans " << chemin;
+    }
+}
+
 static void rassemble_statistiques(Compilatrice &compilatrice,
                                    Statistiques &stats,
                                    kuri::tableau<Tacheronne *> const &tacheronnes)
@@ -238,6 +260,24 @@ static ActionParsageArgument gère_argument_parallélise_llvm(ParseuseArguments
 static ActionParsageArgument gère_argument_débogage_ne_compile_que_nécessaire(
     ParseuseArguments & /*parseuse*/, ArgumentsCompilatrice &résultat);
 
+static ActionParsageArgument gère_argument_cache_lexèmes(ParseuseArguments & /*parseuse*/,
+                                                         ArgumentsCompilatrice &résultat);
+
+static ActionParsageArgument gère_argument_compilation_incrémentale(
+    ParseuseArguments & /*parseuse*/, ArgumentsCompilatrice &résultat);
+
+static ActionParsageArgument gère_argument_jit_métaprogrammes(ParseuseArguments & /*parseuse*/,
+                                                              ArgumentsCompilatrice &résultat);
+
+static ActionParsageArgument gère_argument_code_binaire_registres(
+    ParseuseArguments & /*parseuse*/, ArgumentsCompilatrice &résultat);
+
+static ActionParsageArgument gère_argument_assembleur_interne(ParseuseArguments & /*parseuse*/,
+                                                              ArgumentsCompilatrice &résultat);
+
+static ActionParsageArgument gère_argument_trace_tâches(ParseuseArguments &parseuse,
+                                                        ArgumentsCompilatrice &résultat);
+
 static DescriptionArgumentCompilation descriptions_arguments[] = {
     {"--aide", "-a", "--aide, -a", "Imprime cette aide", gère_argument_aide},
     {"--", "", "", "Débute la liste des arguments pour les métaprogrammes", nullptr},
@@ -260,8 +300,10 @@ static DescriptionArgumentCompilation descriptions_arguments[] = {
      gère_argument_profile_exécution},
     {"--format_profile",
      "",
-     "--format_profile {défaut|gregg|échantillons_totaux}",
-     "Définit le format du fichier de profilage",
+     "--format_profile {défaut|gregg|échantillons_totaux|tableaux|speedscope}",
+     "Définit le format du fichier de profilage : piles au format de Brendan Gregg, nombre "
+     "d'échantillons par fonction, tableaux des temps propres et totaux par fonction, ligne et "
+     "instruction, ou JSON pour speedscope.app",
      gère_argument_format_profile},
     {"--débogue_exécution",
      "",
@@ -332,6 +374,43 @@ static DescriptionArgumentCompilation descriptions_arguments[] = {
      "de ne compiler que ce qui atteignable depuis la fonction principale (sans les "
      "initialisations des globales ou du lors-exécution.",
      gère_argument_débogage_ne_compile_que_nécessaire},
+    {"--cache_lexèmes",
+     "",
+     "",
+     "Sauvegarde les lexèmes des fichiers dans un cache sur disque, et réutilise ceux-ci lors "
+     "des compilations suivantes pour les fichiers n'ayant pas changé",
+     gère_argument_cache_lexèmes},
+    {"--compilation_incrémentale",
+     "",
+     "",
+     "Préserve les fichiers objets de la coulisse C entre les compilations, et ne recompile que "
+     "les fichiers C dont le contenu a changé depuis la dernière compilation",
+     gère_argument_compilation_incrémentale},
+    {"--jit_métaprogrammes",
+     "",
+     "",
+     "Compile en code machine, via la coulisse ASM, les fonctions des métaprogrammes appelées "
+     "souvent, au lieu de les interpréter",
+     gère_argument_jit_métaprogrammes},
+    {"--code_binaire_registres",
+     "",
+     "",
+     "Génère, pour les métaprogrammes, des instructions lisant leurs opérandes et écrivant leur "
+     "résultat directement dans les variables locales, au lieu de passer par la pile de valeurs",
+     gère_argument_code_binaire_registres},
+    {"--assembleur_interne",
+     "",
+     "",
+     "Pour la coulisse ASM, encode directement les instructions dans le fichier objet au lieu "
+     "d'imprimer le code assembleur et de l'assembler via nasm (expérimental)",
+     gère_argument_assembleur_interne},
+    {"--trace_tâches",
+     "",
+     "--trace_tâches FICHIER",
+     "Écris dans le fichier spécifié, au format JSON « Trace Event » de Chrome, les tâches "
+     "exécutées par chaque tacheronne ainsi que les mises en attente des unités de compilation. "
+     "Le fichier peut être lu avec chrome://tracing ou ui.perfetto.dev",
+     gère_argument_trace_tâches},
 };
 
 static std::optional<DescriptionArgumentCompilation> donne_description_pour_arg(
@@ -470,6 +549,16 @@ static ActionParsageArgument gère_argument_format_profile(ParseuseArguments &pa
         return ActionParsageArgument::CONTINUE;
     }
 
+    if (arg.value() == "tableaux") {
+        résultat.format_rapport_profilage = FormatRapportProfilage::TABLEAUX;
+        return ActionParsageArgument::CONTINUE;
+    }
+
+    if (arg.value() == "speedscope") {
+        résultat.format_rapport_profilage = FormatRapportProfilage::SPEEDSCOPE;
+        return ActionParsageArgument::CONTINUE;
+    }
+
     dbg() << "Type de format de profile \"" << arg.value() << "\" inconnu.";
     return ActionParsageArgument::ARRÊTE_CAR_ERREUR;
 }
@@ -544,6 +633,53 @@ static ActionParsageArgument gère_argument_débogage_ne_compile_que_nécessaire
     return ActionParsageArgument::CONTINUE;
 }
 
+static ActionParsageArgument gère_argument_cache_lexèmes(ParseuseArguments & /*parseuse*/,
+                                                         ArgumentsCompilatrice &résultat)
+{
+    résultat.utilise_cache_lexèmes = true;
+    return ActionParsageArgument::CONTINUE;
+}
+
+static ActionParsageArgument gère_argument_compilation_incrémentale(
+    ParseuseArguments & /*parseuse*/, ArgumentsCompilatrice &résultat)
+{
+    résultat.compilation_incrémentale = true;
+    return ActionParsageArgument::CONTINUE;
+}
+
+static ActionParsageArgument gère_argument_jit_métaprogrammes(ParseuseArguments & /*parseuse*/,
+                                                              ArgumentsCompilatrice &résultat)
+{
+    résultat.jit_métaprogrammes = true;
+    return ActionParsageArgument::CONTINUE;
+}
+
+static ActionParsageArgument gère_argument_code_binaire_registres(
+    ParseuseArguments & /*parseuse*/, ArgumentsCompilatrice &résultat)
+{
+    résultat.code_binaire_registres = true;
+    return ActionParsageArgument::CONTINUE;
+}
+
+static ActionParsageArgument gère_argument_assembleur_interne(ParseuseArguments & /*parseuse*/,
+                                                              ArgumentsCompilatrice &résultat)
+{
+    résultat.assembleur_interne = true;
+    return ActionParsageArgument::CONTINUE;
+}
+
+static ActionParsageArgument gère_argument_trace_tâches(ParseuseArguments &parseuse,
+                                                        ArgumentsCompilatrice &résultat)
+{
+    auto arg = parseuse.donne_argument_suivant();
+    if (!arg.has_value()) {
+        dbg() << "Argument manquant après --trace_tâches.";
+        return ActionParsageArgument::ARRÊTE_CAR_ERREUR;
+    }
+    résultat.chemin_trace_tâches = arg.value();
+    return ActionParsageArgument::CONTINUE;
+}
+
 static ActionParsageArgument gère_argument_coulisse(ParseuseArguments &parseuse,
                                                     ArgumentsCompilatrice &résultat)
 {
@@ -738,6 +874,8 @@ static bool compile_fichier(Compilatrice &compilatrice, kuri::chaine_statique ch
     /* restore le dossier d'origine */
     kuri::chemin_systeme::change_chemin_courant(dossier_origine);
 
+    émets_trace_tâches(compilatrice, tacheronnes);
+
     if (compilatrice.possède_erreur()) {
         return false;
     }
@@ -15,6 +15,8 @@
 #include "representation_intermediaire/impression.hh"
 #include "representation_intermediaire/syntaxage.hh"
 
+#include "statistiques/statistiques.hh"
+
 #include "structures/chemin_systeme.hh"
 
 #include "utilitaires/log.hh"
@@ -54,13 +56,43 @@ int main(int argc, char **argv)
 {
     if (argc < 2) {
         dbg() << "Utilisation " << argv[0] << " "
-              << "FICHIER_RI";
+              << "[--passes=LISTE] [--stats] FICHIER_RI";
         return 1;
     }
 
-    auto chemin_fichier_ri = kuri::chemin_systeme::chemin_temporaire(argv[1]);
+    auto passes = PassesFSAU::TOUTES;
+    auto imprime_statistiques = false;
+
+    for (auto i = 1; i < argc - 1; i++) {
+        auto argument = kuri::chaine_statique(argv[i]);
+
+        if (argument == "--stats") {
+            imprime_statistiques = true;
+            continue;
+        }
+
+        auto const préfixe_passes = kuri::chaine_statique("--passes=");
+        if (argument.taille() >= préfixe_passes.taille() &&
+            kuri::chaine_statique(argument.pointeur(), préfixe_passes.taille()) ==
+                préfixe_passes) {
+            auto passes_requises = donne_passes_fsau_pour_chaine(kuri::chaine_statique(
+                argument.pointeur() + préfixe_passes.taille(),
+                argument.taille() - préfixe_passes.taille()));
+            if (!passes_requises.has_value()) {
+                std::cerr << "Liste de passes '" << argv[i] << "' invalide.\n";
+                return 1;
+            }
+            passes = passes_requises.value();
+            continue;
+        }
+
+        std::cerr << "Argument '" << argv[i] << "' inconnu.\n";
+        return 1;
+    }
+
+    auto chemin_fichier_ri = kuri::chemin_systeme::chemin_temporaire(argv[argc - 1]);
     if (!kuri::chemin_systeme::existe(chemin_fichier_ri)) {
-        std::cerr << "Fichier '" << argv[1] << "' inconnu.";
+        std::cerr << "Fichier '" << argv[argc - 1] << "' inconnu.";
         return 1;
     }
 
@@ -124,10 +156,16 @@ int main(int argc, char **argv)
     syntaxeuse.analyse();
 
     auto contexte_analyse = ContexteAnalyseRI();
+    auto stats = StatistiquesFSAU();
+    auto code_sortie = 0;
 
     POUR (syntaxeuse.donne_fonctions()) {
 
-        convertis_fsau(espace, it, syntaxeuse.donne_constructrice());
+        convertis_fsau(espace,
+                       it,
+                       syntaxeuse.donne_constructrice(),
+                       passes,
+                       imprime_statistiques ? &stats : nullptr);
 
         auto résultat = supprime_espaces_blanches_autour(imprime_fonction(it));
         //        dbg() << résultat;
@@ -138,9 +176,14 @@ int main(int argc, char **argv)
             dbg() << résultat;
             dbg() << "Voulu :\n";
             dbg() << texte_résultat;
-            return 1;
+            code_sortie = 1;
+            break;
         }
     }
 
-    return 0;
+    if (imprime_statistiques) {
+        stats.imprime_stats();
+    }
+
+    return code_sortie;
 }
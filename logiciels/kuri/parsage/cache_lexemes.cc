@@ -0,0 +1,285 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * The Original Code is Copyright (C) 2026 Kévin Dietrich. */
+
+#include "cache_lexemes.hh"
+
+#include <atomic>
+#include <cstring>
+#include <fstream>
+
+#ifdef _MSC_VER
+#    include <process.h>
+#else
+#    include <unistd.h>
+#endif
+
+#include "statistiques/statistiques.hh"
+
+#include "structures/enchaineuse.hh"
+
+#include "lexemes.hh"
+#include "modules.hh"
+
+/* Incrémente ceci à chaque changement du format du cache ou de la manière de lexer. */
+static constexpr uint32_t VERSION_CACHE_LEXÈMES = 2;
+
+static constexpr char MAGIQUE_CACHE_LEXÈMES[8] = {'K', 'U', 'R', 'I', 'L', 'E', 'X', '\0'};
+
+struct EntêteCacheLexèmes {
+    char magique[8];
+    uint32_t version;
+    uint32_t nombre_lexèmes;
+    uint64_t signature_lexèmes;
+    uint64_t taille_source;
+    uint64_t empreinte_source;
+    /* Empreinte des lexèmes écrits, afin de détecter un fichier tronqué ou corrompu. */
+    uint64_t empreinte_lexèmes;
+    /* Le chemin du fichier source suit l'entête, afin de détecter les collisions d'empreintes
+     * des chemins. Les lexèmes suivent le chemin, alignés sur 8 octets. */
+    uint64_t taille_chemin;
+};
+
+struct LexèmeCache {
+    uint32_t genre;
+    /* Décalage et taille de la chaine du lexème dans le tampon source. */
+    uint32_t décalage;
+    uint32_t taille;
+    int32_t ligne;
+    int32_t colonne;
+    uint32_t rembourrage;
+    uint64_t valeur;
+};
+
+static_assert(sizeof(EntêteCacheLexèmes) == 56);
+static_assert(sizeof(LexèmeCache) == 32);
+
+static uint64_t arrondis_sur_8(uint64_t taille)
+{
+    return (taille + 7) & ~uint64_t(7);
+}
+
+static uint64_t empreinte_lexèmes_cache(kuri::tableau<LexèmeCache, int> const &lexèmes)
+{
+    auto const octets = kuri::chaine_statique(
+        reinterpret_cast<char const *>(lexèmes.données()),
+        static_cast<int64_t>(lexèmes.taille()) * static_cast<int64_t>(sizeof(LexèmeCache)));
+    return kuri::empreinte_fnv1a(octets);
+}
+
+/* Retourne un nom de fichier temporaire propre à ce processus et à cet appel, afin que deux
+ * compilations, ou deux espaces de travail, écrivant le même cache ne se marchent pas dessus
+ * avant le renommage. */
+static kuri::chemin_systeme chemin_temporaire_unique(kuri::chemin_systeme const &chemin)
+{
+    static std::atomic<uint64_t> compteur = 0;
+#ifdef _MSC_VER
+    auto const id_processus = _getpid();
+#else
+    auto const id_processus = getpid();
+#endif
+    return kuri::chemin_systeme(
+        enchaine(chemin, ".", id_processus, ".", compteur.fetch_add(1), ".tmp"));
+}
+
+/* Empreinte des noms des genres de lexèmes, afin d'invalider le cache si les lexèmes de la
+ * Compilatrice changent. */
+static uint64_t signature_genres_lexèmes()
+{
+    static const uint64_t signature = [] {
+        auto résultat = kuri::EMPREINTE_FNV1A_INITIALE;
+        for (auto i = 0u; i <= static_cast<uint32_t>(GenreLexème::INCONNU); i++) {
+            auto const genre = static_cast<GenreLexème>(i);
+            résultat = kuri::empreinte_fnv1a(chaine_du_genre_de_lexème(genre), résultat);
+            résultat = kuri::empreinte_fnv1a(";", résultat);
+        }
+        return résultat;
+    }();
+    return signature;
+}
+
+CacheLexèmes::CacheLexèmes(kuri::chemin_systeme dossier) : m_dossier(dossier)
+{
+    kuri::chemin_systeme::crée_dossiers(m_dossier);
+}
+
+kuri::chemin_systeme CacheLexèmes::dossier_défaut()
+{
+    return kuri::chemin_systeme::chemin_temporaire("cache_lexèmes_kuri");
+}
+
+kuri::chemin_systeme CacheLexèmes::chemin_cache_pour(Fichier const *fichier) const
+{
+    auto empreinte_chemin = kuri::empreinte_fnv1a(fichier->chemin());
+    auto nom = enchaine(fichier->nom(), "_", empreinte_chemin, ".lexèmes");
+    return m_dossier / nom;
+}
+
+bool CacheLexèmes::charge_lexèmes(Fichier *fichier)
+{
+    auto const &tampon = fichier->tampon();
+    auto const taille_source = static_cast<uint64_t>(tampon.chaine().taille());
+
+    std::ifstream flux(vers_std_path(chemin_cache_pour(fichier)),
+                       std::ios::in | std::ios::binary);
+    if (!flux.is_open()) {
+        m_nombre_échecs += 1;
+        return false;
+    }
+
+    auto entête = EntêteCacheLexèmes{};
+    if (!flux.read(reinterpret_cast<char *>(&entête), sizeof(entête))) {
+        m_nombre_échecs += 1;
+        return false;
+    }
+
+    if (memcmp(entête.magique, MAGIQUE_CACHE_LEXÈMES, sizeof(MAGIQUE_CACHE_LEXÈMES)) != 0 ||
+        entête.version != VERSION_CACHE_LEXÈMES ||
+        entête.signature_lexèmes != signature_genres_lexèmes() ||
+        entête.taille_source != taille_source ||
+        entête.taille_chemin != static_cast<uint64_t>(fichier->chemin().taille())) {
+        m_nombre_échecs += 1;
+        return false;
+    }
+
+    auto chemin = kuri::chaine();
+    chemin.redimensionne(static_cast<int64_t>(arrondis_sur_8(entête.taille_chemin)));
+    if (!flux.read(chemin.pointeur(), chemin.taille())) {
+        m_nombre_échecs += 1;
+        return false;
+    }
+
+    if (kuri::chaine_statique(chemin.pointeur(), static_cast<int64_t>(entête.taille_chemin)) !=
+        fichier->chemin()) {
+        m_nombre_échecs += 1;
+        return false;
+    }
+
+    /* Vérifie le contenu en dernier, c'est le test le plus coûteux. */
+    auto const source = kuri::chaine_statique(tampon.chaine());
+    if (entête.empreinte_source != kuri::empreinte_fnv1a(source)) {
+        m_nombre_échecs += 1;
+        return false;
+    }
+
+    kuri::tableau<LexèmeCache, int> lexèmes_cache;
+    lexèmes_cache.redimensionne(static_cast<int>(entête.nombre_lexèmes));
+    auto const taille_lexèmes = static_cast<std::streamsize>(entête.nombre_lexèmes *
+                                                             sizeof(LexèmeCache));
+    if (!flux.read(reinterpret_cast<char *>(lexèmes_cache.données()), taille_lexèmes)) {
+        m_nombre_échecs += 1;
+        return false;
+    }
+
+    if (entête.empreinte_lexèmes != empreinte_lexèmes_cache(lexèmes_cache)) {
+        m_nombre_échecs += 1;
+        return false;
+    }
+
+    auto const id_fichier = static_cast<int>(fichier->id());
+    auto &lexèmes = fichier->lexèmes;
+    lexèmes.efface();
+    lexèmes.réserve(lexèmes_cache.taille());
+
+    POUR (lexèmes_cache) {
+        if (it.genre > static_cast<uint32_t>(GenreLexème::INCONNU) ||
+            uint64_t(it.décalage) + uint64_t(it.taille) > taille_source) {
+            lexèmes.efface();
+            m_nombre_échecs += 1;
+            return false;
+        }
+
+        auto lexème = Lexème{};
+        lexème.chaine = kuri::chaine_statique(tampon.début() + it.décalage, it.taille);
+        lexème.valeur_entiere = it.valeur;
+        lexème.genre = static_cast<GenreLexème>(it.genre);
+        lexème.fichier = id_fichier;
+        lexème.ligne = it.ligne;
+        lexème.colonne = it.colonne;
+        lexèmes.ajoute(lexème);
+    }
+
+    m_nombre_succès += 1;
+    return true;
+}
+
+void CacheLexèmes::sauvegarde_lexèmes(Fichier const *fichier)
+{
+    auto const &tampon = fichier->tampon();
+    auto const source = kuri::chaine_statique(tampon.chaine());
+
+    auto entête = EntêteCacheLexèmes{};
+    memcpy(entête.magique, MAGIQUE_CACHE_LEXÈMES, sizeof(MAGIQUE_CACHE_LEXÈMES));
+    entête.version = VERSION_CACHE_LEXÈMES;
+    entête.nombre_lexèmes = static_cast<uint32_t>(fichier->lexèmes.taille());
+    entête.signature_lexèmes = signature_genres_lexèmes();
+    entête.taille_source = static_cast<uint64_t>(source.taille());
+    entête.empreinte_source = kuri::empreinte_fnv1a(source);
+    entête.taille_chemin = static_cast<uint64_t>(fichier->chemin().taille());
+
+    kuri::tableau<LexèmeCache, int> lexèmes_cache;
+    lexèmes_cache.réserve(fichier->lexèmes.taille());
+
+    POUR (fichier->lexèmes) {
+        auto lexème = LexèmeCache{};
+        lexème.genre = static_cast<uint32_t>(it.genre);
+        if (it.chaine.taille() != 0) {
+            lexème.décalage = static_cast<uint32_t>(it.chaine.pointeur() - tampon.début());
+            lexème.taille = static_cast<uint32_t>(it.chaine.taille());
+        }
+        lexème.ligne = it.ligne;
+        lexème.colonne = it.colonne;
+        /* Les identifiants et les indices des chaines sont recréés lors du chargement. */
+        if (it.genre == GenreLexème::NOMBRE_ENTIER || it.genre == GenreLexème::NOMBRE_RÉEL ||
+            it.genre == GenreLexème::CARACTÈRE) {
+            lexème.valeur = it.valeur_entiere;
+        }
+        lexèmes_cache.ajoute(lexème);
+    }
+
+    entête.empreinte_lexèmes = empreinte_lexèmes_cache(lexèmes_cache);
+
+    /* Écris dans un fichier temporaire puis renomme celui-ci afin qu'une compilation
+     * concurrente ne puisse lire un cache partiellement écrit. */
+    auto const chemin = chemin_cache_pour(fichier);
+    auto const chemin_temporaire = chemin_temporaire_unique(chemin);
+
+    {
+        std::ofstream flux(vers_std_path(chemin_temporaire),
+                           std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!flux.is_open()) {
+            return;
+        }
+
+        auto chemin_source = kuri::chaine(fichier->chemin());
+        chemin_source.redimensionne(static_cast<int64_t>(arrondis_sur_8(entête.taille_chemin)));
+        for (auto i = fichier->chemin().taille(); i < chemin_source.taille(); i++) {
+            chemin_source[i] = '\0';
+        }
+
+        flux.write(reinterpret_cast<char const *>(&entête), sizeof(entête));
+        flux.write(chemin_source.pointeur(), chemin_source.taille());
+        flux.write(reinterpret_cast<char const *>(lexèmes_cache.données()),
+                   static_cast<std::streamsize>(lexèmes_cache.taille()) *
+                       static_cast<std::streamsize>(sizeof(LexèmeCache)));
+
+        if (!flux) {
+            flux.close();
+            static_cast<void>(kuri::chemin_systeme::supprime(chemin_temporaire));
+            return;
+        }
+    }
+
+    if (kuri::chemin_systeme::renomme(chemin_temporaire, chemin)) {
+        m_nombre_sauvegardes += 1;
+    }
+    else {
+        static_cast<void>(kuri::chemin_systeme::supprime(chemin_temporaire));
+    }
+}
+
+void CacheLexèmes::rassemble_statistiques(Statistiques &stats) const
+{
+    stats.nombre_fichiers_cache_lexèmes_chargés = m_nombre_succès.load();
+    stats.nombre_fichiers_cache_lexèmes_ratés = m_nombre_échecs.load();
+    stats.nombre_fichiers_cache_lexèmes_sauvegardés = m_nombre_sauvegardes.load();
+}
@@ -0,0 +1,70 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * The Original Code is Copyright (C) 2026 Kévin Dietrich. */
+
+#pragma once
+
+#include <atomic>
+
+#include "structures/chemin_systeme.hh"
+
+#include "utilitaires/macros.hh"
+
+struct Fichier;
+struct Statistiques;
+
+/* ------------------------------------------------------------------------- */
+/** \name Cache des lexèmes.
+ *
+ * Cache sur disque des lexèmes des fichiers afin d'éviter de relexer les fichiers qui n'ont pas
+ * changé depuis la dernière compilation (notamment ceux des modules de la bibliothèque standarde).
+ *
+ * Chaque fichier possède son fichier de cache, dont le nom dérive de l'empreinte du chemin du
+ * fichier source. Le cache contient une entête, avec l'empreinte et la taille du contenu du
+ * fichier source, suivie d'un tableau plat de lexèmes de taille fixe. Les chaines des lexèmes
+ * y sont stockées sous forme de décalages dans le tampon source, et les identifiants et chaines
+ * littérales sont recréés par la Lexeuse lors du chargement, donc le cache ne dépend d'aucune
+ * adresse propre à un processus.
+ *
+ * Le cache ne concerne que les lexèmes produits par un lexage sans drapeaux (celui de la
+ * compilation), les outils incluant les commentaires ou les espaces blanches ne l'utilisent pas.
+ * \{ */
+
+struct CacheLexèmes {
+  private:
+    kuri::chemin_systeme m_dossier{};
+
+    std::atomic<int64_t> m_nombre_succès{0};
+    std::atomic<int64_t> m_nombre_échecs{0};
+    std::atomic<int64_t> m_nombre_sauvegardes{0};
+
+  public:
+    explicit CacheLexèmes(kuri::chemin_systeme dossier);
+
+    EMPECHE_COPIE(CacheLexèmes);
+
+    /**
+     * Charge les lexèmes du fichier depuis le cache. Le tampon du fichier doit être chargé.
+     * Retourne vrai si le cache existe et correspond au contenu du fichier, auquel cas les
+     * lexèmes du fichier sont remplis ; l'identifiant et l'indice de chaine des lexèmes restent
+     * à calculer.
+     */
+    bool charge_lexèmes(Fichier *fichier);
+
+    /**
+     * Sauvegarde les lexèmes du fichier dans le cache. Cette fonction doit être appelée avant la
+     * création des identifiants et des chaines littérales.
+     */
+    void sauvegarde_lexèmes(Fichier const *fichier);
+
+    void rassemble_statistiques(Statistiques &stats) const;
+
+    /**
+     * Retourne le dossier par défaut du cache : le dossier temporaire du système.
+     */
+    static kuri::chemin_systeme dossier_défaut();
+
+  private:
+    kuri::chemin_systeme chemin_cache_pour(Fichier const *fichier) const;
+};
+
+/** \} */
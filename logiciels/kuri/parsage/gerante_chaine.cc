@@ -3,6 +3,21 @@
 
 #include "gerante_chaine.hh"
 
+#include <atomic>
+
+static constexpr auto MASQUE_POSITION = int64_t(0xfffffff);
+static constexpr auto DÉCALAGE_PARTITION = 28;
+static_assert(GeranteChaine::NOMBRE_DE_PARTITIONS <= 16,
+              "L'indice de la partition doit tenir sur 4 bits");
+
+int GeranteChaine::donne_indice_partition_fil_courant()
+{
+    static std::atomic<int> prochain_indice = 0;
+    thread_local int indice = prochain_indice.fetch_add(1, std::memory_order_relaxed) %
+                              NOMBRE_DE_PARTITIONS;
+    return indice;
+}
+
 int64_t GeranteChaine::ajoute_chaine(const kuri::chaine &chaine)
 {
     return ajoute_chaine(kuri::chaine_statique(chaine));
@@ -10,6 +25,11 @@ int64_t GeranteChaine::ajoute_chaine(const kuri::chaine &chaine)
 
 int64_t GeranteChaine::ajoute_chaine(kuri::chaine_statique chaine)
 {
+    auto const indice_partition = donne_indice_partition_fil_courant();
+    auto &partition = m_partitions[indice_partition];
+    std::unique_lock verrou(partition.mutex);
+
+    auto &enchaineuse = partition.enchaineuse;
     if ((enchaineuse.tampon_courant->occupe + chaine.taille()) >= Enchaineuse::TAILLE_TAMPON) {
         enchaineuse.ajoute_tampon();
     }
@@ -17,10 +37,12 @@ int64_t GeranteChaine::ajoute_chaine(kuri::chaine_statique chaine)
     // calcul l'adresse de la chaine
     auto adresse = (enchaineuse.nombre_tampons() - 1) * Enchaineuse::TAILLE_TAMPON +
                    enchaineuse.tampon_courant->occupe;
+    assert(adresse <= MASQUE_POSITION);
 
     enchaineuse.ajoute(chaine);
 
-    return adresse | (chaine.taille() << 32);
+    return adresse | (int64_t(indice_partition) << DÉCALAGE_PARTITION) |
+           (chaine.taille() << 32);
 }
 
 kuri::chaine_statique GeranteChaine::chaine_pour_adresse(int64_t adresse) const
@@ -31,8 +53,10 @@ kuri::chaine_statique GeranteChaine::chaine_pour_adresse(int64_t adresse) const
      * compilation. Convertissons explicitement. */
     auto adresse_naturelle = size_t(adresse);
     auto taille = (adresse_naturelle >> 32) & 0xffffffff;
-    adresse_naturelle = (adresse_naturelle & 0xfffffff);
+    auto indice_partition = (adresse_naturelle >> DÉCALAGE_PARTITION) & 0xf;
+    adresse_naturelle = (adresse_naturelle & size_t(MASQUE_POSITION));
 
+    auto const &enchaineuse = m_partitions[indice_partition].enchaineuse;
     auto tampon_courant = &enchaineuse.m_tampon_base;
 
     while (adresse_naturelle >= size_t(Enchaineuse::TAILLE_TAMPON)) {
@@ -46,5 +70,10 @@ kuri::chaine_statique GeranteChaine::chaine_pour_adresse(int64_t adresse) const
 
 int64_t GeranteChaine::mémoire_utilisée() const
 {
-    return enchaineuse.mémoire_utilisée();
+    auto résultat = int64_t(0);
+    for (auto const &partition : m_partitions) {
+        std::unique_lock verrou(partition.mutex);
+        résultat += partition.enchaineuse.mémoire_utilisée();
+    }
+    return résultat;
 }
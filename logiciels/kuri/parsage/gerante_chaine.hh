@@ -3,17 +3,46 @@
 
 #pragma once
 
+#include <mutex>
+
 #include "structures/enchaineuse.hh"
 
+#include "utilitaires/macros.hh"
+
+/* Stockage des chaines littérales, partagé par toutes les tâcheronnes.
+ *
+ * Les chaines sont ajoutées dans une des partitions, chacune ayant son propre verrou. Chaque fil
+ * d'exécution se voit attribuer une partition, pour que les lexeuses ne se bloquent pas les unes
+ * les autres. L'indice de la partition est encodé dans l'adresse retournée : les bits 0 à 27
+ * contiennent la position de la chaine dans la partition, les bits 28 à 31 l'indice de la
+ * partition, et les bits 32 à 63 la taille de la chaine.
+ *
+ * La lecture d'une chaine depuis son adresse ne prend pas de verrou : les tampons d'une
+ * partition ne sont jamais déplacés, et l'adresse n'est connue qu'après que la chaine fut écrite.
+ */
 struct GeranteChaine {
+    static constexpr int NOMBRE_DE_PARTITIONS = 16;
+
   private:
-    Enchaineuse enchaineuse{};
+    struct Partition {
+        mutable std::mutex mutex{};
+        Enchaineuse enchaineuse{};
+    };
+
+    Partition m_partitions[NOMBRE_DE_PARTITIONS];
 
   public:
+    GeranteChaine() = default;
+
+    EMPECHE_COPIE(GeranteChaine);
+
     int64_t ajoute_chaine(kuri::chaine_statique chaine);
     int64_t ajoute_chaine(kuri::chaine const &chaine);
 
     kuri::chaine_statique chaine_pour_adresse(int64_t adresse) const;
 
     int64_t mémoire_utilisée() const;
+
+  private:
+    static int donne_indice_partition_fil_courant();
 };
@@ -8,27 +8,51 @@ TableIdentifiant::TableIdentifiant()
     initialise_identifiants(*this);
 }
 
-IdentifiantCode *TableIdentifiant::identifiant_pour_chaine(kuri::chaine_statique nom)
+int TableIdentifiant::donne_indice_partition(kuri::chaine_statique nom)
+{
+    /* Les bits de poids faible de l'empreinte servent à la table de hachage de la partition,
+     * mélangeons-la et utilisons les bits de poids fort. */
+    uint64_t empreinte = std::hash<kuri::chaine_statique>()(nom);
+    empreinte *= 0x9e3779b97f4a7c15ull;
+    return int(empreinte >> 60);
+}
+
+IdentifiantCode *TableIdentifiant::identifiant_pour_chaine(Partition &partition,
+                                                           kuri::chaine_statique nom)
 {
     auto trouve = false;
-    auto iter = table.trouve(nom, trouve);
+    auto iter = partition.table.trouve(nom, trouve);
 
     if (trouve) {
         return iter;
     }
 
-    return ajoute_identifiant(nom);
+    auto ident = partition.identifiants.ajoute_élément();
+    ident->nom = nom;
+    partition.table.insère(nom, ident);
+    return ident;
+}
+
+IdentifiantCode *TableIdentifiant::identifiant_pour_chaine(kuri::chaine_statique nom)
+{
+    auto &partition = m_partitions[donne_indice_partition(nom)];
+    std::unique_lock verrou(partition.mutex);
+    return identifiant_pour_chaine(partition, nom);
 }
 
 IdentifiantCode *TableIdentifiant::identifiant_pour_nouvelle_chaine(kuri::chaine_statique nom)
 {
+    auto &partition = m_partitions[donne_indice_partition(nom)];
+    std::unique_lock verrou(partition.mutex);
+
     auto trouve = false;
-    auto iter = table.trouve(nom, trouve);
+    auto iter = partition.table.trouve(nom, trouve);
 
     if (trouve) {
         return iter;
     }
 
+    auto &enchaineuse = partition.enchaineuse;
     auto tampon_courant = enchaineuse.tampon_courant;
 
     if (tampon_courant->occupe + nom.taille() > Enchaineuse::TAILLE_TAMPON) {
@@ -40,38 +64,56 @@ IdentifiantCode *TableIdentifiant::identifiant_pour_nouvelle_chaine(kuri::chaine
     enchaineuse.ajoute(nom);
 
     auto vue_nom = kuri::chaine_statique(ptr, nom.taille());
-    return ajoute_identifiant(vue_nom);
+    return identifiant_pour_chaine(partition, vue_nom);
+}
+
+void TableIdentifiant::identifiants_pour_tampon(TamponIdentifiants &tampon)
+{
+    for (auto i = 0; i < NOMBRE_DE_PARTITIONS; i++) {
+        auto &requêtes = tampon.requêtes[i];
+        if (requêtes.est_vide()) {
+            continue;
+        }
+
+        auto &partition = m_partitions[i];
+        std::unique_lock verrou(partition.mutex);
+
+        POUR (requêtes) {
+            *it.résultat = identifiant_pour_chaine(partition, it.nom);
+        }
+
+        requêtes.efface();
+    }
 }
 
 int64_t TableIdentifiant::taille() const
 {
-    return table.taille();
+    auto résultat = int64_t(0);
+    for (auto const &partition : m_partitions) {
+        std::unique_lock verrou(partition.mutex);
+        résultat += partition.table.taille();
+    }
+    return résultat;
 }
 
 int64_t TableIdentifiant::mémoire_utilisée() const
 {
     auto memoire = int64_t(0);
-    memoire += identifiants.mémoire_utilisée();
-    memoire += table.taille_mémoire();
-    memoire += enchaineuse.mémoire_utilisée();
 
-    POUR_TABLEAU_PAGE (identifiants) {
-        memoire += it.nom_broye.taille();
+    for (auto const &partition : m_partitions) {
+        std::unique_lock verrou(partition.mutex);
+        memoire += partition.identifiants.mémoire_utilisée();
+        memoire += partition.table.taille_mémoire();
+        memoire += partition.enchaineuse.mémoire_utilisée();
+
+        POUR_TABLEAU_PAGE (partition.identifiants) {
+            memoire += it.nom_broye.taille();
+        }
     }
 
     return memoire;
 }
 
-IdentifiantCode *TableIdentifiant::ajoute_identifiant(kuri::chaine_statique nom)
-{
-    auto ident = identifiants.ajoute_élément();
-    ident->nom = nom;
-
-    table.insère(nom, ident);
-
-    return ident;
-}
-
 /* ************************************************************************** */
 
 namespace ID {
@@ -3,13 +3,20 @@
 
 #pragma once
 
+#include <mutex>
+
 #include "structures/chaine_statique.hh"
 #include "structures/enchaineuse.hh"
 #include "structures/table_hachage.hh"
+#include "structures/tableau.hh"
 #include "structures/tableau_page.hh"
 
+#include "utilitaires/macros.hh"
+
 #include "plateforme/windows.h"
 
+struct TamponIdentifiants;
+
 struct IdentifiantCode {
     kuri::chaine_statique nom{};
     kuri::chaine_statique nom_broye{};
@@ -20,26 +27,64 @@ struct IdentifiantCode {
     }
 };
 
+/* Table des identifiants, partagée par toutes les tâcheronnes.
+ *
+ * Les identifiants sont répartis dans des partitions selon l'empreinte de leurs noms, chaque
+ * partition ayant son propre verrou, afin que les lexeuses de différents fichiers ne se bloquent
+ * pas les unes les autres. Les adresses des identifiants sont stables. */
 struct TableIdentifiant {
+    static constexpr int NOMBRE_DE_PARTITIONS = 16;
+
   private:
-    kuri::table_hachage<kuri::chaine_statique, IdentifiantCode *> table{"IdentifiantCode"};
-    kuri::tableau_page<IdentifiantCode, 1024> identifiants{};
+    struct Partition {
+        mutable std::mutex mutex{};
+        kuri::table_hachage<kuri::chaine_statique, IdentifiantCode *> table{"IdentifiantCode"};
+        kuri::tableau_page<IdentifiantCode, 256> identifiants{};
+        Enchaineuse enchaineuse{};
+    };
 
-    Enchaineuse enchaineuse{};
+    Partition m_partitions[NOMBRE_DE_PARTITIONS];
 
   public:
     TableIdentifiant();
 
+    EMPECHE_COPIE(TableIdentifiant);
+
     IdentifiantCode *identifiant_pour_chaine(kuri::chaine_statique nom);
 
     IdentifiantCode *identifiant_pour_nouvelle_chaine(kuri::chaine_statique nom);
 
+    /* Crée les identifiants de toutes les requêtes du tampon, en ne verrouillant chaque partition
+     * qu'une seule fois. Le tampon est vidé. */
+    void identifiants_pour_tampon(TamponIdentifiants &tampon);
+
     int64_t taille() const;
 
     int64_t mémoire_utilisée() const;
 
+    static int donne_indice_partition(kuri::chaine_statique nom);
+
   private:
-    IdentifiantCode *ajoute_identifiant(kuri::chaine_statique nom);
+    static IdentifiantCode *identifiant_pour_chaine(Partition &partition,
+                                                    kuri::chaine_statique nom);
+};
+
+/* Tampon d'insertion d'une lexeuse : les noms y sont rangés par partition de la table, pour que
+ * la table soit remplie avec un seul verrouillage par partition. */
+struct TamponIdentifiants {
+    struct Requête {
+        kuri::chaine_statique nom{};
+        /* Où écrire l'identifiant créé. */
+        IdentifiantCode **résultat = nullptr;
+    };
+
+    kuri::tableau<Requête, int> requêtes[TableIdentifiant::NOMBRE_DE_PARTITIONS];
+
+    void ajoute(kuri::chaine_statique nom, IdentifiantCode **résultat)
+    {
+        auto indice = TableIdentifiant::donne_indice_partition(nom);
+        requêtes[indice].ajoute({nom, résultat});
+    }
 };
 
 namespace ID {
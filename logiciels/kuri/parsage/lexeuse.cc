@@ -6,8 +6,13 @@
 #include <array>
 #include <cmath>
 
+#if defined(__SSE2__)
+#    include <immintrin.h>
+#endif
+
 #include "utilitaires/unicode.hh"
 
+#include "cache_lexemes.hh"
 #include "empreinte_parfaite.hh"
 #include "gerante_chaine.hh"
 #include "identifiant.hh"
@@ -209,6 +214,227 @@ static bool est_rune_guillemet(uint32_t rune)
     return false;
 }
 
+/* ************************************************************************** */
+/* Recherches vectorisées.
+ *
+ * Les commentaires, chaines, identifiants, et indentations sont sautés en examinant 32 (AVX2) ou
+ * 16 (SSE2) octets à la fois. Les octets restant à la fin du tampon, ou tous les octets si aucun
+ * jeu d'instructions n'est disponible, sont examinés un par un. */
+
+#if defined(__AVX2__)
+#    define AVEC_RECHERCHES_VECTORISEES
+
+using VecteurOctets = __m256i;
+static constexpr int64_t TAILLE_VECTEUR = 32;
+
+inline static VecteurOctets charge_vecteur(char const *ptr)
+{
+    return _mm256_loadu_si256(reinterpret_cast<VecteurOctets const *>(ptr));
+}
+
+inline static VecteurOctets vecteur_pour(char c)
+{
+    return _mm256_set1_epi8(c);
+}
+
+inline static VecteurOctets égaux(VecteurOctets a, VecteurOctets b)
+{
+    return _mm256_cmpeq_epi8(a, b);
+}
+
+/* Comparaison signée : les octets non-ASCII sont négatifs. */
+inline static VecteurOctets plus_grands(VecteurOctets a, VecteurOctets b)
+{
+    return _mm256_cmpgt_epi8(a, b);
+}
+
+inline static VecteurOctets ou(VecteurOctets a, VecteurOctets b)
+{
+    return _mm256_or_si256(a, b);
+}
+
+inline static VecteurOctets et(VecteurOctets a, VecteurOctets b)
+{
+    return _mm256_and_si256(a, b);
+}
+
+inline static uint32_t donne_masque(VecteurOctets v)
+{
+    return uint32_t(_mm256_movemask_epi8(v));
+}
+
+static constexpr uint32_t MASQUE_COMPLET = 0xffffffff;
+
+#elif defined(__SSE2__)
+#    define AVEC_RECHERCHES_VECTORISEES
+
+using VecteurOctets = __m128i;
+static constexpr int64_t TAILLE_VECTEUR = 16;
+
+inline static VecteurOctets charge_vecteur(char const *ptr)
+{
+    return _mm_loadu_si128(reinterpret_cast<VecteurOctets const *>(ptr));
+}
+
+inline static VecteurOctets vecteur_pour(char c)
+{
+    return _mm_set1_epi8(c);
+}
+
+inline static VecteurOctets égaux(VecteurOctets a, VecteurOctets b)
+{
+    return _mm_cmpeq_epi8(a, b);
+}
+
+/* Comparaison signée : les octets non-ASCII sont négatifs. */
+inline static VecteurOctets plus_grands(VecteurOctets a, VecteurOctets b)
+{
+    return _mm_cmpgt_epi8(a, b);
+}
+
+inline static VecteurOctets ou(VecteurOctets a, VecteurOctets b)
+{
+    return _mm_or_si128(a, b);
+}
+
+inline static VecteurOctets et(VecteurOctets a, VecteurOctets b)
+{
+    return _mm_and_si128(a, b);
+}
+
+inline static uint32_t donne_masque(VecteurOctets v)
+{
+    return uint32_t(_mm_movemask_epi8(v));
+}
+
+static constexpr uint32_t MASQUE_COMPLET = 0xffff;
+#endif
+
+/* Retourne le premier octet de [début, fin[ pour lequel le prédicat est vrai, ou fin. Le prédicat
+ * vectoriel retourne le masque des octets du vecteur pour lesquels le prédicat est vrai. */
+template <typename TypePrédicatVecteur, typename TypePrédicatOctet>
+inline static char const *trouve_premier_octet(
+    char const *début,
+    char const *fin,
+    [[maybe_unused]] TypePrédicatVecteur &&prédicat_vecteur,
+    TypePrédicatOctet &&prédicat_octet)
+{
+#ifdef AVEC_RECHERCHES_VECTORISEES
+    while (fin - début >= TAILLE_VECTEUR) {
+        auto const masque = prédicat_vecteur(charge_vecteur(début));
+        if (masque != 0) {
+            return début + __builtin_ctz(masque);
+        }
+        début += TAILLE_VECTEUR;
+    }
+#endif
+
+    while (début < fin && !prédicat_octet(*début)) {
+        ++début;
+    }
+    return début;
+}
+
+#ifdef AVEC_RECHERCHES_VECTORISEES
+#    define PREDICAT_VECTEUR(expression) [](VecteurOctets v) -> uint32_t { return expression; }
+#else
+#    define PREDICAT_VECTEUR(expression) nullptr
+#endif
+
+static char const *trouve_fin_ligne(char const *début, char const *fin)
+{
+    return trouve_premier_octet(
+        début,
+        fin,
+        PREDICAT_VECTEUR(donne_masque(égaux(v, vecteur_pour('\n')))),
+        [](char c) { return c == '\n'; });
+}
+
+static char const *trouve_délimiteur_chaine(char const *début, char const *fin)
+{
+    return trouve_premier_octet(
+        début,
+        fin,
+        PREDICAT_VECTEUR(
+            donne_masque(ou(égaux(v, vecteur_pour('"')), égaux(v, vecteur_pour('\\'))))),
+        [](char c) { return c == '"' || c == '\\'; });
+}
+
+/* Les guillemets « et » sont encodés C2 AB et C2 BB en UTF-8. 0xC2 ne peut être qu'un premier
+ * octet, la recherche ne s'arrête donc jamais au milieu d'un caractère. */
+static char const *trouve_candidat_guillemet(char const *début, char const *fin)
+{
+    return trouve_premier_octet(
+        début,
+        fin,
+        PREDICAT_VECTEUR(donne_masque(égaux(v, vecteur_pour(char(0xc2))))),
+        [](char c) { return c == char(0xc2); });
+}
+
+static char const *trouve_délimiteur_commentaire_bloc(char const *début, char const *fin)
+{
+    return trouve_premier_octet(
+        début,
+        fin,
+        PREDICAT_VECTEUR(
+            donne_masque(ou(égaux(v, vecteur_pour('/')), égaux(v, vecteur_pour('*'))))),
+        [](char c) { return c == '/' || c == '*'; });
+}
+
+static char const *saute_espaces_horizontales(char const *début, char const *fin)
+{
+    return trouve_premier_octet(
+        début,
+        fin,
+        PREDICAT_VECTEUR(MASQUE_COMPLET ^ donne_masque(ou(égaux(v, vecteur_pour(' ')),
+                                                          égaux(v, vecteur_pour('\t'))))),
+        [](char c) { return c != ' ' && c != '\t'; });
+}
+
+#ifdef AVEC_RECHERCHES_VECTORISEES
+inline static VecteurOctets est_dans_plage(VecteurOctets v, char min, char max)
+{
+    return et(plus_grands(v, vecteur_pour(char(min - 1))),
+              plus_grands(vecteur_pour(char(max + 1)), v));
+}
+#endif
+
+/* Retourne la fin de la suite de caractères ASCII pouvant suivre un identifiant. Les octets
+ * non-ASCII arrêtent la recherche. */
+static char const *trouve_fin_identifiant_ascii(char const *début, char const *fin)
+{
+    return trouve_premier_octet(
+        début,
+        fin,
+        PREDICAT_VECTEUR(
+            MASQUE_COMPLET ^
+            donne_masque(ou(ou(est_dans_plage(ou(v, vecteur_pour(0x20)), 'a', 'z'),
+                               est_dans_plage(v, '0', '9')),
+                            égaux(v, vecteur_pour('_'))))),
+        [](char c) { return !peut_suivre_identifiant(c); });
+}
+
+static int compte_nouvelles_lignes(char const *début, char const *fin)
+{
+    auto résultat = 0;
+
+#ifdef AVEC_RECHERCHES_VECTORISEES
+    auto const nouvelle_ligne = vecteur_pour('\n');
+    while (fin - début >= TAILLE_VECTEUR) {
+        résultat += __builtin_popcount(donne_masque(égaux(charge_vecteur(début), nouvelle_ligne)));
+        début += TAILLE_VECTEUR;
+    }
+#endif
+
+    while (début < fin) {
+        résultat += (*début == '\n');
+        ++début;
+    }
+    return résultat;
+}
+
+#undef PREDICAT_VECTEUR
+
 /* ************************************************************************** */
 
 static int longueur_utf8_depuis_premier_caractère[] = {
@@ -224,9 +450,9 @@ static int longueur_utf8_depuis_premier_caractère[] = {
 
 Lexeuse::Lexeuse(ContexteLexage contexte, Fichier *données, int drapeaux)
     : m_gérante_chaine(contexte.gérante_chaine), m_table_identifiants(contexte.table_identifiants),
-      m_données(données), m_début_mot(données->tampon().début()),
-      m_début(données->tampon().début()), m_fin(données->tampon().fin()), m_drapeaux(drapeaux),
-      m_rappel_erreur(contexte.rappel_erreur)
+      m_cache_lexèmes(contexte.cache_lexèmes), m_données(données),
+      m_début_mot(données->tampon().début()), m_début(données->tampon().début()),
+      m_fin(données->tampon().fin()), m_drapeaux(drapeaux), m_rappel_erreur(contexte.rappel_erreur)
 {
 }
 
@@ -268,6 +494,26 @@ Lexème Lexeuse::crée_lexème_littérale_réelle(double valeur)
 }
 
 void Lexeuse::performe_lexage()
+{
+    /* Le cache ne contient que les lexèmes du lexage de la compilation. */
+    auto cache = (m_drapeaux == 0) ? m_cache_lexèmes : nullptr;
+
+    if (!cache || !cache->charge_lexèmes(m_données)) {
+        découpe_tampon();
+
+        if (cache && !m_possède_erreur) {
+            cache->sauvegarde_lexèmes(m_données);
+        }
+    }
+
+    crée_identifiants();
+    crée_chaines_littérales();
+
+    m_données->lexèmes.rétrécis_capacité_sur_taille();
+    m_données->fut_lexé = true;
+}
+
+void Lexeuse::découpe_tampon()
 {
     while (!this->fini()) {
         consomme_espaces_blanches();
@@ -285,60 +531,62 @@ void Lexeuse::performe_lexage()
 
         ajoute_lexème(lexème);
     }
+}
 
-    // crée les identifiants à la fin pour améliorer la cohérence de cache
-    {
-        auto table_identifiants = m_table_identifiants.verrou_écriture();
+/* Les identifiants et les chaines littérales sont créés à la fin pour améliorer la cohérence de
+ * cache. Ceci permet également de ne pas avoir à stocker d'adresses dans le cache des lexèmes. */
+void Lexeuse::crée_identifiants()
+{
+    /* Les noms sont d'abord rangés par partition de la table, afin de ne verrouiller chaque
+     * partition qu'une seule fois par fichier. Le tampon est propre au fil d'exécution pour
+     * réutiliser sa mémoire d'un fichier à l'autre. */
+    static thread_local TamponIdentifiants tampon;
 
-        POUR (m_données->lexèmes) {
-            if (it.genre == GenreLexème::SI) {
-                it.ident = ID::si;
-            }
-            else if (it.genre == GenreLexème::SAUFSI) {
-                it.ident = ID::saufsi;
-            }
-            else if (it.genre == GenreLexème::CHAINE_CARACTERE) {
-                it.ident = table_identifiants->identifiant_pour_chaine(it.chaine);
-            }
+    POUR (m_données->lexèmes) {
+        if (it.genre == GenreLexème::SI) {
+            it.ident = ID::si;
+        }
+        else if (it.genre == GenreLexème::SAUFSI) {
+            it.ident = ID::saufsi;
+        }
+        else if (it.genre == GenreLexème::CHAINE_CARACTERE) {
+            tampon.ajoute(it.chaine, &it.ident);
         }
     }
 
-    // crée les chaines littérales à la fin pour améliorer la cohérence de cache
-    {
-        auto gérante_chaine = m_gérante_chaine.verrou_écriture();
+    m_table_identifiants.identifiants_pour_tampon(tampon);
+}
 
-        /* en dehors de la boucle car nous l'utilisons comme tampon */
-        kuri::chaine chaine;
+void Lexeuse::crée_chaines_littérales()
+{
+    /* en dehors de la boucle car nous l'utilisons comme tampon */
+    kuri::chaine chaine;
 
-        POUR (m_données->lexèmes) {
-            if (it.genre != GenreLexème::CHAINE_LITTERALE) {
-                continue;
-            }
+    POUR (m_données->lexèmes) {
+        if (it.genre != GenreLexème::CHAINE_LITTERALE) {
+            continue;
+        }
 
-            /* Metton-nous sur la bonne ligne en cas d'erreur. */
-            this->m_compte_ligne = it.ligne;
-            this->m_position_ligne = it.colonne;
+        /* Metton-nous sur la bonne ligne en cas d'erreur. */
+        this->m_compte_ligne = it.ligne;
+        this->m_position_ligne = it.colonne;
 
-            this->m_début = it.chaine.pointeur();
-            auto fin_chaine = this->m_début + it.chaine.taille();
+        this->m_début = it.chaine.pointeur();
+        auto fin_chaine = this->m_début + it.chaine.taille();
 
-            chaine.efface();
-            chaine.réserve(it.chaine.taille());
+        chaine.efface();
+        chaine.réserve(it.chaine.taille());
 
-            while (m_début != fin_chaine) {
-                if (*m_début == '\n') {
-                    this->m_compte_ligne += 1;
-                    this->m_position_ligne = 0;
-                }
-                this->lèxe_caractère_littéral(&chaine);
+        while (m_début != fin_chaine) {
+            if (*m_début == '\n') {
+                this->m_compte_ligne += 1;
+                this->m_position_ligne = 0;
             }
-
-            it.indice_chaine = gérante_chaine->ajoute_chaine(chaine);
+            this->lèxe_caractère_littéral(&chaine);
         }
-    }
 
-    m_données->lexèmes.rétrécis_capacité_sur_taille();
-    m_données->fut_lexé = true;
+        it.indice_chaine = m_gérante_chaine.ajoute_chaine(chaine);
+    }
 }
 
 void Lexeuse::consomme_espaces_blanches()
@@ -366,15 +614,10 @@ void Lexeuse::consomme_espaces_blanches()
                     m_position_ligne = 0;
                     m_compte_ligne += 1;
 
-                    // idée de micro-optimisation provenant de D, saute 4 espaces à la fois
-                    // https://github.com/dlang/dmd/pull/11095
-                    // 0x20 == ' '
+                    /* Saute l'indentation de la ligne suivante d'un coup. */
                     if ((m_drapeaux & INCLUS_ESPACES_BLANCHES) == 0) {
-                        while (m_début <= m_fin - 4 &&
-                               *reinterpret_cast<uint32_t const *>(m_début) == 0x20202020) {
-                            m_début += 4;
-                            m_position_ligne += 4;
-                        }
+                        auto fin_indentation = saute_espaces_horizontales(m_début, m_fin);
+                        avance_sans_nouvelle_ligne(int(fin_indentation - m_début));
                     }
                 }
                 break;
@@ -632,6 +875,14 @@ Lexème Lexeuse::lèxe_chaine_littérale()
     auto const ligne_début = m_compte_ligne;
 
     while (!this->fini()) {
+        auto délimiteur = trouve_délimiteur_chaine(m_début, m_fin);
+        this->ajoute_caractère(int(délimiteur - m_début));
+        this->avance_jusqu_à(délimiteur);
+
+        if (this->fini()) {
+            break;
+        }
+
         if (this->caractère_courant() == '\\') {
             this->avance();
             this->ajoute_caractère();
@@ -639,12 +890,8 @@ Lexème Lexeuse::lèxe_chaine_littérale()
             this->ajoute_caractère();
             continue;
         }
-        if (this->caractère_courant() == '"') {
-            break;
-        }
 
-        this->avance();
-        this->ajoute_caractère();
+        break;
     }
 
     /* Saute le dernier guillemet si nécessaire. */
@@ -685,6 +932,14 @@ Lexème Lexeuse::lèxe_chaine_littérale_guillemet()
     auto const ligne_début = m_compte_ligne;
 
     while (!this->fini()) {
+        auto candidat = trouve_candidat_guillemet(m_début, m_fin);
+        this->ajoute_caractère(int(candidat - m_début));
+        this->avance_jusqu_à(candidat);
+
+        if (this->fini()) {
+            break;
+        }
+
         nombre_octet = unicode::nombre_octets(m_début);
         auto c = unicode::convertis_utf32(m_début, nombre_octet);
 
@@ -768,17 +1023,20 @@ Lexème Lexeuse::lèxe_identifiant()
     this->enregistre_pos_mot();
 
     while (!fini()) {
+        auto fin_ascii = trouve_fin_identifiant_ascii(m_début, m_fin);
+        ajoute_caractère(int(fin_ascii - m_début));
+        avance_sans_nouvelle_ligne(int(fin_ascii - m_début));
+
+        if (fini()) {
+            break;
+        }
+
         auto c = this->caractère_courant();
         auto nombre_octet = longueur_utf8_depuis_premier_caractère[static_cast<unsigned char>(c)];
 
         if (nombre_octet == 1) {
-            if (!peut_suivre_identifiant(c)) {
-                break;
-            }
-
-            ajoute_caractère(1);
-            avance_sans_nouvelle_ligne(1);
-            continue;
+            /* Caractère ASCII ne pouvant suivre un identifiant. */
+            break;
         }
 
         auto rune = unicode::convertis_utf32(m_début, nombre_octet);
@@ -824,6 +1082,26 @@ void Lexeuse::avance(int n)
     }
 }
 
+void Lexeuse::avance_jusqu_à(char const *position)
+{
+    auto const nombre_de_lignes = compte_nouvelles_lignes(m_début, position);
+
+    if (nombre_de_lignes == 0) {
+        m_position_ligne += int(position - m_début);
+    }
+    else {
+        auto début_ligne = position;
+        while (*(début_ligne - 1) != '\n') {
+            --début_ligne;
+        }
+
+        m_compte_ligne += nombre_de_lignes;
+        m_position_ligne = int(position - début_ligne);
+    }
+
+    m_début = position;
+}
+
 kuri::chaine_statique Lexeuse::mot_courant() const
 {
     return kuri::chaine_statique(m_début_mot, m_taille_mot_courant);
@@ -886,12 +1164,11 @@ Lexème Lexeuse::lèxe_commentaire_impl()
         this->enregistre_pos_mot();
     }
 
-    while (!this->fini() && this->caractère_courant() != '\n') {
-        this->avance_fixe<1>();
-        if (INCLUS_COMMENTAIRE) {
-            this->ajoute_caractère();
-        }
+    auto fin_ligne = trouve_fin_ligne(m_début, m_fin);
+    if (INCLUS_COMMENTAIRE) {
+        this->ajoute_caractère(int(fin_ligne - m_début));
     }
+    this->avance_sans_nouvelle_ligne(int(fin_ligne - m_début));
 
     Lexème résultat;
     résultat.genre = GenreLexème::COMMENTAIRE;
@@ -935,6 +1212,16 @@ Lexème Lexeuse::lèxe_commentaire_bloc_impl()
     auto compte_blocs = 0;
 
     while (!this->fini()) {
+        auto délimiteur = trouve_délimiteur_commentaire_bloc(m_début, m_fin);
+        if (INCLUS_COMMENTAIRE) {
+            this->ajoute_caractère(int(délimiteur - m_début));
+        }
+        this->avance_jusqu_à(délimiteur);
+
+        if (this->fini()) {
+            break;
+        }
+
         if (this->caractère_courant() == '/' && this->caractère_voisin(1) == '*') {
             this->avance_fixe<2>();
             if (INCLUS_COMMENTAIRE) {
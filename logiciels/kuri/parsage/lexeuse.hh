@@ -8,11 +8,11 @@
 #include "structures/chaine.hh"
 
 #include "utilitaires/macros.hh"
-#include "utilitaires/synchrone.hh"
 
 #include "lexemes.hh"
 #include "site_source.hh"
 
+struct CacheLexèmes;
 struct Fichier;
 struct GeranteChaine;
 struct TableIdentifiant;
@@ -28,15 +28,18 @@ enum {
 using TypeRappelErreur = std::function<void(SiteSource, kuri::chaine)>;
 
 struct ContexteLexage {
-    kuri::Synchrone<GeranteChaine> &gérante_chaine;
-    kuri::Synchrone<TableIdentifiant> &table_identifiants;
+    GeranteChaine &gérante_chaine;
+    TableIdentifiant &table_identifiants;
     TypeRappelErreur rappel_erreur;
+    /* Optionnel, le cache où chercher et sauvegarder les lexèmes. */
+    CacheLexèmes *cache_lexèmes = nullptr;
 };
 
 struct Lexeuse {
   private:
-    kuri::Synchrone<GeranteChaine> &m_gérante_chaine;
-    kuri::Synchrone<TableIdentifiant> &m_table_identifiants;
+    GeranteChaine &m_gérante_chaine;
+    TableIdentifiant &m_table_identifiants;
+    CacheLexèmes *m_cache_lexèmes = nullptr;
     Fichier *m_données;
 
     const char *m_début_mot = nullptr;
@@ -67,6 +70,10 @@ struct Lexeuse {
     }
 
   private:
+    void découpe_tampon();
+    void crée_identifiants();
+    void crée_chaines_littérales();
+
     TOUJOURS_ENLIGNE bool fini() const
     {
         return m_possède_erreur || m_début >= m_fin;
@@ -87,6 +94,9 @@ struct Lexeuse {
 
     void avance(int n = 1);
 
+    /* Avance jusqu'à la position, en comptant les nouvelles lignes rencontrées. */
+    void avance_jusqu_à(char const *position);
+
     TOUJOURS_ENLIGNE char caractère_courant() const
     {
         return *m_début;
@@ -180,10 +180,9 @@ std::optional<kuri::chemin_systeme> SystèmeModule::détermine_chemin_dossier_mo
     return {};
 }
 
-InfoRequêteModule SystèmeModule::trouve_ou_crée_module(
-    kuri::Synchrone<TableIdentifiant> &table_identifiants,
-    Fichier const *fichier,
-    kuri::chaine_statique nom_module)
+InfoRequêteModule SystèmeModule::trouve_ou_crée_module(TableIdentifiant &table_identifiants,
+                                                       Fichier const *fichier,
+                                                       kuri::chaine_statique nom_module)
 {
     auto résultat = InfoRequêteModule{};
 
@@ -212,7 +211,7 @@ InfoRequêteModule SystèmeModule::trouve_ou_crée_module(
     }
 
     auto module = trouve_ou_crée_module(
-        table_identifiants->identifiant_pour_nouvelle_chaine(nom_dossier), chemin_absolu);
+        table_identifiants.identifiant_pour_nouvelle_chaine(nom_dossier), chemin_absolu);
     résultat.module = module;
     résultat.état = InfoRequêteModule::État::TROUVÉ;
 
@@ -282,6 +281,91 @@ FichierNeuf SystèmeModule::crée_fichier(Module *module,
     return FichierNeuf(df);
 }
 
+/* ------------------------------------------------------------------------- */
+/** \name Données constantes des fichiers.
+ * \{ */
+
+DonnéesConstantesFichier *TableDonnéesConstantesFichiers::trouve_ou_crée(
+    kuri::chaine_statique chemin)
+{
+    std::unique_lock verrou(m_mutex);
+
+    auto existantes = m_table.valeur_ou(chemin, nullptr);
+    if (existantes) {
+        m_nombre_tampons_partagés += 1;
+        return existantes;
+    }
+
+    auto résultat = m_données.ajoute_élément();
+    résultat->chemin = chemin;
+    m_table.insère(résultat->chemin, résultat);
+    return résultat;
+}
+
+bool TableDonnéesConstantesFichiers::copie_lexèmes(Fichier *fichier)
+{
+    auto données = fichier->données_constantes;
+    if (!données) {
+        return false;
+    }
+
+    std::unique_lock verrou(données->mutex);
+    auto source = données->fichier_lexèmes;
+    if (!source) {
+        return false;
+    }
+
+    fichier->lexèmes = source->lexèmes;
+    auto const id_fichier = static_cast<int>(fichier->id());
+    POUR (fichier->lexèmes) {
+        it.fichier = id_fichier;
+    }
+    fichier->fut_lexé = true;
+
+    m_nombre_lexèmes_partagés += 1;
+    return true;
+}
+
+void TableDonnéesConstantesFichiers::publie_lexèmes(Fichier const *fichier)
+{
+    auto données = fichier->données_constantes;
+    if (!données) {
+        return;
+    }
+
+    std::unique_lock verrou(données->mutex);
+    if (!données->fichier_lexèmes) {
+        données->fichier_lexèmes = fichier;
+    }
+}
+
+int64_t TableDonnéesConstantesFichiers::mémoire_utilisée() const
+{
+    auto résultat = m_données.mémoire_utilisée() + m_table.taille_mémoire();
+    POUR_TABLEAU_PAGE (m_données) {
+        résultat += it.chemin.taille();
+        résultat += it.tampon.chaine().taille();
+    }
+    return résultat;
+}
+
+void TableDonnéesConstantesFichiers::rassemble_statistiques(Statistiques &stats) const
+{
+    stats.nombre_fichiers_tampons_partagés = m_nombre_tampons_partagés.load();
+    stats.nombre_fichiers_lexèmes_partagés = m_nombre_lexèmes_partagés.load();
+
+    /* Les fichiers des espaces ne comptent pas la mémoire des tampons partagés. */
+    auto &stats_fichiers = stats.stats_fichiers;
+    POUR_TABLEAU_PAGE (m_données) {
+        auto entrée = EntréeFichier();
+        entrée.chemin = it.chemin;
+        entrée.mémoire_tampons = it.tampon.taille_données();
+        stats_fichiers.fusionne_entrée(entrée);
+    }
+}
+
+/** \} */
+
 void SystèmeModule::rassemble_stats(Statistiques &stats) const
 {
     stats.nombre_modules = modules.taille();
@@ -295,7 +379,9 @@ void SystèmeModule::rassemble_stats(Statistiques &stats) const
         entrée.chemin = it.chemin();
         entrée.nom = it.nom();
         entrée.nombre_lignes = it.tampon().nombre_lignes();
-        entrée.mémoire_tampons = it.tampon().taille_données();
+        if (!it.données_constantes) {
+            entrée.mémoire_tampons = it.tampon().taille_données();
+        }
         entrée.mémoire_lexèmes = it.lexèmes.taille_mémoire();
         entrée.nombre_lexèmes = it.lexèmes.taille();
         entrée.temps_chargement = it.temps_chargement;
@@ -320,7 +406,9 @@ int64_t SystèmeModule::mémoire_utilisée() const
     POUR_TABLEAU_PAGE (fichiers) {
         résultat += it.nom().taille();
         résultat += it.chemin().taille();
-        résultat += it.tampon().chaine().taille();
+        if (!it.données_constantes) {
+            résultat += it.tampon().chaine().taille();
+        }
     }
 
     POUR_TABLEAU_PAGE (modules) {
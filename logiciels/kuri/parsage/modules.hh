@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <mutex>
 #include <optional>
 #include <variant>
@@ -10,6 +11,7 @@
 #include "structures/chaine.hh"
 #include "structures/chemin_systeme.hh"
 #include "structures/ensemblon.hh"
+#include "structures/table_hachage.hh"
 #include "structures/tableau.hh"
 #include "structures/tableau_page.hh"
 #include "structures/tablet.hh"
@@ -23,6 +25,7 @@
 
 struct Enchaineuse;
 struct EspaceDeTravail;
+struct Fichier;
 struct IdentifiantCode;
 struct MétaProgramme;
 struct Module;
@@ -88,6 +91,78 @@ struct hash<ModuleImporté> {
 };
 }  // namespace std
 
+/* ------------------------------------------------------------------------- */
+/** \name Données constantes des fichiers.
+ *
+ * Chaque espace de travail possède ses propres fichiers, mais le contenu d'un fichier du disque et
+ * ses lexèmes ne dépendent pas de l'espace. Ces données sont donc partagées entre les fichiers de
+ * même chemin des différents espaces : le fichier n'est chargé qu'une seule fois, et lexé une
+ * seule fois dès qu'un espace a fini de le parser.
+ *
+ * Les lexèmes ne peuvent être partagés tels quels : ils contiennent l'index du fichier dans son
+ * espace, et la Syntaxeuse change le genre de certains (par exemple MOINS en MOINS_UNAIRE). Les
+ * autres espaces en reçoivent donc une copie, faite une fois le parsage du premier terminé.
+ *
+ * Les arbres syntaxiques ne sont pas partagés, chaque espace parse et valide ses fichiers (voir
+ * architecture.md).
+ * \{ */
+
+struct DonnéesConstantesFichier {
+    kuri::chaine chemin{};
+
+    std::mutex mutex{};
+
+    TamponSource tampon{""};
+    bool fut_chargé = false;
+
+    /* Le premier fichier parsé ayant ce chemin, dont les lexèmes sont copiés par les autres
+     * espaces. */
+    Fichier const *fichier_lexèmes = nullptr;
+
+    DonnéesConstantesFichier() = default;
+
+    EMPECHE_COPIE(DonnéesConstantesFichier);
+};
+
+struct TableDonnéesConstantesFichiers {
+  private:
+    std::mutex m_mutex{};
+    kuri::tableau_page<DonnéesConstantesFichier> m_données{};
+    kuri::table_hachage<kuri::chaine_statique, DonnéesConstantesFichier *> m_table{
+        "DonnéesConstantesFichier"};
+
+    std::atomic<int64_t> m_nombre_tampons_partagés{0};
+    std::atomic<int64_t> m_nombre_lexèmes_partagés{0};
+
+  public:
+    TableDonnéesConstantesFichiers() = default;
+
+    EMPECHE_COPIE(TableDonnéesConstantesFichiers);
+
+    /**
+     * Retourne les données pour le chemin, en les créant si aucun espace n'a encore chargé de
+     * fichier ayant ce chemin.
+     */
+    DonnéesConstantesFichier *trouve_ou_crée(kuri::chaine_statique chemin);
+
+    /**
+     * Copie dans le fichier les lexèmes d'un fichier de même chemin déjà parsé dans un autre
+     * espace. Retourne faux si aucun ne l'est encore, auquel cas le fichier doit être lexé.
+     */
+    bool copie_lexèmes(Fichier *fichier);
+
+    /**
+     * Appelé après le parsage du fichier, pour rendre ses lexèmes disponibles aux autres espaces.
+     */
+    void publie_lexèmes(Fichier const *fichier);
+
+    int64_t mémoire_utilisée() const;
+
+    void rassemble_statistiques(Statistiques &stats) const;
+};
+
+/** \} */
+
 struct Fichier {
     double temps_analyse = 0.0;
     double temps_chargement = 0.0;
@@ -95,6 +170,8 @@ struct Fichier {
     double temps_tampon = 0.0;
 
     TamponSource tampon_{""};
+    /* Non-nul si le fichier vient du disque, auquel cas son tampon est celui des données. */
+    DonnéesConstantesFichier *données_constantes = nullptr;
 
     kuri::tableau<Lexème, int> lexèmes{};
 
@@ -167,6 +244,9 @@ struct Fichier {
 
     TamponSource const &tampon() const
     {
+        if (données_constantes) {
+            return données_constantes->tampon;
+        }
         return tampon_;
     }
 
@@ -175,6 +255,12 @@ struct Fichier {
         tampon_ = t;
         fut_chargé = true;
     }
+
+    void partage_données_constantes(DonnéesConstantesFichier *données)
+    {
+        données_constantes = données;
+        fut_chargé = true;
+    }
 };
 
 CREE_TYPE_OPAQUE(FichierExistant, Fichier *);
@@ -267,7 +353,7 @@ struct SystèmeModule {
 
     Module *crée_module(IdentifiantCode *nom, kuri::chaine_statique chemin);
 
-    InfoRequêteModule trouve_ou_crée_module(kuri::Synchrone<TableIdentifiant> &table_identifiants,
+    InfoRequêteModule trouve_ou_crée_module(TableIdentifiant &table_identifiants,
                                             Fichier const *fichier,
                                             kuri::chaine_statique nom_module);
 
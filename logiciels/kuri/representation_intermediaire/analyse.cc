@@ -1222,7 +1222,7 @@ static bool rapproche_allocations_des_stockages(Bloc *bloc)
     return bloc_modifié;
 }
 
-static void marque_paramètres_utilisés(AtomeFonction const &fonction)
+void marque_paramètres_utilisés(AtomeFonction const &fonction)
 {
     POUR (fonction.params_entrée) {
         it->drapeaux &= ~DrapeauxAtome::EST_UTILISÉ;
@@ -32,6 +32,9 @@ struct ContexteAnalyseRI {
 
 void marque_instructions_utilisées(kuri::tableau<Instruction *, int> &instructions);
 
+/* Ajourne le drapeau EST_UTILISÉ des paramètres de la fonction selon ses instructions. */
+void marque_paramètres_utilisés(AtomeFonction const &fonction);
+
 AtomeConstante *évalue_opérateur_binaire(InstructionOpBinaire const *inst,
                                          ConstructriceRI &constructrice);
 
@@ -4,6 +4,7 @@
 #include "code_binaire.hh"
 
 #include <iomanip>
+#include <optional>
 
 #include "arbre_syntaxique/cas_genre_noeud.hh"
 #include "arbre_syntaxique/noeud_expression.hh"
@@ -94,6 +95,8 @@ void Chunk::initialise()
     compte = 0;
     capacité = 0;
     m_sites_source.efface();
+    m_décalage_dernière_op = -1;
+    m_dernière_op_fusionnée = false;
 }
 
 void Chunk::détruit()
@@ -148,10 +151,54 @@ void Chunk::émets_entête_op(octet_t op, const NoeudExpression *site)
     if (émets_stats_ops) {
         émets(OP_STAT_INSTRUCTION);
     }
+    else {
+        forme_superinstruction(op);
+    }
 
+    m_décalage_dernière_op = compte;
     émets(op);
 }
 
+/* Retourne la superinstruction exécutant les deux opérations, ou la première opération si la
+ * paire n'en a pas. */
+static octet_t donne_superinstruction(octet_t première, octet_t seconde)
+{
+    if (première == OP_CHARGE_LOCALE) {
+        if (seconde == OP_AJOUTE) {
+            return OP_CHARGE_LOCALE_AJOUTE;
+        }
+        if (seconde == OP_CHARGE_LOCALE) {
+            return OP_CHARGE_LOCALE_CHARGE_LOCALE;
+        }
+    }
+    else if (première == OP_COMP_INF && seconde == OP_BRANCHE_CONDITION) {
+        return OP_COMP_INF_BRANCHE_CONDITION;
+    }
+    return première;
+}
+
+/* Remplace l'opération précédente par une superinstruction si elle forme une paire fréquente
+ * avec op. Le code de la seconde opération reste en place : la superinstruction saute son code
+ * d'opération, et les branches vers la seconde opération restent valides. */
+void Chunk::forme_superinstruction(octet_t op)
+{
+    auto const précédente_fusionnée = m_dernière_op_fusionnée;
+    m_dernière_op_fusionnée = false;
+
+    if (m_décalage_dernière_op == -1 || précédente_fusionnée) {
+        return;
+    }
+
+    auto &précédente = code[m_décalage_dernière_op];
+    auto const superinstruction = donne_superinstruction(précédente, op);
+    if (superinstruction == précédente) {
+        return;
+    }
+
+    précédente = superinstruction;
+    m_dernière_op_fusionnée = true;
+}
+
 void Chunk::émets_logue_instruction(int32_t décalage)
 {
     émets_entête_op(OP_LOGUE_INSTRUCTION, nullptr);
@@ -617,6 +664,94 @@ static octet_t convertis_op_binaire(OpérateurBinaire::Genre genre)
     return static_cast<octet_t>(-1);
 }
 
+static bool est_code_opération_comparaison(octet_t op)
+{
+    switch (op) {
+        case OP_COMP_ÉGAL:
+        case OP_COMP_INÉGAL:
+        case OP_COMP_INF:
+        case OP_COMP_INF_ÉGAL:
+        case OP_COMP_SUP:
+        case OP_COMP_SUP_ÉGAL:
+        case OP_COMP_INF_NATUREL:
+        case OP_COMP_INF_ÉGAL_NATUREL:
+        case OP_COMP_SUP_NATUREL:
+        case OP_COMP_SUP_ÉGAL_NATUREL:
+        case OP_COMP_ÉGAL_RÉEL:
+        case OP_COMP_INÉGAL_RÉEL:
+        case OP_COMP_INF_RÉEL:
+        case OP_COMP_INF_ÉGAL_RÉEL:
+        case OP_COMP_SUP_RÉEL:
+        case OP_COMP_SUP_ÉGAL_RÉEL:
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Retourne le type des opérandes d'une opération à registres, ou 0 si l'opération n'a pas de
+ * forme à registres. Le signe des opérandes est le même que celui utilisé par la machine virtuelle
+ * pour l'opération sur la pile. */
+static octet_t donne_type_opérandes_registres(octet_t op, uint32_t taille_octet)
+{
+    if (taille_octet != 1 && taille_octet != 2 && taille_octet != 4 && taille_octet != 8) {
+        return 0;
+    }
+
+    auto const bits = octet_t(taille_octet * 8);
+
+    switch (op) {
+        case OP_AJOUTE:
+        case OP_SOUSTRAIT:
+        case OP_MULTIPLIE:
+        case OP_DIVISE_RELATIF:
+        case OP_RESTE_RELATIF:
+        case OP_COMP_ÉGAL:
+        case OP_COMP_INÉGAL:
+        case OP_COMP_INF:
+        case OP_COMP_INF_ÉGAL:
+        case OP_COMP_SUP:
+        case OP_COMP_SUP_ÉGAL:
+        case OP_ET_BINAIRE:
+        case OP_OU_BINAIRE:
+        case OP_OU_EXCLUSIF:
+        case OP_DEC_GAUCHE:
+        case OP_DEC_DROITE_ARITHM:
+        {
+            return CONSTANTE_ENTIER_RELATIF | bits;
+        }
+        case OP_DIVISE:
+        case OP_RESTE_NATUREL:
+        case OP_COMP_INF_NATUREL:
+        case OP_COMP_INF_ÉGAL_NATUREL:
+        case OP_COMP_SUP_NATUREL:
+        case OP_COMP_SUP_ÉGAL_NATUREL:
+        case OP_DEC_DROITE_LOGIQUE:
+        {
+            return CONSTANTE_ENTIER_NATUREL | bits;
+        }
+        case OP_AJOUTE_RÉEL:
+        case OP_SOUSTRAIT_RÉEL:
+        case OP_MULTIPLIE_RÉEL:
+        case OP_DIVISE_RÉEL:
+        case OP_COMP_ÉGAL_RÉEL:
+        case OP_COMP_INÉGAL_RÉEL:
+        case OP_COMP_INF_RÉEL:
+        case OP_COMP_INF_ÉGAL_RÉEL:
+        case OP_COMP_SUP_RÉEL:
+        case OP_COMP_SUP_ÉGAL_RÉEL:
+        {
+            if (taille_octet != 4 && taille_octet != 8) {
+                return 0;
+            }
+            return CONSTANTE_NOMBRE_RÉEL | bits;
+        }
+    }
+
+    return 0;
+}
+
 static std::optional<octet_t> convertis_type_transtypage(TypeTranstypage genre)
 {
     switch (genre) {
@@ -764,6 +899,78 @@ void Chunk::émets_copie_mémoire(const NoeudExpression *site, uint32_t taille_o
     émets(taille_octet);
 }
 
+void Chunk::émets_opérande_registre(OpérandeRegistre opérande)
+{
+    if (opérande.genre != OpérandeRegistre::Genre::PILE) {
+        émets(opérande.valeur);
+    }
+}
+
+static octet_t donne_modes_opérandes(OpérationRegistres const &opération)
+{
+    return donne_modes_opérandes(opération.gauche.genre, opération.droite.genre);
+}
+
+void Chunk::émets_notifie_dépilage_opérandes(NoeudExpression const *site,
+                                             OpérationRegistres const &opération)
+{
+    auto const taille_opérande = uint32_t(opération.type >> 3);
+    if (opération.droite.genre == OpérandeRegistre::Genre::PILE) {
+        émets_notifie_dépilage(site, taille_opérande);
+    }
+    if (opération.gauche.genre == OpérandeRegistre::Genre::PILE) {
+        émets_notifie_dépilage(site, taille_opérande);
+    }
+}
+
+void Chunk::émets_opération_registres(NoeudExpression const *site,
+                                      OpérationRegistres const &opération,
+                                      int destination)
+{
+    émets_notifie_dépilage_opérandes(site, opération);
+    émets_entête_op(OP_OPÉRATION_REGISTRES, site);
+    émets(opération.op);
+    émets(opération.type);
+    émets(donne_modes_opérandes(opération));
+    émets(destination);
+    émets_opérande_registre(opération.gauche);
+    émets_opérande_registre(opération.droite);
+
+    if (destination == DESTINATION_PILE) {
+        auto const taille_résultat = est_code_opération_comparaison(opération.op) ?
+                                         1u :
+                                         uint32_t(opération.type >> 3);
+        émets_notifie_empilage(site, taille_résultat);
+    }
+}
+
+void Chunk::émets_branche_registres(NoeudExpression const *site,
+                                    kuri::tableau<PatchLabel> &patchs_labels,
+                                    OpérationRegistres const &opération,
+                                    int indice_label_si_vrai,
+                                    int indice_label_si_faux)
+{
+    if (émets_vérification_branches) {
+        émets_entête_op(OP_VÉRIFIE_CIBLE_BRANCHE_CONDITION, nullptr);
+        émets(0);
+        patchs_labels.ajoute({indice_label_si_vrai, static_cast<int>(compte - 4)});
+        émets(0);
+        patchs_labels.ajoute({indice_label_si_faux, static_cast<int>(compte - 4)});
+    }
+
+    émets_notifie_dépilage_opérandes(site, opération);
+    émets_entête_op(OP_BRANCHE_REGISTRES, site);
+    émets(opération.op);
+    émets(opération.type);
+    émets(donne_modes_opérandes(opération));
+    émets_opérande_registre(opération.gauche);
+    émets_opérande_registre(opération.droite);
+    émets(0);
+    patchs_labels.ajoute({indice_label_si_vrai, static_cast<int>(compte - 4)});
+    émets(0);
+    patchs_labels.ajoute({indice_label_si_faux, static_cast<int>(compte - 4)});
+}
+
 /* ************************************************************************** */
 
 template <typename T>
@@ -819,6 +1026,73 @@ static int64_t instruction_3d(Chunk const &chunk, int64_t décalage, Enchaineuse
     return décalage;
 }
 
+static void désassemble_opérande_registre(Chunk const &chunk,
+                                         int64_t &décalage,
+                                         OpérandeRegistre::Genre genre,
+                                         Enchaineuse &os)
+{
+    if (genre == OpérandeRegistre::Genre::PILE) {
+        os << "pile";
+        return;
+    }
+
+    auto valeur = DésassembleuseValeur<int64_t>::donne_valeur(chunk, décalage);
+    if (genre == OpérandeRegistre::Genre::IMMÉDIAT) {
+        os << '$' << valeur;
+    }
+    else {
+        os << "[" << valeur << "]";
+    }
+}
+
+/* Imprime par exemple « OP_OPÉRATION_REGISTRES OP_AJOUTE n32 [8] = [0], $1 », où les valeurs
+ * entre crochets sont les adresses des locales dans la frame, et « pile » désigne une valeur
+ * dépilée. */
+static int64_t désassemble_instruction_registres(Chunk const &chunk,
+                                                 int64_t décalage,
+                                                 Enchaineuse &os)
+{
+    auto const instruction = chunk.code[décalage];
+    décalage += 1;
+    auto const op = chunk.code[décalage++];
+    auto const type = chunk.code[décalage++];
+    auto const modes = chunk.code[décalage++];
+
+    os << ' ' << chaine_code_opération(op) << ' ';
+    if ((type & CONSTANTE_NOMBRE_RÉEL) != 0) {
+        os << 'r';
+    }
+    else if ((type & CONSTANTE_ENTIER_RELATIF) != 0) {
+        os << 'z';
+    }
+    else {
+        os << 'n';
+    }
+    os << (type >> 3) * 8 << ' ';
+
+    if (instruction == OP_OPÉRATION_REGISTRES) {
+        auto destination = DésassembleuseValeur<int>::donne_valeur(chunk, décalage);
+        if (destination == DESTINATION_PILE) {
+            os << "pile = ";
+        }
+        else {
+            os << "[" << destination << "] = ";
+        }
+    }
+
+    désassemble_opérande_registre(chunk, décalage, donne_genre_opérande_gauche(modes), os);
+    os << ", ";
+    désassemble_opérande_registre(chunk, décalage, donne_genre_opérande_droite(modes), os);
+
+    if (instruction == OP_BRANCHE_REGISTRES) {
+        os << ", " << DésassembleuseValeur<int>::donne_valeur(chunk, décalage);
+        os << ", " << DésassembleuseValeur<int>::donne_valeur(chunk, décalage);
+    }
+
+    os << '\n';
+    return décalage;
+}
+
 int64_t désassemble_instruction(Chunk const &chunk, int64_t décalage, Enchaineuse &os)
 {
     os << std::setfill('0') << std::setw(4) << décalage << ' ';
@@ -979,6 +1253,7 @@ int64_t désassemble_instruction(Chunk const &chunk, int64_t décalage, Enchaine
         case OP_NOTIFIE_EMPILAGE_VALEUR:
         case OP_SÉLECTION:
         case OP_VÉRIFIE_CIBLE_BRANCHE:
+        case OP_COMP_INF_BRANCHE_CONDITION:
         {
             return instruction_1d<int>(chunk, décalage, os);
         }
@@ -999,6 +1274,8 @@ int64_t désassemble_instruction(Chunk const &chunk, int64_t décalage, Enchaine
         }
         case OP_ASSIGNE_LOCALE:
         case OP_CHARGE_LOCALE:
+        case OP_CHARGE_LOCALE_AJOUTE:
+        case OP_CHARGE_LOCALE_CHARGE_LOCALE:
         case OP_BRANCHE_CONDITION:
         case OP_INCRÉMENTE_LOCALE:
         case OP_RÉFÉRENCE_RUBRIQUE_LOCALE:
@@ -1010,6 +1287,11 @@ int64_t désassemble_instruction(Chunk const &chunk, int64_t décalage, Enchaine
         {
             return instruction_3d<int, int, int>(chunk, décalage, os);
         }
+        case OP_OPÉRATION_REGISTRES:
+        case OP_BRANCHE_REGISTRES:
+        {
+            return désassemble_instruction_registres(chunk, décalage, os);
+        }
         case OP_VÉRIFIE_CIBLE_APPEL:
         {
             auto décalage_est_pointeur = décalage + 1;
@@ -1257,6 +1539,7 @@ CompilatriceCodeBinaire::CompilatriceCodeBinaire(EspaceDeTravail *espace_,
     notifie_empilage = espace->compilatrice().arguments.debogue_execution;
     émets_stats_ops = espace->compilatrice().arguments.émets_stats_ops_exécution;
     émets_profilage = espace->compilatrice().arguments.profile_métaprogrammes;
+    utilise_registres = espace->compilatrice().arguments.code_binaire_registres;
 }
 
 bool CompilatriceCodeBinaire::génère_code(ProgrammeRepreInter const &repr_inter)
@@ -1294,6 +1577,15 @@ bool CompilatriceCodeBinaire::génère_code(ProgrammeRepreInter const &repr_inte
             continue;
         }
 
+        /* Le code final de l'espace fut généré et sa RI libérée : du code ajouté à l'espace après
+         * la fin de sa compilation ne peut plus exécuter cette fonction. */
+        if (it->ri_libérée) {
+            espace->rapporte_erreur(it->decl,
+                                    "Impossible de générer le code binaire de la fonction, sa RI "
+                                    "fut libérée à la fin de la compilation de son espace");
+            return false;
+        }
+
         it->données_exécution = mémoire::loge<DonnéesExécutionFonction>(
             "DonnéesExécutionFonction");
         m_atome_fonction_courante = it;
@@ -1381,6 +1673,7 @@ bool CompilatriceCodeBinaire::génère_code_pour_fonction(AtomeFonction const *f
             return false;
         }
 
+        données_externe.prépare_appel_direct();
         return true;
     }
 
@@ -1463,6 +1756,18 @@ void CompilatriceCodeBinaire::génère_code_pour_instruction(Instruction const *
             auto branche = instruction->comme_branche_cond();
 
             /* À FAIRE : évite de générer une branche si nous avons une constante. */
+            if (auto opération = donne_opération_registres(branche->condition, chunk)) {
+                if (est_code_opération_comparaison(opération->op)) {
+                    génère_code_opérandes_pile(opération.value(), chunk);
+                    chunk.émets_branche_registres(branche->site,
+                                                  patchs_labels,
+                                                  opération.value(),
+                                                  branche->label_si_vrai->id,
+                                                  branche->label_si_faux->id);
+                    break;
+                }
+            }
+
             if (branche->condition->est_instruction()) {
                 if (auto atome = est_comparaison_égal_zéro_ou_nul(
                         branche->condition->comme_instruction())) {
@@ -1549,6 +1854,15 @@ void CompilatriceCodeBinaire::génère_code_pour_instruction(Instruction const *
                 break;
             }
 
+            if (auto opération = donne_opération_registres(stocke->source, chunk)) {
+                if (auto adresse = donne_adresse_dans_frame(stocke->destination, chunk)) {
+                    génère_code_opérandes_pile(opération.value(), chunk);
+                    chunk.émets_opération_registres(
+                        stocke->site, opération.value(), adresse.value());
+                    break;
+                }
+            }
+
             génère_code_pour_atome(stocke->source, chunk);
 
             if (est_allocation(stocke->destination)) {
@@ -1694,6 +2008,13 @@ void CompilatriceCodeBinaire::génère_code_pour_instruction(Instruction const *
             auto op_binaire = instruction->comme_op_binaire();
             auto type_gauche = op_binaire->valeur_gauche->type;
 
+            if (auto opération = donne_opération_registres(op_binaire, chunk)) {
+                génère_code_opérandes_pile(opération.value(), chunk);
+                chunk.émets_opération_registres(
+                    op_binaire->site, opération.value(), DESTINATION_PILE);
+                break;
+            }
+
             génère_code_pour_atome(op_binaire->valeur_gauche, chunk);
 
             if (op_binaire->op == OpérateurBinaire::Genre::Addition &&
@@ -2217,6 +2538,202 @@ int CompilatriceCodeBinaire::donne_indice_locale(const InstructionAllocation *al
     return m_indice_locales[alloc->numéro];
 }
 
+/* Retourne l'adresse dans la frame de l'atome s'il s'agit d'une locale ou d'une rubrique d'une
+ * locale, les deux pouvant alors être lues ou écrites directement par les instructions à
+ * registres. */
+std::optional<int> CompilatriceCodeBinaire::donne_adresse_dans_frame(Atome const *atome,
+                                                                     Chunk const &chunk) const
+{
+    if (!atome->est_instruction()) {
+        return {};
+    }
+
+    auto inst = atome->comme_instruction();
+    if (inst->est_alloc()) {
+        return chunk.locales[donne_indice_locale(inst->comme_alloc())].adresse;
+    }
+
+    if (inst->est_accès_rubrique()) {
+        auto accès_fusionné = fusionne_accès_rubriques(inst->comme_accès_rubrique());
+        if (!est_allocation(accès_fusionné.accédé)) {
+            return {};
+        }
+
+        auto alloc = accès_fusionné.accédé->comme_instruction()->comme_alloc();
+        auto const &locale = chunk.locales[donne_indice_locale(alloc)];
+        return locale.adresse + int(accès_fusionné.décalage);
+    }
+
+    return {};
+}
+
+std::optional<OpérandeRegistre> CompilatriceCodeBinaire::donne_opérande_registre(
+    Atome const *atome, Chunk const &chunk) const
+{
+    switch (atome->genre_atome) {
+        case Atome::Genre::INSTRUCTION:
+        {
+            auto inst = atome->comme_instruction();
+            if (!inst->est_charge()) {
+                return {};
+            }
+
+            auto adresse = donne_adresse_dans_frame(inst->comme_charge()->chargée, chunk);
+            if (!adresse.has_value()) {
+                return {};
+            }
+
+            return OpérandeRegistre{OpérandeRegistre::Genre::LOCALE, adresse.value()};
+        }
+        case Atome::Genre::CONSTANTE_ENTIÈRE:
+        {
+            /* La machine virtuelle ne lit que les octets de poids faible. */
+            auto valeur = atome->comme_constante_entière()->valeur;
+            return OpérandeRegistre{OpérandeRegistre::Genre::IMMÉDIAT, static_cast<int64_t>(valeur)};
+        }
+        case Atome::Genre::CONSTANTE_BOOLÉENNE:
+        {
+            return OpérandeRegistre{OpérandeRegistre::Genre::IMMÉDIAT, int64_t(atome->comme_constante_booléenne()->valeur)};
+        }
+        case Atome::Genre::CONSTANTE_NULLE:
+        {
+            return OpérandeRegistre{OpérandeRegistre::Genre::IMMÉDIAT, 0};
+        }
+        case Atome::Genre::CONSTANTE_RÉELLE:
+        {
+            auto constante_réelle = atome->comme_constante_réelle();
+            auto résultat = OpérandeRegistre{OpérandeRegistre::Genre::IMMÉDIAT, 0};
+            if (constante_réelle->type->taille_octet == 4) {
+                auto valeur = static_cast<float>(constante_réelle->valeur);
+                memcpy(&résultat.valeur, &valeur, sizeof(valeur));
+            }
+            else {
+                memcpy(&résultat.valeur, &constante_réelle->valeur, sizeof(double));
+            }
+            return résultat;
+        }
+        default:
+        {
+            break;
+        }
+    }
+
+    return {};
+}
+
+/* Retourne vrai si le calcul de la valeur de l'atome ne contient aucun appel, et ne peut donc
+ * modifier de locale. */
+static bool est_sans_appel(Atome const *atome)
+{
+    if (!atome->est_instruction()) {
+        return true;
+    }
+
+    auto inst = atome->comme_instruction();
+    switch (inst->genre) {
+        case GenreInstruction::ALLOCATION:
+        {
+            return true;
+        }
+        case GenreInstruction::CHARGE_MÉMOIRE:
+        {
+            return est_sans_appel(inst->comme_charge()->chargée);
+        }
+        case GenreInstruction::ACCÈS_RUBRIQUE:
+        {
+            return est_sans_appel(inst->comme_accès_rubrique()->accédé);
+        }
+        case GenreInstruction::ACCÈS_INDICE:
+        {
+            auto accès = inst->comme_accès_indice();
+            return est_sans_appel(accès->accédé) && est_sans_appel(accès->indice);
+        }
+        case GenreInstruction::OPÉRATION_UNAIRE:
+        {
+            return est_sans_appel(inst->comme_op_unaire()->valeur);
+        }
+        case GenreInstruction::OPÉRATION_BINAIRE:
+        {
+            auto op_binaire = inst->comme_op_binaire();
+            return est_sans_appel(op_binaire->valeur_gauche) &&
+                   est_sans_appel(op_binaire->valeur_droite);
+        }
+        case GenreInstruction::TRANSTYPE:
+        {
+            return est_sans_appel(inst->comme_transtype()->valeur);
+        }
+        default:
+        {
+            return false;
+        }
+    }
+}
+
+std::optional<OpérationRegistres> CompilatriceCodeBinaire::donne_opération_registres(
+    Atome const *atome, Chunk const &chunk) const
+{
+    if (!utilise_registres || !atome->est_instruction()) {
+        return {};
+    }
+
+    auto inst = atome->comme_instruction();
+    if (!inst->est_op_binaire()) {
+        return {};
+    }
+
+    auto op_binaire = inst->comme_op_binaire();
+    auto taille_gauche = donne_type_primitif(op_binaire->valeur_gauche->type)->taille_octet;
+    auto taille_droite = donne_type_primitif(op_binaire->valeur_droite->type)->taille_octet;
+    if (taille_gauche != taille_droite) {
+        return {};
+    }
+
+    auto résultat = OpérationRegistres{};
+    résultat.op = convertis_op_binaire(op_binaire->op);
+    résultat.type = donne_type_opérandes_registres(résultat.op, taille_gauche);
+    if (résultat.type == 0) {
+        return {};
+    }
+
+    auto const taille_résultat = est_code_opération_comparaison(résultat.op) ? 1u :
+                                                                                 taille_gauche;
+    if (donne_type_primitif(op_binaire->type)->taille_octet != taille_résultat) {
+        return {};
+    }
+
+    auto gauche = donne_opérande_registre(op_binaire->valeur_gauche, chunk);
+    auto droite = donne_opérande_registre(op_binaire->valeur_droite, chunk);
+
+    /* Sans opérande dans la frame ou dans le code, l'instruction sur la pile est aussi courte. */
+    if (!gauche.has_value() && !droite.has_value()) {
+        return {};
+    }
+
+    /* L'opérande droite est calculé avant la lecture de la locale gauche, qui doit donc ne pas
+     * pouvoir être modifiée par ce calcul. */
+    if (!droite.has_value() && gauche->genre == OpérandeRegistre::Genre::LOCALE &&
+        !est_sans_appel(op_binaire->valeur_droite)) {
+        return {};
+    }
+
+    résultat.gauche = gauche.value_or(
+        OpérandeRegistre{OpérandeRegistre::Genre::PILE, 0, op_binaire->valeur_gauche});
+    résultat.droite = droite.value_or(
+        OpérandeRegistre{OpérandeRegistre::Genre::PILE, 0, op_binaire->valeur_droite});
+    return résultat;
+}
+
+void CompilatriceCodeBinaire::génère_code_opérandes_pile(OpérationRegistres const &opération,
+                                                         Chunk &chunk)
+{
+    if (opération.gauche.genre == OpérandeRegistre::Genre::PILE) {
+        génère_code_pour_atome(opération.gauche.atome, chunk);
+    }
+    if (opération.droite.genre == OpérandeRegistre::Genre::PILE) {
+        génère_code_pour_atome(opération.droite.atome, chunk);
+    }
+}
+
 ContexteGénérationCodeBinaire CompilatriceCodeBinaire::contexte() const
 {
     return {espace, fonction_courante};
@@ -2234,10 +2751,68 @@ void CompilatriceCodeBinaire::ajoute_réadressage_pour_globale(
     données_exécutions->patchs_données_constantes.ajoute(patch);
 }
 
+static std::optional<ArgumentAppelDirect> donne_argument_appel_direct(ffi_type const *type)
+{
+    if (type == &ffi_type_uint8) {
+        return ArgumentAppelDirect{1, false};
+    }
+    if (type == &ffi_type_sint8) {
+        return ArgumentAppelDirect{1, true};
+    }
+    if (type == &ffi_type_uint16) {
+        return ArgumentAppelDirect{2, false};
+    }
+    if (type == &ffi_type_sint16) {
+        return ArgumentAppelDirect{2, true};
+    }
+    if (type == &ffi_type_uint32) {
+        return ArgumentAppelDirect{4, false};
+    }
+    if (type == &ffi_type_sint32) {
+        return ArgumentAppelDirect{4, true};
+    }
+    if (type == &ffi_type_uint64 || type == &ffi_type_pointer) {
+        return ArgumentAppelDirect{8, false};
+    }
+    if (type == &ffi_type_sint64) {
+        return ArgumentAppelDirect{8, true};
+    }
+    return {};
+}
+
+void DonnéesExécutionFonction::DonnéesFonctionExterne::prépare_appel_direct()
+{
+    nombre_arguments_appel_direct = -1;
+
+    /* Nous nous reposons sur la convention d'appel System V où tous les scalaires entiers
+     * sont passés et retournés via des registres entiers, les petits entiers étant étendus
+     * par l'appelant. */
+#if defined(__x86_64__) && !defined(_MSC_VER)
+    if (cif.abi != FFI_DEFAULT_ABI || cif.nargs > NOMBRE_MAX_ARGUMENTS_APPEL_DIRECT) {
+        return;
+    }
+
+    if (cif.rtype != &ffi_type_void && !donne_argument_appel_direct(cif.rtype).has_value()) {
+        return;
+    }
+
+    for (auto i = 0u; i < cif.nargs; i++) {
+        auto argument = donne_argument_appel_direct(cif.arg_types[i]);
+        if (!argument.has_value()) {
+            return;
+        }
+        arguments_appel_direct[i] = argument.value();
+    }
+
+    nombre_arguments_appel_direct = static_cast<int>(cif.nargs);
+#endif
+}
+
 int64_t DonnéesExécutionFonction::mémoire_utilisée() const
 {
     int64_t résultat = 0;
     résultat += chunk.mémoire_utilisée();
     résultat += données_externe.types_entrées.taille_mémoire();
+    résultat += données_jit.types_entrées.taille_mémoire();
     return résultat;
 }
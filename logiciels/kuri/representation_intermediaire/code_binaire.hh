@@ -4,6 +4,7 @@
 #pragma once
 
 #include <ffi.h>  // pour ffi_type qui est un typedef
+#include <optional>
 
 #include "arbre_syntaxique/prodeclaration.hh"
 
@@ -114,6 +115,11 @@ using octet_t = unsigned char;
     ENUMERE_CODE_OPERATION_EX(OP_NATUREL_VERS_RÉEL)                                               \
     ENUMERE_CODE_OPERATION_EX(OP_RELATIF_VERS_RÉEL)                                               \
     ENUMERE_CODE_OPERATION_EX(OP_REMBOURRAGE)                                                     \
+    ENUMERE_CODE_OPERATION_EX(OP_CHARGE_LOCALE_AJOUTE)                                            \
+    ENUMERE_CODE_OPERATION_EX(OP_CHARGE_LOCALE_CHARGE_LOCALE)                                     \
+    ENUMERE_CODE_OPERATION_EX(OP_COMP_INF_BRANCHE_CONDITION)                                      \
+    ENUMERE_CODE_OPERATION_EX(OP_OPÉRATION_REGISTRES)                                             \
+    ENUMERE_CODE_OPERATION_EX(OP_BRANCHE_REGISTRES)                                               \
     ENUMERE_CODE_OPERATION_EX(OP_VÉRIFIE_ADRESSAGE_CHARGE)                                        \
     ENUMERE_CODE_OPERATION_EX(OP_VÉRIFIE_ADRESSAGE_ASSIGNE)                                       \
     ENUMERE_CODE_OPERATION_EX(OP_VÉRIFIE_CIBLE_APPEL)                                             \
@@ -225,6 +231,58 @@ struct Locale {
     int adresse = 0;
 };
 
+/* Opérande des instructions à registres : soit une valeur immédiate, soit l'adresse d'une locale
+ * (ou d'une rubrique d'une locale) dans la frame, soit une valeur temporaire calculée sur la pile
+ * avant l'instruction. Les valeurs immédiates et les adresses sont encodées sur 8 octets dans le
+ * code, les valeurs sur la pile n'y occupent rien. */
+struct OpérandeRegistre {
+    enum class Genre : octet_t {
+        LOCALE,
+        IMMÉDIAT,
+        PILE,
+    };
+
+    Genre genre = Genre::LOCALE;
+    int64_t valeur = 0;
+    /* Pour les opérandes sur la pile, l'atome dont le code est généré avant l'instruction. */
+    Atome const *atome = nullptr;
+};
+
+/* Les modes des opérandes sont encodés dans un octet : le genre de l'opérande gauche dans les deux
+ * bits de poids faible, celui de l'opérande droite dans les deux suivants. */
+inline octet_t donne_modes_opérandes(OpérandeRegistre::Genre gauche,
+                                     OpérandeRegistre::Genre droite)
+{
+    return octet_t(int(gauche) | (int(droite) << 2));
+}
+
+inline OpérandeRegistre::Genre donne_genre_opérande_gauche(octet_t modes)
+{
+    return OpérandeRegistre::Genre(modes & 3);
+}
+
+inline OpérandeRegistre::Genre donne_genre_opérande_droite(octet_t modes)
+{
+    return OpérandeRegistre::Genre((modes >> 2) & 3);
+}
+
+/* Une opération binaire dont au moins un opérande est une locale ou une constante. Le type est
+ * celui des opérandes, au format de drapeau_pour_constante.
+ *
+ * Seules l'arithmétique, les opérations binaires et les comparaisons sur des entiers de 1, 2, 4 ou
+ * 8 octets ou des réels de 4 ou 8 octets ont une forme à registres. Les opérations dont les deux
+ * opérandes sont des temporaires, ainsi que les autres instructions (accès indexés, appels,
+ * transtypages), passent toujours par la pile. */
+struct OpérationRegistres {
+    octet_t op = 0;
+    octet_t type = 0;
+    OpérandeRegistre gauche{};
+    OpérandeRegistre droite{};
+};
+
+/* Pour OP_OPÉRATION_REGISTRES, la destination indiquant que le résultat doit être empilé. */
+static constexpr int DESTINATION_PILE = -1;
+
 struct Chunk {
     octet_t *code = nullptr;
     int64_t compte = 0;
@@ -252,6 +310,11 @@ struct Chunk {
 
     kuri::tableau<SiteSource, int> m_sites_source{};
 
+    /* Pour former des superinstructions : le décalage de la dernière opération émise, et si
+     * celle-ci est déjà la seconde opération d'une superinstruction. */
+    int64_t m_décalage_dernière_op = -1;
+    bool m_dernière_op_fusionnée = false;
+
   public:
     ~Chunk();
 
@@ -278,6 +341,7 @@ struct Chunk {
     void agrandis_si_nécessaire(int64_t taille);
 
     void émets_entête_op(octet_t op, NoeudExpression const *site);
+    void forme_superinstruction(octet_t op);
 
     void émets_logue_instruction(int32_t décalage);
     void émets_logue_appel(AtomeFonction const *atome);
@@ -295,6 +359,10 @@ struct Chunk {
     void émets_profile_débute_appel();
     void émets_profile_termine_appel();
 
+    void émets_opérande_registre(OpérandeRegistre opérande);
+    void émets_notifie_dépilage_opérandes(NoeudExpression const *site,
+                                          OpérationRegistres const &opération);
+
     void ajoute_site_source(NoeudExpression const *site);
 
   public:
@@ -390,6 +458,16 @@ struct Chunk {
     void rétrécis_capacité_sur_taille();
 
     void émets_copie_mémoire(const NoeudExpression *site, uint32_t taille_octet);
+
+    /* La destination est l'adresse de la locale dans la frame, ou DESTINATION_PILE. */
+    void émets_opération_registres(NoeudExpression const *site,
+                                   OpérationRegistres const &opération,
+                                   int destination);
+    void émets_branche_registres(NoeudExpression const *site,
+                                 kuri::tableau<PatchLabel> &patchs_labels,
+                                 OpérationRegistres const &opération,
+                                 int indice_label_si_vrai,
+                                 int indice_label_si_faux);
 };
 
 [[nodiscard]] kuri::chaine désassemble(Chunk const &chunk, kuri::chaine_statique nom);
@@ -402,6 +480,15 @@ struct Globale {
     void *adresse_pour_exécution = nullptr;
 };
 
+/* Argument ou sortie d'une fonction pouvant être appelée directement, sans passer par
+ * ffi_call : un scalaire entier ou un pointeur, passé dans un registre entier. */
+struct ArgumentAppelDirect {
+    uint8_t taille = 0;
+    bool est_signé = false;
+};
+
+static constexpr int NOMBRE_MAX_ARGUMENTS_APPEL_DIRECT = 6;
+
 struct DonnéesExécutionFonction {
     Chunk chunk{};
 
@@ -409,10 +496,26 @@ struct DonnéesExécutionFonction {
         kuri::tablet<ffi_type *, 6> types_entrées{};
         ffi_cif cif{};
         void (*ptr_fonction)() = nullptr;
+
+        /* Si la signature n'est composée que de scalaires entiers ou de pointeurs, la fonction
+         * est appelée directement via un pointeur de fonction de la bonne arité au lieu de
+         * ffi_call. -1 si la fonction doit être appelée via libffi. */
+        int nombre_arguments_appel_direct = -1;
+        ArgumentAppelDirect arguments_appel_direct[NOMBRE_MAX_ARGUMENTS_APPEL_DIRECT] = {};
+
+        /* Détermine si la fonction peut être appelée directement, selon l'interface d'appel
+         * préparée. */
+        void prépare_appel_direct();
     };
 
     DonnéesFonctionExterne données_externe{};
 
+    /* Pour la compilation à la volée : le code natif de la fonction est appelé via libffi, comme
+     * une fonction externe. */
+    DonnéesFonctionExterne données_jit{};
+    int64_t nombre_appels = 0;
+    bool compilation_jit_échouée = false;
+
     int64_t mémoire_utilisée() const;
 };
 
@@ -440,6 +543,7 @@ class CompilatriceCodeBinaire {
     bool émets_stats_ops = false;
     bool notifie_empilage = false;
     bool émets_profilage = false;
+    bool utilise_registres = false;
 
   public:
     CompilatriceCodeBinaire(EspaceDeTravail *espace_, MétaProgramme *métaprogramme_);
@@ -461,6 +565,13 @@ class CompilatriceCodeBinaire {
 
     void génère_code_pour_atome(Atome const *atome, Chunk &chunk);
 
+    std::optional<int> donne_adresse_dans_frame(Atome const *atome, Chunk const &chunk) const;
+    std::optional<OpérandeRegistre> donne_opérande_registre(Atome const *atome,
+                                                            Chunk const &chunk) const;
+    std::optional<OpérationRegistres> donne_opération_registres(Atome const *atome,
+                                                                Chunk const &chunk) const;
+    void génère_code_opérandes_pile(OpérationRegistres const &opération, Chunk &chunk);
+
     bool ajoute_globale(AtomeGlobale *globale) const;
     void génère_code_pour_globale(AtomeGlobale const *atome_globale) const;
 
@@ -284,6 +284,34 @@ AtomeGlobale *RegistreSymboliqueRI::trouve_ou_insère_globale(NoeudDéclaration
     return decl_var->atome->comme_globale();
 }
 
+void RegistreSymboliqueRI::libère_ri_fonctions()
+{
+    std::unique_lock lock(mutex_atomes_fonctions);
+
+    POUR_TABLEAU_PAGE (fonctions) {
+        if (it.ri_libérée) {
+            continue;
+        }
+
+        m_mémoire_ri_libérée += it.libère_ri();
+        m_nombre_ri_libérées += 1;
+    }
+
+    mémoire::rends_mémoire_libérée();
+}
+
+void RegistreSymboliqueRI::libère_ri_fonction(AtomeFonction *fonction)
+{
+    std::unique_lock lock(mutex_atomes_fonctions);
+
+    if (fonction->ri_libérée) {
+        return;
+    }
+
+    m_mémoire_ri_libérée += fonction->libère_ri();
+    m_nombre_ri_libérées += 1;
+}
+
 void RegistreSymboliqueRI::rassemble_statistiques(Statistiques &stats) const
 {
     auto &stats_ri = stats.stats_ri;
@@ -293,18 +321,38 @@ void RegistreSymboliqueRI::rassemble_statistiques(Statistiques &stats) const
     auto mémoire_instructions = int64_t(0);
     auto gaspillage_instructions = int64_t(0);
     auto mémoire_code_binaire = int64_t(0);
+    auto mémoire_arènes = int64_t(0);
+    auto gaspillage_arènes = int64_t(0);
+    auto nombre_arènes = int64_t(0);
+    auto plus_grande_arène = int64_t(0);
     pour_chaque_élément(fonctions, [&](AtomeFonction const &it) {
         mémoire_paramètres += it.params_entrée.taille_mémoire();
         gaspillage_paramètres += it.params_entrée.gaspillage_mémoire();
         mémoire_instructions += it.instructions.taille_mémoire();
         gaspillage_instructions += it.instructions.gaspillage_mémoire();
 
+        if (it.arène) {
+            auto const mémoire_arène = it.arène->mémoire_utilisée();
+            mémoire_arènes += mémoire_arène;
+            gaspillage_arènes += it.arène->gaspillage_mémoire();
+            plus_grande_arène = std::max(plus_grande_arène, mémoire_arène);
+            nombre_arènes += 1;
+        }
+
         if (it.données_exécution) {
             mémoire_code_binaire += it.données_exécution->mémoire_utilisée();
             mémoire_code_binaire += taille_de(DonnéesExécutionFonction);
         }
     });
 
+    /* Les arènes ne font pas partie des statistiques de la RI afin d'être rapportées séparément
+     * dans la mémoire utilisée. */
+    stats.ajoute_mémoire_utilisée("RI Arènes Fonctions", mémoire_arènes);
+    stats.nombre_arènes_ri += nombre_arènes;
+    stats.plus_grande_arène_ri = std::max(stats.plus_grande_arène_ri, plus_grande_arène);
+    stats.nombre_arènes_ri_libérées += m_nombre_ri_libérées;
+    stats.mémoire_arènes_ri_libérée += m_mémoire_ri_libérée;
+
     stats_ri.fusionne_entrée({"paramètres_fonctions", fonctions.taille(), mémoire_paramètres});
     stats_ri.fusionne_entrée({"instructions_fonctions", fonctions.taille(), mémoire_instructions});
     stats_ri.fusionne_entrée({"fonctions", fonctions.taille(), fonctions.mémoire_utilisée()});
@@ -317,6 +365,7 @@ void RegistreSymboliqueRI::rassemble_statistiques(Statistiques &stats) const
     auto &stats_gaspillage = stats.stats_gaspillage;
     stats_gaspillage.fusionne_entrée({"Instructions RI", 1, gaspillage_instructions});
     stats_gaspillage.fusionne_entrée({"Paramètres Fonctions RI", 1, gaspillage_paramètres});
+    stats_gaspillage.fusionne_entrée({"Arènes Fonctions RI", 1, gaspillage_arènes});
 }
 
 /** \} */
@@ -368,7 +417,7 @@ InstructionAllocation *ConstructriceRI::crée_allocation(NoeudExpression const *
 {
     /* le résultat d'une instruction d'allocation est l'adresse de la variable. */
     auto type_pointeur = m_typeuse->type_pointeur_pour(const_cast<Type *>(type), false);
-    auto inst = m_alloc.ajoute_élément(site_, type_pointeur, ident);
+    auto inst = alloue_instruction(m_alloc, site_, type_pointeur, ident);
 
     /* Nous utilisons pour l'instant crée_allocation pour les paramètres des
      * fonctions, et la fonction_courante est nulle lors de cette opération.
@@ -564,7 +613,7 @@ InstructionBranche *ConstructriceRI::crée_branche(NoeudExpression const *site_,
                                                   InstructionLabel *label,
                                                   bool crée_seulement)
 {
-    auto inst = m_branche.ajoute_élément(site_, label);
+    auto inst = alloue_instruction(m_branche, site_, label);
 
     label->drapeaux |= DrapeauxAtome::EST_UTILISÉ;
 
@@ -581,7 +630,7 @@ InstructionBrancheCondition *ConstructriceRI::crée_branche_condition(
     InstructionLabel *label_si_vrai,
     InstructionLabel *label_si_faux)
 {
-    auto inst = m_branche_cond.ajoute_élément(site_, valeur, label_si_vrai, label_si_faux);
+    auto inst = alloue_instruction(m_branche_cond, site_, valeur, label_si_vrai, label_si_faux);
 
     label_si_vrai->drapeaux |= DrapeauxAtome::EST_UTILISÉ;
     label_si_faux->drapeaux |= DrapeauxAtome::EST_UTILISÉ;
@@ -592,14 +641,14 @@ InstructionBrancheCondition *ConstructriceRI::crée_branche_condition(
 
 InstructionLabel *ConstructriceRI::crée_label(NoeudExpression const *site_)
 {
-    auto inst = m_label.ajoute_élément(site_, m_nombre_labels++);
+    auto inst = alloue_instruction(m_label, site_, m_nombre_labels++);
     insère_label(inst);
     return inst;
 }
 
 InstructionLabel *ConstructriceRI::réserve_label(NoeudExpression const *site_)
 {
-    return m_label.ajoute_élément(site_, m_nombre_labels++);
+    return alloue_instruction(m_label, site_, m_nombre_labels++);
 }
 
 /* Pour dédupliquer les chargements de mémoire, afin de réduire la mémoire utilisée. */
@@ -641,7 +690,7 @@ void ConstructriceRI::insère_label_si_utilisé(InstructionLabel *label)
 
 InstructionRetour *ConstructriceRI::crée_retour(NoeudExpression const *site_, Atome *valeur)
 {
-    auto inst = m_retour.ajoute_élément(site_, valeur);
+    auto inst = alloue_instruction(m_retour, site_, valeur);
     insère(inst);
     return inst;
 }
@@ -669,7 +718,7 @@ InstructionStockeMem *ConstructriceRI::crée_stocke_mem(NoeudExpression const *s
                       }
                   });
 
-    auto inst = m_stocke_mem.ajoute_élément(site_, ou, valeur);
+    auto inst = alloue_instruction(m_stocke_mem, site_, ou, valeur);
 
     if (!crée_seulement) {
         insère(inst);
@@ -706,7 +755,7 @@ InstructionChargeMem *ConstructriceRI::crée_charge_mem(NoeudExpression const *s
     }
 #endif
 
-    auto inst = m_charge.ajoute_élément(site_, type, ou);
+    auto inst = alloue_instruction(m_charge, site_, type, ou);
 
     if (!crée_seulement) {
         insère(inst);
@@ -722,7 +771,7 @@ InstructionCopieMémoire *ConstructriceRI::crée_copie_mémoire(NoeudExpression
                                                              uint32_t taille,
                                                              bool crée_seulement)
 {
-    auto résultat = m_copie_mémoire.ajoute_élément(site_, destination, source, taille);
+    auto résultat = alloue_instruction(m_copie_mémoire, site_, destination, source, taille);
     if (!crée_seulement) {
         insère(résultat);
     }
@@ -731,7 +780,7 @@ InstructionCopieMémoire *ConstructriceRI::crée_copie_mémoire(NoeudExpression
 
 InstructionAppel *ConstructriceRI::crée_appel(NoeudExpression const *site_, Atome *appelé)
 {
-    auto inst = m_appel.ajoute_élément(site_, appelé);
+    auto inst = alloue_instruction(m_appel, site_, appelé);
     insère(inst);
     return inst;
 }
@@ -764,7 +813,7 @@ InstructionAppel *ConstructriceRI::crée_appel(NoeudExpression const *site_,
     }
 #endif
 
-    auto inst = m_appel.ajoute_élément(site_, appelé, std::move(args));
+    auto inst = alloue_instruction(m_appel, site_, appelé, std::move(args));
     insère(inst);
     return inst;
 }
@@ -811,7 +860,7 @@ Atome *ConstructriceRI::crée_op_unaire(NoeudExpression const *site_,
         }
     }
 
-    auto inst = m_op_unaire.ajoute_élément(site_, type, op, valeur);
+    auto inst = alloue_instruction(m_op_unaire, site_, type, op, valeur);
     insère(inst);
     return inst;
 }
@@ -856,7 +905,7 @@ Atome *ConstructriceRI::crée_op_binaire(NoeudExpression const *site_,
         return remplacement;
     }
 
-    auto inst = m_op_binaire.ajoute_élément(site_, type, op, valeur_gauche, valeur_droite);
+    auto inst = alloue_instruction(m_op_binaire, site_, type, op, valeur_gauche, valeur_droite);
     insère(inst);
     return inst;
 }
@@ -894,7 +943,7 @@ InstructionAccèsIndice *ConstructriceRI::crée_accès_indice(NoeudExpression co
 
     auto type = m_typeuse->type_pointeur_pour(type_déréférencé_pour(type_élément), false);
 
-    auto inst = m_accès_indice.ajoute_élément(site_, type, accédé, indice);
+    auto inst = alloue_instruction(m_accès_indice, site_, type, accédé, indice);
     insère(inst);
     return inst;
 }
@@ -903,7 +952,7 @@ InstructionAccèsRubrique *ConstructriceRI::crée_référence_rubrique(
     NoeudExpression const *site_, Type const *type, Atome *accédé, int indice, bool crée_seulement)
 {
 
-    auto inst = m_accès_rubrique.ajoute_élément(site_, type, accédé, indice);
+    auto inst = alloue_instruction(m_accès_rubrique, site_, type, accédé, indice);
     if (!crée_seulement) {
         insère(inst);
     }
@@ -1326,7 +1375,7 @@ Atome *ConstructriceRI::crée_transtype(NoeudExpression const *site_,
 
     // dbg() << __func__ << ", type : " << chaine_type(type) << ", valeur " <<
     // chaine_type(valeur->type);
-    auto inst = m_transtype.ajoute_élément(site_, type, valeur, op);
+    auto inst = alloue_instruction(m_transtype, site_, type, valeur, op);
     insère(inst);
     return inst;
 }
@@ -1459,7 +1508,7 @@ AtomeConstante *ConstructriceRI::crée_initialisation_défaut_pour_type(Type con
 InstructionInatteignable *ConstructriceRI::crée_inatteignable(const NoeudExpression *site,
                                                               bool crée_seulement)
 {
-    auto résultat = m_inatteignable.ajoute_élément(site);
+    auto résultat = alloue_instruction(m_inatteignable, site);
     if (!crée_seulement) {
         insère(résultat);
     }
@@ -1469,7 +1518,7 @@ InstructionInatteignable *ConstructriceRI::crée_inatteignable(const NoeudExpres
 InstructionSélection *ConstructriceRI::crée_sélection(NoeudExpression const *site,
                                                       bool crée_seulement)
 {
-    auto résultat = m_sélection.ajoute_élément(site);
+    auto résultat = alloue_instruction(m_sélection, site);
     if (!crée_seulement) {
         insère(résultat);
     }
@@ -1479,7 +1528,7 @@ InstructionSélection *ConstructriceRI::crée_sélection(NoeudExpression const *
 InstructionArrêtDébug *ConstructriceRI::crée_arrêt_débug(NoeudExpression const *site,
                                                          bool crée_seulement)
 {
-    auto résultat = m_arrêt_débug.ajoute_élément(site);
+    auto résultat = alloue_instruction(m_arrêt_débug, site);
     if (!crée_seulement) {
         insère(résultat);
     }
@@ -1502,6 +1551,11 @@ InstructionChargeMem *ConstructriceRI::donne_charge(Atome *source)
     return nullptr;
 }
 
+void ConstructriceRI::invalide_charges()
+{
+    m_charges.efface();
+}
+
 void ConstructriceRI::invalide_charge(Atome *source)
 {
     POUR (m_charges) {
@@ -1679,7 +1733,7 @@ AtomeFonction *CompilatriceRI::génère_fonction_init_globales_et_appel(
     kuri::tableau_statique<AtomeGlobale *> globales, AtomeFonction *fonction_pour)
 {
     auto nom_fonction = enchaine("init_globale", fonction_pour);
-    auto ident_nom = m_compilatrice.table_identifiants->identifiant_pour_nouvelle_chaine(
+    auto ident_nom = m_compilatrice.table_identifiants.identifiant_pour_nouvelle_chaine(
         nom_fonction);
 
     auto types_entrées = kuri::tablet<Type *, 6>(0);
@@ -2272,7 +2326,7 @@ void CompilatriceRI::génère_ri_pour_noeud(NoeudExpression *noeud, Atome *place
         case GenreNoeud::EXPRESSION_LITTÉRALE_CHAINE:
         {
             auto lit_chaine = noeud->comme_littérale_chaine();
-            auto chaine = compilatrice().gérante_chaine->chaine_pour_adresse(lit_chaine->valeur);
+            auto chaine = compilatrice().gérante_chaine.chaine_pour_adresse(lit_chaine->valeur);
 
             assert_rappel(
                 (noeud->lexème->chaine.taille() != 0 && chaine.taille() != 0) ||
@@ -42,6 +42,9 @@ struct RegistreSymboliqueRI {
 
     ConstructriceRI *m_constructrice = nullptr;
 
+    int64_t m_nombre_ri_libérées = 0;
+    int64_t m_mémoire_ri_libérée = 0;
+
   public:
     RegistreSymboliqueRI(Typeuse &typeuse);
 
@@ -68,6 +71,14 @@ struct RegistreSymboliqueRI {
 
     AtomeGlobale *trouve_ou_insère_globale(NoeudDéclaration *decl);
 
+    /* Libère les instructions de toutes les fonctions, une fois que le code final de l'espace fut
+     * généré. Les atomes des fonctions et des globales sont gardés. */
+    void libère_ri_fonctions();
+
+    /* Libère les instructions d'une seule fonction. Peut être appelée depuis plusieurs fils à la
+     * fois, par exemple lors de la génération en parallèle des fichiers C. */
+    void libère_ri_fonction(AtomeFonction *fonction);
+
     void rassemble_statistiques(Statistiques &stats) const;
 };
 
@@ -235,6 +246,10 @@ struct ConstructriceRI {
 
     void insère(Instruction *inst);
 
+    /* Vide le cache de déduplication des chargements, pour les transformations copiant des
+     * instructions hors de l'ordre de génération du code. */
+    void invalide_charges();
+
     Typeuse &typeuse()
     {
         return *m_typeuse;
@@ -243,6 +258,19 @@ struct ConstructriceRI {
   private:
     kuri::chaine imprime_site(NoeudExpression const *site) const;
 
+    /* Les instructions sont allouées dans l'arène de la fonction courante, afin de pouvoir être
+     * libérées avec celle-ci. Celles créées hors d'une fonction, par exemple les paramètres,
+     * vivent aussi longtemps que la constructrice. */
+    template <typename T, typename... Args>
+    T *alloue_instruction(kuri::tableau_page<T> &instructions, Args &&...args)
+    {
+        if (m_fonction_courante) {
+            return m_fonction_courante->donne_arène().ajoute_instruction<T>(
+                std::forward<Args>(args)...);
+        }
+        return instructions.ajoute_élément(std::forward<Args>(args)...);
+    }
+
     /* Déduplication des instructions de chargement. Nous ne créons des chargements que la première
      * fois qu'une valeur est chargée et après chaque stockage vers la valeur chargée. */
     kuri::tableau<InstructionChargeMem *, int> m_charges{};
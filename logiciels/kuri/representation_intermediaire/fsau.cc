@@ -3,8 +3,14 @@
 
 #include "fsau.hh"
 
+#include <algorithm>  // pour rotate
+
 #include "arbre_syntaxique/noeud_expression.hh"
 
+#include "compilation/typage.hh"
+
+#include "statistiques/statistiques.hh"
+
 #include "utilitaires/algorithmes.hh"
 #include "utilitaires/log.hh"
 #include "utilitaires/type_opaque.hh"
@@ -19,6 +25,7 @@
 #include "constructrice_ri.hh"
 #include "impression.hh"
 #include "instructions.hh"
+#include "regles_optimisation.hh"
 
 #define INSTRUCTION_NON_IMPLEMENTEE                                                               \
     assert_rappel(false, [&]() { dbg() << "Instruction non-gérée " << inst->genre; })
@@ -31,7 +38,11 @@
 
 namespace FSAU {
 
-static void rièrevertis_en_ri(FonctionEtBlocs &fonction_et_blocs, ConstructriceRI &constructrice);
+struct TableDesRelations;
+
+static void rièrevertis_en_ri(FonctionEtBlocs &fonction_et_blocs,
+                              TableDesRelations &table,
+                              ConstructriceRI &constructrice);
 
 CREE_TYPE_OPAQUE(indice_table_utilisateur, int32_t);
 static const indice_table_utilisateur indice_utilisateur_invalide = indice_table_utilisateur(-1);
@@ -1043,6 +1054,9 @@ struct ConvertisseuseFSAU {
     kuri::tableau_page<FSAU::ValeurConstante> m_constante_entières{};
     kuri::tableau_page<FSAU::ValeurConstante> m_constante_booléennes{};
 
+    /* Instructions pour les opérateurs créés par les règles de réécriture. */
+    kuri::tableau_page<InstructionOpBinaire> m_instructions_op_binaire{};
+
     ConstructriceRI &m_constructrice;
 
     TableDesRelations m_table_relations{};
@@ -1061,6 +1075,50 @@ struct ConvertisseuseFSAU {
         return m_table_relations;
     }
 
+    ConstructriceRI &donne_constructrice()
+    {
+        return m_constructrice;
+    }
+
+    /* Retourne la valeur pour une constante calculée par une passe d'optimisation. Si elle
+     * n'existe pas encore, la valeur est ajoutée au début du bloc d'entrée afin de ne pas suivre
+     * son instruction de contrôle de flux. */
+    Valeur *donne_valeur_pour_constante(Bloc *bloc_entrée, AtomeConstante const *atome)
+    {
+        auto const taille_avant = bloc_entrée->valeurs.taille();
+        auto résultat = donne_valeur_pour_atome(
+            bloc_entrée, atome, UtilisationAtome::POUR_OPÉRATEUR);
+        if (bloc_entrée->valeurs.taille() != taille_avant) {
+            std::rotate(bloc_entrée->valeurs.begin(),
+                        bloc_entrée->valeurs.end() - 1,
+                        bloc_entrée->valeurs.end());
+        }
+        return résultat;
+    }
+
+    /* Crée un opérateur binaire dans le bloc, juste avant la valeur « avant ». */
+    ValeurOpérateurBinaire *crée_opérateur_binaire(Bloc *bloc,
+                                                  Valeur const *avant,
+                                                  Type const *type,
+                                                  OpérateurBinaire::Genre op,
+                                                  Valeur *gauche,
+                                                  Valeur *droite)
+    {
+        auto inst = m_instructions_op_binaire.ajoute_élément(
+            nullptr, type, op, nullptr, nullptr);
+
+        auto résultat = m_opérateur_binaire.ajoute_élément();
+        résultat->définis_gauche(m_table_relations, gauche);
+        résultat->définis_droite(m_table_relations, droite);
+        résultat->inst = inst;
+        résultat->indice_bloc = avant->indice_bloc;
+        ajoute_valeur_au_bloc(résultat, bloc);
+
+        auto position = std::find(bloc->valeurs.begin(), bloc->valeurs.end(), avant);
+        std::rotate(position, bloc->valeurs.end() - 1, bloc->valeurs.end());
+        return résultat;
+    }
+
   public:
     // algorithme 1 : local value numbering
 
@@ -1331,9 +1389,6 @@ struct ConvertisseuseFSAU {
 
         return nullptr;
     }
-
-  private:
-    Valeur *crée_opérateur_binaire();
 };
 
 #define DEBOGUE_UTILISATION_INSTRUCTION                                                           \
@@ -1915,17 +1970,27 @@ static bool détecte_expressions_communes(FonctionEtBlocs &fonction_et_blocs,
     return résultat;
 }
 
+/* Renseigne pour chaque valeur l'indice de son bloc dans fonction_et_blocs.blocs. */
+static void assigne_indices_blocs(FonctionEtBlocs &fonction_et_blocs)
+{
+    int32_t indice_bloc = 0;
+    POUR_NOMME (bloc, fonction_et_blocs.blocs) {
+        POUR_NOMME (valeur, bloc->valeurs) {
+            valeur->indice_bloc = indice_bloc;
+        }
+        indice_bloc++;
+    }
+}
+
 static bool supprime_code_inutile(FonctionEtBlocs &fonction_et_blocs, TableDesRelations &table)
 {
     auto résultat = false;
 
-    int32_t indice_bloc = 0;
+    assigne_indices_blocs(fonction_et_blocs);
     POUR_NOMME (bloc, fonction_et_blocs.blocs) {
         POUR_NOMME (valeur, bloc->valeurs) {
-            valeur->indice_bloc = indice_bloc;
             valeur->drapeaux &= ~DrapeauxValeur::PARTICIPE_AU_FLOT_DU_PROGRAMME;
         }
-        indice_bloc++;
     }
 
     /* Remplace les phis par leurs dernières opérandes si toutes les opérandes sont dans le bloc du
@@ -1972,35 +2037,9 @@ static bool supprime_code_inutile(FonctionEtBlocs &fonction_et_blocs, TableDesRe
         }
     }
 
-    /* Deuxième passe pour les indice. */
+    /* Deuxième passe pour les indice. Les écritures surécrites furent marquées par
+     * supprime_stockages_morts. */
     POUR_NOMME (bloc, fonction_et_blocs.blocs) {
-        kuri::tablet<ValeurÉcrisIndice *, 16> valeurs_écris_indice;
-        POUR_NOMME (valeur, bloc->valeurs) {
-            if (!valeur->est_écris_indice()) {
-                continue;
-            }
-
-            auto écris_indice = valeur->comme_écris_indice();
-            auto accédée = écris_indice->donne_accédée();
-            if (!accédée->possède_drapeau(DrapeauxValeur::PARTICIPE_AU_FLOT_DU_PROGRAMME)) {
-                continue;
-            }
-
-            POUR (valeurs_écris_indice) {
-                if (it->donne_accédée() != accédée) {
-                    continue;
-                }
-
-                if (it->donne_indice() != écris_indice->donne_indice()) {
-                    continue;
-                }
-
-                it->drapeaux |= DrapeauxValeur::ÉCRIS_INDICE_EST_SURÉCRIS;
-            }
-
-            valeurs_écris_indice.ajoute(écris_indice);
-        }
-
         POUR_NOMME (valeur, bloc->valeurs) {
             if (!valeur->est_écris_indice() ||
                 !valeur->possède_drapeau(DrapeauxValeur::NE_PRODUIS_PAS_DE_VALEUR) ||
@@ -2192,227 +2231,1495 @@ static bool propage_temporaires(FonctionEtBlocs &fonction_et_blocs, TableDesRela
     return résultat;
 }
 
-void convertis_fsau(EspaceDeTravail &espace,
-                    AtomeFonction *fonction,
-                    ConstructriceRI &constructrice)
-{
-    FonctionEtBlocs fonction_et_blocs;
-    if (!fonction_et_blocs.convertis_en_blocs(espace, fonction)) {
-        return;
-    }
+/* ------------------------------------------------------------------------- */
+/** \name Informations de dominance.
+ *
+ * Calculées selon « A Simple, Fast Dominance Algorithm » de Cooper, Harvey et Kennedy : les
+ * dominateurs immédiats sont raffinés en visitant les blocs en ordre postfixe inverse jusqu'à
+ * convergence.
+ * \{ */
 
-    auto convertisseuse_fsau = ConvertisseuseFSAU{constructrice};
+struct InformationsDominance {
+    kuri::table_hachage<Bloc const *, int> indices_blocs{"Indices blocs FSAU"};
+    /* Les blocs atteignables depuis le bloc d'entrée, en ordre postfixe inverse. */
+    kuri::tableau<Bloc *, int> ordre_postfixe_inverse{};
+    /* Indexés selon la position des blocs dans FonctionEtBlocs::blocs, -1 pour les blocs
+     * inatteignables. */
+    kuri::tableau<int, int> rang_postfixe{};
+    kuri::tableau<int, int> dominateur_immédiat{};
 
-    kuri::file<Bloc *> blocs;
-    blocs.enfile(fonction_et_blocs.blocs[0]);
+    explicit InformationsDominance(FonctionEtBlocs const &fonction_et_blocs);
 
-    POUR (fonction->params_entrée) {
-        it->drapeaux |= DrapeauxAtome::EST_PARAMÈTRE_FONCTION;
-        (void)convertisseuse_fsau.génère_valeur_pour_instruction(
-            fonction_et_blocs.blocs[0], it, UtilisationAtome::RACINE);
+    int donne_indice(Bloc const *bloc) const
+    {
+        return indices_blocs.valeur_ou(bloc, -1);
     }
 
-    /* Insère la valeur de retour dans le premier bloc. */
-    (void)convertisseuse_fsau.génère_valeur_pour_instruction(
-        fonction_et_blocs.blocs[0], fonction->param_sortie, UtilisationAtome::RACINE);
-
-    while (!blocs.est_vide()) {
-        auto bloc = blocs.défile();
-
-        // dbg() << "dépile bloc " << bloc;
-
-        if (bloc->tous_les_parents_furent_remplis()) {
-            convertisseuse_fsau.scelle_bloc(bloc);
-            if (bloc->possède_drapeau(DrapeauxBlocBasique::EST_REMPLIS)) {
-                continue;
-            }
-        }
+    bool est_atteignable(int indice_bloc) const
+    {
+        return indice_bloc >= 0 && dominateur_immédiat[indice_bloc] != -1;
+    }
 
-        if (!bloc->possède_drapeau(DrapeauxBlocBasique::EST_REMPLIS)) {
-            dbg() << "Remplis bloc " << bloc->label->id;
+    /* Retourne vrai si le bloc a domine le bloc b. Un bloc se domine lui-même. */
+    bool domine(int a, int b) const;
 
-            POUR_NOMME (inst, bloc->instructions) {
-                if (!instruction_est_racine(inst) && !inst->est_alloc()) {
-                    continue;
-                }
-                (void)convertisseuse_fsau.génère_valeur_pour_instruction(
-                    bloc, inst, UtilisationAtome::RACINE);
-            }
-            bloc->drapeaux |= DrapeauxBlocBasique::EST_REMPLIS;
-        }
+  private:
+    int intersecte(int a, int b) const;
+};
 
-        if (!bloc->tous_les_parents_furent_remplis()) {
-            blocs.enfile(bloc);
-            // dbg() << "empile bloc " << bloc << " car tous les parents ne furent pas remplis";
-            POUR (bloc->parents) {
-                if (it->possède_drapeau(DrapeauxBlocBasique::EST_REMPLIS)) {
-                    continue;
-                }
+InformationsDominance::InformationsDominance(FonctionEtBlocs const &fonction_et_blocs)
+{
+    auto const &blocs = fonction_et_blocs.blocs;
+    POUR_INDICE (blocs) {
+        indices_blocs.insère(it, indice_it);
+    }
 
-                // dbg() << "-- parent non remplis " << it;
-            }
-        }
+    rang_postfixe.redimensionne(blocs.taille(), -1);
+    dominateur_immédiat.redimensionne(blocs.taille(), -1);
 
-        POUR (bloc->enfants) {
-            blocs.enfile(it);
-            // dbg() << "empile bloc " << it;
-        }
+    if (blocs.est_vide()) {
+        return;
     }
 
-    TableDesRelations &table_des_relations = convertisseuse_fsau.donne_table_des_relations();
-
-    imprime_blocs(fonction_et_blocs);
+    /* Parcours en profondeur itératif pour l'ordre postfixe. */
+    struct ÉlémentPile {
+        Bloc *bloc = nullptr;
+        int enfant_suivant = 0;
+    };
 
-    auto visiteuse = VisiteuseBlocs(fonction_et_blocs);
+    kuri::tableau<ÉlémentPile, int> pile;
+    kuri::tableau<bool, int> visités;
+    visités.redimensionne(blocs.taille(), false);
+    kuri::tableau<Bloc *, int> ordre_postfixe;
 
-    while (true) {
-        auto chose_faite = false;
+    pile.ajoute({blocs[0], 0});
+    visités[0] = true;
 
-        chose_faite |= supprime_branches_inutiles(
-            fonction_et_blocs, visiteuse, table_des_relations);
+    while (!pile.est_vide()) {
+        auto &sommet = pile.dernier_élément();
 
-        chose_faite |= détecte_expressions_communes(fonction_et_blocs, table_des_relations);
-        chose_faite |= propage_temporaires(fonction_et_blocs, table_des_relations);
-        chose_faite |= simplifie_accès_indice(fonction_et_blocs, table_des_relations);
+        if (sommet.enfant_suivant < sommet.bloc->enfants.taille()) {
+            auto enfant = sommet.bloc->enfants[sommet.enfant_suivant++];
+            auto indice_enfant = donne_indice(enfant);
+            if (indice_enfant != -1 && !visités[indice_enfant]) {
+                visités[indice_enfant] = true;
+                pile.ajoute({enfant, 0});
+            }
+            continue;
+        }
 
-        // Redondant avec supprime_code_inutile, ne prends pas en compte les accès_indice
-        // supprime_valeurs_inutilisées(fonction_et_blocs, table_des_relations);
-        chose_faite |= supprime_code_inutile(fonction_et_blocs, table_des_relations);
+        rang_postfixe[donne_indice(sommet.bloc)] = ordre_postfixe.taille();
+        ordre_postfixe.ajoute(sommet.bloc);
+        pile.supprime_dernier();
+    }
 
-        if (!chose_faite) {
-            break;
-        }
+    for (auto i = ordre_postfixe.taille() - 1; i >= 0; i--) {
+        ordre_postfixe_inverse.ajoute(ordre_postfixe[i]);
     }
 
-    numérote_valeurs(fonction_et_blocs);
-    imprime_blocs(fonction_et_blocs);
+    dominateur_immédiat[0] = 0;
 
-    //    POUR_NOMME (bloc, fonction_et_blocs.blocs) {
-    //        POUR_NOMME (valeur, bloc->valeurs) {
-    //            visite_opérande(valeur, [&](Valeur *opérande) {
-    //                table_des_relations.ajoute_utilisateur(opérande, valeur);
-    //            });
-    //        }
-    //    }
+    auto changé = true;
+    while (changé) {
+        changé = false;
 
-    POUR_NOMME (bloc, fonction_et_blocs.blocs) {
-        POUR_NOMME (valeur, bloc->valeurs) {
-            if (valeur->est_controle_de_flux() ||
-                valeur->possède_drapeau(DrapeauxValeur::NE_PRODUIS_PAS_DE_VALEUR)) {
+        POUR (ordre_postfixe_inverse) {
+            auto indice = donne_indice(it);
+            if (indice == 0) {
                 continue;
             }
 
-            auto utilisateurs = table_des_relations.donne_utilisateurs(valeur);
+            auto nouveau_dominateur = -1;
+            POUR_NOMME (parent, it->parents) {
+                auto indice_parent = donne_indice(parent);
+                if (indice_parent == -1 || dominateur_immédiat[indice_parent] == -1) {
+                    continue;
+                }
 
-            dbg() << "v" << valeur->numéro << ", utilisateurs : ";
-            POUR (utilisateurs) {
-                if (it->est_controle_de_flux() ||
-                    it->possède_drapeau(DrapeauxValeur::NE_PRODUIS_PAS_DE_VALEUR)) {
-                    dbg() << "-- " << it->genre;
+                if (nouveau_dominateur == -1) {
+                    nouveau_dominateur = indice_parent;
                 }
                 else {
-                    dbg() << "-- v" << it->numéro;
+                    nouveau_dominateur = intersecte(indice_parent, nouveau_dominateur);
                 }
             }
+
+            if (dominateur_immédiat[indice] != nouveau_dominateur) {
+                dominateur_immédiat[indice] = nouveau_dominateur;
+                changé = true;
+            }
         }
     }
-
-    rièrevertis_en_ri(fonction_et_blocs, constructrice);
 }
 
-/* ------------------------------------------------------------------------- */
-/** \name Implémentation de la table des relations.
- * \{ */
-
-void TableDesRelations::remplace_ou_ajoute_utilisateur(Valeur *utilisée,
-                                                       Valeur *ancien,
-                                                       Valeur *par)
+int InformationsDominance::intersecte(int a, int b) const
 {
-    if (ancien) {
-        supprime_utilisateur(ancien, par);
+    while (a != b) {
+        while (rang_postfixe[a] < rang_postfixe[b]) {
+            a = dominateur_immédiat[a];
+        }
+        while (rang_postfixe[b] < rang_postfixe[a]) {
+            b = dominateur_immédiat[b];
+        }
     }
-
-    ajoute_utilisateur(utilisée, par);
+    return a;
 }
 
-void TableDesRelations::ajoute_utilisateur(Valeur *utilisée, Valeur *par)
+bool InformationsDominance::domine(int a, int b) const
 {
-    auto indice_données_utilisée = donne_indice_pour_valeur(utilisée);
+    if (!est_atteignable(a) || !est_atteignable(b)) {
+        return false;
+    }
 
-    auto &indice = m_indice[int32_t(indice_données_utilisée)];
+    while (b != a) {
+        if (b == 0) {
+            return false;
+        }
+        b = dominateur_immédiat[b];
+    }
 
-    auto info = UtilisateurValeur{par, indice_utilisateur_invalide, indice_utilisateur_invalide};
+    return true;
+}
 
-    if (indice.premier_utilisateur == indice_utilisateur_invalide) {
-        /* Insère un nouvelle utilisateur. */
-        indice.premier_utilisateur = indice_table_utilisateur(m_utilisateurs.taille());
-    }
-    else {
-        /* Trouve le dernier utilisateur. */
-        auto utilisateur = &m_utilisateurs[int32_t(indice.premier_utilisateur)];
-        info.précédent = indice.premier_utilisateur;
-        while (utilisateur->suivant != indice_utilisateur_invalide) {
-            info.précédent = utilisateur->suivant;
-            utilisateur = &m_utilisateurs[int32_t(utilisateur->suivant)];
-        }
+/** \} */
 
-        utilisateur->suivant = indice_table_utilisateur(m_utilisateurs.taille());
-    }
+/* ------------------------------------------------------------------------- */
+/** \name Fonctions auxiliaires pour les passes d'optimisation.
+ * \{ */
 
-    // dbg() << __func__ << " : "
-    //       << "précédent " << info.précédent << " suivant " << info.suivant;
+static bool est_opérateur_commutatif(OpérateurBinaire::Genre op)
+{
+    switch (op) {
+        case OpérateurBinaire::Genre::Addition:
+        case OpérateurBinaire::Genre::Multiplication:
+        case OpérateurBinaire::Genre::Et_Binaire:
+        case OpérateurBinaire::Genre::Ou_Binaire:
+        case OpérateurBinaire::Genre::Ou_Exclusif:
+        case OpérateurBinaire::Genre::Comp_Égal:
+        case OpérateurBinaire::Genre::Comp_Inégal:
+        {
+            return true;
+        }
+        default:
+        {
+            return false;
+        }
+    }
+}
 
-    m_utilisateurs.ajoute(info);
+static bool est_division_ou_reste(OpérateurBinaire::Genre op)
+{
+    return op == OpérateurBinaire::Genre::Division_Naturel ||
+           op == OpérateurBinaire::Genre::Division_Relatif ||
+           op == OpérateurBinaire::Genre::Reste_Naturel ||
+           op == OpérateurBinaire::Genre::Reste_Relatif;
 }
 
-bool TableDesRelations::est_utilisée(const Valeur *valeur) const
+static bool est_constante_entière(Valeur const *valeur)
 {
-    auto const indice_données_utilisation = valeur->indice_relations;
-    if (indice_données_utilisation == indice_relation_invalide) {
+    if (!valeur->est_constante()) {
         return false;
     }
-    return m_indice[int32_t(indice_données_utilisation)].premier_utilisateur !=
-           indice_utilisateur_invalide;
+
+    auto atome = valeur->comme_constante()->atome;
+    return atome && atome->est_constante_entière();
 }
 
-void TableDesRelations::supprime(const Valeur *valeur)
+/* Les opérandes des phis doivent rester des locales : les passes remplaçant des valeurs ignorent
+ * donc les phis, et ne considèrent que les valeurs ayant d'autres utilisateurs. */
+static bool possède_utilisateur_hors_phi(TableDesRelations const &table, Valeur const *valeur)
 {
-    /* Supprime la valeur de la liste des utilisateurs des valeurs qu'elle utilise. */
-    for (int i = 0; i < m_indice.taille(); i++) {
-        if (m_indice[i].premier_utilisateur == indice_utilisateur_invalide) {
-            continue;
+    POUR (table.donne_utilisateurs(valeur)) {
+        if (it != valeur && !it->est_phi()) {
+            return true;
         }
+    }
+    return false;
+}
 
-        supprime_utilisateur(indice_table_relation(i), valeur);
+static uint64_t donne_masque_pour_type(Type const *type)
+{
+    if (type->taille_octet == 0 || type->taille_octet >= 8) {
+        return ~uint64_t(0);
     }
+
+    return (uint64_t(1) << (type->taille_octet * 8)) - 1;
 }
 
-kuri::tablet<Valeur *, 6> TableDesRelations::donne_utilisateurs(const Valeur *valeur) const
+/** \} */
+
+/* ------------------------------------------------------------------------- */
+/** \name Propagation creuse de constantes conditionnelle.
+ *
+ * Wegman et Zadeck, « Constant Propagation with Conditional Branches ». Chaque valeur reçoit un
+ * état dans le treillis HAUT (inconnue) > CONSTANTE > BAS (variable). Seuls les blocs atteignables
+ * selon les conditions déjà connues sont évalués, ce qui permet de propager les constantes au
+ * travers des phis dont certaines opérandes proviennent de branches mortes.
+ * \{ */
+
+enum class GenreÉtatTreillis : uint8_t {
+    HAUT,
+    CONSTANTE,
+    BAS,
+};
+
+struct ÉtatTreillis {
+    GenreÉtatTreillis genre = GenreÉtatTreillis::HAUT;
+    AtomeConstante const *constante = nullptr;
+};
+
+static bool sont_constantes_égales(AtomeConstante const *a, AtomeConstante const *b)
 {
-    kuri::tablet<Valeur *, 6> résultat;
+    if (a == b) {
+        return true;
+    }
 
-    auto const indice_données_utilisation = valeur->indice_relations;
-    // assert(indice_données_utilisation != -1);
-    if (indice_données_utilisation == indice_relation_invalide) {
-        return résultat;
+    if (a->genre_atome != b->genre_atome || a->type != b->type) {
+        return false;
     }
 
-    auto &indice = m_indice[int32_t(indice_données_utilisation)];
+    if (a->est_constante_entière()) {
+        return a->comme_constante_entière()->valeur == b->comme_constante_entière()->valeur;
+    }
 
-    auto indice_utilisateur = indice.premier_utilisateur;
-    while (indice_utilisateur != indice_utilisateur_invalide) {
-        auto utilisateur = m_utilisateurs[int32_t(indice_utilisateur)].utilisateur;
-        résultat.ajoute(utilisateur);
-        indice_utilisateur = m_utilisateurs[int32_t(indice_utilisateur)].suivant;
+    if (a->est_constante_booléenne()) {
+        return a->comme_constante_booléenne()->valeur == b->comme_constante_booléenne()->valeur;
     }
 
-    return résultat;
+    return false;
 }
 
-void TableDesRelations::supprime_utilisateur(Valeur *utilisée, Valeur const *par)
+static bool sont_états_égaux(ÉtatTreillis const &a, ÉtatTreillis const &b)
 {
-    auto indice_données_utilisée = utilisée->indice_relations;
-    assert(indice_données_utilisée != indice_relation_invalide);
+    if (a.genre != b.genre) {
+        return false;
+    }
+
+    if (a.genre != GenreÉtatTreillis::CONSTANTE) {
+        return true;
+    }
+
+    return sont_constantes_égales(a.constante, b.constante);
+}
+
+static ÉtatTreillis rencontre(ÉtatTreillis const &a, ÉtatTreillis const &b)
+{
+    if (a.genre == GenreÉtatTreillis::HAUT) {
+        return b;
+    }
+
+    if (b.genre == GenreÉtatTreillis::HAUT) {
+        return a;
+    }
+
+    if (sont_états_égaux(a, b)) {
+        return a;
+    }
+
+    return {GenreÉtatTreillis::BAS, nullptr};
+}
+
+/* Évalue l'opérateur si les constantes sont d'un genre supporté par évalue_opérateur_binaire. */
+static AtomeConstante const *évalue_constantes(InstructionOpBinaire const *inst,
+                                               AtomeConstante const *gauche,
+                                               AtomeConstante const *droite,
+                                               ConstructriceRI &constructrice)
+{
+    if (gauche->genre_atome != droite->genre_atome) {
+        return nullptr;
+    }
+
+    if (gauche->est_constante_booléenne()) {
+        if (inst->op != OpérateurBinaire::Genre::Comp_Égal &&
+            inst->op != OpérateurBinaire::Genre::Comp_Inégal) {
+            return nullptr;
+        }
+    }
+    else if (!gauche->est_constante_entière()) {
+        return nullptr;
+    }
+
+    if (est_division_ou_reste(inst->op) && est_constante_entière_zéro(droite)) {
+        return nullptr;
+    }
+
+    InstructionOpBinaire tmp(inst->site);
+    tmp.type = inst->type;
+    tmp.op = inst->op;
+    tmp.valeur_gauche = const_cast<AtomeConstante *>(gauche);
+    tmp.valeur_droite = const_cast<AtomeConstante *>(droite);
+    return évalue_opérateur_binaire(&tmp, constructrice);
+}
+
+struct PropagationConstantes {
+    kuri::table_hachage<Valeur const *, ÉtatTreillis> états{"États propagation constantes"};
+
+    ÉtatTreillis donne_état(Valeur const *valeur) const
+    {
+        if (valeur->est_constante()) {
+            auto atome = valeur->comme_constante()->atome;
+            if (!atome) {
+                return {GenreÉtatTreillis::BAS, nullptr};
+            }
+            return {GenreÉtatTreillis::CONSTANTE, atome};
+        }
+
+        auto trouvé = false;
+        auto résultat = états.trouve(valeur, trouvé);
+        if (!trouvé) {
+            /* La valeur ne se trouve dans aucun bloc (p.e. la valeur indéfinie remplaçant un phi
+             * trivial) : nous ne pouvons rien supposer. */
+            return {GenreÉtatTreillis::BAS, nullptr};
+        }
+        return résultat;
+    }
+
+    ÉtatTreillis évalue(Valeur const *valeur, ConstructriceRI &constructrice) const
+    {
+        switch (valeur->genre) {
+            case FSAU::GenreValeur::LOCALE:
+            {
+                auto valeur_locale = valeur->comme_locale()->donne_valeur();
+                if (!valeur_locale) {
+                    break;
+                }
+                return donne_état(valeur_locale);
+            }
+            case FSAU::GenreValeur::PHI:
+            {
+                /* Les opérandes provenant de blocs non-exécutables n'ont jamais été évaluées et
+                 * restent donc HAUT, ce qui est neutre pour la rencontre. */
+                auto résultat = ÉtatTreillis{};
+                POUR (valeur->comme_phi()->opérandes) {
+                    if (it == valeur) {
+                        continue;
+                    }
+                    résultat = rencontre(résultat, donne_état(it));
+                }
+                return résultat;
+            }
+            case FSAU::GenreValeur::OPÉRATEUR_BINAIRE:
+            {
+                auto op_binaire = valeur->comme_opérateur_binaire();
+                auto état_gauche = donne_état(op_binaire->donne_gauche());
+                auto état_droite = donne_état(op_binaire->donne_droite());
+
+                if (état_gauche.genre == GenreÉtatTreillis::BAS ||
+                    état_droite.genre == GenreÉtatTreillis::BAS) {
+                    break;
+                }
+
+                if (état_gauche.genre == GenreÉtatTreillis::HAUT ||
+                    état_droite.genre == GenreÉtatTreillis::HAUT) {
+                    return {};
+                }
+
+                auto constante = évalue_constantes(
+                    op_binaire->inst, état_gauche.constante, état_droite.constante, constructrice);
+                if (!constante) {
+                    break;
+                }
+                return {GenreÉtatTreillis::CONSTANTE, constante};
+            }
+            default:
+            {
+                break;
+            }
+        }
+
+        return {GenreÉtatTreillis::BAS, nullptr};
+    }
+
+    /* Retourne vrai si le contrôle peut passer du bloc à l'enfant selon les états connus. */
+    bool arête_est_exécutable(Bloc const *bloc, Bloc const *enfant) const
+    {
+        Valeur const *terminatrice = nullptr;
+        for (auto i = bloc->valeurs.taille() - 1; i >= 0; i--) {
+            if (bloc->valeurs[i]->est_controle_de_flux()) {
+                terminatrice = bloc->valeurs[i];
+                break;
+            }
+        }
+
+        if (!terminatrice || !terminatrice->est_branche_cond()) {
+            return true;
+        }
+
+        auto branche = terminatrice->comme_branche_cond();
+        auto état = donne_état(branche->donne_condition());
+        if (état.genre == GenreÉtatTreillis::HAUT) {
+            return false;
+        }
+
+        if (état.genre == GenreÉtatTreillis::BAS || !état.constante->est_constante_booléenne()) {
+            return true;
+        }
+
+        auto label = état.constante->comme_constante_booléenne()->valeur ?
+                         branche->inst->label_si_vrai :
+                         branche->inst->label_si_faux;
+        return enfant->label == label;
+    }
+};
+
+static bool propage_constantes_creuses(FonctionEtBlocs &fonction_et_blocs,
+                                       ConvertisseuseFSAU &convertisseuse)
+{
+    auto &blocs = fonction_et_blocs.blocs;
+    if (blocs.est_vide()) {
+        return false;
+    }
+
+    auto &constructrice = convertisseuse.donne_constructrice();
+    auto &table = convertisseuse.donne_table_des_relations();
+
+    kuri::table_hachage<Bloc const *, int> indices_blocs{"Indices blocs propagation"};
+    PropagationConstantes propagation;
+
+    POUR_INDICE (blocs) {
+        indices_blocs.insère(it, indice_it);
+
+        POUR_NOMME (valeur, it->valeurs) {
+            if (!valeur->est_constante()) {
+                propagation.états.insère(valeur, ÉtatTreillis{});
+            }
+        }
+    }
+
+    kuri::tableau<bool, int> blocs_exécutables;
+    blocs_exécutables.redimensionne(blocs.taille(), false);
+    blocs_exécutables[0] = true;
+
+    auto changé = true;
+    while (changé) {
+        changé = false;
+
+        POUR_INDICE (blocs) {
+            if (!blocs_exécutables[indice_it]) {
+                continue;
+            }
+
+            POUR_NOMME (valeur, it->valeurs) {
+                if (valeur->est_constante()) {
+                    continue;
+                }
+
+                auto ancien_état = propagation.donne_état(valeur);
+                if (ancien_état.genre == GenreÉtatTreillis::BAS) {
+                    continue;
+                }
+
+                /* La rencontre garantie que les états ne font que descendre dans le treillis. */
+                auto nouvel_état = rencontre(ancien_état,
+                                             propagation.évalue(valeur, constructrice));
+                if (sont_états_égaux(ancien_état, nouvel_état)) {
+                    continue;
+                }
+
+                *propagation.états.trouve_pointeur(valeur) = nouvel_état;
+                changé = true;
+            }
+
+            POUR_NOMME (enfant, it->enfants) {
+                if (!propagation.arête_est_exécutable(it, enfant)) {
+                    continue;
+                }
+
+                auto indice_enfant = indices_blocs.valeur_ou(enfant, -1);
+                if (indice_enfant != -1 && !blocs_exécutables[indice_enfant]) {
+                    blocs_exécutables[indice_enfant] = true;
+                    changé = true;
+                }
+            }
+        }
+    }
+
+    /* Rassemble les remplacements avant de les faire, car les nouvelles constantes sont ajoutées
+     * au bloc d'entrée. */
+    struct Remplacement {
+        Valeur *valeur = nullptr;
+        AtomeConstante const *constante = nullptr;
+    };
+    kuri::tablet<Remplacement, 16> remplacements;
+
+    POUR_INDICE (blocs) {
+        if (!blocs_exécutables[indice_it]) {
+            continue;
+        }
+
+        POUR_NOMME (valeur, it->valeurs) {
+            if (!valeur->est_phi() && !valeur->est_opérateur_binaire()) {
+                continue;
+            }
+
+            if (!possède_utilisateur_hors_phi(table, valeur)) {
+                continue;
+            }
+
+            auto état = propagation.donne_état(valeur);
+            if (état.genre != GenreÉtatTreillis::CONSTANTE) {
+                continue;
+            }
+
+            remplacements.ajoute({valeur, état.constante});
+        }
+    }
+
+    POUR (remplacements) {
+        auto constante = convertisseuse.donne_valeur_pour_constante(blocs[0], it.constante);
+        it.valeur->remplace_par(table, constante, DrapeauxRemplacement::IGNORE_PHI);
+    }
+
+    return !remplacements.est_vide();
+}
+
+/** \} */
+
+/* ------------------------------------------------------------------------- */
+/** \name Numérotation globale des valeurs.
+ *
+ * Les opérateurs binaires et transtypages équivalents à une valeur précédente sont remplacés par
+ * celle-ci si son bloc domine le leur. Les blocs sont visités en ordre postfixe inverse afin de
+ * visiter les dominateurs avant les blocs qu'ils dominent.
+ * \{ */
+
+static size_t combine_empreintes(size_t graine, size_t empreinte)
+{
+    return graine ^ (empreinte + 0x9e3779b9 + (graine << 6) + (graine >> 2));
+}
+
+static size_t donne_empreinte_valeur(Valeur const *valeur)
+{
+    if (valeur->est_transtypage()) {
+        auto transtypage = valeur->comme_transtypage();
+        auto résultat = std::hash<Type const *>()(transtypage->inst->type);
+        résultat = combine_empreintes(résultat, size_t(transtypage->inst->op));
+        return combine_empreintes(résultat,
+                                  std::hash<Valeur const *>()(transtypage->donne_valeur()));
+    }
+
+    auto op_binaire = valeur->comme_opérateur_binaire();
+    auto empreinte_gauche = std::hash<Valeur const *>()(op_binaire->donne_gauche());
+    auto empreinte_droite = std::hash<Valeur const *>()(op_binaire->donne_droite());
+    if (est_opérateur_commutatif(op_binaire->inst->op) && empreinte_gauche > empreinte_droite) {
+        std::swap(empreinte_gauche, empreinte_droite);
+    }
+
+    auto résultat = std::hash<Type const *>()(op_binaire->inst->type);
+    résultat = combine_empreintes(résultat, size_t(op_binaire->inst->op));
+    résultat = combine_empreintes(résultat, empreinte_gauche);
+    return combine_empreintes(résultat, empreinte_droite);
+}
+
+static bool sont_valeurs_équivalentes(Valeur const *a, Valeur const *b)
+{
+    if (a->genre != b->genre) {
+        return false;
+    }
+
+    if (a->est_transtypage()) {
+        auto transtypage_a = a->comme_transtypage();
+        auto transtypage_b = b->comme_transtypage();
+        return transtypage_a->inst->type == transtypage_b->inst->type &&
+               transtypage_a->inst->op == transtypage_b->inst->op &&
+               transtypage_a->donne_valeur() == transtypage_b->donne_valeur();
+    }
+
+    auto op_a = a->comme_opérateur_binaire();
+    auto op_b = b->comme_opérateur_binaire();
+    if (op_a->inst->op != op_b->inst->op || op_a->inst->type != op_b->inst->type) {
+        return false;
+    }
+
+    if (op_a->donne_gauche() == op_b->donne_gauche() &&
+        op_a->donne_droite() == op_b->donne_droite()) {
+        return true;
+    }
+
+    return est_opérateur_commutatif(op_a->inst->op) &&
+           op_a->donne_gauche() == op_b->donne_droite() &&
+           op_a->donne_droite() == op_b->donne_gauche();
+}
+
+static bool numérote_valeurs_globalement(FonctionEtBlocs &fonction_et_blocs,
+                                         TableDesRelations &table)
+{
+    assigne_indices_blocs(fonction_et_blocs);
+    auto const dominance = InformationsDominance(fonction_et_blocs);
+
+    kuri::table_hachage<size_t, kuri::tablet<Valeur *, 4>> valeurs_disponibles{
+        "Valeurs disponibles"};
+    auto résultat = false;
+
+    POUR_NOMME (bloc, dominance.ordre_postfixe_inverse) {
+        auto const indice_bloc = dominance.donne_indice(bloc);
+
+        POUR_NOMME (valeur, bloc->valeurs) {
+            if (!valeur->est_opérateur_binaire() && !valeur->est_transtypage()) {
+                continue;
+            }
+
+            if (!possède_utilisateur_hors_phi(table, valeur)) {
+                continue;
+            }
+
+            auto const empreinte = donne_empreinte_valeur(valeur);
+            auto candidates = valeurs_disponibles.trouve_pointeur(empreinte);
+            if (!candidates) {
+                valeurs_disponibles.insère(empreinte, kuri::tablet<Valeur *, 4>());
+                candidates = valeurs_disponibles.trouve_pointeur(empreinte);
+            }
+
+            Valeur *équivalente = nullptr;
+            POUR (*candidates) {
+                if (sont_valeurs_équivalentes(it, valeur) &&
+                    dominance.domine(it->indice_bloc, indice_bloc)) {
+                    équivalente = it;
+                    break;
+                }
+            }
+
+            if (!équivalente) {
+                candidates->ajoute(valeur);
+                continue;
+            }
+
+            valeur->remplace_par(table, équivalente, DrapeauxRemplacement::IGNORE_PHI);
+            résultat = true;
+        }
+    }
+
+    return résultat;
+}
+
+/** \} */
+
+/* ------------------------------------------------------------------------- */
+/** \name Suppression des stockages morts.
+ *
+ * Chaque bloc est parcouru à rebours : une écriture à un indice est morte si le même indice de la
+ * même variable est réécrit plus loin dans le bloc sans que la variable ne soit lue entre temps.
+ * Les écritures mortes sont marquées, et supprimées par supprime_code_inutile.
+ * \{ */
+
+/* Retourne la variable à la racine des versions créées par les écritures à des indices. */
+static Valeur const *donne_racine_accédée(Valeur const *accédée)
+{
+    while (accédée->est_locale()) {
+        auto valeur = accédée->comme_locale()->donne_valeur();
+        if (!valeur || !valeur->est_écris_indice() ||
+            !valeur->possède_drapeau(DrapeauxValeur::NE_PRODUIS_PAS_DE_VALEUR)) {
+            break;
+        }
+
+        accédée = valeur->comme_écris_indice()->donne_accédée();
+    }
+
+    return accédée;
+}
+
+static bool supprime_stockages_morts(FonctionEtBlocs &fonction_et_blocs)
+{
+    struct ÉcritureFuture {
+        Valeur const *accédée = nullptr;
+        Valeur const *indice = nullptr;
+    };
+
+    auto résultat = false;
+
+    POUR_NOMME (bloc, fonction_et_blocs.blocs) {
+        /* Les écritures faites plus loin dans le bloc, sans lecture de leurs variables depuis. */
+        kuri::tablet<ÉcritureFuture, 16> écritures_futures;
+
+        auto oublie_écritures = [&](Valeur const *lue) {
+            if (!lue) {
+                return;
+            }
+
+            auto racine = donne_racine_accédée(lue);
+            auto nombre_restantes = 0;
+            POUR (écritures_futures) {
+                if (it.accédée != racine) {
+                    écritures_futures[nombre_restantes++] = it;
+                }
+            }
+            écritures_futures.redimensionne(nombre_restantes);
+        };
+
+        for (auto i = bloc->valeurs.taille() - 1; i >= 0; i--) {
+            auto valeur = bloc->valeurs[i];
+
+            if (!valeur->est_écris_indice() ||
+                !valeur->possède_drapeau(DrapeauxValeur::NE_PRODUIS_PAS_DE_VALEUR)) {
+                visite_opérande(valeur, oublie_écritures);
+                continue;
+            }
+
+            auto écris_indice = valeur->comme_écris_indice();
+            auto racine = donne_racine_accédée(écris_indice->donne_accédée());
+            auto indice = écris_indice->donne_indice();
+
+            auto est_surécrite = false;
+            POUR (écritures_futures) {
+                if (it.accédée == racine && it.indice == indice) {
+                    est_surécrite = true;
+                    break;
+                }
+            }
+
+            if (!est_surécrite) {
+                écritures_futures.ajoute({racine, indice});
+            }
+            else if (!valeur->possède_drapeau(DrapeauxValeur::ÉCRIS_INDICE_EST_SURÉCRIS)) {
+                valeur->drapeaux |= DrapeauxValeur::ÉCRIS_INDICE_EST_SURÉCRIS;
+                résultat = true;
+            }
+
+            /* L'écriture lit sa valeur et son indice. */
+            oublie_écritures(écris_indice->donne_valeur());
+            oublie_écritures(indice);
+        }
+    }
+
+    return résultat;
+}
+
+/** \} */
+
+/* ------------------------------------------------------------------------- */
+/** \name Déplacement des invariants de boucles.
+ *
+ * Les boucles sont détectées via leurs arêtes arrières (d'un bloc vers un bloc qui le domine).
+ * Les opérateurs et transtypages dont les opérandes sont définies hors de la boucle sont déplacés
+ * à la fin du bloc précédant l'entête, si ce bloc est unique et ne branche que vers l'entête.
+ * \{ */
+
+static bool peut_être_déplacée(Valeur const *valeur)
+{
+    if (valeur->est_transtypage()) {
+        return true;
+    }
+
+    if (!valeur->est_opérateur_binaire()) {
+        return false;
+    }
+
+    /* Une division par zéro ne doit pas être exécutée si la boucle ne l'aurait pas fait. */
+    return !est_division_ou_reste(valeur->comme_opérateur_binaire()->inst->op);
+}
+
+static bool opérandes_sont_invariantes(Valeur *valeur,
+                                       kuri::tableau<bool, int> const &dans_boucle)
+{
+    auto résultat = true;
+    visite_opérande(valeur, [&](Valeur *opérande) {
+        if (opérande->est_constante() || opérande->indice_bloc == -1) {
+            return;
+        }
+
+        if (dans_boucle[opérande->indice_bloc]) {
+            résultat = false;
+        }
+    });
+    return résultat;
+}
+
+static void insère_avant_terminatrice(Bloc *bloc, Valeur *valeur)
+{
+    bloc->valeurs.ajoute(valeur);
+
+    auto position = bloc->valeurs.taille() - 1;
+    while (position > 0 && bloc->valeurs[position - 1]->est_controle_de_flux()) {
+        position -= 1;
+    }
+
+    std::rotate(bloc->valeurs.begin() + position, bloc->valeurs.end() - 1, bloc->valeurs.end());
+}
+
+static bool déplace_invariants_boucles(FonctionEtBlocs &fonction_et_blocs,
+                                       TableDesRelations &table)
+{
+    assigne_indices_blocs(fonction_et_blocs);
+    auto const dominance = InformationsDominance(fonction_et_blocs);
+    auto const &blocs = fonction_et_blocs.blocs;
+    auto résultat = false;
+
+    kuri::tableau<bool, int> dans_boucle;
+    kuri::tableau<Bloc *, int> pile;
+
+    POUR_NOMME (entête, dominance.ordre_postfixe_inverse) {
+        auto const indice_entête = dominance.donne_indice(entête);
+
+        /* Rassemble le corps de la boucle en remontant depuis les sources des arêtes arrières. */
+        pile.efface();
+        POUR_NOMME (parent, entête->parents) {
+            if (dominance.domine(indice_entête, dominance.donne_indice(parent))) {
+                pile.ajoute(parent);
+            }
+        }
+
+        if (pile.est_vide()) {
+            continue;
+        }
+
+        dans_boucle.efface();
+        dans_boucle.redimensionne(blocs.taille(), false);
+        dans_boucle[indice_entête] = true;
+
+        while (!pile.est_vide()) {
+            auto bloc = pile.dernier_élément();
+            pile.supprime_dernier();
+
+            auto indice_bloc = dominance.donne_indice(bloc);
+            if (indice_bloc == -1 || dans_boucle[indice_bloc]) {
+                continue;
+            }
+
+            dans_boucle[indice_bloc] = true;
+            POUR (bloc->parents) {
+                pile.ajoute(it);
+            }
+        }
+
+        Bloc *pré_entête = nullptr;
+        auto nombre_pré_entêtes = 0;
+        POUR (entête->parents) {
+            auto indice_parent = dominance.donne_indice(it);
+            if (indice_parent != -1 && dans_boucle[indice_parent]) {
+                continue;
+            }
+
+            pré_entête = it;
+            nombre_pré_entêtes += 1;
+        }
+
+        if (nombre_pré_entêtes != 1 || pré_entête->enfants.taille() != 1) {
+            continue;
+        }
+
+        auto const indice_pré_entête = dominance.donne_indice(pré_entête);
+        if (!dominance.est_atteignable(indice_pré_entête)) {
+            continue;
+        }
+
+        /* Visite les blocs en ordre postfixe inverse pour rencontrer les définitions avant leurs
+         * utilisations, afin de pouvoir déplacer des chaînes de calculs. */
+        POUR_NOMME (bloc, dominance.ordre_postfixe_inverse) {
+            if (!dans_boucle[dominance.donne_indice(bloc)]) {
+                continue;
+            }
+
+            for (auto i = 0; i < bloc->valeurs.taille();) {
+                auto valeur = bloc->valeurs[i];
+
+                if (!peut_être_déplacée(valeur) || !table.est_utilisée(valeur) ||
+                    !opérandes_sont_invariantes(valeur, dans_boucle)) {
+                    i += 1;
+                    continue;
+                }
+
+                std::rotate(bloc->valeurs.begin() + i,
+                            bloc->valeurs.begin() + i + 1,
+                            bloc->valeurs.end());
+                bloc->valeurs.supprime_dernier();
+
+                insère_avant_terminatrice(pré_entête, valeur);
+                valeur->indice_bloc = indice_pré_entête;
+                résultat = true;
+            }
+        }
+    }
+
+    return résultat;
+}
+
+/** \} */
+
+/* ------------------------------------------------------------------------- */
+/** \name Règles de réécriture.
+ *
+ * Applique les règles de optimisations.txt, compilées en motifs par genere_regles_optimisation.
+ * \{ */
+
+using LiaisonsMotif = kuri::tablet<Valeur *, 8>;
+
+/* Retourne la valeur d'une locale, sauf si la locale doit être gardée (paramètres, tableaux). */
+static Valeur *donne_valeur_effective(Valeur *valeur)
+{
+    while (valeur->est_locale()) {
+        auto valeur_locale = valeur->comme_locale()->donne_valeur();
+        if (!valeur_locale || valeur_locale->est_indéfinie() || valeur_locale->est_écris_indice()) {
+            break;
+        }
+
+        valeur = valeur_locale;
+    }
+
+    return valeur;
+}
+
+static int donne_taille_sous_motif(NoeudMotif const *motif, int indice)
+{
+    if (motif[indice].genre != GenreNoeudMotif::OPÉRATEUR) {
+        return 1;
+    }
+
+    auto const taille_gauche = donne_taille_sous_motif(motif, indice + 1);
+    auto const taille_droite = donne_taille_sous_motif(motif, indice + 1 + taille_gauche);
+    return 1 + taille_gauche + taille_droite;
+}
+
+static bool filtre_motif(NoeudMotif const *motif,
+                         int indice,
+                         Valeur *valeur,
+                         LiaisonsMotif &liaisons)
+{
+    auto const &noeud = motif[indice];
+    auto effective = donne_valeur_effective(valeur);
+
+    switch (noeud.genre) {
+        case GenreNoeudMotif::OPÉRATEUR:
+        {
+            if (!effective->est_opérateur_binaire()) {
+                return false;
+            }
+
+            auto op_binaire = effective->comme_opérateur_binaire();
+            if (op_binaire->inst->op != noeud.op) {
+                return false;
+            }
+
+            auto const indice_gauche = indice + 1;
+            auto const indice_droite = indice_gauche + donne_taille_sous_motif(motif, indice_gauche);
+            auto gauche = op_binaire->donne_gauche();
+            auto droite = op_binaire->donne_droite();
+
+            auto const sauvegarde = liaisons;
+            if (filtre_motif(motif, indice_gauche, gauche, liaisons) &&
+                filtre_motif(motif, indice_droite, droite, liaisons)) {
+                return true;
+            }
+
+            liaisons = sauvegarde;
+            if (!est_opérateur_commutatif(noeud.op)) {
+                return false;
+            }
+
+            if (filtre_motif(motif, indice_gauche, droite, liaisons) &&
+                filtre_motif(motif, indice_droite, gauche, liaisons)) {
+                return true;
+            }
+
+            liaisons = sauvegarde;
+            return false;
+        }
+        case GenreNoeudMotif::VARIABLE:
+        case GenreNoeudMotif::CONSTANTE_LIÉE:
+        {
+            if (noeud.genre == GenreNoeudMotif::CONSTANTE_LIÉE && !est_constante_entière(effective)) {
+                return false;
+            }
+
+            auto &liée = liaisons[noeud.liaison];
+            if (!liée) {
+                liée = effective;
+                return true;
+            }
+
+            return liée == effective;
+        }
+        case GenreNoeudMotif::CONSTANTE:
+        {
+            if (!est_constante_entière(effective)) {
+                return false;
+            }
+
+            auto atome = effective->comme_constante()->atome->comme_constante_entière();
+            auto const masque = donne_masque_pour_type(atome->type);
+            return (atome->valeur & masque) == (static_cast<uint64_t>(noeud.valeur) & masque);
+        }
+        case GenreNoeudMotif::CONSTANTE_CALCULÉE:
+        {
+            /* N'apparaît que dans les remplacements. */
+            break;
+        }
+    }
+
+    return false;
+}
+
+static Valeur *crée_remplacement(NoeudMotif const *motif,
+                                 int indice,
+                                 LiaisonsMotif const &liaisons,
+                                 ValeurOpérateurBinaire const *racine,
+                                 Bloc *bloc,
+                                 Bloc *bloc_entrée,
+                                 ConvertisseuseFSAU &convertisseuse)
+{
+    auto const &noeud = motif[indice];
+    auto const type = racine->inst->type;
+    auto &constructrice = convertisseuse.donne_constructrice();
+
+    switch (noeud.genre) {
+        case GenreNoeudMotif::OPÉRATEUR:
+        {
+            auto const indice_gauche = indice + 1;
+            auto const indice_droite = indice_gauche + donne_taille_sous_motif(motif, indice_gauche);
+
+            auto gauche = crée_remplacement(
+                motif, indice_gauche, liaisons, racine, bloc, bloc_entrée, convertisseuse);
+            if (!gauche) {
+                return nullptr;
+            }
+
+            auto droite = crée_remplacement(
+                motif, indice_droite, liaisons, racine, bloc, bloc_entrée, convertisseuse);
+            if (!droite) {
+                return nullptr;
+            }
+
+            return convertisseuse.crée_opérateur_binaire(
+                bloc, racine, type, noeud.op, gauche, droite);
+        }
+        case GenreNoeudMotif::VARIABLE:
+        case GenreNoeudMotif::CONSTANTE_LIÉE:
+        {
+            return liaisons[noeud.liaison];
+        }
+        case GenreNoeudMotif::CONSTANTE:
+        {
+            auto atome = constructrice.crée_constante_nombre_entier(
+                type, static_cast<uint64_t>(noeud.valeur));
+            return convertisseuse.donne_valeur_pour_constante(bloc_entrée, atome);
+        }
+        case GenreNoeudMotif::CONSTANTE_CALCULÉE:
+        {
+            auto liée = liaisons[noeud.liaison]->comme_constante()->atome;
+            auto valeur = liée->comme_constante_entière()->valeur;
+            auto const opérande = static_cast<uint64_t>(noeud.valeur);
+
+            switch (noeud.op) {
+                case OpérateurBinaire::Genre::Addition:
+                {
+                    valeur += opérande;
+                    break;
+                }
+                case OpérateurBinaire::Genre::Soustraction:
+                {
+                    valeur -= opérande;
+                    break;
+                }
+                case OpérateurBinaire::Genre::Multiplication:
+                {
+                    valeur *= opérande;
+                    break;
+                }
+                default:
+                {
+                    return nullptr;
+                }
+            }
+
+            auto atome = constructrice.crée_constante_nombre_entier(
+                liée->type, valeur & donne_masque_pour_type(liée->type));
+            return convertisseuse.donne_valeur_pour_constante(bloc_entrée, atome);
+        }
+    }
+
+    return nullptr;
+}
+
+static bool applique_règles_réécriture(FonctionEtBlocs &fonction_et_blocs,
+                                       ConvertisseuseFSAU &convertisseuse)
+{
+    if (fonction_et_blocs.blocs.est_vide()) {
+        return false;
+    }
+
+    assigne_indices_blocs(fonction_et_blocs);
+
+    auto &table = convertisseuse.donne_table_des_relations();
+    auto bloc_entrée = fonction_et_blocs.blocs[0];
+    auto résultat = false;
+
+    POUR_NOMME (bloc, fonction_et_blocs.blocs) {
+        /* Copie les opérateurs, car les remplacements sont ajoutés aux blocs. */
+        kuri::tablet<ValeurOpérateurBinaire *, 16> opérateurs;
+        POUR_NOMME (valeur, bloc->valeurs) {
+            if (valeur->est_opérateur_binaire()) {
+                opérateurs.ajoute(valeur->comme_opérateur_binaire());
+            }
+        }
+
+        POUR_NOMME (op_binaire, opérateurs) {
+            if (!possède_utilisateur_hors_phi(table, op_binaire) ||
+                !est_type_entier(op_binaire->inst->type)) {
+                continue;
+            }
+
+            POUR_NOMME (règle, donne_règles_réécriture(op_binaire->inst->op)) {
+                LiaisonsMotif liaisons;
+                liaisons.redimensionne(règle.nombre_liaisons);
+                POUR (liaisons) {
+                    it = nullptr;
+                }
+
+                if (!filtre_motif(règle.motif, 0, op_binaire, liaisons)) {
+                    continue;
+                }
+
+                auto remplacement = crée_remplacement(règle.remplacement,
+                                                      0,
+                                                      liaisons,
+                                                      op_binaire,
+                                                      bloc,
+                                                      bloc_entrée,
+                                                      convertisseuse);
+                if (!remplacement || remplacement == op_binaire) {
+                    break;
+                }
+
+                op_binaire->remplace_par(table, remplacement, DrapeauxRemplacement::IGNORE_PHI);
+                résultat = true;
+                break;
+            }
+        }
+    }
+
+    return résultat;
+}
+
+/** \} */
+
+std::optional<PassesFSAU> donne_passes_fsau_pour_chaine(kuri::chaine_statique chaine)
+{
+    struct NomPasse {
+        kuri::chaine_statique nom;
+        PassesFSAU passes;
+    };
+
+    static const NomPasse noms_passes[] = {
+        {"aucune", PassesFSAU::AUCUNE},
+        {"propagation_constantes", PassesFSAU::PROPAGATION_CONSTANTES},
+        {"numérotation_valeurs", PassesFSAU::NUMÉROTATION_VALEURS},
+        {"stockages_morts", PassesFSAU::STOCKAGES_MORTS},
+        {"invariants_boucles", PassesFSAU::INVARIANTS_BOUCLES},
+        {"règles_réécriture", PassesFSAU::RÈGLES_RÉÉCRITURE},
+        {"toutes", PassesFSAU::TOUTES},
+    };
+
+    auto résultat = PassesFSAU::AUCUNE;
+    auto début = int64_t(0);
+
+    while (début <= chaine.taille()) {
+        auto fin = début;
+        while (fin < chaine.taille() && chaine.pointeur()[fin] != ',') {
+            fin += 1;
+        }
+
+        auto const nom = kuri::chaine_statique(chaine.pointeur() + début, fin - début);
+        auto trouvé = false;
+        for (auto const &nom_passe : noms_passes) {
+            if (nom_passe.nom == nom) {
+                résultat |= nom_passe.passes;
+                trouvé = true;
+                break;
+            }
+        }
+
+        if (!trouvé) {
+            return {};
+        }
+
+        début = fin + 1;
+    }
+
+    return résultat;
+}
+
+void convertis_fsau(EspaceDeTravail &espace,
+                    AtomeFonction *fonction,
+                    ConstructriceRI &constructrice,
+                    PassesFSAU passes,
+                    StatistiquesFSAU *stats)
+{
+    /* Exécute la passe, et accumule son temps d'exécution si des statistiques sont requises. */
+    auto chronomètre = [&](int entrée, auto &&passe) -> bool {
+        if (!stats) {
+            return passe();
+        }
+
+        auto début = kuri::chrono::compte_milliseconde();
+        auto résultat = passe();
+        stats->stats.fusionne_entrée(entrée, {"", début.temps()});
+        return résultat;
+    };
+
+    auto début_construction = kuri::chrono::compte_milliseconde();
+
+    FonctionEtBlocs fonction_et_blocs;
+    if (!fonction_et_blocs.convertis_en_blocs(espace, fonction)) {
+        return;
+    }
+
+    auto convertisseuse_fsau = ConvertisseuseFSAU{constructrice};
+
+    kuri::file<Bloc *> blocs;
+    blocs.enfile(fonction_et_blocs.blocs[0]);
+
+    POUR (fonction->params_entrée) {
+        it->drapeaux |= DrapeauxAtome::EST_PARAMÈTRE_FONCTION;
+        (void)convertisseuse_fsau.génère_valeur_pour_instruction(
+            fonction_et_blocs.blocs[0], it, UtilisationAtome::RACINE);
+    }
+
+    /* Insère la valeur de retour dans le premier bloc. */
+    (void)convertisseuse_fsau.génère_valeur_pour_instruction(
+        fonction_et_blocs.blocs[0], fonction->param_sortie, UtilisationAtome::RACINE);
+
+    while (!blocs.est_vide()) {
+        auto bloc = blocs.défile();
+
+        // dbg() << "dépile bloc " << bloc;
+
+        if (bloc->tous_les_parents_furent_remplis()) {
+            convertisseuse_fsau.scelle_bloc(bloc);
+            if (bloc->possède_drapeau(DrapeauxBlocBasique::EST_REMPLIS)) {
+                continue;
+            }
+        }
+
+        if (!bloc->possède_drapeau(DrapeauxBlocBasique::EST_REMPLIS)) {
+            dbg() << "Remplis bloc " << bloc->label->id;
+
+            POUR_NOMME (inst, bloc->instructions) {
+                if (!instruction_est_racine(inst) && !inst->est_alloc()) {
+                    continue;
+                }
+                (void)convertisseuse_fsau.génère_valeur_pour_instruction(
+                    bloc, inst, UtilisationAtome::RACINE);
+            }
+            bloc->drapeaux |= DrapeauxBlocBasique::EST_REMPLIS;
+        }
+
+        if (!bloc->tous_les_parents_furent_remplis()) {
+            blocs.enfile(bloc);
+            // dbg() << "empile bloc " << bloc << " car tous les parents ne furent pas remplis";
+            POUR (bloc->parents) {
+                if (it->possède_drapeau(DrapeauxBlocBasique::EST_REMPLIS)) {
+                    continue;
+                }
+
+                // dbg() << "-- parent non remplis " << it;
+            }
+        }
+
+        POUR (bloc->enfants) {
+            blocs.enfile(it);
+            // dbg() << "empile bloc " << it;
+        }
+    }
+
+    if (stats) {
+        stats->stats.fusionne_entrée(PASSES_FSAU__CONSTRUCTION,
+                                     {"", début_construction.temps()});
+    }
+
+    TableDesRelations &table_des_relations = convertisseuse_fsau.donne_table_des_relations();
+
+    imprime_blocs(fonction_et_blocs);
+
+    auto visiteuse = VisiteuseBlocs(fonction_et_blocs);
+
+    while (true) {
+        auto chose_faite = false;
+
+        chose_faite |= chronomètre(PASSES_FSAU__BRANCHES_INUTILES, [&]() {
+            return supprime_branches_inutiles(fonction_et_blocs, visiteuse, table_des_relations);
+        });
+
+        if (drapeau_est_actif(passes, PassesFSAU::PROPAGATION_CONSTANTES)) {
+            chose_faite |= chronomètre(PASSES_FSAU__PROPAGATION_CONSTANTES, [&]() {
+                return propage_constantes_creuses(fonction_et_blocs, convertisseuse_fsau);
+            });
+        }
+
+        chose_faite |= chronomètre(PASSES_FSAU__SIMPLIFICATIONS, [&]() {
+            auto résultat = détecte_expressions_communes(fonction_et_blocs, table_des_relations);
+            résultat |= propage_temporaires(fonction_et_blocs, table_des_relations);
+            résultat |= simplifie_accès_indice(fonction_et_blocs, table_des_relations);
+            return résultat;
+        });
+
+        if (drapeau_est_actif(passes, PassesFSAU::RÈGLES_RÉÉCRITURE)) {
+            chose_faite |= chronomètre(PASSES_FSAU__RÈGLES_RÉÉCRITURE, [&]() {
+                return applique_règles_réécriture(fonction_et_blocs, convertisseuse_fsau);
+            });
+        }
+
+        if (drapeau_est_actif(passes, PassesFSAU::NUMÉROTATION_VALEURS)) {
+            chose_faite |= chronomètre(PASSES_FSAU__NUMÉROTATION_VALEURS, [&]() {
+                return numérote_valeurs_globalement(fonction_et_blocs, table_des_relations);
+            });
+        }
+
+        if (drapeau_est_actif(passes, PassesFSAU::INVARIANTS_BOUCLES)) {
+            chose_faite |= chronomètre(PASSES_FSAU__INVARIANTS_BOUCLES, [&]() {
+                return déplace_invariants_boucles(fonction_et_blocs, table_des_relations);
+            });
+        }
+
+        if (drapeau_est_actif(passes, PassesFSAU::STOCKAGES_MORTS)) {
+            chose_faite |= chronomètre(PASSES_FSAU__STOCKAGES_MORTS, [&]() {
+                return supprime_stockages_morts(fonction_et_blocs);
+            });
+        }
+
+        // Redondant avec supprime_code_inutile, ne prends pas en compte les accès_indice
+        // supprime_valeurs_inutilisées(fonction_et_blocs, table_des_relations);
+        chose_faite |= chronomètre(PASSES_FSAU__CODE_INUTILE, [&]() {
+            return supprime_code_inutile(fonction_et_blocs, table_des_relations);
+        });
+
+        if (!chose_faite) {
+            break;
+        }
+    }
+
+    numérote_valeurs(fonction_et_blocs);
+    imprime_blocs(fonction_et_blocs);
+
+    //    POUR_NOMME (bloc, fonction_et_blocs.blocs) {
+    //        POUR_NOMME (valeur, bloc->valeurs) {
+    //            visite_opérande(valeur, [&](Valeur *opérande) {
+    //                table_des_relations.ajoute_utilisateur(opérande, valeur);
+    //            });
+    //        }
+    //    }
+
+    POUR_NOMME (bloc, fonction_et_blocs.blocs) {
+        POUR_NOMME (valeur, bloc->valeurs) {
+            if (valeur->est_controle_de_flux() ||
+                valeur->possède_drapeau(DrapeauxValeur::NE_PRODUIS_PAS_DE_VALEUR)) {
+                continue;
+            }
+
+            auto utilisateurs = table_des_relations.donne_utilisateurs(valeur);
+
+            dbg() << "v" << valeur->numéro << ", utilisateurs : ";
+            POUR (utilisateurs) {
+                if (it->est_controle_de_flux() ||
+                    it->possède_drapeau(DrapeauxValeur::NE_PRODUIS_PAS_DE_VALEUR)) {
+                    dbg() << "-- " << it->genre;
+                }
+                else {
+                    dbg() << "-- v" << it->numéro;
+                }
+            }
+        }
+    }
+
+    chronomètre(PASSES_FSAU__RIÈREVERSION, [&]() {
+        rièrevertis_en_ri(fonction_et_blocs, table_des_relations, constructrice);
+        return true;
+    });
+}
+
+/* ------------------------------------------------------------------------- */
+/** \name Implémentation de la table des relations.
+ * \{ */
+
+void TableDesRelations::remplace_ou_ajoute_utilisateur(Valeur *utilisée,
+                                                       Valeur *ancien,
+                                                       Valeur *par)
+{
+    /* Si l'utilisateur utilise la valeur plusieurs fois (p.e. x - x), toutes ses utilisations
+     * furent supprimées lors du remplacement de la première. */
+    if (ancien && est_utilisée(ancien)) {
+        supprime_utilisateur(ancien, par);
+    }
+
+    ajoute_utilisateur(utilisée, par);
+}
+
+void TableDesRelations::ajoute_utilisateur(Valeur *utilisée, Valeur *par)
+{
+    auto indice_données_utilisée = donne_indice_pour_valeur(utilisée);
+
+    auto &indice = m_indice[int32_t(indice_données_utilisée)];
+
+    auto info = UtilisateurValeur{par, indice_utilisateur_invalide, indice_utilisateur_invalide};
+
+    if (indice.premier_utilisateur == indice_utilisateur_invalide) {
+        /* Insère un nouvelle utilisateur. */
+        indice.premier_utilisateur = indice_table_utilisateur(m_utilisateurs.taille());
+    }
+    else {
+        /* Trouve le dernier utilisateur. */
+        auto utilisateur = &m_utilisateurs[int32_t(indice.premier_utilisateur)];
+        info.précédent = indice.premier_utilisateur;
+        while (utilisateur->suivant != indice_utilisateur_invalide) {
+            info.précédent = utilisateur->suivant;
+            utilisateur = &m_utilisateurs[int32_t(utilisateur->suivant)];
+        }
+
+        utilisateur->suivant = indice_table_utilisateur(m_utilisateurs.taille());
+    }
+
+    // dbg() << __func__ << " : "
+    //       << "précédent " << info.précédent << " suivant " << info.suivant;
+
+    m_utilisateurs.ajoute(info);
+}
+
+bool TableDesRelations::est_utilisée(const Valeur *valeur) const
+{
+    auto const indice_données_utilisation = valeur->indice_relations;
+    if (indice_données_utilisation == indice_relation_invalide) {
+        return false;
+    }
+    return m_indice[int32_t(indice_données_utilisation)].premier_utilisateur !=
+           indice_utilisateur_invalide;
+}
+
+void TableDesRelations::supprime(const Valeur *valeur)
+{
+    /* Supprime la valeur de la liste des utilisateurs des valeurs qu'elle utilise. */
+    for (int i = 0; i < m_indice.taille(); i++) {
+        if (m_indice[i].premier_utilisateur == indice_utilisateur_invalide) {
+            continue;
+        }
+
+        supprime_utilisateur(indice_table_relation(i), valeur);
+    }
+}
+
+kuri::tablet<Valeur *, 6> TableDesRelations::donne_utilisateurs(const Valeur *valeur) const
+{
+    kuri::tablet<Valeur *, 6> résultat;
+
+    auto const indice_données_utilisation = valeur->indice_relations;
+    // assert(indice_données_utilisation != -1);
+    if (indice_données_utilisation == indice_relation_invalide) {
+        return résultat;
+    }
+
+    auto &indice = m_indice[int32_t(indice_données_utilisation)];
+
+    auto indice_utilisateur = indice.premier_utilisateur;
+    while (indice_utilisateur != indice_utilisateur_invalide) {
+        auto utilisateur = m_utilisateurs[int32_t(indice_utilisateur)].utilisateur;
+        résultat.ajoute(utilisateur);
+        indice_utilisateur = m_utilisateurs[int32_t(indice_utilisateur)].suivant;
+    }
+
+    return résultat;
+}
+
+void TableDesRelations::supprime_utilisateur(Valeur *utilisée, Valeur const *par)
+{
+    auto indice_données_utilisée = utilisée->indice_relations;
+    assert(indice_données_utilisée != indice_relation_invalide);
     supprime_utilisateur(indice_données_utilisée, par);
 }
 
@@ -2480,10 +3787,72 @@ indice_table_relation TableDesRelations::donne_indice_pour_valeur(Valeur *valeur
 namespace FSAU {
 
 class Rièrevertisseuse {
+    /* Les opérateurs utilisés plusieurs fois, ou depuis d'autres blocs, sont générés une seule
+     * fois à leur définition, puis réutilisés par leurs utilisateurs. */
+    kuri::ensemble<Valeur const *> m_à_matérialiser{};
+    kuri::table_hachage<Valeur const *, Atome *> m_atomes_matérialisés{"Atomes matérialisés"};
+
   public:
+    void détermine_valeurs_à_matérialiser(FonctionEtBlocs &fonction_et_blocs,
+                                          TableDesRelations &table);
+
     Atome *rièrevertis_en_ri(Valeur *valeur, ConstructriceRI &constructrice, bool pour_opérande);
 };
 
+void Rièrevertisseuse::détermine_valeurs_à_matérialiser(FonctionEtBlocs &fonction_et_blocs,
+                                                        TableDesRelations &table)
+{
+    assigne_indices_blocs(fonction_et_blocs);
+    auto const dominance = InformationsDominance(fonction_et_blocs);
+
+    kuri::table_hachage<Valeur const *, int> positions{"Positions valeurs"};
+    POUR_NOMME (bloc, fonction_et_blocs.blocs) {
+        POUR_INDICE (bloc->valeurs) {
+            positions.insère(it, indice_it);
+        }
+    }
+
+    POUR_NOMME (bloc, fonction_et_blocs.blocs) {
+        POUR_NOMME (valeur, bloc->valeurs) {
+            if (!valeur->est_opérateur_binaire()) {
+                continue;
+            }
+
+            auto const position = positions.valeur_ou(valeur, -1);
+            auto nombre_utilisateurs = 0;
+            auto utilisée_ailleurs = false;
+            auto domine_utilisateurs = true;
+
+            POUR (table.donne_utilisateurs(valeur)) {
+                auto const position_utilisateur = positions.valeur_ou(it, -1);
+                if (position_utilisateur == -1) {
+                    /* L'utilisateur fut supprimé. */
+                    continue;
+                }
+
+                nombre_utilisateurs += 1;
+
+                /* Les phis utilisent leurs opérandes à la fin des blocs parents. */
+                if (it->est_phi()) {
+                    domine_utilisateurs = false;
+                }
+                else if (it->indice_bloc != valeur->indice_bloc) {
+                    utilisée_ailleurs = true;
+                    domine_utilisateurs &= dominance.domine(valeur->indice_bloc,
+                                                            it->indice_bloc);
+                }
+                else {
+                    domine_utilisateurs &= position_utilisateur > position;
+                }
+            }
+
+            if ((nombre_utilisateurs >= 2 || utilisée_ailleurs) && domine_utilisateurs) {
+                m_à_matérialiser.insère(valeur);
+            }
+        }
+    }
+}
+
 Atome *Rièrevertisseuse::rièrevertis_en_ri(Valeur *valeur,
                                            ConstructriceRI &constructrice,
                                            bool pour_opérande)
@@ -2602,7 +3971,13 @@ Atome *Rièrevertisseuse::rièrevertis_en_ri(Valeur *valeur,
         }
         case GenreValeur::OPÉRATEUR_BINAIRE:
         {
-            if (!pour_opérande) {
+            auto atome_matérialisé = m_atomes_matérialisés.valeur_ou(valeur, nullptr);
+            if (atome_matérialisé) {
+                return pour_opérande ? atome_matérialisé : nullptr;
+            }
+
+            auto const doit_matérialiser = !pour_opérande && m_à_matérialiser.possède(valeur);
+            if (!pour_opérande && !doit_matérialiser) {
                 return nullptr;
             }
 
@@ -2618,11 +3993,15 @@ Atome *Rièrevertisseuse::rièrevertis_en_ri(Valeur *valeur,
                 dbg() << "Genre opérande droite : " << op_binaire->donne_droite()->genre;
             });
 
-            return constructrice.crée_op_binaire(nullptr,
-                                                 op_binaire->inst->type,
-                                                 op_binaire->inst->op,
-                                                 opérande_gauche,
-                                                 opérande_droite);
+            auto résultat = constructrice.crée_op_binaire(nullptr,
+                                                          op_binaire->inst->type,
+                                                          op_binaire->inst->op,
+                                                          opérande_gauche,
+                                                          opérande_droite);
+            if (doit_matérialiser) {
+                m_atomes_matérialisés.insère(valeur, résultat);
+            }
+            return résultat;
         }
         case GenreValeur::OPÉRATEUR_UNAIRE:
         {
@@ -2650,7 +4029,9 @@ Atome *Rièrevertisseuse::rièrevertis_en_ri(Valeur *valeur,
     return nullptr;
 }
 
-static void rièrevertis_en_ri(FonctionEtBlocs &fonction_et_blocs, ConstructriceRI &constructrice)
+static void rièrevertis_en_ri(FonctionEtBlocs &fonction_et_blocs,
+                              TableDesRelations &table,
+                              ConstructriceRI &constructrice)
 {
     dbg() << "--------------------------";
     auto fonction = fonction_et_blocs.fonction;
@@ -2659,6 +4040,7 @@ static void rièrevertis_en_ri(FonctionEtBlocs &fonction_et_blocs, Constructrice
     constructrice.définis_fonction_courante(fonction);
 
     Rièrevertisseuse rièrevertisseuse;
+    rièrevertisseuse.détermine_valeurs_à_matérialiser(fonction_et_blocs, table);
 
     POUR_NOMME (bloc, fonction_et_blocs.blocs) {
         constructrice.insère_label(bloc->label);
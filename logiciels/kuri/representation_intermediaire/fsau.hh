@@ -3,10 +3,43 @@
 
 #pragma once
 
+#include <optional>
+
+#include "structures/chaine_statique.hh"
+
+#include "utilitaires/macros.hh"
+
 struct AtomeFonction;
 struct ConstructriceRI;
 struct EspaceDeTravail;
+struct StatistiquesFSAU;
+
+/* Passes d'optimisation optionnelles exécutées sur la FSAU, en plus des simplifications faites
+ * lors de la construction. */
+enum class PassesFSAU : uint32_t {
+    AUCUNE = 0,
+    /* Propagation creuse de constantes conditionnelle (SCCP). */
+    PROPAGATION_CONSTANTES = (1u << 0),
+    /* Numérotation globale des valeurs (GVN). */
+    NUMÉROTATION_VALEURS = (1u << 1),
+    /* Suppression des stockages surécrits avant d'être lus. */
+    STOCKAGES_MORTS = (1u << 2),
+    /* Déplacement des calculs invariants hors des boucles (LICM). */
+    INVARIANTS_BOUCLES = (1u << 3),
+    /* Règles de réécriture de optimisations.txt. */
+    RÈGLES_RÉÉCRITURE = (1u << 4),
+
+    TOUTES = (PROPAGATION_CONSTANTES | NUMÉROTATION_VALEURS | STOCKAGES_MORTS |
+              INVARIANTS_BOUCLES | RÈGLES_RÉÉCRITURE),
+};
+DEFINIS_OPERATEURS_DRAPEAU(PassesFSAU)
+
+/* Retourne les passes pour une liste de noms séparés par des virgules, par exemple
+ * "propagation_constantes,invariants_boucles", ou rien si un nom est inconnu. */
+std::optional<PassesFSAU> donne_passes_fsau_pour_chaine(kuri::chaine_statique chaine);
 
 void convertis_fsau(EspaceDeTravail &espace,
                     AtomeFonction *fonction,
-                    ConstructriceRI &constructrice);
+                    ConstructriceRI &constructrice,
+                    PassesFSAU passes = PassesFSAU::TOUTES,
+                    StatistiquesFSAU *stats = nullptr);
@@ -3,6 +3,7 @@
 
 #include "instructions.hh"
 
+#include <atomic>
 #include <ostream>
 
 #include "arbre_syntaxique/noeud_expression.hh"
@@ -67,10 +68,115 @@ PartageMémoire AtomeGlobale::donne_partage_mémoire() const
     return decl->partage_mémoire;
 }
 
+/* ------------------------------------------------------------------------- */
+/** \name ArèneInstructions
+ * \{ */
+
+/* Les blocs doublent de taille jusqu'à cette limite, afin que les petites fonctions ne réservent
+ * pas trop de mémoire, et que les grandes n'aient pas trop de blocs. */
+static constexpr int64_t TAILLE_PREMIER_BLOC_ARÈNE = 1024;
+static constexpr int64_t TAILLE_MAXIMALE_BLOC_ARÈNE = 64 * 1024;
+
+ArèneInstructions::~ArèneInstructions()
+{
+    POUR (m_à_détruire) {
+        switch (it->genre) {
+#define ENUMERE_GENRE_INSTRUCTION_EX(genre_, nom_classe, ident)                                   \
+    case GenreInstruction::genre_:                                                                \
+    {                                                                                             \
+        static_cast<nom_classe *>(it)->~nom_classe();                                             \
+        break;                                                                                    \
+    }
+            ENUMERE_GENRE_INSTRUCTION(ENUMERE_GENRE_INSTRUCTION_EX)
+#undef ENUMERE_GENRE_INSTRUCTION_EX
+        }
+    }
+
+    POUR (m_blocs) {
+        mémoire::déloge_tableau("ArèneInstructions", it.données, it.taille);
+    }
+}
+
+int64_t ArèneInstructions::mémoire_utilisée() const
+{
+    auto résultat = m_blocs.taille_mémoire() + m_à_détruire.taille_mémoire();
+    POUR (m_blocs) {
+        résultat += it.taille;
+    }
+    return résultat;
+}
+
+int64_t ArèneInstructions::gaspillage_mémoire() const
+{
+    auto résultat = m_blocs.gaspillage_mémoire() + m_à_détruire.gaspillage_mémoire();
+    POUR (m_blocs) {
+        résultat += it.taille - it.occupé;
+    }
+    return résultat;
+}
+
+void *ArèneInstructions::alloue(int64_t taille, int64_t alignement)
+{
+    if (m_blocs.taille() != 0) {
+        auto &bloc = m_blocs.dernier_élément();
+        auto décalage = (bloc.occupé + alignement - 1) & ~(alignement - 1);
+        if (décalage + taille <= bloc.taille) {
+            bloc.occupé = décalage + taille;
+            return bloc.données + décalage;
+        }
+    }
+
+    auto taille_bloc = TAILLE_PREMIER_BLOC_ARÈNE;
+    if (m_blocs.taille() != 0) {
+        taille_bloc = std::min(m_blocs.dernier_élément().taille * 2, TAILLE_MAXIMALE_BLOC_ARÈNE);
+    }
+    taille_bloc = std::max(taille_bloc, taille);
+
+    auto bloc = Bloc{};
+    bloc.données = mémoire::loge_tableau<char>("ArèneInstructions", taille_bloc);
+    bloc.taille = taille_bloc;
+    bloc.occupé = taille;
+    m_blocs.ajoute(bloc);
+    return bloc.données;
+}
+
+/** \} */
+
 AtomeFonction::~AtomeFonction()
 {
     /* À FAIRE : stocke ça quelque part dans un tableau_page. */
     mémoire::déloge("DonnéesExécutionFonction", données_exécution);
+    mémoire::déloge("ArèneInstructions", arène);
+}
+
+ArèneInstructions &AtomeFonction::donne_arène()
+{
+    assert(!ri_libérée);
+    if (!arène) {
+        arène = mémoire::loge<ArèneInstructions>("ArèneInstructions");
+    }
+    return *arène;
+}
+
+static std::atomic<uint64_t> nombre_libérations_ri = 0;
+
+uint64_t donne_nombre_libérations_ri()
+{
+    return nombre_libérations_ri.load(std::memory_order_acquire);
+}
+
+int64_t AtomeFonction::libère_ri()
+{
+    auto résultat = instructions.taille_mémoire();
+    if (arène) {
+        résultat += arène->mémoire_utilisée();
+        mémoire::déloge("ArèneInstructions", arène);
+    }
+
+    instructions = kuri::tableau<Instruction *, int>();
+    ri_libérée = true;
+    nombre_libérations_ri.fetch_add(1, std::memory_order_release);
+    return résultat;
 }
 
 Instruction *AtomeFonction::dernière_instruction() const
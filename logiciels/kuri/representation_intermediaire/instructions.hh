@@ -4,6 +4,7 @@
 #pragma once
 
 #include <functional>
+#include <type_traits>
 #include <utility>
 
 #include "compilation/operateurs.hh"
@@ -394,6 +395,63 @@ struct AccèsIndiceConstant : public AtomeConstante {
     Type const *donne_type_accédé() const;
 };
 
+/* ------------------------------------------------------------------------- */
+/** \name ArèneInstructions
+ * Mémoire des instructions d'une fonction. Les instructions sont placées les unes à la suite des
+ * autres dans des blocs de tailles croissantes, et sont toutes libérées ensemble lorsque la RI de
+ * la fonction n'est plus requise. Les constantes et les globales, qui peuvent être référencées
+ * par plusieurs fonctions, sont stockées dans la ConstructriceRI.
+ * \{ */
+
+struct ArèneInstructions {
+  private:
+    struct Bloc {
+        char *données = nullptr;
+        int64_t taille = 0;
+        int64_t occupé = 0;
+    };
+
+    kuri::tableau<Bloc, int> m_blocs{};
+    /* Les instructions dont le destructeur doit être appelé lors de la libération. */
+    kuri::tableau<Instruction *, int> m_à_détruire{};
+    int64_t m_nombre_instructions = 0;
+
+  public:
+    ArèneInstructions() = default;
+
+    EMPECHE_COPIE(ArèneInstructions);
+
+    ~ArèneInstructions();
+
+    template <typename T, typename... Args>
+    T *ajoute_instruction(Args &&...args)
+    {
+        auto résultat = new (alloue(int64_t(sizeof(T)), int64_t(alignof(T))))
+            T(std::forward<Args>(args)...);
+
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            m_à_détruire.ajoute(résultat);
+        }
+
+        m_nombre_instructions += 1;
+        return résultat;
+    }
+
+    int64_t nombre_instructions() const
+    {
+        return m_nombre_instructions;
+    }
+
+    int64_t mémoire_utilisée() const;
+
+    int64_t gaspillage_mémoire() const;
+
+  private:
+    void *alloue(int64_t taille, int64_t alignement);
+};
+
+/** \} */
+
 struct AtomeFonction : public AtomeConstante {
     kuri::chaine_statique nom{};
 
@@ -416,6 +474,12 @@ struct AtomeFonction : public AtomeConstante {
 
     AtomeGlobale *info_trace_appel = nullptr;
 
+    /* Mémoire des instructions, créée lors de la génération de la RI de la fonction. */
+    ArèneInstructions *arène = nullptr;
+    /* Vrai si la RI fut libérée après la génération du code final de l'espace : les instructions
+     * ne sont plus disponibles, seuls l'atome, les paramètres, et le code binaire demeurent. */
+    bool ri_libérée = false;
+
     AtomeFonction(NoeudDéclarationEntêteFonction const *decl_, kuri::chaine_statique nom_)
         : nom(nom_), decl(decl_)
     {
@@ -443,9 +507,19 @@ struct AtomeFonction : public AtomeConstante {
     bool est_intrinsèque() const;
     bool est_intrinsèque(GenreIntrinsèque genre_intrinsèque) const;
 
+    ArèneInstructions &donne_arène();
+
+    /* Libère les instructions de la fonction. Retourne la quantité de mémoire libérée. */
+    int64_t libère_ri();
+
     EMPECHE_COPIE(AtomeFonction);
 };
 
+/* Retourne le nombre de fois où la RI d'une fonction fut libérée. Les adresses des instructions
+ * libérées peuvent être réutilisées : les caches indexés par instruction doivent être vidés
+ * lorsque ce nombre change. */
+uint64_t donne_nombre_libérations_ri();
+
 #define DECLARE_FONCTIONS_DISCRIMINATION_INSTRUCTION(genre_, nom_classe, ident)                   \
     inline bool est_##ident() const                                                               \
     {                                                                                             \
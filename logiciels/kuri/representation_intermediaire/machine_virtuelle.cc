@@ -526,6 +526,155 @@ static inline void *donne_adresse_locale(FrameAppel *frame, int indice)
     return &frame->pointeur_pile[locale.adresse];
 }
 
+/* ------------------------------------------------------------------------- */
+/** \name Opérations à registres.
+ *
+ * Les opérandes sont soit dans les locales de la frame, soit immédiatement dans le code. Le type
+ * de calcul est choisi selon le type des opérandes, ainsi le signe des opérations est déjà résolu
+ * par la compilatrice de code binaire.
+ * \{ */
+
+/* Retourne l'adresse de l'opérande, ou nul s'il est sur la pile : il sera alors dépilé par
+ * MachineVirtuelle::dépile_opérandes_registres. */
+static inline octet_t *donne_adresse_opérande_registre(FrameAppel *frame,
+                                                       OpérandeRegistre::Genre genre)
+{
+    if (genre == OpérandeRegistre::Genre::PILE) {
+        return nullptr;
+    }
+
+    auto résultat = frame->pointeur;
+    if (genre == OpérandeRegistre::Genre::LOCALE) {
+        résultat = &frame->pointeur_pile[*reinterpret_cast<int64_t *>(frame->pointeur)];
+    }
+    frame->pointeur += 8;
+    return résultat;
+}
+
+template <typename Op, typename T>
+static inline int64_t applique_opération_registres(octet_t *résultat,
+                                                    octet_t const *gauche,
+                                                    octet_t const *droite)
+{
+    T a, b;
+    memcpy(&a, gauche, sizeof(T));
+    memcpy(&b, droite, sizeof(T));
+    auto r = Op::template applique_opération<T>(a, b);
+    memcpy(résultat, &r, sizeof(r));
+    return static_cast<int64_t>(sizeof(r));
+}
+
+template <typename T>
+static int64_t applique_opération_entière(octet_t op,
+                                          octet_t *résultat,
+                                          octet_t const *gauche,
+                                          octet_t const *droite)
+{
+#define CAS_OPERATION(code, opération)                                                            \
+    case code:                                                                                    \
+        return applique_opération_registres<opération, T>(résultat, gauche, droite);
+
+    switch (op) {
+        CAS_OPERATION(OP_AJOUTE, Addition)
+        CAS_OPERATION(OP_SOUSTRAIT, Soustraction)
+        CAS_OPERATION(OP_MULTIPLIE, Multiplication)
+        CAS_OPERATION(OP_DIVISE, Division)
+        CAS_OPERATION(OP_DIVISE_RELATIF, Division)
+        CAS_OPERATION(OP_RESTE_NATUREL, Modulo)
+        CAS_OPERATION(OP_RESTE_RELATIF, Modulo)
+        CAS_OPERATION(OP_COMP_ÉGAL, Égal)
+        CAS_OPERATION(OP_COMP_INÉGAL, Différent)
+        CAS_OPERATION(OP_COMP_INF, Inférieur)
+        CAS_OPERATION(OP_COMP_INF_ÉGAL, InférieurÉgal)
+        CAS_OPERATION(OP_COMP_SUP, Supérieur)
+        CAS_OPERATION(OP_COMP_SUP_ÉGAL, SupérieurÉgal)
+        CAS_OPERATION(OP_COMP_INF_NATUREL, Inférieur)
+        CAS_OPERATION(OP_COMP_INF_ÉGAL_NATUREL, InférieurÉgal)
+        CAS_OPERATION(OP_COMP_SUP_NATUREL, Supérieur)
+        CAS_OPERATION(OP_COMP_SUP_ÉGAL_NATUREL, SupérieurÉgal)
+        CAS_OPERATION(OP_ET_BINAIRE, ConjonctionBinaire)
+        CAS_OPERATION(OP_OU_BINAIRE, DisjonctionBinaire)
+        CAS_OPERATION(OP_OU_EXCLUSIF, DisjonctionBinaireExclusive)
+        CAS_OPERATION(OP_DEC_GAUCHE, DécalageGauche)
+        CAS_OPERATION(OP_DEC_DROITE_ARITHM, DécalageDroite)
+        CAS_OPERATION(OP_DEC_DROITE_LOGIQUE, DécalageDroite)
+    }
+
+#undef CAS_OPERATION
+    return 0;
+}
+
+template <typename T>
+static int64_t applique_opération_réelle(octet_t op,
+                                         octet_t *résultat,
+                                         octet_t const *gauche,
+                                         octet_t const *droite)
+{
+#define CAS_OPERATION(code, opération)                                                            \
+    case code:                                                                                    \
+        return applique_opération_registres<opération, T>(résultat, gauche, droite);
+
+    switch (op) {
+        CAS_OPERATION(OP_AJOUTE_RÉEL, Addition)
+        CAS_OPERATION(OP_SOUSTRAIT_RÉEL, Soustraction)
+        CAS_OPERATION(OP_MULTIPLIE_RÉEL, Multiplication)
+        CAS_OPERATION(OP_DIVISE_RÉEL, Division)
+        CAS_OPERATION(OP_COMP_ÉGAL_RÉEL, Égal)
+        CAS_OPERATION(OP_COMP_INÉGAL_RÉEL, Différent)
+        CAS_OPERATION(OP_COMP_INF_RÉEL, Inférieur)
+        CAS_OPERATION(OP_COMP_INF_ÉGAL_RÉEL, InférieurÉgal)
+        CAS_OPERATION(OP_COMP_SUP_RÉEL, Supérieur)
+        CAS_OPERATION(OP_COMP_SUP_ÉGAL_RÉEL, SupérieurÉgal)
+    }
+
+#undef CAS_OPERATION
+    return 0;
+}
+
+/* Écris le résultat de l'opération dans résultat, et retourne sa taille en octet. Le résultat
+ * peut recouvrir les opérandes. */
+static int64_t exécute_opération_registres(octet_t op,
+                                           octet_t type,
+                                           octet_t *résultat,
+                                           octet_t const *gauche,
+                                           octet_t const *droite)
+{
+    auto const bits = type & (BITS_8 | BITS_16 | BITS_32 | BITS_64);
+
+    if ((type & CONSTANTE_NOMBRE_RÉEL) != 0) {
+        if (bits == BITS_32) {
+            return applique_opération_réelle<float>(op, résultat, gauche, droite);
+        }
+        return applique_opération_réelle<double>(op, résultat, gauche, droite);
+    }
+
+    if ((type & CONSTANTE_ENTIER_RELATIF) != 0) {
+        switch (bits) {
+            case BITS_8:
+                return applique_opération_entière<char>(op, résultat, gauche, droite);
+            case BITS_16:
+                return applique_opération_entière<short>(op, résultat, gauche, droite);
+            case BITS_32:
+                return applique_opération_entière<int>(op, résultat, gauche, droite);
+            default:
+                return applique_opération_entière<int64_t>(op, résultat, gauche, droite);
+        }
+    }
+
+    switch (bits) {
+        case BITS_8:
+            return applique_opération_entière<unsigned char>(op, résultat, gauche, droite);
+        case BITS_16:
+            return applique_opération_entière<unsigned short>(op, résultat, gauche, droite);
+        case BITS_32:
+            return applique_opération_entière<uint32_t>(op, résultat, gauche, droite);
+        default:
+            return applique_opération_entière<uint64_t>(op, résultat, gauche, droite);
+    }
+}
+
+/** \} */
+
 struct LimitesCodeFrame {
     octet_t const *adresse_début = nullptr;
     octet_t const *adresse_fin = nullptr;
@@ -575,20 +724,14 @@ inline T dépile(octet_t *&pointeur_pile)
     return *reinterpret_cast<T *>(pointeur_pile);
 }
 
-void MachineVirtuelle::incrémente_pointeur_de_pile(int64_t taille)
+void MachineVirtuelle::rapporte_sur_entamponnage_pile()
 {
-    this->pointeur_pile += taille;
-    if (pointeur_pile >= (pile + TAILLE_PILE)) {
-        rapporte_erreur_exécution("sur-entamponnage de la pile de données");
-    }
+    rapporte_erreur_exécution("sur-entamponnage de la pile de données");
 }
 
-void MachineVirtuelle::décrémente_pointeur_de_pile(int64_t taille)
+void MachineVirtuelle::rapporte_sous_entamponnage_pile()
 {
-    pointeur_pile -= taille;
-    if (pointeur_pile < pile) {
-        rapporte_erreur_exécution("sous-entamponnage de la pile de données");
-    }
+    rapporte_erreur_exécution("sous-entamponnage de la pile de données");
 }
 
 bool MachineVirtuelle::appel(AtomeFonction *fonction, NoeudExpression const *site)
@@ -635,6 +778,19 @@ bool MachineVirtuelle::appel_fonction_interne(AtomeFonction *ptr_fonction,
         }
     }
 
+    if (compilatrice.arguments.jit_métaprogrammes) {
+        auto données = ptr_fonction->données_exécution;
+        if (!données->données_jit.ptr_fonction && !données->compilation_jit_échouée &&
+            ++données->nombre_appels == CompilatriceJIT::SEUIL_APPELS) {
+            m_jit.compile(m_métaprogramme->unité->espace->typeuse, ptr_fonction);
+        }
+
+        if (données->données_jit.ptr_fonction) {
+            appel_fonction_jit(ptr_fonction, taille_argument);
+            return true;
+        }
+    }
+
     // puisque les arguments utilisent des instructions d'allocations retire la taille des
     // arguments du pointeur de la pile pour ne pas que les allocations ne l'augmente
     décrémente_pointeur_de_pile(taille_argument);
@@ -1086,58 +1242,237 @@ void MachineVirtuelle::appel_fonction_externe(AtomeFonction *ptr_fonction,
     auto pointeurs_arguments = kuri::tablet<void *, 12>();
     auto décalage_argument = 0u;
 
-    if (ptr_fonction->decl->possède_drapeau(DrapeauxNoeudFonction::EST_VARIADIQUE)) {
-        auto nombre_arguments_fixes = static_cast<unsigned>(type_fonction->types_entrées.taille() -
-                                                            1);
-        auto nombre_arguments_totaux = static_cast<unsigned>(inst_appel->args.taille());
+    auto données_appel = &données_externe;
 
-        données_externe.types_entrées.efface();
-        données_externe.types_entrées.réserve(nombre_arguments_totaux);
+    if (ptr_fonction->decl->possède_drapeau(DrapeauxNoeudFonction::EST_VARIADIQUE)) {
+        données_appel = donne_interface_appel_variadique(ptr_fonction, inst_appel);
+        if (!données_appel) {
+            rapporte_erreur_exécution("Erreur interne : impossible de préparer les arguments FFI "
+                                      "pour la fonction variadique externe.");
+            résultat_interp = RésultatInterprétation::ERREUR;
+            return;
+        }
 
         POUR (inst_appel->args) {
-            auto type_primitif = donne_type_primitif(it->type);
-            auto type_ffi = convertis_type_ffi(type_primitif);
-            données_externe.types_entrées.ajoute(type_ffi);
-
             auto ptr = &pointeur_arguments[décalage_argument];
             pointeurs_arguments.ajoute(ptr);
+            décalage_argument += donne_type_primitif(it->type)->taille_octet;
+        }
+    }
+    else {
+        POUR (type_fonction->types_entrées) {
+            auto ptr = &pointeur_arguments[décalage_argument];
+            pointeurs_arguments.ajoute(ptr);
+            décalage_argument += it->taille_octet;
+        }
+    }
+
+    appel_ffi(*données_appel,
+              pointeurs_arguments.données(),
+              taille_argument,
+              type_fonction->type_sortie->taille_octet);
+}
+
+DonnéesExécutionFonction::DonnéesFonctionExterne *MachineVirtuelle::
+    donne_interface_appel_variadique(AtomeFonction const *ptr_fonction,
+                                     InstructionAppel const *inst_appel)
+{
+    auto const &données_externe = ptr_fonction->données_exécution->données_externe;
 
-            décalage_argument += type_primitif->taille_octet;
+    auto const nombre_libérations_ri = donne_nombre_libérations_ri();
+    if (nombre_libérations_ri != m_nombre_libérations_ri_vues) {
+        m_interfaces_appel_variadiques.efface();
+        m_nombre_interfaces_appel_variadiques = 0;
+        m_nombre_libérations_ri_vues = nombre_libérations_ri;
+    }
+
+    /* Le site peut appeler différentes fonctions s'il s'agit d'un appel via un pointeur. */
+    auto résultat = m_interfaces_appel_variadiques.valeur_ou(inst_appel, nullptr);
+    if (résultat && résultat->ptr_fonction == données_externe.ptr_fonction) {
+        return résultat;
+    }
+
+    if (!résultat) {
+        if (m_nombre_interfaces_appel_variadiques <
+            m_stockage_interfaces_appel_variadiques.taille()) {
+            résultat = &m_stockage_interfaces_appel_variadiques.à_l_indice(
+                m_nombre_interfaces_appel_variadiques);
+        }
+        else {
+            résultat = m_stockage_interfaces_appel_variadiques.ajoute_élément();
         }
+        m_nombre_interfaces_appel_variadiques += 1;
+        m_interfaces_appel_variadiques.insère(inst_appel, résultat);
+    }
 
-        données_externe.types_entrées.ajoute(nullptr);
+    auto type_fonction = ptr_fonction->decl->type->comme_type_fonction();
+    auto nombre_arguments_fixes = static_cast<unsigned>(type_fonction->types_entrées.taille() -
+                                                        1);
+    auto nombre_arguments_totaux = static_cast<unsigned>(inst_appel->args.taille());
 
-        auto type_ffi_sortie = convertis_type_ffi(type_fonction->type_sortie);
-        auto ptr_types_entrées = données_externe.types_entrées.données();
+    résultat->ptr_fonction = nullptr;
+    résultat->types_entrées.efface();
+    résultat->types_entrées.réserve(nombre_arguments_totaux + 1);
 
-        auto status = ffi_prep_cif_var(&données_externe.cif,
-                                       FFI_DEFAULT_ABI,
-                                       nombre_arguments_fixes,
-                                       nombre_arguments_totaux,
-                                       type_ffi_sortie,
-                                       ptr_types_entrées);
+    POUR (inst_appel->args) {
+        auto type_primitif = donne_type_primitif(it->type);
+        résultat->types_entrées.ajoute(convertis_type_ffi(type_primitif));
+    }
 
-        if (status != FFI_OK) {
-            rapporte_erreur_exécution("Erreur interne : impossible de préparer les arguments FFI "
-                                      "pour la fonction variadique externe.");
-            résultat_interp = RésultatInterprétation::ERREUR;
-            return;
+    résultat->types_entrées.ajoute(nullptr);
+
+    auto type_ffi_sortie = convertis_type_ffi(type_fonction->type_sortie);
+    auto ptr_types_entrées = résultat->types_entrées.données();
+
+    auto status = ffi_prep_cif_var(&résultat->cif,
+                                   FFI_DEFAULT_ABI,
+                                   nombre_arguments_fixes,
+                                   nombre_arguments_totaux,
+                                   type_ffi_sortie,
+                                   ptr_types_entrées);
+
+    if (status != FFI_OK) {
+        return nullptr;
+    }
+
+    /* Les fonctions variadiques sont toujours appelées via libffi, qui renseigne le nombre de
+     * registres vectoriels utilisés. */
+    résultat->nombre_arguments_appel_direct = -1;
+    résultat->ptr_fonction = données_externe.ptr_fonction;
+    return résultat;
+}
+
+template <typename T>
+static uint64_t lis_argument_direct(void const *ptr)
+{
+    T valeur;
+    memcpy(&valeur, ptr, sizeof(T));
+    return static_cast<uint64_t>(valeur);
+}
+
+static uint64_t lis_argument_direct(void const *ptr, ArgumentAppelDirect argument)
+{
+    /* Étends les petits entiers selon leurs signes, comme le ferait un appelant C. */
+    switch (argument.taille) {
+        case 1:
+        {
+            return argument.est_signé ? lis_argument_direct<int8_t>(ptr) :
+                                        lis_argument_direct<uint8_t>(ptr);
+        }
+        case 2:
+        {
+            return argument.est_signé ? lis_argument_direct<int16_t>(ptr) :
+                                        lis_argument_direct<uint16_t>(ptr);
+        }
+        case 4:
+        {
+            return argument.est_signé ? lis_argument_direct<int32_t>(ptr) :
+                                        lis_argument_direct<uint32_t>(ptr);
+        }
+        default:
+        {
+            return lis_argument_direct<uint64_t>(ptr);
         }
     }
-    else {
-        POUR (type_fonction->types_entrées) {
-            auto ptr = &pointeur_arguments[décalage_argument];
-            pointeurs_arguments.ajoute(ptr);
-            décalage_argument += it->taille_octet;
+}
+
+/* Appel d'une fonction dont tous les arguments et la sortie sont des scalaires entiers ou des
+ * pointeurs : ceux-ci sont tous passés via des registres entiers, donc la fonction peut être
+ * appelée via un pointeur de fonction ne prenant que des uint64_t, sans passer par ffi_call. */
+static void appel_direct(DonnéesExécutionFonction::DonnéesFonctionExterne const &données,
+                         void **pointeurs_arguments,
+                         octet_t *sortie)
+{
+    using A = uint64_t;
+    uint64_t args[NOMBRE_MAX_ARGUMENTS_APPEL_DIRECT];
+
+    for (auto i = 0; i < données.nombre_arguments_appel_direct; i++) {
+        args[i] = lis_argument_direct(pointeurs_arguments[i], données.arguments_appel_direct[i]);
+    }
+
+    auto ptr = données.ptr_fonction;
+    auto résultat = uint64_t(0);
+
+    switch (données.nombre_arguments_appel_direct) {
+        case 0:
+        {
+            résultat = reinterpret_cast<A (*)()>(ptr)();
+            break;
+        }
+        case 1:
+        {
+            résultat = reinterpret_cast<A (*)(A)>(ptr)(args[0]);
+            break;
+        }
+        case 2:
+        {
+            résultat = reinterpret_cast<A (*)(A, A)>(ptr)(args[0], args[1]);
+            break;
+        }
+        case 3:
+        {
+            résultat = reinterpret_cast<A (*)(A, A, A)>(ptr)(args[0], args[1], args[2]);
+            break;
         }
+        case 4:
+        {
+            résultat = reinterpret_cast<A (*)(A, A, A, A)>(ptr)(
+                args[0], args[1], args[2], args[3]);
+            break;
+        }
+        case 5:
+        {
+            résultat = reinterpret_cast<A (*)(A, A, A, A, A)>(ptr)(
+                args[0], args[1], args[2], args[3], args[4]);
+            break;
+        }
+        case 6:
+        {
+            résultat = reinterpret_cast<A (*)(A, A, A, A, A, A)>(ptr)(
+                args[0], args[1], args[2], args[3], args[4], args[5]);
+            break;
+        }
+    }
+
+    /* Comme ffi_call, écris un registre complet ; seuls les octets du type de retour sont
+     * copiés par l'appelant. */
+    memcpy(sortie, &résultat, sizeof(résultat));
+}
+
+void MachineVirtuelle::appel_fonction_jit(AtomeFonction *ptr_fonction, int taille_argument)
+{
+    auto pointeur_arguments = pointeur_pile - taille_argument;
+
+    auto pointeurs_arguments = kuri::tablet<void *, 12>();
+    auto décalage_argument = 0u;
+
+    /* Les arguments sont empilés selon les paramètres de la représentation intermédiaire, à
+     * partir de laquelle le code natif fut généré. */
+    POUR (ptr_fonction->params_entrée) {
+        pointeurs_arguments.ajoute(&pointeur_arguments[décalage_argument]);
+        décalage_argument += it->donne_type_alloué()->taille_octet;
     }
 
-    ffi_call(&données_externe.cif,
-             données_externe.ptr_fonction,
-             pointeur_pile,
-             pointeurs_arguments.données());
+    auto type_fonction = ptr_fonction->type->comme_type_fonction();
+    appel_ffi(ptr_fonction->données_exécution->données_jit,
+              pointeurs_arguments.données(),
+              taille_argument,
+              type_fonction->type_sortie->taille_octet);
+}
+
+void MachineVirtuelle::appel_ffi(DonnéesExécutionFonction::DonnéesFonctionExterne &données,
+                                 void **pointeurs_arguments,
+                                 int taille_argument,
+                                 uint32_t taille_type_retour)
+{
+    auto pointeur_arguments = pointeur_pile - taille_argument;
 
-    auto taille_type_retour = type_fonction->type_sortie->taille_octet;
+    if (données.nombre_arguments_appel_direct >= 0) {
+        appel_direct(données, pointeurs_arguments, pointeur_pile);
+    }
+    else {
+        ffi_call(&données.cif, données.ptr_fonction, pointeur_pile, pointeurs_arguments);
+    }
 
     if (taille_type_retour != 0) {
         if (taille_type_retour <= static_cast<uint32_t>(taille_argument)) {
@@ -1269,9 +1604,63 @@ void MachineVirtuelle::désinstalle_métaprogramme(MétaProgramme *métaprogramm
 
 #define INSTRUCTIONS_PAR_LOT 1000
 
+/* Avec AVEC_DISPATCH_DIRECT_MV, chaque opération saute directement à la suivante via une table
+ * des adresses des étiquettes des cas (goto calculés, une extension de GCC et de Clang) au lieu de
+ * repasser par le switch. Chaque opération ayant son propre saut indirect, ceux-ci sont mieux
+ * prédits par le processeur. Les opérations de vérification, de statistiques, et de journalisation
+ * ne sont émises que si elles sont requises, elles n'ajoutent donc rien aux autres opérations.
+ * Un code d'opération hors de la table mène à l'erreur des opérations inconnues, comme le
+ * « default » du switch. */
+#if defined(AVEC_DISPATCH_DIRECT_MV) && (defined(__GNUC__) || defined(__clang__))
+#    define DISPATCH_DIRECT
+#endif
+
+#ifdef DISPATCH_DIRECT
+#    define CAS_OP(code)                                                                          \
+        case code:                                                                                \
+        étiquette_##code:
+
+#    define OPÉRATION_SUIVANTE()                                                                  \
+        if (IMPROBABLE(++i == INSTRUCTIONS_PAR_LOT)) {                                            \
+            goto fin_lot;                                                                         \
+        }                                                                                         \
+        pointeur_début = frame->pointeur;                                                         \
+        instruction = LIS_OCTET();                                                                \
+        if (IMPROBABLE(instruction >= NOMBRE_CODES_OPÉRATION)) {                                  \
+            goto étiquette_opération_inconnue;                                                    \
+        }                                                                                         \
+        goto *table_dispatch[instruction]
+#else
+#    define CAS_OP(code) case code:
+#    define OPÉRATION_SUIVANTE() break
+#endif
+
+#define CHARGE_LOCALE()                                                                           \
+    {                                                                                             \
+        auto indice_locale = LIS_4_OCTETS();                                                      \
+        auto taille_locale = LIS_4_OCTETS();                                                      \
+        auto adresse_locale = donne_adresse_locale(frame, indice_locale);                         \
+        memcpy(this->pointeur_pile, adresse_locale, static_cast<size_t>(taille_locale));          \
+        incrémente_pointeur_de_pile(taille_locale);                                               \
+    }
+
+#define ENUMERE_CODE_OPERATION_EX(code) +1
+static constexpr int NOMBRE_CODES_OPÉRATION = 0 ENUMERE_CODES_OPERATION;
+#undef ENUMERE_CODE_OPERATION_EX
+
+#if defined(__GNUC__)
+#    pragma GCC diagnostic push
+#    pragma GCC diagnostic ignored "-Wpedantic"
+#endif
 MachineVirtuelle::RésultatInterprétation MachineVirtuelle::exécute_instructions(
     int &compte_exécutées)
 {
+#ifdef DISPATCH_DIRECT
+#    define ENUMERE_CODE_OPERATION_EX(code) &&étiquette_##code,
+    static void *const table_dispatch[NOMBRE_CODES_OPÉRATION] = {ENUMERE_CODES_OPERATION};
+#    undef ENUMERE_CODE_OPERATION_EX
+#endif
+
     auto frame = &frames[profondeur_appel - 1];
 
     for (auto i = 0; i < INSTRUCTIONS_PAR_LOT; ++i) {
@@ -1280,7 +1669,7 @@ MachineVirtuelle::RésultatInterprétation MachineVirtuelle::exécute_instructio
         auto instruction = LIS_OCTET();
 
         switch (instruction) {
-            case OP_VÉRIFIE_CIBLE_BRANCHE:
+            CAS_OP(OP_VÉRIFIE_CIBLE_BRANCHE)
             {
                 auto const décalage = LIS_4_OCTETS();
                 auto const limites = donne_limite_code_frame(frame);
@@ -1290,17 +1679,17 @@ MachineVirtuelle::RésultatInterprétation MachineVirtuelle::exécute_instructio
                         "Branche vers une destination hors des limites de la fonction");
                     return RésultatInterprétation::ERREUR;
                 }
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_BRANCHE:
+            CAS_OP(OP_BRANCHE)
             {
                 /* frame->pointeur contient le décalage relatif à l'adresse du début de la
                  * fonction, leur addition nous donne donc le nouveau pointeur. */
                 frame->pointeur = frame->fonction->données_exécution->chunk.code +
                                   *reinterpret_cast<int *>(frame->pointeur);
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_VÉRIFIE_CIBLE_BRANCHE_CONDITION:
+            CAS_OP(OP_VÉRIFIE_CIBLE_BRANCHE_CONDITION)
             {
                 auto const décalage_si_vrai = LIS_4_OCTETS();
                 auto const limites = donne_limite_code_frame(frame);
@@ -1317,9 +1706,9 @@ MachineVirtuelle::RésultatInterprétation MachineVirtuelle::exécute_instructio
                         "Branche vers une destination hors des limites de la fonction");
                     return RésultatInterprétation::ERREUR;
                 }
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_BRANCHE_CONDITION:
+            CAS_OP(OP_BRANCHE_CONDITION)
             {
                 auto décalage_si_vrai = LIS_4_OCTETS();
                 auto décalage_si_faux = LIS_4_OCTETS();
@@ -1334,9 +1723,82 @@ MachineVirtuelle::RésultatInterprétation MachineVirtuelle::exécute_instructio
                                       décalage_si_faux;
                 }
 
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_BRANCHE_SI_ZÉRO:
+            CAS_OP(OP_COMP_INF_BRANCHE_CONDITION)
+            {
+                OP_BINAIRE(Inférieur)
+                /* Saute le code de OP_BRANCHE_CONDITION. */
+                frame->pointeur += 1;
+
+                auto décalage_si_vrai = LIS_4_OCTETS();
+                auto décalage_si_faux = LIS_4_OCTETS();
+                auto condition = dépile<bool>();
+
+                if (condition) {
+                    frame->pointeur = frame->fonction->données_exécution->chunk.code +
+                                      décalage_si_vrai;
+                }
+                else {
+                    frame->pointeur = frame->fonction->données_exécution->chunk.code +
+                                      décalage_si_faux;
+                }
+
+                OPÉRATION_SUIVANTE();
+            }
+            CAS_OP(OP_OPÉRATION_REGISTRES)
+            {
+                auto op = LIS_OCTET();
+                auto type = LIS_OCTET();
+                auto modes = LIS_OCTET();
+                auto destination = LIS_4_OCTETS();
+                auto gauche = donne_adresse_opérande_registre(frame,
+                                                              donne_genre_opérande_gauche(modes));
+                auto droite = donne_adresse_opérande_registre(frame,
+                                                              donne_genre_opérande_droite(modes));
+                dépile_opérandes_registres(type, gauche, droite);
+
+                if (destination == DESTINATION_PILE) {
+                    auto taille = exécute_opération_registres(
+                        op, type, this->pointeur_pile, gauche, droite);
+                    incrémente_pointeur_de_pile(taille);
+                }
+                else {
+                    exécute_opération_registres(
+                        op, type, &frame->pointeur_pile[destination], gauche, droite);
+                }
+
+                OPÉRATION_SUIVANTE();
+            }
+            CAS_OP(OP_BRANCHE_REGISTRES)
+            {
+                auto op = LIS_OCTET();
+                auto type = LIS_OCTET();
+                auto modes = LIS_OCTET();
+                auto gauche = donne_adresse_opérande_registre(frame,
+                                                              donne_genre_opérande_gauche(modes));
+                auto droite = donne_adresse_opérande_registre(frame,
+                                                              donne_genre_opérande_droite(modes));
+                dépile_opérandes_registres(type, gauche, droite);
+                auto décalage_si_vrai = LIS_4_OCTETS();
+                auto décalage_si_faux = LIS_4_OCTETS();
+
+                auto condition = false;
+                exécute_opération_registres(
+                    op, type, reinterpret_cast<octet_t *>(&condition), gauche, droite);
+
+                if (condition) {
+                    frame->pointeur = frame->fonction->données_exécution->chunk.code +
+                                      décalage_si_vrai;
+                }
+                else {
+                    frame->pointeur = frame->fonction->données_exécution->chunk.code +
+                                      décalage_si_faux;
+                }
+
+                OPÉRATION_SUIVANTE();
+            }
+            CAS_OP(OP_BRANCHE_SI_ZÉRO)
             {
                 auto taille = LIS_4_OCTETS();
                 auto décalage_si_vrai = LIS_4_OCTETS();
@@ -1382,14 +1844,14 @@ MachineVirtuelle::RésultatInterprétation MachineVirtuelle::exécute_instructio
                     frame->pointeur = frame->fonction->données_exécution->chunk.code +
                                       décalage_si_faux;
                 }
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_CONSTANTE:
+            CAS_OP(OP_CONSTANTE)
             {
                 empile_constante(frame);
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_STRUCTURE_CONSTANTE:
+            CAS_OP(OP_STRUCTURE_CONSTANTE)
             {
                 auto taille_structure = LIS_4_OCTETS();
 
@@ -1399,15 +1861,15 @@ MachineVirtuelle::RésultatInterprétation MachineVirtuelle::exécute_instructio
 
                 frame->pointeur += taille_structure;
                 incrémente_pointeur_de_pile(taille_structure);
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_REMBOURRAGE:
+            CAS_OP(OP_REMBOURRAGE)
             {
                 auto rembourrage = LIS_4_OCTETS();
                 incrémente_pointeur_de_pile(rembourrage);
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_INCRÉMENTE:
+            CAS_OP(OP_INCRÉMENTE)
             {
                 auto taille = LIS_4_OCTETS();
 
@@ -1428,9 +1890,9 @@ MachineVirtuelle::RésultatInterprétation MachineVirtuelle::exécute_instructio
                     empile(valeur + 1);
                 }
 
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_INCRÉMENTE_LOCALE:
+            CAS_OP(OP_INCRÉMENTE_LOCALE)
             {
                 auto taille = LIS_4_OCTETS();
                 auto indice = LIS_4_OCTETS();
@@ -1447,9 +1909,9 @@ MachineVirtuelle::RésultatInterprétation MachineVirtuelle::exécute_instructio
                 else {
                     *reinterpret_cast<uint64_t *>(adresse_variable) += 1;
                 }
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_DÉCRÉMENTE:
+            CAS_OP(OP_DÉCRÉMENTE)
             {
                 auto taille = LIS_4_OCTETS();
 
@@ -1470,217 +1932,217 @@ MachineVirtuelle::RésultatInterprétation MachineVirtuelle::exécute_instructio
                     empile(valeur - 1);
                 }
 
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_COMPLEMENT_ENTIER:
+            CAS_OP(OP_COMPLEMENT_ENTIER)
             {
                 OP_UNAIRE(-)
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_COMPLEMENT_RÉEL:
+            CAS_OP(OP_COMPLEMENT_RÉEL)
             {
                 OP_UNAIRE_RÉEL(-)
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_NON_BINAIRE:
+            CAS_OP(OP_NON_BINAIRE)
             {
                 OP_UNAIRE(~)
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_AJOUTE:
+            CAS_OP(OP_AJOUTE)
             {
                 OP_BINAIRE(Addition)
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_SOUSTRAIT:
+            CAS_OP(OP_SOUSTRAIT)
             {
                 OP_BINAIRE(Soustraction)
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_MULTIPLIE:
+            CAS_OP(OP_MULTIPLIE)
             {
                 OP_BINAIRE(Multiplication)
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_DIVISE:
+            CAS_OP(OP_DIVISE)
             {
                 OP_BINAIRE_NATUREL(Division)
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_DIVISE_RELATIF:
+            CAS_OP(OP_DIVISE_RELATIF)
             {
                 OP_BINAIRE(Division)
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_AJOUTE_RÉEL:
+            CAS_OP(OP_AJOUTE_RÉEL)
             {
                 OP_BINAIRE_RÉEL(Addition)
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_SOUSTRAIT_RÉEL:
+            CAS_OP(OP_SOUSTRAIT_RÉEL)
             {
                 OP_BINAIRE_RÉEL(Soustraction)
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_MULTIPLIE_RÉEL:
+            CAS_OP(OP_MULTIPLIE_RÉEL)
             {
                 OP_BINAIRE_RÉEL(Multiplication)
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_DIVISE_RÉEL:
+            CAS_OP(OP_DIVISE_RÉEL)
             {
                 OP_BINAIRE_RÉEL(Division)
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_RESTE_NATUREL:
+            CAS_OP(OP_RESTE_NATUREL)
             {
                 OP_BINAIRE_NATUREL(Modulo)
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_RESTE_RELATIF:
+            CAS_OP(OP_RESTE_RELATIF)
             {
                 OP_BINAIRE(Modulo)
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_COMP_ÉGAL:
+            CAS_OP(OP_COMP_ÉGAL)
             {
                 OP_BINAIRE(Égal)
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_COMP_INÉGAL:
+            CAS_OP(OP_COMP_INÉGAL)
             {
                 OP_BINAIRE(Différent)
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_COMP_INF:
+            CAS_OP(OP_COMP_INF)
             {
                 OP_BINAIRE(Inférieur)
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_COMP_INF_ÉGAL:
+            CAS_OP(OP_COMP_INF_ÉGAL)
             {
                 OP_BINAIRE(InférieurÉgal)
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_COMP_SUP:
+            CAS_OP(OP_COMP_SUP)
             {
                 OP_BINAIRE(Supérieur)
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_COMP_SUP_ÉGAL:
+            CAS_OP(OP_COMP_SUP_ÉGAL)
             {
                 OP_BINAIRE(SupérieurÉgal)
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_COMP_INF_NATUREL:
+            CAS_OP(OP_COMP_INF_NATUREL)
             {
                 OP_BINAIRE_NATUREL(Inférieur)
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_COMP_INF_ÉGAL_NATUREL:
+            CAS_OP(OP_COMP_INF_ÉGAL_NATUREL)
             {
                 OP_BINAIRE_NATUREL(InférieurÉgal)
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_COMP_SUP_NATUREL:
+            CAS_OP(OP_COMP_SUP_NATUREL)
             {
                 OP_BINAIRE_NATUREL(Supérieur)
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_COMP_SUP_ÉGAL_NATUREL:
+            CAS_OP(OP_COMP_SUP_ÉGAL_NATUREL)
             {
                 OP_BINAIRE_NATUREL(SupérieurÉgal)
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_COMP_ÉGAL_RÉEL:
+            CAS_OP(OP_COMP_ÉGAL_RÉEL)
             {
                 OP_BINAIRE_RÉEL(Égal)
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_COMP_INÉGAL_RÉEL:
+            CAS_OP(OP_COMP_INÉGAL_RÉEL)
             {
                 OP_BINAIRE_RÉEL(Différent)
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_COMP_INF_RÉEL:
+            CAS_OP(OP_COMP_INF_RÉEL)
             {
                 OP_BINAIRE_RÉEL(Inférieur)
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_COMP_INF_ÉGAL_RÉEL:
+            CAS_OP(OP_COMP_INF_ÉGAL_RÉEL)
             {
                 OP_BINAIRE_RÉEL(InférieurÉgal)
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_COMP_SUP_RÉEL:
+            CAS_OP(OP_COMP_SUP_RÉEL)
             {
                 OP_BINAIRE_RÉEL(Supérieur)
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_COMP_SUP_ÉGAL_RÉEL:
+            CAS_OP(OP_COMP_SUP_ÉGAL_RÉEL)
             {
                 OP_BINAIRE_RÉEL(SupérieurÉgal)
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_ET_BINAIRE:
+            CAS_OP(OP_ET_BINAIRE)
             {
                 OP_BINAIRE(ConjonctionBinaire)
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_OU_BINAIRE:
+            CAS_OP(OP_OU_BINAIRE)
             {
                 OP_BINAIRE(DisjonctionBinaire)
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_OU_EXCLUSIF:
+            CAS_OP(OP_OU_EXCLUSIF)
             {
                 OP_BINAIRE(DisjonctionBinaireExclusive)
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_DEC_GAUCHE:
+            CAS_OP(OP_DEC_GAUCHE)
             {
                 OP_BINAIRE(DécalageGauche)
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_DEC_DROITE_ARITHM:
+            CAS_OP(OP_DEC_DROITE_ARITHM)
             {
                 OP_BINAIRE(DécalageDroite)
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_DEC_DROITE_LOGIQUE:
+            CAS_OP(OP_DEC_DROITE_LOGIQUE)
             {
                 OP_BINAIRE_NATUREL(DécalageDroite)
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_AUGMENTE_NATUREL:
+            CAS_OP(OP_AUGMENTE_NATUREL)
             {
                 auto taille_de = LIS_4_OCTETS();
                 auto taille_vers = LIS_4_OCTETS();
                 FAIS_TRANSTYPE_AUGMENTE(unsigned char, unsigned short, uint32_t, uint64_t)
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_DIMINUE_NATUREL:
+            CAS_OP(OP_DIMINUE_NATUREL)
             {
                 auto taille_de = LIS_4_OCTETS();
                 auto taille_vers = LIS_4_OCTETS();
                 FAIS_TRANSTYPE_DIMINUE(unsigned char, unsigned short, uint32_t, uint64_t)
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_AUGMENTE_RELATIF:
+            CAS_OP(OP_AUGMENTE_RELATIF)
             {
                 auto taille_de = LIS_4_OCTETS();
                 auto taille_vers = LIS_4_OCTETS();
                 FAIS_TRANSTYPE_AUGMENTE(char, short, int, int64_t)
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_DIMINUE_RELATIF:
+            CAS_OP(OP_DIMINUE_RELATIF)
             {
                 auto taille_de = LIS_4_OCTETS();
                 auto taille_vers = LIS_4_OCTETS();
                 FAIS_TRANSTYPE_DIMINUE(char, short, int, int64_t)
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_AUGMENTE_RÉEL:
+            CAS_OP(OP_AUGMENTE_RÉEL)
             {
                 auto taille_de = LIS_4_OCTETS();
                 auto taille_vers = LIS_4_OCTETS();
@@ -1690,9 +2152,9 @@ MachineVirtuelle::RésultatInterprétation MachineVirtuelle::exécute_instructio
                     empile(static_cast<double>(v));
                 }
 
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_DIMINUE_RÉEL:
+            CAS_OP(OP_DIMINUE_RÉEL)
             {
                 auto taille_de = LIS_4_OCTETS();
                 auto taille_vers = LIS_4_OCTETS();
@@ -1702,9 +2164,9 @@ MachineVirtuelle::RésultatInterprétation MachineVirtuelle::exécute_instructio
                     empile(static_cast<float>(v));
                 }
 
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_NATUREL_VERS_RÉEL:
+            CAS_OP(OP_NATUREL_VERS_RÉEL)
             {
                 auto taille_de = LIS_4_OCTETS();
                 auto taille_vers = LIS_4_OCTETS();
@@ -1712,9 +2174,9 @@ MachineVirtuelle::RésultatInterprétation MachineVirtuelle::exécute_instructio
                 TRANSTYPE_EVR(uint16_t)
                 TRANSTYPE_EVR(uint32_t)
                 TRANSTYPE_EVR(int64_t)
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_RELATIF_VERS_RÉEL:
+            CAS_OP(OP_RELATIF_VERS_RÉEL)
             {
                 auto taille_de = LIS_4_OCTETS();
                 auto taille_vers = LIS_4_OCTETS();
@@ -1722,25 +2184,25 @@ MachineVirtuelle::RésultatInterprétation MachineVirtuelle::exécute_instructio
                 TRANSTYPE_EVR(int16_t)
                 TRANSTYPE_EVR(int32_t)
                 TRANSTYPE_EVR(int64_t)
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_RÉEL_VERS_NATUREL:
+            CAS_OP(OP_RÉEL_VERS_NATUREL)
             {
                 auto taille_de = LIS_4_OCTETS();
                 auto taille_vers = LIS_4_OCTETS();
                 TRANSTYPE_RVE(float, uint8_t, uint16_t, uint32_t, uint64_t)
                 TRANSTYPE_RVE(double, uint8_t, uint16_t, uint32_t, uint64_t)
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_RÉEL_VERS_RELATIF:
+            CAS_OP(OP_RÉEL_VERS_RELATIF)
             {
                 auto taille_de = LIS_4_OCTETS();
                 auto taille_vers = LIS_4_OCTETS();
                 TRANSTYPE_RVE(float, int8_t, int16_t, int32_t, int64_t)
                 TRANSTYPE_RVE(double, int8_t, int16_t, int32_t, int64_t)
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_RETOURNE:
+            CAS_OP(OP_RETOURNE)
             {
                 /* ATTENTION : si ceci change il faudra ajourner OP_LOGUE_SORTIES et
                  * OP_LOGUE_RETOUR. */
@@ -1774,9 +2236,9 @@ MachineVirtuelle::RésultatInterprétation MachineVirtuelle::exécute_instructio
 
                 /* Reprend l'exécution à la frame précédente. */
                 frame = &frames[profondeur_appel - 1];
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_VÉRIFIE_CIBLE_APPEL:
+            CAS_OP(OP_VÉRIFIE_CIBLE_APPEL)
             {
                 auto est_pointeur = LIS_OCTET();
                 AtomeFonction *ptr_fonction = nullptr;
@@ -1793,9 +2255,9 @@ MachineVirtuelle::RésultatInterprétation MachineVirtuelle::exécute_instructio
                     compte_exécutées = i + 1;
                     return RésultatInterprétation::ERREUR;
                 }
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_APPEL:
+            CAS_OP(OP_APPEL)
             {
                 auto ptr_fonction = LIS_POINTEUR(AtomeFonction);
                 auto taille_argument = LIS_4_OCTETS();
@@ -1805,9 +2267,9 @@ MachineVirtuelle::RésultatInterprétation MachineVirtuelle::exécute_instructio
                     return RésultatInterprétation::ERREUR;
                 }
 
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_APPEL_EXTERNE:
+            CAS_OP(OP_APPEL_EXTERNE)
             {
                 auto ptr_fonction = LIS_POINTEUR(AtomeFonction);
                 auto taille_argument = LIS_4_OCTETS();
@@ -1819,9 +2281,9 @@ MachineVirtuelle::RésultatInterprétation MachineVirtuelle::exécute_instructio
                     return résultat;
                 }
                 dépile_fonction_non_interne(ptr_fonction);
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_APPEL_COMPILATRICE:
+            CAS_OP(OP_APPEL_COMPILATRICE)
             {
                 auto ptr_fonction = LIS_POINTEUR(AtomeFonction);
 
@@ -1843,17 +2305,17 @@ MachineVirtuelle::RésultatInterprétation MachineVirtuelle::exécute_instructio
                     return RésultatInterprétation::PASSE_AU_SUIVANT;
                 }
 
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_APPEL_INTRINSÈQUE:
+            CAS_OP(OP_APPEL_INTRINSÈQUE)
             {
                 auto ptr_fonction = LIS_POINTEUR(AtomeFonction);
                 empile_fonction_non_interne(ptr_fonction);
                 appel_fonction_intrinsèque(ptr_fonction);
                 dépile_fonction_non_interne(ptr_fonction);
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_APPEL_POINTEUR:
+            CAS_OP(OP_APPEL_POINTEUR)
             {
                 auto taille_argument = LIS_4_OCTETS();
                 auto valeur_inst = LIS_8_OCTETS();
@@ -1899,9 +2361,9 @@ MachineVirtuelle::RésultatInterprétation MachineVirtuelle::exécute_instructio
                     }
                 }
 
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_VÉRIFIE_ADRESSAGE_ASSIGNE:
+            CAS_OP(OP_VÉRIFIE_ADRESSAGE_ASSIGNE)
             {
                 auto taille = LIS_4_OCTETS();
 
@@ -1915,18 +2377,18 @@ MachineVirtuelle::RésultatInterprétation MachineVirtuelle::exécute_instructio
                     return RésultatInterprétation::ERREUR;
                 }
 
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_ASSIGNE:
+            CAS_OP(OP_ASSIGNE)
             {
                 auto taille = LIS_4_OCTETS();
                 auto adresse_ou = dépile<void *>();
                 auto adresse_de = static_cast<void *>(this->pointeur_pile - taille);
                 memcpy(adresse_ou, adresse_de, static_cast<size_t>(taille));
                 décrémente_pointeur_de_pile(taille);
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_ASSIGNE_LOCALE:
+            CAS_OP(OP_ASSIGNE_LOCALE)
             {
                 auto indice = LIS_4_OCTETS();
                 auto taille = LIS_4_OCTETS();
@@ -1936,17 +2398,17 @@ MachineVirtuelle::RésultatInterprétation MachineVirtuelle::exécute_instructio
                 memcpy(adresse_ou, adresse_de, static_cast<size_t>(taille));
 
                 décrémente_pointeur_de_pile(taille);
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_COPIE_MÉMOIRE:
+            CAS_OP(OP_COPIE_MÉMOIRE)
             {
                 auto taille = LIS_4_OCTETS();
                 auto adresse_ou = dépile<void *>();
                 auto adresse_de = dépile<void *>();
                 memcpy(adresse_ou, adresse_de, static_cast<size_t>(taille));
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_INIT_LOCALE_ZÉRO:
+            CAS_OP(OP_INIT_LOCALE_ZÉRO)
             {
                 auto indice = LIS_4_OCTETS();
                 auto taille = LIS_4_OCTETS();
@@ -1972,9 +2434,9 @@ MachineVirtuelle::RésultatInterprétation MachineVirtuelle::exécute_instructio
                     }
                 }
 
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_COPIE_LOCALE:
+            CAS_OP(OP_COPIE_LOCALE)
             {
                 auto taille = LIS_4_OCTETS();
                 auto indice_source = LIS_4_OCTETS();
@@ -1984,9 +2446,9 @@ MachineVirtuelle::RésultatInterprétation MachineVirtuelle::exécute_instructio
                 auto adresse_destination = donne_adresse_locale(frame, indice_destination);
 
                 memcpy(adresse_destination, adresse_source, static_cast<size_t>(taille));
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_VÉRIFIE_ADRESSAGE_CHARGE:
+            CAS_OP(OP_VÉRIFIE_ADRESSAGE_CHARGE)
             {
                 auto taille = LIS_4_OCTETS();
 
@@ -2000,66 +2462,75 @@ MachineVirtuelle::RésultatInterprétation MachineVirtuelle::exécute_instructio
                     return RésultatInterprétation::ERREUR;
                 }
 
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_CHARGE:
+            CAS_OP(OP_CHARGE)
             {
                 auto taille = LIS_4_OCTETS();
                 auto adresse_de = dépile<void *>();
                 auto adresse_ou = static_cast<void *>(this->pointeur_pile);
                 memcpy(adresse_ou, adresse_de, static_cast<size_t>(taille));
                 incrémente_pointeur_de_pile(taille);
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_CHARGE_LOCALE:
+            CAS_OP(OP_CHARGE_LOCALE)
             {
-                auto indice = LIS_4_OCTETS();
-                auto taille = LIS_4_OCTETS();
-
-                auto adresse_de = donne_adresse_locale(frame, indice);
-                auto adresse_ou = static_cast<void *>(this->pointeur_pile);
-                memcpy(adresse_ou, adresse_de, static_cast<size_t>(taille));
-
-                incrémente_pointeur_de_pile(taille);
-                break;
+                CHARGE_LOCALE()
+                OPÉRATION_SUIVANTE();
             }
-            case OP_RÉFÉRENCE_LOCALE:
+            CAS_OP(OP_CHARGE_LOCALE_AJOUTE)
+            {
+                CHARGE_LOCALE()
+                /* Saute le code de OP_AJOUTE. */
+                frame->pointeur += 1;
+                OP_BINAIRE(Addition)
+                OPÉRATION_SUIVANTE();
+            }
+            CAS_OP(OP_CHARGE_LOCALE_CHARGE_LOCALE)
+            {
+                CHARGE_LOCALE()
+                /* Saute le code de la seconde OP_CHARGE_LOCALE. */
+                frame->pointeur += 1;
+                CHARGE_LOCALE()
+                OPÉRATION_SUIVANTE();
+            }
+            CAS_OP(OP_RÉFÉRENCE_LOCALE)
             {
                 auto indice = LIS_4_OCTETS();
                 empile(donne_adresse_locale(frame, indice));
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_RÉFÉRENCE_GLOBALE:
+            CAS_OP(OP_RÉFÉRENCE_GLOBALE)
             {
                 auto indice = LIS_4_OCTETS();
                 auto const &globale = données_constantes->globales[indice];
                 empile(&ptr_données_globales[globale.adresse]);
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_RÉFÉRENCE_GLOBALE_EXTERNE:
+            CAS_OP(OP_RÉFÉRENCE_GLOBALE_EXTERNE)
             {
                 auto adresse = LIS_8_OCTETS();
                 empile(adresse);
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_RÉFÉRENCE_RUBRIQUE:
+            CAS_OP(OP_RÉFÉRENCE_RUBRIQUE)
             {
                 auto décalage = LIS_4_OCTETS();
                 auto adresse_de = dépile<char *>();
                 empile(adresse_de + décalage);
                 // dbg() << "adresse_de : " << static_cast<void *>(adresse_de);
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_RÉFÉRENCE_RUBRIQUE_LOCALE:
+            CAS_OP(OP_RÉFÉRENCE_RUBRIQUE_LOCALE)
             {
                 auto pointeur = LIS_4_OCTETS();
                 auto décalage = LIS_4_OCTETS();
                 auto adresse_base = donne_adresse_locale(frame, pointeur);
                 auto adresse_rubrique = static_cast<char *>(adresse_base) + décalage;
                 empile(adresse_rubrique);
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_ACCÈS_INDICE:
+            CAS_OP(OP_ACCÈS_INDICE)
             {
                 auto taille_données = LIS_4_OCTETS();
                 auto adresse = dépile<char *>();
@@ -2069,18 +2540,18 @@ MachineVirtuelle::RésultatInterprétation MachineVirtuelle::exécute_instructio
                 // dbg() << "nouvelle_adresse : " << static_cast<void *>(nouvelle_adresse) << '\n'
                 //       << "indice            : " << indice << '\n'
                 //       << "taille_données   : " << taille_données;
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_STAT_INSTRUCTION:
+            CAS_OP(OP_STAT_INSTRUCTION)
             {
                 /* L'opération est directement après nous. Il ne faut pas incémenter le pointeur.
                  */
                 auto op = *frame->pointeur;
                 m_métaprogramme->données_exécution->compte_instructions[op] += 1;
                 m_métaprogramme->données_exécution->compte_instructions[OP_STAT_INSTRUCTION] += 1;
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_LOGUE_INSTRUCTION:
+            CAS_OP(OP_LOGUE_INSTRUCTION)
             {
                 auto décalage = LIS_4_OCTETS();
                 auto &chunk = frame->fonction->données_exécution->chunk;
@@ -2088,23 +2559,23 @@ MachineVirtuelle::RésultatInterprétation MachineVirtuelle::exécute_instructio
                     TypeLogMétaprogramme::INSTRUCTION);
                 logueuse << chaine_indentations(profondeur_appel);
                 désassemble_instruction(chunk, décalage, logueuse);
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_LOGUE_VALEURS_LOCALES:
+            CAS_OP(OP_LOGUE_VALEURS_LOCALES)
             {
                 auto &logueuse = m_métaprogramme->donne_logueuse(TypeLogMétaprogramme::APPEL);
                 imprime_valeurs_locales(frame, profondeur_appel, logueuse);
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_LOGUE_APPEL:
+            CAS_OP(OP_LOGUE_APPEL)
             {
                 auto ptr_fonction = LIS_POINTEUR(AtomeFonction);
                 auto &logueuse = m_métaprogramme->donne_logueuse(TypeLogMétaprogramme::APPEL);
                 logueuse << "-- appel : " << ptr_fonction->nom << " ("
                          << chaine_type(ptr_fonction->type) << ')' << '\n';
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_LOGUE_ENTRÉES:
+            CAS_OP(OP_LOGUE_ENTRÉES)
             {
                 auto ptr_fonction = LIS_POINTEUR(AtomeFonction);
                 auto taille_arguments = LIS_4_OCTETS();
@@ -2112,9 +2583,9 @@ MachineVirtuelle::RésultatInterprétation MachineVirtuelle::exécute_instructio
                 auto &logueuse = m_métaprogramme->donne_logueuse(TypeLogMétaprogramme::APPEL);
                 imprime_valeurs_entrées(
                     pointeur_arguments, ptr_fonction, profondeur_appel, logueuse);
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_LOGUE_SORTIES:
+            CAS_OP(OP_LOGUE_SORTIES)
             {
                 auto type_fonction = frame->fonction->type->comme_type_fonction();
                 auto taille_retour = static_cast<int>(type_fonction->type_sortie->taille_octet);
@@ -2122,9 +2593,9 @@ MachineVirtuelle::RésultatInterprétation MachineVirtuelle::exécute_instructio
                 auto &logueuse = m_métaprogramme->donne_logueuse(TypeLogMétaprogramme::APPEL);
                 imprime_valeurs_sorties(
                     pointeur_début_retour, frame->fonction, profondeur_appel, logueuse);
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_LOGUE_RETOUR:
+            CAS_OP(OP_LOGUE_RETOUR)
             {
                 auto type_fonction = frame->fonction->type->comme_type_fonction();
                 auto taille_retour = static_cast<int>(type_fonction->type_sortie->taille_octet);
@@ -2133,48 +2604,48 @@ MachineVirtuelle::RésultatInterprétation MachineVirtuelle::exécute_instructio
                          << static_cast<int>(frame->pointeur_pile - pile) << '\n';
                 logueuse << "Empile " << taille_retour << " octet(s), décalage : "
                          << static_cast<int>(frame->pointeur_pile + taille_retour - pile) << '\n';
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_NOTIFIE_DÉPILAGE_VALEUR:
+            CAS_OP(OP_NOTIFIE_DÉPILAGE_VALEUR)
             {
                 auto taille_données = LIS_4_OCTETS();
                 auto résultat = notifie_dépile(frame, frame->pointeur, uint32_t(taille_données));
                 if (résultat != RésultatInterprétation::OK) {
                     return résultat;
                 }
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_NOTIFIE_EMPILAGE_VALEUR:
+            CAS_OP(OP_NOTIFIE_EMPILAGE_VALEUR)
             {
                 auto taille_données = LIS_4_OCTETS();
                 notifie_empile(frame, frame->pointeur, uint32_t(taille_données));
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_PROFILE_DÉBUTE_APPEL:
+            CAS_OP(OP_PROFILE_DÉBUTE_APPEL)
             {
                 auto de = m_métaprogramme->données_exécution;
                 de->profondeur_appel = profondeur_appel;
                 de->profileuse.ajoute_échantillon(m_métaprogramme, 1);
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_PROFILE_TERMINE_APPEL:
+            CAS_OP(OP_PROFILE_TERMINE_APPEL)
             {
                 auto de = m_métaprogramme->données_exécution;
                 /* La profondeur d'appel fut modifiée par dépile_fonction_non_interne ou par les
                  * retours, donc nous devons l'ajuster ici. */
                 de->profondeur_appel = profondeur_appel + 1;
-                de->profileuse.ajoute_échantillon(m_métaprogramme, 1);
+                de->profileuse.ajoute_échantillon(m_métaprogramme, 1, true);
                 de->profondeur_appel = profondeur_appel;
-                break;
+                OPÉRATION_SUIVANTE();
             }
-            case OP_INATTEIGNABLE:
+            CAS_OP(OP_INATTEIGNABLE)
             {
                 rapporte_erreur_exécution("Erreur : l'exécution du métaprogramme atteint une "
                                           "instruction inatteignable.");
                 compte_exécutées = i + 1;
                 return RésultatInterprétation::ERREUR;
             }
-            case OP_SÉLECTION:
+            CAS_OP(OP_SÉLECTION)
             {
                 auto taille_arguments = LIS_4_OCTETS();
                 auto valeur_condition = dépile<bool>();
@@ -2189,9 +2660,15 @@ MachineVirtuelle::RésultatInterprétation MachineVirtuelle::exécute_instructio
 
                 /* Nous ne supprimons qu'un seul argument. */
                 décrémente_pointeur_de_pile(taille_arguments);
-                break;
+                OPÉRATION_SUIVANTE();
             }
+            /* Non supportées par la MV. */
+            CAS_OP(OP_PIVOTE_GAUCHE)
+            CAS_OP(OP_PIVOTE_DROITE)
             default:
+#ifdef DISPATCH_DIRECT
+            étiquette_opération_inconnue:
+#endif
             {
                 rapporte_erreur_exécution("Erreur interne : Opération inconnue dans la MV !");
                 compte_exécutées = i + 1;
@@ -2200,9 +2677,19 @@ MachineVirtuelle::RésultatInterprétation MachineVirtuelle::exécute_instructio
         }
     }
 
+#ifdef DISPATCH_DIRECT
+fin_lot:
+#endif
     compte_exécutées = INSTRUCTIONS_PAR_LOT;
     return RésultatInterprétation::OK;
 }
+#if defined(__GNUC__)
+#    pragma GCC diagnostic pop
+#endif
+
+#undef CHARGE_LOCALE
+#undef OPÉRATION_SUIVANTE
+#undef CAS_OP
 
 void MachineVirtuelle::imprime_trace_appel(NoeudExpression const *site)
 {
@@ -2523,10 +3010,14 @@ void MachineVirtuelle::déloge_données_exécution(DonnéesExécution *&données
 
 void MachineVirtuelle::rassemble_statistiques(Statistiques &stats)
 {
-    stats.ajoute_mémoire_utilisée("Machine Virtuelle", données_exécution.mémoire_utilisée());
+    stats.ajoute_mémoire_utilisée("Machine Virtuelle",
+                                  données_exécution.mémoire_utilisée() +
+                                      m_stockage_interfaces_appel_variadiques.mémoire_utilisée() +
+                                      m_interfaces_appel_variadiques.taille_mémoire());
     stats.nombre_métaprogrammes_exécutés += nombre_de_métaprogrammes_exécutés;
     stats.temps_métaprogrammes += temps_exécution_métaprogammes;
     stats.instructions_exécutées += instructions_exécutées;
+    m_jit.rassemble_statistiques(stats);
 }
 
 std::ostream &operator<<(std::ostream &os, PatchDonnéesConstantes const &patch)
@@ -2561,6 +3052,7 @@ std::ostream &operator<<(std::ostream &os, PatchDonnéesConstantes const &patch)
 void Profileuse::réinitialise()
 {
     échantillons.efface();
+    données_adresses.efface();
 }
 
 void Profileuse::prépare_pour_profilage()
@@ -2596,15 +3088,20 @@ static bool les_frames_sont_les_mêmes(FrameAppel const *frame1,
     return true;
 }
 
-void Profileuse::ajoute_échantillon(MétaProgramme *métaprogramme, int poids)
+void Profileuse::ajoute_échantillon(MétaProgramme *métaprogramme, int poids, bool après_retour)
 {
     if (poids == 0) {
         return;
     }
 
     auto ticks = donne_ticks();
+    /* Ajourne avant de fusionner l'échantillon avec le précédent, sinon les ticks s'accumulent
+     * et le temps depuis le dernier échantillon distinct est recompté à chaque fusion. */
+    ajourne_ticks();
 
     auto de = métaprogramme->données_exécution;
+    ajoute_poids_adresses(de->frames, de->profondeur_appel, ticks, après_retour);
+
     if (!échantillons.est_vide()) {
         auto &dernier_échantillon = échantillons.dernier_élément();
         auto profondeur_échantillon = dernier_échantillon.profondeur_frame_appel;
@@ -2627,8 +3124,51 @@ void Profileuse::ajoute_échantillon(MétaProgramme *métaprogramme, int poids)
     }
 
     échantillons.ajoute(echantillon);
+}
 
-    ajourne_ticks();
+void Profileuse::ajoute_poids_adresses(FrameAppel const *frames,
+                                       int profondeur,
+                                       uint64_t poids,
+                                       bool après_retour)
+{
+    for (int i = 0; i < profondeur; i++) {
+        auto const &frame = frames[i];
+        auto const est_dernière_frame = (i == profondeur - 1);
+
+        /* Le pointeur des frames appelantes est l'adresse de retour, celui d'une frame ayant
+         * retourné se trouve après le retour : l'octet précédent se trouve dans l'instruction
+         * d'appel ou de retour, et donc sur sa ligne. */
+        auto adresse = frame.pointeur;
+        auto est_début_instruction = est_dernière_frame && !après_retour;
+        if (!est_début_instruction) {
+            adresse -= 1;
+        }
+
+        /* Lors d'appels récursifs, seule la frame la plus profonde de chaque fonction compte
+         * dans le temps total, afin que celui d'une ligne ne dépasse pas le temps d'exécution. */
+        auto déjà_comptée = false;
+        for (int j = i + 1; j < profondeur; j++) {
+            if (frames[j].fonction == frame.fonction) {
+                déjà_comptée = true;
+                break;
+            }
+        }
+
+        auto données = données_adresses.trouve_pointeur(adresse);
+        if (!données) {
+            données_adresses.insère(adresse,
+                                    {frame.fonction, adresse, est_début_instruction, 0, 0});
+            données = données_adresses.trouve_pointeur(adresse);
+        }
+
+        if (!déjà_comptée) {
+            données->total += poids;
+        }
+
+        if (est_dernière_frame) {
+            données->propre += poids;
+        }
+    }
 }
 
 static void imprime_nom_fonction(AtomeFonction const *fonction, Enchaineuse &os)
@@ -2697,9 +3237,278 @@ static void crée_rapport_format_brendan_gregg(
     }
 }
 
+/* Le temps propre et total d'une fonction, d'une ligne, ou d'une opération. */
+struct TempsProfilage {
+    AtomeFonction const *fonction = nullptr;
+    Lexème const *lexème = nullptr;
+    octet_t code_opération = 0;
+    uint64_t propre = 0;
+    uint64_t total = 0;
+};
+
+static void trie_par_temps_propre(kuri::tableau<TempsProfilage, int> &temps)
+{
+    std::sort(temps.begin(), temps.end(), [](auto &a, auto &b) {
+        if (a.propre != b.propre) {
+            return a.propre > b.propre;
+        }
+        return a.total > b.total;
+    });
+}
+
+static void imprime_pourcentage(Enchaineuse &os, uint64_t valeur, uint64_t total)
+{
+    auto pourcentage = total ? double(valeur) * 100.0 / double(total) : 0.0;
+    char tampon[32];
+    auto taille = snprintf(tampon, sizeof(tampon), "%6.2f%%", pourcentage);
+    os << kuri::chaine_statique(tampon, taille);
+}
+
+static void imprime_temps_profilage(Enchaineuse &os,
+                                    TempsProfilage const &temps,
+                                    uint64_t total,
+                                    bool avec_total)
+{
+    os << "  ";
+    imprime_pourcentage(os, temps.propre, total);
+    if (avec_total) {
+        os << "  ";
+        imprime_pourcentage(os, temps.total, total);
+    }
+    os << "  ";
+}
+
+/* Les fonctions externes n'ont pas de code binaire, et leurs frames peuvent être obsolètes. */
+static bool adresse_est_dans_le_code(AtomeFonction const *fonction, octet_t const *adresse)
+{
+    if (!fonction->données_exécution) {
+        return false;
+    }
+
+    auto const &chunk = fonction->données_exécution->chunk;
+    return adresse >= chunk.code && adresse < chunk.code + chunk.compte;
+}
+
+static Lexème const *donne_lexème_pour_adresse(AtomeFonction const *fonction, octet_t *adresse)
+{
+    auto site = fonction->données_exécution->chunk.donne_site_pour_adresse(adresse);
+    return site ? site->lexème : nullptr;
+}
+
+/* Crée des tableaux des temps propres (passés dans la fonction ou la ligne même) et totaux
+ * (incluant les fonctions appelées) par fonction, par ligne de code source, et par opération.
+ * Les pourcentages sont relatifs au temps total d'exécution. */
+static void crée_rapport_format_tableaux(
+    EspaceDeTravail const &espace,
+    kuri::tableau_statique<ÉchantillonProfilage> échantillons,
+    kuri::table_hachage<octet_t *, DonnéesAdresseProfilage> const &données_adresses,
+    Enchaineuse &os)
+{
+    auto temps_total = uint64_t(0);
+
+    /* Fonctions, depuis les piles d'appels. */
+    auto indices_fonctions = kuri::table_hachage<AtomeFonction const *, int>("Profilage");
+    auto temps_fonctions = kuri::tableau<TempsProfilage, int>();
+
+    POUR (échantillons) {
+        temps_total += it.poids;
+
+        for (int i = 0; i < it.profondeur_frame_appel; i++) {
+            auto fonction = it.frames[i].fonction;
+
+            bool trouvé;
+            auto indice = indices_fonctions.trouve(fonction, trouvé);
+            if (!trouvé) {
+                indice = temps_fonctions.taille();
+                indices_fonctions.insère(fonction, indice);
+                temps_fonctions.ajoute({fonction});
+            }
+
+            /* Les fonctions récursives ne comptent qu'une fois dans le temps total. */
+            auto déjà_comptée = false;
+            for (int j = 0; j < i; j++) {
+                if (it.frames[j].fonction == fonction) {
+                    déjà_comptée = true;
+                    break;
+                }
+            }
+
+            auto &temps = temps_fonctions[indice];
+            if (!déjà_comptée) {
+                temps.total += it.poids;
+            }
+
+            if (i == it.profondeur_frame_appel - 1) {
+                temps.propre += it.poids;
+            }
+        }
+    }
+
+    /* Lignes et opérations, depuis les adresses. */
+    auto indices_lignes = kuri::table_hachage<int64_t, int>("Profilage");
+    auto temps_lignes = kuri::tableau<TempsProfilage, int>();
+    /* Le temps entre le dernier échantillon d'une fonction et son retour. */
+    auto temps_fin_appel = uint64_t(0);
+    TempsProfilage temps_opérations[256];
+    for (int i = 0; i < 256; i++) {
+        temps_opérations[i].code_opération = octet_t(i);
+    }
+
+    données_adresses.pour_chaque_élément([&](DonnéesAdresseProfilage const &données) {
+        if (!adresse_est_dans_le_code(données.fonction, données.adresse)) {
+            return;
+        }
+
+        auto lexème = donne_lexème_pour_adresse(données.fonction, données.adresse);
+        if (lexème) {
+            auto clé = (int64_t(lexème->fichier) << 32) | int64_t(uint32_t(lexème->ligne));
+
+            bool trouvé;
+            auto indice = indices_lignes.trouve(clé, trouvé);
+            if (!trouvé) {
+                indice = temps_lignes.taille();
+                indices_lignes.insère(clé, indice);
+                temps_lignes.ajoute({données.fonction, lexème});
+            }
+
+            temps_lignes[indice].propre += données.propre;
+            temps_lignes[indice].total += données.total;
+        }
+
+        if (données.est_début_instruction) {
+            temps_opérations[*données.adresse].propre += données.propre;
+        }
+        else {
+            temps_fin_appel += données.propre;
+        }
+    });
+
+    os << "Temps total : " << temps_total << " ticks\n";
+
+    os << "\nFonctions :\n";
+    os << "   propre    total  fonction\n";
+    trie_par_temps_propre(temps_fonctions);
+    POUR (temps_fonctions) {
+        imprime_temps_profilage(os, it, temps_total, true);
+        imprime_nom_fonction(it.fonction, os);
+        os << '\n';
+    }
+
+    os << "\nLignes :\n";
+    os << "   propre    total  ligne\n";
+    trie_par_temps_propre(temps_lignes);
+    POUR (temps_lignes) {
+        if (it.total == 0) {
+            continue;
+        }
+
+        imprime_temps_profilage(os, it, temps_total, true);
+        os << espace.fichier(it.lexème->fichier)->nom() << ':' << it.lexème->ligne + 1 << " (";
+        imprime_nom_fonction(it.fonction, os);
+        os << ")\n";
+    }
+
+    os << "\nOpérations :\n";
+    os << "   propre  opération\n";
+    auto opérations = kuri::tableau<TempsProfilage, int>();
+    for (auto const &temps : temps_opérations) {
+        if (temps.propre != 0) {
+            opérations.ajoute(temps);
+        }
+    }
+    trie_par_temps_propre(opérations);
+    POUR (opérations) {
+        imprime_temps_profilage(os, it, temps_total, false);
+        os << chaine_code_opération(it.code_opération) << '\n';
+    }
+
+    if (temps_fin_appel != 0) {
+        os << "  ";
+        imprime_pourcentage(os, temps_fin_appel, temps_total);
+        os << "  (fin d'appel)\n";
+    }
+}
+
+/* Crée un fichier JSON pour https://www.speedscope.app, selon le schéma
+ * https://www.speedscope.app/file-format-schema.json : les fonctions forment les frames
+ * partagées, et chaque échantillon est une pile d'indices de frames avec son poids. */
+static void crée_rapport_format_speedscope(
+    EspaceDeTravail const &espace,
+    kuri::chaine_statique nom_profil,
+    kuri::tableau_statique<ÉchantillonProfilage> échantillons,
+    Enchaineuse &os)
+{
+    auto indices_fonctions = kuri::table_hachage<AtomeFonction const *, int>("Profilage");
+    auto fonctions = kuri::tableau<AtomeFonction const *, int>();
+    auto temps_total = uint64_t(0);
+
+    POUR (échantillons) {
+        temps_total += it.poids;
+        for (int i = 0; i < it.profondeur_frame_appel; i++) {
+            auto fonction = it.frames[i].fonction;
+            if (!indices_fonctions.possède(fonction)) {
+                indices_fonctions.insère(fonction, fonctions.taille());
+                fonctions.ajoute(fonction);
+            }
+        }
+    }
+
+    os << "{\"$schema\":\"https://www.speedscope.app/file-format-schema.json\"";
+    os << ",\"exporter\":\"kuri\",\"name\":";
+    imprime_chaine_json(os, nom_profil);
+
+    os << ",\"shared\":{\"frames\":[";
+    auto virgule = "";
+    POUR (fonctions) {
+        Enchaineuse nom;
+        imprime_nom_fonction(it, nom);
+
+        os << virgule << "{\"name\":";
+        imprime_chaine_json(os, nom.chaine());
+
+        auto decl = it->decl;
+        if (decl && decl->lexème) {
+            os << ",\"file\":";
+            imprime_chaine_json(os, espace.fichier(decl->lexème->fichier)->chemin());
+            os << ",\"line\":" << decl->lexème->ligne + 1;
+        }
+
+        os << "}";
+        virgule = ",";
+    }
+    os << "]}";
+
+    os << ",\"profiles\":[{\"type\":\"sampled\",\"name\":";
+    imprime_chaine_json(os, nom_profil);
+    os << ",\"unit\":\"none\",\"startValue\":0,\"endValue\":" << temps_total;
+
+    os << ",\"samples\":[";
+    virgule = "";
+    POUR (échantillons) {
+        os << virgule << "[";
+        for (int i = 0; i < it.profondeur_frame_appel; i++) {
+            if (i != 0) {
+                os << ",";
+            }
+            os << indices_fonctions.valeur_ou(it.frames[i].fonction, 0);
+        }
+        os << "]";
+        virgule = ",";
+    }
+
+    os << "],\"weights\":[";
+    virgule = "";
+    POUR (échantillons) {
+        os << virgule << it.poids;
+        virgule = ",";
+    }
+    os << "]}]}\n";
+}
+
 void Profileuse::crée_rapport(MétaProgramme *métaprogramme, FormatRapportProfilage format)
 {
     auto &logueuse = métaprogramme->donne_logueuse(TypeLogMétaprogramme::PROFILAGE);
+    auto const &espace = *métaprogramme->unité->espace;
 
     switch (format) {
         case FormatRapportProfilage::ECHANTILLONS_TOTAL_POUR_FONCTION:
@@ -2712,5 +3521,16 @@ void Profileuse::crée_rapport(MétaProgramme *métaprogramme, FormatRapportProf
             crée_rapport_format_brendan_gregg(échantillons, logueuse);
             break;
         }
+        case FormatRapportProfilage::TABLEAUX:
+        {
+            crée_rapport_format_tableaux(espace, échantillons, données_adresses, logueuse);
+            break;
+        }
+        case FormatRapportProfilage::SPEEDSCOPE:
+        {
+            crée_rapport_format_speedscope(
+                espace, métaprogramme->donne_nom_pour_fichier_log(), échantillons, logueuse);
+            break;
+        }
     }
 }
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "code_binaire.hh"
+#include "machine_virtuelle_jit.hh"
 
 #include "structures/pile.hh"
 
@@ -14,6 +15,7 @@
 #else
 #    include <unordered_map>
 #endif
+#include "structures/table_hachage.hh"
 #include "structures/tableau_page.hh"
 
 struct AtomeFonction;
@@ -83,11 +85,27 @@ struct PaireÉchantillonFonction {
     int nombre_échantillons = 0;
 };
 
+/* Le temps passé à une adresse du code binaire, afin d'attribuer celui-ci aux lignes du code
+ * source et aux opérations. */
+struct DonnéesAdresseProfilage {
+    AtomeFonction const *fonction = nullptr;
+    octet_t *adresse = nullptr;
+    /* Faux si l'adresse pointe dans une instruction d'appel ou de retour, et non au début de
+     * l'instruction à exécuter. */
+    bool est_début_instruction = false;
+    /* Le temps passé à exécuter l'instruction à cette adresse. */
+    uint64_t propre = 0;
+    /* Le temps passé à exécuter l'instruction, ainsi que les fonctions qu'elle appelle. */
+    uint64_t total = 0;
+};
+
 enum class FormatRapportProfilage : int;
 
 struct Profileuse {
   private:
     kuri::tableau<ÉchantillonProfilage> échantillons{};
+    kuri::table_hachage<octet_t *, DonnéesAdresseProfilage> données_adresses{
+        "Profilage adresses"};
     uint64_t ticks_de_bases = 0;
 
   public:
@@ -95,13 +113,20 @@ struct Profileuse {
 
     void prépare_pour_profilage();
 
-    void ajoute_échantillon(MétaProgramme *métaprogramme, int poids);
+    /* après_retour doit être vrai si la dernière frame vient de retourner, auquel cas son
+     * pointeur se trouve après l'instruction de retour. */
+    void ajoute_échantillon(MétaProgramme *métaprogramme, int poids, bool après_retour = false);
 
     void crée_rapport(MétaProgramme *métaprogramme, FormatRapportProfilage format);
 
   private:
     void ajourne_ticks();
     uint64_t donne_ticks();
+
+    void ajoute_poids_adresses(FrameAppel const *frames,
+                               int profondeur,
+                               uint64_t poids,
+                               bool après_retour);
 };
 
 /** \} */
@@ -178,6 +203,21 @@ struct MachineVirtuelle {
 
     MétaProgramme *m_métaprogramme = nullptr;
 
+    /* Utilisée si --jit_métaprogrammes fut renseigné. */
+    CompilatriceJIT m_jit{};
+
+    /* Interfaces d'appel préparées des fonctions externes variadiques pour chaque site d'appel,
+     * les types des arguments variadiques étant propres au site. L'adresse d'une instruction
+     * libérée pouvant être réutilisée pour un autre appel, le cache est vidé dès que de la RI
+     * fut libérée depuis sa dernière consultation. */
+    kuri::tableau_page<DonnéesExécutionFonction::DonnéesFonctionExterne>
+        m_stockage_interfaces_appel_variadiques{};
+    int64_t m_nombre_interfaces_appel_variadiques = 0;
+    kuri::table_hachage<InstructionAppel const *,
+                        DonnéesExécutionFonction::DonnéesFonctionExterne *>
+        m_interfaces_appel_variadiques{"Interfaces appel variadiques"};
+    uint64_t m_nombre_libérations_ri_vues = 0;
+
   public:
     bool stop = false;
 
@@ -221,8 +261,41 @@ struct MachineVirtuelle {
         return *reinterpret_cast<T *>(this->pointeur_pile);
     }
 
-    void incrémente_pointeur_de_pile(int64_t taille);
-    void décrémente_pointeur_de_pile(int64_t taille);
+    /* Les vérifications des limites de la pile sont en ligne, seuls les rapports d'erreurs sont
+     * hors de la boucle d'exécution. */
+    void incrémente_pointeur_de_pile(int64_t taille)
+    {
+        this->pointeur_pile += taille;
+        if (IMPROBABLE(pointeur_pile >= (pile + TAILLE_PILE))) {
+            rapporte_sur_entamponnage_pile();
+        }
+    }
+
+    void décrémente_pointeur_de_pile(int64_t taille)
+    {
+        pointeur_pile -= taille;
+        if (IMPROBABLE(pointeur_pile < pile)) {
+            rapporte_sous_entamponnage_pile();
+        }
+    }
+
+    /* Dépile les opérandes des instructions à registres qui sont sur la pile (ceux dont
+     * l'adresse est nulle), l'opérande droite étant au sommet. */
+    void dépile_opérandes_registres(octet_t type, octet_t *&gauche, octet_t *&droite)
+    {
+        auto const taille = static_cast<int64_t>(type >> 3);
+        if (droite == nullptr) {
+            décrémente_pointeur_de_pile(taille);
+            droite = pointeur_pile;
+        }
+        if (gauche == nullptr) {
+            décrémente_pointeur_de_pile(taille);
+            gauche = pointeur_pile;
+        }
+    }
+
+    TOUJOURS_HORSLIGNE void rapporte_sur_entamponnage_pile();
+    TOUJOURS_HORSLIGNE void rapporte_sous_entamponnage_pile();
 
     bool appel(AtomeFonction *fonction, NoeudExpression const *site);
 
@@ -233,6 +306,13 @@ struct MachineVirtuelle {
                                 int taille_argument,
                                 InstructionAppel *inst_appel,
                                 RésultatInterprétation &résultat);
+    DonnéesExécutionFonction::DonnéesFonctionExterne *donne_interface_appel_variadique(
+        AtomeFonction const *ptr_fonction, InstructionAppel const *inst_appel);
+    void appel_fonction_jit(AtomeFonction *ptr_fonction, int taille_argument);
+    void appel_ffi(DonnéesExécutionFonction::DonnéesFonctionExterne &données,
+                   void **pointeurs_arguments,
+                   int taille_argument,
+                   uint32_t taille_type_retour);
     void appel_fonction_compilatrice(AtomeFonction *ptr_fonction,
                                      RésultatInterprétation &résultat);
     void appel_fonction_intrinsèque(AtomeFonction *ptr_fonction);
@@ -0,0 +1,385 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * The Original Code is Copyright (C) 2026 Kévin Dietrich. */
+
+#include "machine_virtuelle_jit.hh"
+
+#include <cstring>
+#include <limits>
+
+#ifndef _MSC_VER
+#    include <sys/mman.h>
+#endif
+
+#include "arbre_syntaxique/noeud_expression.hh"
+
+#include "compilation/coulisse_asm.hh"
+#include "compilation/fichier_elf.hh"
+#include "compilation/typage.hh"
+
+#include "statistiques/statistiques.hh"
+
+#include "structures/ensemble.hh"
+#include "structures/pile.hh"
+
+#include "code_binaire.hh"
+#include "instructions.hh"
+#include "visite_instructions.hh"
+
+/* ------------------------------------------------------------------------- */
+/** \name Éligibilité des fonctions.
+ * \{ */
+
+static bool est_type_scalaire_supporté(Type const *type)
+{
+    return type->est_type_entier_naturel() || type->est_type_entier_relatif() ||
+           type->est_type_bool() || type->est_type_octet() || type->est_type_pointeur();
+}
+
+static bool est_opérande_supportée(Atome const *atome)
+{
+    switch (atome->genre_atome) {
+        case Atome::Genre::INSTRUCTION:
+        case Atome::Genre::CONSTANTE_ENTIÈRE:
+        case Atome::Genre::CONSTANTE_BOOLÉENNE:
+        case Atome::Genre::CONSTANTE_NULLE:
+        case Atome::Genre::CONSTANTE_CARACTÈRE:
+        {
+            return true;
+        }
+        default:
+        {
+            return false;
+        }
+    }
+}
+
+static bool est_instruction_supportée(Instruction *inst)
+{
+    switch (inst->genre) {
+        case GenreInstruction::ALLOCATION:
+        {
+            return est_type_scalaire_supporté(inst->comme_alloc()->donne_type_alloué());
+        }
+        case GenreInstruction::APPEL:
+        {
+            /* Les appels doivent être directs, l'appelé est vérifié par l'appelant. */
+            auto appel = inst->comme_appel();
+            if (!appel->appelé->est_fonction()) {
+                return false;
+            }
+
+            POUR (appel->args) {
+                if (!est_opérande_supportée(it)) {
+                    return false;
+                }
+            }
+
+            return appel->type->est_type_rien() || est_type_scalaire_supporté(appel->type);
+        }
+        case GenreInstruction::OPÉRATION_UNAIRE:
+        {
+            auto op = inst->comme_op_unaire()->op;
+            if (op != OpérateurUnaire::Genre::Négation &&
+                op != OpérateurUnaire::Genre::Négation_Binaire) {
+                return false;
+            }
+            break;
+        }
+        case GenreInstruction::BRANCHE:
+        case GenreInstruction::LABEL:
+        case GenreInstruction::INATTEIGNABLE:
+        {
+            return true;
+        }
+        case GenreInstruction::RETOUR:
+        case GenreInstruction::BRANCHE_CONDITION:
+        case GenreInstruction::CHARGE_MÉMOIRE:
+        case GenreInstruction::STOCKE_MÉMOIRE:
+        case GenreInstruction::OPÉRATION_BINAIRE:
+        case GenreInstruction::TRANSTYPE:
+        {
+            break;
+        }
+        default:
+        {
+            return false;
+        }
+    }
+
+    if (inst->type && !inst->type->est_type_rien() && !est_type_scalaire_supporté(inst->type)) {
+        return false;
+    }
+
+    auto résultat = true;
+    visite_opérandes_instruction(inst, [&](Atome const *opérande) {
+        if (!est_opérande_supportée(opérande) ||
+            !est_type_scalaire_supporté(opérande->type)) {
+            résultat = false;
+        }
+    });
+    return résultat;
+}
+
+static bool est_fonction_éligible(AtomeFonction const *fonction)
+{
+    if (fonction->est_externe || fonction->est_intrinsèque() || !fonction->données_exécution ||
+        fonction->ri_libérée) {
+        return false;
+    }
+
+    if (fonction->decl &&
+        (fonction->decl->possède_drapeau(DrapeauxNoeudFonction::EST_IPA_COMPILATRICE) ||
+         fonction->decl->possède_drapeau(DrapeauxNoeudFonction::EST_INITIALISATION_TYPE) ||
+         fonction->decl->possède_drapeau(DrapeauxNoeudFonction::EST_VARIADIQUE))) {
+        return false;
+    }
+
+    /* Le code natif ne peut notifier la MachineVirtuelle : n'en compilons pas si celle-ci doit
+     * être instrumentée. */
+    auto const &chunk = fonction->données_exécution->chunk;
+    if (chunk.émets_stats_ops || chunk.émets_vérification_branches ||
+        chunk.émets_notifications_empilage || chunk.émets_profilage) {
+        return false;
+    }
+
+    auto type_fonction = fonction->type->comme_type_fonction();
+    if (!type_fonction->type_sortie->est_type_rien() &&
+        !est_type_scalaire_supporté(type_fonction->type_sortie)) {
+        return false;
+    }
+
+    POUR (fonction->params_entrée) {
+        if (!est_type_scalaire_supporté(it->donne_type_alloué())) {
+            return false;
+        }
+    }
+
+    POUR (fonction->instructions) {
+        if (!est_instruction_supportée(it)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* Rassemble la fonction et toutes les fonctions qu'elle appelle transitivement, le code natif
+ * étant encodé en un seul bloc où les appels ne visent que des fonctions du bloc. */
+static bool rassemble_fonctions_à_compiler(AtomeFonction *racine,
+                                           kuri::tableau<AtomeFonction const *> &résultat)
+{
+    kuri::pile<AtomeFonction *> fonctions_à_visiter;
+    kuri::ensemble<AtomeFonction *> fonctions_visitées;
+
+    fonctions_à_visiter.empile(racine);
+
+    while (!fonctions_à_visiter.est_vide()) {
+        auto fonction = fonctions_à_visiter.dépile();
+
+        if (fonctions_visitées.possède(fonction)) {
+            continue;
+        }
+
+        if (!est_fonction_éligible(fonction)) {
+            return false;
+        }
+
+        résultat.ajoute(fonction);
+        fonctions_visitées.insère(fonction);
+
+        POUR (fonction->instructions) {
+            if (it->est_appel()) {
+                fonctions_à_visiter.empile(it->comme_appel()->appelé->comme_fonction());
+            }
+        }
+    }
+
+    return true;
+}
+
+/** \} */
+
+/* ------------------------------------------------------------------------- */
+/** \name CompilatriceJIT
+ * \{ */
+
+CompilatriceJIT::~CompilatriceJIT()
+{
+#ifndef _MSC_VER
+    POUR (m_régions) {
+        munmap(it.adresse, it.taille);
+    }
+#endif
+}
+
+bool CompilatriceJIT::compile(Typeuse &typeuse, AtomeFonction *fonction)
+{
+    if (compile_impl(typeuse, fonction)) {
+        return true;
+    }
+
+    fonction->données_exécution->compilation_jit_échouée = true;
+    m_nombre_échecs += 1;
+    return false;
+}
+
+static bool prépare_interface_appel(AtomeFonction const *fonction)
+{
+    auto &données_jit = fonction->données_exécution->données_jit;
+    données_jit.types_entrées.efface();
+    données_jit.types_entrées.réserve(fonction->params_entrée.taille());
+
+    POUR (fonction->params_entrée) {
+        données_jit.types_entrées.ajoute(convertis_type_ffi(it->donne_type_alloué()));
+    }
+
+    auto type_fonction = fonction->type->comme_type_fonction();
+    auto type_ffi_sortie = convertis_type_ffi(type_fonction->type_sortie);
+    auto nombre_arguments = static_cast<unsigned>(données_jit.types_entrées.taille());
+
+    auto status = ffi_prep_cif(&données_jit.cif,
+                               FFI_DEFAULT_ABI,
+                               nombre_arguments,
+                               type_ffi_sortie,
+                               données_jit.types_entrées.données());
+    if (status != FFI_OK) {
+        return false;
+    }
+
+    données_jit.prépare_appel_direct();
+    return true;
+}
+
+#ifndef _MSC_VER
+/* Résout les relocations des appels entre les fonctions, une fois le code copié à son adresse
+ * finale. Le code ne référençant ni globales ni données constantes, tous les symboles doivent
+ * être des fonctions de la section. */
+static bool résous_relocations(FichierELF &fichier, SectionELF const &section_text, char *code)
+{
+    POUR (section_text.relocations) {
+        auto const &symbole = fichier.donne_symbole(it.indice_symbole);
+        if (symbole.section != &section_text) {
+            return false;
+        }
+
+        auto const cible = int64_t(symbole.valeur) + it.addend;
+        auto const site = int64_t(it.décalage);
+
+        switch (it.type) {
+            case R_X86_64_PC32:
+            case R_X86_64_PLT32:
+            {
+                auto const valeur = cible - site;
+                if (valeur < std::numeric_limits<int32_t>::min() ||
+                    valeur > std::numeric_limits<int32_t>::max()) {
+                    return false;
+                }
+
+                auto const valeur32 = int32_t(valeur);
+                memcpy(code + site, &valeur32, sizeof(valeur32));
+                break;
+            }
+            case R_X86_64_64:
+            {
+                auto const valeur = reinterpret_cast<uint64_t>(code) + uint64_t(cible);
+                memcpy(code + site, &valeur, sizeof(valeur));
+                break;
+            }
+            default:
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+#endif
+
+bool CompilatriceJIT::compile_impl(Typeuse &typeuse, AtomeFonction *fonction)
+{
+#ifdef _MSC_VER
+    /* La coulisse ASM ne génère que du code pour la convention d'appel System V. */
+    static_cast<void>(typeuse);
+    static_cast<void>(fonction);
+    return false;
+#else
+    kuri::tableau<AtomeFonction const *> fonctions;
+    if (!rassemble_fonctions_à_compiler(fonction, fonctions)) {
+        return false;
+    }
+
+    auto fichier = FichierELF::crée_fichier_objet();
+    kuri::tableau<uint64_t> décalages_fonctions;
+    génère_code_machine_pour_jit(typeuse, fonctions, *fichier, décalages_fonctions);
+
+    auto const résultat = installe_code(*fichier, fonctions, décalages_fonctions);
+    mémoire::déloge("FichierELF", fichier);
+    return résultat && fonction->données_exécution->données_jit.ptr_fonction != nullptr;
+#endif
+}
+
+bool CompilatriceJIT::installe_code(FichierELF &fichier,
+                                    kuri::tableau_statique<AtomeFonction const *> fonctions,
+                                    kuri::tableau_statique<uint64_t> décalages_fonctions)
+{
+#ifdef _MSC_VER
+    static_cast<void>(fichier);
+    static_cast<void>(fonctions);
+    static_cast<void>(décalages_fonctions);
+    return false;
+#else
+    auto const &section_text = *fichier.donne_section(".text");
+    if (section_text.données.est_vide()) {
+        return false;
+    }
+
+    auto const taille = static_cast<size_t>(section_text.données.taille());
+    auto adresse = mmap(
+        nullptr, taille, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (adresse == MAP_FAILED) {
+        return false;
+    }
+
+    auto code = static_cast<char *>(adresse);
+    memcpy(code, section_text.données.données(), taille);
+
+    if (!résous_relocations(fichier, section_text, code) ||
+        mprotect(adresse, taille, PROT_READ | PROT_EXEC) != 0) {
+        munmap(adresse, taille);
+        return false;
+    }
+
+    m_régions.ajoute({adresse, taille});
+    m_taille_code += int64_t(taille);
+
+    POUR_INDICE (fonctions) {
+        auto données = it->données_exécution;
+        if (données->données_jit.ptr_fonction) {
+            /* Déjà compilée via un autre appelant. */
+            continue;
+        }
+
+        auto const décalage = décalages_fonctions[indice_it];
+        if (décalage >= taille || !prépare_interface_appel(it)) {
+            données->compilation_jit_échouée = true;
+            continue;
+        }
+
+        données->données_jit.ptr_fonction = reinterpret_cast<void (*)()>(code + décalage);
+        m_nombre_fonctions_compilées += 1;
+    }
+
+    return true;
+#endif
+}
+
+void CompilatriceJIT::rassemble_statistiques(Statistiques &stats) const
+{
+    stats.ajoute_mémoire_utilisée("Machine Virtuelle (JIT)",
+                                  m_taille_code + m_régions.taille_mémoire());
+    stats.nombre_fonctions_jit += m_nombre_fonctions_compilées;
+    stats.nombre_échecs_jit += m_nombre_échecs;
+}
+
+/** \} */
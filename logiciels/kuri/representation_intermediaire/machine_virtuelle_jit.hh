@@ -0,0 +1,72 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * The Original Code is Copyright (C) 2026 Kévin Dietrich. */
+
+#pragma once
+
+#include "structures/tableau.hh"
+
+#include "utilitaires/macros.hh"
+
+class FichierELF;
+struct AtomeFonction;
+struct Statistiques;
+struct Typeuse;
+
+/* ------------------------------------------------------------------------- */
+/** \name Compilation à la volée des fonctions des métaprogrammes.
+ *
+ * Les fonctions appelées souvent par la MachineVirtuelle sont compilées en code machine via la
+ * coulisse ASM, puis appelées directement via libffi au lieu d'être interprétées.
+ *
+ * Le code machine est encodé dans le processus par l'EncodeuseX64 de la coulisse ASM, sans
+ * assembleur externe, puis copié dans une région exécutable. Si la compilation d'une fonction
+ * échoue, celle-ci est marquée comme non compilable et continue d'être interprétée.
+ *
+ * Seules les fonctions n'opérant que sur des scalaires entiers, booléens ou pointeurs, et
+ * n'appelant que de telles fonctions, sont éligibles : la coulisse ASM ne supporte pas encore
+ * tout le langage, et le code natif n'a accès ni aux globales, ni aux données constantes, ni aux
+ * fonctions de la compilatrice de la MachineVirtuelle.
+ * \{ */
+
+struct CompilatriceJIT {
+    /* Nombre d'appels d'une fonction avant que celle-ci ne soit compilée. */
+    static constexpr int64_t SEUIL_APPELS = 1000;
+
+  private:
+    struct RégionExécutable {
+        void *adresse = nullptr;
+        size_t taille = 0;
+    };
+
+    kuri::tableau<RégionExécutable> m_régions{};
+
+    int64_t m_nombre_fonctions_compilées = 0;
+    int64_t m_nombre_échecs = 0;
+    int64_t m_taille_code = 0;
+
+  public:
+    CompilatriceJIT() = default;
+    ~CompilatriceJIT();
+
+    EMPECHE_COPIE(CompilatriceJIT);
+
+    /**
+     * Compile la fonction ainsi que les fonctions qu'elle appelle. Retourne vrai si le code natif
+     * de la fonction est disponible dans ses données d'exécution. En cas d'échec, la fonction est
+     * marquée afin de ne plus être considérée.
+     */
+    bool compile(Typeuse &typeuse, AtomeFonction *fonction);
+
+    void rassemble_statistiques(Statistiques &stats) const;
+
+  private:
+    bool compile_impl(Typeuse &typeuse, AtomeFonction *fonction);
+
+    /* Copie le code encodé dans une région exécutable, et renseigne le code natif des
+     * fonctions. */
+    bool installe_code(FichierELF &fichier,
+                       kuri::tableau_statique<AtomeFonction const *> fonctions,
+                       kuri::tableau_statique<uint64_t> décalages_fonctions);
+};
+
+/** \} */
@@ -5,14 +5,22 @@
 
 #include "arbre_syntaxique/noeud_expression.hh"
 
+#include "compilation/espace_de_travail.hh"
+#include "compilation/options.hh"
+
+#include "statistiques/statistiques.hh"
+
 #include "utilitaires/log.hh"
 
+#include "structures/ensemble.hh"
 #include "structures/table_hachage.hh"
 #include "structures/tablet.hh"
 
+#include "analyse.hh"
 #include "constructrice_ri.hh"
 #include "impression.hh"
 #include "instructions.hh"
+#include "visite_instructions.hh"
 
 /*
   À FAIRE(optimisations) :
@@ -20,7 +28,7 @@
   - Substitutrice, pour généraliser les substitions d'instructions
 
   À FAIRE(enlignage) :
-  - détecte les fonctions récursives, empêche leurs enlignages
+  - détecte les récursions mutuelles, seules les fonctions s'appelant directement sont ignorées
   - enlignage ascendant (considère la fonction enlignée d'abord) ou descendant (considère la
   fonction où enligner d'abord)
   - problème avec l'enlignage : il semblerait que les pointeurs ne soit pas correctement « enlignés
@@ -127,6 +135,9 @@ struct CopieuseInstruction {
             {
                 auto charge = inst->comme_charge();
                 auto source = copie_atome(charge->chargée);
+                /* Chaque chargement est copié tel quel : il ne doit pas être dédupliqué avec
+                 * un chargement de l'appelante ou d'une autre fonction enlignée. */
+                constructrice.invalide_charges();
                 return constructrice.crée_charge_mem(inst->site, source);
             }
             case GenreInstruction::STOCKE_MÉMOIRE:
@@ -207,8 +218,10 @@ struct CopieuseInstruction {
             }
             case GenreInstruction::LABEL:
             {
+                /* Le label peut être référencé par une branche avant sa définition : il est
+                 * inséré par performe_enlignage. */
                 auto label = inst->comme_label();
-                auto n_label = constructrice.crée_label(inst->site);
+                auto n_label = constructrice.réserve_label(inst->site);
                 n_label->id = label->id;
                 return n_label;
             }
@@ -223,11 +236,16 @@ struct CopieuseInstruction {
             case GenreInstruction::SÉLECTION:
             {
                 auto const sélection = inst->comme_sélection();
+                /* Copie les opérandes avant de créer la sélection, afin qu'elles la précèdent
+                 * dans la fonction. */
+                auto condition = copie_atome(sélection->condition);
+                auto si_vrai = copie_atome(sélection->si_vrai);
+                auto si_faux = copie_atome(sélection->si_faux);
                 auto nouvelle_sélection = constructrice.crée_sélection(inst->site, false);
                 nouvelle_sélection->type = sélection->type;
-                nouvelle_sélection->condition = sélection->condition;
-                nouvelle_sélection->si_vrai = sélection->si_vrai;
-                nouvelle_sélection->si_faux = sélection->si_faux;
+                nouvelle_sélection->condition = condition;
+                nouvelle_sélection->si_vrai = si_vrai;
+                nouvelle_sélection->si_faux = si_faux;
                 return nouvelle_sélection;
             }
             case GenreInstruction::COPIE_MÉMOIRE:
@@ -246,6 +264,44 @@ struct CopieuseInstruction {
     }
 };
 
+/* Retourne vrai si le paramètre n'est que chargé dans la fonction. Il peut alors être remplacé
+ * par l'adresse d'où l'argument fut chargé, sinon les écritures de la fonction appelée dans le
+ * paramètre modifieraient la variable de l'appelante. */
+static bool paramètre_est_seulement_chargé(AtomeFonction const *fonction,
+                                           Atome const *paramètre)
+{
+    POUR (fonction->instructions) {
+        if (it->est_charge()) {
+            continue;
+        }
+
+        auto est_utilisé = false;
+        visite_opérandes_instruction(
+            it, [&](Atome const *opérande) { est_utilisé |= (opérande == paramètre); });
+
+        if (est_utilisé) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool paramètre_est_utilisé(AtomeFonction const *fonction, Atome const *paramètre)
+{
+    POUR (fonction->instructions) {
+        auto est_utilisé = false;
+        visite_opérandes_instruction(
+            it, [&](Atome const *opérande) { est_utilisé |= (opérande == paramètre); });
+
+        if (est_utilisé) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 void performe_enlignage(ConstructriceRI &constructrice,
                         AtomeFonction *fonction_appelée,
                         kuri::tableau<Atome *, int> const &arguments,
@@ -259,13 +315,19 @@ void performe_enlignage(ConstructriceRI &constructrice,
         auto paramètre = fonction_appelée->params_entrée[i];
         auto atome = arguments[i];
 
-        if (est_charge(atome)) {
+        if (!paramètre_est_utilisé(fonction_appelée, paramètre)) {
+            /* L'argument sera supprimé s'il n'est plus utilisé. */
+            continue;
+        }
+
+        if (est_charge(atome) && paramètre_est_seulement_chargé(fonction_appelée, paramètre)) {
             atome = atome->comme_instruction()->comme_charge()->chargée;
             copieuse.ajoute_substitution(paramètre, atome);
         }
         else {
             /* Crée une temporaire. */
-            auto alloc = constructrice.crée_allocation(nullptr, atome->type, nullptr);
+            auto alloc = constructrice.crée_allocation(
+                nullptr, paramètre->donne_type_alloué(), nullptr);
             constructrice.crée_stocke_mem(nullptr, alloc, atome);
             copieuse.ajoute_substitution(paramètre, alloc);
         }
@@ -280,13 +342,14 @@ void performe_enlignage(ConstructriceRI &constructrice,
 
         if (it->est_label()) {
             auto label = it->comme_label();
-            /* Ignore le label d'entrée de la fonction. */
-            if (label->id == 0) {
+            /* Ignore le label d'entrée de la fonction, sauf s'il est la cible d'une branche. */
+            if (label->id == 0 && !label->possède_drapeau(DrapeauxAtome::EST_UTILISÉ)) {
                 continue;
             }
 
             auto n_label = copieuse.copie_atome(it)->comme_instruction()->comme_label();
             n_label->id = nombre_labels++;
+            constructrice.insère_label(n_label);
             continue;
         }
 
@@ -497,48 +560,248 @@ struct Substitutrice {
 
 #undef DEBOGUE_ENLIGNAGE
 
-// À FAIRE : définis de bonnes heuristiques pour l'enlignage
-static bool est_candidate_pour_enlignage(AtomeFonction *fonction)
+BudgetEnlignage donne_budget_enlignage(NiveauOptimisation niveau)
 {
-    dbg() << "candidate pour enlignage : " << fonction->nom;
-
-    /* appel d'une fonction externe */
-    if (fonction->instructions.taille() == 0) {
-        dbg() << "-- ignore la candidate car il n'y a pas d'instructions...";
-        return false;
+    auto résultat = BudgetEnlignage();
+
+    switch (niveau) {
+        case NiveauOptimisation::AUCUN:
+        case NiveauOptimisation::O0:
+        case NiveauOptimisation::O1:
+        case NiveauOptimisation::O2:
+        {
+            break;
+        }
+        case NiveauOptimisation::Os:
+        case NiveauOptimisation::Oz:
+        {
+            /* N'enligne que les fonctions plus petites qu'un appel et ses arguments. */
+            résultat.coût_maximal_appelée = 8;
+            résultat.profondeur_maximale = 1;
+            résultat.coût_maximal_appelante = 256;
+            break;
+        }
+        case NiveauOptimisation::O3:
+        {
+            résultat.coût_maximal_appelée = 64;
+            résultat.profondeur_maximale = 4;
+            résultat.coût_maximal_appelante = 4096;
+            break;
+        }
     }
 
-    if (fonction->instructions.taille() < 32) {
-        return true;
+    return résultat;
+}
+
+/* Le coût d'une fonction pour l'enlignage : son nombre d'instructions racines, les autres
+ * instructions étant copiées avec celles-ci. */
+static int donne_coût_enlignage(AtomeFonction const *fonction)
+{
+    auto résultat = 0;
+    POUR (fonction->instructions) {
+        résultat += instruction_est_racine(it);
     }
+    return résultat;
+}
 
-    if (fonction->decl) {
-        if (fonction->decl->possède_drapeau(DrapeauxNoeudFonction::FORCE_ENLIGNE)) {
+static bool appelle_fonction(AtomeFonction const *fonction, AtomeFonction const *appelée)
+{
+    POUR (fonction->instructions) {
+        if (it->est_appel() && it->comme_appel()->appelé == appelée) {
             return true;
         }
+    }
+    return false;
+}
 
-        if (fonction->decl->possède_drapeau(DrapeauxNoeudFonction::FORCE_HORSLIGNE)) {
-            dbg() << "-- ignore la candidate car nous forçons un horslignage...";
-            return false;
+enum class DécisionEnlignage {
+    ENLIGNE,
+    REFUS_EXTERNE,
+    REFUS_HORSLIGNE,
+    REFUS_RÉCURSION,
+    REFUS_COÛT,
+    REFUS_BUDGET,
+};
+
+struct InfosAppeléeEnlignage {
+    int coût = 0;
+    bool est_récursive = false;
+};
+
+struct ModèleCoûtEnlignage {
+  private:
+    BudgetEnlignage const &m_budget;
+    AtomeFonction const *m_appelante = nullptr;
+    kuri::table_hachage<AtomeFonction const *, InfosAppeléeEnlignage> m_infos_appelées{
+        "Infos appelées enlignage"};
+
+  public:
+    /* Le coût de la fonction appelante, augmenté à chaque enlignage. */
+    int coût_appelante = 0;
+
+    ModèleCoûtEnlignage(BudgetEnlignage const &budget, AtomeFonction const *appelante)
+        : m_budget(budget), m_appelante(appelante),
+          coût_appelante(donne_coût_enlignage(appelante))
+    {
+    }
+
+    EMPECHE_COPIE(ModèleCoûtEnlignage);
+
+    InfosAppeléeEnlignage donne_infos(AtomeFonction const *appelée)
+    {
+        auto infos = m_infos_appelées.trouve_pointeur(appelée);
+        if (infos) {
+            return *infos;
         }
+
+        auto résultat = InfosAppeléeEnlignage();
+        résultat.coût = donne_coût_enlignage(appelée);
+        résultat.est_récursive = appelle_fonction(appelée, appelée);
+        m_infos_appelées.insère(appelée, résultat);
+        return résultat;
     }
 
-    dbg() << "-- ignore la candidate car il y a trop d'instructions...";
-    return false;
+    DécisionEnlignage détermine_décision(AtomeFonction const *appelée)
+    {
+        /* Appel d'une fonction externe. */
+        if (appelée->est_externe || appelée->instructions.est_vide()) {
+            return DécisionEnlignage::REFUS_EXTERNE;
+        }
+
+        if (appelée == m_appelante) {
+            return DécisionEnlignage::REFUS_RÉCURSION;
+        }
+
+        if (appelée->decl &&
+            appelée->decl->possède_drapeau(DrapeauxNoeudFonction::FORCE_HORSLIGNE)) {
+            return DécisionEnlignage::REFUS_HORSLIGNE;
+        }
+
+        auto const infos = donne_infos(appelée);
+
+        /* Une fonction récursive serait enlignée en elle-même jusqu'à épuisement du budget. */
+        if (infos.est_récursive) {
+            return DécisionEnlignage::REFUS_RÉCURSION;
+        }
+
+        if (appelée->enligne) {
+            return DécisionEnlignage::ENLIGNE;
+        }
+
+        if (infos.coût > m_budget.coût_maximal_appelée) {
+            return DécisionEnlignage::REFUS_COÛT;
+        }
+
+        if (coût_appelante + infos.coût > m_budget.coût_maximal_appelante) {
+            return DécisionEnlignage::REFUS_BUDGET;
+        }
+
+        return DécisionEnlignage::ENLIGNE;
+    }
+};
+
+static void comptabilise_décision(StatistiquesEnlignage *stats, DécisionEnlignage décision)
+{
+    if (!stats) {
+        return;
+    }
+
+    stats->sites_considérés += 1;
+
+    switch (décision) {
+        case DécisionEnlignage::ENLIGNE:
+        {
+            stats->sites_enlignés += 1;
+            break;
+        }
+        case DécisionEnlignage::REFUS_EXTERNE:
+        {
+            stats->refus_externe += 1;
+            break;
+        }
+        case DécisionEnlignage::REFUS_HORSLIGNE:
+        {
+            stats->refus_horsligne += 1;
+            break;
+        }
+        case DécisionEnlignage::REFUS_RÉCURSION:
+        {
+            stats->refus_récursion += 1;
+            break;
+        }
+        case DécisionEnlignage::REFUS_COÛT:
+        {
+            stats->refus_coût += 1;
+            break;
+        }
+        case DécisionEnlignage::REFUS_BUDGET:
+        {
+            stats->refus_budget += 1;
+            break;
+        }
+    }
 }
 
-bool enligne_fonctions(ConstructriceRI &constructrice, AtomeFonction *atome_fonc)
+/* Supprime les instructions sans effets secondaires qui ne sont plus utilisées, par exemple les
+ * chargements des arguments passés à des paramètres inutilisés des fonctions enlignées. Les
+ * coulisses n'utilisent pas ces instructions, mais les paramètres y étant référencés seraient
+ * considérés comme utilisés. */
+static void supprime_instructions_non_utilisées(AtomeFonction *atome_fonc)
+{
+    auto utilisés = kuri::ensemble<Atome const *>();
+    auto nombre_instructions = 0;
+
+    /* Les valeurs sont définies avant d'être utilisées, donc un seul parcours en sens inverse
+     * suffit pour supprimer les chaines d'instructions inutilisées. */
+    for (auto i = atome_fonc->instructions.taille() - 1; i >= 0; --i) {
+        auto inst = atome_fonc->instructions[i];
+
+        if (!instruction_est_racine(inst) && !inst->est_alloc() && !utilisés.possède(inst)) {
+            atome_fonc->instructions[i] = nullptr;
+            continue;
+        }
+
+        nombre_instructions += 1;
+        visite_opérandes_instruction(inst, [&](Atome *atome) { utilisés.insère(atome); });
+    }
+
+    if (nombre_instructions == atome_fonc->instructions.taille()) {
+        return;
+    }
+
+    auto curseur = 0;
+    POUR (atome_fonc->instructions) {
+        if (it) {
+            atome_fonc->instructions[curseur++] = it;
+        }
+    }
+    atome_fonc->instructions.redimensionne(curseur);
+}
+
+bool enligne_fonctions(ConstructriceRI &constructrice,
+                       AtomeFonction *atome_fonc,
+                       BudgetEnlignage const &budget,
+                       StatistiquesEnlignage *stats)
 {
 #ifdef DEBOGUE_ENLIGNAGE
     dbg() << "===== avant enlignage =====\n" << imprime_fonction(atome_fonc);
 #endif
 
     auto substitutrice = Substitutrice();
+    auto modèle_coût = ModèleCoûtEnlignage(budget, atome_fonc);
     auto nombre_labels = 0;
     auto nombre_fonctions_enlignées = 0;
+    /* Vrai si la dernière fonction enlignée ne retourne jamais : les instructions suivant son
+     * appel sont inatteignables jusqu'au prochain label. Les allocations sont gardées car elles
+     * peuvent être utilisées dans d'autres blocs. */
+    auto ignore_code_mort = false;
 
+    /* Les identifiants des labels ne sont pas forcément contigus, les nouveaux labels doivent
+     * suivre le plus grand. */
     POUR (atome_fonc->instructions) {
-        nombre_labels += it->genre == GenreInstruction::LABEL;
+        if (it->est_label()) {
+            nombre_labels = std::max(nombre_labels, it->comme_label()->id + 1);
+        }
     }
 
     auto anciennes_instructions = atome_fonc->instructions;
@@ -547,6 +810,17 @@ bool enligne_fonctions(ConstructriceRI &constructrice, AtomeFonction *atome_fonc
     constructrice.définis_fonction_courante(atome_fonc);
 
     POUR (anciennes_instructions) {
+        if (ignore_code_mort) {
+            if (est_allocation(it)) {
+                atome_fonc->instructions.ajoute(it);
+                continue;
+            }
+            if (!it->est_label()) {
+                continue;
+            }
+            ignore_code_mort = false;
+        }
+
         if (it->genre != GenreInstruction::APPEL) {
             atome_fonc->instructions.ajoute(substitutrice.instruction_substituée(it));
             continue;
@@ -561,13 +835,19 @@ bool enligne_fonctions(ConstructriceRI &constructrice, AtomeFonction *atome_fonc
         }
 
         auto atome_fonc_appelée = appelé->comme_fonction();
+        auto décision = modèle_coût.détermine_décision(atome_fonc_appelée);
+        comptabilise_décision(stats, décision);
 
-        if (!est_candidate_pour_enlignage(atome_fonc_appelée)) {
+        if (décision != DécisionEnlignage::ENLIGNE) {
             atome_fonc->instructions.ajoute(substitutrice.instruction_substituée(it));
             continue;
         }
 
+        /* Les arguments peuvent référencer des appels déjà enlignés. */
+        substitutrice.instruction_substituée(appel);
+
         atome_fonc->instructions.réserve_delta(atome_fonc_appelée->instructions.taille() + 1);
+        auto const nombre_instructions_avant = atome_fonc->instructions.taille();
 
         auto adresse_retour = static_cast<InstructionAllocation *>(nullptr);
 
@@ -585,8 +865,21 @@ bool enligne_fonctions(ConstructriceRI &constructrice, AtomeFonction *atome_fonc
                            label_post,
                            adresse_retour);
         nombre_fonctions_enlignées += 1;
+        modèle_coût.coût_appelante += modèle_coût.donne_infos(atome_fonc_appelée).coût;
+
+        if (stats) {
+            stats->instructions_copiées += atome_fonc->instructions.taille() -
+                                           nombre_instructions_avant;
+        }
+
+        /* Aucune branche vers le label si la fonction appelée ne retourne jamais (par exemple si
+         * elle panique). */
+        if (!label_post->possède_drapeau(DrapeauxAtome::EST_UTILISÉ)) {
+            ignore_code_mort = true;
+            continue;
+        }
 
-        atome_fonc->instructions.ajoute(label_post);
+        constructrice.insère_label(label_post);
 
         if (adresse_retour) {
             auto charge = constructrice.crée_charge_mem(appel->site, adresse_retour, false);
@@ -594,6 +887,15 @@ bool enligne_fonctions(ConstructriceRI &constructrice, AtomeFonction *atome_fonc
         }
     }
 
+    /* Les instructions créées ensuite par la constructrice n'appartiennent pas à cette fonction,
+     * et ne doivent pas être allouées dans son arène. */
+    constructrice.définis_fonction_courante(nullptr);
+
+    if (nombre_fonctions_enlignées != 0) {
+        supprime_instructions_non_utilisées(atome_fonc);
+        marque_paramètres_utilisés(*atome_fonc);
+    }
+
 #ifdef DEBOGUE_ENLIGNAGE
     dbg() << "===== après enlignage =====\n" << imprime_fonction(atome_fonc);
 #endif
@@ -601,10 +903,18 @@ bool enligne_fonctions(ConstructriceRI &constructrice, AtomeFonction *atome_fonc
     return nombre_fonctions_enlignées != 0;
 }
 
-void optimise_code(EspaceDeTravail & /*espace*/,
+void optimise_code(EspaceDeTravail &espace,
                    ConstructriceRI &constructrice,
-                   AtomeFonction *atome_fonc)
+                   AtomeFonction *atome_fonc,
+                   StatistiquesEnlignage *stats)
 {
-    // while (enligne_fonctions(constructrice, atome_fonc)) {}
-    enligne_fonctions(constructrice, atome_fonc);
+    auto const budget = donne_budget_enlignage(espace.options.niveau_optimisation);
+
+    /* Chaque passe enligne les appels copiés depuis les fonctions enlignées lors de la
+     * précédente ; la profondeur d'enlignage est donc bornée par le nombre de passes. */
+    for (auto profondeur = 0; profondeur < budget.profondeur_maximale; ++profondeur) {
+        if (!enligne_fonctions(constructrice, atome_fonc, budget, stats)) {
+            break;
+        }
+    }
 }
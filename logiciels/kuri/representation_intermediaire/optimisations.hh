@@ -6,7 +6,32 @@
 struct ConstructriceRI;
 struct EspaceDeTravail;
 struct AtomeFonction;
+struct StatistiquesEnlignage;
+
+enum class NiveauOptimisation : int;
+
+/* Budget de l'enlignage. Le coût d'une fonction est son nombre d'instructions racines. */
+struct BudgetEnlignage {
+    /* Coût maximal d'une fonction appelée pour qu'elle soit enlignée, sauf si elle est marquée
+     * par #enligne. */
+    int coût_maximal_appelée = 32;
+    /* Nombre maximal de passes d'enlignage sur une fonction. Chaque passe enligne les appels
+     * apparus lors de la précédente. */
+    int profondeur_maximale = 3;
+    /* Coût au-delà duquel plus rien n'est enligné dans la fonction appelante, sauf les fonctions
+     * marquées par #enligne. */
+    int coût_maximal_appelante = 1024;
+};
+
+BudgetEnlignage donne_budget_enlignage(NiveauOptimisation niveau);
+
+/* Enligne les appels de la fonction selon le budget. Retourne vrai si un appel fut enligné. */
+bool enligne_fonctions(ConstructriceRI &constructrice,
+                       AtomeFonction *atome_fonc,
+                       BudgetEnlignage const &budget,
+                       StatistiquesEnlignage *stats);
 
 void optimise_code(EspaceDeTravail &espace,
                    ConstructriceRI &constructrice,
-                   AtomeFonction *atome_fonc);
+                   AtomeFonction *atome_fonc,
+                   StatistiquesEnlignage *stats = nullptr);
@@ -0,0 +1,61 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * The Original Code is Copyright (C) 2026 Kévin Dietrich. */
+
+#pragma once
+
+#include <cstdint>
+
+#include "compilation/operateurs.hh"
+
+#include "structures/tableau_statique.hh"
+
+/* ------------------------------------------------------------------------- */
+/** \name Règles de réécriture.
+ *
+ * Les règles de optimisations.txt sont compilées par genere_regles_optimisation en tables de
+ * motifs (regles_optimisation.cc), groupées selon l'opérateur à la racine du motif.
+ *
+ * Les motifs et remplacements sont aplatis en ordre préfixe : un noeud OPÉRATEUR est suivi de
+ * son opérande gauche puis de son opérande droite.
+ * \{ */
+
+enum class GenreNoeudMotif : uint8_t {
+    /* Un opérateur binaire, suivi de ses deux opérandes. */
+    OPÉRATEUR,
+    /* Une valeur quelconque, liée lors de sa première occurrence dans le motif ; les occurrences
+     * suivantes doivent être la même valeur. */
+    VARIABLE,
+    /* Une constante entière littérale. */
+    CONSTANTE,
+    /* Une constante entière quelconque (@N), liée comme une variable. */
+    CONSTANTE_LIÉE,
+    /* Une constante calculée depuis une constante liée : %(N - 1). N'apparaît que dans les
+     * remplacements. */
+    CONSTANTE_CALCULÉE,
+};
+
+struct NoeudMotif {
+    GenreNoeudMotif genre{};
+    /* L'opérateur pour OPÉRATEUR, ou l'opération du calcul pour CONSTANTE_CALCULÉE. */
+    OpérateurBinaire::Genre op{};
+    /* L'indice de la liaison pour VARIABLE, CONSTANTE_LIÉE et CONSTANTE_CALCULÉE. */
+    int8_t liaison = 0;
+    /* La valeur de CONSTANTE, ou l'opérande droite du calcul de CONSTANTE_CALCULÉE. */
+    int64_t valeur = 0;
+};
+
+struct RègleRéécriture {
+    /* Le texte de la règle, pour le débogage. */
+    const char *texte = nullptr;
+    NoeudMotif const *motif = nullptr;
+    int taille_motif = 0;
+    NoeudMotif const *remplacement = nullptr;
+    int taille_remplacement = 0;
+    int nombre_liaisons = 0;
+};
+
+/* Retourne les règles dont le motif a l'opérateur donné à sa racine. */
+kuri::tableau_statique<RègleRéécriture const> donne_règles_réécriture(
+    OpérateurBinaire::Genre op);
+
+/** \} */
@@ -82,6 +82,21 @@ void imprime_stats(Statistiques const &stats, kuri::chrono::compte_seconde débu
         {"- Nombre Lexèmes", formatte_nombre(stats.stats_fichiers.totaux.nombre_lexèmes), ""});
     tableau.ajoute_ligne(
         {"- Nombre Noeuds", formatte_nombre(stats.stats_arbre.totaux.compte), ""});
+    tableau.ajoute_ligne({"- Cache Lexèmes (chargés)",
+                          formatte_nombre(stats.nombre_fichiers_cache_lexèmes_chargés),
+                          ""});
+    tableau.ajoute_ligne({"- Cache Lexèmes (ratés)",
+                          formatte_nombre(stats.nombre_fichiers_cache_lexèmes_ratés),
+                          ""});
+    tableau.ajoute_ligne({"- Cache Lexèmes (sauvegardés)",
+                          formatte_nombre(stats.nombre_fichiers_cache_lexèmes_sauvegardés),
+                          ""});
+    tableau.ajoute_ligne({"- Fichiers Partagés (tampons)",
+                          formatte_nombre(stats.nombre_fichiers_tampons_partagés),
+                          ""});
+    tableau.ajoute_ligne({"- Fichiers Partagés (lexèmes)",
+                          formatte_nombre(stats.nombre_fichiers_lexèmes_partagés),
+                          ""});
     tableau.ajoute_ligne({"- Nombre Noeuds Déps",
                           formatte_nombre(stats.stats_graphe_dépendance.totaux.compte),
                           ""});
@@ -101,12 +116,54 @@ void imprime_stats(Statistiques const &stats, kuri::chrono::compte_seconde débu
              formatte_nombre(calc_pourcentage(double(it.quantité), double(mémoire_consommee)))});
     }
 
+    tableau.ajoute_ligne({"Arènes RI", "", ""});
+    tableau.ajoute_ligne({"- Actives", formatte_nombre(stats.nombre_arènes_ri), ""});
+    tableau.ajoute_ligne(
+        {"- Plus grande", formatte_nombre(stats.plus_grande_arène_ri), "o"});
+    tableau.ajoute_ligne({"- Libérées", formatte_nombre(stats.nombre_arènes_ri_libérées), ""});
+    tableau.ajoute_ligne(
+        {"- Mémoire libérée", formatte_nombre(stats.mémoire_arènes_ri_libérée), "o"});
+
     tableau.ajoute_ligne(
         {"Nombre allocations", formatte_nombre(mémoire::nombre_allocations()), ""});
     tableau.ajoute_ligne(
         {"Nombre métaprogrammes", formatte_nombre(stats.nombre_métaprogrammes_exécutés), ""});
     tableau.ajoute_ligne(
         {"Instructions exécutées", formatte_nombre(stats.instructions_exécutées), ""});
+    tableau.ajoute_ligne(
+        {"- Fonctions JIT (compilées)", formatte_nombre(stats.nombre_fonctions_jit), ""});
+    tableau.ajoute_ligne(
+        {"- Fonctions JIT (échecs)", formatte_nombre(stats.nombre_échecs_jit), ""});
+
+    auto const &enlignage = stats.stats_enlignage;
+    tableau.ajoute_ligne({"Enlignage", "", ""});
+    tableau.ajoute_ligne(
+        {"- Appels considérés", formatte_nombre(enlignage.sites_considérés), ""});
+    tableau.ajoute_ligne({"- Appels enlignés",
+                          formatte_nombre(enlignage.sites_enlignés),
+                          "",
+                          formatte_nombre(calc_pourcentage(double(enlignage.sites_enlignés),
+                                                           double(enlignage.sites_considérés)))});
+    tableau.ajoute_ligne(
+        {"- Instructions copiées", formatte_nombre(enlignage.instructions_copiées), ""});
+    tableau.ajoute_ligne({"- Refus (externe)", formatte_nombre(enlignage.refus_externe), ""});
+    tableau.ajoute_ligne({"- Refus (horsligne)", formatte_nombre(enlignage.refus_horsligne), ""});
+    tableau.ajoute_ligne({"- Refus (récursion)", formatte_nombre(enlignage.refus_récursion), ""});
+    tableau.ajoute_ligne({"- Refus (coût)", formatte_nombre(enlignage.refus_coût), ""});
+    tableau.ajoute_ligne({"- Refus (budget)", formatte_nombre(enlignage.refus_budget), ""});
+
+    auto const &totaux_files = stats.stats_files_tâches.totaux;
+    tableau.ajoute_ligne({"Ordonnanceuse", "", ""});
+    tableau.ajoute_ligne({"- Tâches prises", formatte_nombre(totaux_files.tâches_prises), ""});
+    tableau.ajoute_ligne({"- Tâches volées",
+                          formatte_nombre(totaux_files.tâches_volées),
+                          "",
+                          formatte_nombre(calc_pourcentage(double(totaux_files.tâches_volées),
+                                                           double(totaux_files.tâches_prises)))});
+    tableau.ajoute_ligne({"- Contentions", formatte_nombre(totaux_files.contentions), ""});
+    tableau.ajoute_ligne({"- Temps de sommeil",
+                          formatte_nombre(totaux_files.temps_passé_à_dormir),
+                          "ms"});
 
     tableau.ajoute_ligne({"Temps Scène",
                           formatte_nombre(temps_scène * 1000.0),
@@ -296,6 +353,27 @@ static void imprime_stats_programme(EntréesStats<EntréeProgramme> const &stats
     imprime_tableau(tableau);
 }
 
+static void imprime_stats_files_tâches(EntréesStats<EntréeFileTâches> const &stats)
+{
+    std::sort(stats.entrées.begin(),
+              stats.entrées.end(),
+              [](const EntréeFileTâches &a, const EntréeFileTâches &b) {
+                  return a.tacheronne < b.tacheronne;
+              });
+
+    auto tableau = Tabuleuse({"Tacheronne", "Prises", "Volées", "Contentions", "Sommeil (ms)"});
+
+    POUR (stats.entrées) {
+        tableau.ajoute_ligne({formatte_nombre(it.tacheronne),
+                              formatte_nombre(it.tâches_prises),
+                              formatte_nombre(it.tâches_volées),
+                              formatte_nombre(it.contentions),
+                              formatte_nombre(it.temps_passé_à_dormir)});
+    }
+
+    imprime_tableau(tableau);
+}
+
 void imprime_stats_détaillées(Statistiques const &stats)
 {
     std::cout << "Arbre Syntaxique :\n";
@@ -312,8 +390,12 @@ void imprime_stats_détaillées(Statistiques const &stats)
     imprime_stats_tableaux(stats.stats_tableaux);
     std::cout << "Gaspillage :\n";
     imprime_stats_tableau(stats.stats_gaspillage);
+    std::cout << "Monomorphisations :\n";
+    imprime_stats_tableau(stats.stats_monomorphisations);
     std::cout << "Programmes :\n";
     imprime_stats_programme(stats.stats_programmes);
+    std::cout << "Files Tâches :\n";
+    imprime_stats_files_tâches(stats.stats_files_tâches);
 }
 
 static void imprime_stats_temps(EntréesStats<EntréeTemps> const &stats)
@@ -353,6 +435,11 @@ void StatistiquesGestion::imprime_stats()
     imprime_stats_temps(stats);
 }
 
+void StatistiquesFSAU::imprime_stats()
+{
+    imprime_stats_temps(stats);
+}
+
 const kuri::tableau<MémoireUtilisée> &Statistiques::donne_mémoire_utilisée_pour_impression() const
 {
     ajoute_mémoire_utilisée("Graphe", stats_graphe_dépendance.totaux.mémoire);
@@ -156,6 +156,28 @@ struct EntréeProgramme {
     }
 };
 
+struct EntréeFileTâches {
+    int64_t tacheronne = 0;
+    int64_t tâches_prises = 0;
+    int64_t tâches_volées = 0;
+    int64_t contentions = 0;
+    double temps_passé_à_dormir = 0.0;
+
+    EntréeFileTâches &operator+=(EntréeFileTâches const &autre)
+    {
+        tâches_prises += autre.tâches_prises;
+        tâches_volées += autre.tâches_volées;
+        contentions += autre.contentions;
+        temps_passé_à_dormir += autre.temps_passé_à_dormir;
+        return *this;
+    }
+
+    bool peut_fusionner_avec(EntréeFileTâches const &autre) const
+    {
+        return autre.tacheronne == tacheronne;
+    }
+};
+
 template <TypeEntréesStats T>
 struct EntréesStats {
     kuri::chaine_statique nom{};
@@ -215,6 +237,36 @@ using StatistiquesRI = EntréesStats<EntréeNombreMémoire>;
 using StatistiquesTableaux = EntréesStats<EntréeTailleTableau>;
 using StatistiquesProgrammes = EntréesStats<EntréeProgramme>;
 using StatistiquesGaspillage = EntréesStats<EntréeNombreMémoire>;
+using StatistiquesFilesTâches = EntréesStats<EntréeFileTâches>;
+/* Nombre de monomorphisations par déclaration polymorphique. */
+using StatistiquesMonomorphisations = EntréesStats<EntréeNombreMémoire>;
+
+/* Compteurs des sites d'appel considérés par l'enlignage de la RI. */
+struct StatistiquesEnlignage {
+    int64_t sites_considérés = 0;
+    int64_t sites_enlignés = 0;
+    int64_t instructions_copiées = 0;
+
+    /* Les raisons pour lesquelles des sites ne furent pas enlignés. */
+    int64_t refus_externe = 0;
+    int64_t refus_horsligne = 0;
+    int64_t refus_récursion = 0;
+    int64_t refus_coût = 0;
+    int64_t refus_budget = 0;
+
+    StatistiquesEnlignage &operator+=(StatistiquesEnlignage const &autre)
+    {
+        sites_considérés += autre.sites_considérés;
+        sites_enlignés += autre.sites_enlignés;
+        instructions_copiées += autre.instructions_copiées;
+        refus_externe += autre.refus_externe;
+        refus_horsligne += autre.refus_horsligne;
+        refus_récursion += autre.refus_récursion;
+        refus_coût += autre.refus_coût;
+        refus_budget += autre.refus_budget;
+        return *this;
+    }
+};
 
 struct MémoireUtilisée {
     kuri::chaine_statique catégorie{};
@@ -230,6 +282,17 @@ struct Statistiques {
     int64_t nombre_identifiants = 0l;
     int64_t nombre_métaprogrammes_exécutés = 0l;
     int64_t instructions_exécutées = 0l;
+    int64_t nombre_fichiers_cache_lexèmes_chargés = 0l;
+    int64_t nombre_fichiers_cache_lexèmes_ratés = 0l;
+    int64_t nombre_fichiers_cache_lexèmes_sauvegardés = 0l;
+    int64_t nombre_fichiers_tampons_partagés = 0l;
+    int64_t nombre_fichiers_lexèmes_partagés = 0l;
+    int64_t nombre_fonctions_jit = 0l;
+    int64_t nombre_arènes_ri = 0l;
+    int64_t nombre_arènes_ri_libérées = 0l;
+    int64_t mémoire_arènes_ri_libérée = 0l;
+    int64_t plus_grande_arène_ri = 0l;
+    int64_t nombre_échecs_jit = 0l;
     double temps_génération_code = 0.0;
     double temps_fichier_objet = 0.0;
     double temps_exécutable = 0.0;
@@ -252,6 +315,9 @@ struct Statistiques {
     StatistiquesTableaux stats_tableaux{"Tableaux"};
     StatistiquesProgrammes stats_programmes{"Programmes"};
     StatistiquesGaspillage stats_gaspillage{"Gaspillage"};
+    StatistiquesFilesTâches stats_files_tâches{"Files Tâches"};
+    StatistiquesMonomorphisations stats_monomorphisations{"Monomorphisations"};
+    StatistiquesEnlignage stats_enlignage{};
 
     kuri::tableau<MémoireUtilisée> const &donne_mémoire_utilisée_pour_impression() const;
 
@@ -372,6 +438,27 @@ struct StatistiquesGestion {
     void imprime_stats();
 };
 
+#define ENTREES_POUR_PASSES_FSAU(OP)                                                              \
+    OP(PASSES_FSAU__CONSTRUCTION, "construction")                                                 \
+    OP(PASSES_FSAU__BRANCHES_INUTILES, "branches inutiles")                                       \
+    OP(PASSES_FSAU__PROPAGATION_CONSTANTES, "propagation constantes")                             \
+    OP(PASSES_FSAU__SIMPLIFICATIONS, "simplifications")                                           \
+    OP(PASSES_FSAU__RÈGLES_RÉÉCRITURE, "règles réécriture")                                       \
+    OP(PASSES_FSAU__NUMÉROTATION_VALEURS, "numérotation valeurs")                                 \
+    OP(PASSES_FSAU__INVARIANTS_BOUCLES, "invariants boucles")                                     \
+    OP(PASSES_FSAU__STOCKAGES_MORTS, "stockages morts")                                           \
+    OP(PASSES_FSAU__CODE_INUTILE, "code inutile")                                                 \
+    OP(PASSES_FSAU__RIÈREVERSION, "rièreversion")
+
+DEFINIS_ENUM(PASSES_FSAU)
+
+/* Stats pour les passes d'optimisation sur la FSAU. */
+struct StatistiquesFSAU {
+    EntréesStats<EntréeTemps> stats{"Passes FSAU", INIT_NOMS_ENTREES(PASSES_FSAU)};
+
+    void imprime_stats();
+};
+
 void imprime_stats(Statistiques const &stats, kuri::chrono::compte_seconde début_compilation);
 
 void imprime_stats_détaillées(Statistiques const &stats);
@@ -394,3 +481,4 @@ void imprime_stats_détaillées(Statistiques const &stats);
 #undef ENTREES_POUR_STRUCTURE
 #undef ENTREES_POUR_ASSIGNATION
 #undef ENTREES_POUR_GESTIONNAIRE_CODE
+#undef ENTREES_POUR_PASSES_FSAU
@@ -78,4 +78,13 @@ std::ostream &operator<<(std::ostream &os, const chaine_statique &vc)
     return os;
 }
 
+uint64_t empreinte_fnv1a(chaine_statique chn, uint64_t empreinte)
+{
+    for (auto c : chn) {
+        empreinte ^= static_cast<uint8_t>(c);
+        empreinte *= 1099511628211ull;
+    }
+    return empreinte;
+}
+
 }  // namespace kuri
@@ -113,6 +113,15 @@ bool operator!=(char const *vc1, chaine_statique const &vc2);
 
 std::ostream &operator<<(std::ostream &os, chaine_statique const &vc);
 
+inline constexpr uint64_t EMPREINTE_FNV1A_INITIALE = 14695981039346656037ull;
+
+/**
+ * Calcule l'empreinte FNV-1a de la chaine. L'empreinte précédente peut être passée afin de
+ * calculer l'empreinte de plusieurs chaines à la suite. Contrairement à std::hash, l'empreinte
+ * est stable entre les exécutions et peut être écrite sur disque.
+ */
+uint64_t empreinte_fnv1a(chaine_statique chn, uint64_t empreinte = EMPREINTE_FNV1A_INITIALE);
+
 }  // namespace kuri
 
 namespace std {
@@ -149,6 +149,19 @@ int64_t Enchaineuse::taille_chaine() const
     return taille;
 }
 
+uint64_t Enchaineuse::empreinte_fnv1a() const
+{
+    auto résultat = kuri::EMPREINTE_FNV1A_INITIALE;
+    auto tampon = &m_tampon_base;
+
+    while (tampon) {
+        résultat = kuri::empreinte_fnv1a({&tampon->données[0], tampon->occupe}, résultat);
+        tampon = tampon->suivant;
+    }
+
+    return résultat;
+}
+
 kuri::chaine Enchaineuse::chaine() const
 {
     auto taille = taille_chaine();
@@ -268,3 +281,47 @@ Enchaineuse &operator<<(Enchaineuse &enchaineuse, const char *chn)
 
     return enchaineuse;
 }
+
+void imprime_chaine_json(Enchaineuse &enchaineuse, kuri::chaine_statique chaine)
+{
+    static const char *chiffres_hexadécimaux = "0123456789abcdef";
+
+    enchaineuse << '"';
+    POUR (chaine) {
+        switch (it) {
+            case '"':
+            {
+                enchaineuse << "\\\"";
+                break;
+            }
+            case '\\':
+            {
+                enchaineuse << "\\\\";
+                break;
+            }
+            case '\n':
+            {
+                enchaineuse << "\\n";
+                break;
+            }
+            case '\t':
+            {
+                enchaineuse << "\\t";
+                break;
+            }
+            default:
+            {
+                auto c = static_cast<unsigned char>(it);
+                if (c < 0x20) {
+                    enchaineuse << "\\u00" << chiffres_hexadécimaux[c >> 4]
+                                << chiffres_hexadécimaux[c & 0xf];
+                }
+                else {
+                    enchaineuse << it;
+                }
+                break;
+            }
+        }
+    }
+    enchaineuse << '"';
+}
@@ -52,6 +52,9 @@ struct Enchaineuse {
 
     int64_t taille_chaine() const;
 
+    /** Retourne l'empreinte FNV-1a de la chaine construite. */
+    uint64_t empreinte_fnv1a() const;
+
     kuri::chaine chaine() const;
 
     void permute(Enchaineuse &autre);
@@ -231,6 +234,9 @@ Enchaineuse &operator<<(Enchaineuse &enchaineuse, kuri::chaine const &chn);
 
 Enchaineuse &operator<<(Enchaineuse &enchaineuse, const char *chn);
 
+/* Imprime la chaine entre guillemets, en échappant les caractères selon les règles du JSON. */
+void imprime_chaine_json(Enchaineuse &enchaineuse, kuri::chaine_statique chaine);
+
 template <typename... Ts>
 kuri::chaine enchaine(Ts &&...ts)
 {
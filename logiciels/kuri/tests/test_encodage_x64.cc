@@ -0,0 +1,610 @@
+/* SPDX-License-Identifier: GPL-2.0-or-later
+ * The Original Code is Copyright (C) 2026 Kévin Dietrich. */
+
+/* Tests de l'encodage des instructions par l'EncodeuseX64.
+ *
+ * Chaque cas émet une instruction, ou une courte séquence, via l'AssembleuseASM. Les octets
+ * encodés sont comparés à ceux attendus, qui sont ceux que produit nasm (-f elf64, avec ses
+ * optimisations par défaut) pour le texte imprimé par l'AssembleuseASM. Si nasm est installé,
+ * ce texte est également assemblé par celui-ci, et ses octets comparés à ceux de l'encodeuse.
+ */
+
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <unistd.h>
+
+#include "compilation/assembleuse_asm.hh"
+
+#include "structures/chemin_systeme.hh"
+#include "structures/enchaineuse.hh"
+
+#include "utilitaires/log.hh"
+
+using Mémoire = AssembleuseASM::Mémoire;
+using Immédiate8 = AssembleuseASM::Immédiate8;
+using Immédiate16 = AssembleuseASM::Immédiate16;
+using Immédiate32 = AssembleuseASM::Immédiate32;
+using Immédiate64 = AssembleuseASM::Immédiate64;
+using Fonction = AssembleuseASM::Fonction;
+using Globale = AssembleuseASM::Globale;
+
+struct CasEncodage {
+    /* Les octets attendus, en hexadécimal. */
+    const char *octets = "";
+    void (*émets)(AssembleuseASM &) = nullptr;
+
+    /* La relocation attendue, pour les références aux symboles. */
+    const char *symbole = nullptr;
+    uint32_t type_relocation = R_X86_64_NONE;
+    int64_t addend = 0;
+};
+
+#define CAS(octets, ...)                                                                          \
+    {                                                                                             \
+        octets, [](AssembleuseASM &a) { a.__VA_ARGS__; }                                          \
+    }
+
+#define CAS_RELOCATION(octets, symbole, type, addend, ...)                                        \
+    {                                                                                             \
+        octets, [](AssembleuseASM &a) { a.__VA_ARGS__; }, symbole, type, addend                   \
+    }
+
+/* Au-delà de 127 octets entre un saut et sa cible, nasm utilise, comme l'encodeuse, un
+ * déplacement de 32 bits. Le remplissage fait 130 octets. */
+static void émets_remplissage(AssembleuseASM &a)
+{
+    for (int i = 0; i < 13; i++) {
+        a.mov(Registre::RAX, Immédiate64{0x123456789abcdef0}, 8);
+    }
+}
+
+#define OCTETS_MOV_REMPLISSAGE "48 b8 f0 de bc 9a 78 56 34 12 "
+#define OCTETS_REMPLISSAGE                                                                        \
+    OCTETS_MOV_REMPLISSAGE OCTETS_MOV_REMPLISSAGE OCTETS_MOV_REMPLISSAGE                          \
+        OCTETS_MOV_REMPLISSAGE OCTETS_MOV_REMPLISSAGE OCTETS_MOV_REMPLISSAGE                      \
+            OCTETS_MOV_REMPLISSAGE OCTETS_MOV_REMPLISSAGE OCTETS_MOV_REMPLISSAGE                  \
+                OCTETS_MOV_REMPLISSAGE OCTETS_MOV_REMPLISSAGE OCTETS_MOV_REMPLISSAGE              \
+                    OCTETS_MOV_REMPLISSAGE
+
+static CasEncodage cas_encodage[] = {
+    /* mov registre, registre : toutes les tailles, REX.R/REX.B, registres octets requérant un
+     * préfixe REX. */
+    CAS("48 89 d8", mov(Registre::RAX, Registre::RBX, 8)),
+    CAS("89 d8", mov(Registre::RAX, Registre::RBX, 4)),
+    CAS("66 89 d8", mov(Registre::RAX, Registre::RBX, 2)),
+    CAS("88 d8", mov(Registre::RAX, Registre::RBX, 1)),
+    CAS("4d 89 f8", mov(Registre::R8, Registre::R15, 8)),
+    CAS("41 89 c1", mov(Registre::R9, Registre::RAX, 4)),
+    CAS("66 44 89 e0", mov(Registre::RAX, Registre::R12, 2)),
+    CAS("40 88 c6", mov(Registre::RSI, Registre::RAX, 1)),
+    CAS("40 88 f8", mov(Registre::RAX, Registre::RDI, 1)),
+    CAS("88 e3", mov_ah(Registre::RBX)),
+
+    /* mov registre, immédiate. */
+    CAS("b8 01 00 00 00", mov(Registre::RAX, Immédiate64{1}, 8)),
+    CAS("41 ba ff ff ff ff", mov(Registre::R10, Immédiate64{0xffffffff}, 8)),
+    CAS("48 c7 c0 ff ff ff ff", mov(Registre::RAX, Immédiate64{uint64_t(-1)}, 8)),
+    CAS("49 c7 c3 00 00 00 80", mov(Registre::R11, Immédiate64{uint64_t(-2147483648ll)}, 8)),
+    CAS("48 b8 f0 de bc 9a 78 56 34 12", mov(Registre::RAX, Immédiate64{0x123456789abcdef0}, 8)),
+    CAS("49 bf 00 00 00 00 01 00 00 00", mov(Registre::R15, Immédiate64{0x100000000}, 8)),
+    CAS("b8 07 00 00 00", mov(Registre::RAX, Immédiate32{7}, 4)),
+    CAS("66 b9 07 00", mov(Registre::RCX, Immédiate16{7}, 2)),
+    CAS("b2 07", mov(Registre::RDX, Immédiate8{7}, 1)),
+    CAS("41 b4 07", mov(Registre::R12, Immédiate8{7}, 1)),
+    CAS("40 b7 01", mov(Registre::RDI, Immédiate8{1}, 1)),
+
+    /* mov mémoire, immédiate. */
+    CAS("48 c7 45 f8 05 00 00 00", mov(Mémoire{Registre::RBP, -8}, Immédiate64{5}, 8)),
+    CAS("c7 44 24 fc 00 00 80 3f",
+        mov(Mémoire{Registre::RSP, -4}, Immédiate32{0x3f800000}, 4)),
+    CAS("66 41 c7 45 00 02 00", mov(Mémoire{Registre::R13}, Immédiate16{2}, 2)),
+    CAS("41 c6 04 24 01", mov(Mémoire{Registre::R12}, Immédiate8{1}, 1)),
+
+    /* Modes d'adressage : sans déplacement, rbp et r13 requérant un déplacement, rsp et r12
+     * requérant un octet SIB, déplacements sur 8 et 32 bits, positifs et négatifs. */
+    CAS("48 8b 03", mov(Registre::RAX, Mémoire{Registre::RBX}, 8)),
+    CAS("48 8b 45 00", mov(Registre::RAX, Mémoire{Registre::RBP}, 8)),
+    CAS("49 8b 45 00", mov(Registre::RAX, Mémoire{Registre::R13}, 8)),
+    CAS("48 8b 04 24", mov(Registre::RAX, Mémoire{Registre::RSP}, 8)),
+    CAS("49 8b 44 24 08", mov(Registre::RAX, Mémoire{Registre::R12, 8}, 8)),
+    CAS("48 8b 45 f8", mov(Registre::RAX, Mémoire{Registre::RBP, -8}, 8)),
+    CAS("48 8b 45 80", mov(Registre::RAX, Mémoire{Registre::RBP, -128}, 8)),
+    CAS("48 8b 85 7f ff ff ff", mov(Registre::RAX, Mémoire{Registre::RBP, -129}, 8)),
+    CAS("48 8b 43 7f", mov(Registre::RAX, Mémoire{Registre::RBX, 127}, 8)),
+    CAS("48 8b 83 80 00 00 00", mov(Registre::RAX, Mémoire{Registre::RBX, 128}, 8)),
+    CAS("45 8b 98 e8 03 00 00", mov(Registre::R11, Mémoire{Registre::R8, 1000}, 4)),
+    CAS("8a 8c 24 00 01 00 00", mov(Registre::RCX, Mémoire{Registre::RSP, 256}, 1)),
+    CAS("4c 89 7c 24 08", mov(Mémoire{Registre::RSP, 8}, Registre::R15, 8)),
+    CAS("40 88 75 ff", mov(Mémoire{Registre::RBP, -1}, Registre::RSI, 1)),
+    CAS("66 44 89 08", mov(Mémoire{Registre::RAX}, Registre::R9, 2)),
+    CAS("48 8d 45 f0", lea(Registre::RAX, Mémoire{Registre::RBP, -16})),
+    CAS("48 8d 7c 24 08", lea(Registre::RDI, Mémoire{Registre::RSP, 8})),
+
+    /* Adressage relatif à rip. L'addend prend en compte les octets suivant le déplacement, et
+     * le décalage de l'expression, qui peut être négatif. */
+    CAS_RELOCATION("48 8b 05 00 00 00 00",
+                   "globale",
+                   R_X86_64_PC32,
+                   -4,
+                   mov(Registre::RAX, Mémoire{"globale"}, 8)),
+    CAS_RELOCATION("48 89 05 00 00 00 00",
+                   "globale",
+                   R_X86_64_PC32,
+                   -4,
+                   mov(Mémoire{"globale"}, Registre::RAX, 8)),
+    CAS_RELOCATION("48 8b 0d 00 00 00 00",
+                   "globale",
+                   R_X86_64_PC32,
+                   -20,
+                   mov(Registre::RCX, Mémoire{"globale - 16"}, 8)),
+    CAS_RELOCATION("c7 05 00 00 00 00 01 00 00 00",
+                   "globale",
+                   R_X86_64_PC32,
+                   0,
+                   mov(Mémoire{"globale + 8"}, Immédiate32{1}, 4)),
+    CAS_RELOCATION("4c 8d 35 00 00 00 00",
+                   "globale",
+                   R_X86_64_PC32,
+                   20,
+                   lea(Registre::R14, Mémoire{"globale + 24"})),
+    CAS_RELOCATION("f3 0f 10 0d 00 00 00 00",
+                   "globale",
+                   R_X86_64_PC32,
+                   -4,
+                   movss(Registre::XMM1, Globale{"globale"})),
+    CAS_RELOCATION("f2 0f 10 05 00 00 00 00",
+                   "globale",
+                   R_X86_64_PC32,
+                   -12,
+                   movsd(Registre::XMM0, Mémoire{"globale - 8"})),
+
+    /* movsx et movzx. */
+    CAS("48 0f be c3", movsx(Registre::RAX, 8, Registre::RBX, 1)),
+    CAS("48 0f bf c3", movsx(Registre::RAX, 8, Registre::RBX, 2)),
+    CAS("48 63 c3", movsx(Registre::RAX, 8, Registre::RBX, 4)),
+    CAS("40 0f be c6", movsx(Registre::RAX, 4, Registre::RSI, 1)),
+    CAS("66 0f be ca", movsx(Registre::RCX, 2, Registre::RDX, 1)),
+    CAS("4c 63 c8", movsx(Registre::R9, 8, Registre::RAX, 4)),
+    CAS("48 0f b6 c3", movzx(Registre::RAX, 8, Registre::RBX, 1)),
+    CAS("0f b7 c3", movzx(Registre::RAX, 4, Registre::RBX, 2)),
+    CAS("45 0f b6 c1", movzx(Registre::R8, 4, Registre::R9, 1)),
+
+    /* Arithmétique : registre, mémoire, immédiates sur 8 et 32 bits, et formes courtes pour
+     * l'accumulateur. */
+    CAS("48 01 d8", add(Registre::RAX, Registre::RBX, 8)),
+    CAS("48 83 c0 08", add(Registre::RAX, Immédiate64{8}, 8)),
+    CAS("48 81 c4 e8 03 00 00", add(Registre::RSP, Immédiate64{1000}, 8)),
+    CAS("48 05 e8 03 00 00", add(Registre::RAX, Immédiate64{1000}, 8)),
+    CAS("05 e8 03 00 00", add(Registre::RAX, Immédiate32{1000}, 4)),
+    CAS("66 05 e8 03", add(Registre::RAX, Immédiate16{1000}, 2)),
+    CAS("66 81 c1 e8 03", add(Registre::RCX, Immédiate16{1000}, 2)),
+    CAS("66 83 c1 05", add(Registre::RCX, Immédiate16{5}, 2)),
+    CAS("04 05", add(Registre::RAX, Immédiate8{5}, 1)),
+    CAS("80 c1 05", add(Registre::RCX, Immédiate8{5}, 1)),
+    CAS("41 80 c0 c8", add(Registre::R8, Immédiate8{200}, 1)),
+    CAS("48 03 45 f8", add(Registre::RAX, Mémoire{Registre::RBP, -8}, 8)),
+    CAS("48 01 45 f8", add(Mémoire{Registre::RBP, -8}, Registre::RAX, 8)),
+    CAS("48 83 ec 10", sub(Registre::RSP, Immédiate64{16}, 8)),
+    CAS("48 2d 00 01 00 00", sub(Registre::RAX, Immédiate64{256}, 8)),
+    CAS("4c 29 c2", sub(Registre::RDX, Registre::R8, 8)),
+    CAS("48 83 e4 f0", and_(Registre::RSP, Immédiate64{0xfffffffffffffff0}, 8)),
+    CAS("48 25 ff 00 00 00", and_(Registre::RAX, Immédiate64{0xff}, 8)),
+    CAS("24 0f", and_(Registre::RAX, Immédiate8{0x0f}, 1)),
+    CAS("09 c2", or_(Registre::RDX, Registre::RAX, 4)),
+    CAS("0d 00 00 01 00", or_(Registre::RAX, Immédiate32{0x10000}, 4)),
+    CAS("31 c0", xor_(Registre::RAX, Registre::RAX, 4)),
+    CAS("4d 31 c0", xor_(Registre::R8, Registre::R8, 8)),
+    CAS("34 01", xor_(Registre::RAX, Immédiate8{1}, 1)),
+    CAS("48 83 f8 00", cmp(Registre::RAX, Immédiate64{0}, 8)),
+    CAS("48 3d 00 02 00 00", cmp(Registre::RAX, Immédiate64{512}, 8)),
+    CAS("3c 7f", cmp(Registre::RAX, Immédiate8{127}, 1)),
+    CAS("40 38 f7", cmp(Registre::RDI, Registre::RSI, 1)),
+    CAS("3b 45 fc", cmp(Registre::RAX, Mémoire{Registre::RBP, -4}, 4)),
+    CAS("48 85 c0", test(Registre::RAX, Registre::RAX)),
+    CAS("4d 85 c9", test(Registre::R9, Registre::R9)),
+    CAS("48 a9 01 00 00 00", test(Registre::RAX, Immédiate64{1})),
+    CAS("48 f7 c1 01 00 00 00", test(Registre::RCX, Immédiate64{1})),
+
+    /* Multiplications, divisions, et opérations unaires. */
+    CAS("48 0f af c3", imul(Registre::RAX, Registre::RBX, 8)),
+    CAS("48 6b c0 0a", imul(Registre::RAX, Immédiate64{10}, 8)),
+    CAS("69 c9 e8 03 00 00", imul(Registre::RCX, Immédiate32{1000}, 4)),
+    CAS("48 f7 eb", imul(Registre::RBX, 8)),
+    CAS("f7 e1", mul(Registre::RCX, 4)),
+    CAS("48 f7 f3", div(Registre::RBX, 8)),
+    CAS("49 f7 fa", idiv(Registre::R10, 8)),
+    CAS("f6 f9", idiv(Registre::RCX, 1)),
+    CAS("48 f7 d8", neg(Registre::RAX, 8)),
+    CAS("40 f6 d6", not_(Registre::RSI, 1)),
+    CAS("66 f7 d0", not_(Registre::RAX, 2)),
+
+    /* Décalages : par immédiate, par 1, et par cl. */
+    CAS("48 c1 e0 03", shl(Registre::RAX, Immédiate8{3}, 8)),
+    CAS("48 d1 e0", shl(Registre::RAX, Immédiate8{1}, 8)),
+    CAS("40 d0 ee", shr(Registre::RSI, Immédiate8{1}, 1)),
+    CAS("d3 ea", shr(Registre::RDX, Registre::RCX, 4)),
+    CAS("49 c1 f8 3f", sar(Registre::R8, Immédiate8{63}, 8)),
+    CAS("d2 f8", sar(Registre::RAX, Registre::RCX, 1)),
+
+    /* Mouvements conditionnels. */
+    CAS("48 0f 44 c3", cmove(Registre::RAX, Registre::RBX)),
+    CAS("48 0f 45 c3", cmovne(Registre::RAX, Registre::RBX)),
+    CAS("49 0f 4c c1", cmovl(Registre::RAX, Registre::R9)),
+    CAS("48 0f 4e c3", cmovle(Registre::RAX, Registre::RBX)),
+    CAS("4c 0f 4f c3", cmovg(Registre::R8, Registre::RBX)),
+    CAS("48 0f 4d c3", cmovge(Registre::RAX, Registre::RBX)),
+
+    /* SSE. */
+    CAS("f3 0f 10 c1", movss(Registre::XMM0, Registre::XMM1)),
+    CAS("f3 0f 10 45 fc", movss(Registre::XMM0, Mémoire{Registre::RBP, -4})),
+    CAS("f2 0f 11 0c 24", movsd(Mémoire{Registre::RSP}, Registre::XMM1)),
+    CAS("f2 41 0f 10 54 24 10", movsd(Registre::XMM2, Mémoire{Registre::R12, 16})),
+    CAS("f3 0f 58 c1", addss(Registre::XMM0, Registre::XMM1)),
+    CAS("f2 0f 58 55 f8", addsd(Registre::XMM2, Mémoire{Registre::RBP, -8})),
+    CAS("f3 0f 5c d3", subss(Registre::XMM2, Registre::XMM3)),
+    CAS("f2 0f 5c e5", subsd(Registre::XMM4, Registre::XMM5)),
+    CAS("f3 0f 59 f7", mulss(Registre::XMM6, Registre::XMM7)),
+    CAS("f2 0f 59 c1", mulsd(Registre::XMM0, Registre::XMM1)),
+    CAS("f3 0f 5e c1", divss(Registre::XMM0, Registre::XMM1)),
+    CAS("f2 0f 5e c1", divsd(Registre::XMM0, Registre::XMM1)),
+    CAS("0f 57 c1", xorps(Registre::XMM0, Registre::XMM1)),
+    CAS("66 0f ef db", pxor(Registre::XMM3, Registre::XMM3)),
+    CAS("0f 2e c1", ucomiss(Registre::XMM0, Registre::XMM1)),
+    CAS("66 0f 2e c1", ucomisd(Registre::XMM0, Registre::XMM1)),
+    CAS("f2 0f 5a c8", cvtsd2ss(Registre::XMM1, Registre::XMM0)),
+    CAS("f3 0f 2c c0", cvttss2si(Registre::RAX, Registre::XMM0, 4)),
+    CAS("f3 48 0f 2d c1", cvtss2si(Registre::RAX, Registre::XMM1, 8)),
+    CAS("f2 44 0f 2c ca", cvttsd2si(Registre::R9, Registre::XMM2, 4)),
+    CAS("f2 48 0f 2d c0", cvtsd2si(Registre::RAX, Registre::XMM0, 8)),
+    CAS("f3 48 0f 2a c0", cvtsi2ss(Registre::XMM0, Registre::RAX, 8)),
+    CAS("f2 0f 2a c9", cvtsi2sd(Registre::XMM1, Registre::RCX, 4)),
+    CAS("f2 49 0f 2a c7", cvtsi2sd(Registre::XMM0, Registre::R15, 8)),
+
+    /* Pile. */
+    CAS("50", push(Registre::RAX)),
+    CAS("41 54", push(Registre::R12)),
+    CAS("5d", pop(Registre::RBP)),
+    CAS("41 5f", pop(Registre::R15)),
+    CAS("6a 05", push_immédiate_8(5)),
+    CAS("6a c8", push_immédiate_8(200)),
+    CAS("66 6a 05", push_immédiate_16(5)),
+    CAS("66 68 e8 03", push_immédiate_16(1000)),
+    CAS("6a 05", push_immédiate_32(5)),
+    CAS("68 e8 03 00 00", push_immédiate_32(1000)),
+    CAS("6a 00", push_immédiate_64(0)),
+    CAS("68 a0 86 01 00", push_immédiate_64(100000)),
+
+    /* Instructions sans opérandes. */
+    CAS("c3", ret()),
+    CAS("0f 05", syscall()),
+    CAS("0f 0b", ud2()),
+    CAS("cc", int3()),
+    CAS("66 98", cbw()),
+    CAS("66 99", cwd()),
+    CAS("99", cdq()),
+    CAS("48 99", cqo()),
+
+    /* Appels. */
+    CAS_RELOCATION(
+        "e8 00 00 00 00", "fonction", R_X86_64_PC32, -4, call(Fonction{"fonction", false})),
+    CAS_RELOCATION(
+        "e8 00 00 00 00", "fonction", R_X86_64_PLT32, -4, call(Fonction{"fonction", true})),
+    CAS("ff d0", call(Registre::RAX)),
+    CAS("41 ff d3", call(Registre::R11)),
+
+    /* Sauts vers des labels, en arrière et en avant. */
+    CAS("" OCTETS_REMPLISSAGE "e9 79 ff ff ff", label(0); émets_remplissage(a); a.jump(0)),
+    CAS("e9 82 00 00 00 " OCTETS_REMPLISSAGE, jump(0); émets_remplissage(a); a.label(0)),
+    CAS("0f 84 ac 00 00 00 0f 85 a6 00 00 00 0f 84 a0 00 00 00 0f 85 9a 00 00 00 "
+        "0f 8c 94 00 00 00 0f 8e 8e 00 00 00 0f 8f 88 00 00 00 0f 8d 82 00 00 00 "
+        "" OCTETS_REMPLISSAGE,
+        jump_si_égal(1);
+        a.jump_si_inégal(1);
+        a.jump_si_zéro(1);
+        a.jump_si_non_zéro(1);
+        a.jump_si_inférieur(1);
+        a.jump_si_inférieur_égal(1);
+        a.jump_si_supérieur(1);
+        a.jump_si_supérieur_égal(1);
+        émets_remplissage(a);
+        a.label(1)),
+};
+
+static kuri::tableau<uint8_t> donne_octets(const char *hexadécimal)
+{
+    auto résultat = kuri::tableau<uint8_t>();
+    auto octet = 0;
+    auto chiffres = 0;
+
+    for (auto c = hexadécimal; *c != '\0'; c++) {
+        if (*c == ' ') {
+            continue;
+        }
+
+        auto const valeur = (*c >= 'a') ? (*c - 'a' + 10) : (*c - '0');
+        octet = octet * 16 + valeur;
+        chiffres += 1;
+
+        if (chiffres == 2) {
+            résultat.ajoute(uint8_t(octet));
+            octet = 0;
+            chiffres = 0;
+        }
+    }
+
+    return résultat;
+}
+
+static bool sont_égaux(kuri::tableau<uint8_t> const &a, kuri::tableau<uint8_t> const &b)
+{
+    if (a.taille() != b.taille()) {
+        return false;
+    }
+
+    POUR_INDICE (a) {
+        if (it != b[indice_it]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void imprime_octets(std::ostream &os, kuri::tableau<uint8_t> const &octets)
+{
+    static const char *chiffres = "0123456789abcdef";
+    POUR (octets) {
+        os << chiffres[it >> 4] << chiffres[it & 0xf] << ' ';
+    }
+}
+
+static kuri::chaine donne_texte(CasEncodage const &cas)
+{
+    Enchaineuse enchaineuse;
+    AssembleuseASM assembleuse(enchaineuse);
+    cas.émets(assembleuse);
+    return enchaineuse.chaine();
+}
+
+static bool nasm_est_disponible()
+{
+    return system("nasm -v > /dev/null 2>&1") == 0;
+}
+
+/* Assemble le texte avec nasm, et retourne les octets de la section .text. */
+static std::optional<kuri::tableau<uint8_t>> assemble_avec_nasm(kuri::chaine_statique texte)
+{
+    auto const nom_base = enchaine("test_encodage_x64_", getpid());
+    auto const chemin_asm = kuri::chemin_systeme::chemin_temporaire(enchaine(nom_base, ".asm"));
+    auto const chemin_o = kuri::chemin_systeme::chemin_temporaire(enchaine(nom_base, ".o"));
+    auto const chemin_bin = kuri::chemin_systeme::chemin_temporaire(enchaine(nom_base, ".bin"));
+
+    std::ofstream of(kuri::vers_std_path(chemin_asm));
+    of << "BITS 64\n";
+    of << "extern globale\n";
+    of << "extern fonction\n";
+    of << "section .text\n";
+    of << "test:\n";
+    of << texte;
+    of.close();
+
+    auto const commande = enchaine("nasm -f elf64 ",
+                                   chemin_asm,
+                                   " -o ",
+                                   chemin_o,
+                                   " && objcopy -O binary --only-section=.text ",
+                                   chemin_o,
+                                   " ",
+                                   chemin_bin,
+                                   '\0');
+    auto résultat = std::optional<kuri::tableau<uint8_t>>();
+
+    if (system(commande.pointeur()) == 0) {
+        auto octets = kuri::tableau<uint8_t>();
+        std::ifstream fichier(kuri::vers_std_path(chemin_bin), std::ios::binary);
+        char c;
+        while (fichier.get(c)) {
+            octets.ajoute(uint8_t(c));
+        }
+        résultat = octets;
+    }
+
+    for (auto const &chemin : {chemin_asm, chemin_o, chemin_bin}) {
+        if (kuri::chemin_systeme::existe(chemin) && !kuri::chemin_systeme::supprime(chemin)) {
+            dbg() << "Impossible de supprimer " << chemin;
+        }
+    }
+
+    return résultat;
+}
+
+static bool vérifie_cas(CasEncodage const &cas, bool compare_avec_nasm)
+{
+    FichierELF fichier;
+    fichier.crée_section(".text", SHT_PROGBITS);
+
+    EncodeuseX64 encodeuse(fichier);
+    encodeuse.débute_fonction("test");
+    {
+        AssembleuseASM assembleuse(encodeuse);
+        cas.émets(assembleuse);
+    }
+    encodeuse.termine_fonction();
+
+    auto const &section = encodeuse.donne_section_text();
+    auto const attendus = donne_octets(cas.octets);
+    auto résultat = true;
+
+    if (!sont_égaux(section.données, attendus)) {
+        std::cerr << "ERREUR encodage de :\n" << donne_texte(cas);
+        std::cerr << "  obtenu  : ";
+        imprime_octets(std::cerr, section.données);
+        std::cerr << "\n  attendu : ";
+        imprime_octets(std::cerr, attendus);
+        std::cerr << "\n";
+        résultat = false;
+    }
+
+    if (cas.symbole) {
+        if (section.relocations.taille() != 1) {
+            std::cerr << "ERREUR " << section.relocations.taille()
+                      << " relocations au lieu d'une pour :\n"
+                      << donne_texte(cas);
+            return false;
+        }
+
+        auto const &relocation = section.relocations[0];
+        auto const &symbole = fichier.donne_symbole(relocation.indice_symbole);
+        if (symbole.nom != cas.symbole || relocation.type != cas.type_relocation ||
+            relocation.addend != cas.addend) {
+            std::cerr << "ERREUR relocation de :\n" << donne_texte(cas);
+            std::cerr << "  obtenue  : " << symbole.nom << ", type " << relocation.type
+                      << ", addend " << relocation.addend << "\n";
+            std::cerr << "  attendue : " << cas.symbole << ", type " << cas.type_relocation
+                      << ", addend " << cas.addend << "\n";
+            résultat = false;
+        }
+    }
+    else if (!section.relocations.est_vide()) {
+        std::cerr << "ERREUR relocation inattendue pour :\n" << donne_texte(cas);
+        résultat = false;
+    }
+
+    if (!compare_avec_nasm) {
+        return résultat;
+    }
+
+    auto const texte = donne_texte(cas);
+    auto const octets_nasm = assemble_avec_nasm(texte);
+    if (!octets_nasm.has_value()) {
+        std::cerr << "ERREUR nasm ne peut assembler :\n" << texte;
+        return false;
+    }
+
+    if (!sont_égaux(section.données, octets_nasm.value())) {
+        std::cerr << "ERREUR encodage différent de celui de nasm pour :\n" << texte;
+        std::cerr << "  encodeuse : ";
+        imprime_octets(std::cerr, section.données);
+        std::cerr << "\n  nasm      : ";
+        imprime_octets(std::cerr, octets_nasm.value());
+        std::cerr << "\n";
+        résultat = false;
+    }
+
+    return résultat;
+}
+
+static bool vérifie_symbole_et_décalage(kuri::chaine_statique expression,
+                                        kuri::chaine_statique symbole_attendu,
+                                        int64_t décalage_attendu)
+{
+    auto décalage = int64_t(-1);
+    auto const symbole = donne_symbole_et_décalage(expression, décalage);
+
+    if (symbole != symbole_attendu || décalage != décalage_attendu) {
+        std::cerr << "ERREUR « " << expression << " » donne « " << symbole << " » et "
+                  << décalage << " au lieu de « " << symbole_attendu << " » et "
+                  << décalage_attendu << "\n";
+        return false;
+    }
+
+    return true;
+}
+
+/* L'adresse d'une constante de la fonction est poussée relativement à rip, alors que nasm
+ * pousserait une immédiate, qui requiers une relocation absolue. */
+static bool vérifie_push_constante()
+{
+    FichierELF fichier;
+    fichier.crée_section(".text", SHT_PROGBITS);
+
+    EncodeuseX64 encodeuse(fichier);
+    encodeuse.débute_fonction("test");
+    {
+        AssembleuseASM assembleuse(encodeuse);
+        assembleuse.push(AssembleuseASM::Label{"C", 0}, 8);
+        assembleuse.ret();
+    }
+    encodeuse.définis_constante_locale(0);
+    encodeuse.donne_section_text().ajoute_valeur(uint64_t(0));
+    encodeuse.termine_fonction();
+
+    auto const &données = encodeuse.donne_section_text().données;
+    auto const attendus = donne_octets("50 48 8d 05 05 00 00 00 48 87 04 24 c3 "
+                                       "00 00 00 00 00 00 00 00");
+    if (!sont_égaux(données, attendus)) {
+        std::cerr << "ERREUR encodage de push .C0\n";
+        std::cerr << "  obtenu  : ";
+        imprime_octets(std::cerr, données);
+        std::cerr << "\n  attendu : ";
+        imprime_octets(std::cerr, attendus);
+        std::cerr << "\n";
+        return false;
+    }
+
+    return true;
+}
+
+/* Les initialisations des globales référençant d'autres symboles. */
+static bool vérifie_relocations_absolues()
+{
+    FichierELF fichier;
+    fichier.crée_section(".text", SHT_PROGBITS);
+    auto data = fichier.crée_section(".data", SHT_PROGBITS);
+
+    EncodeuseX64 encodeuse(fichier);
+    encodeuse.ajoute_relocation_absolue(*data, "fonction");
+    encodeuse.ajoute_relocation_absolue(*data, "DC + 16");
+    encodeuse.ajoute_relocation_absolue(*data, "DC - 24");
+
+    int64_t const addends_attendus[] = {0, 16, -24};
+    const char *symboles_attendus[] = {"fonction", "DC", "DC"};
+
+    if (data->données.taille() != 24 || data->relocations.taille() != 3) {
+        std::cerr << "ERREUR relocations absolues : " << data->données.taille() << " octets et "
+                  << data->relocations.taille() << " relocations\n";
+        return false;
+    }
+
+    auto résultat = true;
+    POUR_INDICE (data->relocations) {
+        auto const &symbole = fichier.donne_symbole(it.indice_symbole);
+        if (it.type != R_X86_64_64 || it.décalage != uint64_t(indice_it * 8) ||
+            it.addend != addends_attendus[indice_it] ||
+            symbole.nom != symboles_attendus[indice_it]) {
+            std::cerr << "ERREUR relocation absolue " << indice_it << " : " << symbole.nom
+                      << ", addend " << it.addend << "\n";
+            résultat = false;
+        }
+    }
+
+    return résultat;
+}
+
+int main()
+{
+    auto reussite = true;
+
+    reussite &= vérifie_symbole_et_décalage("globale", "globale", 0);
+    reussite &= vérifie_symbole_et_décalage("DC + 16", "DC", 16);
+    reussite &= vérifie_symbole_et_décalage("DC - 16", "DC", -16);
+    reussite &= vérifie_symbole_et_décalage("DC+8", "DC", 8);
+    reussite &= vérifie_symbole_et_décalage("DC-8", "DC", -8);
+    reussite &= vérifie_symbole_et_décalage("DC - 0", "DC", 0);
+
+    reussite &= vérifie_relocations_absolues();
+    reussite &= vérifie_push_constante();
+
+    auto const compare_avec_nasm = nasm_est_disponible();
+    if (!compare_avec_nasm) {
+        std::cerr << "nasm est introuvable, les encodages ne sont comparés qu'aux octets "
+                     "attendus.\n";
+    }
+
+    for (auto const &cas : cas_encodage) {
+        reussite &= vérifie_cas(cas, compare_avec_nasm);
+    }
+
+    return reussite ? 0 : 1;
+}
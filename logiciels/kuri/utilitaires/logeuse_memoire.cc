@@ -28,6 +28,10 @@
 #include <mutex>
 #include <sstream>
 
+#ifdef __GLIBC__
+#    include <malloc.h>
+#endif
+
 namespace mémoire {
 
 static void imprime_blocs_memoire();
@@ -297,6 +301,13 @@ int64_t nombre_deallocations()
     return logeuse.nombre_deallocations.load();
 }
 
+void rends_mémoire_libérée()
+{
+#ifdef __GLIBC__
+    malloc_trim(0);
+#endif
+}
+
 std::string formate_taille(int64_t octets)
 {
     std::stringstream ss;
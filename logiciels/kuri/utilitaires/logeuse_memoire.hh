@@ -183,6 +183,13 @@ struct logeuse_mémoire {
 
 [[nodiscard]] int64_t nombre_deallocations();
 
+/**
+ * Rend au système les pages inutilisées de l'allocateur. La mémoire délogée par un fil n'est
+ * réutilisée que par les allocations du même tas : ceci permet de réduire la mémoire résidente
+ * après avoir délogé beaucoup de mémoire que le fil courant ne réutilisera pas.
+ */
+void rends_mémoire_libérée();
+
 template <typename T, typename... Args>
 [[nodiscard]] T *loge(const char *message, Args &&...args)
 {
@@ -74,7 +74,7 @@ struct PouleDeTâchesSousProcessus final : public PouleDeTâches {
 
 struct PouleDeTâchesMoultFils final : public PouleDeTâches {
   private:
-    kuri::tablet<std::thread *, 16> m_threads;
+    kuri::tablet<std::thread *, 16> m_threads{};
 
   public:
     void ajoute_tâche(std::function<void()> &&tâche) override;